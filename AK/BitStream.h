@@ -233,6 +233,33 @@ public:
         m_bit_count -= count;
     }
 
+    /// Tops up the bit buffer with a single read from the underlying stream, without failing at its end.
+    /// Further reads are only made while fewer than `required_bit_count` bits are buffered, so this never
+    /// waits on a pipe or socket for data that the caller does not need yet.
+    /// Together with buffered_bits(), this allows decoders to peek and discard bits in tight loops
+    /// without checking for errors on every access, as long as they stay within buffered_bit_count().
+    ErrorOr<void> fill_bit_buffer(size_t required_bit_count = 0)
+    {
+        VERIFY(required_bit_count <= bit_buffer_size);
+        do {
+            if (m_bit_count > bit_buffer_size - bits_per_byte)
+                break;
+
+            BufferType buffer = 0;
+            auto bytes = TRY(m_stream->read_some({ &buffer, (bit_buffer_size - m_bit_count) / bits_per_byte }));
+            if (bytes.is_empty())
+                break;
+
+            m_bit_buffer |= buffer << m_bit_count;
+            m_bit_count += bytes.size() * bits_per_byte;
+        } while (m_bit_count < required_bit_count);
+        return {};
+    }
+
+    /// The contents of the bit buffer, with any bits above buffered_bit_count() set to zero.
+    ALWAYS_INLINE BufferType buffered_bits() const { return m_bit_buffer; }
+    ALWAYS_INLINE size_t buffered_bit_count() const { return m_bit_count; }
+
     /// Discards any sub-byte stream positioning the input stream may be keeping track of.
     /// Non-bitwise reads will implicitly call this.
     u8 align_to_byte_boundary()
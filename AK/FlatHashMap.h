@@ -0,0 +1,547 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Concepts.h>
+#include <AK/Error.h>
+#include <AK/HashTable.h>
+#include <AK/Optional.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Traits.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <AK/kmalloc.h>
+#include <initializer_list>
+
+namespace AK {
+
+template<typename FlatHashMapType, typename EntryType>
+class FlatHashMapIterator {
+    friend FlatHashMapType;
+
+public:
+    bool operator==(FlatHashMapIterator const& other) const { return m_index == other.m_index; }
+    bool operator!=(FlatHashMapIterator const& other) const { return m_index != other.m_index; }
+    EntryType& operator*() { return m_map->m_entries[m_index]; }
+    EntryType* operator->() { return &m_map->m_entries[m_index]; }
+    void operator++() { m_index = m_map->next_full_index(m_index + 1); }
+
+private:
+    FlatHashMapIterator(FlatHashMapType* map, size_t index)
+        : m_map(map)
+        , m_index(index)
+    {
+    }
+
+    FlatHashMapType* m_map { nullptr };
+    size_t m_index { 0 };
+};
+
+// A map datastructure based on an open addressing hash table in the style of Abseil's "Swiss tables".
+// Instead of storing its state next to each entry like HashMap does, every slot has a control byte in a separate array,
+// holding 7 bits of the entry's hash. Lookups compare a group of 16 control bytes at once and only look at entries
+// whose control byte matches, which makes them touch far less memory for large maps and expensive to compare keys.
+// FlatHashMap does not provide ordered iteration, and any insertion invalidates iterators as well as references to entries.
+template<typename K, typename V, typename KeyTraits, typename ValueTraits>
+class FlatHashMap {
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    static constexpr size_t group_size = 16;
+    static constexpr size_t minimum_capacity = group_size;
+
+    // Control bytes of full slots hold the 7 bits of hash that aren't used to pick the position, so they are never negative.
+    static constexpr i8 control_empty = -128;
+    static constexpr i8 control_deleted = -2;
+
+    class Group {
+    public:
+        explicit Group(i8 const* controls)
+            : m_controls(AK::SIMD::load_unaligned<AK::SIMD::i8x16>(controls))
+        {
+        }
+
+        u16 match(i8 control) const { return AK::SIMD::maskbits(m_controls == control); }
+        u16 match_empty() const { return match(control_empty); }
+        u16 match_empty_or_deleted() const { return AK::SIMD::maskbits(m_controls < 0); }
+
+    private:
+        AK::SIMD::i8x16 m_controls;
+    };
+
+    // Moves on by one more group every time, which visits every group exactly once as the capacity is a power of two.
+    class ProbeSequence {
+    public:
+        ProbeSequence(size_t hash, size_t mask)
+            : m_mask(mask)
+            , m_offset(hash & mask)
+        {
+        }
+
+        size_t offset() const { return m_offset; }
+        size_t offset(size_t index_in_group) const { return (m_offset + index_in_group) & m_mask; }
+
+        void next()
+        {
+            m_index += group_size;
+            m_offset = (m_offset + m_index) & m_mask;
+        }
+
+    private:
+        size_t m_mask { 0 };
+        size_t m_offset { 0 };
+        size_t m_index { 0 };
+    };
+
+    static_assert(alignof(Entry) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+public:
+    using KeyType = K;
+    using ValueType = V;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(std::initializer_list<Entry> list)
+    {
+        MUST(try_ensure_capacity(list.size()));
+        for (auto& [key, value] : list)
+            set(key, value);
+    }
+
+    ~FlatHashMap()
+    {
+        destroy_entries();
+        if (m_entries)
+            kfree_sized(m_entries, size_in_bytes(m_capacity));
+    }
+
+    FlatHashMap(FlatHashMap const& other) // FIXME: Not OOM-safe! Use clone() instead.
+    {
+        ensure_capacity(other.size());
+        for (auto const& [key, value] : other)
+            set(key, value);
+    }
+
+    FlatHashMap& operator=(FlatHashMap const& other) // FIXME: Not OOM-safe! Use clone() instead.
+    {
+        FlatHashMap temporary(other);
+        swap(*this, temporary);
+        return *this;
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept
+        : m_entries(exchange(other.m_entries, nullptr))
+        , m_controls(exchange(other.m_controls, nullptr))
+        , m_size(exchange(other.m_size, 0))
+        , m_capacity(exchange(other.m_capacity, 0))
+        , m_growth_left(exchange(other.m_growth_left, 0))
+    {
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept
+    {
+        FlatHashMap temporary { move(other) };
+        swap(*this, temporary);
+        return *this;
+    }
+
+    friend void swap(FlatHashMap& a, FlatHashMap& b) noexcept
+    {
+        swap(a.m_entries, b.m_entries);
+        swap(a.m_controls, b.m_controls);
+        swap(a.m_size, b.m_size);
+        swap(a.m_capacity, b.m_capacity);
+        swap(a.m_growth_left, b.m_growth_left);
+    }
+
+    [[nodiscard]] bool is_empty() const { return m_size == 0; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    void clear()
+    {
+        *this = FlatHashMap();
+    }
+
+    void clear_with_capacity()
+    {
+        if (m_capacity == 0)
+            return;
+        destroy_entries();
+        __builtin_memset(m_controls, control_empty, m_capacity + group_size);
+        m_size = 0;
+        m_growth_left = max_load(m_capacity);
+    }
+
+    HashSetResult set(K const& key, V const& value) { return MUST(try_set(key, value)); }
+    HashSetResult set(K const& key, V&& value) { return MUST(try_set(key, move(value))); }
+    HashSetResult set(K&& key, V&& value) { return MUST(try_set(move(key), move(value))); }
+    ErrorOr<HashSetResult> try_set(K const& key, V const& value) { return try_set_impl(key, value); }
+    ErrorOr<HashSetResult> try_set(K const& key, V&& value) { return try_set_impl(key, move(value)); }
+    ErrorOr<HashSetResult> try_set(K&& key, V&& value) { return try_set_impl(move(key), move(value)); }
+
+    ErrorOr<void> try_ensure_capacity(size_t capacity)
+    {
+        if (capacity <= m_size + m_growth_left)
+            return {};
+        return try_rehash(capacity_for_size(max(capacity, m_size)));
+    }
+
+    void ensure_capacity(size_t capacity)
+    {
+        MUST(try_ensure_capacity(capacity));
+    }
+
+    using Iterator = FlatHashMapIterator<FlatHashMap, Entry>;
+    using ConstIterator = FlatHashMapIterator<FlatHashMap const, Entry const>;
+
+    [[nodiscard]] Iterator begin() { return Iterator(this, next_full_index(0)); }
+    [[nodiscard]] Iterator end() { return Iterator(this, m_capacity); }
+    [[nodiscard]] ConstIterator begin() const { return ConstIterator(this, next_full_index(0)); }
+    [[nodiscard]] ConstIterator end() const { return ConstIterator(this, m_capacity); }
+
+    [[nodiscard]] Iterator find(K const& key)
+    {
+        return Iterator(this, find_index(KeyTraits::hash(key), [&](auto& entry) { return KeyTraits::equals(entry.key, key); }));
+    }
+
+    [[nodiscard]] ConstIterator find(K const& key) const
+    {
+        return ConstIterator(this, find_index(KeyTraits::hash(key), [&](auto& entry) { return KeyTraits::equals(entry.key, key); }));
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) [[nodiscard]] Iterator find(Key const& key)
+    {
+        return Iterator(this, find_index(Traits<Key>::hash(key), [&](auto& entry) { return Traits<K>::equals(entry.key, key); }));
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) [[nodiscard]] ConstIterator find(Key const& key) const
+    {
+        return ConstIterator(this, find_index(Traits<Key>::hash(key), [&](auto& entry) { return Traits<K>::equals(entry.key, key); }));
+    }
+
+    Optional<typename ValueTraits::ConstPeekType> get(K const& key) const
+    {
+        auto it = find(key);
+        if (it == end())
+            return {};
+        return (*it).value;
+    }
+
+    Optional<typename ValueTraits::PeekType> get(K const& key)
+    requires(!IsConst<typename ValueTraits::PeekType>)
+    {
+        auto it = find(key);
+        if (it == end())
+            return {};
+        return (*it).value;
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) Optional<typename ValueTraits::ConstPeekType> get(Key const& key) const
+    {
+        auto it = find(key);
+        if (it == end())
+            return {};
+        return (*it).value;
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) Optional<typename ValueTraits::PeekType> get(Key const& key)
+    requires(!IsConst<typename ValueTraits::PeekType>)
+    {
+        auto it = find(key);
+        if (it == end())
+            return {};
+        return (*it).value;
+    }
+
+    [[nodiscard]] bool contains(K const& key) const
+    {
+        return find(key) != end();
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) [[nodiscard]] bool contains(Key const& key) const
+    {
+        return find(key) != end();
+    }
+
+    bool remove(K const& key)
+    {
+        auto it = find(key);
+        if (it == end())
+            return false;
+        remove(it);
+        return true;
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) bool remove(Key const& key)
+    {
+        auto it = find(key);
+        if (it == end())
+            return false;
+        remove(it);
+        return true;
+    }
+
+    void remove(Iterator it)
+    {
+        VERIFY(it.m_map == this && it.m_index < m_capacity);
+        remove_at(it.m_index);
+    }
+
+    template<typename TUnaryPredicate>
+    bool remove_all_matching(TUnaryPredicate const& predicate)
+    {
+        bool removed_anything = false;
+        for (size_t i = next_full_index(0); i < m_capacity; i = next_full_index(i + 1)) {
+            if (predicate(m_entries[i].key, m_entries[i].value)) {
+                remove_at(i);
+                removed_anything = true;
+            }
+        }
+        return removed_anything;
+    }
+
+    Optional<V> take(K const& key)
+    {
+        auto it = find(key);
+        if (it == end())
+            return {};
+        auto value = move(it->value);
+        remove(it);
+        return value;
+    }
+
+    V& ensure(K const& key)
+    {
+        return ensure(key, [] { return V(); });
+    }
+
+    template<typename Callback>
+    V& ensure(K const& key, Callback initialization_callback)
+    {
+        auto hash = KeyTraits::hash(key);
+        auto index = find_index(hash, [&](auto& entry) { return KeyTraits::equals(entry.key, key); });
+        if (index != m_capacity)
+            return m_entries[index].value;
+
+        index = MUST(prepare_insert(hash));
+        new (&m_entries[index]) Entry { key, initialization_callback() };
+        return m_entries[index].value;
+    }
+
+    [[nodiscard]] Vector<K> keys() const
+    {
+        Vector<K> list;
+        list.ensure_capacity(size());
+        for (auto const& [key, _] : *this)
+            list.unchecked_append(key);
+        return list;
+    }
+
+    ErrorOr<FlatHashMap> clone() const
+    {
+        FlatHashMap map_clone;
+        TRY(map_clone.try_ensure_capacity(size()));
+        for (auto const& [key, value] : *this)
+            TRY(map_clone.try_set(key, value));
+        return map_clone;
+    }
+
+private:
+    friend Iterator;
+    friend ConstIterator;
+
+    // Up to 7/8 of the slots are used before growing, as probing stops at the first group with an empty slot.
+    static constexpr size_t max_load(size_t capacity) { return capacity - capacity / 8; }
+
+    static constexpr size_t capacity_for_size(size_t size)
+    {
+        size_t capacity = minimum_capacity;
+        while (max_load(capacity) < size)
+            capacity *= 2;
+        return capacity;
+    }
+
+    static constexpr size_t size_in_bytes(size_t capacity)
+    {
+        // The first group of control bytes is repeated after the last one, so groups can be loaded from any slot.
+        return capacity * sizeof(Entry) + capacity + group_size;
+    }
+
+    // The low bits of the hash pick the slot to start probing at, the high bits go into the control byte.
+    static constexpr size_t position_from_hash(u32 hash) { return hash >> 7; }
+    static constexpr i8 control_from_hash(u32 hash) { return static_cast<i8>(hash & 0x7f); }
+
+    size_t next_full_index(size_t index) const
+    {
+        while (index < m_capacity && m_controls[index] < 0)
+            ++index;
+        return index;
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] size_t find_index(u32 hash, TUnaryPredicate predicate) const
+    {
+        if (m_size == 0)
+            return m_capacity;
+
+        auto control = control_from_hash(hash);
+        ProbeSequence sequence { position_from_hash(hash), m_capacity - 1 };
+        for (;;) {
+            Group group { m_controls + sequence.offset() };
+            for (u16 matches = group.match(control); matches != 0; matches &= matches - 1) {
+                auto index = sequence.offset(count_trailing_zeroes(matches));
+                if (predicate(m_entries[index])) [[likely]]
+                    return index;
+            }
+            if (group.match_empty() != 0) [[likely]]
+                return m_capacity;
+            sequence.next();
+        }
+    }
+
+    size_t find_first_non_full(u32 hash) const
+    {
+        ProbeSequence sequence { position_from_hash(hash), m_capacity - 1 };
+        for (;;) {
+            auto available = Group { m_controls + sequence.offset() }.match_empty_or_deleted();
+            if (available != 0)
+                return sequence.offset(count_trailing_zeroes(available));
+            sequence.next();
+        }
+    }
+
+    void set_control(size_t index, i8 control)
+    {
+        m_controls[index] = control;
+        if (index < group_size)
+            m_controls[m_capacity + index] = control;
+    }
+
+    template<typename KeyArgument, typename ValueArgument>
+    ErrorOr<HashSetResult> try_set_impl(KeyArgument&& key, ValueArgument&& value)
+    {
+        auto hash = KeyTraits::hash(key);
+        auto index = find_index(hash, [&](auto& entry) { return KeyTraits::equals(entry.key, key); });
+        if (index != m_capacity) {
+            m_entries[index].value = forward<ValueArgument>(value);
+            return HashSetResult::ReplacedExistingEntry;
+        }
+
+        index = TRY(prepare_insert(hash));
+        new (&m_entries[index]) Entry { forward<KeyArgument>(key), forward<ValueArgument>(value) };
+        return HashSetResult::InsertedNewEntry;
+    }
+
+    // Claims a slot for a new entry with the given hash, the caller has to construct the entry in it.
+    ErrorOr<size_t> prepare_insert(u32 hash)
+    {
+        if (m_capacity == 0)
+            TRY(try_rehash(minimum_capacity));
+
+        auto index = find_first_non_full(hash);
+        if (m_growth_left == 0 && m_controls[index] == control_empty) {
+            // If most of the used slots are deleted entries, cleaning them up is enough to make room.
+            auto new_capacity = m_size <= max_load(m_capacity) / 2 ? m_capacity : m_capacity * 2;
+            TRY(try_rehash(new_capacity));
+            index = find_first_non_full(hash);
+        }
+
+        if (m_controls[index] == control_empty)
+            --m_growth_left;
+        set_control(index, control_from_hash(hash));
+        ++m_size;
+        return index;
+    }
+
+    void remove_at(size_t index)
+    {
+        m_entries[index].~Entry();
+        --m_size;
+
+        // A slot can only become empty again if no lookup could have probed past it while it was full, which is the
+        // case if every group it is part of also contains an empty slot. Otherwise, it has to be marked as deleted.
+        auto index_before = (index - group_size) & (m_capacity - 1);
+        auto empty_after = Group { m_controls + index }.match_empty();
+        auto empty_before = Group { m_controls + index_before }.match_empty();
+        bool was_never_full = empty_before != 0 && empty_after != 0
+            && static_cast<size_t>(count_trailing_zeroes(empty_after) + count_leading_zeroes(empty_before)) < group_size;
+
+        set_control(index, was_never_full ? control_empty : control_deleted);
+        if (was_never_full)
+            ++m_growth_left;
+    }
+
+    void destroy_entries()
+    {
+        if constexpr (!IsTriviallyDestructible<Entry>) {
+            for (size_t i = next_full_index(0); i < m_capacity; i = next_full_index(i + 1))
+                m_entries[i].~Entry();
+        }
+    }
+
+    ErrorOr<void> try_rehash(size_t new_capacity)
+    {
+        VERIFY(is_power_of_two(new_capacity) && new_capacity >= minimum_capacity);
+        VERIFY(max_load(new_capacity) >= m_size);
+
+        auto* new_storage = kmalloc(size_in_bytes(new_capacity));
+        if (!new_storage)
+            return Error::from_errno(ENOMEM);
+
+        auto* old_entries = m_entries;
+        auto* old_controls = m_controls;
+        auto old_capacity = m_capacity;
+
+        m_entries = static_cast<Entry*>(new_storage);
+        m_controls = reinterpret_cast<i8*>(m_entries + new_capacity);
+        m_capacity = new_capacity;
+        m_growth_left = max_load(new_capacity) - m_size;
+        __builtin_memset(m_controls, control_empty, new_capacity + group_size);
+
+        if (!old_entries)
+            return {};
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_controls[i] < 0)
+                continue;
+            auto& entry = old_entries[i];
+            auto hash = KeyTraits::hash(entry.key);
+            auto index = find_first_non_full(hash);
+            set_control(index, control_from_hash(hash));
+            new (&m_entries[index]) Entry { move(entry) };
+            entry.~Entry();
+        }
+
+        kfree_sized(old_entries, size_in_bytes(old_capacity));
+        return {};
+    }
+
+    Entry* m_entries { nullptr };
+    i8* m_controls { nullptr };
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
+    // The number of empty slots that can still be filled before the table has to grow.
+    size_t m_growth_left { 0 };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::FlatHashMap;
+#endif
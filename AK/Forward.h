@@ -104,6 +104,9 @@ class HashMap;
 template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
 using OrderedHashMap = HashMap<K, V, KeyTraits, ValueTraits, true>;
 
+template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
+class FlatHashMap;
+
 template<typename T>
 class Badge;
 
@@ -182,6 +185,7 @@ using AK::Error;
 using AK::ErrorOr;
 using AK::FixedArray;
 using AK::FixedPoint;
+using AK::FlatHashMap;
 using AK::FlyString;
 using AK::Function;
 using AK::GenericLexer;
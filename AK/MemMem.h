@@ -8,10 +8,16 @@
 
 #include <AK/Array.h>
 #include <AK/Assertions.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 
+#ifndef KERNEL
+#    include <AK/SIMD.h>
+#    include <AK/SIMDExtras.h>
+#endif
+
 namespace AK {
 
 namespace Detail {
@@ -165,30 +171,134 @@ requires(requires { (*haystack_begin).data(); (*haystack_begin).size(); })
     return {};
 }
 
+#ifndef KERNEL
+namespace Detail {
+
+ALWAYS_INLINE bool is_all_zero(SIMD::i8x16 mask)
+{
+    auto words = bit_cast<SIMD::u64x2>(mask);
+    return (words[0] | words[1]) == 0;
+}
+
+inline Optional<size_t> simd_find_byte(ReadonlyBytes haystack, u8 needle)
+{
+    auto broadcast_needle = SIMD::expand_to<SIMD::u8x16>(needle);
+
+    size_t offset = 0;
+    for (; offset + sizeof(SIMD::u8x16) <= haystack.size(); offset += sizeof(SIMD::u8x16)) {
+        auto matches = SIMD::load_unaligned<SIMD::u8x16>(haystack.data() + offset) == broadcast_needle;
+        if (!is_all_zero(matches))
+            return offset + count_trailing_zeroes(static_cast<u32>(SIMD::maskbits(matches)));
+    }
+    for (; offset < haystack.size(); ++offset) {
+        if (haystack[offset] == needle)
+            return offset;
+    }
+    return {};
+}
+
+// This is the "generic SIMD" algorithm from http://0x80.pl/articles/simd-strfind.html: For 16 candidate positions at a
+// time, compare two bytes of the needle against the haystack, and only run a full comparison where both of them match.
+inline Optional<size_t> simd_find(ReadonlyBytes haystack, ReadonlyBytes needle, size_t second_probe_index)
+{
+    VERIFY(needle.size() >= 2);
+    VERIFY(second_probe_index > 0 && second_probe_index < needle.size());
+
+    if (haystack.size() < needle.size())
+        return {};
+
+    auto first_byte = SIMD::expand_to<SIMD::u8x16>(needle[0]);
+    auto second_byte = SIMD::expand_to<SIMD::u8x16>(needle[second_probe_index]);
+    auto matches_at = [&](size_t position) {
+        return __builtin_memcmp(haystack.data() + position + 1, needle.data() + 1, needle.size() - 1) == 0;
+    };
+
+    size_t offset = 0;
+    for (; offset + sizeof(SIMD::u8x16) + needle.size() - 1 <= haystack.size(); offset += sizeof(SIMD::u8x16)) {
+        auto first_block = SIMD::load_unaligned<SIMD::u8x16>(haystack.data() + offset);
+        auto second_block = SIMD::load_unaligned<SIMD::u8x16>(haystack.data() + offset + second_probe_index);
+        auto candidates = (first_block == first_byte) & (second_block == second_byte);
+        if (is_all_zero(candidates))
+            continue;
+
+        for (u32 mask = SIMD::maskbits(candidates); mask != 0; mask &= mask - 1) {
+            auto position = offset + count_trailing_zeroes(mask);
+            if (matches_at(position))
+                return position;
+        }
+    }
+
+    for (; offset + needle.size() <= haystack.size(); ++offset) {
+        if (haystack[offset] == needle[0] && haystack[offset + second_probe_index] == needle[second_probe_index] && matches_at(offset))
+            return offset;
+    }
+
+    return {};
+}
+
+}
+#endif
+
+// A substring search with the per-needle setup done up front, so it can be run against many haystacks.
+class SubstringSearcher {
+public:
+    explicit SubstringSearcher(ReadonlyBytes needle)
+        : m_needle(needle)
+    {
+        if (m_needle.size() < 2)
+            return;
+
+        // Probing the first and last byte of the needle works well for most inputs, but is useless when those bytes
+        // are the same (e.g. in "aaaa" or "\n\n"). In that case, pick the last byte that is different from the first one.
+        m_second_probe_index = m_needle.size() - 1;
+        while (m_second_probe_index > 1 && m_needle[m_second_probe_index] == m_needle[0])
+            --m_second_probe_index;
+    }
+
+    ReadonlyBytes needle() const { return m_needle; }
+
+    Optional<size_t> find_in(ReadonlyBytes haystack) const;
+
+private:
+    ReadonlyBytes m_needle;
+    size_t m_second_probe_index { 0 };
+};
+
 inline Optional<size_t> memmem_optional(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
 {
-    if (needle_length == 0)
+    return SubstringSearcher({ static_cast<u8 const*>(needle), needle_length }).find_in({ static_cast<u8 const*>(haystack), haystack_length });
+}
+
+inline Optional<size_t> SubstringSearcher::find_in(ReadonlyBytes haystack) const
+{
+    if (m_needle.is_empty())
         return 0;
 
-    if (haystack_length < needle_length)
+    if (haystack.size() < m_needle.size())
         return {};
 
-    if (haystack_length == needle_length) {
-        if (__builtin_memcmp(haystack, needle, haystack_length) == 0)
+    if (haystack.size() == m_needle.size()) {
+        if (__builtin_memcmp(haystack.data(), m_needle.data(), haystack.size()) == 0)
             return 0;
         return {};
     }
 
-    if (needle_length < 32) {
-        auto const* ptr = Detail::bitap_bitwise(haystack, haystack_length, needle, needle_length);
+#ifndef KERNEL
+    if (m_needle.size() == 1)
+        return Detail::simd_find_byte(haystack, m_needle[0]);
+    return Detail::simd_find(haystack, m_needle, m_second_probe_index);
+#else
+    if (m_needle.size() < 32) {
+        auto const* ptr = Detail::bitap_bitwise(haystack.data(), haystack.size(), m_needle.data(), m_needle.size());
         if (ptr)
-            return static_cast<size_t>((FlatPtr)ptr - (FlatPtr)haystack);
+            return static_cast<size_t>((FlatPtr)ptr - (FlatPtr)haystack.data());
         return {};
     }
 
     // Fallback to KMP.
-    Array<ReadonlyBytes, 1> spans { ReadonlyBytes { (u8 const*)haystack, haystack_length } };
-    return memmem(spans.begin(), spans.end(), { (u8 const*)needle, needle_length });
+    Array<ReadonlyBytes, 1> spans { haystack };
+    return memmem(spans.begin(), spans.end(), m_needle);
+#endif
 }
 
 inline void const* memmem(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
@@ -201,3 +311,7 @@ inline void const* memmem(void const* haystack, size_t haystack_length, void con
 }
 
 }
+
+#if USING_AK_GLOBALLY
+using AK::SubstringSearcher;
+#endif
@@ -437,11 +437,10 @@ Optional<size_t> find_last_not(StringView haystack, char needle)
 Vector<size_t> find_all(StringView haystack, StringView needle)
 {
     Vector<size_t> positions;
+    SubstringSearcher searcher { needle.bytes() };
     size_t current_position = 0;
     while (current_position <= haystack.length()) {
-        auto maybe_position = AK::memmem_optional(
-            haystack.characters_without_null_termination() + current_position, haystack.length() - current_position,
-            needle.characters_without_null_termination(), needle.length());
+        auto maybe_position = searcher.find_in(haystack.bytes().slice(current_position));
         if (!maybe_position.has_value())
             break;
         positions.append(current_position + *maybe_position);
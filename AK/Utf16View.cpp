@@ -65,9 +65,10 @@ ErrorOr<void> code_point_to_utf16(Utf16Data& string, u32 code_point)
 
 size_t utf16_code_unit_length_from_utf8(StringView string)
 {
-    // FIXME: This is inefficient!
-    auto utf16_data = MUST(AK::utf8_to_utf16(string));
-    return Utf16View { utf16_data }.length_in_code_units();
+    size_t length = 0;
+    for (auto code_point : Utf8View { string })
+        length += code_point < first_supplementary_plane_code_point ? 1 : 2;
+    return length;
 }
 
 bool Utf16View::is_high_surrogate(u16 code_unit)
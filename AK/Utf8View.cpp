@@ -6,12 +6,415 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/CPUFeatures.h>
 #include <AK/Debug.h>
 #include <AK/Format.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Utf8View.h>
 
 namespace AK {
 
+template<SIMD::SIMDVector VectorType>
+ALWAYS_INLINE static bool is_all_ascii(VectorType bytes)
+{
+    // Note: GCC ignores dependent vector_size attributes, so we have to spell out the word vector type.
+    using WordVector = Conditional<sizeof(VectorType) == sizeof(SIMD::u64x2), SIMD::u64x2, SIMD::u64x4>;
+    static_assert(sizeof(WordVector) == sizeof(VectorType));
+
+    auto words = bit_cast<WordVector>(bytes);
+    u64 combined = 0;
+    for (size_t i = 0; i < SIMD::vector_length<WordVector>; ++i)
+        combined |= words[i];
+    return (combined & 0x8080808080808080ULL) == 0;
+}
+
+template<SIMD::SIMDVector VectorType>
+ALWAYS_INLINE static size_t ascii_prefix_length(u8 const* bytes, size_t length)
+{
+    constexpr size_t vector_size = sizeof(VectorType);
+    size_t offset = 0;
+
+    // Check four vectors at a time while we are in a long ASCII run, then narrow down to the first non-ASCII byte.
+    for (; offset + 4 * vector_size <= length; offset += 4 * vector_size) {
+        auto a = SIMD::load_unaligned<VectorType>(bytes + offset);
+        auto b = SIMD::load_unaligned<VectorType>(bytes + offset + vector_size);
+        auto c = SIMD::load_unaligned<VectorType>(bytes + offset + 2 * vector_size);
+        auto d = SIMD::load_unaligned<VectorType>(bytes + offset + 3 * vector_size);
+        if (!is_all_ascii(a | b | c | d))
+            break;
+    }
+    for (; offset + vector_size <= length; offset += vector_size) {
+        if (!is_all_ascii(SIMD::load_unaligned<VectorType>(bytes + offset)))
+            break;
+    }
+    while (offset < length && bytes[offset] <= 0x7F)
+        ++offset;
+
+    return offset;
+}
+
+// Returns the length of the well-formed multi-byte sequence at the start of `bytes`, or 0 if it is ill-formed.
+// The accepted byte ranges are those of Table 3-7 in the Unicode Standard, which is equivalent to decoding the
+// sequence and checking it with Utf8View::is_valid_code_point().
+static size_t well_formed_sequence_length(u8 const* bytes, size_t length, Utf8View::AllowSurrogates surrogates)
+{
+    auto in_range = [](u8 byte, u8 lower, u8 upper) { return byte >= lower && byte <= upper; };
+    auto is_continuation = [&](u8 byte) { return in_range(byte, 0x80, 0xBF); };
+
+    u8 leading_byte = bytes[0];
+
+    if (in_range(leading_byte, 0xC2, 0xDF)) {
+        if (length < 2 || !is_continuation(bytes[1]))
+            return 0;
+        return 2;
+    }
+
+    if (in_range(leading_byte, 0xE0, 0xEF)) {
+        if (length < 3)
+            return 0;
+        u8 lower = leading_byte == 0xE0 ? 0xA0 : 0x80;
+        u8 upper = (leading_byte == 0xED && surrogates == Utf8View::AllowSurrogates::No) ? 0x9F : 0xBF;
+        if (!in_range(bytes[1], lower, upper) || !is_continuation(bytes[2]))
+            return 0;
+        return 3;
+    }
+
+    if (in_range(leading_byte, 0xF0, 0xF4)) {
+        if (length < 4)
+            return 0;
+        u8 lower = leading_byte == 0xF0 ? 0x90 : 0x80;
+        u8 upper = leading_byte == 0xF4 ? 0x8F : 0xBF;
+        if (!in_range(bytes[1], lower, upper) || !is_continuation(bytes[2]) || !is_continuation(bytes[3]))
+            return 0;
+        return 4;
+    }
+
+    return 0;
+}
+
+template<SIMD::SIMDVector VectorType>
+ALWAYS_INLINE static bool validate_code_points_impl(u8 const* bytes, size_t length, size_t& valid_bytes, Utf8View::AllowSurrogates surrogates)
+{
+    size_t offset = 0;
+
+    while (offset < length) {
+        offset += ascii_prefix_length<VectorType>(bytes + offset, length - offset);
+
+        while (offset < length && bytes[offset] > 0x7F) {
+            auto sequence_length = well_formed_sequence_length(bytes + offset, length - offset, surrogates);
+            if (sequence_length == 0) {
+                valid_bytes = offset;
+                return false;
+            }
+            offset += sequence_length;
+        }
+    }
+
+    valid_bytes = length;
+    return true;
+}
+
+// Counts the code points in a 16-byte block that starts on a code point boundary, if every multi-byte sequence
+// in it is structurally sound (i.e. each leading byte is followed by exactly the expected continuation bytes).
+// Returns the number of bytes consumed, or 0 if the block needs to be handled by the byte-by-byte decoder.
+// A sequence that is cut off by the end of the block is left for the next iteration.
+ALWAYS_INLINE static size_t count_code_points_in_block(u8 const* bytes, size_t& count)
+{
+    auto block = SIMD::load_unaligned<SIMD::u8x16>(bytes);
+
+    u32 continuation = SIMD::maskbits((block & 0xC0) == 0x80);
+    u32 two_byte_leads = SIMD::maskbits((block & 0xE0) == 0xC0);
+    u32 three_byte_leads = SIMD::maskbits((block & 0xF0) == 0xE0);
+    u32 four_byte_leads = SIMD::maskbits((block & 0xF8) == 0xF0);
+
+    auto expected_continuation = [&] {
+        return ((two_byte_leads | three_byte_leads | four_byte_leads) << 1)
+            | ((three_byte_leads | four_byte_leads) << 2)
+            | (four_byte_leads << 3);
+    };
+
+    size_t consumed = 16;
+    u32 expected = expected_continuation();
+
+    if (expected >> 16) {
+        u32 truncated_leads = (two_byte_leads & 0x8000) | (three_byte_leads & 0xC000) | (four_byte_leads & 0xE000);
+        consumed = count_trailing_zeroes(truncated_leads);
+
+        u32 kept = (1u << consumed) - 1;
+        continuation &= kept;
+        two_byte_leads &= kept;
+        three_byte_leads &= kept;
+        four_byte_leads &= kept;
+        expected = expected_continuation();
+    }
+
+    if (expected != continuation)
+        return 0;
+
+    count += consumed - popcount(continuation);
+    return consumed;
+}
+
+// Similar to Utf8CodePointIterator::operator++, if the byte is not a valid leading byte, try the next byte.
+static constexpr size_t leading_byte_length(u8 byte)
+{
+    if ((byte & 0xE0) == 0xC0)
+        return 2;
+    if ((byte & 0xF0) == 0xE0)
+        return 3;
+    if ((byte & 0xF8) == 0xF0)
+        return 4;
+    return 1;
+}
+
+template<SIMD::SIMDVector VectorType>
+ALWAYS_INLINE static size_t count_code_points_impl(u8 const* bytes, size_t length)
+{
+    size_t count = 0;
+    size_t offset = 0;
+
+    while (offset < length) {
+        auto ascii_length = ascii_prefix_length<VectorType>(bytes + offset, length - offset);
+        count += ascii_length;
+        offset += ascii_length;
+
+        if (offset == length)
+            break;
+
+        if (length - offset >= 16) {
+            if (auto consumed = count_code_points_in_block(bytes + offset, count); consumed != 0) {
+                offset += consumed;
+                continue;
+            }
+        }
+
+        offset += leading_byte_length(bytes[offset]);
+        ++count;
+    }
+
+    return count;
+}
+
+template<CPUFeatures>
+static size_t count_code_points(u8 const*, size_t);
+
+template<CPUFeatures>
+static bool validate_code_points(u8 const*, size_t, size_t&, Utf8View::AllowSurrogates);
+
+template<>
+size_t count_code_points<CPUFeatures::None>(u8 const* bytes, size_t length)
+{
+    return count_code_points_impl<SIMD::u8x16>(bytes, length);
+}
+
+template<>
+bool validate_code_points<CPUFeatures::None>(u8 const* bytes, size_t length, size_t& valid_bytes, Utf8View::AllowSurrogates surrogates)
+{
+    return validate_code_points_impl<SIMD::u8x16>(bytes, length, valid_bytes, surrogates);
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+template<>
+[[gnu::target("avx2")]] size_t count_code_points<CPUFeatures::X86_AVX2>(u8 const* bytes, size_t length)
+{
+    return count_code_points_impl<SIMD::u8x32>(bytes, length);
+}
+
+namespace Detail {
+
+// This is the "lookup" algorithm by John Keiser and Daniel Lemire, see "Validating UTF-8 In Less Than One Instruction
+// Per Byte" (https://arxiv.org/abs/2010.03090). Each pair of adjacent bytes is classified via three 16-entry lookup tables
+// indexed by the high and low nibble of the first byte and the high nibble of the second byte; the bitwise AND of the
+// three lookups is non-zero exactly if the pair cannot occur in well-formed UTF-8. Missing or superfluous third and
+// fourth continuation bytes are detected separately by looking three bytes back.
+enum Utf8Error : u8 {
+    TooShort = 1 << 0,
+    TooLong = 1 << 1,
+    Overlong3 = 1 << 2,
+    TooLarge = 1 << 3,
+    Surrogate = 1 << 4,
+    Overlong2 = 1 << 5,
+    TooLarge1000 = 1 << 6,
+    Overlong4 = 1 << 6,
+    TwoContinuations = 1 << 7,
+    Carry = TooShort | TooLong | TwoContinuations,
+};
+
+template<size_t... Idx>
+static constexpr SIMD::u8x32 duplicate_table(Array<u8, 16> const& table, IndexSequence<Idx...>)
+{
+    return SIMD::u8x32 { table[Idx % 16]... };
+}
+
+static constexpr SIMD::u8x32 duplicate_table(Array<u8, 16> const& table)
+{
+    return duplicate_table(table, MakeIndexSequence<32>());
+}
+
+static constexpr auto first_byte_high_nibble_table = duplicate_table({
+    // 0xxx____ (ASCII)
+    TooLong,
+    TooLong,
+    TooLong,
+    TooLong,
+    TooLong,
+    TooLong,
+    TooLong,
+    TooLong,
+    // 10xx____ (continuation)
+    TwoContinuations,
+    TwoContinuations,
+    TwoContinuations,
+    TwoContinuations,
+    // 1100____ (two-byte lead)
+    TooShort | Overlong2,
+    // 1101____ (two-byte lead)
+    TooShort,
+    // 1110____ (three-byte lead)
+    TooShort | Overlong3 | Surrogate,
+    // 1111____ (four-byte lead)
+    TooShort | TooLarge | TooLarge1000 | Overlong4,
+});
+
+static constexpr auto first_byte_low_nibble_table = duplicate_table({
+    // ____0000
+    Carry | Overlong3 | Overlong2 | Overlong4,
+    // ____0001
+    Carry | Overlong2,
+    // ____001x
+    Carry,
+    Carry,
+    // ____0100
+    Carry | TooLarge,
+    // ____0101 to ____1100
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+    // ____1101
+    Carry | TooLarge | TooLarge1000 | Surrogate,
+    // ____111x
+    Carry | TooLarge | TooLarge1000,
+    Carry | TooLarge | TooLarge1000,
+});
+
+static constexpr auto second_byte_high_nibble_table = duplicate_table({
+    // 0xxx____ (ASCII)
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+    // 1000____
+    TooLong | Overlong2 | TwoContinuations | Overlong3 | TooLarge1000 | Overlong4,
+    // 1001____
+    TooLong | Overlong2 | TwoContinuations | Overlong3 | TooLarge,
+    // 101x____
+    TooLong | Overlong2 | TwoContinuations | Surrogate | TooLarge,
+    TooLong | Overlong2 | TwoContinuations | Surrogate | TooLarge,
+    // 11xx____ (lead)
+    TooShort,
+    TooShort,
+    TooShort,
+    TooShort,
+});
+
+[[gnu::target("avx2")]] ALWAYS_INLINE static SIMD::u8x32 lookup_nibbles(SIMD::u8x32 table, SIMD::u8x32 nibbles)
+{
+    // Note: vpshufb looks up each 128-bit lane separately, which is why the tables are duplicated.
+    return bit_cast<SIMD::u8x32>(__builtin_ia32_pshufb256(bit_cast<SIMD::c8x32>(table), bit_cast<SIMD::c8x32>(nibbles)));
+}
+
+template<size_t N, size_t... Idx>
+[[gnu::target("avx2")]] ALWAYS_INLINE static SIMD::u8x32 shift_in_previous_bytes(SIMD::u8x32 current, SIMD::u8x32 previous, IndexSequence<Idx...>)
+{
+    return __builtin_shufflevector(previous, current, (Idx + 32 - N)...);
+}
+
+template<size_t N>
+[[gnu::target("avx2")]] ALWAYS_INLINE static SIMD::u8x32 shift_in_previous_bytes(SIMD::u8x32 current, SIMD::u8x32 previous)
+{
+    return shift_in_previous_bytes<N>(current, previous, MakeIndexSequence<32>());
+}
+
+[[gnu::target("avx2")]] ALWAYS_INLINE static bool is_all_zero(SIMD::u8x32 bytes)
+{
+    auto words = bit_cast<SIMD::u64x4>(bytes);
+    return (words[0] | words[1] | words[2] | words[3]) == 0;
+}
+
+[[gnu::target("avx2")]] ALWAYS_INLINE static SIMD::u8x32 find_utf8_errors(SIMD::u8x32 current, SIMD::u8x32 previous, u8 allowed_errors)
+{
+    auto previous_1 = shift_in_previous_bytes<1>(current, previous);
+    auto previous_2 = shift_in_previous_bytes<2>(current, previous);
+    auto previous_3 = shift_in_previous_bytes<3>(current, previous);
+
+    auto special_cases = lookup_nibbles(first_byte_high_nibble_table, previous_1 >> 4)
+        & lookup_nibbles(first_byte_low_nibble_table, previous_1 & 0x0F)
+        & lookup_nibbles(second_byte_high_nibble_table, current >> 4);
+    special_cases &= static_cast<u8>(~allowed_errors);
+
+    // The third and fourth byte of a sequence must be continuation bytes. Since the lookups flag every pair of
+    // continuation bytes as TwoContinuations, the expected ones cancel out here.
+    auto must_be_continuation = bit_cast<SIMD::u8x32>((previous_2 >= 0xE0) | (previous_3 >= 0xF0)) & 0x80;
+    return must_be_continuation ^ special_cases;
+}
+
+}
+
+template<>
+[[gnu::target("avx2")]] bool validate_code_points<CPUFeatures::X86_AVX2>(u8 const* bytes, size_t length, size_t& valid_bytes, Utf8View::AllowSurrogates surrogates)
+{
+    using SIMD::u8x32;
+
+    u8 allowed_errors = surrogates == Utf8View::AllowSurrogates::Yes ? Detail::Surrogate : 0;
+    // A block ending in one of these bytes ends in the middle of a multi-byte sequence.
+    constexpr u8x32 maximum_complete_bytes = [&]<size_t... Idx>(IndexSequence<Idx...>) {
+        constexpr u8 last_bytes[] = { 0xF0 - 1, 0xE0 - 1, 0xC0 - 1 };
+        return u8x32 { (Idx < 29 ? static_cast<u8>(0xFF) : last_bytes[Idx - 29])... };
+    }(MakeIndexSequence<32>());
+
+    u8x32 previous {};
+    bool previous_is_incomplete = false;
+    size_t offset = 0;
+
+    for (; offset + sizeof(u8x32) <= length; offset += sizeof(u8x32)) {
+        auto current = SIMD::load_unaligned<u8x32>(bytes + offset);
+
+        if (!is_all_ascii(current) || previous_is_incomplete) {
+            if (!Detail::is_all_zero(Detail::find_utf8_errors(current, previous, allowed_errors)))
+                break;
+        }
+
+        previous_is_incomplete = !Detail::is_all_zero(bit_cast<u8x32>(current > maximum_complete_bytes));
+        previous = current;
+    }
+
+    // Everything before `offset` is well-formed, except for possibly a sequence that straddles it. Let the scalar
+    // validator take over from the start of that sequence to validate the tail, or to pinpoint the exact error.
+    size_t sequence_start = offset;
+    for (size_t distance = 1; distance <= 3 && distance <= offset; ++distance) {
+        if ((bytes[offset - distance] & 0xC0) != 0x80) {
+            sequence_start = offset - distance;
+            break;
+        }
+    }
+
+    bool is_valid = validate_code_points_impl<u8x32>(bytes + sequence_start, length - sequence_start, valid_bytes, surrogates);
+    valid_bytes += sequence_start;
+    return is_valid;
+}
+#endif
+
 Utf8CodePointIterator Utf8View::iterator_at_byte_offset(size_t byte_offset) const
 {
     size_t current_offset = 0;
@@ -72,16 +475,28 @@ Utf8View Utf8View::unicode_substring_view(size_t code_point_offset, size_t code_
 
 size_t Utf8View::calculate_length() const
 {
-    size_t length = 0;
+    static auto const implementation = [] {
+        if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+            if (has_flag(detect_cpu_features(), CPUFeatures::X86_AVX2))
+                return &count_code_points<CPUFeatures::X86_AVX2>;
+        }
+        return &count_code_points<CPUFeatures::None>;
+    }();
 
-    for (size_t i = 0; i < m_string.length(); ++length) {
-        auto [byte_length, code_point, is_valid] = decode_leading_byte(static_cast<u8>(m_string[i]));
+    return implementation(begin_ptr(), m_string.length());
+}
 
-        // Similar to Utf8CodePointIterator::operator++, if the byte is invalid, try the next byte.
-        i += is_valid ? byte_length : 1;
-    }
+bool Utf8View::validate_fast(size_t& valid_bytes, AllowSurrogates surrogates) const
+{
+    static auto const implementation = [] {
+        if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+            if (has_flag(detect_cpu_features(), CPUFeatures::X86_AVX2))
+                return &validate_code_points<CPUFeatures::X86_AVX2>;
+        }
+        return &validate_code_points<CPUFeatures::None>;
+    }();
 
-    return length;
+    return implementation(begin_ptr(), m_string.length(), valid_bytes, surrogates);
 }
 
 bool Utf8View::starts_with(Utf8View const& start) const
@@ -135,6 +135,10 @@ public:
 
     constexpr bool validate(size_t& valid_bytes, AllowSurrogates surrogates = AllowSurrogates::Yes) const
     {
+        // OPTIMIZATION: At runtime, use the vectorized validator which skips over runs of ASCII bytes.
+        if (!is_constant_evaluated())
+            return validate_fast(valid_bytes, surrogates);
+
         valid_bytes = 0;
 
         for (auto it = m_string.begin(); it != m_string.end(); ++it) {
@@ -215,6 +219,7 @@ private:
     u8 const* begin_ptr() const { return reinterpret_cast<u8 const*>(m_string.characters_without_null_termination()); }
     u8 const* end_ptr() const { return begin_ptr() + m_string.length(); }
     size_t calculate_length() const;
+    bool validate_fast(size_t& valid_bytes, AllowSurrogates) const;
 
     struct Utf8EncodedByteData {
         size_t byte_length { 0 };
@@ -63,6 +63,7 @@ set(FUTEXQUEUE_DEBUG ON)
 set(FUTEX_DEBUG ON)
 set(GEMINI_DEBUG ON)
 set(GENERATE_DEBUG ON)
+set(GENERATIONAL_GC_DEBUG ON)
 set(GHASH_PROCESS_DEBUG ON)
 set(GIF_DEBUG ON)
 set(GLOBAL_DTORS_DEBUG ON)
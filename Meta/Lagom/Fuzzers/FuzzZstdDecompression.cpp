@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCompress/Zstd.h>
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const* data, size_t size)
+{
+    AK::set_debug_enabled(false);
+
+    auto stream = make<FixedMemoryStream>(ReadonlyBytes { data, size });
+    auto decompressor_or_error = Compress::ZstdDecompressor::construct(move(stream));
+    if (decompressor_or_error.is_error())
+        return 0;
+    auto decompressor = decompressor_or_error.release_value();
+    while (!decompressor->is_eof()) {
+        auto maybe_error = decompressor->discard(4096);
+        if (maybe_error.is_error())
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCompress/Zstd.h>
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const* data, size_t size)
+{
+    AK::set_debug_enabled(false);
+
+    AllocatingMemoryStream stream {};
+
+    auto compressor = MUST(Compress::ZstdCompressor::construct(MaybeOwned<Stream> { stream }));
+    MUST(compressor->write_until_depleted({ data, size }));
+    MUST(compressor->final_flush());
+
+    auto decompressor = MUST(Compress::ZstdDecompressor::construct(MaybeOwned<Stream> { stream }));
+    auto result = MUST(decompressor->read_until_eof());
+
+    VERIFY((ReadonlyBytes { data, size }) == result.span());
+
+    return 0;
+}
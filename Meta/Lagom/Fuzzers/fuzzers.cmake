@@ -69,6 +69,8 @@ set(FUZZER_TARGETS
     XML
     Zip
     ZlibDecompression
+    ZstdDecompression
+    ZstdRoundtrip
 )
 
 if (TARGET LibWeb)
@@ -144,3 +146,5 @@ set(FUZZER_DEPENDENCIES_WOFF2 LibGfx)
 set(FUZZER_DEPENDENCIES_XML LibXML)
 set(FUZZER_DEPENDENCIES_Zip LibArchive)
 set(FUZZER_DEPENDENCIES_ZlibDecompression LibCompress)
+set(FUZZER_DEPENDENCIES_ZstdDecompression LibCompress)
+set(FUZZER_DEPENDENCIES_ZstdRoundtrip LibCompress)
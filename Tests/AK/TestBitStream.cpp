@@ -218,6 +218,86 @@ TEST_CASE(bit_reads_beyond_stream_limits)
     }
 }
 
+TEST_CASE(little_endian_bit_stream_fill_bit_buffer)
+{
+    Array<u8, 9> const test_data { 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0x42 };
+    auto memory_stream = make<FixedMemoryStream>(test_data);
+    LittleEndianInputBitStream bit_stream { move(memory_stream) };
+
+    TRY_OR_FAIL(bit_stream.fill_bit_buffer());
+    EXPECT_EQ(bit_stream.buffered_bit_count(), 64u);
+    EXPECT_EQ(bit_stream.buffered_bits(), 0xEFCDAB8967452301u);
+
+    bit_stream.discard_previously_peeked_bits(12);
+    TRY_OR_FAIL(bit_stream.fill_bit_buffer());
+    EXPECT_EQ(bit_stream.buffered_bit_count(), 60u);
+    EXPECT_EQ(bit_stream.buffered_bits(), 0x42EFCDAB8967452u);
+
+    // Filling the buffer at the end of the stream is not an error.
+    bit_stream.discard_previously_peeked_bits(56);
+    TRY_OR_FAIL(bit_stream.fill_bit_buffer());
+    EXPECT_EQ(bit_stream.buffered_bit_count(), 4u);
+    EXPECT_EQ(bit_stream.buffered_bits(), 0x4u);
+}
+
+// Hands out its data one byte per read, like a pipe that only ever has a single byte available.
+class TrickleStream final : public Stream {
+public:
+    explicit TrickleStream(ReadonlyBytes data)
+        : m_data(data)
+    {
+    }
+
+    virtual ErrorOr<Bytes> read_some(Bytes bytes) override
+    {
+        m_read_count++;
+        if (bytes.is_empty() || m_data.is_empty())
+            return bytes.trim(0);
+        bytes[0] = m_data[0];
+        m_data = m_data.slice(1);
+        return bytes.trim(1);
+    }
+
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override { return Error::from_errno(EBADF); }
+    virtual bool is_eof() const override { return m_data.is_empty(); }
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+    size_t read_count() const { return m_read_count; }
+
+private:
+    ReadonlyBytes m_data;
+    size_t m_read_count { 0 };
+};
+
+TEST_CASE(little_endian_bit_stream_fill_bit_buffer_reads_only_what_is_required)
+{
+    Array<u8, 4> const test_data { 0x01, 0x23, 0x45, 0x67 };
+    auto trickle_stream = make<TrickleStream>(test_data);
+    auto& trickle_stream_ref = *trickle_stream;
+    LittleEndianInputBitStream bit_stream { move(trickle_stream) };
+
+    // Without a requirement, the buffer is topped up with a single read.
+    TRY_OR_FAIL(bit_stream.fill_bit_buffer());
+    EXPECT_EQ(trickle_stream_ref.read_count(), 1u);
+    EXPECT_EQ(bit_stream.buffered_bit_count(), 8u);
+
+    // Otherwise, reading stops as soon as enough bits are there.
+    TRY_OR_FAIL(bit_stream.fill_bit_buffer(20));
+    EXPECT_EQ(trickle_stream_ref.read_count(), 3u);
+    EXPECT_EQ(bit_stream.buffered_bit_count(), 24u);
+    EXPECT_EQ(bit_stream.buffered_bits(), 0x452301u);
+
+    TRY_OR_FAIL(bit_stream.fill_bit_buffer(20));
+    EXPECT_EQ(trickle_stream_ref.read_count(), 4u);
+    EXPECT_EQ(bit_stream.buffered_bit_count(), 32u);
+
+    // Requiring more than the stream has is not an error.
+    TRY_OR_FAIL(bit_stream.fill_bit_buffer(40));
+    EXPECT_EQ(bit_stream.buffered_bit_count(), 32u);
+    EXPECT_EQ(bit_stream.buffered_bits(), 0x67452301u);
+}
+
 RANDOMIZED_TEST_CASE(roundtrip_u8_little_endian)
 {
     GEN(n, Gen::number_u64(NumericLimits<u8>::max()));
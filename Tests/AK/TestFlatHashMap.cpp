@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteString.h>
+#include <AK/FlatHashMap.h>
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <AK/String.h>
+
+TEST_CASE(construct)
+{
+    using IntIntMap = FlatHashMap<int, int>;
+    EXPECT(IntIntMap().is_empty());
+    EXPECT_EQ(IntIntMap().size(), 0u);
+    EXPECT_EQ(IntIntMap().capacity(), 0u);
+    EXPECT(!IntIntMap().contains(0));
+}
+
+TEST_CASE(construct_from_initializer_list)
+{
+    FlatHashMap<int, ByteString> number_to_string {
+        { 1, "One" },
+        { 2, "Two" },
+        { 3, "Three" },
+    };
+    EXPECT_EQ(number_to_string.size(), 3u);
+    EXPECT_EQ(number_to_string.get(2).value(), "Two");
+}
+
+TEST_CASE(set_get_and_replace)
+{
+    FlatHashMap<int, ByteString> number_to_string;
+    EXPECT_EQ(number_to_string.set(1, "One"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(2, "Two"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(1, "Uno"), AK::HashSetResult::ReplacedExistingEntry);
+
+    EXPECT_EQ(number_to_string.size(), 2u);
+    EXPECT_EQ(number_to_string.get(1).value(), "Uno");
+    EXPECT_EQ(number_to_string.get(2).value(), "Two");
+    EXPECT(!number_to_string.get(3).has_value());
+}
+
+TEST_CASE(range_loop)
+{
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 100; ++i)
+        map.set(i, i * 2);
+
+    int loop_counter = 0;
+    int key_sum = 0;
+    for (auto& [key, value] : map) {
+        EXPECT_EQ(value, key * 2);
+        key_sum += key;
+        ++loop_counter;
+    }
+    EXPECT_EQ(loop_counter, 100);
+    EXPECT_EQ(key_sum, 99 * 100 / 2);
+}
+
+TEST_CASE(remove)
+{
+    FlatHashMap<int, ByteString> number_to_string;
+    number_to_string.set(1, "One");
+    number_to_string.set(2, "Two");
+    number_to_string.set(3, "Three");
+
+    EXPECT_EQ(number_to_string.remove(1), true);
+    EXPECT_EQ(number_to_string.remove(1), false);
+    EXPECT_EQ(number_to_string.size(), 2u);
+    EXPECT(number_to_string.find(1) == number_to_string.end());
+    EXPECT(number_to_string.find(2) != number_to_string.end());
+
+    EXPECT_EQ(number_to_string.take(3), "Three");
+    EXPECT(!number_to_string.take(3).has_value());
+    EXPECT_EQ(number_to_string.size(), 1u);
+}
+
+TEST_CASE(remove_all_matching)
+{
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 1000; ++i)
+        map.set(i, i);
+
+    EXPECT(map.remove_all_matching([](int key, int) { return key % 3 != 0; }));
+    EXPECT_EQ(map.size(), 334u);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(map.contains(i), i % 3 == 0);
+
+    EXPECT(!map.remove_all_matching([](int, int) { return false; }));
+}
+
+TEST_CASE(many_insertions_and_removals)
+{
+    // Keep the size roughly constant while cycling through many keys, which leaves plenty of deleted slots behind.
+    FlatHashMap<u32, u32> map;
+    for (u32 i = 0; i < 100'000; ++i) {
+        map.set(i, ~i);
+        if (i >= 500)
+            EXPECT(map.remove(i - 500));
+    }
+
+    EXPECT_EQ(map.size(), 500u);
+    EXPECT(map.capacity() <= 2048u);
+    for (u32 i = 99'500; i < 100'000; ++i)
+        EXPECT_EQ(map.get(i), ~i);
+    EXPECT(!map.contains(99'499u));
+}
+
+TEST_CASE(ensure_capacity)
+{
+    FlatHashMap<int, int> map;
+    map.ensure_capacity(1000);
+    auto capacity = map.capacity();
+    EXPECT(capacity >= 1000u);
+
+    for (int i = 0; i < 1000; ++i)
+        map.set(i, i);
+    EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST_CASE(ensure)
+{
+    FlatHashMap<ByteString, int> map;
+    map.ensure("counter") += 1;
+    map.ensure("counter") += 1;
+    EXPECT_EQ(map.ensure("other", [] { return 42; }), 42);
+    EXPECT_EQ(map.get("counter").value(), 2);
+    EXPECT_EQ(map.size(), 2u);
+}
+
+TEST_CASE(hash_compatible_lookups)
+{
+    FlatHashMap<String, int> map;
+    map.set("foo"_string, 1);
+    map.set("bar"_string, 2);
+
+    EXPECT(map.contains("foo"sv));
+    EXPECT_EQ(map.get("bar"sv), 2);
+    EXPECT(map.find("baz"sv) == map.end());
+    EXPECT(map.remove("foo"sv));
+    EXPECT(!map.contains("foo"_string));
+}
+
+TEST_CASE(non_trivial_values)
+{
+    FlatHashMap<int, NonnullOwnPtr<int>> map;
+    for (int i = 0; i < 100; ++i)
+        map.set(i, make<int>(i));
+
+    // Growing the table has to move the values rather than copy them.
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(*map.get(i).value(), i);
+
+    auto moved_map = move(map);
+    EXPECT(map.is_empty());
+    EXPECT_EQ(moved_map.size(), 100u);
+
+    moved_map.clear_with_capacity();
+    EXPECT(moved_map.is_empty());
+    EXPECT(moved_map.capacity() > 0u);
+}
+
+TEST_CASE(copy_and_clone)
+{
+    FlatHashMap<ByteString, int> map;
+    map.set("one", 1);
+    map.set("two", 2);
+
+    auto copy = map;
+    auto clone = MUST(map.clone());
+    map.set("one", 100);
+
+    EXPECT_EQ(copy.get("one"), 1);
+    EXPECT_EQ(clone.get("one"), 1);
+    EXPECT_EQ(clone.get("two"), 2);
+    EXPECT_EQ(clone.size(), 2u);
+}
+
+TEST_CASE(colliding_hashes)
+{
+    // All keys land in the same group and share the control byte, so lookups have to fall back to comparing keys.
+    struct CollidingTraits : public Traits<int> {
+        static unsigned hash(int) { return 0; }
+    };
+
+    FlatHashMap<int, int, CollidingTraits> map;
+    for (int i = 0; i < 200; ++i)
+        map.set(i, -i);
+    for (int i = 0; i < 200; i += 2)
+        EXPECT(map.remove(i));
+    for (int i = 0; i < 200; ++i)
+        EXPECT_EQ(map.get(i), i % 2 ? Optional<int>(-i) : Optional<int> {});
+    EXPECT_EQ(map.size(), 100u);
+}
+
+static constexpr size_t benchmark_key_count = 200'000;
+
+static Vector<ByteString> make_benchmark_keys()
+{
+    Vector<ByteString> keys;
+    keys.ensure_capacity(benchmark_key_count);
+    for (size_t i = 0; i < benchmark_key_count; ++i)
+        keys.unchecked_append(ByteString::formatted("property-{}-{}", i * 2654435761u % 1000003, i));
+    return keys;
+}
+
+template<typename Map>
+static void benchmark_insert(Vector<ByteString> const& keys)
+{
+    for (size_t round = 0; round < 5; ++round) {
+        Map map;
+        for (size_t i = 0; i < keys.size(); ++i)
+            map.set(keys[i], i);
+        EXPECT_EQ(map.size(), keys.size());
+    }
+}
+
+template<typename Map>
+static void benchmark_lookup(Vector<ByteString> const& keys)
+{
+    Map map;
+    for (size_t i = 0; i < keys.size(); i += 2)
+        map.set(keys[i], i);
+
+    // Half of the lookups hit and half of them miss.
+    size_t found = 0;
+    for (size_t round = 0; round < 10; ++round) {
+        for (auto const& key : keys)
+            found += map.contains(key);
+    }
+    EXPECT_EQ(found, keys.size() / 2 * 10);
+}
+
+template<typename Map>
+static void benchmark_erase(Vector<ByteString> const& keys)
+{
+    for (size_t round = 0; round < 5; ++round) {
+        Map map;
+        for (size_t i = 0; i < keys.size(); ++i)
+            map.set(keys[i], i);
+        for (auto const& key : keys)
+            map.remove(key);
+        EXPECT(map.is_empty());
+    }
+}
+
+BENCHMARK_CASE(insert_strings_hash_map)
+{
+    benchmark_insert<HashMap<ByteString, size_t>>(make_benchmark_keys());
+}
+
+BENCHMARK_CASE(insert_strings_flat_hash_map)
+{
+    benchmark_insert<FlatHashMap<ByteString, size_t>>(make_benchmark_keys());
+}
+
+BENCHMARK_CASE(lookup_strings_hash_map)
+{
+    benchmark_lookup<HashMap<ByteString, size_t>>(make_benchmark_keys());
+}
+
+BENCHMARK_CASE(lookup_strings_flat_hash_map)
+{
+    benchmark_lookup<FlatHashMap<ByteString, size_t>>(make_benchmark_keys());
+}
+
+BENCHMARK_CASE(erase_strings_hash_map)
+{
+    benchmark_erase<HashMap<ByteString, size_t>>(make_benchmark_keys());
+}
+
+BENCHMARK_CASE(erase_strings_flat_hash_map)
+{
+    benchmark_erase<FlatHashMap<ByteString, size_t>>(make_benchmark_keys());
+}
@@ -135,6 +135,44 @@ TEST_CASE(kmp_match_order)
     EXPECT_EQ(result_1_b.value_or(9), 6u);
 }
 
+TEST_CASE(memmem_long_haystack)
+{
+    // Place the needle at every offset around the 16-byte blocks of the vectorized search.
+    for (size_t offset = 0; offset < 80; ++offset) {
+        Array<u8, 100> haystack {};
+        haystack.fill('a');
+        haystack[offset] = 'x';
+        haystack[offset + 1] = 'a';
+        haystack[offset + 2] = 'y';
+
+        auto needle = "xay"sv;
+        EXPECT_EQ(AK::memmem_optional(haystack.data(), haystack.size(), needle.characters_without_null_termination(), needle.length()), offset);
+
+        auto single_byte_needle = "y"sv;
+        EXPECT_EQ(AK::memmem_optional(haystack.data(), haystack.size(), single_byte_needle.characters_without_null_termination(), 1), offset + 2);
+
+        auto missing_needle = "xaz"sv;
+        EXPECT(!AK::memmem_optional(haystack.data(), haystack.size(), missing_needle.characters_without_null_termination(), missing_needle.length()).has_value());
+    }
+}
+
+TEST_CASE(substring_searcher)
+{
+    auto haystack = "aaaa-aaaa-aaab-aaaa-aaab"sv;
+
+    AK::SubstringSearcher searcher { "aaab"sv.bytes() };
+    EXPECT_EQ(searcher.find_in(haystack.bytes()), 10u);
+    EXPECT_EQ(searcher.find_in(haystack.bytes().slice(11)), 9u);
+    EXPECT(!searcher.find_in(haystack.bytes().slice(21)).has_value());
+
+    AK::SubstringSearcher repeated_searcher { "aaaa"sv.bytes() };
+    EXPECT_EQ(repeated_searcher.find_in(haystack.bytes()), 0u);
+    EXPECT_EQ(repeated_searcher.find_in(haystack.bytes().slice(1)), 4u);
+
+    AK::SubstringSearcher empty_searcher { ReadonlyBytes {} };
+    EXPECT_EQ(empty_searcher.find_in(haystack.bytes()), 0u);
+}
+
 TEST_CASE(timing_safe_compare)
 {
     ByteString data_set = "abcdefghijklmnopqrstuvwxyz123456789";
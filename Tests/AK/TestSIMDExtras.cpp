@@ -1397,3 +1397,12 @@ TEST_CASE(elementwise_byte_reverse_u64x4)
         EXPECT_EQ(result[i], expected[i]);
     }
 }
+
+TEST_CASE(maskbits_i8x16)
+{
+    u8 const input[] = { 0x00, 0x80, 0x7f, 0xff, 0x01, 0x81, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0 };
+    auto v = AK::SIMD::load_unaligned<AK::SIMD::u8x16>(&input[0]);
+
+    EXPECT_EQ(AK::SIMD::maskbits(v >= 0x80), 0b1000'0000'0010'1010);
+    EXPECT_EQ(AK::SIMD::maskbits(v == 0x00), 0b0111'1111'1100'0001);
+}
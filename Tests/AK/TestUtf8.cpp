@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/ByteBuffer.h>
+#include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 
 TEST_CASE(decode_ascii)
@@ -128,6 +129,125 @@ TEST_CASE(validate_overlong_utf8)
     EXPECT(valid_bytes == 2);
 }
 
+static size_t leading_byte_length(u8 byte)
+{
+    if (byte < 0x80)
+        return 1;
+    if ((byte & 0xE0) == 0xC0)
+        return 2;
+    if ((byte & 0xF0) == 0xE0)
+        return 3;
+    if ((byte & 0xF8) == 0xF0)
+        return 4;
+    return 0;
+}
+
+static size_t encoded_length(u32 code_point)
+{
+    if (code_point < 0x80)
+        return 1;
+    if (code_point < 0x800)
+        return 2;
+    if (code_point < 0x10000)
+        return 3;
+    if (code_point <= 0x10FFFF)
+        return 4;
+    return 0;
+}
+
+// Byte-by-byte validation, equivalent to what Utf8View::validate() does during constant evaluation.
+static bool validate_byte_by_byte(StringView string, size_t& valid_bytes)
+{
+    valid_bytes = 0;
+    for (size_t i = 0; i < string.length();) {
+        auto byte = static_cast<u8>(string[i]);
+        auto byte_length = leading_byte_length(byte);
+        if (byte_length == 0 || i + byte_length > string.length())
+            return false;
+
+        u32 code_point = byte_length == 1 ? byte : byte & (0x7F >> byte_length);
+        for (size_t j = 1; j < byte_length; ++j) {
+            auto continuation = static_cast<u8>(string[i + j]);
+            if ((continuation & 0xC0) != 0x80)
+                return false;
+            code_point = (code_point << 6) | (continuation & 0x3F);
+        }
+
+        if (encoded_length(code_point) != byte_length)
+            return false;
+
+        valid_bytes += byte_length;
+        i += byte_length;
+    }
+    return true;
+}
+
+// Byte-by-byte code point counting, which skips invalid leading bytes one at a time like Utf8View::length().
+static size_t length_byte_by_byte(StringView string)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < string.length(); ++length) {
+        auto byte_length = leading_byte_length(static_cast<u8>(string[i]));
+        i += byte_length == 0 ? 1 : byte_length;
+    }
+    return length;
+}
+
+TEST_CASE(validate_long_utf8)
+{
+    // Long enough inputs go through the vectorized code paths; put the interesting bytes around every block boundary.
+    constexpr StringView fragments[] = { "\u00E9"sv, "\u4E16"sv, "\U0001F600"sv, "\xED\xA0\x80"sv, "a"sv };
+    constexpr StringView invalid_fragments[] = { "\xC0\xAF"sv, "\xE0\x80\xAF"sv, "\xF4\x90\x80\x80"sv, "\x80"sv, "\xFF"sv, "\xE4\xB8"sv, "\xF0\x9F\x98"sv };
+
+    for (size_t prefix_length = 0; prefix_length < 70; ++prefix_length) {
+        for (auto fragment : fragments) {
+            StringBuilder builder;
+            builder.append_repeated('x', prefix_length);
+            builder.append(fragment);
+            builder.append_repeated('y', 70);
+            auto string = builder.to_byte_string();
+            Utf8View view { string.view() };
+
+            size_t valid_bytes = 0;
+            EXPECT(view.validate(valid_bytes));
+            EXPECT_EQ(valid_bytes, string.length());
+            EXPECT_EQ(view.length(), prefix_length + 71);
+        }
+
+        for (auto fragment : invalid_fragments) {
+            StringBuilder builder;
+            builder.append_repeated('x', prefix_length);
+            builder.append("\u00E9"sv);
+            builder.append(fragment);
+            builder.append_repeated('y', 70);
+            auto string = builder.to_byte_string();
+            Utf8View view { string.view() };
+
+            size_t valid_bytes = 0;
+            EXPECT(!view.validate(valid_bytes));
+            EXPECT_EQ(valid_bytes, prefix_length + 2);
+            EXPECT_EQ(view.length(), length_byte_by_byte(string));
+        }
+    }
+}
+
+TEST_CASE(validate_long_utf8_surrogates)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 20; ++i)
+        builder.append("abc\u00E9"sv);
+    builder.append("\xED\xA0\x80"sv);
+    builder.append_repeated('z', 40);
+    auto string = builder.to_byte_string();
+    Utf8View view { string.view() };
+
+    size_t valid_bytes = 0;
+    EXPECT(view.validate(valid_bytes, Utf8View::AllowSurrogates::Yes));
+    EXPECT_EQ(valid_bytes, string.length());
+    EXPECT(!view.validate(valid_bytes, Utf8View::AllowSurrogates::No));
+    EXPECT_EQ(valid_bytes, 100u);
+}
+
 TEST_CASE(iterate_utf8)
 {
     Utf8View view("Some weird characters \u00A9\u266A\uA755"sv);
@@ -323,3 +443,57 @@ TEST_CASE(for_each_split_view)
     EXPECT_EQ(gather(SplitBehavior::KeepEmpty | SplitBehavior::KeepTrailingSeparator),
         Vector({ "."sv, "."sv, "."sv, "Well."sv, "."sv, "hello."sv, "friends!."sv, "."sv, "."sv, ""sv }));
 }
+
+static ByteString make_benchmark_text(StringView fragment)
+{
+    StringBuilder builder;
+    while (builder.length() < 4 * MiB)
+        builder.append(fragment);
+    return builder.to_byte_string();
+}
+
+BENCHMARK_CASE(validate_ascii)
+{
+    auto text = make_benchmark_text("The quick brown fox jumps over the lazy dog. "sv);
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT(Utf8View { text.view() }.validate());
+}
+
+BENCHMARK_CASE(validate_ascii_byte_by_byte)
+{
+    auto text = make_benchmark_text("The quick brown fox jumps over the lazy dog. "sv);
+    size_t valid_bytes = 0;
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT(validate_byte_by_byte(text, valid_bytes));
+}
+
+BENCHMARK_CASE(validate_mixed)
+{
+    auto text = make_benchmark_text("Hello, \u043C\u0438\u0440! \u3053\u3093\u306B\u3061\u306F \U0001F600 "sv);
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT(Utf8View { text.view() }.validate());
+}
+
+BENCHMARK_CASE(validate_mixed_byte_by_byte)
+{
+    auto text = make_benchmark_text("Hello, \u043C\u0438\u0440! \u3053\u3093\u306B\u3061\u306F \U0001F600 "sv);
+    size_t valid_bytes = 0;
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT(validate_byte_by_byte(text, valid_bytes));
+}
+
+BENCHMARK_CASE(length_mixed)
+{
+    auto text = make_benchmark_text("Hello, \u043C\u0438\u0440! \u3053\u3093\u306B\u3061\u306F \U0001F600 "sv);
+    auto expected_length = length_byte_by_byte(text);
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(Utf8View { text.view() }.length(), expected_length);
+}
+
+BENCHMARK_CASE(length_mixed_byte_by_byte)
+{
+    auto text = make_benchmark_text("Hello, \u043C\u0438\u0440! \u3053\u3093\u306B\u3061\u306F \U0001F600 "sv);
+    auto expected_length = Utf8View { text.view() }.length();
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(length_byte_by_byte(text), expected_length);
+}
@@ -10,14 +10,18 @@
 #include <AK/BitStream.h>
 #include <AK/MemoryStream.h>
 #include <AK/Random.h>
+#include <AK/StringBuilder.h>
 #include <LibCompress/Deflate.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <cstring>
 
 #ifdef AK_OS_SERENITY
 #    define TEST_INPUT(x) ("/usr/Tests/LibCompress/deflate-test-files/" x)
+#    define CORPUS_INPUT(x) ("/usr/Tests/LibCompress/brotli-test-files/" x)
 #else
 #    define TEST_INPUT(x) ("deflate-test-files/" x)
+#    define CORPUS_INPUT(x) ("brotli-test-files/" x)
 #endif
 
 TEST_CASE(canonical_code_simple)
@@ -69,6 +73,30 @@ TEST_CASE(invalid_canonical_code)
     EXPECT(Compress::CanonicalCode::from_bytes(code).is_error());
 }
 
+TEST_CASE(canonical_code_long_codes)
+{
+    // A complete code with lengths from 1 to 15 bits, so that both literal pairs and sub-table lookups get decoded.
+    Array<u8, 288> code {};
+    Array<u32, 16> symbols;
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        symbols[i] = i * 18;
+        code[symbols[i]] = min<size_t>(i + 1, 15);
+    }
+
+    auto const huffman = TRY_OR_FAIL(Compress::CanonicalCode::from_bytes(code, Compress::HuffmanDecodingTable::LiteralPairs::Yes));
+
+    AllocatingMemoryStream memory_stream;
+    LittleEndianOutputBitStream output_stream { MaybeOwned<Stream>(memory_stream) };
+    for (size_t i = 0; i < 1000; ++i)
+        TRY_OR_FAIL(huffman.write_symbol(output_stream, symbols[(i * 7) % symbols.size()]));
+    TRY_OR_FAIL(output_stream.align_to_byte_boundary());
+    TRY_OR_FAIL(output_stream.flush_buffer_to_stream());
+
+    LittleEndianInputBitStream input_stream { MaybeOwned<Stream>(memory_stream) };
+    for (size_t i = 0; i < 1000; ++i)
+        EXPECT_EQ(TRY_OR_FAIL(huffman.read_symbol(input_stream)), symbols[(i * 7) % symbols.size()]);
+}
+
 TEST_CASE(deflate_decompress_compressed_block)
 {
     Array<u8, 28> const compressed {
@@ -179,6 +207,94 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed == original);
 }
 
+static ByteBuffer generate_log_lines(size_t line_count)
+{
+    // Something that looks like a typical log file, with a lot of short repetitions and some unique bits in between
+    constexpr Array levels { "info"sv, "debug"sv, "warning"sv, "error"sv };
+    constexpr Array messages { "Connection established"sv, "Request completed"sv, "Cache miss, fetching resource"sv, "Retrying after timeout"sv, "Closing idle connection"sv };
+    StringBuilder builder;
+    u32 state = 1;
+    for (size_t i = 0; i < line_count; ++i) {
+        state = state * 1103515245 + 12345;
+        builder.appendff("2024-03-{:02} 12:{:02}:{:02}.{:03} [{}] worker-{}: {} (id={})\n", 1 + (i / 5000) % 28, (i / 60) % 60, i % 60, state % 1000,
+            levels[(state >> 8) % levels.size()], (state >> 12) % 8, messages[(state >> 16) % messages.size()], state >> 4);
+    }
+    return MUST(builder.to_byte_buffer());
+}
+
+TEST_CASE(deflate_round_trip_all_levels)
+{
+    auto original = generate_log_lines(2000);
+    EXPECT(original.size() > Compress::DeflateCompressor::block_size * 2);
+
+    Vector<size_t> compressed_sizes;
+    for (int level = 0; level <= Compress::DeflateCompressor::max_compression_level; ++level) {
+        auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, static_cast<Compress::DeflateCompressor::CompressionLevel>(level)));
+        auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+        EXPECT(uncompressed == original);
+        compressed_sizes.append(compressed.size());
+    }
+
+    auto size_for = [&](auto level) { return compressed_sizes[static_cast<int>(level)]; };
+    EXPECT(size_for(Compress::DeflateCompressor::CompressionLevel::FAST) < size_for(Compress::DeflateCompressor::CompressionLevel::STORE) / 3);
+    EXPECT(size_for(Compress::DeflateCompressor::CompressionLevel::GOOD) < size_for(Compress::DeflateCompressor::CompressionLevel::FAST));
+    EXPECT(size_for(Compress::DeflateCompressor::CompressionLevel::BEST) < size_for(Compress::DeflateCompressor::CompressionLevel::GOOD));
+}
+
+TEST_CASE(deflate_round_trip_matches_across_blocks)
+{
+    // Repeat a chunk of random data with a period that doesn't line up with the block size, so most of the matches have to reach into the previous block
+    constexpr size_t period = 24 * KiB;
+    auto original = ByteBuffer::create_uninitialized(period * 5).release_value();
+    fill_with_random(original.bytes().trim(period));
+    for (size_t i = period; i < original.size(); ++i)
+        original[i] = original[i - period];
+
+    for (int level = 1; level <= Compress::DeflateCompressor::max_compression_level; ++level) {
+        auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, static_cast<Compress::DeflateCompressor::CompressionLevel>(level)));
+        auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+        EXPECT(uncompressed == original);
+        EXPECT(compressed.size() < period * 3 / 2);
+    }
+}
+
+TEST_CASE(deflate_round_trip_long_codes)
+{
+    // Byte frequencies that follow the Fibonacci sequence lead to the longest possible Huffman codes.
+    Vector<u8> original;
+    size_t previous_count = 1, count = 1;
+    for (u8 byte = 0; byte < 24; ++byte) {
+        for (size_t i = 0; i < count; ++i)
+            original.append(byte);
+        count = exchange(previous_count, count) + count;
+    }
+    for (size_t i = original.size() - 1; i > 0; --i)
+        swap(original[i], original[get_random_uniform(i + 1)]);
+
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::FAST));
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed.span() == original.span());
+}
+
+TEST_CASE(deflate_round_trip_parallel)
+{
+    // Use several chunks with repeating content, so that back references into the preceding chunk's data are possible
+    auto size = Compress::ParallelDeflateCompressor::chunk_size * 5 + 1234;
+    auto original = ByteBuffer::create_uninitialized(size).release_value();
+    fill_with_random(original.bytes().trim(4096));
+    for (size_t i = 4096; i < size; ++i)
+        original[i] = original[i % 4096] ^ (i % 1021 == 0);
+
+    auto compressed = TRY_OR_FAIL(Compress::ParallelDeflateCompressor::compress_all(original, 3, Compress::DeflateCompressor::CompressionLevel::FAST));
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+    EXPECT(compressed.size() < size / 10);
+
+    auto compressed_empty = TRY_OR_FAIL(Compress::ParallelDeflateCompressor::compress_all({}, 2));
+    auto uncompressed_empty = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed_empty));
+    EXPECT(uncompressed_empty.is_empty());
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
@@ -203,3 +319,27 @@ TEST_CASE(ossfuzz_58046)
     auto test_data = TRY_OR_FAIL(test_file->read_until_eof());
     EXPECT(Compress::DeflateDecompressor::decompress_all(test_data).is_error());
 }
+
+BENCHMARK_CASE(deflate_compression_levels)
+{
+    Vector<ByteBuffer> corpus;
+    for (auto path : { CORPUS_INPUT("KaticaRegular10.font"sv), CORPUS_INPUT("happy3rd.html"sv), CORPUS_INPUT("serenityos.html"sv), CORPUS_INPUT("transform.txt"sv) }) {
+        auto file = TRY_OR_FAIL(Core::File::open(path, Core::File::OpenMode::Read));
+        corpus.append(TRY_OR_FAIL(file->read_until_eof()));
+    }
+    corpus.append(generate_log_lines(50000));
+
+    for (int level = 0; level <= Compress::DeflateCompressor::max_compression_level; ++level) {
+        size_t uncompressed_size = 0;
+        size_t compressed_size = 0;
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        for (auto const& input : corpus) {
+            auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(input, static_cast<Compress::DeflateCompressor::CompressionLevel>(level)));
+            uncompressed_size += input.size();
+            compressed_size += compressed.size();
+        }
+        auto elapsed_microseconds = max(timer.elapsed_time().to_microseconds(), 1);
+        warnln("level {}: {} -> {} bytes ({:.1}%), {:.1} MB/s", level, uncompressed_size, compressed_size,
+            100.0 * compressed_size / uncompressed_size, static_cast<double>(uncompressed_size) / elapsed_microseconds);
+    }
+}
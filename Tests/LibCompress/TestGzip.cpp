@@ -7,7 +7,9 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/Array.h>
+#include <AK/MemoryStream.h>
 #include <AK/Random.h>
+#include <AK/StringBuilder.h>
 #include <LibCompress/Gzip.h>
 
 TEST_CASE(gzip_decompress_simple)
@@ -94,6 +96,16 @@ TEST_CASE(gzip_round_trip)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(gzip_round_trip_parallel)
+{
+    auto original = ByteBuffer::create_zeroed(Compress::ParallelDeflateCompressor::chunk_size * 4 + 17).release_value();
+    fill_with_random(original.bytes().slice(0, 8192));
+    fill_with_random(original.bytes().slice(300000, 8192));
+    auto compressed = TRY_OR_FAIL(Compress::ParallelGzipCompressor::compress_all(original, 4));
+    auto uncompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(gzip_truncated_uncompressed_block)
 {
     Array<u8, 38> const compressed {
@@ -105,3 +117,76 @@ TEST_CASE(gzip_truncated_uncompressed_block)
     auto const decompressed_or_error = Compress::GzipDecompressor::decompress_all(compressed);
     EXPECT(decompressed_or_error.is_error());
 }
+
+static ByteBuffer generate_seekable_test_data()
+{
+    // Repetitive enough for plenty of back-references across checkpoints, but not so much that everything is one match.
+    StringBuilder builder;
+    u32 state = 1;
+    for (size_t i = 0; i < 20000; ++i) {
+        state = state * 1103515245 + 12345;
+        builder.appendff("line {} of the log, request {} took {} ms\n", i, state % 1000, (state >> 16) % 97);
+    }
+    return MUST(builder.to_byte_buffer());
+}
+
+TEST_CASE(gzip_index_seek)
+{
+    auto original = generate_seekable_test_data();
+
+    // Two members, to make sure that checkpoints work across member boundaries as well.
+    auto split = original.size() / 3;
+    auto compressed = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(original.bytes().trim(split)));
+    compressed.append(TRY_OR_FAIL(Compress::GzipCompressor::compress_all(original.bytes().slice(split))));
+
+    FixedMemoryStream index_input { compressed.bytes() };
+    auto index = TRY_OR_FAIL(Compress::GzipIndex::build(index_input, 64 * KiB));
+    EXPECT_EQ(index.uncompressed_size(), original.size());
+    EXPECT_EQ(index.compressed_size(), compressed.size());
+
+    // Checkpoints can only be taken at block boundaries, so they end up somewhat further apart than requested.
+    EXPECT(index.checkpoints().size() >= original.size() / (128 * KiB));
+
+    // The index is meant to be stored alongside the file, so use one that went through serialization.
+    AllocatingMemoryStream serialized_index;
+    TRY_OR_FAIL(index.write_to_stream(serialized_index));
+    auto read_index = TRY_OR_FAIL(Compress::GzipIndex::read_from_stream(serialized_index));
+    EXPECT_EQ(read_index.checkpoints().size(), index.checkpoints().size());
+
+    auto input = TRY_OR_FAIL(try_make<FixedMemoryStream>(compressed.bytes()));
+    auto decompressor = TRY_OR_FAIL(Compress::SeekableGzipDecompressor::create(move(input), move(read_index)));
+
+    Array<u8, 3000> buffer;
+    auto check_at = [&](size_t offset) {
+        EXPECT_EQ(TRY_OR_FAIL(decompressor->seek(offset, SeekMode::SetPosition)), offset);
+        auto length = min(buffer.size(), original.size() - offset);
+        TRY_OR_FAIL(decompressor->read_until_filled(buffer.span().trim(length)));
+        EXPECT_EQ(buffer.span().trim(length), original.bytes().slice(offset, length));
+        EXPECT_EQ(TRY_OR_FAIL(decompressor->tell()), offset + length);
+    };
+
+    check_at(original.size() - 100);
+    check_at(0);
+    check_at(split - 10);
+    check_at(original.size() / 2);
+    check_at(original.size() / 2 + 5000);
+    check_at(12345);
+    for (auto const& checkpoint : index.checkpoints())
+        check_at(checkpoint.uncompressed_offset);
+
+    TRY_OR_FAIL(decompressor->seek(-50, SeekMode::FromEndPosition));
+    auto tail = TRY_OR_FAIL(decompressor->read_until_eof());
+    EXPECT_EQ(tail.bytes(), original.bytes().slice_from_end(50));
+}
+
+TEST_CASE(gzip_index_rejects_other_file)
+{
+    auto original = generate_seekable_test_data();
+    auto compressed = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(original));
+
+    FixedMemoryStream index_input { compressed.bytes() };
+    auto index = TRY_OR_FAIL(Compress::GzipIndex::build(index_input));
+
+    auto input = TRY_OR_FAIL(try_make<FixedMemoryStream>(compressed.bytes().slice(1)));
+    EXPECT(Compress::SeekableGzipDecompressor::create(move(input), move(index)).is_error());
+}
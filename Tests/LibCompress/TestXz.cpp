@@ -6,6 +6,7 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/ByteString.h>
 #include <AK/MemoryStream.h>
 #include <LibCompress/Xz.h>
 
@@ -965,6 +966,9 @@ TEST_CASE(xz_utils_bad_2_index_1)
     auto decompressor = MUST(Compress::XzDecompressor::create(move(stream)));
     auto buffer_or_error = decompressor->read_until_eof(PAGE_SIZE);
     EXPECT(buffer_or_error.is_error());
+
+    // The parallel decoder reads the Index up front and has to notice the same mismatch.
+    EXPECT(Compress::XzDecompressor::decompress_all(compressed, 2).is_error());
 }
 
 TEST_CASE(xz_utils_bad_2_index_2)
@@ -1243,6 +1247,9 @@ TEST_CASE(xz_utils_good_0catpad_empty)
     auto decompressor = MUST(Compress::XzDecompressor::create(move(stream)));
     auto buffer = TRY_OR_FAIL(decompressor->read_until_eof(PAGE_SIZE));
     EXPECT_EQ(buffer.size(), 0ul);
+
+    auto parallel_buffer = TRY_OR_FAIL(Compress::XzDecompressor::decompress_all(compressed, 2));
+    EXPECT_EQ(parallel_buffer.size(), 0ul);
 }
 
 TEST_CASE(xz_utils_good_0_empty)
@@ -1939,6 +1946,69 @@ TEST_CASE(xz_utils_good_2_lzma2)
     auto decompressor = MUST(Compress::XzDecompressor::create(move(stream)));
     auto buffer = TRY_OR_FAIL(decompressor->read_until_eof(PAGE_SIZE));
     EXPECT_EQ(buffer.span(), xz_utils_hello_world.bytes());
+
+    for (size_t thread_count : { 0, 2, 3 }) {
+        auto parallel_buffer = TRY_OR_FAIL(Compress::XzDecompressor::decompress_all(compressed, thread_count));
+        EXPECT_EQ(parallel_buffer.span(), xz_utils_hello_world.bytes());
+    }
+}
+
+TEST_CASE(xz_concatenated_streams_with_blocks)
+{
+    // This is good-2-lzma2.xz twice, with four-byte Stream Padding between the Streams.
+    Array<u8, 92> const stream {
+        0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, 0x01, 0x69, 0x22, 0xDE, 0x36, 0x02, 0x00, 0x21, 0x01,
+        0x08, 0x00, 0x00, 0x00, 0xD8, 0x0F, 0x23, 0x13, 0x01, 0x00, 0x05, 0x48, 0x65, 0x6C, 0x6C, 0x6F,
+        0x0A, 0x00, 0x00, 0x00, 0x16, 0x35, 0x96, 0x31, 0x02, 0x00, 0x21, 0x01, 0x08, 0x00, 0x00, 0x00,
+        0xD8, 0x0F, 0x23, 0x13, 0x01, 0x00, 0x06, 0x57, 0x6F, 0x72, 0x6C, 0x64, 0x21, 0x0A, 0x00, 0x00,
+        0xDD, 0xD1, 0xCA, 0x53, 0x00, 0x02, 0x1A, 0x06, 0x1B, 0x07, 0x00, 0x00, 0x06, 0xDC, 0xE7, 0x5D,
+        0x3E, 0x30, 0x0D, 0x8B, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x59, 0x5A
+    };
+
+    ByteBuffer compressed;
+    compressed.append(stream);
+    compressed.append(Array<u8, 4> {});
+    compressed.append(stream);
+
+    auto expected = ByteString::formatted("{}{}", xz_utils_hello_world, xz_utils_hello_world);
+
+    auto buffer = TRY_OR_FAIL(Compress::XzDecompressor::decompress_all(compressed));
+    EXPECT_EQ(buffer.span(), expected.bytes());
+
+    auto parallel_buffer = TRY_OR_FAIL(Compress::XzDecompressor::decompress_all(compressed, 2));
+    EXPECT_EQ(parallel_buffer.span(), expected.bytes());
+}
+
+TEST_CASE(xz_seek_through_block_index)
+{
+    // This is good-2-lzma2.xz, which has "Hello\n" and "World!\n" in two separate Blocks.
+    Array<u8, 92> const compressed {
+        0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, 0x01, 0x69, 0x22, 0xDE, 0x36, 0x02, 0x00, 0x21, 0x01,
+        0x08, 0x00, 0x00, 0x00, 0xD8, 0x0F, 0x23, 0x13, 0x01, 0x00, 0x05, 0x48, 0x65, 0x6C, 0x6C, 0x6F,
+        0x0A, 0x00, 0x00, 0x00, 0x16, 0x35, 0x96, 0x31, 0x02, 0x00, 0x21, 0x01, 0x08, 0x00, 0x00, 0x00,
+        0xD8, 0x0F, 0x23, 0x13, 0x01, 0x00, 0x06, 0x57, 0x6F, 0x72, 0x6C, 0x64, 0x21, 0x0A, 0x00, 0x00,
+        0xDD, 0xD1, 0xCA, 0x53, 0x00, 0x02, 0x1A, 0x06, 0x1B, 0x07, 0x00, 0x00, 0x06, 0xDC, 0xE7, 0x5D,
+        0x3E, 0x30, 0x0D, 0x8B, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x59, 0x5A
+    };
+
+    auto decompressor = TRY_OR_FAIL(Compress::ParallelXzDecompressor::create(compressed, 1));
+    EXPECT_EQ(TRY_OR_FAIL(decompressor->size()), xz_utils_hello_world.length());
+
+    EXPECT_EQ(TRY_OR_FAIL(decompressor->seek(8, SeekMode::SetPosition)), 8ul);
+    auto buffer = TRY_OR_FAIL(decompressor->read_until_eof());
+    EXPECT_EQ(buffer.span(), xz_utils_hello_world.substring_view(8).bytes());
+
+    EXPECT_EQ(TRY_OR_FAIL(decompressor->seek(2, SeekMode::SetPosition)), 2ul);
+    Array<u8, 3> partial;
+    TRY_OR_FAIL(decompressor->read_until_filled(partial));
+    EXPECT_EQ(partial.span(), "llo"sv.bytes());
+    EXPECT_EQ(TRY_OR_FAIL(decompressor->tell()), 5ul);
+
+    EXPECT_EQ(TRY_OR_FAIL(decompressor->seek(-4, SeekMode::FromEndPosition)), 9ul);
+    buffer = TRY_OR_FAIL(decompressor->read_until_eof());
+    EXPECT_EQ(buffer.span(), "ld!\n"sv.bytes());
+
+    EXPECT(decompressor->seek(1, SeekMode::FromEndPosition).is_error());
 }
 
 // The following test files are designated as "unsupported", which usually means that they test indicators
@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/Array.h>
+#include <AK/ByteReader.h>
 #include <AK/MemoryStream.h>
 #include <LibCompress/Zlib.h>
 
@@ -81,3 +82,19 @@ TEST_CASE(zlib_decompress_with_missing_end_bits)
     auto decompressed = TRY_OR_FAIL(decompressor->read_until_eof());
     EXPECT_EQ(decompressed.span(), uncompressed.span());
 }
+
+TEST_CASE(zlib_round_trip_parallel)
+{
+    auto original = ByteBuffer::create_zeroed(300000).release_value();
+    for (size_t i = 0; i < original.size(); ++i)
+        original[i] = (i * i) >> 7;
+    auto compressed = TRY_OR_FAIL(Compress::ZlibCompressor::compress_all(original, Compress::ZlibCompressionLevel::Default, 2));
+
+    auto stream = make<FixedMemoryStream>(compressed.bytes());
+    auto decompressor = TRY_OR_FAIL(Compress::ZlibDecompressor::create(move(stream)));
+    auto decompressed = TRY_OR_FAIL(decompressor->read_until_eof());
+    EXPECT(decompressed == original);
+
+    auto checksum = ByteReader::load32(compressed.bytes().slice_from_end(4).data());
+    EXPECT_EQ(AK::convert_between_host_and_big_endian(checksum), Crypto::Checksum::Adler32(original).digest());
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/MemoryStream.h>
+#include <AK/Random.h>
+#include <LibCompress/Zstd.h>
+
+static ByteBuffer generate_word_salad(size_t word_count)
+{
+    static constexpr Array words { "zstandard"sv, "frame"sv, "block"sv, "literal"sv, "sequence"sv, "offset"sv, "match"sv, "huffman"sv, "entropy"sv, "window"sv, "checksum"sv, "serenity"sv };
+
+    StringBuilder builder;
+    u32 state = 1;
+    for (size_t i = 0; i < word_count; ++i) {
+        state = (state * 1103515245 + 12345) & 0x7fffffff;
+        builder.append(words[(state >> 16) % words.size()]);
+        builder.append(i % 8 == 7 ? '\n' : ' ');
+    }
+    return MUST(builder.to_byte_buffer());
+}
+
+TEST_CASE(zstd_decompress_reference_frame)
+{
+    // Generated with `zstd -19 --no-check`, this uses Huffman-coded literals with FSE-compressed weights and
+    // FSE-compressed tables for all three sequence fields.
+    Array<u8, 547> const compressed {
+        0x28, 0xB5, 0x2F, 0xFD, 0x60, 0xFC, 0x0A, 0xCD, 0x10, 0x00, 0x02, 0x06, 0x12, 0x11, 0xB0, 0xEB,
+        0xE4, 0xA1, 0x68, 0x5A, 0x8A, 0x18, 0x32, 0x8A, 0x56, 0x27, 0x49, 0x54, 0x82, 0x03, 0x3A, 0xFF,
+        0xFF, 0x7F, 0x03, 0xAF, 0x5B, 0x7F, 0x42, 0x95, 0x58, 0xF3, 0xBE, 0xB7, 0x8D, 0x91, 0x16, 0x29,
+        0x1B, 0x82, 0xA9, 0x60, 0xED, 0x16, 0x7F, 0x94, 0x6D, 0x97, 0x93, 0x24, 0xB4, 0xA2, 0x84, 0x5D,
+        0x78, 0xD9, 0x36, 0x56, 0x34, 0x86, 0x23, 0xF9, 0x92, 0xE0, 0xF2, 0x12, 0xB9, 0x66, 0xC2, 0x92,
+        0x90, 0x26, 0xA4, 0x03, 0x02, 0x80, 0xF9, 0xA8, 0xA1, 0x2F, 0x4A, 0x61, 0xBF, 0x0E, 0x20, 0x44,
+        0x40, 0x0C, 0x62, 0xB0, 0xEA, 0x01, 0x21, 0x08, 0x82, 0x10, 0x05, 0x98, 0x10, 0x24, 0x30, 0x35,
+        0x1A, 0x14, 0x16, 0xA4, 0x30, 0xEC, 0x06, 0x8D, 0x9B, 0x15, 0x88, 0x02, 0x09, 0xA9, 0x27, 0x0C,
+        0x37, 0x9B, 0x65, 0x86, 0x6C, 0xF7, 0x9A, 0xD1, 0x35, 0x46, 0xFF, 0x03, 0x9F, 0x45, 0x6C, 0x75,
+        0x33, 0x08, 0x81, 0xDF, 0x32, 0xA2, 0x6E, 0x6A, 0x3C, 0xD3, 0x59, 0xBA, 0x11, 0x1B, 0x04, 0x78,
+        0xA1, 0x4C, 0x7B, 0x69, 0x5B, 0x58, 0xF9, 0xDA, 0x21, 0x30, 0xE5, 0xBF, 0x38, 0xC3, 0xC5, 0xF3,
+        0xB6, 0x90, 0x9F, 0x7D, 0x2F, 0x5E, 0x45, 0x49, 0x17, 0xA6, 0xAA, 0x67, 0x4E, 0x56, 0x22, 0x8F,
+        0x54, 0x49, 0xE9, 0x2E, 0x95, 0x8D, 0x64, 0x30, 0x4B, 0x7A, 0xD9, 0x62, 0xD1, 0xAF, 0x86, 0x5B,
+        0x14, 0x46, 0x30, 0x25, 0x9D, 0x2D, 0x25, 0xB0, 0x93, 0x98, 0x2A, 0x6A, 0xF1, 0x88, 0x47, 0xBC,
+        0x89, 0xED, 0x02, 0x90, 0x4A, 0x34, 0x54, 0x4A, 0x83, 0x80, 0xC2, 0x0E, 0x49, 0xDF, 0xCE, 0xC6,
+        0x55, 0x64, 0x0F, 0x94, 0x5A, 0xA6, 0x23, 0xBE, 0xC9, 0x16, 0x68, 0xDD, 0xDE, 0xA0, 0xB7, 0x83,
+        0x69, 0xB8, 0xE0, 0xEB, 0x26, 0x64, 0xF8, 0xC6, 0x70, 0x43, 0x40, 0xB5, 0x1A, 0xCF, 0x5C, 0x08,
+        0x34, 0x7D, 0xA5, 0xC6, 0x37, 0x09, 0xB3, 0x60, 0xB5, 0x05, 0x73, 0x78, 0xF7, 0xA3, 0x20, 0xF5,
+        0x78, 0xE1, 0xDB, 0xF3, 0x85, 0x50, 0x69, 0x14, 0xC3, 0x11, 0x7D, 0x9B, 0x77, 0x22, 0xB2, 0xE9,
+        0x13, 0x92, 0x1D, 0x56, 0x72, 0x10, 0x80, 0x5C, 0xA1, 0xF7, 0x2B, 0xD7, 0xCC, 0xC5, 0x38, 0x6E,
+        0x20, 0x4B, 0x28, 0x51, 0x54, 0x04, 0xFB, 0x90, 0x98, 0xBA, 0x2E, 0x70, 0x23, 0x30, 0x12, 0xD0,
+        0x58, 0x1A, 0xE9, 0x6C, 0xBB, 0x1B, 0xEE, 0x40, 0xB3, 0xBB, 0xEF, 0xA5, 0x62, 0x9B, 0xD9, 0xA5,
+        0xD8, 0xEB, 0x28, 0xAE, 0xE7, 0x80, 0x5B, 0xFC, 0x40, 0x8F, 0xA7, 0x0A, 0x72, 0x58, 0xCC, 0x94,
+        0x29, 0x42, 0x04, 0xCF, 0x41, 0x74, 0x3B, 0x0C, 0x0D, 0xE2, 0x67, 0x8F, 0x81, 0xA0, 0x6F, 0x68,
+        0x99, 0xA8, 0x53, 0xA0, 0x77, 0x42, 0x6C, 0xF9, 0x90, 0x77, 0x25, 0xAA, 0x7D, 0xCC, 0x21, 0x34,
+        0x4D, 0x90, 0xAB, 0xAB, 0x11, 0x00, 0x56, 0xC4, 0xBA, 0x34, 0x65, 0x24, 0xD4, 0x46, 0x12, 0xE8,
+        0x6C, 0x15, 0x0A, 0xD6, 0x16, 0x49, 0xED, 0x09, 0xB7, 0xBD, 0xCB, 0xF9, 0xFB, 0x8A, 0x86, 0x3F,
+        0xFB, 0xA0, 0x73, 0x02, 0x2E, 0xAA, 0x23, 0xAD, 0x0E, 0x97, 0x20, 0xA6, 0x7F, 0x50, 0x6F, 0x19,
+        0xD4, 0x49, 0xA9, 0x07, 0xCE, 0xB1, 0x9D, 0x34, 0xA0, 0x83, 0x12, 0xB8, 0xE6, 0xCE, 0x83, 0xD3,
+        0xFC, 0xE1, 0x68, 0xF2, 0x29, 0x9C, 0xAA, 0x2B, 0x36, 0x78, 0x1E, 0x66, 0xD4, 0x4B, 0xE1, 0xF8,
+        0x82, 0x93, 0x9A, 0xAC, 0x3B, 0x3C, 0x8E, 0x67, 0x2C, 0xEF, 0x27, 0xDE, 0x0A, 0x99, 0xFA, 0x01,
+        0x1E, 0x99, 0x7C, 0x74, 0x43, 0xF6, 0x06, 0x69, 0x4A, 0xE7, 0xB2, 0x0B, 0x2F, 0xD3, 0x5E, 0x03,
+        0x9D, 0xA1, 0x30, 0xE6, 0xB6, 0x5E, 0xE5, 0x8F, 0xA9, 0xCD, 0x04, 0xE5, 0xDB, 0x7F, 0x5E, 0xEA,
+        0x03, 0xAB, 0xD0, 0xA6, 0xA9, 0xD3, 0x09, 0x49, 0x0D, 0x31, 0x08, 0x0A, 0xA3, 0x14, 0x5B, 0x5E,
+        0x35, 0xB9, 0x6A,
+    };
+
+    auto decompressed = TRY_OR_FAIL(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed, generate_word_salad(400));
+}
+
+TEST_CASE(zstd_decompress_raw_and_rle_blocks)
+{
+    Array<u8, 36> const compressed {
+        // Skippable Frame
+        0x50, 0x2A, 0x4D, 0x18, // Magic_Number
+        0x03, 0x00, 0x00, 0x00, // Frame_Size
+        0x01, 0x02, 0x03,       // User_Data
+
+        // Zstandard Frame
+        0x28, 0xB5, 0x2F, 0xFD, // Magic_Number
+        0x20,                   // Frame_Header_Descriptor (Single_Segment_Flag, 1-byte Frame_Content_Size)
+        0x08,                   // Frame_Content_Size
+        //   Raw_Block
+        0x18, 0x00, 0x00, // Block_Header (Block_Size = 3)
+        0x61, 0x62, 0x63,
+        //   RLE_Block
+        0x2B, 0x00, 0x00, // Block_Header (Last_Block, Block_Size = 5)
+        0x78,
+
+        // Zstandard Frame
+        0x28, 0xB5, 0x2F, 0xFD, // Magic_Number
+        0x20,                   // Frame_Header_Descriptor (Single_Segment_Flag, 1-byte Frame_Content_Size)
+        0x00,                   // Frame_Content_Size
+        //   Raw_Block
+        0x01, 0x00, 0x00, // Block_Header (Last_Block, Block_Size = 0)
+    };
+
+    auto decompressed = TRY_OR_FAIL(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.bytes(), "abcxxxxx"sv.bytes());
+}
+
+TEST_CASE(zstd_decompress_checksum)
+{
+    Array<u8, 18> compressed {
+        0x28, 0xB5, 0x2F, 0xFD, // Magic_Number
+        0x04,                   // Frame_Header_Descriptor (Content_Checksum_Flag)
+        0x58,                   // Window_Descriptor
+        //   Raw_Block
+        0x29, 0x00, 0x00, // Block_Header (Last_Block, Block_Size = 5)
+        0x68, 0x65, 0x6C, 0x6C, 0x6F,
+        0xA3, 0x6D, 0x9F, 0x88, // Content_Checksum
+    };
+
+    auto decompressed = TRY_OR_FAIL(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.bytes(), "hello"sv.bytes());
+
+    compressed[compressed.size() - 1] ^= 1;
+    EXPECT(Compress::ZstdDecompressor::decompress_all(compressed).is_error());
+
+    // Truncating the frame anywhere has to be reported as well.
+    for (size_t size = 1; size < compressed.size(); ++size)
+        EXPECT(Compress::ZstdDecompressor::decompress_all(compressed.span().trim(size)).is_error());
+}
+
+TEST_CASE(zstd_round_trip)
+{
+    auto round_trip = [](ReadonlyBytes input) -> ErrorOr<size_t> {
+        auto compressed = TRY(Compress::ZstdCompressor::compress_all(input));
+        auto decompressed = TRY(Compress::ZstdDecompressor::decompress_all(compressed));
+        EXPECT_EQ(decompressed.bytes(), input);
+        return compressed.size();
+    };
+
+    TRY_OR_FAIL(round_trip({}));
+    TRY_OR_FAIL(round_trip("a"sv.bytes()));
+
+    Array<u8, 300 * KiB> zeroes {};
+    EXPECT(TRY_OR_FAIL(round_trip(zeroes)) < 64);
+
+    auto text = generate_word_salad(100'000);
+    EXPECT(TRY_OR_FAIL(round_trip(text)) < text.size() / 4);
+
+    Array<u8, 200 * KiB> random;
+    fill_with_random(random);
+    EXPECT(TRY_OR_FAIL(round_trip(random)) < random.size() + 64);
+}
+
+TEST_CASE(zstd_streaming_round_trip)
+{
+    // This is large enough to move the compressor's window at least once.
+    auto input = generate_word_salad(500'000);
+    EXPECT(input.size() > 3 * Compress::ZstdCompressor::window_size);
+
+    AllocatingMemoryStream compressed_stream;
+    {
+        auto compressor = TRY_OR_FAIL(Compress::ZstdCompressor::construct(MaybeOwned<Stream>(compressed_stream)));
+        for (size_t offset = 0; offset < input.size(); offset += 1000)
+            TRY_OR_FAIL(compressor->write_until_depleted(input.bytes().slice(offset, min<size_t>(1000, input.size() - offset))));
+        // The compressor finishes the frame when it is destroyed.
+    }
+
+    auto decompressor = TRY_OR_FAIL(Compress::ZstdDecompressor::construct(MaybeOwned<Stream>(compressed_stream)));
+    ByteBuffer output;
+    Array<u8, 777> buffer;
+    while (!decompressor->is_eof()) {
+        auto read = TRY_OR_FAIL(decompressor->read_some(buffer));
+        output.append(read);
+    }
+    EXPECT_EQ(output, input);
+}
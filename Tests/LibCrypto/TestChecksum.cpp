@@ -6,6 +6,7 @@
 
 #include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibCrypto/Checksum/XXHash64.h>
 #include <LibCrypto/Checksum/cksum.h>
 #include <LibTest/TestCase.h>
 #include <arpa/inet.h>
@@ -64,3 +65,83 @@ TEST_CASE(test_crc32)
     do_test("The quick brown fox jumps over the lazy dog"sv.bytes(), 0x414FA339);
     do_test("various CRC algorithms input data"sv.bytes(), 0x9BD366AE);
 }
+
+TEST_CASE(test_crc32c)
+{
+    auto do_test = [](ReadonlyBytes input, u32 expected_result) {
+        auto digest = Crypto::Checksum::CRC32C(input).digest();
+        EXPECT_EQ(digest, expected_result);
+    };
+
+    do_test(""sv.bytes(), 0x0);
+    do_test("123456789"sv.bytes(), 0xE3069283);
+    do_test("The quick brown fox jumps over the lazy dog"sv.bytes(), 0x22620404);
+}
+
+TEST_CASE(test_checksums_of_long_inputs)
+{
+    // These are long enough to go through the vectorized implementations, if the CPU has them.
+    auto do_test = [](ReadonlyBytes input, u32 expected_crc32, u32 expected_crc32c, u32 expected_adler32) {
+        EXPECT_EQ(Crypto::Checksum::CRC32(input).digest(), expected_crc32);
+        EXPECT_EQ(Crypto::Checksum::CRC32C(input).digest(), expected_crc32c);
+        EXPECT_EQ(Crypto::Checksum::Adler32(input).digest(), expected_adler32);
+
+        // Feeding the input in uneven pieces makes them start at every possible alignment.
+        Crypto::Checksum::CRC32 crc32;
+        Crypto::Checksum::CRC32C crc32c;
+        Crypto::Checksum::Adler32 adler32;
+        for (size_t offset = 0, piece_size = 1; offset < input.size(); offset += piece_size, piece_size = piece_size % 131 + 1) {
+            auto piece = input.slice(offset, min(piece_size, input.size() - offset));
+            crc32.update(piece);
+            crc32c.update(piece);
+            adler32.update(piece);
+        }
+        EXPECT_EQ(crc32.digest(), expected_crc32);
+        EXPECT_EQ(crc32c.digest(), expected_crc32c);
+        EXPECT_EQ(adler32.digest(), expected_adler32);
+    };
+
+    Array<u8, 10000> pattern;
+    for (size_t i = 0; i < pattern.size(); ++i)
+        pattern[i] = i * i + 7 * i;
+    do_test(pattern, 0xC945A3A7, 0x7D1018FE, 0x80625F3E);
+
+    Array<u8, 100000> all_ones;
+    all_ones.fill(0xFF);
+    do_test(all_ones, 0x68C6CEC4, 0x2F0B8293, 0x149A302C);
+}
+
+TEST_CASE(test_xxhash64)
+{
+    auto do_test = [](ReadonlyBytes input, u64 expected_result) {
+        auto digest = Crypto::Checksum::XXHash64(input).digest();
+        EXPECT_EQ(digest, expected_result);
+
+        // Feeding the input in pieces that don't line up with the 32-byte stripes has to give the same result.
+        Crypto::Checksum::XXHash64 xxhash64;
+        for (size_t offset = 0; offset < input.size(); offset += 5)
+            xxhash64.update(input.slice(offset, min<size_t>(5, input.size() - offset)));
+        EXPECT_EQ(xxhash64.digest(), expected_result);
+    };
+
+    do_test(""sv.bytes(), 0xEF46DB3751D8E999);
+    do_test("a"sv.bytes(), 0xD24EC4F1A98C6E5B);
+    do_test("abc"sv.bytes(), 0x44BC2CF5AD770999);
+    do_test("The quick brown fox jumps over the lazy dog"sv.bytes(), 0x0B242D361FDA71BC);
+}
+
+TEST_CASE(test_checksum_combine)
+{
+    auto input = "The quick brown fox jumps over the lazy dog"sv.bytes();
+
+    for (size_t split = 0; split <= input.size(); ++split) {
+        auto first = input.trim(split);
+        auto second = input.slice(split);
+
+        auto crc32 = Crypto::Checksum::CRC32::combine(Crypto::Checksum::CRC32(first).digest(), Crypto::Checksum::CRC32(second).digest(), second.size());
+        EXPECT_EQ(crc32, 0x414FA339u);
+
+        auto adler32 = Crypto::Checksum::Adler32::combine(Crypto::Checksum::Adler32(first).digest(), Crypto::Checksum::Adler32(second).digest(), second.size());
+        EXPECT_EQ(adler32, Crypto::Checksum::Adler32(input).digest());
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/MemoryStream.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Profiler.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static constexpr auto source = R"(function inner(n) { let sum = 0; for (let i = 0; i < n; ++i) sum += i; return sum; }
+function outer() { let total = 0; for (let i = 0; i < 200; ++i) total += inner(1000); return total; }
+outer();
+)"sv;
+
+// NOTE: The profiler keeps the functions' AST nodes alive, so it has to go away before the VM does.
+static NonnullOwnPtr<JS::Bytecode::Profiler> run_under_profiler(JS::VM& vm)
+{
+    auto execution_context = JS::create_simple_execution_context<JS::GlobalObject>(vm);
+    auto script = JS::Script::parse(source, *execution_context->realm, "profiled.js"sv);
+    VERIFY(!script.is_error());
+
+    // Sample as often as possible, so every function that runs for a while shows up.
+    vm.bytecode_interpreter().start_profiling(Duration::from_microseconds(1));
+    auto result = vm.bytecode_interpreter().run(script.value());
+    auto profiler = vm.bytecode_interpreter().stop_profiling();
+    vm.pop_execution_context();
+    VERIFY(!result.is_error());
+    EXPECT_EQ(result.value(), JS::Value(200 * 499500));
+    return profiler.release_nonnull();
+}
+
+static ByteString written_by(auto write)
+{
+    AllocatingMemoryStream stream;
+    MUST(write(stream));
+    auto buffer = MUST(stream.read_until_eof());
+    return ByteString { StringView { buffer.bytes() } };
+}
+
+TEST_CASE(collapsed_stacks)
+{
+    auto vm = MUST(JS::VM::create());
+    auto profiler = run_under_profiler(*vm);
+    EXPECT(profiler->sample_count() > 0);
+
+    auto output = written_by([&](Stream& stream) { return profiler->write_collapsed_stacks(stream); });
+
+    size_t total_samples = 0;
+    bool saw_inner = false;
+    for (auto line : output.split_view('\n')) {
+        auto separator = line.find_last(' ');
+        VERIFY(separator.has_value());
+        auto stack = line.substring_view(0, *separator);
+        auto count = line.substring_view(*separator + 1).to_number<u64>();
+        EXPECT(count.has_value());
+        EXPECT(count.value_or(0) > 0);
+        total_samples += count.value_or(0);
+
+        EXPECT(stack.starts_with("(top-level) (profiled.js)"sv));
+        if (stack == "(top-level) (profiled.js);outer (profiled.js:2:20);inner (profiled.js:1:21)"sv)
+            saw_inner = true;
+    }
+    EXPECT_EQ(total_samples, profiler->sample_count());
+    EXPECT(saw_inner);
+}
+
+TEST_CASE(instruction_statistics)
+{
+    auto vm = MUST(JS::VM::create());
+    auto profiler = run_under_profiler(*vm);
+    auto output = written_by([&](Stream& stream) { return profiler->write_instruction_statistics(stream); });
+
+    HashMap<StringView, u64> counts;
+    auto lines = output.split_view('\n');
+    EXPECT(lines.first().starts_with("Instruction"sv));
+    for (auto line : lines.span().slice(1)) {
+        auto columns = line.split_view(' ');
+        VERIFY(columns.size() >= 2);
+        counts.set(columns[0], columns[1].to_number<u64>().value());
+    }
+
+    // One call of outer() and 200 of inner(), each returning once.
+    EXPECT_EQ(counts.get("Call"sv), 201u);
+    EXPECT_EQ(counts.get("Return"sv), 201u);
+    // Every iteration of inner()'s loop adds to the sum.
+    EXPECT(counts.get("Add"sv).value_or(0) >= 200 * 1000);
+}
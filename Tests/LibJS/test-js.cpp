@@ -80,6 +80,24 @@ TESTJS_GLOBAL_FUNCTION(mark_as_garbage, markAsGarbage)
     return JS::js_undefined();
 }
 
+TESTJS_GLOBAL_FUNCTION(collect_young_generation, collectYoungGeneration)
+{
+    // Generational collection stays enabled for the rest of the file, so everything that survives this collection is old from now on.
+    vm.heap().set_generational_collection_enabled(true);
+    vm.heap().collect_garbage(JS::Heap::CollectionType::CollectYoungGeneration);
+    return JS::js_undefined();
+}
+
+TESTJS_GLOBAL_FUNCTION(gc_with_marking_threads, gcWithMarkingThreads)
+{
+    auto count = TRY(vm.argument(0).to_u32(vm));
+    auto previous_count = vm.heap().marking_thread_count();
+    vm.heap().set_marking_thread_count(max(count, 1u));
+    vm.heap().collect_garbage();
+    vm.heap().set_marking_thread_count(previous_count);
+    return JS::js_undefined();
+}
+
 TESTJS_GLOBAL_FUNCTION(detach_array_buffer, detachArrayBuffer)
 {
     auto array_buffer = vm.argument(0);
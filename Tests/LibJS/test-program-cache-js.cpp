@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static NonnullOwnPtr<JS::ExecutionContext> create_realm(JS::VM& vm)
+{
+    auto execution_context = JS::create_simple_execution_context<JS::GlobalObject>(vm);
+    vm.pop_execution_context();
+    return execution_context;
+}
+
+static JS::NonnullGCPtr<JS::Script> parse(JS::ExecutionContext& execution_context, StringView source, StringView filename = "test.js"sv, size_t line_number_offset = 1)
+{
+    auto result = JS::Script::parse(source, *execution_context.realm, filename, nullptr, line_number_offset);
+    VERIFY(!result.is_error());
+    return result.release_value();
+}
+
+static JS::Value run(JS::VM& vm, JS::ExecutionContext& execution_context, StringView source)
+{
+    auto script = parse(execution_context, source);
+    vm.push_execution_context(execution_context);
+    auto result = vm.bytecode_interpreter().run(*script);
+    vm.pop_execution_context();
+    VERIFY(!result.is_error());
+    return result.release_value();
+}
+
+static NonnullRefPtr<JS::Program> parse_program(StringView source)
+{
+    auto parser = JS::Parser(JS::Lexer(source, "test.js"sv));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+    return program;
+}
+
+TEST_CASE(same_source_hits_the_cache)
+{
+    auto vm = MUST(JS::VM::create());
+    auto execution_context = create_realm(*vm);
+    vm->program_cache().clear();
+
+    auto source = "function f() { return 42; } f();"sv;
+    auto first = parse(*execution_context, source);
+    auto second = parse(*execution_context, source);
+    EXPECT_EQ(&first->parse_node(), &second->parse_node());
+    EXPECT_EQ(vm->program_cache().cached_source_bytes(), source.length());
+
+    // Scripts in another realm of the same VM share it too.
+    auto other_execution_context = create_realm(*vm);
+    auto third = parse(*other_execution_context, source);
+    EXPECT_EQ(&first->parse_node(), &third->parse_node());
+}
+
+TEST_CASE(different_filename_or_line_offset_misses_the_cache)
+{
+    auto vm = MUST(JS::VM::create());
+    auto execution_context = create_realm(*vm);
+    vm->program_cache().clear();
+
+    auto source = "1 + 1;"sv;
+    auto script = parse(*execution_context, source, "a.js"sv, 1);
+    EXPECT_NE(&script->parse_node(), &parse(*execution_context, source, "b.js"sv, 1)->parse_node());
+    EXPECT_NE(&script->parse_node(), &parse(*execution_context, source, "a.js"sv, 10)->parse_node());
+    EXPECT_EQ(&script->parse_node(), &parse(*execution_context, source, "a.js"sv, 1)->parse_node());
+}
+
+TEST_CASE(annex_b_top_level_hoisting_is_not_cached)
+{
+    auto vm = MUST(JS::VM::create());
+    auto execution_context = create_realm(*vm);
+    vm->program_cache().clear();
+
+    auto source = "{ function hoisted() {} }"sv;
+    auto first = parse(*execution_context, source);
+    EXPECT(first->parse_node().has_functions_hoistable_with_annexB_extension());
+    auto second = parse(*execution_context, source);
+    EXPECT_NE(&first->parse_node(), &second->parse_node());
+    EXPECT_EQ(vm->program_cache().cached_source_bytes(), 0u);
+}
+
+TEST_CASE(least_recently_used_programs_are_evicted)
+{
+    // Three of these don't fit into the cache's 8 MiB.
+    auto make_source = [](char marker) {
+        StringBuilder builder;
+        builder.appendff("'{}'; //", marker);
+        builder.append_repeated('x', 3 * MiB);
+        return builder.to_byte_string();
+    };
+    auto a = make_source('a');
+    auto b = make_source('b');
+    auto c = make_source('c');
+
+    JS::ProgramCache cache;
+    cache.set(a, "test.js"sv, 1, parse_program(a));
+    cache.set(b, "test.js"sv, 1, parse_program(b));
+    EXPECT_EQ(cache.cached_source_bytes(), a.length() + b.length());
+
+    // Using a makes b the least recently used one.
+    EXPECT(cache.get(a, "test.js"sv, 1, JS::Program::Type::Script));
+    cache.set(c, "test.js"sv, 1, parse_program(c));
+
+    EXPECT(cache.get(a, "test.js"sv, 1, JS::Program::Type::Script));
+    EXPECT(!cache.get(b, "test.js"sv, 1, JS::Program::Type::Script));
+    EXPECT(cache.get(c, "test.js"sv, 1, JS::Program::Type::Script));
+    EXPECT_EQ(cache.cached_source_bytes(), a.length() + c.length());
+
+    // A program that doesn't fit at all isn't cached, and doesn't evict anything.
+    auto huge = ByteString::repeated('x', 9 * MiB);
+    cache.set(huge, "test.js"sv, 1, parse_program(huge));
+    EXPECT(!cache.get(huge, "test.js"sv, 1, JS::Program::Type::Script));
+    EXPECT_EQ(cache.cached_source_bytes(), a.length() + c.length());
+}
+
+TEST_CASE(global_variable_caches_are_per_realm)
+{
+    auto vm = MUST(JS::VM::create());
+    auto first_realm = create_realm(*vm);
+    auto second_realm = create_realm(*vm);
+
+    // Both global declarative environments get the same number of bindings, but in a different order.
+    run(*vm, *first_realm, "let padding = 0; let value = 'first'; var variable = 1;"sv);
+    run(*vm, *second_realm, "let value = 'second'; let padding = 0; var variable = 2;"sv);
+
+    auto shared_source = "value + variable"sv;
+    for (size_t i = 0; i < 3; ++i) {
+        auto first = run(*vm, *first_realm, shared_source);
+        auto second = run(*vm, *second_realm, shared_source);
+        EXPECT_EQ(first.to_string_without_side_effects(), "first1"sv);
+        EXPECT_EQ(second.to_string_without_side_effects(), "second2"sv);
+    }
+    auto first = parse(*first_realm, shared_source);
+    EXPECT_EQ(&first->parse_node(), &parse(*second_realm, shared_source)->parse_node());
+}
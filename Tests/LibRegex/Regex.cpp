@@ -1220,3 +1220,230 @@ TEST_CASE(mismatching_brackets)
         EXPECT_EQ(re.parser_result.error, regex::Error::MismatchingBracket);
     }
 }
+
+TEST_CASE(lazy_dfa_is_only_used_without_backtracking)
+{
+    Array tests {
+        Tuple { "(a|ab)(c|bcd)(d*)"sv, true },
+        Tuple { "^\\w+@\\w+\\.com$"sv, true },
+        Tuple { "(a*)*b"sv, true },
+        Tuple { "(a)\\1"sv, false },  // Backreferences need to know where the group matched.
+        Tuple { "a(?=b)"sv, false },  // Lookarounds have to move backwards or restore the position.
+        Tuple { "(?<=a)b"sv, false },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.get<0>());
+        EXPECT_EQ(re.lazy_dfa != nullptr, test.get<1>());
+    }
+}
+
+TEST_CASE(lazy_dfa_matches_like_the_backtracker)
+{
+    Array tests {
+        Tuple { "(a|ab)(c|bcd)(d*)"sv, "abcd"sv },
+        Tuple { "(a+?)(a*)b"sv, "xaaab aab"sv },
+        Tuple { "\\bfoo\\b|bar$"sv, "foobar foo bar"sv },
+        Tuple { "^b|c$"sv, "ab\nbc\nc"sv },
+        Tuple { "(?:aa)*"sv, "aaaaa"sv },
+        Tuple { "x*"sv, "axxb"sv },
+        Tuple { "c|abcd"sv, "xabcd abc"sv },
+        Tuple { "b+c|ab"sv, "xabbbc abbc"sv },
+        Tuple { "\\b\\w+\\b|\\d"sv, "1a 2 b3"sv },
+        Tuple { "(\\d+)-(\\d*)"sv, "12-345 6- -7"sv },
+    };
+
+    Array<ECMAScriptOptions, 3> options {
+        ECMAScriptFlags::Global,
+        ECMAScriptFlags::Global | ECMAScriptFlags::Multiline,
+        ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive,
+    };
+
+    for (auto& test : tests) {
+        for (auto flags : options) {
+            Regex<ECMA262> with_dfa(test.get<0>(), flags);
+            Regex<ECMA262> without_dfa(test.get<0>(), flags);
+            EXPECT(with_dfa.lazy_dfa);
+            without_dfa.lazy_dfa = nullptr;
+
+            auto expected = without_dfa.match(test.get<1>());
+            auto result = with_dfa.match(test.get<1>());
+            EXPECT_EQ(result.success, expected.success);
+            EXPECT_EQ(result.count, expected.count);
+            for (size_t i = 0; i < min(result.matches.size(), expected.matches.size()); ++i) {
+                EXPECT_EQ(result.matches[i].global_offset, expected.matches[i].global_offset);
+                EXPECT_EQ(result.matches[i].view.to_byte_string(), expected.matches[i].view.to_byte_string());
+                EXPECT_EQ(result.capture_group_matches[i].size(), expected.capture_group_matches[i].size());
+                for (size_t j = 0; j < min(result.capture_group_matches[i].size(), expected.capture_group_matches[i].size()); ++j)
+                    EXPECT_EQ(result.capture_group_matches[i][j].view.to_byte_string(), expected.capture_group_matches[i][j].view.to_byte_string());
+            }
+            EXPECT_EQ(with_dfa.has_match(test.get<1>()), without_dfa.has_match(test.get<1>()));
+        }
+    }
+}
+
+TEST_CASE(lazy_dfa_does_not_backtrack_exponentially)
+{
+    // Each of these takes exponential (or at least quadratic) time in a backtracking matcher.
+    auto input = ByteString::formatted("{}!", ByteString::repeated('a', 10'000));
+    Array patterns {
+        "(a*)*b"sv,
+        "(a|aa)+c"sv,
+        "(a|a?)+b"sv,
+        "a*a*a*a*a*b"sv,
+    };
+
+    for (auto& pattern : patterns) {
+        Regex<ECMA262> re(pattern, ECMAScriptFlags::Global);
+        EXPECT(re.lazy_dfa);
+        EXPECT_EQ(re.has_match(input), false);
+        EXPECT_EQ(re.match(input).success, false);
+    }
+
+    Regex<PosixExtended> re("(x+x+)+y");
+    EXPECT(re.lazy_dfa);
+    EXPECT_EQ(re.has_match(ByteString::repeated('x', 10'000)), false);
+}
+
+TEST_CASE(lazy_dfa_searches_in_linear_time)
+{
+    // Every position before the match starts something that only fails at the end of the input, so trying each of
+    // them in turn would take quadratic time.
+    auto input = ByteString::formatted("{}2", ByteString::repeated('a', 100'000));
+    Array patterns {
+        "[a-z]*1|2"sv,
+        "([a-z]*1|(2))"sv,
+    };
+
+    for (auto& pattern : patterns) {
+        Regex<ECMA262> re(pattern, ECMAScriptFlags::Global);
+        EXPECT(re.lazy_dfa);
+        auto result = re.match(input);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.count, 1u);
+        EXPECT_EQ(result.matches.first().global_offset, 100'000u);
+        EXPECT_EQ(result.matches.first().view, "2"sv);
+    }
+}
+
+TEST_CASE(search_prefilters)
+{
+    {
+        Regex<ECMA262> re("ab\\d+wxyz");
+        EXPECT_EQ(re.parser_result.optimization_data.literal_prefix, "ab"sv);
+        EXPECT_EQ(re.parser_result.optimization_data.required_substring, "wxyz"sv);
+    }
+    {
+        Regex<ECMA262> re("(foo|bar)baz");
+        EXPECT(!re.parser_result.optimization_data.literal_prefix.has_value());
+        EXPECT_EQ(re.parser_result.optimization_data.required_substring, "baz"sv);
+        auto const& starting_characters = re.parser_result.optimization_data.starting_characters;
+        EXPECT(starting_characters.has_value());
+        EXPECT(starting_characters->ascii['f'] && starting_characters->ascii['b']);
+        EXPECT(!starting_characters->ascii['a'] && !starting_characters->non_ascii);
+    }
+    {
+        // A single possible first character is searched for like a prefix.
+        Regex<ECMA262> re("x(y|z)");
+        EXPECT_EQ(re.parser_result.optimization_data.literal_prefix, "x"sv);
+    }
+    {
+        Regex<ECMA262> re("foo", ECMAScriptFlags::Insensitive);
+        EXPECT(!re.parser_result.optimization_data.literal_prefix.has_value());
+        auto const& starting_characters = re.parser_result.optimization_data.starting_characters;
+        EXPECT(starting_characters.has_value());
+        EXPECT(starting_characters->ascii['f'] && starting_characters->ascii['F']);
+    }
+    {
+        // Lookarounds look at characters outside of the match, and patterns that can match the empty string can start anywhere.
+        Array patterns { "(?=a)b"sv, "(?<!a)b"sv, "a*"sv, "(a|)b*"sv };
+        for (auto& pattern : patterns) {
+            Regex<ECMA262> re(pattern);
+            EXPECT(!re.parser_result.optimization_data.literal_prefix.has_value());
+            EXPECT(!re.parser_result.optimization_data.required_substring.has_value());
+            EXPECT(!re.parser_result.optimization_data.starting_characters.has_value());
+        }
+    }
+}
+
+TEST_CASE(search_prefilters_match)
+{
+    auto haystack = ByteString::formatted("{}foo123bar{}FOO4bar", ByteString::repeated('a', 100'000), ByteString::repeated('b', 100'000));
+    auto utf16_haystack = MUST(AK::utf8_to_utf16(haystack));
+
+    auto check = [&](auto& re, Vector<size_t> const& expected_offsets) {
+        for (auto view : { RegexStringView { haystack.view() }, RegexStringView { Utf16View { utf16_haystack } } }) {
+            re.start_offset = 0;
+            auto result = re.match(view);
+            EXPECT_EQ(result.matches.size(), expected_offsets.size());
+            for (size_t i = 0; i < min(result.matches.size(), expected_offsets.size()); ++i)
+                EXPECT_EQ(result.matches[i].global_offset, expected_offsets[i]);
+        }
+    };
+
+    Regex<ECMA262> prefix("foo\\d+bar", ECMAScriptFlags::Global);
+    check(prefix, { 100'000 });
+    Regex<ECMA262> insensitive("foo\\d+bar", ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+    check(insensitive, { 100'000, 200'009 });
+    Regex<ECMA262> required("\\w\\d+bar", ECMAScriptFlags::Global);
+    check(required, { 100'002, 200'011 });
+    Regex<ECMA262> missing("\\w\\d+baz", ECMAScriptFlags::Global);
+    check(missing, {});
+    Regex<PosixExtended> posix("[fF][oO]+[0-9]", PosixFlags::Global);
+    check(posix, { 100'000, 200'009 });
+}
+
+TEST_CASE(regex_set)
+{
+    RegexSet<PosixExtended> set({ "foo"sv, "ba[rz]"sv, "^qux"sv, "[0-9]+x"sv, "foo"sv, "b"sv });
+    EXPECT_EQ(set.size(), 6u);
+
+    struct {
+        StringView input;
+        Vector<size_t> expected;
+    } tests[] = {
+        { ""sv, {} },
+        { "nothing here"sv, {} },
+        { "foo"sv, { 0, 4 } },
+        { "a bar and a foo"sv, { 0, 1, 4, 5 } },
+        { "qux 42x"sv, { 2, 3 } },
+        { "not qux 42"sv, {} },
+        { "b"sv, { 5 } },
+    };
+
+    for (auto& test : tests) {
+        EXPECT_EQ(set.matches(test.input), test.expected);
+        EXPECT_EQ(set.first_match(test.input), test.expected.is_empty() ? Optional<size_t> {} : test.expected.first());
+        EXPECT_EQ(set.has_match(test.input), !test.expected.is_empty());
+
+        // Inputs the literal scan can't look at are matched against every pattern instead.
+        auto utf16_input = MUST(AK::utf8_to_utf16(test.input));
+        EXPECT_EQ(set.matches(Utf16View { utf16_input }), test.expected);
+    }
+}
+
+TEST_CASE(regex_set_case_insensitive)
+{
+    RegexSet<PosixBasic> set({ "Hello"sv, "WORLD"sv, "hello"sv, "w.rld"sv }, PosixFlags::Insensitive);
+    EXPECT_EQ(set.matches("hELLo"sv), (Vector<size_t> { 0, 2 }));
+    EXPECT_EQ(set.matches("say world"sv), (Vector<size_t> { 1, 3 }));
+    EXPECT_EQ(set.matches("HELLO WORLD"sv), (Vector<size_t> { 0, 1, 2, 3 }));
+    EXPECT_EQ(set.matches("help"sv), (Vector<size_t> {}));
+}
+
+TEST_CASE(regex_set_overlapping_literals)
+{
+    // Literals that end inside one another are only found by following the automaton's failure links.
+    RegexSet<ECMA262> set({ "he"sv, "she"sv, "his"sv, "hers"sv, "e"sv, ""sv });
+    EXPECT_EQ(set.matches("ushers"sv), (Vector<size_t> { 0, 1, 3, 4, 5 }));
+    EXPECT_EQ(set.matches("this"sv), (Vector<size_t> { 2, 5 }));
+    EXPECT_EQ(set.matches("xyz"sv), (Vector<size_t> { 5 }));
+}
+
+TEST_CASE(regex_set_parse_error)
+{
+    RegexSet<PosixExtended> set({ "fo(o"sv, "bar"sv });
+    EXPECT_NE(set[0].parser_result.error, regex::Error::NoError);
+    EXPECT_EQ(set[1].parser_result.error, regex::Error::NoError);
+    EXPECT_EQ(set.matches("foo bar"sv), (Vector<size_t> { 1 }));
+}
@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/SIMD.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/Operators.h>
+
+// Each case runs one class of v128 operators over inputs taken from the edge cases of the spec's simd_*.wast tests
+// (wrapping, saturation, signed vs. unsigned lanes, NaNs and signed zeros), and checks the results the spec expects.
+// They are all registered twice: as a test that runs them once, and as a benchmark that keeps running them.
+
+using namespace AK::SIMD;
+using namespace Wasm;
+
+template<typename Operator, typename Input, typename Output>
+static void run_binary(size_t iterations, Input lhs, Input rhs, Output expected)
+{
+    auto lhs_value = bit_cast<u128>(lhs);
+    auto rhs_value = bit_cast<u128>(rhs);
+    u128 result;
+    for (size_t i = 0; i < iterations; ++i) {
+        AK::taint_for_optimizer(lhs_value);
+        result = Operator {}(lhs_value, rhs_value);
+        AK::taint_for_optimizer(result);
+    }
+    EXPECT_EQ(result, bit_cast<u128>(expected));
+}
+
+template<typename Operator, typename Input, typename Output>
+static void run_unary(size_t iterations, Input value, Output expected)
+{
+    auto input = bit_cast<u128>(value);
+    u128 result;
+    for (size_t i = 0; i < iterations; ++i) {
+        AK::taint_for_optimizer(input);
+        result = Operator {}(input);
+        AK::taint_for_optimizer(result);
+    }
+    EXPECT_EQ(result, bit_cast<u128>(expected));
+}
+
+static constexpr u32 f32_nan = 0x7fc00000;
+static constexpr u32 f32_negative_nan = 0xffc00000;
+static constexpr u32 f32_negative_zero = 0x80000000;
+static constexpr u32 f32_one = 0x3f800000;
+static constexpr u32 f32_negative_one = 0xbf800000;
+static constexpr u32 f32_infinity = 0x7f800000;
+
+static void integer_arithmetic(size_t iterations)
+{
+    run_binary<Operators::VectorIntegerBinaryOp<16, Operators::Add>>(
+        iterations,
+        i8x16 { 127, -128, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        i8x16 { 1, -1, 1, 0, -1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        i8x16 { -128, 127, 0, 0, 0, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24 });
+    run_binary<Operators::VectorIntegerBinaryOp<16, Operators::Subtract>>(
+        iterations,
+        i8x16 { -128, 127, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        i8x16 { 1, -1, 1, 0, -1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        i8x16 { 127, -128, -1, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+    run_binary<Operators::VectorIntegerBinaryOp<8, Operators::Multiply>>(
+        iterations,
+        i16x8 { 0x7fff, -0x8000, -1, 0x100, 3, -3, 0, 1000 },
+        i16x8 { 2, 2, -1, 0x100, -3, -3, 5, 1000 },
+        i16x8 { -2, 0, 1, 0, -9, 9, 0, 16960 });
+    run_binary<Operators::VectorIntegerBinaryOp<4, Operators::Add, MakeUnsigned>>(
+        iterations,
+        u32x4 { 0xffffffff, 0x7fffffff, 0, 12345 },
+        u32x4 { 1, 1, 0, 54321 },
+        u32x4 { 0, 0x80000000, 0, 66666 });
+    run_binary<Operators::VectorIntegerBinaryOp<2, Operators::Multiply, MakeUnsigned>>(
+        iterations,
+        u64x2 { 0x8000000000000000ull, 0x100000001ull },
+        u64x2 { 2, 0x100000001ull },
+        u64x2 { 0, 0x200000001ull });
+}
+
+static void integer_saturating_arithmetic(size_t iterations)
+{
+    run_binary<Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<i8, Operators::Add>, MakeSigned>>(
+        iterations,
+        i8x16 { 127, -128, 100, -100, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        i8x16 { 1, -1, 100, -100, -1, -2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        i8x16 { 127, -128, 127, -128, 0, 0, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24 });
+    run_binary<Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<u8, Operators::Subtract>, MakeUnsigned>>(
+        iterations,
+        u8x16 { 0, 1, 0xff, 0x80, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 },
+        u8x16 { 1, 0xff, 0, 0x81, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5 },
+        u8x16 { 0, 0, 0xff, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 });
+    run_binary<Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Subtract>, MakeSigned>>(
+        iterations,
+        i16x8 { -0x8000, 0x7fff, 0, -1, 100, -100, 0x4000, -0x4000 },
+        i16x8 { 1, -1, -0x8000, 0x7fff, 50, 50, -0x4000, 0x4000 },
+        i16x8 { -0x8000, 0x7fff, 0x7fff, -0x8000, 50, -150, 0x7fff, -0x8000 });
+    run_binary<Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<u16, Operators::Add>, MakeUnsigned>>(
+        iterations,
+        u16x8 { 0xffff, 0x8000, 0, 1, 2, 3, 4, 5 },
+        u16x8 { 1, 0x8000, 0xffff, 1, 2, 3, 4, 5 },
+        u16x8 { 0xffff, 0xffff, 0xffff, 2, 4, 6, 8, 10 });
+}
+
+static void integer_min_max_average(size_t iterations)
+{
+    run_binary<Operators::VectorIntegerBinaryOp<16, Operators::Minimum, MakeSigned>>(
+        iterations,
+        i8x16 { -128, 127, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        i8x16 { 127, -128, 1, 0, -1, 3, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        i8x16 { -128, -128, -1, 0, -1, 2, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12 });
+    run_binary<Operators::VectorIntegerBinaryOp<16, Operators::Maximum, MakeUnsigned>>(
+        iterations,
+        u8x16 { 0x80, 0x7f, 0xff, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        u8x16 { 0x7f, 0x80, 1, 0, 0xff, 3, 2, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        u8x16 { 0x80, 0x80, 0xff, 0, 0xff, 3, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 });
+    run_binary<Operators::VectorIntegerBinaryOp<8, Operators::Minimum, MakeUnsigned>>(
+        iterations,
+        u16x8 { 0xffff, 0x8000, 0, 1, 2, 3, 4, 5 },
+        u16x8 { 1, 0x7fff, 0xffff, 1, 3, 2, 4, 5 },
+        u16x8 { 1, 0x7fff, 0, 1, 2, 2, 4, 5 });
+    run_binary<Operators::VectorIntegerBinaryOp<4, Operators::Maximum, MakeSigned>>(
+        iterations,
+        i32x4 { -0x7fffffff - 1, 0x7fffffff, -1, 0 },
+        i32x4 { 0x7fffffff, -0x7fffffff - 1, 1, 0 },
+        i32x4 { 0x7fffffff, 0x7fffffff, 1, 0 });
+    run_binary<Operators::VectorIntegerBinaryOp<16, Operators::Average, MakeUnsigned>>(
+        iterations,
+        u8x16 { 0xff, 0, 0, 1, 2, 0x80, 0xfe, 3, 4, 5, 6, 7, 8, 9, 10, 11 },
+        u8x16 { 0xff, 0, 1, 2, 2, 0x7f, 0xff, 3, 5, 5, 6, 7, 8, 9, 10, 11 },
+        u8x16 { 0xff, 0, 1, 2, 2, 0x80, 0xff, 3, 5, 5, 6, 7, 8, 9, 10, 11 });
+    run_binary<Operators::VectorIntegerBinaryOp<8, Operators::Average, MakeUnsigned>>(
+        iterations,
+        u16x8 { 0xffff, 0, 0, 1, 0x8000, 0xfffe, 3, 4 },
+        u16x8 { 0xffff, 0, 1, 2, 0x7fff, 0xffff, 3, 5 },
+        u16x8 { 0xffff, 0, 1, 2, 0x8000, 0xffff, 3, 5 });
+}
+
+static void integer_comparisons(size_t iterations)
+{
+    run_binary<Operators::VectorCmpOp<16, Operators::Equals>>(
+        iterations,
+        i8x16 { 0, 1, -1, -128, 127, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        i8x16 { 0, 2, -1, 127, -128, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 },
+        i8x16 { -1, 0, -1, 0, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0 });
+    run_binary<Operators::VectorCmpOp<16, Operators::LessThan, MakeUnsigned>>(
+        iterations,
+        i8x16 { 0, 1, -1, -128, 127, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+        i8x16 { 0, 2, 1, 127, -128, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 },
+        i8x16 { 0, -1, 0, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1 });
+    run_binary<Operators::VectorCmpOp<8, Operators::LessThan, MakeSigned>>(
+        iterations,
+        i16x8 { 0, 1, -1, -0x8000, 0x7fff, 5, 5, 5 },
+        i16x8 { 0, 2, 1, 0x7fff, -0x8000, 4, 5, 6 },
+        i16x8 { 0, -1, -1, -1, 0, 0, 0, -1 });
+    run_binary<Operators::VectorCmpOp<4, Operators::GreaterThanOrEquals, MakeUnsigned>>(
+        iterations,
+        u32x4 { 0xffffffff, 0, 0x80000000, 7 },
+        u32x4 { 0, 0xffffffff, 0x7fffffff, 7 },
+        i32x4 { -1, 0, -1, -1 });
+    run_binary<Operators::VectorCmpOp<2, Operators::GreaterThan, MakeSigned>>(
+        iterations,
+        i64x2 { -1, 0x7fffffffffffffffll },
+        i64x2 { 0, -0x7fffffffffffffffll - 1 },
+        i64x2 { 0, -1 });
+}
+
+static void integer_unary(size_t iterations)
+{
+    run_unary<Operators::VectorIntegerUnaryOp<16, Operators::Absolute>>(
+        iterations,
+        i8x16 { -128, 127, -1, 0, 1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11, -12 },
+        i8x16 { -128, 127, 1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 });
+    run_unary<Operators::VectorIntegerUnaryOp<8, Operators::Negate>>(
+        iterations,
+        i16x8 { -0x8000, 0x7fff, -1, 0, 1, -2, 3, -4 },
+        i16x8 { -0x8000, -0x7fff, 1, 0, -1, 2, -3, 4 });
+    run_unary<Operators::VectorIntegerUnaryOp<4, Operators::Absolute>>(
+        iterations,
+        i32x4 { -0x7fffffff - 1, 0x7fffffff, -1, 0 },
+        i32x4 { -0x7fffffff - 1, 0x7fffffff, 1, 0 });
+    run_unary<Operators::VectorIntegerUnaryOp<2, Operators::Negate, MakeUnsigned>>(
+        iterations,
+        i64x2 { -0x7fffffffffffffffll - 1, 1 },
+        i64x2 { -0x7fffffffffffffffll - 1, -1 });
+}
+
+static void float_arithmetic(size_t iterations)
+{
+    run_binary<Operators::VectorFloatBinaryOp<4, Operators::Add>>(
+        iterations,
+        f32x4 { 1.0f, -1.0f, 0.5f, __builtin_inff() },
+        f32x4 { 2.0f, 1.0f, 0.25f, -__builtin_inff() },
+        u32x4 { 0x40400000, 0, 0x3f400000, f32_nan | f32_negative_zero });
+    run_binary<Operators::VectorFloatBinaryOp<4, Operators::Multiply>>(
+        iterations,
+        f32x4 { 1.5f, -0.0f, 3.0f, 1e30f },
+        f32x4 { 2.0f, 1.0f, -0.5f, 1e30f },
+        f32x4 { 3.0f, -0.0f, -1.5f, __builtin_inff() });
+    run_binary<Operators::VectorFloatBinaryOp<2, Operators::Divide>>(
+        iterations,
+        f64x2 { 1.0, -1.0 },
+        f64x2 { 0.0, 4.0 },
+        f64x2 { __builtin_inf(), -0.25 });
+    run_binary<Operators::VectorFloatBinaryOp<2, Operators::Subtract>>(
+        iterations,
+        f64x2 { 1.0, 0.0 },
+        f64x2 { 1.0, 0.0 },
+        f64x2 { 0.0, 0.0 });
+}
+
+static void float_min_max(size_t iterations)
+{
+    run_binary<Operators::VectorFloatBinaryOp<4, Operators::PseudoMinimum>>(
+        iterations,
+        u32x4 { f32_nan, 0, f32_one, f32_negative_one },
+        u32x4 { f32_one, f32_negative_zero, f32_nan, f32_one },
+        u32x4 { f32_nan, 0, f32_one, f32_negative_one });
+    run_binary<Operators::VectorFloatBinaryOp<4, Operators::PseudoMaximum>>(
+        iterations,
+        u32x4 { f32_nan, f32_negative_zero, f32_one, f32_negative_one },
+        u32x4 { f32_one, 0, f32_nan, f32_one },
+        u32x4 { f32_nan, f32_negative_zero, f32_one, f32_one });
+    run_binary<Operators::VectorFloatBinaryOp<2, Operators::PseudoMaximum>>(
+        iterations,
+        f64x2 { -2.0, 3.0 },
+        f64x2 { 1.0, 2.0 },
+        f64x2 { 1.0, 3.0 });
+    run_binary<Operators::VectorFloatBinaryOp<4, Operators::Minimum>>(
+        iterations,
+        u32x4 { f32_nan, 0, f32_one, f32_negative_one },
+        u32x4 { f32_one, f32_negative_zero, f32_infinity, f32_one },
+        u32x4 { f32_nan, f32_negative_zero, f32_one, f32_negative_one });
+}
+
+static void float_comparisons(size_t iterations)
+{
+    run_binary<Operators::VectorFloatCmpOp<4, Operators::Equals>>(
+        iterations,
+        u32x4 { f32_nan, 0, f32_one, f32_one },
+        u32x4 { f32_nan, f32_negative_zero, f32_one, f32_negative_one },
+        i32x4 { 0, -1, -1, 0 });
+    run_binary<Operators::VectorFloatCmpOp<4, Operators::NotEquals>>(
+        iterations,
+        u32x4 { f32_nan, 0, f32_one, f32_one },
+        u32x4 { f32_nan, f32_negative_zero, f32_one, f32_negative_one },
+        i32x4 { -1, 0, 0, -1 });
+    run_binary<Operators::VectorFloatCmpOp<4, Operators::LessThan>>(
+        iterations,
+        u32x4 { f32_nan, f32_negative_zero, f32_negative_one, f32_one },
+        u32x4 { f32_one, 0, f32_one, f32_negative_one },
+        i32x4 { 0, 0, -1, 0 });
+    run_binary<Operators::VectorFloatCmpOp<2, Operators::GreaterThanOrEquals>>(
+        iterations,
+        f64x2 { 1.0, __builtin_nan("") },
+        f64x2 { 1.0, 1.0 },
+        i64x2 { -1, 0 });
+}
+
+static void float_sign(size_t iterations)
+{
+    run_unary<Operators::VectorFloatUnaryOp<4, Operators::Absolute>>(
+        iterations,
+        u32x4 { f32_negative_nan, f32_negative_zero, f32_negative_one, f32_one },
+        u32x4 { f32_nan, 0, f32_one, f32_one });
+    run_unary<Operators::VectorFloatUnaryOp<4, Operators::Negate>>(
+        iterations,
+        u32x4 { f32_nan, 0, f32_negative_one, f32_infinity },
+        u32x4 { f32_negative_nan, f32_negative_zero, f32_one, f32_infinity | f32_negative_zero });
+    run_unary<Operators::VectorFloatUnaryOp<2, Operators::Negate>>(
+        iterations,
+        f64x2 { 0.0, -2.5 },
+        f64x2 { -0.0, 2.5 });
+}
+
+static void integer_extend(size_t iterations)
+{
+    run_unary<Operators::VectorIntegerExt<8, Operators::VectorExt::Low, MakeSigned>>(
+        iterations,
+        i8x16 { -128, 127, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        i16x8 { -128, 127, -1, 0, 1, 2, 3, 4 });
+    run_unary<Operators::VectorIntegerExt<8, Operators::VectorExt::High, MakeUnsigned>>(
+        iterations,
+        u8x16 { 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0x80, 0x7f, 0, 1, 2, 3, 4 },
+        u16x8 { 0xff, 0x80, 0x7f, 0, 1, 2, 3, 4 });
+    run_unary<Operators::VectorIntegerExt<4, Operators::VectorExt::High, MakeSigned>>(
+        iterations,
+        i16x8 { 0, 0, 0, 0, -0x8000, 0x7fff, -1, 0 },
+        i32x4 { -0x8000, 0x7fff, -1, 0 });
+    run_unary<Operators::VectorIntegerExt<2, Operators::VectorExt::Low, MakeUnsigned>>(
+        iterations,
+        u32x4 { 0xffffffff, 0x80000000, 0, 0 },
+        u64x2 { 0xffffffff, 0x80000000 });
+    run_binary<Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::Low, MakeSigned>>(
+        iterations,
+        i8x16 { -128, 127, -1, 0, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0 },
+        i8x16 { -128, 127, 127, 5, -1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0 },
+        i16x8 { 16384, 16129, -127, 0, -1, 4, 9, 16 });
+    run_binary<Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::High, MakeUnsigned>>(
+        iterations,
+        u16x8 { 0, 0, 0, 0, 0xffff, 0x8000, 2, 3 },
+        u16x8 { 0, 0, 0, 0, 0xffff, 2, 2, 3 },
+        u32x4 { 0xfffe0001, 0x10000, 4, 9 });
+}
+
+static void integer_pairwise(size_t iterations)
+{
+    run_unary<Operators::VectorIntegerExtOpPairwise<8, Operators::Add, MakeSigned>>(
+        iterations,
+        i8x16 { -128, -128, 127, 127, -1, 1, 0, 0, -128, 127, 1, 2, 3, 4, -5, -6 },
+        i16x8 { -256, 254, 0, 0, -1, 3, 7, -11 });
+    run_unary<Operators::VectorIntegerExtOpPairwise<8, Operators::Add, MakeUnsigned>>(
+        iterations,
+        u8x16 { 0xff, 0xff, 0x80, 0x80, 0, 1, 0, 0, 2, 3, 4, 5, 6, 7, 8, 9 },
+        u16x8 { 0x1fe, 0x100, 1, 0, 5, 9, 13, 17 });
+    run_unary<Operators::VectorIntegerExtOpPairwise<4, Operators::Add, MakeSigned>>(
+        iterations,
+        i16x8 { -0x8000, -0x8000, 0x7fff, 0x7fff, -1, 1, 3, -4 },
+        i32x4 { -0x10000, 0xfffe, 0, -1 });
+    run_unary<Operators::VectorIntegerExtOpPairwise<4, Operators::Add, MakeUnsigned>>(
+        iterations,
+        u16x8 { 0xffff, 0xffff, 0x8000, 0x8000, 0, 1, 2, 3 },
+        u32x4 { 0x1fffe, 0x10000, 1, 5 });
+    run_binary<Operators::VectorDotProduct<4>>(
+        iterations,
+        i16x8 { -0x8000, -0x8000, 0x7fff, 0x7fff, -1, 1, 3, -4 },
+        i16x8 { -0x8000, -0x8000, 0x7fff, 0x7fff, 1, 1, 5, 6 },
+        i32x4 { -0x7fffffff - 1, 0x7ffe0002, 0, -9 });
+}
+
+static void integer_narrow(size_t iterations)
+{
+    run_binary<Operators::VectorNarrow<16, i8>>(
+        iterations,
+        i16x8 { 300, -300, 127, -128, 128, -129, 0, -1 },
+        i16x8 { 0x7fff, -0x8000, 1, 2, 3, 4, 5, 6 },
+        i8x16 { 127, -128, 127, -128, 127, -128, 0, -1, 127, -128, 1, 2, 3, 4, 5, 6 });
+    run_binary<Operators::VectorNarrow<16, u8>>(
+        iterations,
+        i16x8 { 300, -300, 255, 256, 128, -1, 0, 1 },
+        i16x8 { 0x7fff, -0x8000, 1, 2, 3, 4, 5, 6 },
+        u8x16 { 255, 0, 255, 255, 128, 0, 0, 1, 255, 0, 1, 2, 3, 4, 5, 6 });
+    run_binary<Operators::VectorNarrow<8, i16>>(
+        iterations,
+        i32x4 { 0x10000, -0x10000, 0x7fff, -0x8000 },
+        i32x4 { 1, -1, 0x8000, -0x8001 },
+        i16x8 { 0x7fff, -0x8000, 0x7fff, -0x8000, 1, -1, 0x7fff, -0x8000 });
+    run_binary<Operators::VectorNarrow<8, u16>>(
+        iterations,
+        i32x4 { 0x10000, -0x10000, 0xffff, 0x8000 },
+        i32x4 { 1, -1, 0, 0x7fffffff },
+        u16x8 { 0xffff, 0, 0xffff, 0x8000, 1, 0, 0, 0xffff });
+}
+
+static void bitmask(size_t iterations)
+{
+    auto input = bit_cast<u128>(i8x16 { -1, 0, -128, 127, 0, 0, 0, -1, 1, 1, 1, 1, 1, 1, 1, -2 });
+    u32 result = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        AK::taint_for_optimizer(input);
+        result = Operators::VectorBitmask<16> {}(input);
+        AK::taint_for_optimizer(result);
+    }
+    EXPECT_EQ(result, 0x8085u);
+
+    auto words = bit_cast<u128>(i32x4 { -1, 0, -0x7fffffff - 1, 0x7fffffff });
+    for (size_t i = 0; i < iterations; ++i) {
+        AK::taint_for_optimizer(words);
+        result = Operators::VectorBitmask<4> {}(words);
+        AK::taint_for_optimizer(result);
+    }
+    EXPECT_EQ(result, 0b0101u);
+}
+
+static constexpr size_t benchmark_iterations = 1'000'000;
+
+#define SIMD_CASE(name)             \
+    TEST_CASE(name)                 \
+    {                               \
+        name(1);                    \
+    }                               \
+    BENCHMARK_CASE(name)            \
+    {                               \
+        name(benchmark_iterations); \
+    }
+
+SIMD_CASE(integer_arithmetic)
+SIMD_CASE(integer_saturating_arithmetic)
+SIMD_CASE(integer_min_max_average)
+SIMD_CASE(integer_comparisons)
+SIMD_CASE(integer_unary)
+SIMD_CASE(float_arithmetic)
+SIMD_CASE(float_min_max)
+SIMD_CASE(float_comparisons)
+SIMD_CASE(float_sign)
+SIMD_CASE(integer_extend)
+SIMD_CASE(integer_pairwise)
+SIMD_CASE(integer_narrow)
+SIMD_CASE(bitmask)
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/NumericLimits.h>
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/Operators.h>
+
+// These check the lane-wise v128 operators against the spec's scalar definitions, on every 8-bit input and on a grid of
+// 16-bit (and wider) inputs that includes the edges of both the signed and unsigned ranges.
+
+using namespace Wasm;
+
+template<typename T>
+static T saturate(i64 value)
+{
+    return static_cast<T>(clamp<i64>(value, NumericLimits<T>::min(), NumericLimits<T>::max()));
+}
+
+template<typename T>
+static Vector<T> all_8_bit_values()
+{
+    Vector<T> values;
+    for (u32 value = 0; value <= 0xff; ++value)
+        values.append(static_cast<T>(value));
+    return values;
+}
+
+template<typename T>
+static Vector<T> all_16_bit_values()
+{
+    Vector<T> values;
+    for (u32 value = 0; value <= 0xffff; ++value)
+        values.append(static_cast<T>(value));
+    return values;
+}
+
+template<typename T>
+static Vector<T> sampled_16_bit_values()
+{
+    Vector<T> values;
+    for (u32 value = 0; value <= 0xffff; value += 251)
+        values.append(static_cast<T>(value));
+    for (u32 value : { 0x0001, 0x007f, 0x0080, 0x00ff, 0x0100, 0x7ffe, 0x7fff, 0x8000, 0x8001, 0xff7f, 0xff80, 0xfffe, 0xffff })
+        values.append(static_cast<T>(value));
+    return values;
+}
+
+static Vector<i32> sampled_32_bit_values()
+{
+    Vector<i32> values;
+    for (i32 value = -0x20000; value <= 0x20000; value += 257)
+        values.append(value);
+    for (i32 value : { NumericLimits<i32>::min(), -0x10000, -0x8001, -0x8000, -0x7fff, -1, 0, 1, 0x7fff, 0x8000, 0xffff, 0x10000, NumericLimits<i32>::max() })
+        values.append(value);
+    return values;
+}
+
+// Runs a lane-wise operator on each value paired with every one of the values, and checks each lane against the reference.
+template<typename Operator, typename T>
+static void check_lanewise(Vector<T> const& values, auto reference)
+{
+    constexpr size_t lane_count = 16 / sizeof(T);
+    for (auto first : values) {
+        for (size_t offset = 0; offset < values.size(); offset += lane_count) {
+            Array<T, lane_count> lhs_lanes;
+            Array<T, lane_count> rhs_lanes;
+            lhs_lanes.fill(first);
+            for (size_t i = 0; i < lane_count; ++i)
+                rhs_lanes[i] = values[(offset + i) % values.size()];
+
+            auto result = bit_cast<Array<T, lane_count>>(Operator {}(bit_cast<u128>(lhs_lanes), bit_cast<u128>(rhs_lanes)));
+            for (size_t i = 0; i < lane_count; ++i)
+                EXPECT_EQ(result[i], static_cast<T>(reference(lhs_lanes[i], rhs_lanes[i])));
+        }
+    }
+}
+
+// Narrows each of the values, the first operand into the low half of the result and the second one into the high half.
+template<typename Operator, typename Output, typename Input>
+static void check_narrow(Vector<Input> const& values)
+{
+    constexpr size_t lane_count = 16 / sizeof(Input);
+    for (size_t offset = 0; offset < values.size(); offset += lane_count) {
+        Array<Input, lane_count> lhs_lanes;
+        Array<Input, lane_count> rhs_lanes;
+        for (size_t i = 0; i < lane_count; ++i) {
+            lhs_lanes[i] = values[(offset + i) % values.size()];
+            rhs_lanes[i] = values[values.size() - 1 - (offset + i) % values.size()];
+        }
+
+        auto result = bit_cast<Array<Output, 2 * lane_count>>(Operator {}(bit_cast<u128>(lhs_lanes), bit_cast<u128>(rhs_lanes)));
+        for (size_t i = 0; i < lane_count; ++i) {
+            EXPECT_EQ(result[i], saturate<Output>(lhs_lanes[i]));
+            EXPECT_EQ(result[lane_count + i], saturate<Output>(rhs_lanes[i]));
+        }
+    }
+}
+
+// Adds up each value paired with every one of the values.
+template<typename Operator, typename Output, typename Input>
+static void check_pairwise_add(Vector<Input> const& values)
+{
+    constexpr size_t pair_count = 8 / sizeof(Input);
+    for (auto first : values) {
+        for (size_t offset = 0; offset < values.size(); offset += pair_count) {
+            Array<Input, 2 * pair_count> input;
+            for (size_t i = 0; i < pair_count; ++i) {
+                input[2 * i] = first;
+                input[2 * i + 1] = values[(offset + i) % values.size()];
+            }
+
+            auto result = bit_cast<Array<Output, pair_count>>(Operator {}(bit_cast<u128>(input)));
+            for (size_t i = 0; i < pair_count; ++i)
+                EXPECT_EQ(result[i], static_cast<Output>(input[2 * i] + input[2 * i + 1]));
+        }
+    }
+}
+
+TEST_CASE(saturating_add_and_subtract_8_bit)
+{
+    auto signed_values = all_8_bit_values<i8>();
+    auto unsigned_values = all_8_bit_values<u8>();
+
+    check_lanewise<Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<i8, Operators::Add>, MakeSigned>>(
+        signed_values, [](i8 lhs, i8 rhs) { return saturate<i8>(lhs + rhs); });
+    check_lanewise<Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<i8, Operators::Subtract>, MakeSigned>>(
+        signed_values, [](i8 lhs, i8 rhs) { return saturate<i8>(lhs - rhs); });
+    check_lanewise<Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<u8, Operators::Add>, MakeUnsigned>>(
+        unsigned_values, [](u8 lhs, u8 rhs) { return saturate<u8>(lhs + rhs); });
+    check_lanewise<Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<u8, Operators::Subtract>, MakeUnsigned>>(
+        unsigned_values, [](u8 lhs, u8 rhs) { return saturate<u8>(lhs - rhs); });
+}
+
+TEST_CASE(saturating_add_and_subtract_16_bit)
+{
+    auto signed_values = sampled_16_bit_values<i16>();
+    auto unsigned_values = sampled_16_bit_values<u16>();
+
+    check_lanewise<Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Add>, MakeSigned>>(
+        signed_values, [](i16 lhs, i16 rhs) { return saturate<i16>(lhs + rhs); });
+    check_lanewise<Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Subtract>, MakeSigned>>(
+        signed_values, [](i16 lhs, i16 rhs) { return saturate<i16>(lhs - rhs); });
+    check_lanewise<Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<u16, Operators::Add>, MakeUnsigned>>(
+        unsigned_values, [](u16 lhs, u16 rhs) { return saturate<u16>(lhs + rhs); });
+    check_lanewise<Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<u16, Operators::Subtract>, MakeUnsigned>>(
+        unsigned_values, [](u16 lhs, u16 rhs) { return saturate<u16>(lhs - rhs); });
+}
+
+TEST_CASE(rounding_average)
+{
+    check_lanewise<Operators::VectorIntegerBinaryOp<16, Operators::Average, MakeUnsigned>>(
+        all_8_bit_values<u8>(), [](u8 lhs, u8 rhs) { return (static_cast<u32>(lhs) + rhs + 1) / 2; });
+    check_lanewise<Operators::VectorIntegerBinaryOp<8, Operators::Average, MakeUnsigned>>(
+        sampled_16_bit_values<u16>(), [](u16 lhs, u16 rhs) { return (static_cast<u32>(lhs) + rhs + 1) / 2; });
+}
+
+TEST_CASE(narrow)
+{
+    auto values = all_16_bit_values<i16>();
+    check_narrow<Operators::VectorNarrow<16, i8>, i8>(values);
+    check_narrow<Operators::VectorNarrow<16, u8>, u8>(values);
+
+    auto wide_values = sampled_32_bit_values();
+    check_narrow<Operators::VectorNarrow<8, i16>, i16>(wide_values);
+    check_narrow<Operators::VectorNarrow<8, u16>, u16>(wide_values);
+}
+
+TEST_CASE(extadd_pairwise)
+{
+    check_pairwise_add<Operators::VectorIntegerExtOpPairwise<8, Operators::Add, MakeSigned>, i16>(all_8_bit_values<i8>());
+    check_pairwise_add<Operators::VectorIntegerExtOpPairwise<8, Operators::Add, MakeUnsigned>, u16>(all_8_bit_values<u8>());
+    check_pairwise_add<Operators::VectorIntegerExtOpPairwise<4, Operators::Add, MakeSigned>, i32>(sampled_16_bit_values<i16>());
+    check_pairwise_add<Operators::VectorIntegerExtOpPairwise<4, Operators::Add, MakeUnsigned>, u32>(sampled_16_bit_values<u16>());
+}
+
+TEST_CASE(dot_product)
+{
+    auto values = sampled_16_bit_values<i16>();
+
+    // Each lane multiplies one value by a pair of others; with the pair being the same value twice, the sum of the two
+    // products overflows (and wraps around) for -0x8000 * -0x8000.
+    for (size_t pair_distance : { 0u, 1u, 97u }) {
+        for (auto first : values) {
+            for (size_t offset = 0; offset < values.size(); offset += 4) {
+                Array<i16, 8> lhs_lanes;
+                Array<i16, 8> rhs_lanes;
+                for (size_t i = 0; i < 4; ++i) {
+                    lhs_lanes[2 * i] = first;
+                    lhs_lanes[2 * i + 1] = values[(offset + i + pair_distance) % values.size()];
+                    rhs_lanes[2 * i] = values[(offset + i) % values.size()];
+                    rhs_lanes[2 * i + 1] = first;
+                }
+
+                auto result = bit_cast<Array<i32, 4>>(Operators::VectorDotProduct<4> {}(bit_cast<u128>(lhs_lanes), bit_cast<u128>(rhs_lanes)));
+                for (size_t i = 0; i < 4; ++i) {
+                    auto sum = static_cast<i64>(lhs_lanes[2 * i]) * rhs_lanes[2 * i] + static_cast<i64>(lhs_lanes[2 * i + 1]) * rhs_lanes[2 * i + 1];
+                    EXPECT_EQ(result[i], static_cast<i32>(static_cast<u32>(sum)));
+                }
+            }
+        }
+    }
+}
@@ -47,6 +47,7 @@ public:
         : JS::Object(ConstructWithPrototypeTag::Tag, prototype)
     {
         m_machine.enable_instruction_count_limit();
+        m_machine.store().set_memory_kind(Wasm::MemoryInstance::Kind::GuardPages);
     }
 
     static Wasm::AbstractMachine& machine() { return m_machine; }
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringView.h>
+#include <LibCore/Command.h>
+#include <LibTest/Macros.h>
+#include <LibTest/TestCase.h>
+
+static void run_js(Vector<char const*>&& arguments, StringView expected_stdout)
+{
+    MUST(arguments.try_insert(0, "js"));
+    MUST(arguments.try_append(nullptr));
+    auto js = MUST(Core::Command::create("js"sv, arguments.data()));
+    auto [stdout, stderr] = MUST(js->read_all());
+    auto status = MUST(js->status());
+    if (status != Core::Command::ProcessResult::DoneWithZeroExitCode) {
+        FAIL(ByteString::formatted("js didn't exit cleanly: status: {}, stdout:{}, stderr: {}", static_cast<int>(status), StringView { stdout.bytes() }, StringView { stderr.bytes() }));
+    }
+    EXPECT_EQ(StringView { expected_stdout.bytes() }, StringView { stdout.bytes() });
+}
+
+// The loop and the function it calls are hot enough to be compiled by the JIT, which has to work within what js pledges.
+static constexpr auto hot_loop = "function add(a, b) { return a + b; } let sum = 0; for (let i = 0; i < 10000; ++i) sum = add(sum, i); console.log(sum);";
+
+TEST_CASE(hot_loop_under_pledge)
+{
+    run_js({ "-c", hot_loop }, "49995000\n"sv);
+    run_js({ "--disable-jit", "-c", hot_loop }, "49995000\n"sv);
+}
+
+// Enough live cells to spread marking over several threads, which have to be started within what js pledges.
+static constexpr auto many_chains = "let chains = []; for (let i = 0; i < 2000; ++i) { let head = null; for (let j = 0; j < 50; ++j) head = { value: j, next: head }; chains.push(head); } gc(); let sum = 0; for (const head of chains) for (let node = head; node; node = node.next) sum += node.value; console.log(sum);";
+
+TEST_CASE(parallel_marking_under_pledge)
+{
+    run_js({ "-c", many_chains }, "2450000\n"sv);
+    run_js({ "--gc-marking-threads", "4", "-c", many_chains }, "2450000\n"sv);
+}
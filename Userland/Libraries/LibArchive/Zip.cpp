@@ -52,7 +52,7 @@ Optional<Zip> Zip::try_create(ReadonlyBytes buffer)
             return {}; // TODO: support encrypted zip members
         if (central_directory_record.general_purpose_flags.data_descriptor)
             return {}; // TODO: support zip data descriptors
-        if (central_directory_record.compression_method != ZipCompressionMethod::Store && central_directory_record.compression_method != ZipCompressionMethod::Deflate)
+        if (central_directory_record.compression_method != ZipCompressionMethod::Store && central_directory_record.compression_method != ZipCompressionMethod::Deflate && central_directory_record.compression_method != ZipCompressionMethod::Zstandard)
             return {}; // TODO: support obsolete zip compression methods
         if (central_directory_record.compression_method == ZipCompressionMethod::Store && central_directory_record.uncompressed_size != central_directory_record.compressed_size)
             return {};
@@ -132,7 +132,9 @@ ZipOutputStream::ZipOutputStream(NonnullOwnPtr<Stream> stream)
 
 static u16 minimum_version_needed(ZipCompressionMethod method)
 {
-    // Deflate was added in PKZip 2.0
+    // Deflate was added in PKZip 2.0, Zstandard in version 6.3.7 of the APPNOTE
+    if (method == ZipCompressionMethod::Zstandard)
+        return 63;
     return method == ZipCompressionMethod::Deflate ? 20 : 10;
 }
 
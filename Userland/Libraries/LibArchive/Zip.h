@@ -89,7 +89,8 @@ enum class ZipCompressionMethod : u16 {
     Reduce4 = 5,
     Implode = 6,
     Reserved = 7,
-    Deflate = 8
+    Deflate = 8,
+    Zstandard = 93,
 };
 
 union ZipGeneralPurposeFlags {
@@ -4,28 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/BinarySearch.h>
-#include <AK/QuickSort.h>
 #include <LibCompress/Brotli.h>
 #include <LibCompress/BrotliDictionary.h>
 
 namespace Compress {
 
-ErrorOr<size_t> Brotli::CanonicalCode::read_symbol(LittleEndianInputBitStream& input_stream) const
+ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::for_single_symbol(u16 symbol)
 {
-    size_t code_bits = 1;
-
-    while (code_bits < (1 << 16)) {
-        // FIXME: This is very inefficient and could greatly be improved by implementing this
-        //        algorithm: https://www.hanshq.net/zip.html#huffdec
-        size_t index;
-        if (binary_search(m_symbol_codes.span(), code_bits, &index))
-            return m_symbol_values[index];
-
-        code_bits = (code_bits << 1) | TRY(input_stream.read_bit());
-    }
-
-    return Error::from_string_literal("no matching code found");
+    CanonicalCode code;
+    code.m_decoding_table = TRY(HuffmanDecodingTable::for_single_symbol(symbol, 0));
+    return code;
 }
 
 BrotliDecompressionStream::BrotliDecompressionStream(MaybeOwned<Stream> stream)
@@ -200,33 +188,32 @@ ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::read_simple_prefix_code(Li
             return Error::from_string_literal("symbol larger than alphabet");
     }
 
-    if (number_of_symbols == 1) {
-        code.m_symbol_codes.append(0b1);
-        code.m_symbol_values = move(symbols);
-    } else if (number_of_symbols == 2) {
-        code.m_symbol_codes.extend({ 0b10, 0b11 });
-        if (symbols[0] > symbols[1])
-            swap(symbols[0], symbols[1]);
-        code.m_symbol_values = move(symbols);
+    if (number_of_symbols == 1)
+        return for_single_symbol(symbols[0]);
+
+    // The code lengths of the symbols in the order they were read (RFC 7932 section 3.4).
+    Array<u8, 4> lengths;
+    if (number_of_symbols == 2) {
+        lengths = { 1, 1 };
     } else if (number_of_symbols == 3) {
-        code.m_symbol_codes.extend({ 0b10, 0b110, 0b111 });
-        if (symbols[1] > symbols[2])
-            swap(symbols[1], symbols[2]);
-        code.m_symbol_values = move(symbols);
-    } else if (number_of_symbols == 4) {
+        lengths = { 1, 2, 2 };
+    } else {
         bool tree_select = TRY(stream.read_bit());
-        if (tree_select) {
-            code.m_symbol_codes.extend({ 0b10, 0b110, 0b1110, 0b1111 });
-            if (symbols[2] > symbols[3])
-                swap(symbols[2], symbols[3]);
-            code.m_symbol_values = move(symbols);
-        } else {
-            code.m_symbol_codes.extend({ 0b100, 0b101, 0b110, 0b111 });
-            quick_sort(symbols);
-            code.m_symbol_values = move(symbols);
-        }
+        if (tree_select)
+            lengths = { 1, 2, 3, 3 };
+        else
+            lengths = { 2, 2, 2, 2 };
     }
 
+    Vector<u8> code_lengths;
+    TRY(code_lengths.try_resize(alphabet_size));
+    for (size_t i = 0; i < number_of_symbols; i++) {
+        if (code_lengths[symbols[i]] != 0)
+            return Error::from_string_literal("duplicate symbol in simple prefix code");
+        code_lengths[symbols[i]] = lengths[i];
+    }
+
+    code.m_decoding_table = TRY(HuffmanDecodingTable::from_code_lengths(code_lengths));
     return code;
 }
 
@@ -239,7 +226,6 @@ ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::read_complex_prefix_code(L
     // Read the prefix code_value that is used to encode the actual prefix code_value
     size_t const symbol_mapping[18] = { 1, 2, 3, 4, 0, 5, 17, 6, 16, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
     size_t code_length[18] { 0 };
-    size_t code_length_counts[6] { 0 };
 
     size_t sum = 0;
     size_t number_of_non_zero_symbols = 0;
@@ -248,7 +234,6 @@ ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::read_complex_prefix_code(L
         code_length[symbol_mapping[i]] = len;
 
         if (len != 0) {
-            code_length_counts[len]++;
             sum += (32 >> len);
             number_of_non_zero_symbols++;
         }
@@ -259,28 +244,19 @@ ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::read_complex_prefix_code(L
             return Error::from_string_literal("invalid prefix code");
     }
 
+    if (number_of_non_zero_symbols == 0)
+        return Error::from_string_literal("invalid prefix code");
+
     CanonicalCode temp_code;
     if (number_of_non_zero_symbols > 1) {
-        size_t code_value = 0;
-        for (size_t bits = 1; bits <= 5; bits++) {
-            code_value = (code_value + code_length_counts[bits - 1]) << 1;
-            size_t current_code_value = code_value;
-
-            for (size_t i = 0; i < 18; i++) {
-                size_t len = code_length[i];
-                if (len == bits) {
-                    temp_code.m_symbol_codes.append((1 << bits) | current_code_value);
-                    temp_code.m_symbol_values.append(i);
-                    current_code_value++;
-                }
-            }
-        }
+        u8 temp_code_lengths[18];
+        for (size_t i = 0; i < 18; i++)
+            temp_code_lengths[i] = code_length[i];
+        temp_code.m_decoding_table = TRY(HuffmanDecodingTable::from_code_lengths({ temp_code_lengths, sizeof(temp_code_lengths) }));
     } else {
         for (size_t i = 0; i < 18; i++) {
-            size_t len = code_length[i];
-            if (len != 0) {
-                temp_code.m_symbol_codes.append(1);
-                temp_code.m_symbol_values.append(i);
+            if (code_length[i] != 0) {
+                temp_code = TRY(for_single_symbol(i));
                 break;
             }
         }
@@ -296,14 +272,12 @@ ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::read_complex_prefix_code(L
 
     Vector<size_t> result_symbols;
     Vector<size_t> result_lengths;
-    size_t result_lengths_count[16] { 0 };
     while (i < alphabet_size) {
         auto symbol = TRY(temp_code.read_symbol(stream));
 
         if (symbol < 16) {
             result_symbols.append(i);
             result_lengths.append(symbol);
-            result_lengths_count[symbol]++;
 
             if (symbol != 0) {
                 previous_non_zero_code_length = symbol;
@@ -328,7 +302,6 @@ ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::read_complex_prefix_code(L
             for (size_t rep = 0; rep < (repeat_count - last_repeat); rep++) {
                 result_symbols.append(i);
                 result_lengths.append(previous_non_zero_code_length);
-                result_lengths_count[previous_non_zero_code_length]++;
 
                 if (previous_non_zero_code_length != 0) {
                     sum += (32768 >> previous_non_zero_code_length);
@@ -362,24 +335,14 @@ ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::read_complex_prefix_code(L
 
         last_symbol = symbol;
     }
-    result_lengths_count[0] = 0;
 
-    CanonicalCode final_code;
+    Vector<u8> final_code_lengths;
+    TRY(final_code_lengths.try_resize(alphabet_size));
+    for (size_t n = 0; n < result_symbols.size(); n++)
+        final_code_lengths[result_symbols[n]] = result_lengths[n];
 
-    size_t code_value = 0;
-    for (size_t bits = 1; bits < 16; bits++) {
-        code_value = (code_value + result_lengths_count[bits - 1]) << 1;
-        size_t current_code_value = code_value;
-
-        for (size_t n = 0; n < result_symbols.size(); n++) {
-            size_t len = result_lengths[n];
-            if (len == bits) {
-                final_code.m_symbol_codes.append((1 << bits) | current_code_value);
-                final_code.m_symbol_values.append(result_symbols[n]);
-                current_code_value++;
-            }
-        }
-    }
+    CanonicalCode final_code;
+    final_code.m_decoding_table = TRY(HuffmanDecodingTable::from_code_lengths(final_code_lengths));
 
     return final_code;
 }
@@ -10,6 +10,7 @@
 #include <AK/CircularQueue.h>
 #include <AK/FixedArray.h>
 #include <AK/Vector.h>
+#include <LibCompress/Huffman.h>
 
 namespace Compress {
 
@@ -18,23 +19,20 @@ namespace Brotli {
 class CanonicalCode {
 public:
     CanonicalCode() = default;
-    CanonicalCode(Vector<size_t> codes, Vector<size_t> values)
-        : m_symbol_codes(move(codes))
-        , m_symbol_values(move(values))
-    {
-    }
 
     static ErrorOr<CanonicalCode> read_prefix_code(LittleEndianInputBitStream&, size_t alphabet_size);
     static ErrorOr<CanonicalCode> read_simple_prefix_code(LittleEndianInputBitStream&, size_t alphabet_size);
     static ErrorOr<CanonicalCode> read_complex_prefix_code(LittleEndianInputBitStream&, size_t alphabet_size, size_t hskip);
 
-    ErrorOr<size_t> read_symbol(LittleEndianInputBitStream&) const;
+    // A code with only one symbol, which is decoded without reading any bits.
+    static ErrorOr<CanonicalCode> for_single_symbol(u16 symbol);
+
+    ErrorOr<size_t> read_symbol(LittleEndianInputBitStream& input_stream) const { return m_decoding_table.read_symbol(input_stream); }
 
 private:
     static ErrorOr<size_t> read_complex_prefix_code_length(LittleEndianInputBitStream&);
 
-    Vector<size_t> m_symbol_codes;
-    Vector<size_t> m_symbol_values;
+    HuffmanDecodingTable m_decoding_table;
 };
 
 }
@@ -7,10 +7,14 @@
 
 #include <AK/Array.h>
 #include <AK/Assertions.h>
-#include <AK/BinarySearch.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/MemoryStream.h>
 #include <LibCompress/Deflate.h>
 #include <LibCompress/Huffman.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Checksum/Adler32.h>
+#include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace Compress {
 
@@ -20,35 +24,21 @@ static constexpr u8 deflate_special_code_length_long_zeros = 18;
 
 static constexpr int EndOfBlock = 256;
 
+// NOTE: These are function-local statics (rather than being lazily assigned) so that their initialization is
+//       thread-safe, as multiple compressors may be running at the same time.
 CanonicalCode const& CanonicalCode::fixed_literal_codes()
 {
-    static CanonicalCode code;
-    static bool initialized = false;
-
-    if (initialized)
-        return code;
-
-    code = MUST(CanonicalCode::from_bytes(fixed_literal_bit_lengths));
-    initialized = true;
-
+    static CanonicalCode const code = MUST(CanonicalCode::from_bytes(fixed_literal_bit_lengths, HuffmanDecodingTable::LiteralPairs::Yes));
     return code;
 }
 
 CanonicalCode const& CanonicalCode::fixed_distance_codes()
 {
-    static CanonicalCode code;
-    static bool initialized = false;
-
-    if (initialized)
-        return code;
-
-    code = MUST(CanonicalCode::from_bytes(fixed_distance_bit_lengths));
-    initialized = true;
-
+    static CanonicalCode const code = MUST(CanonicalCode::from_bytes(fixed_distance_bit_lengths));
     return code;
 }
 
-ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
+ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes, HuffmanDecodingTable::LiteralPairs literal_pairs)
 {
     CanonicalCode code;
 
@@ -62,9 +52,7 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     }
 
     if (non_zero_symbols == 1) { // special case - only 1 symbol
-        code.m_prefix_table[0] = PrefixTableEntry { static_cast<u16>(last_non_zero), 1u };
-        code.m_prefix_table[1] = code.m_prefix_table[0];
-        code.m_max_prefixed_code_length = 1;
+        code.m_decoding_table = TRY(HuffmanDecodingTable::for_single_symbol(last_non_zero, 1));
 
         if (code.m_bit_codes.size() < static_cast<size_t>(last_non_zero + 1)) {
             TRY(code.m_bit_codes.try_resize(last_non_zero + 1));
@@ -76,25 +64,11 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         return code;
     }
 
-    struct PrefixCode {
-        u16 symbol_code { 0 };
-        u16 symbol_value { 0 };
-        u16 code_length { 0 };
-    };
-    Array<PrefixCode, 1 << CanonicalCode::max_allowed_prefixed_code_length> prefix_codes;
-    size_t number_of_prefix_codes = 0;
-
-    code.m_first_symbol_of_length_after.append(0);
-    code.m_offset_to_first_symbol_index.append(0);
-
     auto next_code = 0;
     for (size_t code_length = 1; code_length <= 15; ++code_length) {
         next_code <<= 1;
         auto start_bit = 1 << code_length;
 
-        auto first_code_at_length = next_code;
-        auto first_symbol_index_at_length = code.m_symbol_values.size();
-
         for (size_t symbol = 0; symbol < bytes.size(); ++symbol) {
             if (bytes[symbol] != code_length)
                 continue;
@@ -102,20 +76,6 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             if (next_code > start_bit)
                 return Error::from_string_literal("Failed to decode code lengths");
 
-            code.m_symbol_values.append(symbol);
-
-            if (code_length <= CanonicalCode::max_allowed_prefixed_code_length) {
-                if (number_of_prefix_codes >= prefix_codes.size())
-                    return Error::from_string_literal("Invalid canonical Huffman code");
-
-                auto& prefix_code = prefix_codes[number_of_prefix_codes++];
-                prefix_code.symbol_code = next_code;
-                prefix_code.symbol_value = symbol;
-                prefix_code.code_length = code_length;
-
-                code.m_max_prefixed_code_length = code_length;
-            }
-
             if (code.m_bit_codes.size() < symbol + 1) {
                 TRY(code.m_bit_codes.try_resize(symbol + 1));
                 TRY(code.m_bit_code_lengths.try_resize(symbol + 1));
@@ -125,63 +85,25 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
 
             next_code++;
         }
-
-        u32 sentinel = next_code;
-        code.m_first_symbol_of_length_after.append(sentinel);
-        VERIFY(code.m_first_symbol_of_length_after[code_length] == sentinel);
-
-        if (code.m_symbol_values.size() > first_symbol_index_at_length)
-            code.m_offset_to_first_symbol_index.append(first_symbol_index_at_length - first_code_at_length);
-        else
-            code.m_offset_to_first_symbol_index.append(0); // Never evaluated.
     }
 
     if (next_code != (1 << 15))
         return Error::from_string_literal("Failed to decode code lengths");
 
-    for (auto [symbol_code, symbol_value, code_length] : prefix_codes) {
-        if (code_length == 0 || code_length > CanonicalCode::max_allowed_prefixed_code_length)
-            break;
-
-        auto shift = code.m_max_prefixed_code_length - code_length;
-        symbol_code <<= shift;
-
-        for (size_t j = 0; j < (1u << shift); ++j) {
-            auto index = fast_reverse16(symbol_code + j, code.m_max_prefixed_code_length);
-            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, code_length };
-        }
-    }
+    code.m_decoding_table = TRY(HuffmanDecodingTable::from_code_lengths(bytes, literal_pairs));
 
     return code;
 }
 
 ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
 {
-    auto prefix = TRY(stream.peek_bits<size_t>(m_max_prefixed_code_length));
-
-    if (auto [symbol_value, code_length] = m_prefix_table[prefix]; code_length != 0) {
-        stream.discard_previously_peeked_bits(code_length);
-        return symbol_value;
-    }
-
-    auto code_bits = TRY(stream.read_bits<u16>(m_max_prefixed_code_length + 1));
-    code_bits = fast_reverse16(code_bits, m_max_prefixed_code_length + 1);
-
-    for (size_t i = m_max_prefixed_code_length + 1; i <= 15; ++i) {
-        if (code_bits < m_first_symbol_of_length_after[i]) {
-            auto symbol_index = (uint16_t)(m_offset_to_first_symbol_index[i] + code_bits);
-            return m_symbol_values[symbol_index];
-        }
-        code_bits = code_bits << 1 | TRY(stream.read_bit());
-    }
-
-    return Error::from_string_literal("Symbol exceeds maximum symbol number");
+    return m_decoding_table.read_symbol(stream);
 }
 
 DeflateDecompressor::CompressedBlock::CompressedBlock(DeflateDecompressor& decompressor, CanonicalCode literal_codes, Optional<CanonicalCode> distance_codes)
     : m_decompressor(decompressor)
-    , m_literal_codes(literal_codes)
-    , m_distance_codes(distance_codes)
+    , m_literal_codes(move(literal_codes))
+    , m_distance_codes(move(distance_codes))
 {
 }
 
@@ -190,6 +112,9 @@ ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
     if (m_eof == true)
         return false;
 
+    if (TRY(decode_buffered_symbols()))
+        return true;
+
     auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
 
     if (symbol >= 286)
@@ -224,6 +149,111 @@ ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
     return true;
 }
 
+// Decodes as many symbols as possible straight from the input stream's bit buffer, which is refilled a word at a time.
+// As long as enough bits for a complete back-reference are buffered, this needs no per-symbol error checking.
+// Returns false if nothing could be decoded this way (e.g. near the end of the input), which leaves the remaining
+// symbols (and the reporting of any errors) to the symbol-at-a-time path in try_read_more().
+ErrorOr<bool> DeflateDecompressor::CompressedBlock::decode_buffered_symbols()
+{
+    // A literal/length code and its extra bits take up at most 20 bits, a distance code and its extra bits at most 28.
+    static constexpr size_t max_length_bit_count = 15 + 5;
+    static constexpr size_t max_distance_bit_count = 15 + 13;
+
+    auto& input_stream = *m_decompressor.m_input_stream;
+    auto& output_buffer = m_decompressor.m_output_buffer;
+    auto const& literal_table = m_literal_codes.decoding_table();
+    auto const* distance_table = m_distance_codes.has_value() ? &m_distance_codes->decoding_table() : nullptr;
+
+    using Kind = HuffmanDecodingTable::Entry::Kind;
+
+    auto ensure_buffered_bits = [&](size_t count) -> ErrorOr<bool> {
+        if (input_stream.buffered_bit_count() < count)
+            TRY(input_stream.fill_bit_buffer());
+        return input_stream.buffered_bit_count() >= count;
+    };
+
+    // Literals are collected and written in bulk, rather than going through the circular buffer one byte at a time.
+    Array<u8, 256> literals;
+    size_t literal_count = 0;
+    size_t available_space = output_buffer.empty_space();
+    bool made_progress = false;
+
+    auto flush_literals = [&] {
+        auto written = output_buffer.write(literals.span().trim(literal_count));
+        VERIFY(written == literal_count);
+        literal_count = 0;
+    };
+
+    while (available_space >= max_back_reference_length) {
+        if (literal_count + 2 > literals.size())
+            flush_literals();
+
+        if (!TRY(ensure_buffered_bits(max_length_bit_count)))
+            break;
+
+        auto entry = literal_table.lookup(input_stream.buffered_bits());
+
+        if (entry.kind == Kind::LiteralPair) {
+            literals[literal_count++] = entry.symbol & 0xff;
+            literals[literal_count++] = entry.symbol >> 8;
+            input_stream.discard_previously_peeked_bits(entry.length);
+            available_space -= 2;
+            made_progress = true;
+            continue;
+        }
+
+        if (entry.kind != Kind::Symbol || entry.symbol >= 286)
+            break;
+
+        if (entry.symbol < EndOfBlock) {
+            literals[literal_count++] = entry.symbol;
+            input_stream.discard_previously_peeked_bits(entry.length);
+            available_space -= 1;
+            made_progress = true;
+            continue;
+        }
+
+        if (entry.symbol == EndOfBlock) {
+            input_stream.discard_previously_peeked_bits(entry.length);
+            m_eof = true;
+            made_progress = true;
+            break;
+        }
+
+        if (distance_table == nullptr)
+            break;
+
+        // Nothing is discarded until the whole back-reference has been decoded, so that bailing out leaves the input untouched.
+        auto const& length_symbol = packed_length_symbols[entry.symbol - 257];
+        size_t length_bit_count = entry.length + length_symbol.extra_bits;
+        if (!TRY(ensure_buffered_bits(length_bit_count + max_distance_bit_count)))
+            break;
+
+        auto bits = input_stream.buffered_bits() >> entry.length;
+        u32 length = length_symbol.base_length + (bits & ((1u << length_symbol.extra_bits) - 1));
+        bits >>= length_symbol.extra_bits;
+
+        auto distance_entry = distance_table->lookup(bits);
+        if (distance_entry.kind != Kind::Symbol || distance_entry.symbol >= 30)
+            break;
+
+        auto const& distance_symbol = packed_distances[distance_entry.symbol];
+        bits >>= distance_entry.length;
+        u32 distance = distance_symbol.base_distance + (bits & ((1u << distance_symbol.extra_bits) - 1));
+
+        flush_literals();
+        input_stream.discard_previously_peeked_bits(length_bit_count + distance_entry.length + distance_symbol.extra_bits);
+        available_space -= length;
+        made_progress = true;
+
+        auto copied_length = TRY(output_buffer.copy_from_seekback(distance, length));
+        VERIFY(copied_length == length);
+    }
+
+    flush_literals();
+    return made_progress;
+}
+
 DeflateDecompressor::UncompressedBlock::UncompressedBlock(DeflateDecompressor& decompressor, size_t length)
     : m_decompressor(decompressor)
     , m_bytes_remaining(length)
@@ -250,7 +280,7 @@ ErrorOr<bool> DeflateDecompressor::UncompressedBlock::try_read_more()
 
 ErrorOr<NonnullOwnPtr<DeflateDecompressor>> DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream> stream)
 {
-    auto output_buffer = TRY(CircularBuffer::create_empty(32 * KiB));
+    auto output_buffer = TRY(CircularBuffer::create_empty(window_size));
     return TRY(adopt_nonnull_own_or_enomem(new (nothrow) DeflateDecompressor(move(stream), move(output_buffer))));
 }
 
@@ -315,7 +345,7 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
                 TRY(decode_codes(literal_codes, distance_codes));
 
                 m_state = State::ReadingCompressedBlock;
-                new (&m_compressed_block) CompressedBlock(*this, literal_codes, distance_codes);
+                new (&m_compressed_block) CompressedBlock(*this, move(literal_codes), move(distance_codes));
 
                 continue;
             }
@@ -337,6 +367,9 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
             m_compressed_block.~CompressedBlock();
             m_state = State::Idle;
 
+            if (m_stop_at_block_boundaries)
+                break;
+
             continue;
         }
 
@@ -354,6 +387,9 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
             m_uncompressed_block.~UncompressedBlock();
             m_state = State::Idle;
 
+            if (m_stop_at_block_boundaries)
+                break;
+
             continue;
         }
 
@@ -365,6 +401,32 @@ ErrorOr<Bytes> DeflateDecompressor::read_some(Bytes bytes)
 
 bool DeflateDecompressor::is_eof() const { return m_state == State::Idle && m_read_final_block; }
 
+bool DeflateDecompressor::is_at_block_boundary() const
+{
+    return m_state == State::Idle && !m_read_final_block && m_output_buffer.used_space() == 0;
+}
+
+ErrorOr<ByteBuffer> DeflateDecompressor::copy_window() const
+{
+    VERIFY(is_at_block_boundary());
+
+    auto window = TRY(ByteBuffer::create_uninitialized(m_output_buffer.seekback_limit()));
+    TRY(m_output_buffer.read_with_seekback(window, window.size()));
+    return window;
+}
+
+ErrorOr<void> DeflateDecompressor::set_dictionary(ReadonlyBytes dictionary)
+{
+    VERIFY(is_at_block_boundary());
+
+    // Writing the dictionary and discarding it right away leaves it available for back-references only.
+    dictionary = dictionary.slice_from_end(min(dictionary.size(), window_size));
+    auto written = m_output_buffer.write(dictionary);
+    VERIFY(written == dictionary.size());
+    TRY(m_output_buffer.discard(written));
+    return {};
+}
+
 ErrorOr<size_t> DeflateDecompressor::write_some(ReadonlyBytes)
 {
     return Error::from_errno(EBADF);
@@ -463,7 +525,7 @@ ErrorOr<void> DeflateDecompressor::decode_codes(CanonicalCode& literal_code, Opt
         return Error::from_string_literal("Number of code lengths does not match the sum of codes");
 
     // Now we extract the code that was used to encode literals and lengths in the block.
-    literal_code = TRY(CanonicalCode::from_bytes(code_lengths.span().trim(literal_code_count)));
+    literal_code = TRY(CanonicalCode::from_bytes(code_lengths.span().trim(literal_code_count), HuffmanDecodingTable::LiteralPairs::Yes));
 
     // Now we extract the code that was used to encode distances in the block.
 
@@ -483,6 +545,7 @@ ErrorOr<void> DeflateDecompressor::decode_codes(CanonicalCode& literal_code, Opt
 
 ErrorOr<NonnullOwnPtr<DeflateCompressor>> DeflateCompressor::construct(MaybeOwned<Stream> stream, CompressionLevel compression_level)
 {
+    VERIFY(static_cast<int>(compression_level) >= 0 && static_cast<int>(compression_level) <= max_compression_level);
     auto bit_stream = TRY(try_make<LittleEndianOutputBitStream>(move(stream)));
     auto deflate_compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DeflateCompressor(move(bit_stream), compression_level)));
     return deflate_compressor;
@@ -495,6 +558,9 @@ DeflateCompressor::DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>
 {
     m_symbol_frequencies.fill(0);
     m_distance_frequencies.fill(0);
+
+    for (auto& slot : m_hash_head) // initialize chained hash table
+        slot = empty_slot;
 }
 
 DeflateCompressor::~DeflateCompressor()
@@ -556,8 +622,21 @@ size_t DeflateCompressor::compare_match_candidate(size_t start, size_t candidate
             return 0;
     }
 
-    // Find the actual length
+    // Find the actual length, comparing 8 bytes at a time for as long as possible
+    auto read_u64 = [&](size_t position) {
+        u64 value;
+        __builtin_memcpy(&value, &m_rolling_window[position], sizeof(value));
+        return AK::convert_between_host_and_little_endian(value);
+    };
     auto match_length = previous_match_length + 1;
+    while (match_length + sizeof(u64) <= maximum_match_length) {
+        auto difference = read_u64(start + match_length) ^ read_u64(candidate + match_length);
+        if (difference != 0) {
+            match_length += count_trailing_zeroes(difference) / 8;
+            break;
+        }
+        match_length += sizeof(u64);
+    }
     while (match_length < maximum_match_length && m_rolling_window[start + match_length] == m_rolling_window[candidate + match_length]) {
         match_length++;
     }
@@ -586,7 +665,7 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             break; // no remaining candidates
 
         VERIFY(candidate < start);
-        if (start - candidate > window_size)
+        if (start - candidate > max_back_reference_distance)
             break; // outside the window
 
         auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
@@ -596,56 +675,164 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             match_position = candidate;
             previous_match_length = match_length;
 
-            if (match_length == maximum_match_length)
-                return match_length; // bail if we got the maximum possible length
+            if (match_length >= m_compression_constants.great_match_length || match_length == maximum_match_length)
+                break; // bail if we got a great match or the maximum possible length
         }
 
-        candidate = m_hash_prev[candidate % window_size];
+        candidate = m_hash_prev[candidate];
     }
     if (!match_found)
         return 0;                 // we didn't find any matches
     return previous_match_length; // we found matches, but they were at most previous_match_length long
 }
 
+// Like find_back_match(), but adds every match that is longer than the ones before it to m_optimal_matches
+ErrorOr<void> DeflateCompressor::find_all_back_matches(size_t start, u16 hash, size_t maximum_match_length)
+{
+    auto max_chain_length = m_compression_constants.max_chain;
+    auto previous_match_length = min_match_length - 1;
+    if (previous_match_length >= maximum_match_length)
+        return {};
+
+    auto candidate = m_hash_head[hash];
+    while (max_chain_length--) {
+        if (candidate == empty_slot)
+            break; // no remaining candidates
+
+        VERIFY(candidate < start);
+        if (start - candidate > max_back_reference_distance)
+            break; // outside the window
+
+        auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
+
+        if (match_length != 0) {
+            TRY(m_optimal_matches.try_append({ static_cast<u16>(match_length), static_cast<u16>(start - candidate) }));
+
+            if (match_length >= m_compression_constants.great_match_length || match_length == maximum_match_length)
+                break; // bail if we got a great match or the maximum possible length
+            if (previous_match_length < m_compression_constants.good_match_length && match_length >= m_compression_constants.good_match_length)
+                max_chain_length /= 4; // we already have a pretty good much, so do a shorter search
+            previous_match_length = match_length;
+        }
+
+        candidate = m_hash_prev[candidate];
+    }
+    return {};
+}
+
+ALWAYS_INLINE void DeflateCompressor::insert_hash(size_t position, u16 hash)
+{
+    m_hash_prev[position] = m_hash_head[hash];
+    m_hash_head[hash] = position;
+}
+
+void DeflateCompressor::slide_hash_table()
+{
+    // The pending block was just moved to the start of the rolling window, so everything in the hash table moves along
+    // with it, and whatever was in the first half of the window is gone.
+    auto slide = [](u16 position) -> u16 {
+        if (position == empty_slot || position < block_size)
+            return empty_slot;
+        return position - block_size;
+    };
+    for (auto& slot : m_hash_head)
+        slot = slide(slot);
+    for (size_t i = 0; i < block_size; i++)
+        m_hash_prev[i] = slide(m_hash_prev[i + block_size]);
+    m_hash_insert_position -= min(m_hash_insert_position, block_size);
+}
+
 ALWAYS_INLINE u8 DeflateCompressor::distance_to_base(u16 distance)
 {
     return (distance <= 256) ? distance_to_base_lo[distance - 1] : distance_to_base_hi[(distance - 1) >> 7];
 }
 
-void DeflateCompressor::lz77_compress_block()
+ALWAYS_INLINE void DeflateCompressor::emit_literal(u8 literal)
 {
-    for (auto& slot : m_hash_head) { // initialize chained hash table
-        slot = empty_slot;
+    VERIFY(m_pending_symbol_size <= block_size + 1);
+    auto index = m_pending_symbol_size++;
+    m_symbol_buffer[index].distance = 0;
+    m_symbol_buffer[index].literal = literal;
+    m_symbol_frequencies[literal]++;
+}
+
+ALWAYS_INLINE void DeflateCompressor::emit_back_reference(u16 distance, u16 length)
+{
+    VERIFY(m_pending_symbol_size <= block_size + 1);
+    auto index = m_pending_symbol_size++;
+    m_symbol_buffer[index].distance = distance;
+    m_symbol_buffer[index].length = length;
+    m_symbol_frequencies[length_to_symbol[length]]++;
+    m_distance_frequencies[distance_to_base(distance)]++;
+}
+
+ErrorOr<void> DeflateCompressor::lz77_compress_block()
+{
+    VERIFY(m_compression_constants.great_match_length <= max_match_length);
+
+    // sequences that start at the end of the previous block (or of a preset dictionary) can only be hashed now that the following bytes are known
+    for (; m_hash_insert_position < block_size; m_hash_insert_position++)
+        insert_hash(m_hash_insert_position, hash_sequence(&m_rolling_window[m_hash_insert_position]));
+
+    switch (m_compression_constants.strategy) {
+    case Strategy::Greedy:
+        lz77_compress_block_greedy();
+        break;
+    case Strategy::Lazy:
+        lz77_compress_block_lazy();
+        break;
+    case Strategy::Optimal:
+        TRY(lz77_compress_block_optimal());
+        break;
+    case Strategy::Store:
+        VERIFY_NOT_REACHED();
     }
 
-    auto insert_hash = [&](auto pos, auto hash) {
-        auto window_pos = pos % window_size;
-        m_hash_prev[window_pos] = m_hash_head[hash];
-        m_hash_head[hash] = window_pos;
-    };
+    // the last few positions of this block are hashed together with the next block
+    m_hash_insert_position = max(block_size, block_size + m_pending_block_size - min_match_length + 1);
+    return {};
+}
 
-    auto emit_literal = [&](auto literal) {
-        VERIFY(m_pending_symbol_size <= block_size + 1);
-        auto index = m_pending_symbol_size++;
-        m_symbol_buffer[index].distance = 0;
-        m_symbol_buffer[index].literal = literal;
-        m_symbol_frequencies[literal]++;
-    };
+void DeflateCompressor::lz77_compress_block_greedy()
+{
+    // our block starts at block_size and is m_pending_block_size in length
+    auto block_end = block_size + m_pending_block_size;
+    auto hash_end = block_end - min_match_length + 1;
+    auto current_position = block_size;
+    while (current_position < hash_end) {
+        auto hash = hash_sequence(&m_rolling_window[current_position]);
+        size_t match_position;
+        auto match_length = find_back_match(current_position, hash, 0, min(max_match_length, block_end - current_position), match_position);
 
-    auto emit_back_reference = [&](auto distance, auto length) {
-        VERIFY(m_pending_symbol_size <= block_size + 1);
-        auto index = m_pending_symbol_size++;
-        m_symbol_buffer[index].distance = distance;
-        m_symbol_buffer[index].length = length;
-        m_symbol_frequencies[length_to_symbol[length]]++;
-        m_distance_frequencies[distance_to_base(distance)]++;
-    };
+        insert_hash(current_position, hash);
+
+        if (match_length == 0) {
+            emit_literal(m_rolling_window[current_position++]);
+            continue;
+        }
+
+        emit_back_reference(current_position - match_position, match_length);
 
+        // adding all the bytes of a long match to the hash chains takes more time than it's worth
+        if (match_length <= m_compression_constants.max_lazy_length) {
+            for (size_t j = current_position + 1; j < min(current_position + match_length, hash_end); j++) {
+                insert_hash(j, hash_sequence(&m_rolling_window[j]));
+            }
+        }
+        current_position += match_length;
+    }
+
+    // output remaining literals
+    while (current_position < block_end) {
+        emit_literal(m_rolling_window[current_position++]);
+    }
+}
+
+void DeflateCompressor::lz77_compress_block_lazy()
+{
     size_t previous_match_length = 0;
     size_t previous_match_position = 0;
 
-    VERIFY(m_compression_constants.great_match_length <= max_match_length);
-
     // our block starts at block_size and is m_pending_block_size in length
     auto block_end = block_size + m_pending_block_size;
     size_t current_position;
@@ -653,7 +840,7 @@ void DeflateCompressor::lz77_compress_block()
         auto hash = hash_sequence(&m_rolling_window[current_position]);
         size_t match_position;
         auto match_length = find_back_match(current_position, hash, previous_match_length,
-            min(m_compression_constants.great_match_length, block_end - current_position), match_position);
+            min(max_match_length, block_end - current_position), match_position);
 
         insert_hash(current_position, hash);
 
@@ -697,6 +884,119 @@ void DeflateCompressor::lz77_compress_block()
     }
 }
 
+ErrorOr<void> DeflateCompressor::lz77_compress_block_optimal()
+{
+    // our block starts at block_size and is m_pending_block_size in length
+    auto block_end = block_size + m_pending_block_size;
+    auto hash_end = block_end - min_match_length + 1;
+
+    // Firstly, collect all the matches of the block. A match that is at least great_match_length long is usually the best
+    // choice anyway, so instead of searching at the positions it covers, just use whatever is left of it there.
+    m_optimal_matches.clear_with_capacity();
+    m_optimal_match_offsets.clear_with_capacity();
+    TRY(m_optimal_match_offsets.try_ensure_capacity(m_pending_block_size + 1));
+
+    size_t skip_end = 0;
+    OptimalMatch skipped_match {};
+    for (size_t position = block_size; position < block_end; position++) {
+        m_optimal_match_offsets.unchecked_append(m_optimal_matches.size());
+        if (position >= hash_end)
+            continue;
+
+        auto hash = hash_sequence(&m_rolling_window[position]);
+        if (position < skip_end) {
+            skipped_match.length--;
+            if (skipped_match.length >= min_match_length)
+                TRY(m_optimal_matches.try_append(skipped_match));
+        } else {
+            auto match_count = m_optimal_matches.size();
+            TRY(find_all_back_matches(position, hash, min(max_match_length, block_end - position)));
+            if (m_optimal_matches.size() != match_count && m_optimal_matches.last().length >= m_compression_constants.great_match_length) {
+                skipped_match = m_optimal_matches.last();
+                skip_end = position + skipped_match.length;
+            }
+        }
+        insert_hash(position, hash);
+    }
+    m_optimal_match_offsets.unchecked_append(m_optimal_matches.size());
+
+    // Then find the cheapest way to encode the block, going backwards from its end. The cost of every symbol is estimated
+    // from the fixed huffman codes at first, and then from the dynamic codes that the previous pass would have resulted in.
+    TRY(m_optimal_nodes.try_resize(m_pending_block_size + 1));
+
+    Array<u8, max_huffman_literals> literal_bit_lengths = fixed_literal_bit_lengths;
+    Array<u8, max_huffman_distances> distance_bit_lengths = fixed_distance_bit_lengths;
+    Array<u32, max_match_length + 1> length_costs {};
+
+    constexpr size_t optimal_parsing_passes = 2;
+    for (size_t pass = 0; pass < optimal_parsing_passes; pass++) {
+        if (pass != 0) {
+            Array<u16, max_huffman_literals> symbol_frequencies {};
+            Array<u16, max_huffman_distances> distance_frequencies {};
+            for (size_t i = 0; i < m_pending_block_size; i += m_optimal_nodes[i].length) {
+                auto const& node = m_optimal_nodes[i];
+                if (node.length == 1) {
+                    symbol_frequencies[m_rolling_window[block_size + i]]++;
+                } else {
+                    symbol_frequencies[length_to_symbol[node.length]]++;
+                    distance_frequencies[distance_to_base(node.distance)]++;
+                }
+            }
+            symbol_frequencies[EndOfBlock]++;
+            generate_huffman_lengths(literal_bit_lengths, symbol_frequencies, 15);
+            generate_huffman_lengths(distance_bit_lengths, distance_frequencies, 15);
+
+            // symbols that weren't used in the previous pass should still be possible to pick, but not too cheaply
+            for (auto& bit_length : literal_bit_lengths) {
+                if (bit_length == 0)
+                    bit_length = 15;
+            }
+            for (auto& bit_length : distance_bit_lengths) {
+                if (bit_length == 0)
+                    bit_length = 15;
+            }
+        }
+
+        // deflate itself allows matches of length 3, so shortening one of our matches to that is fine too
+        for (size_t length = 3; length <= max_match_length; length++) {
+            auto symbol = length_to_symbol[length];
+            length_costs[length] = literal_bit_lengths[symbol] + packed_length_symbols[symbol - 257].extra_bits;
+        }
+
+        // trying every length of a long match takes a lot of time for very little gain, so above this only the full length is tried
+        constexpr size_t max_exhaustive_length = 32;
+
+        m_optimal_nodes[m_pending_block_size] = { 0, 0, 0 };
+        for (size_t i = m_pending_block_size; i-- > 0;) {
+            OptimalNode best_node { literal_bit_lengths[m_rolling_window[block_size + i]] + m_optimal_nodes[i + 1].cost, 1, 0 };
+
+            size_t length = 3;
+            for (size_t match_index = m_optimal_match_offsets[i]; match_index < m_optimal_match_offsets[i + 1]; match_index++) {
+                auto match = m_optimal_matches[match_index];
+                auto base_distance = distance_to_base(match.distance);
+                auto distance_cost = distance_bit_lengths[base_distance] + packed_distances[base_distance].extra_bits;
+                for (; length <= match.length; length++) {
+                    if (length > max_exhaustive_length)
+                        length = match.length;
+                    auto cost = length_costs[length] + distance_cost + m_optimal_nodes[i + length].cost;
+                    if (cost < best_node.cost)
+                        best_node = { cost, static_cast<u16>(length), match.distance };
+                }
+            }
+            m_optimal_nodes[i] = best_node;
+        }
+    }
+
+    for (size_t i = 0; i < m_pending_block_size; i += m_optimal_nodes[i].length) {
+        auto const& node = m_optimal_nodes[i];
+        if (node.length == 1)
+            emit_literal(m_rolling_window[block_size + i]);
+        else
+            emit_back_reference(node.distance, node.length);
+    }
+    return {};
+}
+
 size_t DeflateCompressor::huffman_block_length(Array<u8, max_huffman_literals> const& literal_bit_lengths, Array<u8, max_huffman_distances> const& distance_bit_lengths)
 {
     size_t length = 0;
@@ -891,7 +1191,7 @@ ErrorOr<void> DeflateCompressor::flush()
         return {};
     };
 
-    if (m_compression_level == CompressionLevel::STORE) { // disabled compression fast path
+    if (m_compression_constants.strategy == Strategy::Store) { // disabled compression fast path
         TRY(write_uncompressed());
         m_pending_block_size = 0;
         return {};
@@ -900,7 +1200,7 @@ ErrorOr<void> DeflateCompressor::flush()
     // The following implementation of lz77 compression and huffman encoding is based on the reference implementation by Hans Wennborg https://www.hanshq.net/zip.html
 
     // this reads from the pending block and writes to m_symbol_buffer
-    lz77_compress_block();
+    TRY(lz77_compress_block());
 
     // insert EndOfBlock marker to the symbol buffer
     m_symbol_buffer[m_pending_symbol_size].distance = 0;
@@ -963,6 +1263,7 @@ ErrorOr<void> DeflateCompressor::flush()
     m_distance_frequencies.fill(0);
     // On the final block this copy will potentially produce an invalid search window, but since its the final block we dont care
     pending_block().copy_trimmed_to({ m_rolling_window, block_size });
+    slide_hash_table();
 
     return {};
 }
@@ -976,6 +1277,35 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
+ErrorOr<void> DeflateCompressor::final_sync_flush()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size != 0)
+        TRY(flush());
+
+    // an empty stored block is the only way to get to a byte boundary without ending the deflate stream
+    TRY(m_output_stream->write_bits(0b0u, 1));  // not the final block
+    TRY(m_output_stream->write_bits(0b00u, 2)); // no compression
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xffff));
+    TRY(m_output_stream->flush_buffer_to_stream());
+
+    m_finished = true;
+    return {};
+}
+
+void DeflateCompressor::set_dictionary(ReadonlyBytes dictionary)
+{
+    VERIFY(!m_finished);
+    VERIFY(m_pending_block_size == 0);
+
+    // the dictionary takes the place of the previous block in the rolling window
+    dictionary = dictionary.slice_from_end(min(dictionary.size(), block_size));
+    dictionary.copy_to({ m_rolling_window + block_size - dictionary.size(), dictionary.size() });
+    m_hash_insert_position = block_size - dictionary.size();
+}
+
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
@@ -987,4 +1317,171 @@ ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, Compres
     return output_stream->read_until_eof();
 }
 
+ErrorOr<NonnullOwnPtr<ParallelDeflateCompressor>> ParallelDeflateCompressor::construct(MaybeOwned<Stream> stream, size_t thread_count, DeflateCompressor::CompressionLevel compression_level, Checksum checksum)
+{
+    if (thread_count == 0)
+        thread_count = Core::System::hardware_concurrency();
+
+    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ParallelDeflateCompressor(move(stream), thread_count, compression_level, checksum)));
+    compressor->m_thread_pool = TRY(try_make<ThreadPool>(
+        [compressor = compressor.ptr()](size_t chunk_index) {
+            compressor->compress_chunk(compressor->m_chunks[chunk_index]);
+        },
+        thread_count));
+    return compressor;
+}
+
+ParallelDeflateCompressor::ParallelDeflateCompressor(MaybeOwned<Stream> stream, size_t thread_count, DeflateCompressor::CompressionLevel compression_level, Checksum checksum)
+    : m_output_stream(move(stream))
+    , m_thread_count(thread_count)
+    , m_compression_level(compression_level)
+    , m_checksum_type(checksum)
+    , m_checksum(checksum == Checksum::Adler32 ? 1 : 0) // the checksums of an empty input
+{
+}
+
+ParallelDeflateCompressor::~ParallelDeflateCompressor()
+{
+    VERIFY(m_finished);
+}
+
+ErrorOr<Bytes> ParallelDeflateCompressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> ParallelDeflateCompressor::write_some(ReadonlyBytes bytes)
+{
+    VERIFY(!m_finished);
+
+    // we collect a full chunk for every thread before starting, as each of them only takes a fraction of the time to
+    // compress on its own
+    auto batch_size = m_thread_count * chunk_size;
+    auto pending_input_size = m_input.size() - m_dictionary_size;
+    auto n_written = min(bytes.size(), batch_size - pending_input_size);
+    TRY(m_input.try_append(bytes.trim(n_written)));
+
+    if (pending_input_size + n_written == batch_size)
+        TRY(compress_pending_input(false));
+
+    return n_written;
+}
+
+bool ParallelDeflateCompressor::is_eof() const
+{
+    return true;
+}
+
+bool ParallelDeflateCompressor::is_open() const
+{
+    return m_output_stream->is_open();
+}
+
+void ParallelDeflateCompressor::close()
+{
+}
+
+void ParallelDeflateCompressor::compress_chunk(Chunk& chunk) const
+{
+    switch (m_checksum_type) {
+    case Checksum::None:
+        break;
+    case Checksum::CRC32:
+        chunk.checksum = Crypto::Checksum::CRC32 { chunk.input }.digest();
+        break;
+    case Checksum::Adler32:
+        chunk.checksum = Crypto::Checksum::Adler32 { chunk.input }.digest();
+        break;
+    }
+
+    auto compress = [&]() -> ErrorOr<ByteBuffer> {
+        auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+        auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(*output_stream), m_compression_level));
+
+        deflate_stream->set_dictionary(chunk.dictionary);
+        TRY(deflate_stream->write_until_depleted(chunk.input));
+        if (chunk.is_last)
+            TRY(deflate_stream->final_flush());
+        else
+            TRY(deflate_stream->final_sync_flush());
+
+        return output_stream->read_until_eof();
+    };
+
+    auto output_or_error = compress();
+    if (output_or_error.is_error())
+        chunk.error = output_or_error.release_error();
+    else
+        chunk.output = output_or_error.release_value();
+}
+
+ErrorOr<void> ParallelDeflateCompressor::compress_pending_input(bool is_last_batch)
+{
+    auto input = m_input.bytes();
+
+    auto append_chunk = [&](ReadonlyBytes dictionary, ReadonlyBytes chunk_input, bool is_last) -> ErrorOr<void> {
+        TRY(m_chunks.try_append(Chunk {}));
+        m_chunks.last().dictionary = dictionary;
+        m_chunks.last().input = chunk_input;
+        m_chunks.last().is_last = is_last;
+        return {};
+    };
+
+    m_chunks.clear_with_capacity();
+    for (size_t offset = m_dictionary_size; offset < input.size(); offset += chunk_size) {
+        auto length = min(chunk_size, input.size() - offset);
+        auto dictionary_size = min(offset, DeflateCompressor::block_size);
+        TRY(append_chunk(input.slice(offset - dictionary_size, dictionary_size), input.slice(offset, length), is_last_batch && offset + length == input.size()));
+    }
+
+    // the stream still has to be terminated by a final block, even if there's no input left to put into it
+    if (is_last_batch && m_chunks.is_empty())
+        TRY(append_chunk({}, {}, true));
+
+    for (size_t i = 0; i < m_chunks.size(); ++i)
+        m_thread_pool->submit(i);
+    m_thread_pool->wait_for_all();
+
+    for (auto& chunk : m_chunks) {
+        if (chunk.error.has_value())
+            return chunk.error.release_value();
+
+        TRY(m_output_stream->write_until_depleted(chunk.output));
+
+        if (m_checksum_type == Checksum::CRC32)
+            m_checksum = Crypto::Checksum::CRC32::combine(m_checksum, chunk.checksum, chunk.input.size());
+        else if (m_checksum_type == Checksum::Adler32)
+            m_checksum = Crypto::Checksum::Adler32::combine(m_checksum, chunk.checksum, chunk.input.size());
+        m_total_input_size += chunk.input.size();
+    }
+    m_chunks.clear_with_capacity();
+
+    // keep the end of this batch around, as it is the dictionary for the first chunk of the next one
+    auto dictionary_size = min(input.size(), DeflateCompressor::block_size);
+    input.slice_from_end(dictionary_size).copy_to(m_input.bytes());
+    m_input.resize(dictionary_size);
+    m_dictionary_size = dictionary_size;
+
+    return {};
+}
+
+ErrorOr<void> ParallelDeflateCompressor::final_flush()
+{
+    VERIFY(!m_finished);
+    m_finished = true;
+    TRY(compress_pending_input(true));
+    return {};
+}
+
+ErrorOr<ByteBuffer> ParallelDeflateCompressor::compress_all(ReadonlyBytes bytes, size_t thread_count, DeflateCompressor::CompressionLevel compression_level)
+{
+    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+    auto deflate_stream = TRY(ParallelDeflateCompressor::construct(MaybeOwned<Stream>(*output_stream), thread_count, compression_level));
+
+    TRY(deflate_stream->write_until_depleted(bytes));
+    TRY(deflate_stream->final_flush());
+
+    return output_stream->read_until_eof();
+}
+
 }
@@ -13,9 +13,13 @@
 #include <AK/Endian.h>
 #include <AK/Forward.h>
 #include <AK/MaybeOwned.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
 #include <AK/Stream.h>
 #include <AK/Vector.h>
 #include <LibCompress/DeflateTables.h>
+#include <LibCompress/Huffman.h>
+#include <LibThreading/Forward.h>
 
 namespace Compress {
 
@@ -25,27 +29,16 @@ public:
     ErrorOr<u32> read_symbol(LittleEndianInputBitStream&) const;
     ErrorOr<void> write_symbol(LittleEndianOutputBitStream&, u32) const;
 
+    HuffmanDecodingTable const& decoding_table() const { return m_decoding_table; }
+
     static CanonicalCode const& fixed_literal_codes();
     static CanonicalCode const& fixed_distance_codes();
 
-    static ErrorOr<CanonicalCode> from_bytes(ReadonlyBytes);
+    static ErrorOr<CanonicalCode> from_bytes(ReadonlyBytes, HuffmanDecodingTable::LiteralPairs = HuffmanDecodingTable::LiteralPairs::No);
 
 private:
-    static constexpr size_t max_allowed_prefixed_code_length = 8;
-
-    struct PrefixTableEntry {
-        u16 symbol_value { 0 };
-        u16 code_length { 0 };
-    };
-
-    // Decompression - indexed by code
-    Vector<u16, 286> m_symbol_values;
-
-    Vector<u32, 16> m_first_symbol_of_length_after;
-    Vector<u16, 16> m_offset_to_first_symbol_index;
-
-    Array<PrefixTableEntry, 1 << max_allowed_prefixed_code_length> m_prefix_table {};
-    size_t m_max_prefixed_code_length { 0 };
+    // Decompression
+    HuffmanDecodingTable m_decoding_table;
 
     // Compression - indexed by symbol
     // Deflate uses a maximum of 288 symbols (maximum of 32 for distances),
@@ -71,6 +64,8 @@ private:
         ErrorOr<bool> try_read_more();
 
     private:
+        ErrorOr<bool> decode_buffered_symbols();
+
         bool m_eof { false };
 
         DeflateDecompressor& m_decompressor;
@@ -110,6 +105,16 @@ public:
 
     static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
 
+    // Decompression can be resumed at any block boundary, given the bit position of the next block in the input and
+    // the output preceding it (which the following blocks may refer back to). This is used to build seek indices.
+    static constexpr size_t window_size = 32 * KiB;
+    bool is_at_block_boundary() const;
+    ErrorOr<ByteBuffer> copy_window() const;
+    ErrorOr<void> set_dictionary(ReadonlyBytes);
+
+    // Makes read_some() return at the end of every block, so that callers get a chance to check is_at_block_boundary().
+    void set_stop_at_block_boundaries(bool stop) { m_stop_at_block_boundaries = stop; }
+
 private:
     DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer buffer);
 
@@ -120,6 +125,7 @@ private:
     static constexpr u16 max_back_reference_length = 258;
 
     bool m_read_final_block { false };
+    bool m_stop_at_block_boundaries { false };
 
     State m_state { State::Idle };
     union {
@@ -140,32 +146,50 @@ public:
     static constexpr size_t max_huffman_distances = 32;
     static constexpr size_t min_match_length = 4;   // matches smaller than these are not worth the size of the back reference
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
+    static constexpr size_t max_back_reference_distance = 32 * KiB;
     static constexpr u16 empty_slot = UINT16_MAX;
 
+    enum class Strategy {
+        Store,   // Blocks are written without any compression
+        Greedy,  // Every match is taken right away, and only the positions of short matches are added to the hash chains
+        Lazy,    // A match is deferred if the next byte starts a longer one
+        Optimal, // All matches of a block are collected first, and the cheapest way to encode the block is picked from them
+    };
+
     struct CompressionConstants {
         size_t good_match_length;  // Once we find a match of at least this length (a good enough match) we reduce max_chain to lower processing time
         size_t max_lazy_length;    // If the match is at least this long we dont defer matching to the next byte (which takes time) as its good enough
+                                   // With the greedy strategy, this is the longest match whose positions are still added to the hash chains instead
         size_t great_match_length; // Once we find a match of at least this length (a great match) we can just stop searching for longer ones
         size_t max_chain;          // We only check the actual length of the max_chain closest matches
+        Strategy strategy;
     };
 
-    // These constants were shamelessly "borrowed" from zlib
+    // These constants were shamelessly "borrowed" from zlib, so each level trades speed for size roughly like zlib's level of the same number
     static constexpr CompressionConstants compression_constants[] = {
-        { 0, 0, 0, 0 },
-        { 4, 4, 8, 4 },
-        { 8, 16, 128, 128 },
-        { 32, 258, 258, 4096 },
-        { max_match_length, max_match_length, max_match_length, 1 << hash_bits } // disable all limits
+        { 0, 0, 0, 0, Strategy::Store },
+        { 4, 4, 8, 1, Strategy::Greedy }, // unlike zlib, only the most recent candidate is checked, which makes this a lot faster
+        { 4, 5, 16, 8, Strategy::Greedy },
+        { 4, 6, 32, 32, Strategy::Greedy },
+        { 4, 4, 16, 16, Strategy::Lazy },
+        { 8, 16, 32, 32, Strategy::Lazy },
+        { 8, 16, 128, 128, Strategy::Lazy },
+        { 8, 32, 128, 256, Strategy::Lazy },
+        { 32, 128, 258, 1024, Strategy::Lazy },
+        { 32, 258, 258, 256, Strategy::Optimal }, // optimal parsing makes up for a much shorter max_chain than zlib's 4096
     };
 
+    // Any value from STORE to BEST is a valid level, the named ones are just the commonly used ones.
     enum class CompressionLevel : int {
         STORE = 0,
-        FAST,
-        GOOD,
-        GREAT,
-        BEST // WARNING: this one can take an unreasonable amount of time!
+        FAST = 1,
+        GOOD = 6,
+        GREAT = 8,
+        BEST = 9,
     };
 
+    static constexpr int max_compression_level = static_cast<int>(CompressionLevel::BEST);
+
     static ErrorOr<NonnullOwnPtr<DeflateCompressor>> construct(MaybeOwned<Stream>, CompressionLevel = CompressionLevel::GOOD);
     ~DeflateCompressor();
 
@@ -176,6 +200,14 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
+    // Like final_flush(), but ends the output with an empty stored block instead of marking the last block as final.
+    // This leaves the output byte-aligned and lets the output of another compressor continue the same deflate stream.
+    ErrorOr<void> final_sync_flush();
+
+    // Makes back references into the (up to block_size) last bytes of `dictionary` possible, as if they had been
+    // written right before the actual input. Has to be called before anything is written.
+    void set_dictionary(ReadonlyBytes dictionary);
+
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
 private:
@@ -187,7 +219,15 @@ private:
     static u16 hash_sequence(u8 const* bytes);
     size_t compare_match_candidate(size_t start, size_t candidate, size_t prev_match_length, size_t max_match_length);
     size_t find_back_match(size_t start, u16 hash, size_t previous_match_length, size_t max_match_length, size_t& match_position);
-    void lz77_compress_block();
+    ErrorOr<void> find_all_back_matches(size_t start, u16 hash, size_t max_match_length);
+    void insert_hash(size_t position, u16 hash);
+    void slide_hash_table();
+    void emit_literal(u8 literal);
+    void emit_back_reference(u16 distance, u16 length);
+    void lz77_compress_block_greedy();
+    void lz77_compress_block_lazy();
+    ErrorOr<void> lz77_compress_block_optimal();
+    ErrorOr<void> lz77_compress_block();
 
     // Huffman Coding
     struct code_length_symbol {
@@ -226,8 +266,88 @@ private:
     Array<u16, max_huffman_distances> m_distance_frequencies; // there are 30 valid distance values (distances 30-31 never occur)
 
     // LZ77 Chained hash table
+    // This is kept across blocks, so that matches can reach back into the previous block.
     u16 m_hash_head[1 << hash_bits];
     u16 m_hash_prev[window_size];
+    size_t m_hash_insert_position { block_size }; // positions before this one are already in the hash table (or were skipped on purpose)
+
+    // Optimal parsing
+    struct OptimalMatch {
+        u16 length;
+        u16 distance;
+    };
+    struct OptimalNode {
+        u32 cost;     // the cost in bits of encoding everything from this position to the end of the block
+        u16 length;   // the length of the back reference used at this position, or 1 for a literal
+        u16 distance; // the distance of that back reference
+    };
+    Vector<OptimalMatch> m_optimal_matches;  // all matches of the block, ordered by position and then by increasing length
+    Vector<u32> m_optimal_match_offsets;     // the index of the first match of each position in m_optimal_matches
+    Vector<OptimalNode> m_optimal_nodes;
+};
+
+// Compresses the input in independent chunks on a thread pool, in the style of pigz. Each chunk is primed with the
+// data preceding it as a preset dictionary, which keeps the compression ratio close to that of a single
+// DeflateCompressor, and the compressed chunks are stitched together into a single deflate stream.
+class ParallelDeflateCompressor final : public Stream {
+public:
+    static constexpr size_t chunk_size = 128 * KiB;
+
+    // Checksums of the uncompressed data are computed alongside each chunk and combined afterwards, so that
+    // container formats don't have to make another (single-threaded) pass over the input.
+    enum class Checksum {
+        None,
+        CRC32,
+        Adler32,
+    };
+
+    // A thread count of 0 uses one thread per available core.
+    static ErrorOr<NonnullOwnPtr<ParallelDeflateCompressor>> construct(MaybeOwned<Stream>, size_t thread_count = 0, DeflateCompressor::CompressionLevel = DeflateCompressor::CompressionLevel::GOOD, Checksum = Checksum::None);
+    ~ParallelDeflateCompressor();
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+    ErrorOr<void> final_flush();
+
+    u32 checksum() const { return m_checksum; }
+    u64 total_input_size() const { return m_total_input_size; }
+
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, size_t thread_count = 0, DeflateCompressor::CompressionLevel = DeflateCompressor::CompressionLevel::GOOD);
+
+private:
+    using ThreadPool = Threading::ThreadPool<size_t, Threading::ThreadPoolLooper>;
+
+    struct Chunk {
+        ReadonlyBytes dictionary;
+        ReadonlyBytes input;
+        bool is_last { false };
+        ByteBuffer output;
+        Optional<Error> error;
+        u32 checksum { 0 };
+    };
+
+    ParallelDeflateCompressor(MaybeOwned<Stream>, size_t thread_count, DeflateCompressor::CompressionLevel, Checksum);
+
+    void compress_chunk(Chunk&) const;
+    ErrorOr<void> compress_pending_input(bool is_last_batch);
+
+    bool m_finished { false };
+    MaybeOwned<Stream> m_output_stream;
+    size_t m_thread_count { 0 };
+    DeflateCompressor::CompressionLevel m_compression_level;
+    Checksum m_checksum_type;
+    u32 m_checksum { 0 };
+    u64 m_total_input_size { 0 };
+
+    // The tail of the previous batch (used as the dictionary for its first chunk), followed by the pending input.
+    ByteBuffer m_input;
+    size_t m_dictionary_size { 0 };
+
+    Vector<Chunk> m_chunks;
+    OwnPtr<ThreadPool> m_thread_pool;
 };
 
 }
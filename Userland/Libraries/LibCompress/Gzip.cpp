@@ -8,6 +8,7 @@
 #include <LibCompress/Gzip.h>
 
 #include <AK/BitStream.h>
+#include <AK/CountingStream.h>
 #include <AK/MemoryStream.h>
 #include <AK/String.h>
 #include <LibCore/DateTime.h>
@@ -61,6 +62,75 @@ GzipDecompressor::~GzipDecompressor()
     m_current_member.clear();
 }
 
+ErrorOr<NonnullOwnPtr<GzipDecompressor>> GzipDecompressor::create_at_checkpoint(MaybeOwned<Stream> stream, GzipIndex::Checkpoint const& checkpoint)
+{
+    auto decompressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) GzipDecompressor(move(stream))));
+    TRY(decompressor->m_input_stream->read_bits(checkpoint.compressed_bit_offset % 8));
+
+    auto window = TRY(DeflateDecompressor::decompress_all(checkpoint.compressed_window));
+    auto member = TRY(Member::construct({}, *decompressor->m_input_stream));
+    TRY(member->m_stream->set_dictionary(window));
+    member->m_checksum = Crypto::Checksum::CRC32 { ~checkpoint.member_checksum, {} };
+    member->m_nread = checkpoint.member_uncompressed_offset;
+
+    decompressor->m_current_member = move(member);
+    return decompressor;
+}
+
+ErrorOr<void> GzipDecompressor::read_remaining_header(BlockHeader const& header, LittleEndianInputBitStream& stream)
+{
+    if (!header.valid_magic_number())
+        return Error::from_string_literal("Header does not have a valid magic number");
+
+    if (!header.supported_by_implementation())
+        return Error::from_string_literal("Header is not supported by implementation");
+
+    if (header.flags & Flags::FEXTRA) {
+        u16 subfield_id = TRY(stream.read_value<LittleEndian<u16>>());
+        u16 length = TRY(stream.read_value<LittleEndian<u16>>());
+        TRY(stream.discard(length));
+        (void)subfield_id;
+    }
+
+    auto discard_string = [&]() -> ErrorOr<void> {
+        char next_char;
+        do {
+            next_char = TRY(stream.read_value<char>());
+        } while (next_char);
+
+        return {};
+    };
+
+    if (header.flags & Flags::FNAME)
+        TRY(discard_string());
+
+    if (header.flags & Flags::FCOMMENT)
+        TRY(discard_string());
+
+    if (header.flags & Flags::FHCRC) {
+        u16 crc = TRY(stream.read_value<LittleEndian<u16>>());
+        // FIXME: we should probably verify this instead of just assuming it matches
+        (void)crc;
+    }
+
+    return {};
+}
+
+ErrorOr<void> GzipDecompressor::read_and_verify_trailer(LittleEndianInputBitStream& stream, u32 checksum, u64 uncompressed_size)
+{
+    u32 crc32 = TRY(stream.read_value<LittleEndian<u32>>());
+    u32 input_size = TRY(stream.read_value<LittleEndian<u32>>());
+
+    if (crc32 != checksum)
+        return Error::from_string_literal("Stored CRC32 does not match the calculated CRC32 of the current member");
+
+    // RFC 1952 only stores the size of the original input modulo 2^32.
+    if (input_size != static_cast<u32>(uncompressed_size))
+        return Error::from_string_literal("Input size does not match the number of read bytes");
+
+    return {};
+}
+
 ErrorOr<Bytes> GzipDecompressor::read_some(Bytes bytes)
 {
     size_t total_read = 0;
@@ -76,14 +146,7 @@ ErrorOr<Bytes> GzipDecompressor::read_some(Bytes bytes)
             current_member().m_nread += current_slice.size();
 
             if (current_slice.size() < slice.size()) {
-                u32 crc32 = TRY(m_input_stream->read_value<LittleEndian<u32>>());
-                u32 input_size = TRY(m_input_stream->read_value<LittleEndian<u32>>());
-
-                if (crc32 != current_member().m_checksum.digest())
-                    return Error::from_string_literal("Stored CRC32 does not match the calculated CRC32 of the current member");
-
-                if (input_size != current_member().m_nread)
-                    return Error::from_string_literal("Input size does not match the number of read bytes");
+                TRY(read_and_verify_trailer(*m_input_stream, current_member().m_checksum.digest(), current_member().m_nread));
 
                 m_current_member.clear();
 
@@ -107,40 +170,7 @@ ErrorOr<Bytes> GzipDecompressor::read_some(Bytes bytes)
             m_partial_header_offset = 0;
 
             BlockHeader header = *(reinterpret_cast<BlockHeader*>(m_partial_header));
-
-            if (!header.valid_magic_number())
-                return Error::from_string_literal("Header does not have a valid magic number");
-
-            if (!header.supported_by_implementation())
-                return Error::from_string_literal("Header is not supported by implementation");
-
-            if (header.flags & Flags::FEXTRA) {
-                u16 subfield_id = TRY(m_input_stream->read_value<LittleEndian<u16>>());
-                u16 length = TRY(m_input_stream->read_value<LittleEndian<u16>>());
-                TRY(m_input_stream->discard(length));
-                (void)subfield_id;
-            }
-
-            auto discard_string = [&]() -> ErrorOr<void> {
-                char next_char;
-                do {
-                    next_char = TRY(m_input_stream->read_value<char>());
-                } while (next_char);
-
-                return {};
-            };
-
-            if (header.flags & Flags::FNAME)
-                TRY(discard_string());
-
-            if (header.flags & Flags::FCOMMENT)
-                TRY(discard_string());
-
-            if (header.flags & Flags::FHCRC) {
-                u16 crc = TRY(m_input_stream->read_value<LittleEndian<u16>>());
-                // FIXME: we should probably verify this instead of just assuming it matches
-                (void)crc;
-            }
+            TRY(read_remaining_header(header, *m_input_stream));
 
             m_current_member = TRY(Member::construct(header, *m_input_stream));
             continue;
@@ -184,8 +214,229 @@ ErrorOr<size_t> GzipDecompressor::write_some(ReadonlyBytes)
     return Error::from_errno(EBADF);
 }
 
-GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream)
+static constexpr Array<u8, 4> gzip_index_magic { 'G', 'Z', 'I', 'X' };
+static constexpr u32 gzip_index_version = 1;
+
+// A window of 32 KiB can't grow by more than a few bytes when compressing it, so anything larger than this is corrupt.
+static constexpr size_t gzip_index_max_compressed_window_size = 64 * KiB;
+
+ErrorOr<GzipIndex> GzipIndex::build(Stream& stream, u64 checkpoint_spacing)
+{
+    VERIFY(checkpoint_spacing > 0);
+
+    CountingStream counting_stream { MaybeOwned<Stream>(stream) };
+    LittleEndianInputBitStream bit_stream { MaybeOwned<Stream>(counting_stream) };
+
+    GzipIndex index;
+    auto buffer = TRY(ByteBuffer::create_uninitialized(64 * KiB));
+
+    while (true) {
+        BlockHeader header {};
+        Bytes header_bytes { &header, sizeof(header) };
+
+        auto first_header_bytes = TRY(bit_stream.read_some(header_bytes));
+        if (first_header_bytes.is_empty() && bit_stream.is_eof())
+            break;
+
+        TRY(bit_stream.read_until_filled(header_bytes.slice(first_header_bytes.size())));
+        TRY(GzipDecompressor::read_remaining_header(header, bit_stream));
+
+        auto deflate_stream = TRY(DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream>(bit_stream)));
+        deflate_stream->set_stop_at_block_boundaries(true);
+
+        Crypto::Checksum::CRC32 checksum;
+        u64 member_uncompressed_offset = 0;
+
+        while (!deflate_stream->is_eof()) {
+            auto const next_checkpoint_offset = (index.m_checkpoints.is_empty() ? 0 : index.m_checkpoints.last().uncompressed_offset) + checkpoint_spacing;
+
+            if (deflate_stream->is_at_block_boundary() && index.m_uncompressed_size >= next_checkpoint_offset) {
+                auto window = TRY(deflate_stream->copy_window());
+                auto compressed_window = TRY(DeflateCompressor::compress_all(window, DeflateCompressor::CompressionLevel::FAST));
+
+                TRY(index.m_checkpoints.try_append({
+                    .uncompressed_offset = index.m_uncompressed_size,
+                    .compressed_bit_offset = counting_stream.read_bytes() * 8 - bit_stream.buffered_bit_count(),
+                    .member_uncompressed_offset = member_uncompressed_offset,
+                    .member_checksum = checksum.digest(),
+                    .compressed_window = move(compressed_window),
+                }));
+            }
+
+            auto data = TRY(deflate_stream->read_some(buffer));
+            checksum.update(data);
+            member_uncompressed_offset += data.size();
+            index.m_uncompressed_size += data.size();
+        }
+
+        TRY(GzipDecompressor::read_and_verify_trailer(bit_stream, checksum.digest(), member_uncompressed_offset));
+    }
+
+    index.m_compressed_size = counting_stream.read_bytes();
+    return index;
+}
+
+ErrorOr<GzipIndex> GzipIndex::read_from_stream(Stream& stream)
+{
+    Array<u8, gzip_index_magic.size()> magic;
+    TRY(stream.read_until_filled(magic));
+    if (magic != gzip_index_magic)
+        return Error::from_string_literal("Not a gzip index");
+
+    if (TRY(stream.read_value<LittleEndian<u32>>()) != gzip_index_version)
+        return Error::from_string_literal("Unsupported gzip index version");
+
+    GzipIndex index;
+    index.m_compressed_size = TRY(stream.read_value<LittleEndian<u64>>());
+    index.m_uncompressed_size = TRY(stream.read_value<LittleEndian<u64>>());
+
+    u64 const checkpoint_count = TRY(stream.read_value<LittleEndian<u64>>());
+    for (u64 i = 0; i < checkpoint_count; i++) {
+        Checkpoint checkpoint;
+        checkpoint.uncompressed_offset = TRY(stream.read_value<LittleEndian<u64>>());
+        checkpoint.compressed_bit_offset = TRY(stream.read_value<LittleEndian<u64>>());
+        checkpoint.member_uncompressed_offset = TRY(stream.read_value<LittleEndian<u64>>());
+        checkpoint.member_checksum = TRY(stream.read_value<LittleEndian<u32>>());
+
+        u32 const compressed_window_size = TRY(stream.read_value<LittleEndian<u32>>());
+        if (compressed_window_size > gzip_index_max_compressed_window_size)
+            return Error::from_string_literal("Gzip index contains a checkpoint with an oversized window");
+
+        checkpoint.compressed_window = TRY(ByteBuffer::create_uninitialized(compressed_window_size));
+        TRY(stream.read_until_filled(checkpoint.compressed_window));
+
+        if (!index.m_checkpoints.is_empty() && checkpoint.uncompressed_offset <= index.m_checkpoints.last().uncompressed_offset)
+            return Error::from_string_literal("Gzip index contains checkpoints that are out of order");
+
+        if (checkpoint.uncompressed_offset > index.m_uncompressed_size || checkpoint.member_uncompressed_offset > checkpoint.uncompressed_offset)
+            return Error::from_string_literal("Gzip index contains a checkpoint past the end of the uncompressed data");
+
+        if (checkpoint.compressed_bit_offset / 8 >= index.m_compressed_size)
+            return Error::from_string_literal("Gzip index contains a checkpoint past the end of the compressed data");
+
+        TRY(index.m_checkpoints.try_append(move(checkpoint)));
+    }
+
+    return index;
+}
+
+ErrorOr<void> GzipIndex::write_to_stream(Stream& stream) const
+{
+    TRY(stream.write_until_depleted(gzip_index_magic));
+    TRY(stream.write_value<LittleEndian<u32>>(gzip_index_version));
+    TRY(stream.write_value<LittleEndian<u64>>(m_compressed_size));
+    TRY(stream.write_value<LittleEndian<u64>>(m_uncompressed_size));
+
+    TRY(stream.write_value<LittleEndian<u64>>(m_checkpoints.size()));
+    for (auto const& checkpoint : m_checkpoints) {
+        TRY(stream.write_value<LittleEndian<u64>>(checkpoint.uncompressed_offset));
+        TRY(stream.write_value<LittleEndian<u64>>(checkpoint.compressed_bit_offset));
+        TRY(stream.write_value<LittleEndian<u64>>(checkpoint.member_uncompressed_offset));
+        TRY(stream.write_value<LittleEndian<u32>>(checkpoint.member_checksum));
+        TRY(stream.write_value<LittleEndian<u32>>(checkpoint.compressed_window.size()));
+        TRY(stream.write_until_depleted(checkpoint.compressed_window));
+    }
+
+    return {};
+}
+
+GzipIndex::Checkpoint const* GzipIndex::checkpoint_for_offset(u64 uncompressed_offset) const
+{
+    // This finds the first checkpoint past the given offset, the one before it is the one we are looking for.
+    size_t low = 0;
+    size_t high = m_checkpoints.size();
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        if (m_checkpoints[middle].uncompressed_offset <= uncompressed_offset)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    if (low == 0)
+        return nullptr;
+    return &m_checkpoints[low - 1];
+}
+
+ErrorOr<NonnullOwnPtr<SeekableGzipDecompressor>> SeekableGzipDecompressor::create(MaybeOwned<SeekableStream> stream, GzipIndex index)
+{
+    if (TRY(stream->size()) != index.compressed_size())
+        return Error::from_string_literal("Gzip index does not match the size of the compressed data");
+
+    TRY(stream->seek(0, SeekMode::SetPosition));
+    auto decompressor = TRY(try_make<GzipDecompressor>(MaybeOwned<Stream>(*stream)));
+    return adopt_nonnull_own_or_enomem(new (nothrow) SeekableGzipDecompressor(move(stream), move(index), move(decompressor)));
+}
+
+SeekableGzipDecompressor::SeekableGzipDecompressor(MaybeOwned<SeekableStream> stream, GzipIndex index, NonnullOwnPtr<GzipDecompressor> decompressor)
+    : m_input_stream(move(stream))
+    , m_index(move(index))
+    , m_decompressor(move(decompressor))
+{
+}
+
+ErrorOr<Bytes> SeekableGzipDecompressor::read_some(Bytes bytes)
+{
+    auto result = TRY(m_decompressor->read_some(bytes));
+    m_offset += result.size();
+    return result;
+}
+
+ErrorOr<size_t> SeekableGzipDecompressor::write_some(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool SeekableGzipDecompressor::is_eof() const
+{
+    return m_decompressor->is_eof();
+}
+
+ErrorOr<size_t> SeekableGzipDecompressor::seek(i64 offset, SeekMode mode)
+{
+    i64 target = offset;
+    switch (mode) {
+    case SeekMode::SetPosition:
+        break;
+    case SeekMode::FromCurrentPosition:
+        target += m_offset;
+        break;
+    case SeekMode::FromEndPosition:
+        target += m_index.uncompressed_size();
+        break;
+    }
+
+    if (target < 0 || static_cast<u64>(target) > m_index.uncompressed_size())
+        return Error::from_errno(EINVAL);
+
+    auto const* checkpoint = m_index.checkpoint_for_offset(target);
+    u64 const checkpoint_offset = checkpoint ? checkpoint->uncompressed_offset : 0;
+
+    // Decompressing forward from where we are is cheaper than starting over, unless there is a closer checkpoint.
+    if (static_cast<u64>(target) < m_offset || checkpoint_offset > m_offset) {
+        if (checkpoint) {
+            TRY(m_input_stream->seek(checkpoint->compressed_bit_offset / 8, SeekMode::SetPosition));
+            m_decompressor = TRY(GzipDecompressor::create_at_checkpoint(MaybeOwned<Stream>(*m_input_stream), *checkpoint));
+        } else {
+            TRY(m_input_stream->seek(0, SeekMode::SetPosition));
+            m_decompressor = TRY(try_make<GzipDecompressor>(MaybeOwned<Stream>(*m_input_stream)));
+        }
+        m_offset = checkpoint_offset;
+    }
+
+    TRY(m_decompressor->discard(target - m_offset));
+    m_offset = target;
+    return m_offset;
+}
+
+ErrorOr<void> SeekableGzipDecompressor::truncate(size_t)
+{
+    return Error::from_errno(EBADF);
+}
+
+GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream, DeflateCompressor::CompressionLevel compression_level)
     : m_output_stream(move(stream))
+    , m_compression_level(compression_level)
 {
 }
 
@@ -194,7 +445,7 @@ ErrorOr<Bytes> GzipCompressor::read_some(Bytes)
     return Error::from_errno(EBADF);
 }
 
-ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
+static ErrorOr<void> write_member_header(Stream& stream, DeflateCompressor::CompressionLevel compression_level)
 {
     BlockHeader header;
     header.identification_1 = 0x1f;
@@ -202,10 +453,23 @@ ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
     header.compression_method = 0x08;
     header.flags = 0;
     header.modification_time = 0;
-    header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
+    header.extra_flags = 0;
     header.operating_system = 3; // unix
-    TRY(m_output_stream->write_until_depleted({ &header, sizeof(header) }));
-    auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
+
+    // DEFLATE sets 2 for maximum compression and 4 for minimum compression
+    if (compression_level == DeflateCompressor::CompressionLevel::BEST)
+        header.extra_flags = 2;
+    else if (compression_level == DeflateCompressor::CompressionLevel::FAST)
+        header.extra_flags = 4;
+
+    TRY(stream.write_until_depleted({ &header, sizeof(header) }));
+    return {};
+}
+
+ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
+{
+    TRY(write_member_header(*m_output_stream, m_compression_level));
+    auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream), m_compression_level));
     TRY(compressed_stream->write_until_depleted(bytes));
     TRY(compressed_stream->final_flush());
     Crypto::Checksum::CRC32 crc32;
@@ -229,14 +493,79 @@ void GzipCompressor::close()
 {
 }
 
-ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
+ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes, DeflateCompressor::CompressionLevel compression_level)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
-    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream) };
+    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream), compression_level };
 
     TRY(gzip_stream.write_until_depleted(bytes));
 
     return output_stream->read_until_eof();
 }
 
+ErrorOr<NonnullOwnPtr<ParallelGzipCompressor>> ParallelGzipCompressor::construct(MaybeOwned<Stream> stream, size_t thread_count, DeflateCompressor::CompressionLevel compression_level)
+{
+    TRY(write_member_header(*stream, compression_level));
+    auto compressor_stream = TRY(ParallelDeflateCompressor::construct(MaybeOwned(*stream), thread_count, compression_level, ParallelDeflateCompressor::Checksum::CRC32));
+    return adopt_nonnull_own_or_enomem(new (nothrow) ParallelGzipCompressor(move(stream), move(compressor_stream)));
+}
+
+ParallelGzipCompressor::ParallelGzipCompressor(MaybeOwned<Stream> stream, NonnullOwnPtr<ParallelDeflateCompressor> compressor_stream)
+    : m_output_stream(move(stream))
+    , m_compressor(move(compressor_stream))
+{
+}
+
+ParallelGzipCompressor::~ParallelGzipCompressor()
+{
+    VERIFY(m_finished);
+}
+
+ErrorOr<Bytes> ParallelGzipCompressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> ParallelGzipCompressor::write_some(ReadonlyBytes bytes)
+{
+    VERIFY(!m_finished);
+    return m_compressor->write_some(bytes);
+}
+
+bool ParallelGzipCompressor::is_eof() const
+{
+    return true;
+}
+
+bool ParallelGzipCompressor::is_open() const
+{
+    return m_output_stream->is_open();
+}
+
+void ParallelGzipCompressor::close()
+{
+}
+
+ErrorOr<void> ParallelGzipCompressor::finish()
+{
+    VERIFY(!m_finished);
+    m_finished = true;
+
+    TRY(m_compressor->final_flush());
+    TRY(m_output_stream->write_value<LittleEndian<u32>>(m_compressor->checksum()));
+    TRY(m_output_stream->write_value<LittleEndian<u32>>(static_cast<u32>(m_compressor->total_input_size())));
+    return {};
+}
+
+ErrorOr<ByteBuffer> ParallelGzipCompressor::compress_all(ReadonlyBytes bytes, size_t thread_count, DeflateCompressor::CompressionLevel compression_level)
+{
+    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+    auto gzip_stream = TRY(ParallelGzipCompressor::construct(MaybeOwned<Stream>(*output_stream), thread_count, compression_level));
+
+    TRY(gzip_stream->write_until_depleted(bytes));
+    TRY(gzip_stream->finish());
+
+    return output_stream->read_until_eof();
+}
+
 }
@@ -7,9 +7,11 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
 #include <AK/Stream.h>
+#include <AK/Vector.h>
 #include <LibCompress/Deflate.h>
 #include <LibCrypto/Checksum/CRC32.h>
 
@@ -40,6 +42,44 @@ struct Flags {
     static constexpr u8 MAX = FTEXT | FHCRC | FEXTRA | FNAME | FCOMMENT;
 };
 
+// A zran-style index of checkpoints into a gzip file, which allows resuming decompression close to an arbitrary
+// uncompressed offset instead of decompressing everything that precedes it. Building the index takes one pass over
+// the file, after which it can be written out and kept beside it.
+class GzipIndex {
+public:
+    static constexpr u64 default_checkpoint_spacing = 1 * MiB;
+
+    // Checkpoints are taken at deflate block boundaries, and carry the output preceding them that the next blocks may
+    // refer back to. That window is stored deflate-compressed, since it would make up almost all of the index otherwise.
+    struct Checkpoint {
+        u64 uncompressed_offset { 0 };
+        u64 compressed_bit_offset { 0 };
+
+        // This allows verifying the trailer of the member that the checkpoint is in.
+        u64 member_uncompressed_offset { 0 };
+        u32 member_checksum { 0 };
+
+        ByteBuffer compressed_window;
+    };
+
+    static ErrorOr<GzipIndex> build(Stream&, u64 checkpoint_spacing = default_checkpoint_spacing);
+
+    static ErrorOr<GzipIndex> read_from_stream(Stream&);
+    ErrorOr<void> write_to_stream(Stream&) const;
+
+    u64 compressed_size() const { return m_compressed_size; }
+    u64 uncompressed_size() const { return m_uncompressed_size; }
+    Vector<Checkpoint> const& checkpoints() const { return m_checkpoints; }
+
+    // Returns the last checkpoint at or before the given offset, if there is any.
+    Checkpoint const* checkpoint_for_offset(u64 uncompressed_offset) const;
+
+private:
+    u64 m_compressed_size { 0 };
+    u64 m_uncompressed_size { 0 };
+    Vector<Checkpoint> m_checkpoints;
+};
+
 class GzipDecompressor final : public Stream {
 public:
     GzipDecompressor(MaybeOwned<Stream>);
@@ -57,6 +97,15 @@ public:
     static bool is_likely_compressed(ReadonlyBytes bytes);
 
 private:
+    friend class GzipIndex;
+    friend class SeekableGzipDecompressor;
+
+    // The input has to be positioned at the byte that contains the checkpoint's bit offset.
+    static ErrorOr<NonnullOwnPtr<GzipDecompressor>> create_at_checkpoint(MaybeOwned<Stream>, GzipIndex::Checkpoint const&);
+
+    static ErrorOr<void> read_remaining_header(BlockHeader const&, LittleEndianInputBitStream&);
+    static ErrorOr<void> read_and_verify_trailer(LittleEndianInputBitStream&, u32 checksum, u64 uncompressed_size);
+
     class Member {
     public:
         static ErrorOr<NonnullOwnPtr<Member>> construct(BlockHeader header, LittleEndianInputBitStream&);
@@ -81,9 +130,35 @@ private:
     bool m_eof { false };
 };
 
+// Provides random access to the uncompressed contents of a gzip file through the checkpoints in a GzipIndex.
+// Seeking backwards or past the next checkpoint resumes decompression at the closest checkpoint.
+class SeekableGzipDecompressor final : public SeekableStream {
+public:
+    static ErrorOr<NonnullOwnPtr<SeekableGzipDecompressor>> create(MaybeOwned<SeekableStream>, GzipIndex);
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+    virtual ErrorOr<size_t> seek(i64 offset, SeekMode) override;
+    virtual ErrorOr<size_t> tell() const override { return m_offset; }
+    virtual ErrorOr<size_t> size() override { return m_index.uncompressed_size(); }
+    virtual ErrorOr<void> truncate(size_t) override;
+
+private:
+    SeekableGzipDecompressor(MaybeOwned<SeekableStream>, GzipIndex, NonnullOwnPtr<GzipDecompressor>);
+
+    MaybeOwned<SeekableStream> m_input_stream;
+    GzipIndex m_index;
+    NonnullOwnPtr<GzipDecompressor> m_decompressor;
+    u64 m_offset { 0 };
+};
+
 class GzipCompressor final : public Stream {
 public:
-    GzipCompressor(MaybeOwned<Stream>);
+    GzipCompressor(MaybeOwned<Stream>, DeflateCompressor::CompressionLevel = DeflateCompressor::CompressionLevel::GOOD);
 
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
@@ -91,10 +166,36 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
-    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes);
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, DeflateCompressor::CompressionLevel = DeflateCompressor::CompressionLevel::GOOD);
 
 private:
     MaybeOwned<Stream> m_output_stream;
+    DeflateCompressor::CompressionLevel m_compression_level;
+};
+
+// Unlike GzipCompressor, which writes a separate member for every write, this writes a single member for everything
+// until finish() is called, and compresses it on multiple threads.
+class ParallelGzipCompressor final : public Stream {
+public:
+    // A thread count of 0 uses one thread per available core.
+    static ErrorOr<NonnullOwnPtr<ParallelGzipCompressor>> construct(MaybeOwned<Stream>, size_t thread_count = 0, DeflateCompressor::CompressionLevel = DeflateCompressor::CompressionLevel::GOOD);
+    ~ParallelGzipCompressor();
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+    ErrorOr<void> finish();
+
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, size_t thread_count = 0, DeflateCompressor::CompressionLevel = DeflateCompressor::CompressionLevel::GOOD);
+
+private:
+    ParallelGzipCompressor(MaybeOwned<Stream>, NonnullOwnPtr<ParallelDeflateCompressor>);
+
+    bool m_finished { false };
+    MaybeOwned<Stream> m_output_stream;
+    NonnullOwnPtr<ParallelDeflateCompressor> m_compressor;
 };
 
 }
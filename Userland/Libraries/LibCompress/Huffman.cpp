@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCompress/DeflateTables.h>
+#include <LibCompress/Huffman.h>
+
+namespace Compress {
+
+ErrorOr<HuffmanDecodingTable> HuffmanDecodingTable::from_code_lengths(ReadonlyBytes code_lengths, LiteralPairs literal_pairs)
+{
+    HuffmanDecodingTable table;
+
+    Array<u16, max_code_length + 1> length_counts {};
+    for (auto length : code_lengths) {
+        if (length > max_code_length)
+            return Error::from_string_literal("Huffman code length is too long");
+        length_counts[length]++;
+    }
+    length_counts[0] = 0;
+
+    u32 used_code_space = 0;
+    for (size_t length = 1; length <= max_code_length; ++length) {
+        used_code_space += length_counts[length] << (max_code_length - length);
+        if (length_counts[length] != 0)
+            table.m_max_length = length;
+    }
+    if (used_code_space > (1u << max_code_length))
+        return Error::from_string_literal("Huffman code is over-subscribed");
+
+    // Sort the symbols by code length (and by value within the same length), which is the order canonical codes are assigned in.
+    Array<u16, max_code_length + 2> offsets {};
+    for (size_t length = 1; length <= max_code_length; ++length)
+        offsets[length + 1] = offsets[length] + length_counts[length];
+
+    Vector<u16, 288> sorted_symbols;
+    TRY(sorted_symbols.try_resize(offsets[max_code_length + 1]));
+    for (size_t symbol = 0; symbol < code_lengths.size(); ++symbol) {
+        if (code_lengths[symbol] != 0)
+            sorted_symbols[offsets[code_lengths[symbol]]++] = symbol;
+    }
+
+    table.m_table_bits = min(root_bits, table.m_max_length);
+    auto root_size = 1u << table.m_table_bits;
+    TRY(table.m_table.try_resize(root_size));
+
+    auto remaining_counts = length_counts;
+    u32 code = 0;
+    size_t symbol_index = 0;
+
+    Optional<u32> current_root_index;
+    u32 current_sub_table_offset = 0;
+
+    for (size_t length = 1; length <= table.m_max_length; ++length, code <<= 1) {
+        for (size_t i = 0; i < length_counts[length]; ++i, ++code) {
+            auto symbol = sorted_symbols[symbol_index++];
+            // The codes are read LSB-first, so the table is indexed by their bit-reversed value.
+            u32 reversed_code = fast_reverse16(code, length);
+
+            if (length <= table.m_table_bits) {
+                for (auto index = reversed_code; index < root_size; index += 1u << length)
+                    table.m_table[index] = Entry { .symbol = symbol, .length = static_cast<u8>(length), .kind = Entry::Kind::Symbol };
+                remaining_counts[length]--;
+                continue;
+            }
+
+            auto root_index = reversed_code & (root_size - 1);
+            if (root_index != current_root_index) {
+                // Codes sharing the same root prefix are consecutive, so the sub-table only has to be large enough for the
+                // codes that are still left (this is the same approach as zlib's inflate_table()).
+                size_t sub_table_bits = length - table.m_table_bits;
+                i32 available_entries = 1 << sub_table_bits;
+                while (sub_table_bits + table.m_table_bits < table.m_max_length) {
+                    available_entries -= remaining_counts[sub_table_bits + table.m_table_bits];
+                    if (available_entries <= 0)
+                        break;
+                    sub_table_bits++;
+                    available_entries <<= 1;
+                }
+
+                current_root_index = root_index;
+                current_sub_table_offset = table.m_table.size();
+                if (current_sub_table_offset + (1u << sub_table_bits) > NumericLimits<u16>::max())
+                    return Error::from_string_literal("Huffman code needs too many sub-tables");
+
+                TRY(table.m_table.try_resize(current_sub_table_offset + (1u << sub_table_bits)));
+                table.m_table[root_index] = Entry { .symbol = static_cast<u16>(current_sub_table_offset), .length = static_cast<u8>(sub_table_bits), .kind = Entry::Kind::SubTable };
+            }
+
+            auto sub_table_bits = table.m_table[root_index].length;
+            for (auto index = reversed_code >> table.m_table_bits; index < (1u << sub_table_bits); index += 1u << (length - table.m_table_bits))
+                table.m_table[current_sub_table_offset + index] = Entry { .symbol = symbol, .length = static_cast<u8>(length), .kind = Entry::Kind::Symbol };
+            remaining_counts[length]--;
+        }
+    }
+
+    if (literal_pairs == LiteralPairs::Yes) {
+        // A root entry's index holds the first literal's code in its low bits, followed by whatever comes next in the
+        // stream. If that is short enough to be fully contained in the index as well, both can be decoded at once.
+        Vector<Entry, 1 << root_bits> root_entries;
+        TRY(root_entries.try_extend(table.m_table.span().trim(root_size)));
+
+        for (size_t index = 0; index < root_size; ++index) {
+            auto first = root_entries[index];
+            if (first.kind != Entry::Kind::Symbol || first.symbol >= 256 || first.length >= table.m_table_bits)
+                continue;
+
+            auto second = root_entries[index >> first.length];
+            if (second.kind != Entry::Kind::Symbol || second.symbol >= 256 || first.length + second.length > table.m_table_bits)
+                continue;
+
+            table.m_table[index] = Entry {
+                .symbol = static_cast<u16>(first.symbol | (second.symbol << 8)),
+                .length = static_cast<u8>(first.length + second.length),
+                .first_length = first.length,
+                .kind = Entry::Kind::LiteralPair,
+            };
+        }
+    }
+
+    return table;
+}
+
+ErrorOr<HuffmanDecodingTable> HuffmanDecodingTable::for_single_symbol(u16 symbol, u8 code_length)
+{
+    VERIFY(code_length <= root_bits);
+
+    HuffmanDecodingTable table;
+    table.m_table_bits = code_length;
+    table.m_max_length = code_length;
+    TRY(table.m_table.try_resize(1u << code_length));
+    table.m_table.span().fill(Entry { .symbol = symbol, .length = code_length, .kind = Entry::Kind::Symbol });
+    return table;
+}
+
+}
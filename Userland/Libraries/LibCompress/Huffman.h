@@ -9,6 +9,9 @@
 
 #include <AK/Array.h>
 #include <AK/BinaryHeap.h>
+#include <AK/BitStream.h>
+#include <AK/Error.h>
+#include <AK/Vector.h>
 
 namespace Compress {
 
@@ -83,4 +86,100 @@ inline void generate_huffman_lengths(Bytes lengths, ReadonlySpan<u16> frequencie
     }
 }
 
+// Decodes canonical Huffman codes whose bits are read LSB-first from a LittleEndianInputBitStream, as used by Deflate and Brotli.
+// Codes of up to root_bits bits are decoded with a single table lookup, longer ones with a second lookup into a sub-table.
+// Optionally, two consecutive short literals are packed into a single entry, so that both can be decoded with one lookup.
+class HuffmanDecodingTable {
+public:
+    static constexpr size_t max_code_length = 15;
+    static constexpr size_t root_bits = 10;
+
+    enum class LiteralPairs {
+        No,
+        Yes, // symbols below 256 are literals that may be decoded in pairs
+    };
+
+    struct Entry {
+        enum class Kind : u8 {
+            Invalid,
+            Symbol,
+            LiteralPair,
+            SubTable,
+        };
+
+        u16 symbol { 0 };          // the symbol, both literals of a pair (the first one in the low byte), or the offset of a sub-table
+        u8 length { 0 };           // the number of bits used up by the entry, or the number of bits that index a sub-table
+        u8 first_length : 4 { 0 }; // the code length of the first literal of a pair
+        Kind kind : 4 { Kind::Invalid };
+    };
+    static_assert(sizeof(Entry) == 4);
+
+    HuffmanDecodingTable() = default;
+
+    // Builds the table from the code length of every symbol (0 for unused symbols). Incomplete codes are allowed,
+    // decoding one of their unused bit patterns fails at read time.
+    static ErrorOr<HuffmanDecodingTable> from_code_lengths(ReadonlyBytes code_lengths, LiteralPairs = LiteralPairs::No);
+
+    // A code that always decodes to `symbol`, using up `code_length` bits (which may be zero).
+    static ErrorOr<HuffmanDecodingTable> for_single_symbol(u16 symbol, u8 code_length);
+
+    // The longest code, i.e. the number of bits that have to be buffered for lookup() to be able to decode any symbol.
+    size_t max_length() const { return m_max_length; }
+
+    // Decodes the entry for the low bits of `bits`, which need to hold at least max_length() valid bits.
+    // Entries that are sub-table links are resolved, so the result is never of Kind::SubTable.
+    ALWAYS_INLINE Entry lookup(u64 bits) const
+    {
+        auto entry = m_table[bits & ((1u << m_table_bits) - 1)];
+        if (entry.kind == Entry::Kind::SubTable) [[unlikely]]
+            entry = m_table[entry.symbol + ((bits >> m_table_bits) & ((1u << entry.length) - 1))];
+        return entry;
+    }
+
+    ErrorOr<u16> read_symbol(LittleEndianInputBitStream& stream) const
+    {
+        // Bits past the buffered ones read as zero, so an entry is only right if its code fits into the buffered bits.
+        // Only read from the stream if that is not the case, so that we never wait for input that a short code does not need.
+        auto entry = lookup(stream.buffered_bits());
+        while (stream.buffered_bit_count() < m_max_length && stream.buffered_bit_count() < code_length(entry)) {
+            auto buffered_bit_count = stream.buffered_bit_count();
+            TRY(stream.fill_bit_buffer(buffered_bit_count + 1));
+            if (stream.buffered_bit_count() == buffered_bit_count)
+                break;
+            entry = lookup(stream.buffered_bits());
+        }
+
+        auto symbol = entry.symbol;
+        auto length = entry.length;
+        if (entry.kind == Entry::Kind::LiteralPair) {
+            symbol &= 0xff;
+            length = entry.first_length;
+        } else if (entry.kind == Entry::Kind::Invalid) {
+            return Error::from_string_literal("Invalid Huffman code");
+        }
+
+        if (length > stream.buffered_bit_count()) {
+            // This reads past the end of the input, unless the stream was told to pretend that there is more of it.
+            TRY(stream.peek_bits(length));
+        }
+        stream.discard_previously_peeked_bits(length);
+        return symbol;
+    }
+
+private:
+    // The number of bits that decide `entry`. For an invalid entry, that is only known once all of max_length() is there.
+    size_t code_length(Entry entry) const
+    {
+        if (entry.kind == Entry::Kind::LiteralPair)
+            return entry.first_length;
+        if (entry.kind == Entry::Kind::Invalid)
+            return m_max_length;
+        return entry.length;
+    }
+
+    Vector<Entry> m_table;
+    u8 m_table_bits { 0 };
+    u8 m_max_length { 0 };
+};
+
 }
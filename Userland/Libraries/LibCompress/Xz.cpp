@@ -8,7 +8,9 @@
 #include <AK/MemoryStream.h>
 #include <LibCompress/Lzma2.h>
 #include <LibCompress/Xz.h>
+#include <LibCore/System.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace Compress {
 
@@ -353,6 +355,18 @@ XzDecompressor::XzDecompressor(NonnullOwnPtr<CountingStream> stream)
 {
 }
 
+ErrorOr<ByteBuffer> XzDecompressor::decompress_all(ReadonlyBytes bytes, size_t thread_count)
+{
+    if (thread_count != 1) {
+        auto decompressor = TRY(ParallelXzDecompressor::create(bytes, thread_count));
+        return decompressor->read_until_eof();
+    }
+
+    auto input_stream = TRY(try_make<FixedMemoryStream>(bytes));
+    auto decompressor = TRY(XzDecompressor::create(move(input_stream)));
+    return decompressor->read_until_eof();
+}
+
 static Optional<size_t> size_for_check_type(XzStreamCheckType check_type)
 {
     switch (check_type) {
@@ -780,6 +794,7 @@ ErrorOr<Bytes> XzDecompressor::read_some(Bytes bytes)
             // Another XZ Stream might follow, so we just unset the current information and continue on the next read.
             m_stream_flags.clear();
             m_processed_blocks.clear();
+            m_current_block_stream.clear();
             return bytes.trim(0);
         }
 
@@ -812,4 +827,355 @@ void XzDecompressor::close()
 {
 }
 
+ErrorOr<void> XzDecompressor::decompress_block(ReadonlyBytes block, XzStreamFlags stream_flags, u64 unpadded_size, u64 uncompressed_size, ByteBuffer& output)
+{
+    // The uncompressed size comes from the Index, which could claim anything. To not let it make us allocate
+    // arbitrary amounts of memory, the output buffer starts out small and is only grown once it has been filled.
+    static constexpr size_t initial_output_size = 64 * KiB;
+
+    // This sets up a decompressor that is positioned right at the start of a block, as if it had just read the Stream Header.
+    auto block_stream = TRY(try_make<FixedMemoryStream>(block));
+    auto counting_stream = TRY(try_make<CountingStream>(move(block_stream)));
+    XzDecompressor decompressor { move(counting_stream) };
+    decompressor.m_stream_flags = stream_flags;
+    decompressor.m_found_first_stream_header = true;
+
+    auto const encoded_block_header_size = TRY(decompressor.m_stream->read_value<u8>());
+    if (encoded_block_header_size == 0x00)
+        return Error::from_string_literal("XZ index record points to an Index instead of a Block");
+
+    TRY(decompressor.load_next_block(encoded_block_header_size));
+
+    output.clear();
+    auto& block_data_stream = *decompressor.m_current_block_stream;
+    while (!block_data_stream->is_eof()) {
+        auto const decoded_size = decompressor.m_current_block_uncompressed_size;
+        if (decoded_size == output.size() && decoded_size < uncompressed_size)
+            TRY(output.try_resize(min<u64>(uncompressed_size, max<u64>(initial_output_size, output.size() * 2))));
+
+        // Anything beyond the uncompressed size that is stored in the Index goes into a scratch byte, which is enough to reject the block.
+        u8 excess_byte = 0;
+        auto buffer = output.bytes().slice(decoded_size);
+        if (buffer.is_empty())
+            buffer = { &excess_byte, 1 };
+
+        auto result = TRY(block_data_stream->read_some(buffer));
+        decompressor.m_current_block_uncompressed_size += result.size();
+
+        if (decompressor.m_current_block_uncompressed_size > uncompressed_size)
+            return Error::from_string_literal("Uncompressed size of XZ Block does not match the Index");
+    }
+
+    TRY(decompressor.finish_current_block());
+
+    // 4.3. List of Records:
+    // "If the decoder has decoded all the Blocks of the Stream, it
+    //  MUST verify that the contents of the Records match the real
+    //  Unpadded Size and Uncompressed Size of the respective Blocks."
+    auto const& metadata = decompressor.m_processed_blocks.last();
+    if (metadata.uncompressed_size != uncompressed_size)
+        return Error::from_string_literal("Uncompressed size of XZ Block does not match the Index");
+
+    if (metadata.unpadded_size != unpadded_size)
+        return Error::from_string_literal("Unpadded size of XZ Block does not match the Index");
+
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<ParallelXzDecompressor>> ParallelXzDecompressor::create(ReadonlyBytes bytes, size_t thread_count)
+{
+    if (thread_count == 0)
+        thread_count = Core::System::hardware_concurrency();
+
+    auto blocks = TRY(read_indices(bytes));
+
+    auto decompressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ParallelXzDecompressor(thread_count, move(blocks))));
+    decompressor->m_thread_pool = TRY(try_make<ThreadPool>(
+        [decompressor = decompressor.ptr()](size_t block_index) {
+            decompressor->decompress_block(decompressor->m_blocks[block_index]);
+        },
+        thread_count));
+    return decompressor;
+}
+
+ParallelXzDecompressor::ParallelXzDecompressor(size_t thread_count, Vector<Block> blocks)
+    : m_thread_count(thread_count)
+    , m_blocks(move(blocks))
+{
+}
+
+ParallelXzDecompressor::~ParallelXzDecompressor() = default;
+
+ErrorOr<Vector<ParallelXzDecompressor::Block>> ParallelXzDecompressor::read_indices(ReadonlyBytes bytes)
+{
+    // Stream Header, Blocks, Index and Stream Footer as well as Stream Padding are all multiples of four bytes in size.
+    if (bytes.is_empty() || bytes.size() % 4 != 0)
+        return Error::from_string_literal("XZ file size is not a non-zero multiple of four bytes");
+
+    Vector<Block> blocks;
+    size_t stream_end = bytes.size();
+
+    // Streams are walked from back to front, since the Stream Footer is the only thing that tells us where the Index is.
+    while (stream_end > 0) {
+        // 2.2. Stream Padding:
+        // "Stream Padding MUST contain only null bytes. To preserve the
+        //  four-byte alignment of consecutive Streams, the size of Stream
+        //  Padding MUST be a multiple of four bytes."
+        // The Footer Magic Bytes are not null, so trailing null words can't be part of a Stream Footer.
+        auto ends_in_null_word = [&] {
+            return bytes[stream_end - 4] == 0 && bytes[stream_end - 3] == 0 && bytes[stream_end - 2] == 0 && bytes[stream_end - 1] == 0;
+        };
+        while (stream_end >= 4 && ends_in_null_word())
+            stream_end -= 4;
+
+        if (stream_end < sizeof(XzStreamHeader) + sizeof(XzStreamFooter))
+            return Error::from_string_literal("XZ file contains data that is too small to be a Stream");
+
+        XzStreamFooter stream_footer {};
+        bytes.slice(stream_end - sizeof(XzStreamFooter), sizeof(XzStreamFooter)).copy_to({ &stream_footer, sizeof(stream_footer) });
+        TRY(stream_footer.validate());
+
+        // 2.1.2.2. Backward Size:
+        // "This field indicates the size of the Index field as multiple
+        //  of four bytes, minimum value being four bytes."
+        size_t const index_end = stream_end - sizeof(XzStreamFooter);
+        size_t const index_size = stream_footer.backward_size();
+        if (index_size > index_end - sizeof(XzStreamHeader) || index_size < 8)
+            return Error::from_string_literal("XZ stream footer contains an invalid backward size");
+
+        size_t const index_start = index_end - index_size;
+        auto const index = bytes.slice(index_start, index_size);
+
+        // 4.5. CRC32:
+        // "The CRC32 is calculated over everything in the Index field
+        //  except the CRC32 field itself."
+        constexpr size_t size_of_crc32 = 4;
+        auto const index_without_crc32 = index.trim(index_size - size_of_crc32);
+        u32 const stored_index_crc32 = *reinterpret_cast<LittleEndian<u32> const*>(index.offset(index_size - size_of_crc32));
+        if (Crypto::Checksum::CRC32 { index_without_crc32 }.digest() != stored_index_crc32)
+            return Error::from_string_literal("Stored XZ index CRC32 does not match the calculated CRC32");
+
+        FixedMemoryStream index_stream { index_without_crc32 };
+
+        // 4.1. Index Indicator:
+        // "The first byte of the Index is always 0x00."
+        if (TRY(index_stream.read_value<u8>()) != 0x00)
+            return Error::from_string_literal("XZ stream footer does not point to an Index");
+
+        // 4.2. Number of Records
+        u64 const number_of_records = TRY(index_stream.read_value<XzMultibyteInteger>());
+
+        Vector<Block> stream_blocks;
+        u64 size_of_blocks = 0;
+
+        // 4.3. List of Records
+        for (u64 i = 0; i < number_of_records; i++) {
+            // 4.3.1. Unpadded Size
+            u64 const unpadded_size = TRY(index_stream.read_value<XzMultibyteInteger>());
+            if (unpadded_size < 5)
+                return Error::from_string_literal("XZ index contains a record with an unpadded size of less than five");
+
+            // 4.3.2. Uncompressed Size
+            u64 const uncompressed_size = TRY(index_stream.read_value<XzMultibyteInteger>());
+
+            // 3.3. Block Padding:
+            // "Block Padding MUST contain 0-3 null bytes to make the size of
+            //  the Block a multiple of four bytes."
+            if (unpadded_size > index_start)
+                return Error::from_string_literal("XZ index contains a block that is larger than the file");
+            size_of_blocks += align_up_to(unpadded_size, 4);
+            if (size_of_blocks > index_start - sizeof(XzStreamHeader))
+                return Error::from_string_literal("XZ index contains blocks that are larger than the file");
+
+            TRY(stream_blocks.try_append({
+                .data = {},
+                .stream_flags = {},
+                .unpadded_size = unpadded_size,
+                .uncompressed_offset = 0,
+                .uncompressed_size = uncompressed_size,
+                .output = {},
+                .error = {},
+            }));
+        }
+
+        // 4.4. Index Padding:
+        // "This field MUST contain 0-3 null bytes to pad the Index to
+        //  a multiple of four bytes. If any of the bytes are not null
+        //  bytes, the decoder MUST indicate an error."
+        auto const index_padding = index_without_crc32.slice(MUST(index_stream.tell()));
+        if (index_padding.size() > 3)
+            return Error::from_string_literal("XZ index size does not match the stored size in the stream footer");
+
+        for (auto padding_byte : index_padding) {
+            if (padding_byte != 0)
+                return Error::from_string_literal("XZ index contains a non-null padding byte");
+        }
+
+        size_t const stream_start = index_start - size_of_blocks - sizeof(XzStreamHeader);
+
+        XzStreamHeader stream_header {};
+        bytes.slice(stream_start, sizeof(XzStreamHeader)).copy_to({ &stream_header, sizeof(stream_header) });
+        TRY(stream_header.validate());
+
+        // 2.1.2.3. Stream Flags:
+        // "The decoder MUST compare the Stream Flags fields in both Stream
+        //  Header and Stream Footer, and indicate an error if they are not
+        //  identical."
+        if (ReadonlyBytes { &stream_header.flags, sizeof(XzStreamFlags) } != ReadonlyBytes { &stream_footer.flags, sizeof(XzStreamFlags) })
+            return Error::from_string_literal("XZ stream header flags don't match the stream footer");
+
+        size_t block_start = stream_start + sizeof(XzStreamHeader);
+        for (auto& block : stream_blocks) {
+            auto const block_size = align_up_to(block.unpadded_size, 4);
+            block.data = bytes.slice(block_start, block_size);
+            block.stream_flags = stream_header.flags;
+            block_start += block_size;
+        }
+
+        TRY(blocks.try_prepend(move(stream_blocks)));
+        stream_end = stream_start;
+    }
+
+    u64 uncompressed_offset = 0;
+    for (auto& block : blocks) {
+        block.uncompressed_offset = uncompressed_offset;
+        uncompressed_offset += block.uncompressed_size;
+    }
+
+    return blocks;
+}
+
+void ParallelXzDecompressor::decompress_block(Block& block) const
+{
+    auto decompress = [&]() -> ErrorOr<void> {
+        return XzDecompressor::decompress_block(block.data, block.stream_flags, block.unpadded_size, block.uncompressed_size, block.output);
+    };
+
+    auto result = decompress();
+    if (result.is_error())
+        block.error = result.release_error();
+}
+
+void ParallelXzDecompressor::decompress_next_batch()
+{
+    VERIFY(m_batch_start == m_batch_end);
+
+    // Each block is held in memory in its entirety, so we only decode as many of them at once as there are threads.
+    m_batch_end = min(m_batch_start + m_thread_count, m_blocks.size());
+
+    for (size_t i = m_batch_start; i < m_batch_end; ++i)
+        m_thread_pool->submit(i);
+    m_thread_pool->wait_for_all();
+}
+
+ErrorOr<Bytes> ParallelXzDecompressor::read_some(Bytes bytes)
+{
+    while (m_batch_start < m_blocks.size()) {
+        if (m_batch_start == m_batch_end)
+            decompress_next_batch();
+
+        auto& block = m_blocks[m_batch_start];
+
+        // Errors are only reported once all the output of the preceding blocks has been read, like a sequential decoder would.
+        if (block.error.has_value())
+            return Error::copy(*block.error);
+
+        auto const remaining_output = block.output.bytes().slice(m_output_offset);
+        if (!remaining_output.is_empty()) {
+            auto const size = remaining_output.copy_trimmed_to(bytes);
+            m_output_offset += size;
+            return bytes.trim(size);
+        }
+
+        block.output.clear();
+        m_batch_start++;
+        m_output_offset = 0;
+    }
+
+    return bytes.trim(0);
+}
+
+ErrorOr<size_t> ParallelXzDecompressor::write_some(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool ParallelXzDecompressor::is_eof() const
+{
+    return m_batch_start == m_blocks.size();
+}
+
+bool ParallelXzDecompressor::is_open() const
+{
+    return true;
+}
+
+void ParallelXzDecompressor::close()
+{
+}
+
+ErrorOr<size_t> ParallelXzDecompressor::seek(i64 offset, SeekMode mode)
+{
+    i64 target = offset;
+    switch (mode) {
+    case SeekMode::SetPosition:
+        break;
+    case SeekMode::FromCurrentPosition:
+        target += TRY(tell());
+        break;
+    case SeekMode::FromEndPosition:
+        target += TRY(size());
+        break;
+    }
+
+    if (target < 0 || static_cast<u64>(target) > TRY(size()))
+        return Error::from_errno(EINVAL);
+
+    // This finds the first block that ends past the target, which is where reading continues.
+    size_t block_index = 0;
+    size_t high = m_blocks.size();
+    while (block_index < high) {
+        auto middle = block_index + (high - block_index) / 2;
+        if (m_blocks[middle].uncompressed_offset + m_blocks[middle].uncompressed_size <= static_cast<u64>(target))
+            block_index = middle + 1;
+        else
+            high = middle;
+    }
+
+    // Blocks of the current batch are kept if we are still inside it, everything else is decoded again as needed.
+    auto const keep_current_batch = block_index >= m_batch_start && block_index < m_batch_end;
+    for (size_t i = m_batch_start; i < (keep_current_batch ? block_index : m_batch_end); ++i) {
+        m_blocks[i].output.clear();
+        m_blocks[i].error.clear();
+    }
+
+    m_batch_start = block_index;
+    if (!keep_current_batch)
+        m_batch_end = block_index;
+    m_output_offset = block_index < m_blocks.size() ? target - m_blocks[block_index].uncompressed_offset : 0;
+
+    return target;
+}
+
+ErrorOr<size_t> ParallelXzDecompressor::tell() const
+{
+    if (m_batch_start == m_blocks.size())
+        return m_blocks.is_empty() ? 0 : m_blocks.last().uncompressed_offset + m_blocks.last().uncompressed_size;
+
+    return m_blocks[m_batch_start].uncompressed_offset + m_output_offset;
+}
+
+ErrorOr<size_t> ParallelXzDecompressor::size()
+{
+    if (m_blocks.is_empty())
+        return 0;
+
+    return m_blocks.last().uncompressed_offset + m_blocks.last().uncompressed_size;
+}
+
+ErrorOr<void> ParallelXzDecompressor::truncate(size_t)
+{
+    return Error::from_errno(EBADF);
+}
+
 }
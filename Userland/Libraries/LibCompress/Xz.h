@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/CircularBuffer.h>
 #include <AK/ConstrainedStream.h>
 #include <AK/CountingStream.h>
@@ -16,6 +17,7 @@
 #include <AK/OwnPtr.h>
 #include <AK/Stream.h>
 #include <AK/Vector.h>
+#include <LibThreading/Forward.h>
 
 namespace Compress {
 
@@ -156,6 +158,9 @@ class XzDecompressor : public Stream {
 public:
     static ErrorOr<NonnullOwnPtr<XzDecompressor>> create(MaybeOwned<Stream>);
 
+    // Any thread count other than 1 decompresses on a ParallelXzDecompressor, with 0 using one thread per available core.
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes, size_t thread_count = 1);
+
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
     virtual bool is_eof() const override;
@@ -163,8 +168,13 @@ public:
     virtual void close() override;
 
 private:
+    friend class ParallelXzDecompressor;
+
     XzDecompressor(NonnullOwnPtr<CountingStream>);
 
+    // Decodes a single block into `output`, which is grown as data is decoded instead of being sized from the Index up front.
+    static ErrorOr<void> decompress_block(ReadonlyBytes block, XzStreamFlags, u64 unpadded_size, u64 uncompressed_size, ByteBuffer& output);
+
     ErrorOr<bool> load_next_stream();
     ErrorOr<void> load_next_block(u8 encoded_block_header_size);
     ErrorOr<void> finish_current_block();
@@ -187,6 +197,57 @@ private:
     Vector<BlockMetadata> m_processed_blocks;
 };
 
+// Decodes the blocks of a complete in-memory XZ file on a thread pool. The Index of every Stream is read up front
+// to locate the blocks and their uncompressed sizes, which makes them independent of each other. Only files that
+// have been written in multiple blocks (e.g. by `xz -T`) benefit from this, single-block files are decoded as usual.
+// For the same reason, seeking only has to decode the blocks from the one that contains the new position onwards.
+class ParallelXzDecompressor final : public SeekableStream {
+public:
+    // A thread count of 0 uses one thread per available core.
+    static ErrorOr<NonnullOwnPtr<ParallelXzDecompressor>> create(ReadonlyBytes, size_t thread_count = 0);
+    ~ParallelXzDecompressor();
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+    virtual ErrorOr<size_t> seek(i64 offset, SeekMode) override;
+    virtual ErrorOr<size_t> tell() const override;
+    virtual ErrorOr<size_t> size() override;
+    virtual ErrorOr<void> truncate(size_t) override;
+
+private:
+    using ThreadPool = Threading::ThreadPool<size_t, Threading::ThreadPoolLooper>;
+
+    struct Block {
+        ReadonlyBytes data;
+        XzStreamFlags stream_flags {};
+        u64 unpadded_size { 0 };
+        u64 uncompressed_offset { 0 };
+        u64 uncompressed_size { 0 };
+        ByteBuffer output;
+        Optional<Error> error;
+    };
+
+    ParallelXzDecompressor(size_t thread_count, Vector<Block>);
+
+    static ErrorOr<Vector<Block>> read_indices(ReadonlyBytes);
+    void decompress_block(Block&) const;
+    void decompress_next_batch();
+
+    size_t m_thread_count { 0 };
+    Vector<Block> m_blocks;
+
+    // The blocks in [m_batch_start, m_batch_end) have been decoded, and m_batch_start is the one that is being read from.
+    size_t m_batch_start { 0 };
+    size_t m_batch_end { 0 };
+    size_t m_output_offset { 0 };
+
+    OwnPtr<ThreadPool> m_thread_pool;
+};
+
 }
 
 template<>
@@ -64,15 +64,31 @@ void ZlibDecompressor::close()
 {
 }
 
-ErrorOr<NonnullOwnPtr<ZlibCompressor>> ZlibCompressor::construct(MaybeOwned<Stream> stream, ZlibCompressionLevel compression_level)
+ErrorOr<NonnullOwnPtr<ZlibCompressor>> ZlibCompressor::construct(MaybeOwned<Stream> stream, ZlibCompressionLevel compression_level, size_t thread_count)
 {
     // Zlib only defines Deflate as a compression method.
     auto compression_method = ZlibCompressionMethod::Deflate;
 
-    // FIXME: Find a way to compress with Deflate's "Best" compression level.
-    auto compressor_stream = TRY(DeflateCompressor::construct(MaybeOwned(*stream), static_cast<DeflateCompressor::CompressionLevel>(compression_level)));
-
-    auto zlib_compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ZlibCompressor(move(stream), move(compressor_stream))));
+    auto deflate_compression_level = [&] {
+        switch (compression_level) {
+        case ZlibCompressionLevel::Fastest:
+            return DeflateCompressor::CompressionLevel::STORE;
+        case ZlibCompressionLevel::Fast:
+            return DeflateCompressor::CompressionLevel::FAST;
+        case ZlibCompressionLevel::Default:
+            return DeflateCompressor::CompressionLevel::GOOD;
+        case ZlibCompressionLevel::Best:
+            return DeflateCompressor::CompressionLevel::BEST;
+        }
+        VERIFY_NOT_REACHED();
+    }();
+    OwnPtr<Stream> compressor_stream;
+    if (thread_count == 1)
+        compressor_stream = TRY(DeflateCompressor::construct(MaybeOwned(*stream), deflate_compression_level));
+    else
+        compressor_stream = TRY(ParallelDeflateCompressor::construct(MaybeOwned(*stream), thread_count, deflate_compression_level, ParallelDeflateCompressor::Checksum::Adler32));
+
+    auto zlib_compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ZlibCompressor(move(stream), compressor_stream.release_nonnull())));
     TRY(zlib_compressor->write_header(compression_method, compression_level));
 
     return zlib_compressor;
@@ -123,7 +139,9 @@ ErrorOr<size_t> ZlibCompressor::write_some(ReadonlyBytes bytes)
     VERIFY(!m_finished);
 
     size_t n_written = TRY(m_compressor->write_some(bytes));
-    m_adler32_checksum.update(bytes.trim(n_written));
+    // the parallel compressor checksums every chunk on its worker thread already
+    if (!is<ParallelDeflateCompressor>(m_compressor.ptr()))
+        m_adler32_checksum.update(bytes.trim(n_written));
     return n_written;
 }
 
@@ -145,10 +163,17 @@ ErrorOr<void> ZlibCompressor::finish()
 {
     VERIFY(!m_finished);
 
-    if (is<DeflateCompressor>(m_compressor.ptr()))
-        TRY(static_cast<DeflateCompressor*>(m_compressor.ptr())->final_flush());
+    NetworkOrdered<u32> adler_sum = 0;
+    if (is<ParallelDeflateCompressor>(m_compressor.ptr())) {
+        auto& parallel_compressor = static_cast<ParallelDeflateCompressor&>(*m_compressor);
+        TRY(parallel_compressor.final_flush());
+        adler_sum = parallel_compressor.checksum();
+    } else {
+        if (is<DeflateCompressor>(m_compressor.ptr()))
+            TRY(static_cast<DeflateCompressor*>(m_compressor.ptr())->final_flush());
+        adler_sum = m_adler32_checksum.digest();
+    }
 
-    NetworkOrdered<u32> adler_sum = m_adler32_checksum.digest();
     TRY(m_output_stream->write_value(adler_sum));
 
     m_finished = true;
@@ -156,10 +181,10 @@ ErrorOr<void> ZlibCompressor::finish()
     return {};
 }
 
-ErrorOr<ByteBuffer> ZlibCompressor::compress_all(ReadonlyBytes bytes, ZlibCompressionLevel compression_level)
+ErrorOr<ByteBuffer> ZlibCompressor::compress_all(ReadonlyBytes bytes, ZlibCompressionLevel compression_level, size_t thread_count)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
-    auto zlib_stream = TRY(ZlibCompressor::construct(MaybeOwned<Stream>(*output_stream), compression_level));
+    auto zlib_stream = TRY(ZlibCompressor::construct(MaybeOwned<Stream>(*output_stream), compression_level, thread_count));
 
     TRY(zlib_stream->write_until_depleted(bytes));
 
@@ -63,7 +63,8 @@ private:
 
 class ZlibCompressor : public Stream {
 public:
-    static ErrorOr<NonnullOwnPtr<ZlibCompressor>> construct(MaybeOwned<Stream>, ZlibCompressionLevel = ZlibCompressionLevel::Default);
+    // Any thread count other than 1 compresses on a ParallelDeflateCompressor, with 0 using one thread per available core.
+    static ErrorOr<NonnullOwnPtr<ZlibCompressor>> construct(MaybeOwned<Stream>, ZlibCompressionLevel = ZlibCompressionLevel::Default, size_t thread_count = 1);
     ~ZlibCompressor();
 
     virtual ErrorOr<Bytes> read_some(Bytes) override;
@@ -73,7 +74,7 @@ public:
     virtual void close() override;
     ErrorOr<void> finish();
 
-    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, ZlibCompressionLevel = ZlibCompressionLevel::Default);
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, ZlibCompressionLevel = ZlibCompressionLevel::Default, size_t thread_count = 1);
 
 private:
     ZlibCompressor(MaybeOwned<Stream> stream, NonnullOwnPtr<Stream> compressor_stream);
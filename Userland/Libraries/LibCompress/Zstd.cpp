@@ -0,0 +1,1513 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AllOf.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/ByteReader.h>
+#include <AK/Endian.h>
+#include <AK/MemoryStream.h>
+#include <LibCompress/Huffman.h>
+#include <LibCompress/Zstd.h>
+
+namespace Compress {
+
+namespace Zstd {
+
+// 3.1.1.3.2.1.1. Sequence Codes for Lengths and Offsets
+static constexpr size_t max_literal_length_code = 35;
+static constexpr size_t max_match_length_code = 52;
+static constexpr size_t max_offset_code = 31;
+
+static constexpr Array<u32, max_literal_length_code + 1> literal_length_baselines {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 18, 20, 22, 24, 28, 32, 40, 48, 64, 128, 256, 512, 1024, 2048, 4096,
+    8192, 16384, 32768, 65536
+};
+static constexpr Array<u8, max_literal_length_code + 1> literal_length_extra_bits {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 6, 7, 8, 9, 10, 11, 12,
+    13, 14, 15, 16
+};
+
+static constexpr Array<u32, max_match_length_code + 1> match_length_baselines {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+    19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,
+    35, 37, 39, 41, 43, 47, 51, 59, 67, 83, 99, 131, 259, 515, 1027, 2051,
+    4099, 8195, 16387, 32771, 65539
+};
+static constexpr Array<u8, max_match_length_code + 1> match_length_extra_bits {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 7, 8, 9, 10, 11,
+    12, 13, 14, 15, 16
+};
+
+// 3.1.1.3.2.2. Default Distributions
+static constexpr u8 default_literal_lengths_accuracy_log = 6;
+static constexpr Array<i16, 36> default_literal_lengths_distribution {
+    4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1,
+    -1, -1, -1, -1
+};
+
+static constexpr u8 default_match_lengths_accuracy_log = 6;
+static constexpr Array<i16, 53> default_match_lengths_distribution {
+    1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1,
+    -1, -1, -1, -1, -1
+};
+
+static constexpr u8 default_offsets_accuracy_log = 5;
+static constexpr Array<i16, 29> default_offsets_distribution {
+    1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1
+};
+
+// 3.1.1.3.2.1. Sequences_Section_Header
+static constexpr u8 max_literal_lengths_accuracy_log = 9;
+static constexpr u8 max_match_lengths_accuracy_log = 9;
+static constexpr u8 max_offsets_accuracy_log = 8;
+
+// 4.2.1. Huffman Tree Description
+static constexpr u8 max_huffman_weights_accuracy_log = 6;
+static constexpr u8 max_huffman_bit_count = 11;
+static constexpr size_t max_huffman_weight_count = 255;
+static constexpr size_t max_direct_huffman_weight_count = 128;
+
+static ALWAYS_INLINE u32 highest_bit(u32 value)
+{
+    return 31 - count_leading_zeroes(value);
+}
+
+// Reads the little-endian bit fields of FSE table descriptions.
+class ForwardBitReader {
+public:
+    explicit ForwardBitReader(ReadonlyBytes data)
+        : m_data(data)
+    {
+    }
+
+    // Bits beyond the end of the data read as zero, callers have to check bytes_consumed() once they are done.
+    u32 peek_bits(size_t count) const
+    {
+        u64 value = 0;
+        auto byte_offset = m_bit_offset / 8;
+        for (size_t i = 0; i < 8 && byte_offset + i < m_data.size(); ++i)
+            value |= static_cast<u64>(m_data[byte_offset + i]) << (i * 8);
+        return (value >> (m_bit_offset % 8)) & ((1ull << count) - 1);
+    }
+
+    void consume_bits(size_t count) { m_bit_offset += count; }
+
+    u32 read_bits(size_t count)
+    {
+        auto value = peek_bits(count);
+        consume_bits(count);
+        return value;
+    }
+
+    size_t bytes_consumed() const { return ceil_div(m_bit_offset, 8uz); }
+
+private:
+    ReadonlyBytes m_data;
+    size_t m_bit_offset { 0 };
+};
+
+// 4.1. FSE and 4.2.2. Huffman-Coded Streams:
+// Entropy-coded bitstreams are written forward, but read backward, starting with the highest bit of the last byte.
+class ReverseBitReader {
+public:
+    static ErrorOr<ReverseBitReader> create(ReadonlyBytes data)
+    {
+        // The last byte contains a single 1-bit to mark where the actual data starts.
+        if (data.is_empty() || data.last() == 0)
+            return Error::from_string_literal("Zstandard bitstream is missing its end marker");
+
+        auto padding = count_leading_zeroes(static_cast<u32>(data.last())) - 24 + 1;
+        return ReverseBitReader { data, static_cast<ssize_t>(data.size() * 8 - padding) };
+    }
+
+    // Reading past the start of the stream returns zeroes and makes the reader overflowed.
+    ALWAYS_INLINE u64 peek_bits(size_t count) const
+    {
+        auto start = m_bit_offset - static_cast<ssize_t>(count);
+        if (start >= 0)
+            return extract_bits(start, count);
+        if (m_bit_offset <= 0)
+            return 0;
+        return extract_bits(0, m_bit_offset) << -start;
+    }
+
+    ALWAYS_INLINE void consume_bits(size_t count) { m_bit_offset -= count; }
+
+    ALWAYS_INLINE u64 read_bits(size_t count)
+    {
+        auto value = peek_bits(count);
+        consume_bits(count);
+        return value;
+    }
+
+    bool is_overflowed() const { return m_bit_offset < 0; }
+    bool is_exhausted() const { return m_bit_offset == 0; }
+
+private:
+    ReverseBitReader(ReadonlyBytes data, ssize_t bit_offset)
+        : m_data(data)
+        , m_bit_offset(bit_offset)
+    {
+    }
+
+    ALWAYS_INLINE u64 extract_bits(size_t start, size_t count) const
+    {
+        auto byte_offset = start / 8;
+        u64 value = 0;
+        if (byte_offset + sizeof(u64) <= m_data.size()) {
+            value = AK::convert_between_host_and_little_endian(ByteReader::load64(m_data.offset_pointer(byte_offset)));
+        } else {
+            for (size_t i = 0; byte_offset + i < m_data.size(); ++i)
+                value |= static_cast<u64>(m_data[byte_offset + i]) << (i * 8);
+        }
+        return (value >> (start % 8)) & ((1ull << count) - 1);
+    }
+
+    ReadonlyBytes m_data;
+    ssize_t m_bit_offset { 0 };
+};
+
+// 4.1.1. FSE Table Description
+static ErrorOr<FseTable> build_fse_table(ReadonlySpan<i16> distribution, u8 accuracy_log)
+{
+    size_t table_size = 1u << accuracy_log;
+
+    FseTable table;
+    table.accuracy_log = accuracy_log;
+    TRY(table.entries.try_resize(table_size));
+
+    // Symbols with a "less than 1" probability occupy a single state each at the end of the table.
+    Array<u16, 256> next_state;
+    ssize_t high_threshold = table_size - 1;
+    for (size_t symbol = 0; symbol < distribution.size(); ++symbol) {
+        if (distribution[symbol] == -1) {
+            table.entries[high_threshold--].symbol = symbol;
+            next_state[symbol] = 1;
+        } else {
+            next_state[symbol] = distribution[symbol];
+        }
+    }
+
+    size_t position = 0;
+    size_t step = (table_size >> 1) + (table_size >> 3) + 3;
+    size_t mask = table_size - 1;
+    for (size_t symbol = 0; symbol < distribution.size(); ++symbol) {
+        for (i16 i = 0; i < distribution[symbol]; ++i) {
+            table.entries[position].symbol = symbol;
+            do {
+                position = (position + step) & mask;
+            } while (static_cast<ssize_t>(position) > high_threshold);
+        }
+    }
+    if (position != 0)
+        return Error::from_string_literal("Zstandard FSE distribution is invalid");
+
+    for (auto& entry : table.entries) {
+        u32 state = next_state[entry.symbol]++;
+        entry.bit_count = accuracy_log - highest_bit(state);
+        entry.base = (state << entry.bit_count) - table_size;
+    }
+
+    return table;
+}
+
+static ErrorOr<size_t> read_fse_table(ReadonlyBytes data, u8 max_accuracy_log, size_t max_symbol, FseTable& table)
+{
+    ForwardBitReader reader { data };
+
+    u8 accuracy_log = reader.read_bits(4) + 5;
+    if (accuracy_log > max_accuracy_log)
+        return Error::from_string_literal("Zstandard FSE accuracy log is too large");
+
+    // The remaining probability (plus one) determines how many bits the next value can take up.
+    i32 remaining = (1 << accuracy_log) + 1;
+    i32 threshold = 1 << accuracy_log;
+    size_t bit_count = accuracy_log + 1;
+
+    Vector<i16, 256> distribution;
+    bool previous_was_zero = false;
+    while (remaining > 1 && distribution.size() <= max_symbol) {
+        if (previous_was_zero) {
+            size_t zero_count = 0;
+            for (;;) {
+                auto repeat = reader.read_bits(2);
+                zero_count += repeat;
+                if (repeat != 3)
+                    break;
+            }
+            if (distribution.size() + zero_count > max_symbol)
+                return Error::from_string_literal("Zstandard FSE distribution has too many symbols");
+            TRY(distribution.try_resize(distribution.size() + zero_count));
+        }
+
+        i32 max_small_value = (2 * threshold - 1) - remaining;
+        i32 value = reader.peek_bits(bit_count);
+        if ((value & (threshold - 1)) < max_small_value) {
+            value &= threshold - 1;
+            reader.consume_bits(bit_count - 1);
+        } else {
+            value &= 2 * threshold - 1;
+            if (value >= threshold)
+                value -= max_small_value;
+            reader.consume_bits(bit_count);
+        }
+
+        i16 probability = value - 1;
+        remaining -= probability < 0 ? -probability : probability;
+        if (remaining < 1)
+            return Error::from_string_literal("Zstandard FSE distribution is invalid");
+
+        TRY(distribution.try_append(probability));
+        previous_was_zero = probability == 0;
+
+        while (remaining < threshold) {
+            bit_count--;
+            threshold >>= 1;
+        }
+    }
+
+    if (remaining != 1 || reader.bytes_consumed() > data.size())
+        return Error::from_string_literal("Zstandard FSE distribution is invalid");
+
+    table = TRY(build_fse_table(distribution, accuracy_log));
+    return reader.bytes_consumed();
+}
+
+// 4.2.1.3. Huffman Tree Description
+static ErrorOr<HuffmanTable> build_huffman_table(Vector<u8, 256>& weights)
+{
+    if (weights.size() > max_huffman_weight_count)
+        return Error::from_string_literal("Zstandard Huffman tree has too many symbols");
+
+    u32 weight_sum = 0;
+    for (auto weight : weights) {
+        if (weight > max_huffman_bit_count)
+            return Error::from_string_literal("Zstandard Huffman weight is too large");
+        if (weight != 0)
+            weight_sum += 1u << (weight - 1);
+    }
+    if (weight_sum == 0)
+        return Error::from_string_literal("Zstandard Huffman tree is empty");
+
+    // The weight of the last symbol is implied by the others, as it has to complete the code.
+    u8 max_bit_count = highest_bit(weight_sum) + 1;
+    if (max_bit_count > max_huffman_bit_count)
+        return Error::from_string_literal("Zstandard Huffman tree is too deep");
+
+    u32 remainder = (1u << max_bit_count) - weight_sum;
+    if (!is_power_of_two(remainder))
+        return Error::from_string_literal("Zstandard Huffman tree is incomplete");
+    TRY(weights.try_append(highest_bit(remainder) + 1));
+
+    HuffmanTable table;
+    table.max_bit_count = max_bit_count;
+    TRY(table.entries.try_resize(1u << max_bit_count));
+
+    // The longest codes (lowest weights) come first, and symbols of the same weight are ordered by their value.
+    size_t position = 0;
+    for (u8 weight = 1; weight <= max_bit_count; ++weight) {
+        for (size_t symbol = 0; symbol < weights.size(); ++symbol) {
+            if (weights[symbol] != weight)
+                continue;
+            size_t count = 1u << (weight - 1);
+            table.entries.span().slice(position, count).fill({ static_cast<u8>(symbol), static_cast<u8>(max_bit_count + 1 - weight) });
+            position += count;
+        }
+    }
+
+    return table;
+}
+
+// 4.2.1.2. FSE Compression of Huffman Weights
+static ErrorOr<void> decode_huffman_weights(ReadonlyBytes data, Vector<u8, 256>& weights)
+{
+    FseTable table;
+    auto table_size = TRY(read_fse_table(data, max_huffman_weights_accuracy_log, max_huffman_bit_count, table));
+    auto reader = TRY(ReverseBitReader::create(data.slice(table_size)));
+
+    // Two interleaved states share the bitstream, and decoding stops once an update has to read past its start.
+    u16 states[2];
+    states[0] = reader.read_bits(table.accuracy_log);
+    states[1] = reader.read_bits(table.accuracy_log);
+
+    for (size_t current = 0;; current ^= 1) {
+        if (weights.size() + 2 > max_huffman_weight_count)
+            return Error::from_string_literal("Zstandard Huffman tree has too many symbols");
+
+        auto entry = table.entries[states[current]];
+        weights.unchecked_append(entry.symbol);
+        states[current] = entry.base + reader.read_bits(entry.bit_count);
+
+        if (reader.is_overflowed()) {
+            weights.unchecked_append(table.entries[states[current ^ 1]].symbol);
+            return {};
+        }
+    }
+}
+
+// 3.1.1.5. Sequence Execution
+static ErrorOr<u32> resolve_offset(RepeatedOffsets& repeated_offsets, u32 offset_value, u32 literal_length)
+{
+    if (offset_value > 3) {
+        u32 offset = offset_value - 3;
+        repeated_offsets = { offset, repeated_offsets[0], repeated_offsets[1] };
+        return offset;
+    }
+
+    // When there are no literals, the repeated offsets are shifted by one, as repeating the first one would just
+    // extend the previous match.
+    auto index = offset_value - 1 + (literal_length == 0 ? 1 : 0);
+    if (index == 0)
+        return repeated_offsets[0];
+
+    u32 offset = index == 3 ? repeated_offsets[0] - 1 : repeated_offsets[index];
+    if (offset == 0)
+        return Error::from_string_literal("Zstandard repeated offset is zero");
+
+    if (index == 1)
+        repeated_offsets = { offset, repeated_offsets[0], repeated_offsets[2] };
+    else
+        repeated_offsets = { offset, repeated_offsets[0], repeated_offsets[1] };
+    return offset;
+}
+
+}
+
+ErrorOr<NonnullOwnPtr<ZstdDecompressor>> ZstdDecompressor::construct(MaybeOwned<Stream> stream)
+{
+    return adopt_nonnull_own_or_enomem(new (nothrow) ZstdDecompressor(move(stream)));
+}
+
+ZstdDecompressor::ZstdDecompressor(MaybeOwned<Stream> stream)
+    : m_stream(move(stream))
+{
+}
+
+ErrorOr<ByteBuffer> ZstdDecompressor::decompress_all(ReadonlyBytes bytes)
+{
+    auto memory_stream = TRY(try_make<FixedMemoryStream>(bytes));
+    auto zstd_stream = TRY(ZstdDecompressor::construct(move(memory_stream)));
+    return zstd_stream->read_until_eof(4096);
+}
+
+ErrorOr<void> ZstdDecompressor::read_frame_header()
+{
+    // 3.1.1. Zstandard Frames, 3.1.2. Skippable Frames
+    for (;;) {
+        // Whether there is another frame can only be told by trying to read it, as not all streams know about their EOF in advance.
+        Array<u8, 4> magic_bytes;
+        size_t magic_bytes_read = 0;
+        while (magic_bytes_read < magic_bytes.size()) {
+            auto read_bytes = TRY(m_stream->read_some(magic_bytes.span().slice(magic_bytes_read)));
+            if (read_bytes.is_empty())
+                break;
+            magic_bytes_read += read_bytes.size();
+        }
+
+        if (magic_bytes_read == 0) {
+            m_state = State::Finished;
+            return {};
+        }
+        if (magic_bytes_read < magic_bytes.size())
+            return Error::from_string_literal("Zstandard frame header is truncated");
+
+        u32 magic = magic_bytes[0] | (magic_bytes[1] << 8) | (magic_bytes[2] << 16) | (magic_bytes[3] << 24);
+        if ((magic & Zstd::skippable_frame_magic_number_mask) == Zstd::skippable_frame_magic_number) {
+            u32 frame_size = TRY(m_stream->read_value<LittleEndian<u32>>());
+            TRY(m_stream->discard(frame_size));
+            continue;
+        }
+
+        if (magic != Zstd::frame_magic_number)
+            return Error::from_string_literal("Invalid Zstandard frame magic number");
+        break;
+    }
+
+    // 3.1.1.1.1. Frame_Header_Descriptor
+    u8 descriptor = TRY(m_stream->read_value<u8>());
+    u8 content_size_flag = descriptor >> 6;
+    bool single_segment = (descriptor >> 5) & 1;
+    bool has_checksum = (descriptor >> 2) & 1;
+    u8 dictionary_id_flag = descriptor & 3;
+    if (descriptor & 0x08)
+        return Error::from_string_literal("Zstandard frame header has a reserved bit set");
+
+    // 3.1.1.1.2. Window_Descriptor
+    u64 window_size = 0;
+    if (!single_segment) {
+        u8 window_descriptor = TRY(m_stream->read_value<u8>());
+        u64 window_base = 1ull << (10 + (window_descriptor >> 3));
+        window_size = window_base + (window_base / 8) * (window_descriptor & 7);
+    }
+
+    // 3.1.1.1.3. Dictionary_ID
+    static constexpr Array<u8, 4> dictionary_id_sizes { 0, 1, 2, 4 };
+    u32 dictionary_id = 0;
+    for (size_t i = 0; i < dictionary_id_sizes[dictionary_id_flag]; ++i)
+        dictionary_id |= TRY(m_stream->read_value<u8>()) << (i * 8);
+    if (dictionary_id != 0)
+        return Error::from_string_literal("Zstandard dictionaries are not supported");
+
+    // 3.1.1.1.4. Frame_Content_Size
+    static constexpr Array<u8, 4> content_size_sizes { 0, 2, 4, 8 };
+    size_t content_size_size = content_size_flag == 0 && single_segment ? 1 : content_size_sizes[content_size_flag];
+    m_frame_content_size.clear();
+    if (content_size_size != 0) {
+        u64 content_size = 0;
+        for (size_t i = 0; i < content_size_size; ++i)
+            content_size |= static_cast<u64>(TRY(m_stream->read_value<u8>())) << (i * 8);
+        if (content_size_size == 2)
+            content_size += 256;
+        m_frame_content_size = content_size;
+    }
+
+    if (single_segment)
+        window_size = m_frame_content_size.value();
+    if (window_size > max_window_size)
+        return Error::from_string_literal("Zstandard window size is too large");
+
+    m_block_maximum_size = min(window_size, Zstd::max_block_size);
+
+    // The window only has to hold the data that can be referenced, as a block is only decoded once the previous one was read.
+    auto window_capacity = max(window_size, 1 * KiB);
+    if (!m_window.has_value() || m_window->capacity() < window_capacity)
+        m_window = TRY(CircularBuffer::create_empty(window_capacity));
+    else
+        m_window->clear();
+
+    m_frame_decoded_size = 0;
+    m_checksum.clear();
+    if (has_checksum)
+        m_checksum = Crypto::Checksum::XXHash64 {};
+
+    m_huffman_table.clear();
+    m_literal_lengths_table.clear();
+    m_offsets_table.clear();
+    m_match_lengths_table.clear();
+    m_repeated_offsets = Zstd::initial_repeated_offsets;
+
+    m_state = State::Blocks;
+    return {};
+}
+
+ErrorOr<void> ZstdDecompressor::read_frame_footer()
+{
+    if (m_frame_content_size.has_value() && m_frame_content_size.value() != m_frame_decoded_size)
+        return Error::from_string_literal("Zstandard frame content size does not match the decoded size");
+
+    // 3.1.1. Content_Checksum
+    if (m_checksum.has_value()) {
+        u32 expected_checksum = TRY(m_stream->read_value<LittleEndian<u32>>());
+        if (static_cast<u32>(m_checksum->digest()) != expected_checksum)
+            return Error::from_string_literal("Zstandard frame checksum does not match");
+    }
+
+    m_state = State::FrameHeader;
+    return {};
+}
+
+ErrorOr<void> ZstdDecompressor::write_to_window(ReadonlyBytes bytes)
+{
+    if (m_window->write(bytes) != bytes.size())
+        return Error::from_string_literal("Zstandard block is too large");
+    m_frame_decoded_size += bytes.size();
+    return {};
+}
+
+ErrorOr<void> ZstdDecompressor::decode_block()
+{
+    // 3.1.1.2. Blocks
+    Array<u8, 3> header_bytes;
+    TRY(m_stream->read_until_filled(header_bytes));
+    u32 header = header_bytes[0] | (header_bytes[1] << 8) | (header_bytes[2] << 16);
+
+    bool is_last_block = header & 1;
+    u8 block_type = (header >> 1) & 3;
+    size_t block_size = header >> 3;
+
+    if (block_size > m_block_maximum_size)
+        return Error::from_string_literal("Zstandard block is too large");
+
+    switch (block_type) {
+    case 0: // Raw_Block
+        TRY(m_block_buffer.try_resize(block_size));
+        TRY(m_stream->read_until_filled(m_block_buffer));
+        TRY(write_to_window(m_block_buffer));
+        break;
+    case 1: { // RLE_Block
+        u8 value = TRY(m_stream->read_value<u8>());
+        TRY(m_block_buffer.try_resize(block_size));
+        m_block_buffer.bytes().fill(value);
+        TRY(write_to_window(m_block_buffer));
+        break;
+    }
+    case 2: // Compressed_Block
+        TRY(m_block_buffer.try_resize(block_size));
+        TRY(m_stream->read_until_filled(m_block_buffer));
+        TRY(decode_compressed_block(m_block_buffer));
+        break;
+    default:
+        return Error::from_string_literal("Zstandard block has a reserved type");
+    }
+
+    if (is_last_block)
+        m_state = State::FrameFooter;
+    return {};
+}
+
+ErrorOr<void> ZstdDecompressor::decode_compressed_block(ReadonlyBytes data)
+{
+    auto literals_section_size = TRY(decode_literals_section(data));
+    TRY(decode_sequences_section(data.slice(literals_section_size)));
+    return {};
+}
+
+ErrorOr<size_t> ZstdDecompressor::decode_literals_section(ReadonlyBytes data)
+{
+    // 3.1.1.3.1.1. Literals_Section_Header
+    if (data.is_empty())
+        return Error::from_string_literal("Zstandard literals section is truncated");
+
+    u8 literals_block_type = data[0] & 3;
+    u8 size_format = (data[0] >> 2) & 3;
+    m_literals_offset = 0;
+
+    if (literals_block_type == 0 || literals_block_type == 1) {
+        // Raw_Literals_Block, RLE_Literals_Block
+        size_t header_size;
+        size_t regenerated_size;
+        switch (size_format) {
+        case 0:
+        case 2:
+            header_size = 1;
+            regenerated_size = data[0] >> 3;
+            break;
+        case 1:
+            header_size = 2;
+            if (data.size() < header_size)
+                return Error::from_string_literal("Zstandard literals section is truncated");
+            regenerated_size = (data[0] >> 4) | (data[1] << 4);
+            break;
+        default:
+            header_size = 3;
+            if (data.size() < header_size)
+                return Error::from_string_literal("Zstandard literals section is truncated");
+            regenerated_size = (data[0] >> 4) | (data[1] << 4) | (data[2] << 12);
+            break;
+        }
+
+        if (regenerated_size > m_block_maximum_size)
+            return Error::from_string_literal("Zstandard literals section is too large");
+        TRY(m_literals.try_resize(regenerated_size));
+
+        if (literals_block_type == 0) {
+            if (data.size() < header_size + regenerated_size)
+                return Error::from_string_literal("Zstandard literals section is truncated");
+            data.slice(header_size, regenerated_size).copy_to(m_literals);
+            return header_size + regenerated_size;
+        }
+
+        if (data.size() < header_size + 1)
+            return Error::from_string_literal("Zstandard literals section is truncated");
+        m_literals.span().fill(data[header_size]);
+        return header_size + 1;
+    }
+
+    // Compressed_Literals_Block, Treeless_Literals_Block
+    static constexpr Array<u8, 4> header_sizes { 3, 3, 4, 5 };
+    static constexpr Array<u8, 4> size_bit_counts { 10, 10, 14, 18 };
+
+    size_t header_size = header_sizes[size_format];
+    if (data.size() < header_size)
+        return Error::from_string_literal("Zstandard literals section is truncated");
+
+    u64 header = 0;
+    for (size_t i = 0; i < header_size; ++i)
+        header |= static_cast<u64>(data[i]) << (i * 8);
+
+    u64 size_mask = (1u << size_bit_counts[size_format]) - 1;
+    size_t regenerated_size = (header >> 4) & size_mask;
+    size_t compressed_size = (header >> (4 + size_bit_counts[size_format])) & size_mask;
+
+    if (regenerated_size > m_block_maximum_size)
+        return Error::from_string_literal("Zstandard literals section is too large");
+    if (data.size() < header_size + compressed_size)
+        return Error::from_string_literal("Zstandard literals section is truncated");
+
+    auto streams = data.slice(header_size, compressed_size);
+    if (literals_block_type == 2) {
+        auto tree_size = TRY(read_huffman_table(streams));
+        streams = streams.slice(tree_size);
+    } else if (!m_huffman_table.has_value()) {
+        return Error::from_string_literal("Zstandard treeless literals block without a previous Huffman tree");
+    }
+
+    TRY(m_literals.try_resize(regenerated_size));
+
+    // 4.2.2. Huffman-Coded Streams
+    auto decode_stream = [this](ReadonlyBytes stream, Bytes output) -> ErrorOr<void> {
+        auto reader = TRY(Zstd::ReverseBitReader::create(stream));
+        auto const& table = m_huffman_table.value();
+        for (auto& byte : output) {
+            auto entry = table.entries[reader.peek_bits(table.max_bit_count)];
+            byte = entry.symbol;
+            reader.consume_bits(entry.bit_count);
+        }
+        if (!reader.is_exhausted())
+            return Error::from_string_literal("Zstandard Huffman stream does not match its size");
+        return {};
+    };
+
+    if (size_format == 0) {
+        TRY(decode_stream(streams, m_literals));
+        return header_size + compressed_size;
+    }
+
+    // 3.1.1.3.1.6. Jump_Table
+    if (streams.size() < 6)
+        return Error::from_string_literal("Zstandard literals jump table is truncated");
+
+    Array<size_t, 4> stream_sizes;
+    for (size_t i = 0; i < 3; ++i)
+        stream_sizes[i] = streams[i * 2] | (streams[i * 2 + 1] << 8);
+    streams = streams.slice(6);
+    if (stream_sizes[0] + stream_sizes[1] + stream_sizes[2] > streams.size())
+        return Error::from_string_literal("Zstandard literals jump table is invalid");
+    stream_sizes[3] = streams.size() - stream_sizes[0] - stream_sizes[1] - stream_sizes[2];
+
+    size_t segment_size = (regenerated_size + 3) / 4;
+    if (segment_size * 3 > regenerated_size)
+        return Error::from_string_literal("Zstandard literals section is too small for four streams");
+
+    for (size_t i = 0; i < 4; ++i) {
+        auto output = m_literals.span().slice(i * segment_size, i == 3 ? regenerated_size - 3 * segment_size : segment_size);
+        TRY(decode_stream(streams.trim(stream_sizes[i]), output));
+        streams = streams.slice(stream_sizes[i]);
+    }
+
+    return header_size + compressed_size;
+}
+
+ErrorOr<size_t> ZstdDecompressor::read_huffman_table(ReadonlyBytes data)
+{
+    // 4.2.1. Huffman Tree Description
+    if (data.is_empty())
+        return Error::from_string_literal("Zstandard Huffman tree description is truncated");
+
+    Vector<u8, 256> weights;
+    size_t description_size;
+
+    u8 header = data[0];
+    if (header < 128) {
+        description_size = 1 + header;
+        if (data.size() < description_size)
+            return Error::from_string_literal("Zstandard Huffman tree description is truncated");
+        TRY(Zstd::decode_huffman_weights(data.slice(1, header), weights));
+    } else {
+        size_t weight_count = header - 127;
+        description_size = 1 + ceil_div(weight_count, 2uz);
+        if (data.size() < description_size)
+            return Error::from_string_literal("Zstandard Huffman tree description is truncated");
+        for (size_t i = 0; i < weight_count; ++i) {
+            u8 byte = data[1 + i / 2];
+            weights.unchecked_append(i % 2 == 0 ? byte >> 4 : byte & 0xf);
+        }
+    }
+
+    m_huffman_table = TRY(Zstd::build_huffman_table(weights));
+    return description_size;
+}
+
+ErrorOr<void> ZstdDecompressor::decode_sequences_section(ReadonlyBytes data)
+{
+    // 3.1.1.3.2.1. Sequences_Section_Header
+    if (data.is_empty())
+        return Error::from_string_literal("Zstandard sequences section is truncated");
+
+    size_t offset = 0;
+    size_t sequence_count = data[0];
+    if (sequence_count < 128) {
+        offset = 1;
+    } else if (sequence_count < 255) {
+        if (data.size() < 2)
+            return Error::from_string_literal("Zstandard sequences section is truncated");
+        sequence_count = ((sequence_count - 128) << 8) + data[1];
+        offset = 2;
+    } else {
+        if (data.size() < 3)
+            return Error::from_string_literal("Zstandard sequences section is truncated");
+        sequence_count = data[1] + (data[2] << 8) + 0x7F00;
+        offset = 3;
+    }
+
+    if (sequence_count == 0) {
+        if (offset != data.size())
+            return Error::from_string_literal("Zstandard sequences section has trailing data");
+        return write_to_window(m_literals.span());
+    }
+
+    if (offset >= data.size())
+        return Error::from_string_literal("Zstandard sequences section is truncated");
+    u8 modes = data[offset++];
+    if (modes & 3)
+        return Error::from_string_literal("Zstandard sequences section has reserved bits set");
+
+    // 3.1.1.3.2.1.1. Compression_Modes
+    auto update_table = [&](u8 mode, Optional<Zstd::FseTable>& table, ReadonlySpan<i16> default_distribution, u8 default_accuracy_log, u8 max_accuracy_log, size_t max_code) -> ErrorOr<void> {
+        switch (mode) {
+        case 0: // Predefined_Mode
+            table = TRY(Zstd::build_fse_table(default_distribution, default_accuracy_log));
+            return {};
+        case 1: { // RLE_Mode
+            if (offset >= data.size())
+                return Error::from_string_literal("Zstandard sequences section is truncated");
+            u8 symbol = data[offset++];
+            if (symbol > max_code)
+                return Error::from_string_literal("Zstandard RLE sequence code is too large");
+            Zstd::FseTable rle_table;
+            TRY(rle_table.entries.try_append({ .base = 0, .symbol = symbol, .bit_count = 0 }));
+            table = move(rle_table);
+            return {};
+        }
+        case 2: { // FSE_Compressed_Mode
+            Zstd::FseTable compressed_table;
+            offset += TRY(Zstd::read_fse_table(data.slice(offset), max_accuracy_log, max_code, compressed_table));
+            table = move(compressed_table);
+            return {};
+        }
+        default: // Repeat_Mode
+            if (!table.has_value())
+                return Error::from_string_literal("Zstandard sequences section repeats a nonexistent table");
+            return {};
+        }
+    };
+
+    TRY(update_table(modes >> 6, m_literal_lengths_table, Zstd::default_literal_lengths_distribution, Zstd::default_literal_lengths_accuracy_log, Zstd::max_literal_lengths_accuracy_log, Zstd::max_literal_length_code));
+    TRY(update_table((modes >> 4) & 3, m_offsets_table, Zstd::default_offsets_distribution, Zstd::default_offsets_accuracy_log, Zstd::max_offsets_accuracy_log, Zstd::max_offset_code));
+    TRY(update_table((modes >> 2) & 3, m_match_lengths_table, Zstd::default_match_lengths_distribution, Zstd::default_match_lengths_accuracy_log, Zstd::max_match_lengths_accuracy_log, Zstd::max_match_length_code));
+
+    auto const& literal_lengths_table = m_literal_lengths_table.value();
+    auto const& offsets_table = m_offsets_table.value();
+    auto const& match_lengths_table = m_match_lengths_table.value();
+
+    // 3.1.1.3.2.2. The Sequences_Section_Bitstream
+    auto reader = TRY(Zstd::ReverseBitReader::create(data.slice(offset)));
+    size_t literal_length_state = reader.read_bits(literal_lengths_table.accuracy_log);
+    size_t offset_state = reader.read_bits(offsets_table.accuracy_log);
+    size_t match_length_state = reader.read_bits(match_lengths_table.accuracy_log);
+
+    for (size_t i = 0; i < sequence_count; ++i) {
+        auto literal_length_entry = literal_lengths_table.entries[literal_length_state];
+        auto offset_entry = offsets_table.entries[offset_state];
+        auto match_length_entry = match_lengths_table.entries[match_length_state];
+
+        // The additional bits are read in the order offset, match length, literal length.
+        u32 offset_value = (1u << offset_entry.symbol) + reader.read_bits(offset_entry.symbol);
+        u32 match_length = Zstd::match_length_baselines[match_length_entry.symbol] + reader.read_bits(Zstd::match_length_extra_bits[match_length_entry.symbol]);
+        u32 literal_length = Zstd::literal_length_baselines[literal_length_entry.symbol] + reader.read_bits(Zstd::literal_length_extra_bits[literal_length_entry.symbol]);
+
+        auto match_offset = TRY(Zstd::resolve_offset(m_repeated_offsets, offset_value, literal_length));
+
+        if (literal_length > m_literals.size() - m_literals_offset)
+            return Error::from_string_literal("Zstandard sequence uses more literals than available");
+        TRY(write_to_window(m_literals.span().slice(m_literals_offset, literal_length)));
+        m_literals_offset += literal_length;
+
+        if (TRY(m_window->copy_from_seekback(match_offset, match_length)) != match_length)
+            return Error::from_string_literal("Zstandard block is too large");
+        m_frame_decoded_size += match_length;
+
+        // The states are updated in the order literal length, match length, offset, but not after the last sequence.
+        if (i + 1 < sequence_count) {
+            literal_length_state = literal_length_entry.base + reader.read_bits(literal_length_entry.bit_count);
+            match_length_state = match_length_entry.base + reader.read_bits(match_length_entry.bit_count);
+            offset_state = offset_entry.base + reader.read_bits(offset_entry.bit_count);
+        }
+    }
+
+    if (!reader.is_exhausted())
+        return Error::from_string_literal("Zstandard sequences bitstream does not match its size");
+
+    TRY(write_to_window(m_literals.span().slice(m_literals_offset)));
+    return {};
+}
+
+ErrorOr<Bytes> ZstdDecompressor::read_some(Bytes bytes)
+{
+    while (!m_window.has_value() || m_window->used_space() == 0) {
+        switch (m_state) {
+        case State::FrameHeader:
+            TRY(read_frame_header());
+            break;
+        case State::Blocks:
+            TRY(decode_block());
+            break;
+        case State::FrameFooter:
+            TRY(read_frame_footer());
+            break;
+        case State::Finished:
+            return bytes.trim(0);
+        }
+    }
+
+    auto read_bytes = m_window->read(bytes);
+    if (m_checksum.has_value())
+        m_checksum->update(read_bytes);
+    return read_bytes;
+}
+
+ErrorOr<size_t> ZstdDecompressor::write_some(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool ZstdDecompressor::is_eof() const
+{
+    return m_state == State::Finished || (m_state == State::FrameHeader && m_stream->is_eof());
+}
+
+bool ZstdDecompressor::is_open() const
+{
+    return m_stream->is_open();
+}
+
+void ZstdDecompressor::close()
+{
+}
+
+namespace Zstd {
+
+// Writes the bitstreams that are read by ReverseBitReader.
+class BitWriter {
+public:
+    explicit BitWriter(ByteBuffer& output)
+        : m_output(output)
+    {
+    }
+
+    ALWAYS_INLINE ErrorOr<void> write_bits(u64 value, size_t count)
+    {
+        m_bit_buffer |= (value & ((1ull << count) - 1)) << m_bit_count;
+        m_bit_count += count;
+        if (m_bit_count >= 32) {
+            u32 bits = AK::convert_between_host_and_little_endian(static_cast<u32>(m_bit_buffer));
+            TRY(m_output.try_append(&bits, sizeof(bits)));
+            m_bit_buffer >>= 32;
+            m_bit_count -= 32;
+        }
+        return {};
+    }
+
+    ErrorOr<void> finish()
+    {
+        TRY(write_bits(1, 1));
+        for (; m_bit_count > 0; m_bit_count -= min<size_t>(m_bit_count, 8)) {
+            TRY(m_output.try_append(static_cast<u8>(m_bit_buffer)));
+            m_bit_buffer >>= 8;
+        }
+        return {};
+    }
+
+private:
+    ByteBuffer& m_output;
+    u64 m_bit_buffer { 0 };
+    size_t m_bit_count { 0 };
+};
+
+// The encoding counterpart of build_fse_table(), this spreads the symbols in the same way.
+class FseEncoder {
+public:
+    static ErrorOr<FseEncoder> create(ReadonlySpan<i16> distribution, u8 accuracy_log)
+    {
+        size_t table_size = 1u << accuracy_log;
+
+        FseEncoder encoder;
+        encoder.m_accuracy_log = accuracy_log;
+        TRY(encoder.m_states.try_resize(table_size));
+        TRY(encoder.m_symbols.try_resize(distribution.size()));
+
+        Vector<u8, 512> spread_symbols;
+        TRY(spread_symbols.try_resize(table_size));
+        Vector<u32, 64> cumulative_counts;
+        TRY(cumulative_counts.try_resize(distribution.size() + 1));
+
+        ssize_t high_threshold = table_size - 1;
+        for (size_t symbol = 0; symbol < distribution.size(); ++symbol) {
+            if (distribution[symbol] == -1) {
+                cumulative_counts[symbol + 1] = cumulative_counts[symbol] + 1;
+                spread_symbols[high_threshold--] = symbol;
+            } else {
+                cumulative_counts[symbol + 1] = cumulative_counts[symbol] + distribution[symbol];
+            }
+        }
+
+        size_t position = 0;
+        size_t step = (table_size >> 1) + (table_size >> 3) + 3;
+        size_t mask = table_size - 1;
+        for (size_t symbol = 0; symbol < distribution.size(); ++symbol) {
+            for (i16 i = 0; i < distribution[symbol]; ++i) {
+                spread_symbols[position] = symbol;
+                do {
+                    position = (position + step) & mask;
+                } while (static_cast<ssize_t>(position) > high_threshold);
+            }
+        }
+        VERIFY(position == 0);
+
+        // States are grouped by symbol, so that the next state can be found from the current one with a shift and an offset.
+        for (size_t state = 0; state < table_size; ++state)
+            encoder.m_states[cumulative_counts[spread_symbols[state]]++] = table_size + state;
+
+        i32 total = 0;
+        for (size_t symbol = 0; symbol < distribution.size(); ++symbol) {
+            auto probability = distribution[symbol];
+            auto& transform = encoder.m_symbols[symbol];
+            if (probability == 0)
+                continue;
+            if (probability == -1 || probability == 1) {
+                transform.delta_bit_count = (accuracy_log << 16) - table_size;
+                transform.delta_find_state = total - 1;
+                total++;
+                continue;
+            }
+            u32 max_bits_out = accuracy_log - highest_bit(probability - 1);
+            u32 min_state_plus = static_cast<u32>(probability) << max_bits_out;
+            transform.delta_bit_count = (max_bits_out << 16) - min_state_plus;
+            transform.delta_find_state = total - probability;
+            total += probability;
+        }
+
+        return encoder;
+    }
+
+    void start(u8 symbol)
+    {
+        auto const& transform = m_symbols[symbol];
+        u32 bit_count = (transform.delta_bit_count + (1 << 15)) >> 16;
+        u32 value = (bit_count << 16) - transform.delta_bit_count;
+        m_state = m_states[(value >> bit_count) + transform.delta_find_state];
+    }
+
+    ALWAYS_INLINE ErrorOr<void> encode(BitWriter& writer, u8 symbol)
+    {
+        auto const& transform = m_symbols[symbol];
+        u32 bit_count = (m_state + transform.delta_bit_count) >> 16;
+        TRY(writer.write_bits(m_state, bit_count));
+        m_state = m_states[(m_state >> bit_count) + transform.delta_find_state];
+        return {};
+    }
+
+    ErrorOr<void> finish(BitWriter& writer)
+    {
+        return writer.write_bits(m_state, m_accuracy_log);
+    }
+
+private:
+    struct SymbolTransform {
+        u32 delta_bit_count { 0 };
+        i32 delta_find_state { 0 };
+    };
+
+    FseEncoder() = default;
+
+    u8 m_accuracy_log { 0 };
+    u32 m_state { 0 };
+    Vector<u16> m_states;
+    Vector<SymbolTransform> m_symbols;
+};
+
+static u8 literal_length_code(u32 literal_length)
+{
+    if (literal_length < 16)
+        return literal_length;
+    u8 code = max_literal_length_code;
+    while (literal_length_baselines[code] > literal_length)
+        code--;
+    return code;
+}
+
+static u8 match_length_code(u32 match_length)
+{
+    if (match_length < 35)
+        return match_length - 3;
+    u8 code = max_match_length_code;
+    while (match_length_baselines[code] > match_length)
+        code--;
+    return code;
+}
+
+static void write_literals_header(ByteBuffer& output, u8 literals_block_type, size_t size)
+{
+    if (size < 32) {
+        output.append(static_cast<u8>(literals_block_type | (size << 3)));
+    } else if (size < 4096) {
+        output.append(static_cast<u8>(literals_block_type | (1 << 2) | ((size & 0xf) << 4)));
+        output.append(static_cast<u8>(size >> 4));
+    } else {
+        output.append(static_cast<u8>(literals_block_type | (3 << 2) | ((size & 0xf) << 4)));
+        output.append(static_cast<u8>(size >> 4));
+        output.append(static_cast<u8>(size >> 12));
+    }
+}
+
+// Returns false if Huffman coding doesn't beat storing the literals as they are.
+static ErrorOr<bool> encode_huffman_literals(ReadonlyBytes literals, ByteBuffer& output)
+{
+    Array<u32, 256> counts {};
+    for (auto byte : literals)
+        counts[byte]++;
+
+    size_t max_symbol = 255;
+    while (counts[max_symbol] == 0)
+        max_symbol--;
+
+    // The weights of the symbols before the last one are stored as 4-bit values, which only works for up to 128 of them.
+    // FIXME: Compress the weights with FSE to also allow for larger alphabets.
+    if (max_symbol > max_direct_huffman_weight_count)
+        return false;
+
+    Array<u16, max_direct_huffman_weight_count + 1> frequencies {};
+    u8 shift = literals.size() > NumericLimits<u16>::max() ? 1 : 0;
+    for (size_t symbol = 0; symbol <= max_symbol; ++symbol) {
+        if (counts[symbol] != 0)
+            frequencies[symbol] = max(1u, counts[symbol] >> shift);
+    }
+
+    Array<u8, max_direct_huffman_weight_count + 1> lengths {};
+    generate_huffman_lengths(lengths.span().trim(max_symbol + 1), frequencies.span().trim(max_symbol + 1), max_huffman_bit_count);
+
+    u8 max_bit_count = 0;
+    for (auto length : lengths)
+        max_bit_count = max(max_bit_count, length);
+
+    Array<u8, max_direct_huffman_weight_count + 1> weights {};
+    for (size_t symbol = 0; symbol <= max_symbol; ++symbol)
+        weights[symbol] = lengths[symbol] == 0 ? 0 : max_bit_count + 1 - lengths[symbol];
+
+    // This mirrors the symbol order of build_huffman_table().
+    Array<u16, max_direct_huffman_weight_count + 1> codes {};
+    size_t position = 0;
+    for (u8 weight = 1; weight <= max_bit_count; ++weight) {
+        for (size_t symbol = 0; symbol <= max_symbol; ++symbol) {
+            if (weights[symbol] != weight)
+                continue;
+            codes[symbol] = position >> (weight - 1);
+            position += 1u << (weight - 1);
+        }
+    }
+
+    ByteBuffer compressed;
+    TRY(compressed.try_append(static_cast<u8>(127 + max_symbol)));
+    for (size_t symbol = 0; symbol < max_symbol; symbol += 2)
+        TRY(compressed.try_append(static_cast<u8>((weights[symbol] << 4) | (symbol + 1 < max_symbol ? weights[symbol + 1] : 0))));
+
+    // The streams are read backward, so the symbols are written starting from the last one.
+    auto encode_stream = [&](ReadonlyBytes stream_literals) -> ErrorOr<void> {
+        BitWriter writer { compressed };
+        for (size_t i = stream_literals.size(); i > 0; --i) {
+            auto symbol = stream_literals[i - 1];
+            TRY(writer.write_bits(codes[symbol], lengths[symbol]));
+        }
+        return writer.finish();
+    };
+
+    u8 size_format;
+    if (literals.size() < 1024) {
+        size_format = 0;
+        TRY(encode_stream(literals));
+    } else {
+        size_t jump_table_offset = compressed.size();
+        TRY(compressed.try_resize(jump_table_offset + 6));
+
+        size_t segment_size = (literals.size() + 3) / 4;
+        for (size_t i = 0; i < 4; ++i) {
+            size_t stream_start = compressed.size();
+            TRY(encode_stream(literals.slice(i * segment_size, i == 3 ? literals.size() - 3 * segment_size : segment_size)));
+            size_t stream_size = compressed.size() - stream_start;
+            if (i < 3) {
+                if (stream_size > NumericLimits<u16>::max())
+                    return false;
+                compressed[jump_table_offset + i * 2] = stream_size & 0xff;
+                compressed[jump_table_offset + i * 2 + 1] = stream_size >> 8;
+            }
+        }
+
+        size_format = max(literals.size(), compressed.size()) < 16384 ? 2 : 3;
+    }
+
+    static constexpr Array<u8, 4> header_sizes { 3, 3, 4, 5 };
+    static constexpr Array<u8, 4> size_bit_counts { 10, 10, 14, 18 };
+
+    if (compressed.size() >= (1u << size_bit_counts[size_format]))
+        return false;
+    if (header_sizes[size_format] + compressed.size() >= literals.size())
+        return false;
+
+    u64 header = 2 | (size_format << 2) | (literals.size() << 4) | (static_cast<u64>(compressed.size()) << (4 + size_bit_counts[size_format]));
+    for (size_t i = 0; i < header_sizes[size_format]; ++i)
+        TRY(output.try_append(static_cast<u8>(header >> (i * 8))));
+    TRY(output.try_append(compressed));
+    return true;
+}
+
+}
+
+ErrorOr<NonnullOwnPtr<ZstdCompressor>> ZstdCompressor::construct(MaybeOwned<Stream> stream)
+{
+    auto history = TRY(ByteBuffer::create_uninitialized(2 * window_size));
+
+    Vector<u32> hash_head;
+    TRY(hash_head.try_resize(1 << hash_bits));
+    Vector<u32> hash_chain;
+    TRY(hash_chain.try_resize(window_size));
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) ZstdCompressor(move(stream), move(history), move(hash_head), move(hash_chain)));
+}
+
+ZstdCompressor::ZstdCompressor(MaybeOwned<Stream> stream, ByteBuffer history, Vector<u32> hash_head, Vector<u32> hash_chain)
+    : m_output_stream(move(stream))
+    , m_history(move(history))
+    , m_hash_head(move(hash_head))
+    , m_hash_chain(move(hash_chain))
+{
+}
+
+ZstdCompressor::~ZstdCompressor()
+{
+    if (!m_finished) {
+        // Note: We need a better API for specifying things like this.
+        final_flush().release_value_but_fixme_should_propagate_errors();
+    }
+}
+
+ErrorOr<ByteBuffer> ZstdCompressor::compress_all(ReadonlyBytes bytes)
+{
+    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+    auto zstd_stream = TRY(ZstdCompressor::construct(MaybeOwned<Stream>(*output_stream)));
+
+    TRY(zstd_stream->write_until_depleted(bytes));
+    TRY(zstd_stream->final_flush());
+
+    return output_stream->read_until_eof();
+}
+
+ErrorOr<Bytes> ZstdCompressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> ZstdCompressor::write_some(ReadonlyBytes bytes)
+{
+    VERIFY(!m_finished);
+
+    auto block_end = m_block_start + Zstd::max_block_size;
+    auto count = min(bytes.size(), block_end - m_history_size);
+    bytes.trim(count).copy_to(m_history.span().slice(m_history_size));
+    m_history_size += count;
+    m_checksum.update(bytes.trim(count));
+
+    if (m_history_size == block_end)
+        TRY(compress_block(false));
+
+    return count;
+}
+
+bool ZstdCompressor::is_eof() const
+{
+    return true;
+}
+
+bool ZstdCompressor::is_open() const
+{
+    return m_output_stream->is_open();
+}
+
+void ZstdCompressor::close()
+{
+}
+
+ErrorOr<void> ZstdCompressor::final_flush()
+{
+    VERIFY(!m_finished);
+    m_finished = true;
+
+    TRY(compress_block(true));
+
+    // 3.1.1. Content_Checksum
+    TRY(m_output_stream->write_value<LittleEndian<u32>>(static_cast<u32>(m_checksum.digest())));
+    return {};
+}
+
+static ALWAYS_INLINE u32 hash_at(u8 const* data)
+{
+    u32 value;
+    ByteReader::load(data, value);
+    return (value * 2654435761u) >> (32 - ZstdCompressor::hash_bits);
+}
+
+void ZstdCompressor::insert_hash(size_t position)
+{
+    auto hash = hash_at(m_history.offset_pointer(position));
+    m_hash_chain[position & (window_size - 1)] = m_hash_head[hash];
+    m_hash_head[hash] = position + 1;
+}
+
+ZstdCompressor::Match ZstdCompressor::find_match(size_t position, size_t end) const
+{
+    Match best { 0, 0 };
+    size_t max_length = end - position;
+    if (max_length < min_match_length)
+        return best;
+
+    auto const* data = m_history.data();
+    auto match_length_at = [&](size_t candidate) {
+        size_t length = 0;
+        while (length < max_length && data[candidate + length] == data[position + length])
+            length++;
+        return length;
+    };
+
+    // The most recent offset is the cheapest one to encode, so it is tried first and wins ties.
+    auto repeated_offset = m_repeated_offsets[0];
+    if (repeated_offset <= position) {
+        auto length = match_length_at(position - repeated_offset);
+        if (length >= min_match_length)
+            best = { length, repeated_offset };
+    }
+
+    size_t candidate_plus_one = m_hash_head[hash_at(data + position)];
+    for (size_t chain = 0; candidate_plus_one != 0 && chain < max_chain_length && best.length < max_length; ++chain) {
+        auto candidate = candidate_plus_one - 1;
+        auto distance = position - candidate;
+        if (distance > window_size)
+            break;
+
+        if (data[candidate + best.length] == data[position + best.length]) {
+            auto length = match_length_at(candidate);
+            if (length > best.length && length >= min_match_length)
+                best = { length, distance };
+        }
+
+        candidate_plus_one = m_hash_chain[candidate & (window_size - 1)];
+    }
+
+    return best;
+}
+
+void ZstdCompressor::find_sequences(size_t block_start, size_t block_end)
+{
+    m_literals.clear_with_capacity();
+    m_sequences.clear_with_capacity();
+
+    auto add_sequence = [&](size_t literal_start, size_t position, Match match) {
+        u32 literal_length = position - literal_start;
+        m_literals.extend(m_history.span().slice(literal_start, literal_length));
+
+        // 3.1.1.5. Repeat offsets: Pick the cheapest offset value that resolves to the match's offset.
+        u32 offset = match.offset;
+        u32 offset_value = offset + 3;
+        if (literal_length != 0) {
+            for (u32 i = 0; i < 3; ++i) {
+                if (m_repeated_offsets[i] == offset) {
+                    offset_value = i + 1;
+                    break;
+                }
+            }
+        } else if (offset == m_repeated_offsets[1]) {
+            offset_value = 1;
+        } else if (offset == m_repeated_offsets[2]) {
+            offset_value = 2;
+        } else if (offset == m_repeated_offsets[0] - 1) {
+            offset_value = 3;
+        }
+        MUST(Zstd::resolve_offset(m_repeated_offsets, offset_value, literal_length));
+
+        m_sequences.append({ literal_length, static_cast<u32>(match.length), offset_value });
+    };
+
+    size_t literal_start = block_start;
+    size_t position = block_start;
+    while (position + min_match_length <= block_end) {
+        auto match = find_match(position, block_end);
+        insert_hash(position);
+        if (match.length == 0) {
+            position++;
+            continue;
+        }
+
+        // Lazy matching: Emit a literal instead if the match starting at the next byte is longer.
+        while (match.length < good_match_length && position + 1 + min_match_length <= block_end) {
+            auto next_match = find_match(position + 1, block_end);
+            if (next_match.length <= match.length)
+                break;
+            position++;
+            insert_hash(position);
+            match = next_match;
+        }
+
+        add_sequence(literal_start, position, match);
+
+        for (size_t i = 1; i < match.length && position + i + min_match_length <= block_end; ++i)
+            insert_hash(position + i);
+        position += match.length;
+        literal_start = position;
+    }
+
+    m_literals.extend(m_history.span().slice(literal_start, block_end - literal_start));
+}
+
+void ZstdCompressor::slide_window()
+{
+    // Since the window size is a power of two, moving the data by exactly that much keeps every position in its hash chain slot.
+    VERIFY(m_history_size >= window_size);
+    memmove(m_history.data(), m_history.offset_pointer(window_size), m_history_size - window_size);
+    m_history_size -= window_size;
+    m_block_start -= window_size;
+
+    for (auto& entry : m_hash_head)
+        entry = entry > window_size ? entry - window_size : 0;
+    for (auto& entry : m_hash_chain)
+        entry = entry > window_size ? entry - window_size : 0;
+}
+
+ErrorOr<void> ZstdCompressor::encode_literals_section(ByteBuffer& output)
+{
+    // 3.1.1.3.1. Literals_Section
+    auto literals = m_literals.span();
+
+    bool is_single_value = !literals.is_empty() && all_of(literals, [&](u8 byte) { return byte == literals[0]; });
+    if (is_single_value) {
+        Zstd::write_literals_header(output, 1, literals.size());
+        TRY(output.try_append(literals[0]));
+        return {};
+    }
+
+    if (literals.size() >= 32 && TRY(Zstd::encode_huffman_literals(literals, output)))
+        return {};
+
+    Zstd::write_literals_header(output, 0, literals.size());
+    TRY(output.try_append(literals));
+    return {};
+}
+
+ErrorOr<void> ZstdCompressor::encode_sequences_section(ByteBuffer& output)
+{
+    // 3.1.1.3.2.1. Sequences_Section_Header
+    size_t sequence_count = m_sequences.size();
+    if (sequence_count < 128) {
+        TRY(output.try_append(static_cast<u8>(sequence_count)));
+    } else if (sequence_count < 0x7F00) {
+        TRY(output.try_append(static_cast<u8>((sequence_count >> 8) + 128)));
+        TRY(output.try_append(static_cast<u8>(sequence_count)));
+    } else {
+        TRY(output.try_append(255));
+        TRY(output.try_append(static_cast<u8>(sequence_count - 0x7F00)));
+        TRY(output.try_append(static_cast<u8>((sequence_count - 0x7F00) >> 8)));
+    }
+
+    if (sequence_count == 0)
+        return {};
+
+    // FIXME: Describe custom distributions when they are worth it, we only use the predefined ones for now.
+    TRY(output.try_append(0));
+    auto literal_lengths_encoder = TRY(Zstd::FseEncoder::create(Zstd::default_literal_lengths_distribution, Zstd::default_literal_lengths_accuracy_log));
+    auto offsets_encoder = TRY(Zstd::FseEncoder::create(Zstd::default_offsets_distribution, Zstd::default_offsets_accuracy_log));
+    auto match_lengths_encoder = TRY(Zstd::FseEncoder::create(Zstd::default_match_lengths_distribution, Zstd::default_match_lengths_accuracy_log));
+
+    // The sequences are encoded in reverse, so that the decoder can read the bitstream backward and get them in order.
+    Zstd::BitWriter writer { output };
+    auto write_extra_bits = [&](Sequence const& sequence, u8 literal_length_code, u8 offset_code, u8 match_length_code) -> ErrorOr<void> {
+        TRY(writer.write_bits(sequence.literal_length - Zstd::literal_length_baselines[literal_length_code], Zstd::literal_length_extra_bits[literal_length_code]));
+        TRY(writer.write_bits(sequence.match_length - Zstd::match_length_baselines[match_length_code], Zstd::match_length_extra_bits[match_length_code]));
+        TRY(writer.write_bits(sequence.offset_value - (1u << offset_code), offset_code));
+        return {};
+    };
+
+    for (size_t i = sequence_count; i > 0; --i) {
+        auto const& sequence = m_sequences[i - 1];
+        auto literal_length_code = Zstd::literal_length_code(sequence.literal_length);
+        auto offset_code = static_cast<u8>(Zstd::highest_bit(sequence.offset_value));
+        auto match_length_code = Zstd::match_length_code(sequence.match_length);
+
+        if (i == sequence_count) {
+            match_lengths_encoder.start(match_length_code);
+            offsets_encoder.start(offset_code);
+            literal_lengths_encoder.start(literal_length_code);
+        } else {
+            TRY(offsets_encoder.encode(writer, offset_code));
+            TRY(match_lengths_encoder.encode(writer, match_length_code));
+            TRY(literal_lengths_encoder.encode(writer, literal_length_code));
+        }
+
+        TRY(write_extra_bits(sequence, literal_length_code, offset_code, match_length_code));
+    }
+
+    TRY(match_lengths_encoder.finish(writer));
+    TRY(offsets_encoder.finish(writer));
+    TRY(literal_lengths_encoder.finish(writer));
+    return writer.finish();
+}
+
+ErrorOr<void> ZstdCompressor::write_block(bool is_last_block, u8 block_type, size_t block_size, ReadonlyBytes data)
+{
+    // 3.1.1.2. Block_Header
+    u32 header = (is_last_block ? 1 : 0) | (block_type << 1) | (block_size << 3);
+    u8 header_bytes[3] = { static_cast<u8>(header), static_cast<u8>(header >> 8), static_cast<u8>(header >> 16) };
+    TRY(m_output_stream->write_until_depleted({ header_bytes, sizeof(header_bytes) }));
+    TRY(m_output_stream->write_until_depleted(data));
+    return {};
+}
+
+ErrorOr<void> ZstdCompressor::compress_block(bool is_last_block)
+{
+    if (!m_wrote_frame_header) {
+        // 3.1.1.1. Frame_Header: We don't know the content size in advance, but we always include a checksum.
+        TRY(m_output_stream->write_value<LittleEndian<u32>>(Zstd::frame_magic_number));
+        u8 descriptor = 1 << 2;
+        u8 window_descriptor = (window_log - 10) << 3;
+        TRY(m_output_stream->write_value<u8>(descriptor));
+        TRY(m_output_stream->write_value<u8>(window_descriptor));
+        m_wrote_frame_header = true;
+    }
+
+    auto block = m_history.span().slice(m_block_start, m_history_size - m_block_start);
+
+    // Raw and RLE blocks don't affect the repeated offsets, so we have to restore them if we end up using one.
+    auto repeated_offsets = m_repeated_offsets;
+    find_sequences(m_block_start, m_history_size);
+
+    if (block.size() > 1 && all_of(block, [&](u8 byte) { return byte == block[0]; })) {
+        m_repeated_offsets = repeated_offsets;
+        TRY(write_block(is_last_block, 1, block.size(), block.trim(1)));
+    } else {
+        ByteBuffer compressed;
+        TRY(encode_literals_section(compressed));
+        TRY(encode_sequences_section(compressed));
+
+        if (compressed.size() < block.size()) {
+            TRY(write_block(is_last_block, 2, compressed.size(), compressed));
+        } else {
+            m_repeated_offsets = repeated_offsets;
+            TRY(write_block(is_last_block, 0, block.size(), block));
+        }
+    }
+
+    m_block_start = m_history_size;
+    if (m_history_size + Zstd::max_block_size > m_history.size())
+        slide_window();
+
+    return {};
+}
+
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/ByteBuffer.h>
+#include <AK/CircularBuffer.h>
+#include <AK/Error.h>
+#include <AK/MaybeOwned.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Stream.h>
+#include <AK/Vector.h>
+#include <LibCrypto/Checksum/XXHash64.h>
+
+namespace Compress {
+
+// This implementation is based on RFC 8878, "Zstandard Compression and the 'application/zstd' Media Type":
+// https://datatracker.ietf.org/doc/html/rfc8878
+
+namespace Zstd {
+
+// 3.1.1. Zstandard Frames
+static constexpr u32 frame_magic_number = 0xFD2FB528;
+// 3.1.2. Skippable Frames
+static constexpr u32 skippable_frame_magic_number = 0x184D2A50;
+static constexpr u32 skippable_frame_magic_number_mask = 0xFFFFFFF0;
+
+// 3.1.1.2. Blocks
+static constexpr size_t max_block_size = 128 * KiB;
+
+// 3.1.1.5. Sequence Execution
+using RepeatedOffsets = Array<u32, 3>;
+static constexpr RepeatedOffsets initial_repeated_offsets { 1, 4, 8 };
+
+// 4.1. FSE
+struct FseTable {
+    struct Entry {
+        u16 base;
+        u8 symbol;
+        u8 bit_count;
+    };
+
+    u8 accuracy_log { 0 };
+    Vector<Entry> entries;
+};
+
+// 4.2. Huffman Coding
+struct HuffmanTable {
+    struct Entry {
+        u8 symbol;
+        u8 bit_count;
+    };
+
+    u8 max_bit_count { 0 };
+    Vector<Entry> entries;
+};
+
+}
+
+class ZstdDecompressor final : public Stream {
+public:
+    // This is the default limit of the reference implementation, larger windows have to be explicitly allowed there too.
+    static constexpr size_t max_window_size = 128 * MiB;
+
+    static ErrorOr<NonnullOwnPtr<ZstdDecompressor>> construct(MaybeOwned<Stream>);
+
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+private:
+    enum class State {
+        FrameHeader,
+        Blocks,
+        FrameFooter,
+        Finished,
+    };
+
+    ZstdDecompressor(MaybeOwned<Stream>);
+
+    ErrorOr<void> read_frame_header();
+    ErrorOr<void> read_frame_footer();
+    ErrorOr<void> decode_block();
+    ErrorOr<void> decode_compressed_block(ReadonlyBytes);
+    ErrorOr<size_t> decode_literals_section(ReadonlyBytes);
+    ErrorOr<size_t> read_huffman_table(ReadonlyBytes);
+    ErrorOr<void> decode_sequences_section(ReadonlyBytes);
+    ErrorOr<void> write_to_window(ReadonlyBytes);
+
+    MaybeOwned<Stream> m_stream;
+    State m_state { State::FrameHeader };
+
+    Optional<CircularBuffer> m_window;
+    size_t m_block_maximum_size { 0 };
+    ByteBuffer m_block_buffer;
+    Vector<u8> m_literals;
+    size_t m_literals_offset { 0 };
+
+    Optional<u64> m_frame_content_size;
+    u64 m_frame_decoded_size { 0 };
+    Optional<Crypto::Checksum::XXHash64> m_checksum;
+
+    // These are carried over from one block to the next within the same frame.
+    Optional<Zstd::HuffmanTable> m_huffman_table;
+    Optional<Zstd::FseTable> m_literal_lengths_table;
+    Optional<Zstd::FseTable> m_offsets_table;
+    Optional<Zstd::FseTable> m_match_lengths_table;
+    Zstd::RepeatedOffsets m_repeated_offsets { Zstd::initial_repeated_offsets };
+};
+
+class ZstdCompressor final : public Stream {
+public:
+    static constexpr size_t window_log = 20;
+    static constexpr size_t window_size = 1 << window_log;
+    static constexpr size_t hash_bits = 16;
+    static constexpr size_t min_match_length = 4;
+    static constexpr size_t max_chain_length = 64;
+    static constexpr size_t good_match_length = 64; // matches at least this long are taken without looking for a better one at the next byte
+
+    static ErrorOr<NonnullOwnPtr<ZstdCompressor>> construct(MaybeOwned<Stream>);
+    ~ZstdCompressor();
+
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes);
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+    ErrorOr<void> final_flush();
+
+private:
+    struct Sequence {
+        u32 literal_length;
+        u32 match_length;
+        u32 offset_value;
+    };
+
+    struct Match {
+        size_t length;
+        size_t offset;
+    };
+
+    ZstdCompressor(MaybeOwned<Stream>, ByteBuffer history, Vector<u32> hash_head, Vector<u32> hash_chain);
+
+    ErrorOr<void> compress_block(bool is_last_block);
+    ErrorOr<void> write_block(bool is_last_block, u8 block_type, size_t block_size, ReadonlyBytes data);
+    void find_sequences(size_t block_start, size_t block_end);
+    Match find_match(size_t position, size_t end) const;
+    void insert_hash(size_t position);
+    void slide_window();
+    ErrorOr<void> encode_literals_section(ByteBuffer& output);
+    ErrorOr<void> encode_sequences_section(ByteBuffer& output);
+
+    MaybeOwned<Stream> m_output_stream;
+    bool m_finished { false };
+    bool m_wrote_frame_header { false };
+
+    // This holds up to a window worth of already compressed data, followed by the data of the block that is being assembled.
+    ByteBuffer m_history;
+    size_t m_history_size { 0 };
+    size_t m_block_start { 0 };
+
+    Vector<u32> m_hash_head;
+    Vector<u32> m_hash_chain;
+
+    Vector<u8> m_literals;
+    Vector<Sequence> m_sequences;
+    Zstd::RepeatedOffsets m_repeated_offsets { Zstd::initial_repeated_offsets };
+
+    Crypto::Checksum::XXHash64 m_checksum;
+};
+
+}
@@ -4,19 +4,28 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/CPUFeatures.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/Adler32.h>
 
 namespace Crypto::Checksum {
 
-void Adler32::update(ReadonlyBytes data)
+static constexpr u32 modulus = 65521;
+
+template<CPUFeatures>
+static void update_adler32(u32& state_a, u32& state_b, ReadonlyBytes data);
+
+template<>
+void update_adler32<CPUFeatures::None>(u32& result_a, u32& result_b, ReadonlyBytes data)
 {
     // See https://github.com/SerenityOS/serenity/pull/24408#discussion_r1609051678
     constexpr size_t iterations_without_overflow = 380368439;
 
-    u64 state_a = m_state_a;
-    u64 state_b = m_state_b;
+    u64 state_a = result_a;
+    u64 state_b = result_b;
     while (data.size()) {
         // You can verify that no overflow will happen here during at least
         // `iterations_without_overflow` iterations using the following Python script:
@@ -32,12 +41,74 @@ void Adler32::update(ReadonlyBytes data)
             state_a += byte;
             state_b += state_a;
         }
-        state_a %= 65521;
-        state_b %= 65521;
+        state_a %= modulus;
+        state_b %= modulus;
         data = data.slice(chunk.size());
     }
-    m_state_a = state_a;
-    m_state_b = state_b;
+    result_a = state_a;
+    result_b = state_b;
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+// This processes 32 bytes at a time, like the SSSE3 implementation in Chromium's zlib: `a` is simply the sum of all bytes,
+// while each byte is added to `b` once for every byte from its own position to the end of the block. Every block also adds
+// 32 times the preceding value of `a` to `b`, these are summed separately and multiplied at the end.
+template<>
+[[gnu::target("avx2")]] void update_adler32<CPUFeatures::X86_AVX2>(u32& state_a, u32& state_b, ReadonlyBytes data)
+{
+    using namespace AK::SIMD;
+
+    constexpr size_t block_size = 32;
+    // zlib's NMAX, the largest number of bytes after which `b` still fits into 32 bits before it has to be reduced.
+    constexpr size_t max_blocks_between_reductions = 5552 / block_size;
+
+    static constexpr i8x32 weights { 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+    static constexpr i16x16 ones { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+    auto horizontal_sum = [](u32x8 const& vector) {
+        u32 sum = 0;
+        for (size_t i = 0; i < 8; ++i)
+            sum += vector[i];
+        return sum;
+    };
+
+    while (data.size() >= block_size) {
+        size_t block_count = min(data.size() / block_size, max_blocks_between_reductions);
+
+        u32x8 previous_a_sum { state_a * static_cast<u32>(block_count) };
+        u32x8 vector_a {};
+        u32x8 vector_b { state_b };
+
+        for (size_t i = 0; i < block_count; ++i) {
+            auto bytes = bit_cast<c8x32>(load_unaligned<u8x32>(data.offset_pointer(i * block_size)));
+
+            previous_a_sum += vector_a;
+            vector_a += bit_cast<u32x8>(__builtin_ia32_psadbw256(bytes, c8x32 {}));
+            auto weighted_pairs = __builtin_ia32_pmaddubsw256(bytes, bit_cast<c8x32>(weights));
+            vector_b += bit_cast<u32x8>(__builtin_ia32_pmaddwd256(weighted_pairs, ones));
+        }
+
+        vector_b += previous_a_sum * block_size;
+        state_a = (state_a + horizontal_sum(vector_a)) % modulus;
+        state_b = horizontal_sum(vector_b) % modulus;
+        data = data.slice(block_count * block_size);
+    }
+
+    update_adler32<CPUFeatures::None>(state_a, state_b, data);
+}
+#endif
+
+void Adler32::update(ReadonlyBytes data)
+{
+    static auto const implementation = [] {
+        if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+            if (has_flag(detect_cpu_features(), CPUFeatures::X86_AVX2))
+                return &update_adler32<CPUFeatures::X86_AVX2>;
+        }
+        return &update_adler32<CPUFeatures::None>;
+    }();
+
+    implementation(m_state_a, m_state_b, data);
 }
 
 u32 Adler32::digest()
@@ -45,4 +116,19 @@ u32 Adler32::digest()
     return (m_state_b << 16) | m_state_a;
 }
 
+u32 Adler32::combine(u32 first_digest, u32 second_digest, u64 second_length)
+{
+    // This is the same approach as zlib's adler32_combine(): The second input's `a` sum simply continues on from the
+    // first one's, while every byte of the second input adds the first input's `a` to `b` once more.
+    u64 remainder = second_length % modulus;
+    u64 first_a = first_digest & 0xffff;
+    u64 first_b = first_digest >> 16;
+    u64 second_a = second_digest & 0xffff;
+    u64 second_b = second_digest >> 16;
+
+    u64 state_a = (first_a + second_a + modulus - 1) % modulus;
+    u64 state_b = (remainder * first_a + first_b + second_b + modulus - remainder) % modulus;
+    return (state_b << 16) | state_a;
+}
+
 }
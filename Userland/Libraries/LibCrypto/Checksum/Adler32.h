@@ -30,6 +30,9 @@ public:
     virtual void update(ReadonlyBytes data) override;
     virtual u32 digest() override;
 
+    // Returns the Adler-32 of the concatenation of two inputs, given their digests and the length of the second one.
+    static u32 combine(u32 first_digest, u32 second_digest, u64 second_length);
+
 private:
     u32 m_state_a { 1 };
     u32 m_state_b { 0 };
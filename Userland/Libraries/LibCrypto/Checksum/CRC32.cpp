@@ -5,7 +5,12 @@
  */
 
 #include <AK/Array.h>
+#include <AK/ByteReader.h>
+#include <AK/CPUFeatures.h>
+#include <AK/Endian.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/CRC32.h>
@@ -16,56 +21,70 @@
 
 namespace Crypto::Checksum {
 
+static constexpr u32 ethernet_polynomial = 0xEDB88320;
+
 #if defined(__ARM_ACLE) && __ARM_ARCH >= 8 && defined(__ARM_FEATURE_CRC32)
-void CRC32::update(ReadonlyBytes span)
+// FIXME: Does this require runtime checking on rpi?
+//        (Maybe the instruction is present on the rpi4 but not on the rpi3?)
+template<typename UpdateByte, typename UpdateWord>
+static u32 update_with_crc_instructions(u32 state, ReadonlyBytes span, UpdateByte update_byte, UpdateWord update_word)
 {
-    // FIXME: Does this require runtime checking on rpi?
-    //        (Maybe the instruction is present on the rpi4 but not on the rpi3?)
-
     u8 const* data = span.data();
     size_t size = span.size();
 
     while (size > 0 && (reinterpret_cast<FlatPtr>(data) & 7) != 0) {
-        m_state = __crc32b(m_state, *data);
+        state = update_byte(state, *data);
         ++data;
         --size;
     }
 
     auto* data64 = reinterpret_cast<u64 const*>(data);
     while (size >= 8) {
-        m_state = __crc32d(m_state, *data64);
+        state = update_word(state, *data64);
         ++data64;
         size -= 8;
     }
 
     data = reinterpret_cast<u8 const*>(data64);
     while (size > 0) {
-        m_state = __crc32b(m_state, *data);
+        state = update_byte(state, *data);
         ++data;
         --size;
     }
+
+    return state;
+}
+
+void CRC32::update(ReadonlyBytes data)
+{
+    m_state = update_with_crc_instructions(
+        m_state, data, [](u32 state, u8 byte) { return __crc32b(state, byte); }, [](u32 state, u64 word) { return __crc32d(state, word); });
 }
 
-// FIXME: On Intel, use _mm_crc32_u8 / _mm_crc32_u64 if available (SSE 4.2).
+void CRC32C::update(ReadonlyBytes data)
+{
+    m_state = update_with_crc_instructions(
+        m_state, data, [](u32 state, u8 byte) { return __crc32cb(state, byte); }, [](u32 state, u64 word) { return __crc32cd(state, word); });
+}
 
 #else
 
-static constexpr size_t ethernet_polynomial = 0xEDB88320;
+static constexpr u32 castagnoli_polynomial = 0x82F63B78;
 
-#    if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+using SlicingTable = Array<Array<u32, 256>, 8>;
 
 // This implements Intel's slicing-by-8 algorithm. Their original paper is no longer on their website,
 // but their source code is still available for reference:
 // https://sourceforge.net/projects/slicing-by-8/
-static constexpr auto generate_table()
+static constexpr SlicingTable generate_table(u32 polynomial)
 {
-    Array<Array<u32, 256>, 8> data {};
+    SlicingTable data {};
 
     for (u32 i = 0; i < 256; ++i) {
         auto value = i;
 
         for (size_t j = 0; j < 8; ++j)
-            value = (value >> 1) ^ ((value & 1) * ethernet_polynomial);
+            value = (value >> 1) ^ ((value & 1) * polynomial);
 
         data[0][i] = value;
     }
@@ -78,95 +97,173 @@ static constexpr auto generate_table()
     return data;
 }
 
-static constexpr auto table = generate_table();
-
-struct AlignmentData {
-    ReadonlyBytes misaligned;
-    ReadonlyBytes aligned;
-};
+static constexpr auto ethernet_table = generate_table(ethernet_polynomial);
+static constexpr auto castagnoli_table = generate_table(castagnoli_polynomial);
 
-static AlignmentData split_bytes_for_alignment(ReadonlyBytes data, size_t alignment)
+static u32 update_slicing_by_8(SlicingTable const& table, u32 state, ReadonlyBytes data)
 {
-    auto address = reinterpret_cast<uintptr_t>(data.data());
-    auto offset = alignment - address % alignment;
+    // The input is read as little endian words, which makes the tables work regardless of the host byte order.
+    while (data.size() >= 8) {
+        auto low = AK::convert_between_host_and_little_endian(ByteReader::load32(data.data())) ^ state;
+        auto high = AK::convert_between_host_and_little_endian(ByteReader::load32(data.data() + 4));
 
-    if (offset == alignment)
-        return { {}, data };
+        state = table[0][(high >> 24) & 0xff]
+            ^ table[1][(high >> 16) & 0xff]
+            ^ table[2][(high >> 8) & 0xff]
+            ^ table[3][high & 0xff]
+            ^ table[4][(low >> 24) & 0xff]
+            ^ table[5][(low >> 16) & 0xff]
+            ^ table[6][(low >> 8) & 0xff]
+            ^ table[7][low & 0xff];
 
-    if (data.size() < alignment)
-        return { data, {} };
+        data = data.slice(8);
+    }
 
-    return { data.trim(offset), data.slice(offset) };
+    for (auto byte : data)
+        state = (state >> 8) ^ table[0][(state & 0xff) ^ byte];
+
+    return state;
 }
 
-static constexpr u32 single_byte_crc(u32 crc, u8 byte)
+template<CPUFeatures>
+static u32 update_crc32(u32 state, ReadonlyBytes data);
+
+template<CPUFeatures>
+static u32 update_crc32c(u32 state, ReadonlyBytes data);
+
+template<>
+u32 update_crc32<CPUFeatures::None>(u32 state, ReadonlyBytes data)
 {
-    return (crc >> 8) ^ table[0][(crc & 0xff) ^ byte];
+    return update_slicing_by_8(ethernet_table, state, data);
 }
 
-void CRC32::update(ReadonlyBytes data)
+template<>
+u32 update_crc32c<CPUFeatures::None>(u32 state, ReadonlyBytes data)
 {
-    // The provided data may not be aligned to a 4-byte boundary, required to reinterpret its address
-    // into a u32 in the loop below. So we split the bytes into two segments: the misaligned bytes
-    // (which undergo the standard 1-byte-at-a-time algorithm) and remaining aligned bytes.
-    auto [misaligned_data, aligned_data] = split_bytes_for_alignment(data, alignof(u32));
+    return update_slicing_by_8(castagnoli_table, state, data);
+}
 
-    for (auto byte : misaligned_data)
-        m_state = single_byte_crc(m_state, byte);
+#    if AK_CAN_CODEGEN_FOR_X86_PCLMUL
+using AK::SIMD::u32x4, AK::SIMD::u64x2;
 
-    while (aligned_data.size() >= 8) {
-        auto const* segment = reinterpret_cast<u32 const*>(aligned_data.data());
-        auto low = *segment ^ m_state;
-        auto high = *(++segment);
+template<u8 selector>
+[[gnu::target("pclmul"), gnu::always_inline]] static inline u64x2 carryless_multiply(u64x2 a, u64x2 b)
+{
+    using illx2 = signed long long int __attribute__((vector_size(16)));
+    return bit_cast<u64x2>(__builtin_ia32_pclmulqdq128(bit_cast<illx2>(a), bit_cast<illx2>(b), selector));
+}
 
-        m_state = table[0][(high >> 24) & 0xff]
-            ^ table[1][(high >> 16) & 0xff]
-            ^ table[2][(high >> 8) & 0xff]
-            ^ table[3][high & 0xff]
-            ^ table[4][(low >> 24) & 0xff]
-            ^ table[5][(low >> 16) & 0xff]
-            ^ table[6][(low >> 8) & 0xff]
-            ^ table[7][low & 0xff];
+// Multiplies both halves of `value` by the matching constant and adds them to `next`, which moves the CRC state 128 bits forward.
+[[gnu::target("pclmul"), gnu::always_inline]] static inline u64x2 fold(u64x2 value, u64x2 constants, u64x2 next)
+{
+    return carryless_multiply<0x00>(value, constants) ^ carryless_multiply<0x11>(value, constants) ^ next;
+}
 
-        aligned_data = aligned_data.slice(8);
+// This folds 64 bytes at a time with carry-less multiplications, see Intel's "Fast CRC Computation for Generic Polynomials
+// Using PCLMULQDQ Instruction". The constants are powers of x modulo the bit-reflected polynomial, and are the same ones
+// used by Linux and zlib.
+template<>
+[[gnu::target("pclmul")]] u32 update_crc32<CPUFeatures::X86_PCLMUL>(u32 state, ReadonlyBytes data)
+{
+    if (data.size() < 64)
+        return update_crc32<CPUFeatures::None>(state, data);
+
+    static constexpr u64x2 k1k2 { 0x0154442bd4, 0x01c6e41596 };
+    static constexpr u64x2 k3k4 { 0x01751997d0, 0x00ccaa009e };
+    static constexpr u64x2 k5k0 { 0x0163cd6124, 0x0000000000 };
+    static constexpr u64x2 polynomial { 0x01db710641, 0x01f7011641 };
+    static constexpr u64x2 low_words_mask { 0xffffffff, 0xffffffff };
+
+    auto load = [&](size_t offset) { return AK::SIMD::load_unaligned<u64x2>(data.offset_pointer(offset)); };
+
+    auto x1 = load(0x00) ^ u64x2 { state, 0 };
+    auto x2 = load(0x10);
+    auto x3 = load(0x20);
+    auto x4 = load(0x30);
+    data = data.slice(64);
+
+    while (data.size() >= 64) {
+        x1 = fold(x1, k1k2, load(0x00));
+        x2 = fold(x2, k1k2, load(0x10));
+        x3 = fold(x3, k1k2, load(0x20));
+        x4 = fold(x4, k1k2, load(0x30));
+        data = data.slice(64);
     }
 
-    for (auto byte : aligned_data)
-        m_state = single_byte_crc(m_state, byte);
-}
+    // Fold the four lanes into a single one, followed by any remaining 16-byte blocks.
+    x1 = fold(x1, k3k4, x2);
+    x1 = fold(x1, k3k4, x3);
+    x1 = fold(x1, k3k4, x4);
 
-#    else
+    while (data.size() >= 16) {
+        x1 = fold(x1, k3k4, load(0));
+        data = data.slice(16);
+    }
 
-// FIXME: Implement the slicing-by-8 algorithm for big endian CPUs.
-static constexpr auto generate_table()
-{
-    Array<u32, 256> data {};
-    for (auto i = 0u; i < data.size(); i++) {
-        u32 value = i;
+    // Fold 128 bits down to 64 bits.
+    x2 = carryless_multiply<0x10>(x1, k3k4);
+    x1 = u64x2 { x1[1], 0 } ^ x2;
+    auto words = bit_cast<u32x4>(x1);
+    x2 = bit_cast<u64x2>(u32x4 { words[1], words[2], words[3], 0 });
+    x1 = carryless_multiply<0x00>(x1 & low_words_mask, k5k0) ^ x2;
 
-        for (auto j = 0; j < 8; j++) {
-            if (value & 1) {
-                value = ethernet_polynomial ^ (value >> 1);
-            } else {
-                value = value >> 1;
-            }
-        }
+    // Barrett reduction down to 32 bits.
+    x2 = carryless_multiply<0x10>(x1 & low_words_mask, polynomial);
+    x2 = carryless_multiply<0x00>(x2 & low_words_mask, polynomial);
+    state = bit_cast<u32x4>(x1 ^ x2)[1];
 
-        data[i] = value;
-    }
-    return data;
+    return update_crc32<CPUFeatures::None>(state, data);
 }
+#    endif
+
+#    if AK_CAN_CODEGEN_FOR_X86_SSE42
+// SSE 4.2 only has an instruction for the Castagnoli polynomial.
+template<>
+[[gnu::target("sse4.2")]] u32 update_crc32c<CPUFeatures::X86_SSE42>(u32 state, ReadonlyBytes data)
+{
+    while (data.size() >= 8) {
+#        if ARCH(X86_64)
+        state = __builtin_ia32_crc32di(state, ByteReader::load64(data.data()));
+#        else
+        state = __builtin_ia32_crc32si(state, ByteReader::load32(data.data()));
+        state = __builtin_ia32_crc32si(state, ByteReader::load32(data.data() + 4));
+#        endif
+        data = data.slice(8);
+    }
 
-static constexpr auto table = generate_table();
+    for (auto byte : data)
+        state = __builtin_ia32_crc32qi(state, byte);
+
+    return state;
+}
+#    endif
 
 void CRC32::update(ReadonlyBytes data)
 {
-    for (size_t i = 0; i < data.size(); i++) {
-        m_state = table[(m_state ^ data.at(i)) & 0xFF] ^ (m_state >> 8);
-    }
+    static auto const implementation = [] {
+        if constexpr (is_valid_feature(CPUFeatures::X86_PCLMUL)) {
+            if (has_flag(detect_cpu_features(), CPUFeatures::X86_PCLMUL))
+                return &update_crc32<CPUFeatures::X86_PCLMUL>;
+        }
+        return &update_crc32<CPUFeatures::None>;
+    }();
+
+    m_state = implementation(m_state, data);
+}
+
+void CRC32C::update(ReadonlyBytes data)
+{
+    static auto const implementation = [] {
+        if constexpr (is_valid_feature(CPUFeatures::X86_SSE42)) {
+            if (has_flag(detect_cpu_features(), CPUFeatures::X86_SSE42))
+                return &update_crc32c<CPUFeatures::X86_SSE42>;
+        }
+        return &update_crc32c<CPUFeatures::None>;
+    }();
+
+    m_state = implementation(m_state, data);
 }
 
-#    endif
 #endif
 
 u32 CRC32::digest()
@@ -174,4 +271,53 @@ u32 CRC32::digest()
     return ~m_state;
 }
 
+u32 CRC32C::digest()
+{
+    return ~m_state;
+}
+
+// CRC combination works in GF(2) polynomial arithmetic modulo the (bit-reflected) CRC polynomial, see zlib's
+// crc32_combine(). Appending n zero bytes to an input multiplies its CRC by x^(8n), so the combined CRC is
+// first * x^(8 * second_length) + second.
+static constexpr u32 multiply_modulo_polynomial(u32 a, u32 b)
+{
+    u32 product = 0;
+    for (u32 mask = 1u << 31; mask != 0; mask >>= 1) {
+        if (a & mask)
+            product ^= b;
+        b = (b & 1) ? (b >> 1) ^ ethernet_polynomial : b >> 1;
+    }
+    return product;
+}
+
+// x^(2^n) modulo the polynomial, for n in [0, 64).
+static constexpr auto generate_power_of_two_table()
+{
+    Array<u32, 64> powers {};
+    u32 power = 1u << 30; // x^1
+    for (auto& entry : powers) {
+        entry = power;
+        power = multiply_modulo_polynomial(power, power);
+    }
+    return powers;
+}
+
+static constexpr auto power_of_two_table = generate_power_of_two_table();
+
+// x^(8 * byte_count) modulo the polynomial.
+static constexpr u32 shift_by_bytes(u64 byte_count)
+{
+    u32 result = 1u << 31; // x^0
+    for (size_t exponent = 3; byte_count != 0 && exponent < power_of_two_table.size(); byte_count >>= 1, ++exponent) {
+        if (byte_count & 1)
+            result = multiply_modulo_polynomial(power_of_two_table[exponent], result);
+    }
+    return result;
+}
+
+u32 CRC32::combine(u32 first_digest, u32 second_digest, u64 second_length)
+{
+    return multiply_modulo_polynomial(shift_by_bytes(second_length), first_digest) ^ second_digest;
+}
+
 }
@@ -29,6 +29,31 @@ public:
     virtual void update(ReadonlyBytes data) override;
     virtual u32 digest() override;
 
+    // Returns the CRC32 of the concatenation of two inputs, given their digests and the length of the second one.
+    static u32 combine(u32 first_digest, u32 second_digest, u64 second_length);
+
+private:
+    u32 m_state { ~0u };
+};
+
+// CRC-32C uses the Castagnoli polynomial instead of the Ethernet one, as used by iSCSI, ext4 and SCTP.
+class CRC32C : public ChecksumFunction<u32> {
+public:
+    CRC32C() = default;
+    CRC32C(ReadonlyBytes data)
+    {
+        update(data);
+    }
+
+    CRC32C(u32 initial_state, ReadonlyBytes data)
+        : m_state(initial_state)
+    {
+        update(data);
+    }
+
+    virtual void update(ReadonlyBytes data) override;
+    virtual u32 digest() override;
+
 private:
     u32 m_state { ~0u };
 };
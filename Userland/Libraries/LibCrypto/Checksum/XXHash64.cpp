@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteReader.h>
+#include <AK/Endian.h>
+#include <LibCrypto/Checksum/XXHash64.h>
+
+namespace Crypto::Checksum {
+
+static constexpr u64 prime64_1 = 0x9E3779B185EBCA87;
+static constexpr u64 prime64_2 = 0xC2B2AE3D27D4EB4F;
+static constexpr u64 prime64_3 = 0x165667B19E3779F9;
+static constexpr u64 prime64_4 = 0x85EBCA77C2B2AE63;
+static constexpr u64 prime64_5 = 0x27D4EB2F165667C5;
+
+static ALWAYS_INLINE u64 rotate_left(u64 value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static ALWAYS_INLINE u64 read_u64(u8 const* data)
+{
+    u64 value;
+    ByteReader::load(data, value);
+    return AK::convert_between_host_and_little_endian(value);
+}
+
+static ALWAYS_INLINE u32 read_u32(u8 const* data)
+{
+    u32 value;
+    ByteReader::load(data, value);
+    return AK::convert_between_host_and_little_endian(value);
+}
+
+static ALWAYS_INLINE u64 round(u64 accumulator, u64 lane)
+{
+    accumulator += lane * prime64_2;
+    accumulator = rotate_left(accumulator, 31);
+    return accumulator * prime64_1;
+}
+
+static ALWAYS_INLINE u64 merge_accumulator(u64 hash, u64 accumulator)
+{
+    hash ^= round(0, accumulator);
+    return hash * prime64_1 + prime64_4;
+}
+
+XXHash64::XXHash64(u64 seed)
+    : m_accumulators { seed + prime64_1 + prime64_2, seed + prime64_2, seed, seed - prime64_1 }
+    , m_seed(seed)
+{
+}
+
+void XXHash64::update(ReadonlyBytes data)
+{
+    m_total_length += data.size();
+
+    if (m_stripe_buffer_size != 0) {
+        auto count = min(data.size(), m_stripe_buffer.size() - m_stripe_buffer_size);
+        data.trim(count).copy_to(m_stripe_buffer.span().slice(m_stripe_buffer_size));
+        m_stripe_buffer_size += count;
+        data = data.slice(count);
+
+        if (m_stripe_buffer_size < m_stripe_buffer.size())
+            return;
+
+        for (size_t i = 0; i < 4; ++i)
+            m_accumulators[i] = round(m_accumulators[i], read_u64(m_stripe_buffer.data() + i * 8));
+        m_stripe_buffer_size = 0;
+    }
+
+    auto accumulator_1 = m_accumulators[0];
+    auto accumulator_2 = m_accumulators[1];
+    auto accumulator_3 = m_accumulators[2];
+    auto accumulator_4 = m_accumulators[3];
+
+    u8 const* input = data.data();
+    u8 const* end = input + data.size();
+    while (end - input >= 32) {
+        accumulator_1 = round(accumulator_1, read_u64(input));
+        accumulator_2 = round(accumulator_2, read_u64(input + 8));
+        accumulator_3 = round(accumulator_3, read_u64(input + 16));
+        accumulator_4 = round(accumulator_4, read_u64(input + 24));
+        input += 32;
+    }
+
+    m_accumulators = { accumulator_1, accumulator_2, accumulator_3, accumulator_4 };
+
+    m_stripe_buffer_size = end - input;
+    __builtin_memcpy(m_stripe_buffer.data(), input, m_stripe_buffer_size);
+}
+
+u64 XXHash64::digest()
+{
+    u64 hash;
+    if (m_total_length >= 32) {
+        hash = rotate_left(m_accumulators[0], 1) + rotate_left(m_accumulators[1], 7) + rotate_left(m_accumulators[2], 12) + rotate_left(m_accumulators[3], 18);
+        for (auto accumulator : m_accumulators)
+            hash = merge_accumulator(hash, accumulator);
+    } else {
+        hash = m_seed + prime64_5;
+    }
+
+    hash += m_total_length;
+
+    u8 const* input = m_stripe_buffer.data();
+    u8 const* end = input + m_stripe_buffer_size;
+    for (; end - input >= 8; input += 8) {
+        hash ^= round(0, read_u64(input));
+        hash = rotate_left(hash, 27) * prime64_1 + prime64_4;
+    }
+    if (end - input >= 4) {
+        hash ^= static_cast<u64>(read_u32(input)) * prime64_1;
+        hash = rotate_left(hash, 23) * prime64_2 + prime64_3;
+        input += 4;
+    }
+    for (; input < end; ++input) {
+        hash ^= *input * prime64_5;
+        hash = rotate_left(hash, 11) * prime64_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime64_2;
+    hash ^= hash >> 29;
+    hash *= prime64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+}
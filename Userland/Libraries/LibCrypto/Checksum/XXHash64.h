@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <LibCrypto/Checksum/ChecksumFunction.h>
+
+namespace Crypto::Checksum {
+
+// XXH64 as specified in https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md, which is used by Zstandard.
+class XXHash64 : public ChecksumFunction<u64> {
+public:
+    XXHash64(u64 seed = 0);
+    XXHash64(ReadonlyBytes data)
+        : XXHash64()
+    {
+        update(data);
+    }
+
+    virtual void update(ReadonlyBytes data) override;
+    virtual u64 digest() override;
+
+private:
+    Array<u64, 4> m_accumulators;
+    Array<u8, 32> m_stripe_buffer {};
+    size_t m_stripe_buffer_size { 0 };
+    u64 m_seed { 0 };
+    u64 m_total_length { 0 };
+};
+
+}
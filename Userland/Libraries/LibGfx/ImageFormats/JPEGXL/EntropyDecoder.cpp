@@ -317,7 +317,7 @@ ErrorOr<EntropyDecoder> EntropyDecoder::create(LittleEndianInputBitStream& strea
             if (counts[i] != 1)
                 distributions[i] = TRY(BrotliCanonicalCode::read_prefix_code(stream, counts[i]));
             else
-                distributions[i] = BrotliCanonicalCode { { 1 }, { 0 } };
+                distributions[i] = TRY(BrotliCanonicalCode::for_single_symbol(0));
         }
     } else {
         entropy_decoder.m_distributions = Vector<ANSHistogram> {};
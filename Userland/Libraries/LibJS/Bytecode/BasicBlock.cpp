@@ -31,6 +31,19 @@ BasicBlock::~BasicBlock()
     }
 }
 
+NonnullOwnPtr<BasicBlock> BasicBlock::clone() const
+{
+    auto block = create(m_index, m_name);
+    block->m_buffer = m_buffer;
+    block->m_handler = m_handler;
+    block->m_finalizer = m_finalizer;
+    block->m_terminated = m_terminated;
+    block->m_has_resolved_this = m_has_resolved_this;
+    block->m_source_map = m_source_map;
+    block->m_last_instruction_start_offset = m_last_instruction_start_offset;
+    return block;
+}
+
 void BasicBlock::grow(size_t additional_size)
 {
     m_buffer.grow_capacity(m_buffer.size() + additional_size);
@@ -29,7 +29,12 @@ public:
     static NonnullOwnPtr<BasicBlock> create(u32 index, String name);
     ~BasicBlock();
 
+    // Copies the instructions byte for byte, which works since none of them own any resources.
+    // The handler and finalizer of the copy still point at the blocks of the original.
+    NonnullOwnPtr<BasicBlock> clone() const;
+
     u32 index() const { return m_index; }
+    void set_index(u32 index) { m_index = index; }
 
     ReadonlyBytes instruction_stream() const { return m_buffer.span(); }
     u8* data() { return m_buffer.data(); }
@@ -65,6 +70,8 @@ public:
     void set_last_instruction_start_offset(size_t offset) { m_last_instruction_start_offset = offset; }
 
 private:
+    friend class InstructionStreamRewriter;
+
     explicit BasicBlock(u32 index, String name);
 
     u32 m_index { 0 };
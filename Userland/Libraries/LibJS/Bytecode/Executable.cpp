@@ -8,6 +8,7 @@
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/SourceCode.h>
 
 namespace JS::Bytecode {
@@ -40,17 +41,25 @@ Executable::Executable(
 
 Executable::~Executable() = default;
 
-void Executable::dump() const
+JIT::NativeExecutable const* Executable::get_or_create_native_executable()
 {
-    warnln("\033[37;1mJS bytecode executable\033[0m \"{}\"", name);
-    InstructionStreamIterator it(bytecode, this);
+    if (!m_did_try_jitting) {
+        m_did_try_jitting = true;
+        m_native_executable = JIT::Compiler::compile(*this);
+    }
+    return m_native_executable.ptr();
+}
+
+void Executable::dump_instructions(ReadonlyBytes instructions, ReadonlySpan<size_t> block_start_offsets) const
+{
+    InstructionStreamIterator it(instructions, this);
 
     size_t basic_block_offset_index = 0;
 
     while (!it.at_end()) {
         bool print_basic_block_marker = false;
-        if (basic_block_offset_index < basic_block_start_offsets.size()
-            && it.offset() == basic_block_start_offsets[basic_block_offset_index]) {
+        if (basic_block_offset_index < block_start_offsets.size()
+            && it.offset() == block_start_offsets[basic_block_offset_index]) {
             ++basic_block_offset_index;
             print_basic_block_marker = true;
         }
@@ -67,6 +76,18 @@ void Executable::dump() const
 
         ++it;
     }
+}
+
+void Executable::dump() const
+{
+    if (!unoptimized_bytecode.is_empty()) {
+        warnln("\033[37;1mJS bytecode executable\033[0m \"{}\" (before optimization)", name);
+        dump_instructions(unoptimized_bytecode, unoptimized_basic_block_start_offsets);
+        warnln("");
+    }
+
+    warnln("\033[37;1mJS bytecode executable\033[0m \"{}\"", name);
+    dump_instructions(bytecode, basic_block_start_offsets);
 
     if (!exception_handlers.is_empty()) {
         warnln("");
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -23,13 +24,35 @@
 namespace JS::Bytecode {
 
 struct PropertyLookupCache {
-    WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    // Property accesses that see more shapes than this are considered megamorphic, and keep replacing the oldest entry.
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+
+    struct Entry {
+        enum class Type : u8 {
+            Empty,
+            OwnProperty,
+            InPrototypeChain,
+            // An object with `from_shape` gets `shape` once the property has been added at `property_offset`.
+            AddOwnProperty,
+        };
+        Type type { Type::Empty };
+        WeakPtr<Shape> from_shape;
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        // Where the property was found, for InPrototypeChain.
+        WeakPtr<Object> prototype;
+        // The validity of the prototype chain starting at the object's prototype, for InPrototypeChain and
+        // AddOwnProperty. Additions use it to know that nothing in the chain intercepts them.
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    };
+
+    // Most recently added first.
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
 };
 
-struct GlobalVariableCache : public PropertyLookupCache {
+struct GlobalVariableCache {
+    WeakPtr<Shape> shape;
+    Optional<u32> property_offset;
     u64 environment_serial_number { 0 };
     Optional<u32> environment_binding_index;
 };
@@ -88,6 +111,16 @@ public:
 
     Optional<IdentifierTableIndex> length_identifier;
 
+    // Only filled in with g_dump_bytecode_passes, so that dump() can show what the optimization passes did.
+    Vector<u8> unoptimized_bytecode;
+    Vector<size_t> unoptimized_basic_block_start_offsets;
+
+    // How often this executable has been entered and has looped, used to decide when to compile it to native code.
+    u32 call_count { 0 };
+    u32 back_edge_count { 0 };
+
+    JIT::NativeExecutable const* get_or_create_native_executable();
+
     ByteString const& get_string(StringTableIndex index) const { return string_table->get(index); }
     DeprecatedFlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
@@ -105,7 +138,12 @@ public:
     void dump() const;
 
 private:
+    void dump_instructions(ReadonlyBytes, ReadonlySpan<size_t> block_start_offsets) const;
+
     virtual void visit_edges(Visitor&) override;
+
+    OwnPtr<JIT::NativeExecutable> m_native_executable;
+    bool m_did_try_jitting { false };
 };
 
 }
@@ -4,13 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/QuickSort.h>
 #include <AK/TemporaryChange.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/VM.h>
@@ -199,69 +202,26 @@ CodeGenerationErrorOr<void> Generator::emit_function_declaration_instantiation(E
     return {};
 }
 
-CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNode const& node, FunctionKind enclosing_function_kind, GCPtr<ECMAScriptFunctionObject const> function, MustPropagateCompletion must_propagate_completion, Vector<DeprecatedFlyString> local_variable_names)
-{
-    Generator generator(vm, function, must_propagate_completion);
-
-    generator.switch_to_basic_block(generator.make_block());
-    SourceLocationScope scope(generator, node);
-    generator.m_enclosing_function_kind = enclosing_function_kind;
-    if (generator.is_in_async_function() && !generator.is_in_generator_function()) {
-        // Immediately yield with no value.
-        auto& start_block = generator.make_block();
-        generator.emit<Bytecode::Op::Yield>(Label { start_block }, generator.add_constant(js_undefined()));
-        generator.switch_to_basic_block(start_block);
-        // NOTE: This doesn't have to handle received throw/return completions, as GeneratorObject::resume_abrupt
-        //       will not enter the generator from the SuspendedStart state and immediately completes the generator.
-    }
+namespace {
 
-    if (function)
-        TRY(generator.emit_function_declaration_instantiation(*function));
-
-    if (generator.is_in_generator_function()) {
-        // Immediately yield with no value.
-        auto& start_block = generator.make_block();
-        generator.emit<Bytecode::Op::Yield>(Label { start_block }, generator.add_constant(js_undefined()));
-        generator.switch_to_basic_block(start_block);
-        // NOTE: This doesn't have to handle received throw/return completions, as GeneratorObject::resume_abrupt
-        //       will not enter the generator from the SuspendedStart state and immediately completes the generator.
-    }
-
-    auto last_value = TRY(node.generate_bytecode(generator));
-
-    if (!generator.current_block().is_terminated() && last_value.has_value()) {
-        generator.emit<Bytecode::Op::End>(last_value.value());
-    }
-
-    if (generator.is_in_generator_or_async_function()) {
-        // Terminate all unterminated blocks with yield return
-        for (auto& block : generator.m_root_basic_blocks) {
-            if (block->is_terminated())
-                continue;
-            generator.switch_to_basic_block(*block);
-            generator.emit_return<Bytecode::Op::Yield>(generator.add_constant(js_undefined()));
-        }
-    }
+struct LinkedBytecode {
+    Vector<u8> bytecode;
+    Vector<size_t> basic_block_start_offsets;
+    Vector<Executable::ExceptionHandlers> exception_handlers;
+    HashMap<size_t, SourceRecord> source_map;
+};
 
-    bool is_strict_mode = false;
-    if (is<Program>(node))
-        is_strict_mode = static_cast<Program const&>(node).is_strict_mode();
-    else if (is<FunctionBody>(node))
-        is_strict_mode = static_cast<FunctionBody const&>(node).in_strict_mode();
-    else if (is<FunctionDeclaration>(node))
-        is_strict_mode = static_cast<FunctionDeclaration const&>(node).is_strict_mode();
+}
 
+// Rebases the operands of the blocks onto the register file and lays the blocks out one after the other.
+// `undefined_constant` has to be rebased already, and is only used if a block is not terminated.
+static LinkedBytecode link_basic_blocks(Vector<NonnullOwnPtr<BasicBlock>>& basic_blocks, size_t number_of_registers, size_t number_of_constants, Optional<Operand> undefined_constant)
+{
     size_t size_needed = 0;
-    for (auto& block : generator.m_root_basic_blocks) {
+    for (auto& block : basic_blocks) {
         size_needed += block->size();
     }
 
-    Vector<u8> bytecode;
-    bytecode.ensure_capacity(size_needed);
-
-    Vector<size_t> basic_block_start_offsets;
-    basic_block_start_offsets.ensure_capacity(generator.m_root_basic_blocks.size());
-
     HashMap<BasicBlock const*, size_t> block_offsets;
     Vector<size_t> label_offsets;
 
@@ -273,25 +233,16 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
     };
     Vector<UnlinkedExceptionHandlers> unlinked_exception_handlers;
 
-    HashMap<size_t, SourceRecord> source_map;
-
-    Optional<ScopedOperand> undefined_constant;
-
-    for (auto& block : generator.m_root_basic_blocks) {
-        if (!block->is_terminated()) {
-            // NOTE: We must ensure that the "undefined" constant, which will be used by the not yet
-            // emitted End instruction, is taken into account while shifting local operands by the
-            // number of constants.
-            undefined_constant = generator.add_constant(js_undefined());
-            break;
-        }
-    }
+    LinkedBytecode linked;
+    auto& bytecode = linked.bytecode;
+    auto& basic_block_start_offsets = linked.basic_block_start_offsets;
+    auto& source_map = linked.source_map;
 
-    auto number_of_registers = generator.m_next_register;
-    auto number_of_constants = generator.m_constants.size();
+    bytecode.ensure_capacity(size_needed);
+    basic_block_start_offsets.ensure_capacity(basic_blocks.size());
 
     // Pass: Rewrite the bytecode to use the correct register and constant indices.
-    for (auto& block : generator.m_root_basic_blocks) {
+    for (auto& block : basic_blocks) {
         Bytecode::InstructionStreamIterator it(block->instruction_stream());
         while (!it.at_end()) {
             auto& instruction = const_cast<Instruction&>(*it);
@@ -315,11 +266,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
         }
     }
 
-    // Also rewrite the `undefined` constant if we have one for inserting End.
-    if (undefined_constant.has_value())
-        undefined_constant.value().operand().offset_index_by(number_of_registers);
-
-    for (auto& block : generator.m_root_basic_blocks) {
+    for (auto& block : basic_blocks) {
         basic_block_start_offsets.append(bytecode.size());
         if (block->handler() || block->finalizer()) {
             unlinked_exception_handlers.append({
@@ -354,7 +301,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
                 }
 
                 // OPTIMIZATION: For jumps to a return-or-end-only block, we can emit a `Return` or `End` directly instead.
-                auto& target_block = *generator.m_root_basic_blocks[jump.target().basic_block_index()];
+                auto& target_block = *basic_blocks[jump.target().basic_block_index()];
                 if (target_block.is_terminated()) {
                     auto target_instruction_iterator = InstructionStreamIterator { target_block.instruction_stream() };
                     auto& target_instruction = *target_instruction_iterator;
@@ -418,12 +365,133 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
     }
     for (auto label_offset : label_offsets) {
         auto& label = *reinterpret_cast<Label*>(bytecode.data() + label_offset);
-        auto* block = generator.m_root_basic_blocks[label.basic_block_index()].ptr();
+        auto* block = basic_blocks[label.basic_block_index()].ptr();
         label.set_address(block_offsets.get(block).value());
     }
 
+    for (auto& unlinked_handler : unlinked_exception_handlers) {
+        auto start_offset = unlinked_handler.start_offset;
+        auto end_offset = unlinked_handler.end_offset;
+        auto handler_offset = unlinked_handler.handler ? block_offsets.get(unlinked_handler.handler).value() : Optional<size_t> {};
+        auto finalizer_offset = unlinked_handler.finalizer ? block_offsets.get(unlinked_handler.finalizer).value() : Optional<size_t> {};
+        linked.exception_handlers.append({ start_offset, end_offset, handler_offset, finalizer_offset });
+    }
+
+    quick_sort(linked.exception_handlers, [](auto const& a, auto const& b) {
+        return a.start_offset < b.start_offset;
+    });
+
+    return linked;
+}
+
+// Copies the blocks as they are before the optimization passes run, so that their effect can be shown afterwards.
+static Vector<NonnullOwnPtr<BasicBlock>> clone_basic_blocks(Vector<NonnullOwnPtr<BasicBlock>> const& basic_blocks)
+{
+    Vector<NonnullOwnPtr<BasicBlock>> clones;
+    HashMap<BasicBlock const*, BasicBlock const*> clone_of;
+    clones.ensure_capacity(basic_blocks.size());
+    for (auto const& block : basic_blocks) {
+        clones.unchecked_append(block->clone());
+        clone_of.set(block.ptr(), clones.last().ptr());
+    }
+    for (auto& clone : clones) {
+        if (clone->handler())
+            clone->set_handler(*clone_of.get(clone->handler()).value());
+        if (clone->finalizer())
+            clone->set_finalizer(*clone_of.get(clone->finalizer()).value());
+    }
+    return clones;
+}
+
+CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNode const& node, FunctionKind enclosing_function_kind, GCPtr<ECMAScriptFunctionObject const> function, MustPropagateCompletion must_propagate_completion, Vector<DeprecatedFlyString> local_variable_names)
+{
+    Generator generator(vm, function, must_propagate_completion);
+
+    generator.switch_to_basic_block(generator.make_block());
+    SourceLocationScope scope(generator, node);
+    generator.m_enclosing_function_kind = enclosing_function_kind;
+    if (generator.is_in_async_function() && !generator.is_in_generator_function()) {
+        // Immediately yield with no value.
+        auto& start_block = generator.make_block();
+        generator.emit<Bytecode::Op::Yield>(Label { start_block }, generator.add_constant(js_undefined()));
+        generator.switch_to_basic_block(start_block);
+        // NOTE: This doesn't have to handle received throw/return completions, as GeneratorObject::resume_abrupt
+        //       will not enter the generator from the SuspendedStart state and immediately completes the generator.
+    }
+
+    if (function)
+        TRY(generator.emit_function_declaration_instantiation(*function));
+
+    if (generator.is_in_generator_function()) {
+        // Immediately yield with no value.
+        auto& start_block = generator.make_block();
+        generator.emit<Bytecode::Op::Yield>(Label { start_block }, generator.add_constant(js_undefined()));
+        generator.switch_to_basic_block(start_block);
+        // NOTE: This doesn't have to handle received throw/return completions, as GeneratorObject::resume_abrupt
+        //       will not enter the generator from the SuspendedStart state and immediately completes the generator.
+    }
+
+    auto last_value = TRY(node.generate_bytecode(generator));
+
+    if (!generator.current_block().is_terminated() && last_value.has_value()) {
+        generator.emit<Bytecode::Op::End>(last_value.value());
+    }
+
+    if (generator.is_in_generator_or_async_function()) {
+        // Terminate all unterminated blocks with yield return
+        for (auto& block : generator.m_root_basic_blocks) {
+            if (block->is_terminated())
+                continue;
+            generator.switch_to_basic_block(*block);
+            generator.emit_return<Bytecode::Op::Yield>(generator.add_constant(js_undefined()));
+        }
+    }
+
+    // The blocks as they were generated, only kept around to show what the optimization passes did.
+    Vector<NonnullOwnPtr<BasicBlock>> unoptimized_basic_blocks;
+
+    if (!g_disable_bytecode_optimizations) {
+        if (g_dump_bytecode_passes)
+            unoptimized_basic_blocks = clone_basic_blocks(generator.m_root_basic_blocks);
+
+        auto pipeline = PassManager::create_optimization_pipeline();
+        PassPipelineExecutable pipeline_executable { generator, generator.m_root_basic_blocks };
+        pipeline->perform(pipeline_executable);
+        if (g_dump_bytecode_passes)
+            pipeline->dump_statistics();
+    }
+
+    bool is_strict_mode = false;
+    if (is<Program>(node))
+        is_strict_mode = static_cast<Program const&>(node).is_strict_mode();
+    else if (is<FunctionBody>(node))
+        is_strict_mode = static_cast<FunctionBody const&>(node).in_strict_mode();
+    else if (is<FunctionDeclaration>(node))
+        is_strict_mode = static_cast<FunctionDeclaration const&>(node).is_strict_mode();
+
+    auto has_unterminated_block = [](auto const& basic_blocks) {
+        return any_of(basic_blocks, [](auto const& block) { return !block->is_terminated(); });
+    };
+
+    Optional<Operand> undefined_constant;
+    if (has_unterminated_block(generator.m_root_basic_blocks) || has_unterminated_block(unoptimized_basic_blocks)) {
+        // NOTE: We must ensure that the "undefined" constant, which will be used by the not yet
+        // emitted End instruction, is taken into account while shifting local operands by the
+        // number of constants.
+        undefined_constant = generator.add_constant(js_undefined()).operand();
+    }
+
+    auto number_of_registers = generator.m_next_register;
+    auto number_of_constants = generator.m_constants.size();
+
+    // Also rewrite the `undefined` constant if we have one for inserting End.
+    if (undefined_constant.has_value())
+        undefined_constant->offset_index_by(number_of_registers);
+
+    auto linked = link_basic_blocks(generator.m_root_basic_blocks, number_of_registers, number_of_constants, undefined_constant);
+
     auto executable = vm.heap().allocate_without_realm<Executable>(
-        move(bytecode),
+        move(linked.bytecode),
         move(generator.m_identifier_table),
         move(generator.m_string_table),
         move(generator.m_regex_table),
@@ -434,27 +502,20 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
         generator.m_next_register,
         is_strict_mode);
 
-    Vector<Executable::ExceptionHandlers> linked_exception_handlers;
-
-    for (auto& unlinked_handler : unlinked_exception_handlers) {
-        auto start_offset = unlinked_handler.start_offset;
-        auto end_offset = unlinked_handler.end_offset;
-        auto handler_offset = unlinked_handler.handler ? block_offsets.get(unlinked_handler.handler).value() : Optional<size_t> {};
-        auto finalizer_offset = unlinked_handler.finalizer ? block_offsets.get(unlinked_handler.finalizer).value() : Optional<size_t> {};
-        linked_exception_handlers.append({ start_offset, end_offset, handler_offset, finalizer_offset });
-    }
-
-    quick_sort(linked_exception_handlers, [](auto const& a, auto const& b) {
-        return a.start_offset < b.start_offset;
-    });
-
-    executable->exception_handlers = move(linked_exception_handlers);
-    executable->basic_block_start_offsets = move(basic_block_start_offsets);
-    executable->source_map = move(source_map);
+    executable->exception_handlers = move(linked.exception_handlers);
+    executable->basic_block_start_offsets = move(linked.basic_block_start_offsets);
+    executable->source_map = move(linked.source_map);
     executable->local_variable_names = move(local_variable_names);
     executable->local_index_base = number_of_registers + number_of_constants;
     executable->length_identifier = generator.m_length_identifier;
 
+    if (!unoptimized_basic_blocks.is_empty()) {
+        // The passes only ever add constants, so the unoptimized blocks can share the tables of the executable.
+        auto unoptimized = link_basic_blocks(unoptimized_basic_blocks, number_of_registers, number_of_constants, undefined_constant);
+        executable->unoptimized_bytecode = move(unoptimized.bytecode);
+        executable->unoptimized_basic_block_start_offsets = move(unoptimized.basic_block_start_offsets);
+    }
+
     generator.m_finished = true;
 
     return executable;
@@ -14,6 +14,8 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/Profiler.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -39,6 +41,32 @@
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+bool g_dump_bytecode_passes = false;
+bool g_disable_bytecode_optimizations = false;
+// The JIT maps the code it generates as executable, which a pledged Serenity process can only do with the prot_exec promise,
+// and trying without it kills the process. So there, the JIT is off until a process that has pledged prot_exec turns it on.
+#ifdef AK_OS_SERENITY
+bool g_disable_jit = true;
+#else
+bool g_disable_jit = false;
+#endif
+InlineCacheStatistics g_inline_cache_statistics;
+
+// Executables are handed to the baseline JIT once they've been entered or looped this many times.
+static constexpr u32 jit_call_threshold = 10;
+static constexpr u32 jit_back_edge_threshold = 100;
+
+ALWAYS_INLINE static JIT::NativeExecutable const* native_executable_if_hot(Executable& executable, u32& counter, u32 threshold, Profiler const* profiler)
+{
+    // Native code doesn't report the instructions it runs, so it would be invisible to the profiler.
+    if (g_disable_jit || profiler)
+        return nullptr;
+    if (counter < threshold) {
+        ++counter;
+        return nullptr;
+    }
+    return executable.get_or_create_native_executable();
+}
 
 static ByteString format_operand(StringView name, Operand operand, Bytecode::Executable const& executable)
 {
@@ -155,14 +183,14 @@ Interpreter::~Interpreter()
 {
 }
 
-ALWAYS_INLINE Value Interpreter::get(Operand op) const
+void Interpreter::start_profiling(Duration sample_interval)
 {
-    return m_registers_and_constants_and_locals.data()[op.index()];
+    m_profiler = make<Profiler>(vm(), sample_interval);
 }
 
-ALWAYS_INLINE void Interpreter::set(Operand op, Value value)
+OwnPtr<Profiler> Interpreter::stop_profiling()
 {
-    m_registers_and_constants_and_locals.data()[op.index()] = value;
+    return move(m_profiler);
 }
 
 ALWAYS_INLINE Value Interpreter::do_yield(Value value, Optional<Label> continuation)
@@ -230,19 +258,26 @@ ThrowCompletionOr<Value> Interpreter::run(Script& script_record, JS::GCPtr<Envir
 
     // 13. If result.[[Type]] is normal, then
     if (result.type() == Completion::Type::Normal) {
-        auto executable_result = JS::Bytecode::Generator::generate_from_ast_node(vm, script, {});
-
-        if (executable_result.is_error()) {
-            if (auto error_string = executable_result.error().to_string(); error_string.is_error())
-                result = vm.template throw_completion<JS::InternalError>(vm.error_message(JS::VM::ErrorMessage::OutOfMemory));
-            else if (error_string = String::formatted("TODO({})", error_string.value()); error_string.is_error())
-                result = vm.template throw_completion<JS::InternalError>(vm.error_message(JS::VM::ErrorMessage::OutOfMemory));
-            else
-                result = JS::throw_completion(JS::InternalError::create(realm(), error_string.release_value()));
-        } else {
-            auto executable = executable_result.release_value();
+        // NOTE: The AST may have come from the VM's program cache, in which case we've already generated bytecode for it.
+        GCPtr<Executable> executable = script.bytecode_executable();
+        if (!executable) {
+            auto executable_result = JS::Bytecode::Generator::generate_from_ast_node(vm, script, {});
+
+            if (executable_result.is_error()) {
+                if (auto error_string = executable_result.error().to_string(); error_string.is_error())
+                    result = vm.template throw_completion<JS::InternalError>(vm.error_message(JS::VM::ErrorMessage::OutOfMemory));
+                else if (error_string = String::formatted("TODO({})", error_string.value()); error_string.is_error())
+                    result = vm.template throw_completion<JS::InternalError>(vm.error_message(JS::VM::ErrorMessage::OutOfMemory));
+                else
+                    result = JS::throw_completion(JS::InternalError::create(realm(), error_string.release_value()));
+            } else {
+                executable = executable_result.release_value();
+                const_cast<Program&>(script).set_bytecode_executable(executable);
+            }
+        }
 
-            if (g_dump_bytecode)
+        if (executable) {
+            if (g_dump_bytecode || g_dump_bytecode_passes)
                 executable->dump();
 
             // a. Set result to the result of evaluating script.
@@ -332,6 +367,25 @@ Interpreter::HandleExceptionResponse Interpreter::handle_exception(size_t& progr
     VERIFY_NOT_REACHED();
 }
 
+// Runs native code until it hands control back to us. Returns true if the executable is done,
+// or false if the interpreter should pick up at program_counter.
+bool Interpreter::run_native_code(JIT::NativeExecutable const& native_executable, size_t& program_counter)
+{
+    for (;;) {
+        switch (native_executable.run(*this, m_registers_and_constants_and_locals.data(), program_counter)) {
+        case JIT::NativeExecutable::ExitReason::Finished:
+            return true;
+        case JIT::NativeExecutable::ExitReason::Exception:
+            if (handle_exception(program_counter, reg(Register::exception())) == HandleExceptionResponse::ExitFromExecutable)
+                return true;
+            continue;
+        case JIT::NativeExecutable::ExitReason::Interpret:
+            return false;
+        }
+        VERIFY_NOT_REACHED();
+    }
+}
+
 // FIXME: GCC takes a *long* time to compile with flattening, and it will time out our CI. :|
 #if defined(AK_COMPILER_CLANG)
 #    define FLATTEN_ON_CLANG FLATTEN
@@ -356,6 +410,11 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
     TemporaryChange change(m_program_counter, Optional<size_t&>(program_counter));
 
+    if (auto const* native_executable = native_executable_if_hot(executable, executable.call_count, jit_call_threshold, m_profiler.ptr())) {
+        if (run_native_code(*native_executable, program_counter))
+            return;
+    }
+
     // Declare a lookup table for computed goto with each of the `handle_*` labels
     // to avoid the overhead of a switch statement.
     // This is a GCC extension, but it's also supported by Clang.
@@ -366,6 +425,15 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
     };
 #undef SET_UP_LABEL
 
+    // While profiling, every dispatch goes through profile_instruction first, so the fast path doesn't pay for it otherwise.
+    static void* const profiling_dispatch_table[] = {
+#define SET_UP_LABEL(name) &&profile_instruction,
+        ENUMERATE_BYTECODE_OPS(SET_UP_LABEL)
+    };
+#undef SET_UP_LABEL
+
+    void* const* dispatch_table = m_profiler ? profiling_dispatch_table : bytecode_dispatch_table;
+
 #define DISPATCH_NEXT(name)                                                                         \
     do {                                                                                            \
         if constexpr (Op::name::IsVariableLength)                                                   \
@@ -373,13 +441,21 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
         else                                                                                        \
             program_counter += sizeof(Op::name);                                                    \
         auto& next_instruction = *reinterpret_cast<Instruction const*>(&bytecode[program_counter]); \
-        goto* bytecode_dispatch_table[static_cast<size_t>(next_instruction.type())];                \
+        goto* dispatch_table[static_cast<size_t>(next_instruction.type())];                         \
     } while (0)
 
     for (;;) {
     start:
         for (;;) {
-            goto* bytecode_dispatch_table[static_cast<size_t>((*reinterpret_cast<Instruction const*>(&bytecode[program_counter])).type())];
+            goto* dispatch_table[static_cast<size_t>((*reinterpret_cast<Instruction const*>(&bytecode[program_counter])).type())];
+
+        profile_instruction: {
+            auto type = (*reinterpret_cast<Instruction const*>(&bytecode[program_counter])).type();
+            // The profiler may have been stopped by something this executable called into.
+            if (m_profiler)
+                m_profiler->did_dispatch(type);
+            goto* bytecode_dispatch_table[static_cast<size_t>(type)];
+        }
 
         handle_GetArgument: {
             auto const& instruction = *reinterpret_cast<Op::GetArgument const*>(&bytecode[program_counter]);
@@ -407,7 +483,16 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
         handle_Jump: {
             auto& instruction = *reinterpret_cast<Op::Jump const*>(&bytecode[program_counter]);
-            program_counter = instruction.target().address();
+            auto target = instruction.target().address();
+            if (target <= program_counter) {
+                if (auto const* native_executable = native_executable_if_hot(executable, executable.back_edge_count, jit_back_edge_threshold, m_profiler.ptr())) {
+                    program_counter = target;
+                    if (run_native_code(*native_executable, program_counter))
+                        return;
+                    goto start;
+                }
+            }
+            program_counter = target;
             goto start;
         }
 
@@ -732,8 +817,14 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
         running_execution_context.registers_and_constants_and_locals[executable.number_of_registers + i] = executable.constants[i];
     }
 
+    if (m_profiler)
+        m_profiler->did_enter_bytecode();
+
     run_bytecode(entry_point.value_or(0));
 
+    if (m_profiler)
+        m_profiler->did_leave_bytecode();
+
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
 
     if constexpr (JS_BYTECODE_DEBUG) {
@@ -818,7 +909,7 @@ ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM& vm, ASTNode co
     auto bytecode_executable = executable_result.release_value();
     bytecode_executable->name = name;
 
-    if (Bytecode::g_dump_bytecode)
+    if (Bytecode::g_dump_bytecode || Bytecode::g_dump_bytecode_passes)
         bytecode_executable->dump();
 
     return bytecode_executable;
@@ -835,7 +926,7 @@ ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM& vm, ECMAScript
     auto bytecode_executable = executable_result.release_value();
     bytecode_executable->name = name;
 
-    if (Bytecode::g_dump_bytecode)
+    if (Bytecode::g_dump_bytecode || Bytecode::g_dump_bytecode_passes)
         bytecode_executable->dump();
 
     return bytecode_executable;
@@ -961,6 +1052,35 @@ enum class GetByIdMode {
     Length,
 };
 
+// Returns the entry to fill in after a cache miss on an object with the given shape. An entry that was already used for
+// the shape, but no longer applies, is reused. Otherwise the oldest entry makes room for a new one.
+static PropertyLookupCache::Entry& cache_entry_to_update(PropertyLookupCache& cache, Shape const& shape)
+{
+    for (auto& entry : cache.entries) {
+        auto const& entry_shape = entry.type == PropertyLookupCache::Entry::Type::AddOwnProperty ? entry.from_shape : entry.shape;
+        if (entry.type != PropertyLookupCache::Entry::Type::Empty && entry_shape == &shape) {
+            entry = {};
+            return entry;
+        }
+    }
+    for (size_t i = cache.entries.size() - 1; i > 0; --i)
+        cache.entries[i] = move(cache.entries[i - 1]);
+    cache.entries[0] = {};
+    return cache.entries[0];
+}
+
+// The validity of the prototype chain of objects with the given shape, if it can be tracked.
+static GCPtr<PrototypeChainValidity> prototype_chain_validity_for(Shape const& shape)
+{
+    auto const* prototype = shape.prototype();
+    if (!prototype || !prototype->shape().is_prototype_shape())
+        return nullptr;
+    auto validity = prototype->shape().prototype_chain_validity();
+    if (!validity || !validity->is_valid())
+        return nullptr;
+    return validity;
+}
+
 template<GetByIdMode mode = GetByIdMode::Normal>
 inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex> base_identifier, IdentifierTableIndex property, Value base_value, Value this_value, PropertyLookupCache& cache, Executable const& executable)
 {
@@ -981,44 +1101,51 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
 
     auto& shape = base_obj->shape();
 
-    if (cache.prototype) {
-        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-        bool can_use_cache = [&]() -> bool {
-            if (&shape != cache.shape)
-                return false;
-            if (!cache.prototype_chain_validity)
-                return false;
-            if (!cache.prototype_chain_validity->is_valid())
-                return false;
-            return true;
-        }();
-        if (can_use_cache) {
-            auto value = cache.prototype->get_direct(cache.property_offset.value());
+    for (auto& entry : cache.entries) {
+        if (&shape != entry.shape)
+            continue;
+
+        if (entry.type == PropertyLookupCache::Entry::Type::InPrototypeChain) {
+            // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+            if (!entry.prototype_chain_validity || !entry.prototype_chain_validity->is_valid() || !entry.prototype)
+                continue;
+            ++g_inline_cache_statistics.get_prototype_chain_hits;
+            auto value = entry.prototype->get_direct(entry.property_offset.value());
             if (value.is_accessor())
                 return TRY(call(vm, value.as_accessor().getter(), this_value));
             return value;
         }
-    } else if (&shape == cache.shape) {
+
         // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-        auto value = base_obj->get_direct(cache.property_offset.value());
+        ++g_inline_cache_statistics.get_own_property_hits;
+        auto value = base_obj->get_direct(entry.property_offset.value());
         if (value.is_accessor())
             return TRY(call(vm, value.as_accessor().getter(), this_value));
         return value;
     }
 
+    ++g_inline_cache_statistics.get_misses;
+
     CacheablePropertyMetadata cacheable_metadata;
     auto value = TRY(base_obj->internal_get(executable.get_identifier(property), this_value, &cacheable_metadata));
 
     if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache = {};
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
+        auto& entry = cache_entry_to_update(cache, shape);
+        entry.type = PropertyLookupCache::Entry::Type::OwnProperty;
+        entry.shape = shape;
+        entry.property_offset = cacheable_metadata.property_offset.value();
     } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-        cache = {};
-        cache.shape = &base_obj->shape();
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.prototype = *cacheable_metadata.prototype;
-        cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        // NOTE: The validity of the chain has to start at our own prototype, since any object in between could gain a
+        //       property that shadows the one we found.
+        auto validity = prototype_chain_validity_for(shape);
+        if (validity) {
+            auto& entry = cache_entry_to_update(cache, shape);
+            entry.type = PropertyLookupCache::Entry::Type::InPrototypeChain;
+            entry.shape = shape;
+            entry.property_offset = cacheable_metadata.property_offset.value();
+            entry.prototype = *cacheable_metadata.prototype;
+            entry.prototype_chain_validity = *validity;
+        }
     }
 
     return value;
@@ -1037,10 +1164,17 @@ inline ThrowCompletionOr<Value> get_by_value(VM& vm, Optional<IdentifierTableInd
         if (!object.may_interfere_with_indexed_property_access()
             && object_storage) {
             auto maybe_value = [&] {
-                if (object_storage->is_simple_storage())
+                switch (object_storage->kind()) {
+                case IndexedPropertyStorage::Kind::PackedInt32:
+                    return static_cast<PackedInt32IndexedPropertyStorage const*>(object_storage)->inline_get(index);
+                case IndexedPropertyStorage::Kind::PackedDouble:
+                    return static_cast<PackedDoubleIndexedPropertyStorage const*>(object_storage)->inline_get(index);
+                case IndexedPropertyStorage::Kind::Simple:
                     return static_cast<SimpleIndexedPropertyStorage const*>(object_storage)->inline_get(index);
-                else
+                case IndexedPropertyStorage::Kind::Generic:
                     return static_cast<GenericIndexedPropertyStorage const*>(object_storage)->get(index);
+                }
+                VERIFY_NOT_REACHED();
             }();
             if (maybe_value.has_value()) {
                 auto value = maybe_value->value;
@@ -1111,6 +1245,7 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
         // OPTIMIZATION: For global var bindings, if the shape of the global object hasn't changed,
         //               we can use the cached property offset.
         if (&shape == cache.shape) {
+            ++g_inline_cache_statistics.get_global_hits;
             auto value = binding_object.get_direct(cache.property_offset.value());
             if (value.is_accessor())
                 return TRY(call(vm, value.as_accessor().getter(), js_undefined()));
@@ -1119,10 +1254,13 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
 
         // OPTIMIZATION: For global lexical bindings, if the global declarative environment hasn't changed,
         //               we can use the cached environment binding index.
-        if (cache.environment_binding_index.has_value())
+        if (cache.environment_binding_index.has_value()) {
+            ++g_inline_cache_statistics.get_global_hits;
             return declarative_record.get_binding_value_direct(vm, cache.environment_binding_index.value());
+        }
     }
 
+    ++g_inline_cache_statistics.get_global_misses;
     cache.environment_serial_number = declarative_record.environment_serial_number();
 
     auto& identifier = interpreter.current_executable().get_identifier(identifier_index);
@@ -1156,6 +1294,38 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
     return vm.throw_completion<ReferenceError>(ErrorType::UnknownIdentifier, identifier);
 }
 
+// Whether adding the property to the object by [[Set]] can later be replayed by just changing its shape, for as long as
+// the validity of its prototype chain holds. Nothing in the chain may have the property, or a setter could be skipped.
+static bool can_cache_property_addition_to(Object const& object, PropertyKey const& name)
+{
+    auto const& shape = object.shape();
+    if (!object.can_cache_property_additions() || shape.is_dictionary() || shape.is_prototype_shape())
+        return false;
+    if (!shape.prototype())
+        return true;
+    if (!prototype_chain_validity_for(shape))
+        return false;
+    for (auto const* prototype = shape.prototype(); prototype; prototype = prototype->prototype()) {
+        if (prototype->may_interfere_with_indexed_property_access() || prototype->may_interfere_with_named_property_access())
+            return false;
+        if (prototype->shape().lookup(name.to_string_or_symbol()).has_value())
+            return false;
+    }
+    return true;
+}
+
+static bool did_add_property_by_transition(Shape const& old_shape, Shape const& new_shape, u32 old_property_count, PropertyKey const& name)
+{
+    if (new_shape.is_dictionary() || new_shape.prototype() != old_shape.prototype())
+        return false;
+    if (new_shape.property_count() != old_property_count + 1)
+        return false;
+    auto metadata = new_shape.lookup(name.to_string_or_symbol());
+    return metadata.has_value()
+        && metadata->offset == old_property_count
+        && metadata->attributes == default_attributes;
+}
+
 inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value this_value, Value value, Optional<DeprecatedFlyString const&> const& base_identifier, PropertyKey name, Op::PropertyKind kind, PropertyLookupCache* cache = nullptr)
 {
     // Better error message than to_object would give
@@ -1188,17 +1358,58 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        // NOTE: The cached offsets are only meaningful when we're storing into the object we looked the property up on,
+        //       which isn't the case for super property assignments.
+        if (cache && !(this_value.is_object() && &this_value.as_object() == object.ptr()))
+            cache = nullptr;
+
+        if (cache) {
+            auto& shape = object->shape();
+            for (auto& entry : cache->entries) {
+                if (entry.type == PropertyLookupCache::Entry::Type::OwnProperty && entry.shape == &shape) {
+                    ++g_inline_cache_statistics.put_existing_property_hits;
+                    object->put_direct(*entry.property_offset, value);
+                    return {};
+                }
+
+                if (entry.type == PropertyLookupCache::Entry::Type::AddOwnProperty && entry.from_shape == &shape && entry.shape) {
+                    // OPTIMIZATION: Nothing in the prototype chain may have gained a setter or a read-only property with
+                    //               this name since we last added it to an object with this shape.
+                    if (shape.prototype() && (!entry.prototype_chain_validity || !entry.prototype_chain_validity->is_valid()))
+                        continue;
+                    if (!object->can_cache_property_additions())
+                        continue;
+                    ++g_inline_cache_statistics.put_new_property_hits;
+                    object->add_direct_with_cached_transition(*entry.shape, value);
+                    return {};
+                }
+            }
+            ++g_inline_cache_statistics.put_misses;
         }
 
+        auto& old_shape = object->shape();
+        auto old_property_count = old_shape.property_count();
+        bool can_cache_addition = cache && !name.is_number() && can_cache_property_addition_to(*object, name);
+
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
-        if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+        if (succeeded && cache) {
+            auto& new_shape = object->shape();
+            if (can_cache_addition && &new_shape != &old_shape && did_add_property_by_transition(old_shape, new_shape, old_property_count, name)) {
+                auto& entry = cache_entry_to_update(*cache, old_shape);
+                entry.type = PropertyLookupCache::Entry::Type::AddOwnProperty;
+                entry.from_shape = old_shape;
+                entry.shape = new_shape;
+                entry.property_offset = old_property_count;
+                if (auto validity = prototype_chain_validity_for(old_shape))
+                    entry.prototype_chain_validity = *validity;
+            } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
+                auto& entry = cache_entry_to_update(*cache, new_shape);
+                entry.type = PropertyLookupCache::Entry::Type::OwnProperty;
+                entry.shape = new_shape;
+                entry.property_offset = cacheable_metadata.property_offset.value();
+            }
         }
 
         if (!succeeded && vm.in_strict_mode()) {
@@ -1292,6 +1503,21 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<Depreca
         auto* storage = object.indexed_properties().storage();
         auto index = static_cast<u32>(property_key_value.as_i32());
 
+        // For "non-typed arrays" with packed numeric elements:
+        if (storage
+            && storage->is_packed_numeric_storage()
+            && !object.may_interfere_with_indexed_property_access()
+            && index < storage->array_like_size()) {
+            if (storage->kind() == IndexedPropertyStorage::Kind::PackedInt32 && value.is_int32())
+                static_cast<PackedInt32IndexedPropertyStorage*>(storage)->inline_set(index, value);
+            else if (storage->kind() == IndexedPropertyStorage::Kind::PackedDouble && value.is_number())
+                static_cast<PackedDoubleIndexedPropertyStorage*>(storage)->inline_set(index, value);
+            else
+                object.indexed_properties().put(index, value);
+            object.did_store_reference(value);
+            return {};
+        }
+
         // For "non-typed arrays":
         if (storage
             && storage->is_simple_storage()
@@ -1301,6 +1527,7 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<Depreca
                 auto existing_value = maybe_value->value;
                 if (!existing_value.is_accessor()) {
                     storage->put(index, value);
+                    object.did_store_reference(value);
                     return {};
                 }
             }
@@ -1619,11 +1846,13 @@ inline ThrowCompletionOr<void> append(VM& vm, Value lhs, Value rhs, bool is_spre
         size_t i = lhs_size;
         TRY(get_iterator_values(vm, rhs, [&i, &lhs_array](Value iterator_value) -> Optional<Completion> {
             lhs_array.indexed_properties().put(i, iterator_value, default_attributes);
+            lhs_array.did_store_reference(iterator_value);
             ++i;
             return {};
         }));
     } else {
         lhs_array.indexed_properties().put(lhs_size, rhs, default_attributes);
+        lhs_array.did_store_reference(rhs);
     }
 
     return {};
@@ -18,6 +18,7 @@
 namespace JS::Bytecode {
 
 class InstructionStreamIterator;
+class Profiler;
 
 class Interpreter {
 public:
@@ -56,8 +57,8 @@ public:
         return m_registers_and_constants_and_locals.data()[r.index()];
     }
 
-    [[nodiscard]] Value get(Operand) const;
-    void set(Operand, Value);
+    [[nodiscard]] ALWAYS_INLINE Value get(Operand op) const { return m_registers_and_constants_and_locals.data()[op.index()]; }
+    ALWAYS_INLINE void set(Operand op, Value value) { m_registers_and_constants_and_locals.data()[op.index()] = value; }
 
     Value do_yield(Value value, Optional<Label> continuation);
     void do_return(Value value)
@@ -80,8 +81,14 @@ public:
 
     ExecutionContext& running_execution_context() { return *m_running_execution_context; }
 
+    // While a profiler is attached, executables are only ever interpreted, never run as native code.
+    Profiler* profiler() { return m_profiler.ptr(); }
+    void start_profiling(Duration sample_interval);
+    OwnPtr<Profiler> stop_profiling();
+
 private:
     void run_bytecode(size_t entry_point);
+    [[nodiscard]] bool run_native_code(JIT::NativeExecutable const&, size_t& program_counter);
 
     enum class HandleExceptionResponse {
         ExitFromExecutable,
@@ -99,9 +106,26 @@ private:
     Span<Value> m_arguments;
     Span<Value> m_registers_and_constants_and_locals;
     ExecutionContext* m_running_execution_context { nullptr };
+    OwnPtr<Profiler> m_profiler;
 };
 
 extern bool g_dump_bytecode;
+extern bool g_dump_bytecode_passes;
+extern bool g_disable_bytecode_optimizations;
+extern bool g_disable_jit;
+
+// How the inline caches for named property accesses have fared, for all executables.
+struct InlineCacheStatistics {
+    u64 get_own_property_hits { 0 };
+    u64 get_prototype_chain_hits { 0 };
+    u64 get_misses { 0 };
+    u64 put_existing_property_hits { 0 };
+    u64 put_new_property_hits { 0 };
+    u64 put_misses { 0 };
+    u64 get_global_hits { 0 };
+    u64 get_global_misses { 0 };
+};
+extern InlineCacheStatistics g_inline_cache_statistics;
 
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ASTNode const&, JS::FunctionKind kind, DeprecatedFlyString const& name);
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ECMAScriptFunctionObject const&);
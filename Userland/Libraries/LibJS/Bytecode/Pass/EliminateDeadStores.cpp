@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Bytecode/Register.h>
+
+namespace JS::Bytecode::Passes {
+
+// Instructions that can't throw and have no effect other than writing their destination operand.
+#define ENUMERATE_REMOVABLE_OPS(O) \
+    O(Mov)                         \
+    O(NewArray)                    \
+    O(NewFunction)                 \
+    O(NewObject)                   \
+    O(NewPrimitiveArray)           \
+    O(Not)                         \
+    O(Typeof)
+
+static Optional<Operand> removable_instruction_destination(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+#define __BYTECODE_OP(op)    \
+    case Instruction::Type::op: \
+        return static_cast<Op::op const&>(instruction).dst();
+        ENUMERATE_REMOVABLE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    default:
+        return {};
+    }
+}
+
+static bool is_temporary_register(Operand operand)
+{
+    // The reserved registers are read implicitly by the interpreter.
+    return operand.is_register() && operand.index() >= Register::reserved_register_count;
+}
+
+void EliminateDeadStores::perform(PassPipelineExecutable& executable)
+{
+    // Removing one store may leave the registers it read without readers, so keep going until nothing changes.
+    while (true) {
+        HashTable<u32> read_registers;
+        for (auto& block : executable.basic_blocks) {
+            for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+                auto& instruction = const_cast<Instruction&>(*it);
+                auto destination = removable_instruction_destination(instruction);
+                bool skipped_destination = false;
+                instruction.visit_operands([&](Operand& operand) {
+                    if (destination.has_value() && !skipped_destination && operand == destination.value()) {
+                        skipped_destination = true;
+                        return;
+                    }
+                    if (operand.is_register())
+                        read_registers.set(operand.index());
+                });
+            }
+        }
+
+        auto is_dead = [&](Instruction const& instruction) {
+            auto destination = removable_instruction_destination(instruction);
+            if (!destination.has_value() || !is_temporary_register(destination.value()))
+                return false;
+            if (instruction.type() == Instruction::Type::Mov && static_cast<Op::Mov const&>(instruction).src() == destination.value())
+                return true;
+            return !read_registers.contains(destination->index());
+        };
+
+        bool did_remove_anything = false;
+        for (auto& block : executable.basic_blocks) {
+            bool block_has_dead_stores = false;
+            for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+                if (is_dead(*it)) {
+                    block_has_dead_stores = true;
+                    break;
+                }
+            }
+            if (!block_has_dead_stores)
+                continue;
+
+            InstructionStreamRewriter rewriter(*block);
+            Vector<Instruction*> dead_stores;
+            for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+                if (is_dead(*it))
+                    dead_stores.append(const_cast<Instruction*>(&*it));
+                else
+                    rewriter.append(*block, *it);
+            }
+            for (auto* instruction : dead_stores)
+                Instruction::destroy(*instruction);
+            rewriter.commit();
+            did_remove_anything = true;
+        }
+
+        if (!did_remove_anything)
+            break;
+    }
+}
+
+}
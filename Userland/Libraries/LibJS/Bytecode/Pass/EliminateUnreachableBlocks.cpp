@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void EliminateUnreachableBlocks::perform(PassPipelineExecutable& executable)
+{
+    VERIFY(executable.cfg.has_value());
+
+    auto& basic_blocks = executable.basic_blocks;
+    if (basic_blocks.is_empty())
+        return;
+
+    HashTable<BasicBlock const*> reachable_blocks;
+    Vector<BasicBlock const*> worklist;
+    worklist.append(basic_blocks.first().ptr());
+    while (!worklist.is_empty()) {
+        auto const* block = worklist.take_last();
+        if (reachable_blocks.set(block) != HashSetResult::InsertedNewEntry)
+            continue;
+        for (auto const* successor : executable.cfg->get(block).value())
+            worklist.append(successor);
+    }
+
+    if (reachable_blocks.size() == basic_blocks.size())
+        return;
+
+    // Labels refer to blocks by index, so compact the list and renumber everything that's left.
+    Vector<Optional<u32>> new_indices;
+    new_indices.resize(basic_blocks.size());
+
+    Vector<NonnullOwnPtr<BasicBlock>> surviving_blocks;
+    surviving_blocks.ensure_capacity(reachable_blocks.size());
+    for (size_t i = 0; i < basic_blocks.size(); ++i) {
+        if (!reachable_blocks.contains(basic_blocks[i].ptr()))
+            continue;
+        new_indices[i] = surviving_blocks.size();
+        surviving_blocks.append(move(basic_blocks[i]));
+    }
+
+    for (auto& block : surviving_blocks) {
+        block->set_index(new_indices[block->index()].value());
+
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) {
+                label = Label { new_indices[label.basic_block_index()].value() };
+            });
+            ++it;
+        }
+    }
+
+    // NOTE: This destroys the unreachable blocks that are still left behind in the old list.
+    basic_blocks = move(surviving_blocks);
+    executable.invalidate_cfg();
+}
+
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Bytecode/Register.h>
+#include <LibJS/Runtime/ValueInlines.h>
+
+namespace JS::Bytecode::Passes {
+
+// Only fold values that none of the operators below can throw on, call into user code for, or allocate for.
+static bool is_foldable(Value value)
+{
+    return value.is_number() || value.is_boolean() || value.is_nullish();
+}
+
+static Optional<Value> fold_binary_operation(VM& vm, Instruction::Type type, Value lhs, Value rhs)
+{
+    if (!is_foldable(lhs) || !is_foldable(rhs))
+        return {};
+
+    switch (type) {
+#define __FOLD_BINARY_OP(OpTitleCase, op_snake_case) \
+    case Instruction::Type::OpTitleCase:             \
+        return MUST(op_snake_case(vm, lhs, rhs));
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__FOLD_BINARY_OP)
+        __FOLD_BINARY_OP(Div, div)
+        __FOLD_BINARY_OP(Exp, exp)
+        __FOLD_BINARY_OP(Mod, mod)
+#undef __FOLD_BINARY_OP
+    case Instruction::Type::LooselyEquals:
+        return Value(MUST(is_loosely_equal(vm, lhs, rhs)));
+    case Instruction::Type::LooselyInequals:
+        return Value(!MUST(is_loosely_equal(vm, lhs, rhs)));
+    case Instruction::Type::StrictlyEquals:
+        return Value(is_strictly_equal(lhs, rhs));
+    case Instruction::Type::StrictlyInequals:
+        return Value(!is_strictly_equal(lhs, rhs));
+    default:
+        return {};
+    }
+}
+
+static Optional<Value> fold_unary_operation(VM& vm, Instruction::Type type, Value value)
+{
+    if (!is_foldable(value))
+        return {};
+
+    switch (type) {
+    case Instruction::Type::BitwiseNot:
+        return MUST(bitwise_not(vm, value));
+    case Instruction::Type::Not:
+        return Value(!value.to_boolean());
+    case Instruction::Type::UnaryMinus:
+        return MUST(unary_minus(vm, value));
+    case Instruction::Type::UnaryPlus:
+        return MUST(unary_plus(vm, value));
+    default:
+        return {};
+    }
+}
+
+static bool is_temporary_register(Operand operand)
+{
+    return operand.is_register() && operand.index() >= Register::reserved_register_count;
+}
+
+void FoldConstants::perform(PassPipelineExecutable& executable)
+{
+    auto& generator = executable.generator;
+    auto& vm = generator.vm();
+    bool did_change_control_flow = false;
+
+    for (auto& block : executable.basic_blocks) {
+        // Temporary registers that currently hold a constant, from a Mov earlier in this block.
+        HashMap<u32, Operand> known_constants;
+
+        auto resolve = [&](Operand operand) -> Optional<Operand> {
+            if (operand.is_constant())
+                return operand;
+            if (is_temporary_register(operand))
+                return known_constants.get(operand.index()).copy();
+            return {};
+        };
+        auto resolve_value = [&](Operand operand) -> Optional<Value> {
+            auto constant = resolve(operand);
+            if (!constant.has_value())
+                return {};
+            return generator.get_constant(constant.value());
+        };
+        auto did_write = [&](Operand destination, Optional<Operand> constant = {}) {
+            if (!is_temporary_register(destination))
+                return;
+            if (constant.has_value())
+                known_constants.set(destination.index(), constant.value());
+            else
+                known_constants.remove(destination.index());
+        };
+
+        InstructionStreamRewriter rewriter(*block);
+        Vector<Instruction*> replaced_instructions;
+
+        auto replace_with_mov = [&](Instruction const& instruction, Operand destination, Value value) {
+            auto constant = generator.add_constant(value).operand();
+            rewriter.emit<Op::Mov>(*block, instruction, destination, constant);
+            replaced_instructions.append(const_cast<Instruction*>(&instruction));
+            did_write(destination, constant);
+        };
+        auto replace_with_jump = [&](Instruction const& instruction, Label target) {
+            rewriter.emit<Op::Jump>(*block, instruction, target);
+            replaced_instructions.append(const_cast<Instruction*>(&instruction));
+            did_change_control_flow = true;
+        };
+
+        for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+            auto const& instruction = *it;
+
+            switch (instruction.type()) {
+            case Instruction::Type::Mov: {
+                auto const& mov = static_cast<Op::Mov const&>(instruction);
+                auto constant = resolve(mov.src());
+                if (constant.has_value() && !mov.src().is_constant()) {
+                    // Propagate the constant, so the register it came from may become dead.
+                    rewriter.emit<Op::Mov>(*block, instruction, mov.dst(), constant.value());
+                    replaced_instructions.append(const_cast<Instruction*>(&instruction));
+                } else {
+                    rewriter.append(*block, instruction);
+                }
+                did_write(mov.dst(), constant);
+                continue;
+            }
+
+#define __HANDLE_BINARY_OP(OpTitleCase, op_snake_case)                                              \
+    case Instruction::Type::OpTitleCase: {                                                          \
+        auto const& operation = static_cast<Op::OpTitleCase const&>(instruction);                   \
+        auto lhs = resolve_value(operation.lhs());                                                  \
+        auto rhs = resolve_value(operation.rhs());                                                  \
+        if (lhs.has_value() && rhs.has_value()) {                                                   \
+            if (auto result = fold_binary_operation(vm, instruction.type(), *lhs, *rhs); result.has_value()) { \
+                replace_with_mov(instruction, operation.dst(), *result);                            \
+                continue;                                                                           \
+            }                                                                                       \
+        }                                                                                           \
+        rewriter.append(*block, instruction);                                                       \
+        did_write(operation.dst());                                                                 \
+        continue;                                                                                   \
+    }
+                JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__HANDLE_BINARY_OP)
+                JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__HANDLE_BINARY_OP)
+#undef __HANDLE_BINARY_OP
+
+#define __HANDLE_UNARY_OP(OpTitleCase, op_snake_case)                                         \
+    case Instruction::Type::OpTitleCase: {                                                    \
+        auto const& operation = static_cast<Op::OpTitleCase const&>(instruction);             \
+        if (auto value = resolve_value(operation.src()); value.has_value()) {                 \
+            if (auto result = fold_unary_operation(vm, instruction.type(), *value); result.has_value()) { \
+                replace_with_mov(instruction, operation.dst(), *result);                      \
+                continue;                                                                     \
+            }                                                                                 \
+        }                                                                                     \
+        rewriter.append(*block, instruction);                                                 \
+        did_write(operation.dst());                                                           \
+        continue;                                                                             \
+    }
+                JS_ENUMERATE_COMMON_UNARY_OPS(__HANDLE_UNARY_OP)
+#undef __HANDLE_UNARY_OP
+
+            case Instruction::Type::JumpIf: {
+                auto const& jump = static_cast<Op::JumpIf const&>(instruction);
+                if (auto condition = resolve_value(jump.condition()); condition.has_value() && !condition->is_empty()) {
+                    replace_with_jump(instruction, condition->to_boolean() ? jump.true_target() : jump.false_target());
+                    continue;
+                }
+                break;
+            }
+
+            case Instruction::Type::JumpNullish: {
+                auto const& jump = static_cast<Op::JumpNullish const&>(instruction);
+                if (auto condition = resolve_value(jump.condition()); condition.has_value() && !condition->is_empty()) {
+                    replace_with_jump(instruction, condition->is_nullish() ? jump.true_target() : jump.false_target());
+                    continue;
+                }
+                break;
+            }
+
+            case Instruction::Type::JumpUndefined: {
+                auto const& jump = static_cast<Op::JumpUndefined const&>(instruction);
+                if (auto condition = resolve_value(jump.condition()); condition.has_value() && !condition->is_empty()) {
+                    replace_with_jump(instruction, condition->is_undefined() ? jump.true_target() : jump.false_target());
+                    continue;
+                }
+                break;
+            }
+
+#define __HANDLE_COMPARISON_JUMP(op_TitleCase, op_snake_case, numeric_operator)                                          \
+    case Instruction::Type::Jump##op_TitleCase: {                                                                       \
+        auto const& jump = static_cast<Op::Jump##op_TitleCase const&>(instruction);                                     \
+        auto lhs = resolve_value(jump.lhs());                                                                           \
+        auto rhs = resolve_value(jump.rhs());                                                                           \
+        if (lhs.has_value() && rhs.has_value()) {                                                                       \
+            if (auto result = fold_binary_operation(vm, Instruction::Type::op_TitleCase, *lhs, *rhs); result.has_value()) { \
+                replace_with_jump(instruction, result->as_bool() ? jump.true_target() : jump.false_target());           \
+                continue;                                                                                               \
+            }                                                                                                           \
+        }                                                                                                               \
+        break;                                                                                                          \
+    }
+                JS_ENUMERATE_COMPARISON_OPS(__HANDLE_COMPARISON_JUMP)
+#undef __HANDLE_COMPARISON_JUMP
+
+            default:
+                break;
+            }
+
+            // We don't know which operands an arbitrary instruction writes to, so forget everything it touches.
+            rewriter.append(*block, instruction);
+            const_cast<Instruction&>(instruction).visit_operands([&](Operand& operand) {
+                did_write(operand);
+            });
+        }
+
+        if (replaced_instructions.is_empty())
+            continue;
+
+        for (auto* instruction : replaced_instructions)
+            Instruction::destroy(*instruction);
+        rewriter.commit();
+    }
+
+    if (did_change_control_flow)
+        executable.invalidate_cfg();
+}
+
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void GenerateCFG::perform(PassPipelineExecutable& executable)
+{
+    HashMap<BasicBlock const*, HashTable<BasicBlock const*>> cfg;
+    HashMap<BasicBlock const*, HashTable<BasicBlock const*>> inverted_cfg;
+
+    for (auto& block : executable.basic_blocks) {
+        cfg.ensure(block.ptr());
+        inverted_cfg.ensure(block.ptr());
+    }
+
+    auto add_edge = [&](BasicBlock const& from, BasicBlock const& to) {
+        cfg.get(&from)->set(&to);
+        inverted_cfg.get(&to)->set(&from);
+    };
+
+    for (auto& block : executable.basic_blocks) {
+        // NOTE: Every label counts as an edge, including the continuation of a Yield or Await
+        //       and the targets of ScheduleJump, as the interpreter may resume execution there.
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) {
+                add_edge(*block, *executable.basic_blocks[label.basic_block_index()]);
+            });
+            ++it;
+        }
+
+        // An instruction anywhere in the block may throw, and unwinding may run the finalizer.
+        if (auto const* handler = block->handler())
+            add_edge(*block, *handler);
+        if (auto const* finalizer = block->finalizer())
+            add_edge(*block, *finalizer);
+    }
+
+    executable.cfg = move(cfg);
+    executable.inverted_cfg = move(inverted_cfg);
+}
+
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static Instruction const* terminator_of(BasicBlock const& block)
+{
+    if (!block.is_terminated())
+        return nullptr;
+    return reinterpret_cast<Instruction const*>(block.data() + block.last_instruction_start_offset());
+}
+
+void MergeBlocks::perform(PassPipelineExecutable& executable)
+{
+    VERIFY(executable.cfg.has_value());
+    auto& cfg = executable.cfg.value();
+    auto& inverted_cfg = executable.inverted_cfg.value();
+    auto& basic_blocks = executable.basic_blocks;
+
+    // Blocks that code jumps to when unwinding have to stay where they are.
+    HashTable<BasicBlock const*> unwind_targets;
+    for (auto& block : basic_blocks) {
+        if (auto const* handler = block->handler())
+            unwind_targets.set(handler);
+        if (auto const* finalizer = block->finalizer())
+            unwind_targets.set(finalizer);
+    }
+
+    auto successor_to_merge = [&](BasicBlock& block) -> BasicBlock* {
+        auto const* terminator = terminator_of(block);
+        if (!terminator || terminator->type() != Instruction::Type::Jump)
+            return nullptr;
+
+        auto target_index = static_cast<Op::Jump const&>(*terminator).target().basic_block_index();
+        auto& successor = *basic_blocks[target_index];
+        if (&successor == &block || target_index == 0 || unwind_targets.contains(&successor))
+            return nullptr;
+
+        // The successor must run with the same exception handler and finalizer as the code it's appended to.
+        if (successor.handler() != block.handler() || successor.finalizer() != block.finalizer())
+            return nullptr;
+
+        auto const& predecessors = inverted_cfg.get(&successor).value();
+        if (predecessors.size() != 1 || !predecessors.contains(&block))
+            return nullptr;
+        return &successor;
+    };
+
+    for (auto& block : basic_blocks) {
+        while (auto* successor = successor_to_merge(*block)) {
+            auto const* jump = terminator_of(*block);
+
+            InstructionStreamRewriter rewriter(*block);
+            for (InstructionStreamIterator it(block->instruction_stream()); !it.at_end(); ++it) {
+                if (&*it != jump)
+                    rewriter.append(*block, *it);
+            }
+            for (InstructionStreamIterator it(successor->instruction_stream()); !it.at_end(); ++it)
+                rewriter.append(*successor, *it);
+            Instruction::destroy(const_cast<Instruction&>(*jump));
+            rewriter.commit();
+
+            // The instructions now live in `block`, so leave the successor empty; it no longer has any predecessors.
+            InstructionStreamRewriter(*successor).commit();
+
+            auto successors_of_successor = cfg.take(successor).value();
+            for (auto const* next : successors_of_successor) {
+                auto& next_predecessors = inverted_cfg.get(next).value();
+                next_predecessors.remove(successor);
+                next_predecessors.set(block.ptr());
+            }
+            cfg.set(block.ptr(), move(successors_of_successor));
+            cfg.set(successor, {});
+            inverted_cfg.set(successor, {});
+        }
+    }
+}
+
+}
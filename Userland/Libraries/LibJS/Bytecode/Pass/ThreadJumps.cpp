@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static Optional<size_t> jump_target_if_trampoline(BasicBlock const& block)
+{
+    if (block.size() == 0)
+        return {};
+    InstructionStreamIterator it(block.instruction_stream());
+    auto const& instruction = *it;
+    if (instruction.type() != Instruction::Type::Jump || instruction.length() != block.size())
+        return {};
+    return static_cast<Op::Jump const&>(instruction).target().basic_block_index();
+}
+
+void ThreadJumps::perform(PassPipelineExecutable& executable)
+{
+    auto& basic_blocks = executable.basic_blocks;
+
+    // Where a jump to each block ends up after following any chain of blocks that only contain a Jump.
+    Vector<size_t> final_targets;
+    final_targets.ensure_capacity(basic_blocks.size());
+    for (size_t i = 0; i < basic_blocks.size(); ++i) {
+        auto target = i;
+        HashTable<size_t> seen;
+        while (true) {
+            auto next = jump_target_if_trampoline(*basic_blocks[target]);
+            if (!next.has_value())
+                break;
+            // A chain of trampolines that loops back on itself is an infinite loop, leave it alone.
+            if (seen.set(target) != HashSetResult::InsertedNewEntry)
+                break;
+            target = next.value();
+        }
+        final_targets.unchecked_append(target);
+    }
+
+    bool did_change_control_flow = false;
+    for (auto& block : basic_blocks) {
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) {
+                auto final_target = final_targets[label.basic_block_index()];
+                if (final_target == label.basic_block_index())
+                    return;
+                label = Label { static_cast<u32>(final_target) };
+                did_change_control_flow = true;
+            });
+            ++it;
+        }
+
+        if (!block->is_terminated() || block->size() == 0)
+            continue;
+
+        // A JumpIf that goes to the same place either way is just a Jump.
+        auto& terminator = *reinterpret_cast<Instruction const*>(block->data() + block->last_instruction_start_offset());
+        if (terminator.type() != Instruction::Type::JumpIf)
+            continue;
+        auto const& jump_if = static_cast<Op::JumpIf const&>(terminator);
+        if (jump_if.true_target().basic_block_index() != jump_if.false_target().basic_block_index())
+            continue;
+
+        InstructionStreamRewriter rewriter(*block);
+        InstructionStreamIterator rewrite_it(block->instruction_stream());
+        while (!rewrite_it.at_end()) {
+            auto const& instruction = *rewrite_it;
+            if (&instruction == &terminator)
+                rewriter.emit<Op::Jump>(*block, instruction, jump_if.true_target());
+            else
+                rewriter.append(*block, instruction);
+            ++rewrite_it;
+        }
+        Instruction::destroy(const_cast<Instruction&>(terminator));
+        rewriter.commit();
+        did_change_control_flow = true;
+    }
+
+    if (did_change_control_flow)
+        executable.invalidate_cfg();
+}
+
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode {
+
+NonnullOwnPtr<PassManager> PassManager::create_optimization_pipeline()
+{
+    auto pipeline = make<PassManager>();
+    pipeline->add<Passes::FoldConstants>();
+    pipeline->add<Passes::ThreadJumps>();
+    pipeline->add<Passes::GenerateCFG>();
+    pipeline->add<Passes::EliminateUnreachableBlocks>();
+    pipeline->add<Passes::GenerateCFG>();
+    pipeline->add<Passes::MergeBlocks>();
+    pipeline->add<Passes::GenerateCFG>();
+    pipeline->add<Passes::EliminateUnreachableBlocks>();
+    pipeline->add<Passes::EliminateDeadStores>();
+    return pipeline;
+}
+
+static size_t total_size(Vector<NonnullOwnPtr<BasicBlock>> const& basic_blocks)
+{
+    size_t size = 0;
+    for (auto const& block : basic_blocks)
+        size += block->size();
+    return size;
+}
+
+void PassManager::perform(PassPipelineExecutable& executable)
+{
+    started();
+    m_statistics.clear_with_capacity();
+    for (auto& pass : m_passes) {
+        Statistics statistics {
+            .pass_name = pass->name(),
+            .elapsed = {},
+            .blocks_before = executable.basic_blocks.size(),
+            .bytes_before = total_size(executable.basic_blocks),
+        };
+
+        pass->started();
+        pass->perform(executable);
+        pass->finished();
+
+        statistics.elapsed = pass->elapsed();
+        statistics.blocks_after = executable.basic_blocks.size();
+        statistics.bytes_after = total_size(executable.basic_blocks);
+        m_statistics.append(statistics);
+    }
+    finished();
+}
+
+void PassManager::dump_statistics() const
+{
+    warnln("\033[37;1mBytecode optimization pipeline\033[0m ({}us)", elapsed().to_microseconds());
+    for (auto const& statistics : m_statistics) {
+        warnln("    {:28} {:6}us  {:4} -> {:4} blocks  {:6} -> {:6} bytes",
+            statistics.pass_name,
+            statistics.elapsed.to_microseconds(),
+            statistics.blocks_before,
+            statistics.blocks_after,
+            statistics.bytes_before,
+            statistics.bytes_after);
+    }
+    warnln("");
+}
+
+Optional<SourceRecord> InstructionStreamRewriter::source_record_for(BasicBlock const& source, Instruction const& instruction)
+{
+    auto offset = bit_cast<FlatPtr>(&instruction) - bit_cast<FlatPtr>(source.data());
+    return source.source_map().get(offset).copy();
+}
+
+void InstructionStreamRewriter::append(BasicBlock const& source, Instruction const& instruction)
+{
+    auto source_record = source_record_for(source, instruction);
+    size_t slot_offset = m_buffer.size();
+    m_buffer.append(reinterpret_cast<u8 const*>(&instruction), instruction.length());
+    did_append(slot_offset, source_record, instruction.is_terminator());
+}
+
+void InstructionStreamRewriter::did_append(size_t offset, Optional<SourceRecord> source_record, bool is_terminator)
+{
+    VERIFY(!m_terminated);
+    m_last_instruction_start_offset = offset;
+    if (source_record.has_value())
+        m_source_map.set(offset, source_record.value());
+    m_terminated = is_terminator;
+}
+
+void InstructionStreamRewriter::commit()
+{
+    m_block.m_buffer = move(m_buffer);
+    m_block.m_source_map = move(m_source_map);
+    m_block.m_last_instruction_start_offset = m_last_instruction_start_offset;
+    m_block.m_terminated = m_terminated;
+}
+
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+// The basic blocks of an executable that is still being generated.
+// Labels refer to blocks by index and operands have not been rebased onto the register file yet.
+struct PassPipelineExecutable {
+    Generator& generator;
+    Vector<NonnullOwnPtr<BasicBlock>>& basic_blocks;
+
+    // Filled in by Passes::GenerateCFG, and reset by every pass that changes control flow.
+    // Edges include exception handlers and finalizers, so that every block reachable at runtime is reachable here.
+    Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> cfg {};
+    Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> inverted_cfg {};
+
+    void invalidate_cfg()
+    {
+        cfg.clear();
+        inverted_cfg.clear();
+    }
+};
+
+class Pass {
+public:
+    Pass() = default;
+    virtual ~Pass() = default;
+
+    virtual StringView name() const = 0;
+    virtual void perform(PassPipelineExecutable&) = 0;
+
+    void started() { m_timer.start(); }
+    void finished() { m_time_difference = m_timer.elapsed_time(); }
+
+    Duration elapsed() const { return m_time_difference; }
+
+protected:
+    Core::ElapsedTimer m_timer { Core::TimerType::Precise };
+    Duration m_time_difference {};
+};
+
+class PassManager : public Pass {
+public:
+    PassManager() = default;
+    ~PassManager() override = default;
+
+    // The pipeline every executable goes through after code generation, unless g_disable_bytecode_optimizations is set.
+    static NonnullOwnPtr<PassManager> create_optimization_pipeline();
+
+    void add(NonnullOwnPtr<Pass> pass) { m_passes.append(move(pass)); }
+
+    template<typename PassT, typename... Args>
+    void add(Args&&... args) { m_passes.append(make<PassT>(forward<Args>(args)...)); }
+
+    virtual StringView name() const override { return "PassManager"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+
+    // Prints how long each pass took and how it changed the size of the executable.
+    void dump_statistics() const;
+
+private:
+    struct Statistics {
+        StringView pass_name;
+        Duration elapsed;
+        size_t blocks_before { 0 };
+        size_t bytes_before { 0 };
+        size_t blocks_after { 0 };
+        size_t bytes_after { 0 };
+    };
+
+    Vector<NonnullOwnPtr<Pass>> m_passes;
+    Vector<Statistics> m_statistics;
+};
+
+// Accumulates a new instruction stream for a block, so passes can replace, drop and append instructions.
+// Instructions are trivially relocatable, so kept instructions are copied byte for byte.
+class InstructionStreamRewriter {
+public:
+    explicit InstructionStreamRewriter(BasicBlock& block)
+        : m_block(block)
+    {
+    }
+
+    // Appends an instruction from `source` (usually the block being rewritten) unchanged.
+    void append(BasicBlock const& source, Instruction const&);
+
+    // Appends a new instruction that takes over the source range of `origin`.
+    template<typename OpType, typename... Args>
+    void emit(BasicBlock const& source, Instruction const& origin, Args&&... args)
+    {
+        auto source_record = source_record_for(source, origin);
+        size_t slot_offset = m_buffer.size();
+        m_buffer.resize(slot_offset + sizeof(OpType));
+        new (m_buffer.data() + slot_offset) OpType(forward<Args>(args)...);
+        did_append(slot_offset, source_record, OpType::IsTerminator);
+    }
+
+    // Replaces the block's instruction stream with the new one. Instructions that were not carried over
+    // must have been destroyed by the pass, and blocks whose instructions were moved elsewhere must be cleared.
+    void commit();
+
+private:
+    static Optional<SourceRecord> source_record_for(BasicBlock const&, Instruction const&);
+    void did_append(size_t offset, Optional<SourceRecord>, bool is_terminator);
+
+    BasicBlock& m_block;
+    Vector<u8> m_buffer;
+    HashMap<size_t, SourceRecord> m_source_map;
+    size_t m_last_instruction_start_offset { 0 };
+    bool m_terminated { false };
+};
+
+namespace Passes {
+
+class GenerateCFG : public Pass {
+public:
+    GenerateCFG() = default;
+    ~GenerateCFG() override = default;
+
+    virtual StringView name() const override { return "GenerateCFG"sv; }
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Folds arithmetic, comparisons and conditional jumps on constant operands, tracking registers that
+// were loaded with a constant earlier in the same block.
+class FoldConstants : public Pass {
+public:
+    FoldConstants() = default;
+    ~FoldConstants() override = default;
+
+    virtual StringView name() const override { return "FoldConstants"sv; }
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Retargets jumps that lead to a block consisting of nothing but another jump.
+class ThreadJumps : public Pass {
+public:
+    ThreadJumps() = default;
+    ~ThreadJumps() override = default;
+
+    virtual StringView name() const override { return "ThreadJumps"sv; }
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Requires the CFG. Removes blocks that can't be reached from the entry block and renumbers the rest.
+class EliminateUnreachableBlocks : public Pass {
+public:
+    EliminateUnreachableBlocks() = default;
+    ~EliminateUnreachableBlocks() override = default;
+
+    virtual StringView name() const override { return "EliminateUnreachableBlocks"sv; }
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Requires the CFG. Appends a block to its only predecessor when that predecessor unconditionally jumps to it.
+class MergeBlocks : public Pass {
+public:
+    MergeBlocks() = default;
+    ~MergeBlocks() override = default;
+
+    virtual StringView name() const override { return "MergeBlocks"sv; }
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Removes side-effect free instructions whose destination is a temporary register that is never read.
+class EliminateDeadStores : public Pass {
+public:
+    EliminateDeadStores() = default;
+    ~EliminateDeadStores() override = default;
+
+    virtual StringView name() const override { return "EliminateDeadStores"sv; }
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+}
+
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <AK/Stream.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Profiler.h>
+#include <LibJS/Runtime/ECMAScriptFunctionObject.h>
+#include <LibJS/Runtime/ExecutionContext.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/SourceCode.h>
+
+namespace JS::Bytecode {
+
+static constexpr StringView instruction_type_names[] = {
+#define __BYTECODE_OP(op) #op##sv,
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+};
+
+Profiler::Profiler(VM& vm, Duration sample_interval)
+    : m_vm(vm)
+    , m_sample_interval(sample_interval)
+{
+    VERIFY(sample_interval > Duration::zero());
+}
+
+Profiler::~Profiler() = default;
+
+void Profiler::did_leave_bytecode()
+{
+    if (m_bytecode_depth > 0)
+        --m_bytecode_depth;
+    if (m_bytecode_depth > 0)
+        return;
+
+    // Whatever happens until JS runs again (e.g. an idle event loop) shouldn't be blamed on the last instruction or the next sample.
+    auto now = MonotonicTime::now();
+    if (m_current_instruction.has_value())
+        m_instruction_statistics[to_underlying(*m_current_instruction)].time += now - m_current_instruction_start;
+    m_current_instruction.clear();
+
+    if (m_last_sample_time.has_value())
+        m_time_since_last_sample = now - *m_last_sample_time;
+    m_last_sample_time.clear();
+}
+
+void Profiler::take_sample(MonotonicTime now)
+{
+    auto intervals = (now - *m_last_sample_time).to_nanoseconds() / m_sample_interval.to_nanoseconds();
+    *m_last_sample_time += Duration::from_nanoseconds(intervals * m_sample_interval.to_nanoseconds());
+
+    StringBuilder builder;
+    for (auto const* context : m_vm.execution_context_stack()) {
+        // Skip contexts that never run any code themselves, like the one a realm is created in.
+        if (!context->function && !context->executable)
+            continue;
+        if (!builder.is_empty())
+            builder.append(';');
+        builder.append(label_for(*context));
+    }
+    if (builder.is_empty())
+        return;
+
+    m_samples_by_stack.ensure(builder.to_byte_string()) += intervals;
+    m_sample_count += intervals;
+}
+
+// Frames are separated by ';' and the count by the last space in the collapsed stack format, so keep ';' out of labels.
+static ByteString sanitized_label(ByteString const& label)
+{
+    return label.replace(";"sv, ","sv, ReplaceMode::All).replace("\n"sv, " "sv, ReplaceMode::All);
+}
+
+ByteString const& Profiler::label_for(ExecutionContext const& context)
+{
+    if (context.function && is<ECMAScriptFunctionObject>(*context.function)) {
+        auto const& function = static_cast<ECMAScriptFunctionObject const&>(*context.function);
+        auto const& code = function.ecmascript_code();
+        auto& function_label = m_function_labels.ensure(&code, [&] {
+            auto name = function.name().is_empty() ? "(anonymous)"sv : function.name().view();
+            auto source_range = code.source_range();
+            auto label = ByteString::formatted("{} ({}:{}:{})", name, source_range.filename(), source_range.start.line, source_range.start.column);
+            return FunctionLabel { code, sanitized_label(label) };
+        });
+        return function_label.label;
+    }
+
+    if (context.function) {
+        auto const& name = context.function->name();
+        m_scratch_label = sanitized_label(ByteString::formatted("{} [native]", name.is_empty() ? "(anonymous)"sv : name.view()));
+    } else {
+        m_scratch_label = sanitized_label(ByteString::formatted("(top-level) ({})", context.executable->source_code->filename()));
+    }
+    return m_scratch_label;
+}
+
+ErrorOr<void> Profiler::write_collapsed_stacks(Stream& stream) const
+{
+    Vector<ByteString const*> stacks;
+    TRY(stacks.try_ensure_capacity(m_samples_by_stack.size()));
+    for (auto const& it : m_samples_by_stack)
+        stacks.unchecked_append(&it.key);
+    quick_sort(stacks, [](auto const* a, auto const* b) { return *a < *b; });
+
+    for (auto const* stack : stacks)
+        TRY(stream.write_formatted("{} {}\n", *stack, m_samples_by_stack.get(*stack).value()));
+    return {};
+}
+
+ErrorOr<void> Profiler::write_instruction_statistics(Stream& stream) const
+{
+    Vector<size_t> types;
+    Duration total_time;
+    for (size_t i = 0; i < instruction_type_count; ++i) {
+        if (m_instruction_statistics[i].count == 0)
+            continue;
+        TRY(types.try_append(i));
+        total_time += m_instruction_statistics[i].time;
+    }
+    quick_sort(types, [&](size_t a, size_t b) { return m_instruction_statistics[a].time > m_instruction_statistics[b].time; });
+
+    TRY(stream.write_formatted("{:<36} {:>14} {:>12} {:>10} {:>7}\n", "Instruction", "Count", "Time (ms)", "ns/op", "Time %"));
+    for (auto type : types) {
+        auto const& statistics = m_instruction_statistics[type];
+        auto nanoseconds = statistics.time.to_nanoseconds();
+        auto percentage = total_time.is_zero() ? 0.0 : 100.0 * nanoseconds / total_time.to_nanoseconds();
+        TRY(stream.write_formatted("{:<36} {:>14} {:>12.3} {:>10} {:>6.2}%\n",
+            instruction_type_names[type],
+            statistics.count,
+            nanoseconds / 1'000'000.0,
+            nanoseconds / static_cast<i64>(statistics.count),
+            percentage));
+    }
+    return {};
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+// Records where the bytecode interpreter spends its time, while it's attached to an Interpreter.
+//
+// Rather than relying on a timer signal, the interpreter reports every instruction it dispatches,
+// and a sample of the JS call stack is taken on the first dispatch after each sample interval.
+// A sample is weighted by the number of intervals that have passed since the last one, so time
+// spent in native code is blamed on the function that called into it.
+class Profiler {
+    AK_MAKE_NONCOPYABLE(Profiler);
+    AK_MAKE_NONMOVABLE(Profiler);
+
+public:
+    static constexpr Duration default_sample_interval = Duration::from_milliseconds(1);
+
+    Profiler(VM&, Duration sample_interval);
+    ~Profiler();
+
+    Duration sample_interval() const { return m_sample_interval; }
+
+    ALWAYS_INLINE void did_dispatch(Instruction::Type type)
+    {
+        auto now = MonotonicTime::now();
+        if (m_current_instruction.has_value())
+            m_instruction_statistics[to_underlying(*m_current_instruction)].time += now - m_current_instruction_start;
+        m_current_instruction = type;
+        m_current_instruction_start = now;
+        ++m_instruction_statistics[to_underlying(type)].count;
+
+        if (!m_last_sample_time.has_value())
+            m_last_sample_time = now - m_time_since_last_sample;
+        if (now - *m_last_sample_time >= m_sample_interval)
+            take_sample(now);
+    }
+
+    void did_enter_bytecode() { ++m_bytecode_depth; }
+    void did_leave_bytecode();
+
+    size_t sample_count() const { return m_sample_count; }
+
+    // One line per distinct call stack, outermost frame first, in the format that flamegraph.pl and speedscope read.
+    ErrorOr<void> write_collapsed_stacks(Stream&) const;
+    ErrorOr<void> write_instruction_statistics(Stream&) const;
+
+private:
+    void take_sample(MonotonicTime now);
+    ByteString const& label_for(ExecutionContext const&);
+
+    struct InstructionStatistics {
+        u64 count { 0 };
+        Duration time;
+    };
+
+#define __BYTECODE_OP(op) +1
+    static constexpr size_t instruction_type_count = 0 ENUMERATE_BYTECODE_OPS(__BYTECODE_OP);
+#undef __BYTECODE_OP
+
+    VM& m_vm;
+    Duration m_sample_interval;
+
+    AK::Array<InstructionStatistics, instruction_type_count> m_instruction_statistics {};
+    Optional<Instruction::Type> m_current_instruction;
+    MonotonicTime m_current_instruction_start { MonotonicTime::now() };
+
+    // While no bytecode is running, the sample clock is stopped and only remembers how far into the interval it got.
+    Optional<MonotonicTime> m_last_sample_time;
+    Duration m_time_since_last_sample;
+    size_t m_bytecode_depth { 0 };
+    size_t m_sample_count { 0 };
+    HashMap<ByteString, u64> m_samples_by_stack;
+
+    struct FunctionLabel {
+        NonnullRefPtr<ASTNode const> code;
+        ByteString label;
+    };
+    HashMap<ASTNode const*, FunctionLabel> m_function_labels;
+    ByteString m_scratch_label;
+};
+
+}
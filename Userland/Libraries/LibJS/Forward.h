@@ -198,6 +198,7 @@ class Parser;
 struct ParserError;
 class PrimitiveString;
 class Program;
+class ProgramCache;
 class PromiseCapability;
 class PromiseReaction;
 class PropertyAttributes;
@@ -325,4 +326,8 @@ class RegexTable;
 class Register;
 }
 
+namespace JIT {
+class NativeExecutable;
+}
+
 }
@@ -15,6 +15,17 @@ void JS::Cell::initialize(JS::Realm&)
 {
 }
 
+void JS::Cell::remember()
+{
+    heap().remember_cell({}, *this);
+}
+
+void JS::Cell::did_store_value_into_old_cell(JS::Value const& value)
+{
+    if (value.is_cell())
+        did_store_reference(&value.as_cell());
+}
+
 void JS::Cell::Visitor::visit(JS::Value value)
 {
     if (value.is_cell())
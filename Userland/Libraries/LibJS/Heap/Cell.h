@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Format.h>
 #include <AK/Forward.h>
@@ -47,6 +48,41 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
+    // For when several threads are marking at once. Returns false if the cell had already been marked.
+    bool try_set_marked() { return !m_mark.exchange(true); }
+
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(Badge<Heap>, bool b) { m_remembered = b; }
+
+    // Write barrier for generational garbage collection.
+    // This must be called after storing a reference to another cell anywhere visit_edges() will find it.
+    // With generational collection, cells that survived a collection stay marked until the next full collection,
+    // so only stores into those (and only of references to cells that are still unmarked) need to be recorded.
+    ALWAYS_INLINE void did_store_reference(Cell const* cell)
+    {
+        if (m_mark && cell && !cell->m_mark && !m_remembered) [[unlikely]]
+            remember();
+    }
+
+    ALWAYS_INLINE void did_store_reference(Value const& value)
+    {
+        if (m_mark && !m_remembered) [[unlikely]]
+            did_store_value_into_old_cell(value);
+    }
+
+    template<typename T>
+    ALWAYS_INLINE void did_store_reference(GCPtr<T> const& cell) { did_store_reference(cell.ptr()); }
+
+    template<typename T>
+    ALWAYS_INLINE void did_store_reference(NonnullGCPtr<T> const& cell) { did_store_reference(cell.ptr()); }
+
+    // For when references were stored in bulk, e.g. by code running with this cell's registers.
+    ALWAYS_INLINE void did_store_references()
+    {
+        if (m_mark && !m_remembered) [[unlikely]]
+            remember();
+    }
+
     enum class State : bool {
         Live,
         Dead,
@@ -177,7 +213,12 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
-    bool m_mark : 1 { false };
+    void remember();
+    void did_store_value_into_old_cell(Value const&);
+
+    // NOTE: This isn't part of the bitfield below, so that marking threads can set it without clobbering the other bits.
+    Atomic<bool, AK::MemoryOrder::memory_order_relaxed> m_mark { false };
+    bool m_remembered : 1 { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
     State m_state : 1 { State::Live };
 };
@@ -36,6 +36,7 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     auto& block = *m_usable_blocks.last();
     auto* cell = block.allocate();
     VERIFY(cell);
+    block.set_has_young_cells(true);
     if (block.is_full())
         m_full_blocks.append(*m_usable_blocks.last());
     return cell;
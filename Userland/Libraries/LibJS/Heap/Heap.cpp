@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Debug.h>
 #include <AK/HashTable.h>
@@ -22,6 +23,9 @@
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/WeakContainer.h>
 #include <LibJS/SafeFunction.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+#include <sched.h>
 #include <setjmp.h>
 
 #ifdef AK_OS_SERENITY
@@ -69,17 +73,103 @@ Heap::~Heap()
 
 void Heap::will_allocate(size_t size)
 {
+    // NOTE: With generational collection, the young generation is collected whenever it reaches the minimum threshold,
+    //       no matter how large the old generation has become.
+    auto threshold = m_generational_collection_enabled ? GC_MIN_BYTES_THRESHOLD : m_gc_bytes_threshold;
+
+    // While marking incrementally, the mutator pays for what it allocates with a slice of marking work.
+    if (m_incremental_marking) {
+        threshold = INCREMENTAL_MARKING_SLICE_BYTES;
+        m_incremental_marking->allocated_bytes += size;
+    }
+
     if (should_collect_on_every_allocation()) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
-    } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
+        perform_automatic_collection();
+    } else if (m_allocated_bytes_since_last_gc + size > threshold) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        perform_automatic_collection();
     }
 
     m_allocated_bytes_since_last_gc += size;
 }
 
+void Heap::perform_automatic_collection()
+{
+    if (m_incremental_marking) {
+        perform_incremental_marking_slice();
+        return;
+    }
+
+    auto collection_type = automatic_collection_type();
+    if (collection_type == CollectionType::CollectGarbage && m_incremental_marking_enabled) {
+        start_incremental_marking();
+        return;
+    }
+    collect_garbage(collection_type);
+}
+
+Heap::CollectionType Heap::automatic_collection_type() const
+{
+    if (!m_generational_collection_enabled)
+        return CollectionType::CollectGarbage;
+
+    // Cells that die after being promoted are only reclaimed by full collections, so do one once the old generation
+    // has grown by as much as was live after the last one.
+    if (m_promoted_bytes_since_last_full_collection > m_gc_bytes_threshold)
+        return CollectionType::CollectGarbage;
+    return CollectionType::CollectYoungGeneration;
+}
+
+void Heap::set_generational_collection_enabled(bool enabled)
+{
+    VERIFY(!m_collecting_garbage);
+    if (m_generational_collection_enabled == enabled)
+        return;
+    m_generational_collection_enabled = enabled;
+
+    // Without generational collection, cells are only marked while a collection is running.
+    if (!enabled && !m_incremental_marking)
+        clear_marks_and_remembered_set();
+}
+
+void Heap::set_incremental_marking_enabled(bool enabled)
+{
+    VERIFY(!m_collecting_garbage);
+    m_incremental_marking_enabled = enabled;
+    if (!enabled && m_incremental_marking)
+        collect_garbage();
+}
+
+void Heap::remember_cell(Badge<Cell>, Cell& cell)
+{
+    if (!m_generational_collection_enabled && !m_incremental_marking)
+        return;
+    cell.set_remembered({}, true);
+    m_remembered_cells.append(cell);
+}
+
+Vector<NonnullGCPtr<Cell>> Heap::take_remembered_cells()
+{
+    for (auto& cell : m_remembered_cells)
+        cell->set_remembered({}, false);
+    return move(m_remembered_cells);
+}
+
+void Heap::clear_marks_and_remembered_set()
+{
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+            cell->set_remembered({}, false);
+        });
+        return IterationDecision::Continue;
+    });
+    m_remembered_cells.clear();
+    m_promoted_bytes_since_last_full_collection = 0;
+    m_minor_collections_since_last_full_collection = 0;
+}
+
 static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
 {
     if constexpr (sizeof(FlatPtr*) == sizeof(Value)) {
@@ -274,17 +364,33 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     if (print_report)
         collection_measurement_timer.start();
 
-    if (collection_type == CollectionType::CollectGarbage) {
-        if (m_gc_deferrals) {
-            m_should_gc_when_deferral_ends = true;
-            return;
-        }
+    // NOTE: A minor collection can't run while marking incrementally, since the old generation is being marked again.
+    if (collection_type == CollectionType::CollectYoungGeneration && (!m_generational_collection_enabled || m_incremental_marking))
+        collection_type = CollectionType::CollectGarbage;
+
+    if (collection_type != CollectionType::CollectEverything && m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    // A full collection finishes what incremental marking has started.
+    auto incremental_marking = move(m_incremental_marking);
+    if (incremental_marking && collection_type == CollectionType::CollectEverything) {
+        // Nothing survives this one, so throw away whatever has been marked so far.
+        incremental_marking = nullptr;
+        clear_marks_and_remembered_set();
+    } else if (m_generational_collection_enabled && collection_type != CollectionType::CollectYoungGeneration && !incremental_marking) {
+        // Marks are sticky with generational collection, so a full collection has to start from scratch.
+        clear_marks_and_remembered_set();
+    }
+
+    if (collection_type != CollectionType::CollectEverything) {
         HashMap<Cell*, HeapRoot> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        mark_live_cells(roots, collection_type, incremental_marking.ptr());
     }
-    finalize_unmarked_cells();
-    sweep_dead_cells(print_report, collection_measurement_timer);
+    finalize_unmarked_cells(collection_type);
+    sweep_dead_cells(collection_type, incremental_marking.ptr(), print_report, collection_measurement_timer);
 }
 
 void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
@@ -388,29 +494,44 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     });
 }
 
+class ParallelMarker;
+
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
-        : m_heap(heap)
+    explicit MarkingVisitor(Heap& heap)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
+        heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
+        heap.for_each_block([&](auto& block) {
             m_all_live_heap_blocks.set(&block);
             return IterationDecision::Continue;
         });
+    }
 
+    MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+        : MarkingVisitor(heap)
+    {
         for (auto* root : roots.keys()) {
             visit(root);
         }
     }
 
+    // Marks on a thread of its own, sharing work with the other visitors of the ParallelMarker.
+    MarkingVisitor(MarkingVisitor const& main_visitor, ParallelMarker& parallel_marker, size_t thread_index)
+        : m_parallel_marker(&parallel_marker)
+        , m_thread_index(thread_index)
+        , m_all_live_heap_blocks(main_visitor.m_all_live_heap_blocks)
+        , m_min_block_address(main_visitor.m_min_block_address)
+        , m_max_block_address(main_visitor.m_max_block_address)
+    {
+    }
+
     virtual void visit_impl(Cell& cell) override
     {
-        if (cell.is_marked())
+        if (!mark(cell))
             return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
-        cell.set_marked(true);
+        did_mark(cell);
         m_work_queue.append(cell);
     }
 
@@ -423,44 +544,377 @@ public:
             add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
 
         for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
-            if (cell->is_marked())
-                return;
             if (cell->state() != Cell::State::Live)
                 return;
-            cell->set_marked(true);
+            if (!mark(*cell))
+                return;
+            did_mark(*cell);
             m_work_queue.append(*cell);
         });
     }
 
-    void mark_all_live_cells()
+    void mark_all_live_cells();
+
+    // Returns true if there is nothing left to mark.
+    bool mark_live_cells_for(Duration time_budget)
     {
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        size_t visited_cells = 0;
         while (!m_work_queue.is_empty()) {
             m_work_queue.take_last()->visit_edges(*this);
+            // Looking at the clock is not free, so only do it every so often.
+            if (++visited_cells % 256 == 0 && timer.elapsed_time() >= time_budget)
+                break;
         }
+        return m_work_queue.is_empty();
+    }
+
+    void add_to_work_queue(NonnullGCPtr<Cell> cell) { m_work_queue.append(cell); }
+    void add_to_work_queue(Vector<NonnullGCPtr<Cell>> cells) { m_work_queue.extend(move(cells)); }
+    Vector<NonnullGCPtr<Cell>> take_work_queue() { return move(m_work_queue); }
+
+    size_t live_heap_block_count() const { return m_all_live_heap_blocks.size(); }
+
+    size_t marked_cells() const { return m_marked_cells; }
+    size_t marked_cell_bytes() const { return m_marked_cell_bytes; }
+
+    void add_statistics_from(MarkingVisitor const& other)
+    {
+        m_marked_cells += other.m_marked_cells;
+        m_marked_cell_bytes += other.m_marked_cell_bytes;
     }
 
 private:
-    Heap& m_heap;
+    // Returns false if the cell was already marked.
+    bool mark(Cell& cell)
+    {
+        if (cell.is_marked())
+            return false;
+        if (m_parallel_marker)
+            return cell.try_set_marked();
+        cell.set_marked(true);
+        return true;
+    }
+
+    void did_mark(Cell& cell)
+    {
+        ++m_marked_cells;
+        m_marked_cell_bytes += HeapBlock::from_cell(&cell)->cell_size();
+    }
+
+    ParallelMarker* m_parallel_marker { nullptr };
+    size_t m_thread_index { 0 };
     Vector<NonnullGCPtr<Cell>> m_work_queue;
+    size_t m_marked_cells { 0 };
+    size_t m_marked_cell_bytes { 0 };
     HashTable<HeapBlock*> m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+// Spreads marking over several threads. Every thread marks from a work queue of its own, and hands out the oldest
+// half of it when another thread has run out of work.
+class ParallelMarker {
+    AK_MAKE_NONCOPYABLE(ParallelMarker);
+    AK_MAKE_NONMOVABLE(ParallelMarker);
+
+public:
+    ParallelMarker(MarkingVisitor& main_visitor, size_t thread_count)
+        : m_main_visitor(main_visitor)
+        , m_thread_count(thread_count)
+    {
+        for (size_t i = 0; i < thread_count; ++i)
+            m_shared_work_queues.append(make<SharedWorkQueue>());
+    }
+
+    void mark_all_live_cells()
+    {
+        Vector<NonnullOwnPtr<MarkingVisitor>> visitors;
+        for (size_t i = 0; i < m_thread_count; ++i)
+            visitors.append(make<MarkingVisitor>(m_main_visitor, *this, i));
+
+        auto work_queue = m_main_visitor.take_work_queue();
+        for (size_t i = 0; i < work_queue.size(); ++i)
+            visitors[i % m_thread_count]->add_to_work_queue(work_queue[i]);
+
+        Vector<NonnullRefPtr<Threading::Thread>> threads;
+        for (size_t i = 1; i < m_thread_count; ++i) {
+            auto thread = Threading::Thread::construct([&visitor = *visitors[i]]() -> intptr_t {
+                visitor.mark_all_live_cells();
+                return 0;
+            },
+                "GC marking"sv);
+            thread->start();
+            threads.append(move(thread));
+        }
+
+        // The calling thread does its share of the work too.
+        visitors[0]->mark_all_live_cells();
+
+        for (auto& thread : threads)
+            (void)thread->join();
+
+        for (auto& visitor : visitors)
+            m_main_visitor.add_statistics_from(*visitor);
+    }
+
+    void maybe_share_work(size_t thread_index, Vector<NonnullGCPtr<Cell>>& work_queue)
+    {
+        if (work_queue.size() < MIN_SHARED_WORK_QUEUE_SIZE * 2 || m_idle_thread_count.load() == 0)
+            return;
+
+        auto& shared_work_queue = *m_shared_work_queues[thread_index];
+        if (shared_work_queue.size.load() != 0)
+            return;
+
+        // The oldest cells are the most likely to lead to a lot more work.
+        auto count = work_queue.size() / 2;
+        Threading::MutexLocker locker(shared_work_queue.mutex);
+        shared_work_queue.cells.append(work_queue.data(), count);
+        work_queue.remove(0, count);
+        shared_work_queue.size.store(shared_work_queue.cells.size());
+    }
+
+    // Returns false once every thread has run out of work, which means marking is done.
+    bool find_work(size_t thread_index, Vector<NonnullGCPtr<Cell>>& work_queue)
+    {
+        // Take back whatever nobody has taken from us yet.
+        if (take_work(*m_shared_work_queues[thread_index], work_queue, SIZE_MAX))
+            return true;
+
+        ++m_idle_thread_count;
+        while (true) {
+            for (size_t i = 1; i < m_thread_count; ++i) {
+                auto& victim = *m_shared_work_queues[(thread_index + i) % m_thread_count];
+                auto size = victim.size.load();
+                if (size == 0)
+                    continue;
+                --m_idle_thread_count;
+                if (take_work(victim, work_queue, (size + 1) / 2))
+                    return true;
+                ++m_idle_thread_count;
+            }
+
+            // A thread that isn't idle may still share some work, so we are only done when everyone is idle.
+            if (m_idle_thread_count.load() == m_thread_count)
+                return false;
+            sched_yield();
+        }
+    }
+
+private:
+    static constexpr size_t MIN_SHARED_WORK_QUEUE_SIZE { 64 };
+
+    struct SharedWorkQueue {
+        Threading::Mutex mutex;
+        Vector<NonnullGCPtr<Cell>> cells;
+        Atomic<size_t> size { 0 };
+    };
+
+    static bool take_work(SharedWorkQueue& shared_work_queue, Vector<NonnullGCPtr<Cell>>& work_queue, size_t max_count)
+    {
+        Threading::MutexLocker locker(shared_work_queue.mutex);
+        auto& cells = shared_work_queue.cells;
+        if (cells.is_empty())
+            return false;
+        auto count = min(max_count, cells.size());
+        work_queue.append(cells.data() + cells.size() - count, count);
+        cells.shrink(cells.size() - count);
+        shared_work_queue.size.store(cells.size());
+        return true;
+    }
+
+    MarkingVisitor& m_main_visitor;
+    size_t m_thread_count { 0 };
+    Vector<NonnullOwnPtr<SharedWorkQueue>> m_shared_work_queues;
+    Atomic<size_t> m_idle_thread_count { 0 };
+};
+
+void MarkingVisitor::mark_all_live_cells()
+{
+    while (true) {
+        while (!m_work_queue.is_empty()) {
+            m_work_queue.take_last()->visit_edges(*this);
+            if (m_parallel_marker)
+                m_parallel_marker->maybe_share_work(m_thread_index, m_work_queue);
+        }
+        if (!m_parallel_marker || !m_parallel_marker->find_work(m_thread_index, m_work_queue))
+            return;
+    }
+}
+
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots, CollectionType collection_type, IncrementalMarking* incremental_marking)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
     MarkingVisitor visitor(*this, roots);
 
-    visitor.mark_all_live_cells();
+    if (incremental_marking)
+        visitor.add_to_work_queue(move(incremental_marking->work_queue));
+
+    if (collection_type == CollectionType::CollectYoungGeneration || incremental_marking) {
+        // Cells that are already marked don't get looked inside again.
+        // The ones that had a reference stored into them since they were marked may be all that keeps an unmarked cell alive.
+        auto remembered_cells = take_remembered_cells();
+        for (auto& cell : remembered_cells)
+            cell->visit_edges(visitor);
+        m_young_generation_statistics.remembered_cells = remembered_cells.size();
+    }
+
+    if (m_marking_thread_count > 1 && visitor.live_heap_block_count() * HeapBlock::block_size >= PARALLEL_MARKING_MIN_HEAP_BYTES) {
+        ParallelMarker parallel_marker(visitor, m_marking_thread_count);
+        parallel_marker.mark_all_live_cells();
+    } else {
+        visitor.mark_all_live_cells();
+    }
+
+    // Every cell marked by a minor collection was young, and is now old.
+    m_young_generation_statistics.promoted_cells = visitor.marked_cells();
+    m_young_generation_statistics.promoted_cell_bytes = visitor.marked_cell_bytes();
 
-    for (auto& inverse_root : m_uprooted_cells)
+    if constexpr (GENERATIONAL_GC_DEBUG) {
+        if (collection_type == CollectionType::CollectYoungGeneration || incremental_marking)
+            verify_marking(roots);
+    }
+
+    for (auto& inverse_root : m_uprooted_cells) {
         inverse_root->set_marked(false);
+        // An uprooted cell may be old, make sure a minor collection still gets rid of it.
+        HeapBlock::from_cell(inverse_root)->set_has_young_cells(true);
+    }
 
     m_uprooted_cells.clear();
 }
 
+void Heap::start_incremental_marking()
+{
+    VERIFY(!m_collecting_garbage);
+    VERIFY(!m_incremental_marking);
+
+    if (m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    TemporaryChange change(m_collecting_garbage, true);
+
+    // Marks are sticky with generational collection, so marking has to start from scratch.
+    if (m_generational_collection_enabled)
+        clear_marks_and_remembered_set();
+
+    // NOTE: The roots are only used to get started, they are gathered again once marking is finished.
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    MarkingVisitor visitor(*this, roots);
+
+    m_incremental_marking = make<IncrementalMarking>();
+    m_incremental_marking->work_queue = visitor.take_work_queue();
+}
+
+void Heap::perform_incremental_marking_slice()
+{
+    if (!m_incremental_marking || m_collecting_garbage)
+        return;
+
+    if (m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    // Don't let the mutator keep marking from finishing, by giving up on slices once it has allocated as much as a
+    // full collection would have let it.
+    bool is_finished = m_incremental_marking->allocated_bytes > m_gc_bytes_threshold;
+    if (!is_finished) {
+        TemporaryChange change(m_collecting_garbage, true);
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
+        MarkingVisitor visitor(*this);
+        visitor.add_to_work_queue(move(m_incremental_marking->work_queue));
+
+        // These were marked earlier, but have had references to unmarked cells stored into them since.
+        for (auto& cell : take_remembered_cells())
+            cell->visit_edges(visitor);
+
+        is_finished = visitor.mark_live_cells_for(INCREMENTAL_MARKING_SLICE_DURATION);
+        m_incremental_marking->work_queue = visitor.take_work_queue();
+        ++m_incremental_marking->slices;
+        m_incremental_marking->time_spent_in_slices += timer.elapsed_time();
+    }
+
+    if (is_finished)
+        collect_garbage(CollectionType::CollectGarbage);
+}
+
+// Checks that a minor collection, or the end of incremental marking, marked every cell that a full collection would
+// have marked. Anything reported here is reachable through an already marked cell that is missing a write barrier.
+class MarkingVerificationVisitor final : public Cell::Visitor {
+public:
+    explicit MarkingVerificationVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    {
+        heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
+        heap.for_each_block([&](auto& block) {
+            m_all_live_heap_blocks.set(&block);
+            return IterationDecision::Continue;
+        });
+
+        for (auto* root : roots.keys())
+            visit(root);
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        if (m_visited.set(&cell) != HashSetResult::InsertedNewEntry)
+            return;
+        if (!cell.is_marked()) {
+            if (m_cell_being_visited)
+                dbgln("Unmarked cell {} ({}) is reachable from {} ({})", &cell, cell.class_name(), m_cell_being_visited.ptr(), m_cell_being_visited->class_name());
+            else
+                dbgln("Unmarked cell {} ({}) is reachable from a root", &cell, cell.class_name());
+            ++m_unmarked_reachable_cells;
+        }
+        m_work_queue.append(cell);
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        HashMap<FlatPtr, HeapRoot> possible_pointers;
+
+        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+
+        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+            if (cell->state() == Cell::State::Live)
+                visit_impl(*cell);
+        });
+    }
+
+    size_t visit_all_cells()
+    {
+        while (!m_work_queue.is_empty()) {
+            m_cell_being_visited = m_work_queue.take_last();
+            m_cell_being_visited->visit_edges(*this);
+        }
+        return m_unmarked_reachable_cells;
+    }
+
+private:
+    GCPtr<Cell> m_cell_being_visited;
+    Vector<NonnullGCPtr<Cell>> m_work_queue;
+    HashTable<Cell*> m_visited;
+    size_t m_unmarked_reachable_cells { 0 };
+    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    FlatPtr m_min_block_address;
+    FlatPtr m_max_block_address;
+};
+
+void Heap::verify_marking(HashMap<Cell*, HeapRoot> const& roots)
+{
+    MarkingVerificationVisitor visitor(*this, roots);
+    auto unmarked_reachable_cells = visitor.visit_all_cells();
+    VERIFY(unmarked_reachable_cells == 0);
+}
+
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 {
     if (!cell.overrides_must_survive_garbage_collection({}))
@@ -468,9 +922,9 @@ bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
     return cell.must_survive_garbage_collection();
 }
 
-void Heap::finalize_unmarked_cells()
+void Heap::finalize_unmarked_cells(CollectionType collection_type)
 {
-    for_each_block([&](auto& block) {
+    for_each_block_to_collect(collection_type, [&](auto& block) {
         block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
             if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
                 cell->finalize();
@@ -479,7 +933,7 @@ void Heap::finalize_unmarked_cells()
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::sweep_dead_cells(CollectionType collection_type, IncrementalMarking const* incremental_marking, bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
@@ -489,10 +943,12 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     size_t live_cells = 0;
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
+    size_t swept_block_count = 0;
 
-    for_each_block([&](auto& block) {
+    for_each_block_to_collect(collection_type, [&](auto& block) {
         bool block_has_live_cells = false;
         bool block_was_full = block.is_full();
+        ++swept_block_count;
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
             if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
@@ -500,12 +956,15 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
                 ++collected_cells;
                 collected_cell_bytes += block.cell_size();
             } else {
-                cell->set_marked(false);
+                // NOTE: With generational collection, surviving cells stay marked. That's what makes them old.
+                if (!m_generational_collection_enabled)
+                    cell->set_marked(false);
                 block_has_live_cells = true;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
             }
         });
+        block.set_has_young_cells(false);
         if (!block_has_live_cells)
             empty_blocks.append(&block);
         else if (block_was_full != block.is_full())
@@ -533,7 +992,13 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         });
     }
 
-    m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        // Only the blocks with young cells were swept, so the live cell count says little about the whole heap.
+        m_promoted_bytes_since_last_full_collection += m_young_generation_statistics.promoted_cell_bytes;
+        ++m_minor_collections_since_last_full_collection;
+    } else {
+        m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+    }
 
     if (print_report) {
         Duration const time_spent = measurement_timer.elapsed_time();
@@ -545,9 +1010,23 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
         dbgln("Garbage collection report");
         dbgln("=============================================");
-        dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
-        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        if (collection_type == CollectionType::CollectYoungGeneration) {
+            auto const& statistics = m_young_generation_statistics;
+            dbgln("     Collection: Minor (#{} since last full collection)", m_minor_collections_since_last_full_collection);
+            dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
+            dbgln(" Remembered set: {} cells", statistics.remembered_cells);
+            dbgln(" Promoted cells: {} ({} bytes)", statistics.promoted_cells, statistics.promoted_cell_bytes);
+            dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+            dbgln("   Swept blocks: {} of {}", swept_block_count, live_block_count + empty_blocks.size());
+            dbgln(" Old generation: {} bytes promoted since last full collection", m_promoted_bytes_since_last_full_collection);
+        } else {
+            dbgln("     Collection: Full");
+            dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
+            if (incremental_marking)
+                dbgln(" Marking slices: {} ({} ms)", incremental_marking->slices, incremental_marking->time_spent_in_slices.to_milliseconds());
+            dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
+            dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        }
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
         dbgln("=============================================");
@@ -566,7 +1045,7 @@ void Heap::undefer_gc()
 
     if (!m_gc_deferrals) {
         if (m_should_gc_when_deferral_ends)
-            collect_garbage();
+            perform_automatic_collection();
         m_should_gc_when_deferral_ends = false;
     }
 }
@@ -11,6 +11,8 @@
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -52,14 +54,16 @@ public:
         auto* memory = allocate_cell<T>();
         defer_gc();
         new (memory) T(forward<Args>(args)...);
-        undefer_gc();
         auto* cell = static_cast<T*>(memory);
+        // NOTE: Keep the cell young until it has been initialized, so initialize() doesn't need write barriers.
         memory->initialize(realm);
+        undefer_gc();
         return *cell;
     }
 
     enum class CollectionType {
         CollectGarbage,
+        CollectYoungGeneration,
         CollectEverything,
     };
 
@@ -69,6 +73,36 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // With generational collection enabled, cells that survive a collection are considered old and are only looked
+    // at again by full collections. Automatic collections are then mostly minor ones, which only trace from the
+    // roots and from old cells that had a reference stored into them (see Cell::did_store_reference()).
+    // NOTE: This is only sound if every cell type calls the write barrier when it is mutated after initialization.
+    //       LibJS's own cells do, but LibWeb's (the DOM, layout and style cells and everything else WebContent keeps
+    //       on this heap) don't yet, which is why this is off by default and only turned on by js and test-js.
+    bool is_generational_collection_enabled() const { return m_generational_collection_enabled; }
+    void set_generational_collection_enabled(bool);
+
+    // With incremental marking enabled, automatic full collections mark the heap a slice at a time, interleaved with
+    // the mutator. Slices are performed as the mutator allocates. The roots are gathered again when marking is
+    // finished, and cells that were already marked are rescanned if the write barrier saw them change.
+    // NOTE: This has the same soundness requirement as generational collection, so it is only turned on by js and test-js.
+    bool is_incremental_marking_enabled() const { return m_incremental_marking_enabled; }
+    void set_incremental_marking_enabled(bool);
+    bool is_incremental_marking_in_progress() const { return m_incremental_marking; }
+
+    // Stop-the-world marking is spread over this many threads when the heap is large enough to make it worthwhile.
+    // The roots, including the conservatively scanned ones, are always gathered on the mutator thread first.
+    // NOTE: This requires every visit_edges() to be safe to call from several threads at once. LibWeb hasn't been audited
+    //       for that, so only js and test-js set this.
+    size_t marking_thread_count() const { return m_marking_thread_count; }
+    void set_marking_thread_count(size_t count)
+    {
+        VERIFY(count > 0);
+        m_marking_thread_count = count;
+    }
+
+    void remember_cell(Badge<Cell>, Cell&);
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
@@ -91,6 +125,7 @@ public:
 private:
     friend class MarkingVisitor;
     friend class GraphConstructorVisitor;
+    friend class MarkingVerificationVisitor;
     friend class DeferGC;
 
     void defer_gc();
@@ -110,15 +145,29 @@ private:
         return allocator_for_size(sizeof(T)).allocate_cell(*this);
     }
 
+    struct IncrementalMarking {
+        Vector<NonnullGCPtr<Cell>> work_queue;
+        size_t allocated_bytes { 0 };
+        size_t slices { 0 };
+        Duration time_spent_in_slices;
+    };
+
     void will_allocate(size_t);
+    void perform_automatic_collection();
+    CollectionType automatic_collection_type() const;
+    void start_incremental_marking();
+    void perform_incremental_marking_slice();
 
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
-    void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells, CollectionType, IncrementalMarking*);
+    Vector<NonnullGCPtr<Cell>> take_remembered_cells();
+    void verify_marking(HashMap<Cell*, HeapRoot> const& live_cells);
+    void clear_marks_and_remembered_set();
+    void finalize_unmarked_cells(CollectionType);
+    void sweep_dead_cells(CollectionType, IncrementalMarking const*, bool print_report, Core::ElapsedTimer const&);
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -140,12 +189,43 @@ private:
         }
     }
 
+    template<typename Callback>
+    void for_each_block_to_collect(CollectionType collection_type, Callback callback)
+    {
+        for_each_block([&](auto& block) {
+            if (collection_type == CollectionType::CollectYoungGeneration && !block.has_young_cells())
+                return IterationDecision::Continue;
+            return callback(block);
+        });
+    }
+
     static constexpr size_t GC_MIN_BYTES_THRESHOLD { 4 * 1024 * 1024 };
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
 
     bool m_should_collect_on_every_allocation { false };
 
+    bool m_generational_collection_enabled { false };
+    Vector<NonnullGCPtr<Cell>> m_remembered_cells;
+    size_t m_promoted_bytes_since_last_full_collection { 0 };
+    size_t m_minor_collections_since_last_full_collection { 0 };
+
+    struct YoungGenerationStatistics {
+        size_t remembered_cells { 0 };
+        size_t promoted_cells { 0 };
+        size_t promoted_cell_bytes { 0 };
+    };
+    YoungGenerationStatistics m_young_generation_statistics;
+
+    static constexpr size_t INCREMENTAL_MARKING_SLICE_BYTES { 256 * 1024 };
+    static constexpr Duration INCREMENTAL_MARKING_SLICE_DURATION { Duration::from_milliseconds(2) };
+    bool m_incremental_marking_enabled { false };
+
+    OwnPtr<IncrementalMarking> m_incremental_marking;
+
+    static constexpr size_t PARALLEL_MARKING_MIN_HEAP_BYTES { 1 * 1024 * 1024 };
+    size_t m_marking_thread_count { 1 };
+
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
     CellAllocator::List m_all_cell_allocators;
 
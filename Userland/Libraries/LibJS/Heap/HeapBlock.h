@@ -32,6 +32,11 @@ public:
     size_t cell_count() const { return (block_size - sizeof(HeapBlock)) / m_cell_size; }
     bool is_full() const { return !has_lazy_freelist() && !m_freelist; }
 
+    // Whether cells may have been allocated in this block since the last garbage collection.
+    // Minor collections only need to look at these blocks.
+    bool has_young_cells() const { return m_has_young_cells; }
+    void set_has_young_cells(bool b) { m_has_young_cells = b; }
+
     ALWAYS_INLINE Cell* allocate()
     {
         Cell* allocated_cell = nullptr;
@@ -111,6 +116,7 @@ private:
     CellAllocator& m_cell_allocator;
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
+    bool m_has_young_cells { false };
     GCPtr<FreelistEntry> m_freelist;
     alignas(__BIGGEST_ALIGNMENT__) u8 m_storage[];
 
@@ -0,0 +1,573 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibJIT/GDB.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/ValueInlines.h>
+#include <sys/mman.h>
+
+#ifdef JIT_ARCH_SUPPORTED
+
+namespace JS::JIT {
+
+// Registers that hold the same thing for the whole lifetime of a native frame.
+// They're all callee-saved, so the helpers we call leave them alone.
+// NOTE: The assembler can't encode R12 or R13 as a base register yet, so we stay away from those.
+static constexpr auto INTERPRETER = ::JIT::Assembler::Reg::RBX;
+static constexpr auto REGISTERS_AND_CONSTANTS_AND_LOCALS = ::JIT::Assembler::Reg::R14;
+static constexpr auto PROGRAM_COUNTER = ::JIT::Assembler::Reg::R15;
+
+// Scratch registers, these are clobbered by every helper call.
+static constexpr auto RAX = ::JIT::Assembler::Reg::RAX;
+static constexpr auto RCX = ::JIT::Assembler::Reg::RCX;
+static constexpr auto RDX = ::JIT::Assembler::Reg::RDX;
+static constexpr auto RSI = ::JIT::Assembler::Reg::RSI;
+static constexpr auto RDI = ::JIT::Assembler::Reg::RDI;
+
+using Operand = ::JIT::Assembler::Operand;
+using Condition = ::JIT::Assembler::Condition;
+
+template<typename OpType>
+static u64 cxx_execute(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    if constexpr (IsSame<decltype(instruction.execute_impl(interpreter)), void>) {
+        instruction.execute_impl(interpreter);
+    } else {
+        auto result = instruction.execute_impl(interpreter);
+        if (result.is_error()) {
+            interpreter.reg(Bytecode::Register::exception()) = result.error_value();
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static u64 cxx_get_argument(Bytecode::Interpreter& interpreter, Bytecode::Op::GetArgument const& instruction)
+{
+    interpreter.set(instruction.dst(), interpreter.running_execution_context().arguments.data()[instruction.index()]);
+    return 0;
+}
+
+static u64 cxx_set_argument(Bytecode::Interpreter& interpreter, Bytecode::Op::SetArgument const& instruction)
+{
+    interpreter.running_execution_context().arguments.data()[instruction.index()] = interpreter.get(instruction.src());
+    return 0;
+}
+
+static u64 cxx_enter_unwind_context(Bytecode::Interpreter& interpreter, Bytecode::Op::EnterUnwindContext const&)
+{
+    interpreter.enter_unwind_context();
+    return 0;
+}
+
+template<typename OpType>
+static u64 cxx_to_boolean(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    return interpreter.get(instruction.condition()).to_boolean();
+}
+
+static ThrowCompletionOr<Value> loosely_equals(VM& vm, Value lhs, Value rhs)
+{
+    return Value(TRY(is_loosely_equal(vm, lhs, rhs)));
+}
+
+static ThrowCompletionOr<Value> loosely_inequals(VM& vm, Value lhs, Value rhs)
+{
+    return Value(!TRY(is_loosely_equal(vm, lhs, rhs)));
+}
+
+static ThrowCompletionOr<Value> strict_equals(VM&, Value lhs, Value rhs)
+{
+    return Value(is_strictly_equal(lhs, rhs));
+}
+
+static ThrowCompletionOr<Value> strict_inequals(VM&, Value lhs, Value rhs)
+{
+    return Value(!is_strictly_equal(lhs, rhs));
+}
+
+// Comparison jumps return 0 or 1 for the outcome of the comparison, or 2 if it threw.
+static constexpr u64 comparison_threw = 2;
+
+#    define DEFINE_CXX_JUMP_COMPARISON(op_TitleCase, op_snake_case, numeric_operator)                               \
+        static u64 cxx_jump_##op_snake_case(Bytecode::Interpreter& interpreter, Bytecode::Op::Jump##op_TitleCase const& instruction) \
+        {                                                                                                            \
+            auto result = op_snake_case(interpreter.vm(), interpreter.get(instruction.lhs()), interpreter.get(instruction.rhs())); \
+            if (result.is_error()) {                                                                                 \
+                interpreter.reg(Bytecode::Register::exception()) = result.error_value();                             \
+                return comparison_threw;                                                                             \
+            }                                                                                                        \
+            return result.value().to_boolean();                                                                     \
+        }
+
+JS_ENUMERATE_COMPARISON_OPS(DEFINE_CXX_JUMP_COMPARISON)
+#    undef DEFINE_CXX_JUMP_COMPARISON
+
+static constexpr Condition condition_for_numeric_operator(StringView numeric_operator)
+{
+    if (numeric_operator == "<"sv)
+        return Condition::SignedLessThan;
+    if (numeric_operator == "<="sv)
+        return Condition::SignedLessThanOrEqualTo;
+    if (numeric_operator == ">"sv)
+        return Condition::SignedGreaterThan;
+    if (numeric_operator == ">="sv)
+        return Condition::SignedGreaterThanOrEqualTo;
+    if (numeric_operator == "=="sv)
+        return Condition::EqualTo;
+    VERIFY(numeric_operator == "!="sv);
+    return Condition::NotEqualTo;
+}
+
+void Compiler::load_operand(Assembler::Reg dst, Bytecode::Operand operand)
+{
+    m_assembler.mov(
+        Operand::Register(dst),
+        Operand::Mem64BaseAndOffset(REGISTERS_AND_CONSTANTS_AND_LOCALS, operand.index() * sizeof(Value)));
+}
+
+void Compiler::store_operand(Bytecode::Operand operand, Assembler::Reg src)
+{
+    m_assembler.mov(
+        Operand::Mem64BaseAndOffset(REGISTERS_AND_CONSTANTS_AND_LOCALS, operand.index() * sizeof(Value)),
+        Operand::Register(src));
+}
+
+void Compiler::jump_if_not_int32(Assembler::Reg value, Assembler::Reg scratch, Assembler::Label& label)
+{
+    m_assembler.mov(Operand::Register(scratch), Operand::Register(value));
+    m_assembler.shift_right(Operand::Register(scratch), Operand::Imm(TAG_SHIFT));
+    m_assembler.jump_if(Operand::Register(scratch), Condition::NotEqualTo, Operand::Imm(INT32_TAG), label);
+}
+
+// Expects the upper half of `value` to be zero, which all 32-bit operations leave behind.
+void Compiler::box_int32(Assembler::Reg value, Assembler::Reg scratch)
+{
+    m_assembler.mov(Operand::Register(scratch), Operand::Imm(SHIFTED_INT32_TAG));
+    m_assembler.bitwise_or(Operand::Register(value), Operand::Register(scratch));
+}
+
+void Compiler::store_program_counter()
+{
+    m_assembler.mov(Operand::Register(RAX), Operand::Imm(m_program_counter));
+    m_assembler.mov(Operand::Mem64BaseAndOffset(PROGRAM_COUNTER, 0), Operand::Register(RAX));
+}
+
+template<typename OpType>
+void Compiler::call_helper(u64 (*helper)(Bytecode::Interpreter&, OpType const&), OpType const& op)
+{
+    m_assembler.mov(Operand::Register(RDI), Operand::Register(INTERPRETER));
+    m_assembler.mov(Operand::Register(RSI), Operand::Imm(bit_cast<u64>(&op)));
+    m_assembler.native_call(bit_cast<u64>(helper));
+}
+
+void Compiler::check_exception()
+{
+    m_assembler.jump_if(Operand::Register(RAX), Condition::NotEqualTo, Operand::Imm(0), m_exception_exit);
+}
+
+template<typename OpType>
+void Compiler::call_execute_impl(OpType const& op)
+{
+    store_program_counter();
+    call_helper(cxx_execute<OpType>, op);
+    if constexpr (!IsSame<decltype(op.execute_impl(declval<Bytecode::Interpreter&>())), void>)
+        check_exception();
+}
+
+void Compiler::exit_with(NativeExecutable::ExitReason reason)
+{
+    m_assembler.mov(Operand::Register(RAX), Operand::Imm(to_underlying(reason)));
+    m_assembler.jump(m_exit);
+}
+
+Compiler::Assembler::Label& Compiler::label_for(Bytecode::Label const& label)
+{
+    return m_instruction_labels.find(label.address())->value;
+}
+
+template<typename OpType>
+void Compiler::compile_op(OpType const& op)
+{
+    call_execute_impl(op);
+}
+
+void Compiler::compile_op(Bytecode::Op::Mov const& op)
+{
+    load_operand(RAX, op.src());
+    store_operand(op.dst(), RAX);
+}
+
+void Compiler::compile_op(Bytecode::Op::GetArgument const& op)
+{
+    call_helper(cxx_get_argument, op);
+}
+
+void Compiler::compile_op(Bytecode::Op::SetArgument const& op)
+{
+    call_helper(cxx_set_argument, op);
+}
+
+void Compiler::compile_op(Bytecode::Op::End const& op)
+{
+    load_operand(RAX, op.value());
+    store_operand(Bytecode::Operand(Bytecode::Register::accumulator()), RAX);
+    exit_with(NativeExecutable::ExitReason::Finished);
+}
+
+void Compiler::compile_op(Bytecode::Op::Return const& op)
+{
+    call_execute_impl(op);
+    exit_with(NativeExecutable::ExitReason::Finished);
+}
+
+void Compiler::compile_op(Bytecode::Op::Yield const& op)
+{
+    call_execute_impl(op);
+    exit_with(NativeExecutable::ExitReason::Finished);
+}
+
+void Compiler::compile_op(Bytecode::Op::Await const& op)
+{
+    call_execute_impl(op);
+    exit_with(NativeExecutable::ExitReason::Finished);
+}
+
+void Compiler::compile_op(Bytecode::Op::Jump const& op)
+{
+    m_assembler.jump(label_for(op.target()));
+}
+
+template<typename OpType>
+void Compiler::compile_conditional_jump(OpType const& op, Assembler::Label& true_target, Assembler::Label& false_target)
+{
+    Assembler::Label not_boolean {};
+    Assembler::Label slow_case {};
+
+    load_operand(RAX, op.condition());
+    m_assembler.mov(Operand::Register(RCX), Operand::Register(RAX));
+    m_assembler.shift_right(Operand::Register(RCX), Operand::Imm(TAG_SHIFT));
+
+    // Booleans keep their value in the lowest bit.
+    m_assembler.jump_if(Operand::Register(RCX), Condition::NotEqualTo, Operand::Imm(BOOLEAN_TAG), not_boolean);
+    m_assembler.test(Operand::Register(RAX), Operand::Imm(1));
+    m_assembler.jump_if(Condition::NotEqualTo, true_target);
+    m_assembler.jump(false_target);
+
+    // Int32s are truthy unless they're zero.
+    not_boolean.link(m_assembler);
+    m_assembler.jump_if(Operand::Register(RCX), Condition::NotEqualTo, Operand::Imm(INT32_TAG), slow_case);
+    m_assembler.mov32(Operand::Register(RAX), Operand::Register(RAX));
+    m_assembler.jump_if(Operand::Register(RAX), Condition::NotEqualTo, Operand::Imm(0), true_target);
+    m_assembler.jump(false_target);
+
+    slow_case.link(m_assembler);
+    call_helper(cxx_to_boolean<OpType>, op);
+    m_assembler.jump_if(Operand::Register(RAX), Condition::NotEqualTo, Operand::Imm(0), true_target);
+    m_assembler.jump(false_target);
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpIf const& op)
+{
+    compile_conditional_jump(op, label_for(op.true_target()), label_for(op.false_target()));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpTrue const& op)
+{
+    Assembler::Label fallthrough {};
+    compile_conditional_jump(op, label_for(op.target()), fallthrough);
+    fallthrough.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpFalse const& op)
+{
+    Assembler::Label fallthrough {};
+    compile_conditional_jump(op, fallthrough, label_for(op.target()));
+    fallthrough.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpNullish const& op)
+{
+    load_operand(RAX, op.condition());
+    m_assembler.shift_right(Operand::Register(RAX), Operand::Imm(TAG_SHIFT));
+    m_assembler.bitwise_and(Operand::Register(RAX), Operand::Imm(IS_NULLISH_EXTRACT_PATTERN));
+    m_assembler.jump_if(Operand::Register(RAX), Condition::EqualTo, Operand::Imm(IS_NULLISH_PATTERN), label_for(op.true_target()));
+    m_assembler.jump(label_for(op.false_target()));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpUndefined const& op)
+{
+    load_operand(RAX, op.condition());
+    m_assembler.shift_right(Operand::Register(RAX), Operand::Imm(TAG_SHIFT));
+    m_assembler.jump_if(Operand::Register(RAX), Condition::EqualTo, Operand::Imm(UNDEFINED_TAG), label_for(op.true_target()));
+    m_assembler.jump(label_for(op.false_target()));
+}
+
+void Compiler::compile_op(Bytecode::Op::EnterUnwindContext const& op)
+{
+    call_helper(cxx_enter_unwind_context, op);
+    m_assembler.jump(label_for(op.entry_point()));
+}
+
+// These two pick their jump target at runtime from the unwind state, so we leave them to the interpreter.
+void Compiler::compile_op(Bytecode::Op::ContinuePendingUnwind const&)
+{
+    store_program_counter();
+    exit_with(NativeExecutable::ExitReason::Interpret);
+}
+
+void Compiler::compile_op(Bytecode::Op::ScheduleJump const&)
+{
+    store_program_counter();
+    exit_with(NativeExecutable::ExitReason::Interpret);
+}
+
+template<typename OpType>
+void Compiler::compile_binary_int32_op(OpType const& op, Function<void(Assembler::Label& slow_case)> emit_operation)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    load_operand(RAX, op.lhs());
+    load_operand(RCX, op.rhs());
+    jump_if_not_int32(RAX, RDX, slow_case);
+    jump_if_not_int32(RCX, RDX, slow_case);
+    emit_operation(slow_case);
+    store_operand(op.dst(), RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    call_execute_impl(op);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::Add const& op)
+{
+    compile_binary_int32_op(op, [&](auto& slow_case) {
+        m_assembler.add32(Operand::Register(RAX), Operand::Register(RCX), slow_case);
+        box_int32(RAX, RDX);
+    });
+}
+
+void Compiler::compile_op(Bytecode::Op::Sub const& op)
+{
+    compile_binary_int32_op(op, [&](auto& slow_case) {
+        m_assembler.sub32(Operand::Register(RAX), Operand::Register(RCX), slow_case);
+        box_int32(RAX, RDX);
+    });
+}
+
+// Both operands carry the same tag, so and/or on the whole encoded value leaves it intact.
+void Compiler::compile_op(Bytecode::Op::BitwiseAnd const& op)
+{
+    compile_binary_int32_op(op, [&](auto&) {
+        m_assembler.bitwise_and(Operand::Register(RAX), Operand::Register(RCX));
+    });
+}
+
+void Compiler::compile_op(Bytecode::Op::BitwiseOr const& op)
+{
+    compile_binary_int32_op(op, [&](auto&) {
+        m_assembler.bitwise_or(Operand::Register(RAX), Operand::Register(RCX));
+    });
+}
+
+void Compiler::compile_op(Bytecode::Op::BitwiseXor const& op)
+{
+    compile_binary_int32_op(op, [&](auto&) {
+        m_assembler.bitwise_xor32(Operand::Register(RAX), Operand::Register(RCX));
+        box_int32(RAX, RDX);
+    });
+}
+
+void Compiler::compile_op(Bytecode::Op::Increment const& op)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    load_operand(RAX, op.dst());
+    jump_if_not_int32(RAX, RDX, slow_case);
+    m_assembler.inc32(Operand::Register(RAX), slow_case);
+    box_int32(RAX, RDX);
+    store_operand(op.dst(), RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    call_execute_impl(op);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::Decrement const& op)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    load_operand(RAX, op.dst());
+    jump_if_not_int32(RAX, RDX, slow_case);
+    m_assembler.dec32(Operand::Register(RAX), slow_case);
+    box_int32(RAX, RDX);
+    store_operand(op.dst(), RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    call_execute_impl(op);
+
+    done.link(m_assembler);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_comparison(OpType const& op, Assembler::Condition condition)
+{
+    compile_binary_int32_op(op, [&](auto&) {
+        m_assembler.sign_extend_32_to_64_bits(RAX);
+        m_assembler.sign_extend_32_to_64_bits(RCX);
+        m_assembler.cmp(Operand::Register(RAX), Operand::Register(RCX));
+        // NOTE: A 64-bit immediate move leaves the flags alone, and the boolean tag has a zero low byte for set_if() to fill in.
+        m_assembler.mov(Operand::Register(RAX), Operand::Imm(SHIFTED_BOOLEAN_TAG));
+        m_assembler.set_if(condition, Operand::Register(RAX));
+    });
+}
+
+void Compiler::compile_op(Bytecode::Op::LessThan const& op)
+{
+    compile_int32_comparison(op, Condition::SignedLessThan);
+}
+
+void Compiler::compile_op(Bytecode::Op::LessThanEquals const& op)
+{
+    compile_int32_comparison(op, Condition::SignedLessThanOrEqualTo);
+}
+
+void Compiler::compile_op(Bytecode::Op::GreaterThan const& op)
+{
+    compile_int32_comparison(op, Condition::SignedGreaterThan);
+}
+
+void Compiler::compile_op(Bytecode::Op::GreaterThanEquals const& op)
+{
+    compile_int32_comparison(op, Condition::SignedGreaterThanOrEqualTo);
+}
+
+template<typename OpType>
+void Compiler::compile_jump_on_int32_comparison(OpType const& op, Assembler::Condition condition, u64 (*slow_case_helper)(Bytecode::Interpreter&, OpType const&))
+{
+    Assembler::Label slow_case {};
+    auto& true_target = label_for(op.true_target());
+    auto& false_target = label_for(op.false_target());
+
+    load_operand(RAX, op.lhs());
+    load_operand(RCX, op.rhs());
+    jump_if_not_int32(RAX, RDX, slow_case);
+    jump_if_not_int32(RCX, RDX, slow_case);
+    m_assembler.sign_extend_32_to_64_bits(RAX);
+    m_assembler.sign_extend_32_to_64_bits(RCX);
+    m_assembler.cmp(Operand::Register(RAX), Operand::Register(RCX));
+    m_assembler.jump_if(condition, true_target);
+    m_assembler.jump(false_target);
+
+    slow_case.link(m_assembler);
+    store_program_counter();
+    call_helper(slow_case_helper, op);
+    m_assembler.jump_if(Operand::Register(RAX), Condition::EqualTo, Operand::Imm(comparison_threw), m_exception_exit);
+    m_assembler.jump_if(Operand::Register(RAX), Condition::NotEqualTo, Operand::Imm(0), true_target);
+    m_assembler.jump(false_target);
+}
+
+#    define DEFINE_COMPILE_JUMP_COMPARISON_OP(op_TitleCase, op_snake_case, numeric_operator)                                     \
+        void Compiler::compile_op(Bytecode::Op::Jump##op_TitleCase const& op)                                                    \
+        {                                                                                                                        \
+            compile_jump_on_int32_comparison(op, condition_for_numeric_operator(#numeric_operator ""sv), cxx_jump_##op_snake_case); \
+        }
+
+JS_ENUMERATE_COMPARISON_OPS(DEFINE_COMPILE_JUMP_COMPARISON_OP)
+#    undef DEFINE_COMPILE_JUMP_COMPARISON_OP
+
+void Compiler::compile_instruction(Bytecode::Instruction const& instruction)
+{
+    switch (instruction.type()) {
+#    define CASE_BYTECODE_OP(OpTitleCase)                                                  \
+    case Bytecode::Instruction::Type::OpTitleCase:                                         \
+        compile_op(static_cast<Bytecode::Op::OpTitleCase const&>(instruction));             \
+        break;
+        ENUMERATE_BYTECODE_OPS(CASE_BYTECODE_OP)
+#    undef CASE_BYTECODE_OP
+    }
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& bytecode_executable)
+{
+    Compiler compiler;
+    auto& assembler = compiler.m_assembler;
+
+    // Native frames are entered through a single prologue that sets up our fixed registers and then
+    // jumps straight to the code for the requested instruction:
+    // u64 entry(Interpreter&, Value* registers_and_constants_and_locals, size_t* program_counter, void* native_address)
+    assembler.enter();
+    assembler.mov(Operand::Register(INTERPRETER), Operand::Register(RDI));
+    assembler.mov(Operand::Register(REGISTERS_AND_CONSTANTS_AND_LOCALS), Operand::Register(RSI));
+    assembler.mov(Operand::Register(PROGRAM_COUNTER), Operand::Register(RDX));
+    assembler.jump(Operand::Register(RCX));
+
+    for (Bytecode::InstructionStreamIterator it(bytecode_executable.bytecode); !it.at_end(); ++it)
+        compiler.m_instruction_labels.set(it.offset(), {});
+
+    for (Bytecode::InstructionStreamIterator it(bytecode_executable.bytecode); !it.at_end(); ++it) {
+        compiler.m_program_counter = it.offset();
+        compiler.m_native_offsets.set(it.offset(), compiler.m_output.size());
+        compiler.m_instruction_labels.find(it.offset())->value.link(assembler);
+        compiler.compile_instruction(*it);
+    }
+
+    // Every basic block ends in a terminator, so we should never fall off the end.
+    assembler.verify_not_reached();
+
+    compiler.m_exception_exit.link(assembler);
+    assembler.mov(Operand::Register(RAX), Operand::Imm(to_underlying(NativeExecutable::ExitReason::Exception)));
+    compiler.m_exit.link(assembler);
+    assembler.exit();
+
+    auto& code = compiler.m_output;
+    auto* executable_memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (executable_memory == MAP_FAILED) {
+        dbgln("JIT: Failed to allocate memory for native code: {}", strerror(errno));
+        return nullptr;
+    }
+
+    memcpy(executable_memory, code.data(), code.size());
+
+    if (mprotect(executable_memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("JIT: Failed to make native code executable: {}", strerror(errno));
+        munmap(executable_memory, code.size());
+        return nullptr;
+    }
+
+    auto name = bytecode_executable.name.is_empty() ? "(anonymous)"sv : bytecode_executable.name.view();
+    auto gdb_object = ::JIT::GDB::build_gdb_image({ static_cast<u8 const*>(executable_memory), code.size() }, "LibJS JIT"sv, name);
+
+    dbgln_if(JS_BYTECODE_DEBUG, "JIT: Compiled {} ({} bytes of bytecode) into {} bytes of native code", name, bytecode_executable.bytecode.size(), code.size());
+
+    return make<NativeExecutable>(executable_memory, code.size(), move(compiler.m_native_offsets), move(gdb_object));
+}
+
+}
+
+#else
+
+namespace JS::JIT {
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable&)
+{
+    return nullptr;
+}
+
+}
+
+#endif
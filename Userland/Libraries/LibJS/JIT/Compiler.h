@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <LibJIT/Assembler.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::JIT {
+
+// The baseline JIT translates each bytecode instruction into a call to the same helper the interpreter
+// would have used, with inline fast paths for Int32 arithmetic, comparisons and jumps.
+// Values never live in machine registers across instructions, so the interpreter can take over
+// at any instruction boundary.
+class Compiler {
+public:
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+#ifdef JIT_ARCH_SUPPORTED
+private:
+    using Assembler = ::JIT::Assembler;
+
+    Compiler()
+        : m_assembler(m_output)
+    {
+    }
+
+    void compile_instruction(Bytecode::Instruction const&);
+
+    void compile_op(Bytecode::Op::Mov const&);
+    void compile_op(Bytecode::Op::GetArgument const&);
+    void compile_op(Bytecode::Op::SetArgument const&);
+    void compile_op(Bytecode::Op::End const&);
+    void compile_op(Bytecode::Op::Return const&);
+    void compile_op(Bytecode::Op::Yield const&);
+    void compile_op(Bytecode::Op::Await const&);
+    void compile_op(Bytecode::Op::Jump const&);
+    void compile_op(Bytecode::Op::JumpIf const&);
+    void compile_op(Bytecode::Op::JumpTrue const&);
+    void compile_op(Bytecode::Op::JumpFalse const&);
+    void compile_op(Bytecode::Op::JumpNullish const&);
+    void compile_op(Bytecode::Op::JumpUndefined const&);
+    void compile_op(Bytecode::Op::EnterUnwindContext const&);
+    void compile_op(Bytecode::Op::ContinuePendingUnwind const&);
+    void compile_op(Bytecode::Op::ScheduleJump const&);
+    void compile_op(Bytecode::Op::Add const&);
+    void compile_op(Bytecode::Op::Sub const&);
+    void compile_op(Bytecode::Op::BitwiseAnd const&);
+    void compile_op(Bytecode::Op::BitwiseOr const&);
+    void compile_op(Bytecode::Op::BitwiseXor const&);
+    void compile_op(Bytecode::Op::Increment const&);
+    void compile_op(Bytecode::Op::Decrement const&);
+    void compile_op(Bytecode::Op::LessThan const&);
+    void compile_op(Bytecode::Op::LessThanEquals const&);
+    void compile_op(Bytecode::Op::GreaterThan const&);
+    void compile_op(Bytecode::Op::GreaterThanEquals const&);
+
+#    define DECLARE_COMPILE_JUMP_COMPARISON_OP(op_TitleCase, op_snake_case, numeric_operator) \
+        void compile_op(Bytecode::Op::Jump##op_TitleCase const&);
+    JS_ENUMERATE_COMPARISON_OPS(DECLARE_COMPILE_JUMP_COMPARISON_OP)
+#    undef DECLARE_COMPILE_JUMP_COMPARISON_OP
+
+    // Everything else is executed by calling the instruction's execute_impl().
+    template<typename OpType>
+    void compile_op(OpType const&);
+
+    template<typename OpType>
+    void compile_binary_int32_op(OpType const&, Function<void(Assembler::Label& slow_case)> emit_operation);
+    template<typename OpType>
+    void compile_int32_comparison(OpType const&, Assembler::Condition);
+    template<typename OpType>
+    void compile_jump_on_int32_comparison(OpType const&, Assembler::Condition, u64 (*slow_case_helper)(Bytecode::Interpreter&, OpType const&));
+    template<typename OpType>
+    void compile_conditional_jump(OpType const&, Assembler::Label& true_target, Assembler::Label& false_target);
+
+    template<typename OpType>
+    void call_helper(u64 (*helper)(Bytecode::Interpreter&, OpType const&), OpType const&);
+    template<typename OpType>
+    void call_execute_impl(OpType const&);
+    void check_exception();
+    void store_program_counter();
+
+    void load_operand(Assembler::Reg, Bytecode::Operand);
+    void store_operand(Bytecode::Operand, Assembler::Reg);
+    void jump_if_not_int32(Assembler::Reg value, Assembler::Reg scratch, Assembler::Label&);
+    void box_int32(Assembler::Reg value, Assembler::Reg scratch);
+    void exit_with(NativeExecutable::ExitReason);
+
+    Assembler::Label& label_for(Bytecode::Label const&);
+
+    Vector<u8> m_output;
+    Assembler m_assembler;
+
+    size_t m_program_counter { 0 };
+    HashMap<size_t, Assembler::Label> m_instruction_labels;
+    HashMap<size_t, size_t> m_native_offsets;
+    Assembler::Label m_exit;
+    Assembler::Label m_exception_exit;
+#endif
+};
+
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJIT/GDB.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+NativeExecutable::NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> native_offsets, Optional<FixedArray<u8>> gdb_object)
+    : m_code(code)
+    , m_size(size)
+    , m_native_offsets(move(native_offsets))
+    , m_gdb_object(move(gdb_object))
+{
+    if (m_gdb_object.has_value())
+        ::JIT::GDB::register_into_gdb(m_gdb_object.value().span());
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    if (m_gdb_object.has_value())
+        ::JIT::GDB::unregister_from_gdb(m_gdb_object.value().span());
+    munmap(m_code, m_size);
+}
+
+NativeExecutable::ExitReason NativeExecutable::run(Bytecode::Interpreter& interpreter, Value* registers_and_constants_and_locals, size_t& program_counter) const
+{
+    using EntryPoint = u64 (*)(Bytecode::Interpreter&, Value*, size_t*, void const*);
+
+    auto native_offset = m_native_offsets.get(program_counter);
+    VERIFY(native_offset.has_value());
+
+    auto entry_point = bit_cast<EntryPoint>(m_code);
+    auto result = entry_point(interpreter, registers_and_constants_and_locals, &program_counter, static_cast<u8 const*>(m_code) + native_offset.value());
+    return static_cast<ExitReason>(result);
+}
+
+}
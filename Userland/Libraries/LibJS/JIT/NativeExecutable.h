@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FixedArray.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+// Machine code for a single Bytecode::Executable, produced by JIT::Compiler.
+// The code can be entered at the start of any bytecode instruction, and hands control back to the
+// interpreter whenever it finishes, throws, or reaches an instruction it does not know how to run.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    enum class ExitReason : u64 {
+        // The executable has finished running (End, Return, Yield or Await).
+        Finished,
+        // The instruction at the program counter threw, the exception is in Register::exception().
+        Exception,
+        // The instruction at the program counter has to be executed by the interpreter.
+        Interpret,
+    };
+
+    NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> native_offsets, Optional<FixedArray<u8>> gdb_object);
+    ~NativeExecutable();
+
+    // Runs the native code starting at the bytecode instruction at program_counter.
+    // On return, program_counter holds the offset of the instruction the exit reason refers to.
+    [[nodiscard]] ExitReason run(Bytecode::Interpreter&, Value* registers_and_constants_and_locals, size_t& program_counter) const;
+
+    ReadonlyBytes code_bytes() const { return { m_code, m_size }; }
+
+private:
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    HashMap<size_t, size_t> m_native_offsets;
+    Optional<FixedArray<u8>> m_gdb_object;
+};
+
+}
@@ -102,6 +102,9 @@ void finish_loading_imported_module(ImportedModuleReferrer referrer, ModuleReque
                 loaded_modules.append(ModuleWithSpecifier {
                     .specifier = module_request.module_specifier,
                     .module = NonnullGCPtr<Module>(*module) });
+                referrer.visit(
+                    [](JS::NonnullGCPtr<JS::Realm>&) {},
+                    [&](auto& script_or_module) { script_or_module->did_store_reference(module); });
             }
         }
     }
@@ -175,6 +178,7 @@ Object* Module::module_namespace_create(VM& vm, Vector<DeprecatedFlyString> unam
 
     // 9. Set module.[[Namespace]] to M.
     m_namespace = make_handle(module_namespace);
+    did_store_reference(m_namespace);
 
     // 10. Return M.
     return module_namespace;
@@ -125,6 +125,7 @@ protected:
     void set_environment(Environment* environment)
     {
         m_environment = environment;
+        did_store_reference(environment);
     }
 
 private:
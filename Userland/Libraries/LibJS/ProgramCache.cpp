@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/ProgramCache.h>
+#include <LibJS/SourceCode.h>
+
+namespace JS {
+
+RefPtr<Program> ProgramCache::get(StringView source_text, StringView filename, size_t line_number_offset, Program::Type type)
+{
+    auto source_hash = source_text.hash();
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto const& entry = m_entries[i];
+        if (entry.source_hash != source_hash || entry.line_number_offset != line_number_offset || entry.program->type() != type)
+            continue;
+        if (entry.filename != filename || entry.program->source_code().code() != source_text)
+            continue;
+
+        auto program = entry.program;
+        if (i != m_entries.size() - 1)
+            m_entries.append(m_entries.take(i));
+        return program;
+    }
+    return {};
+}
+
+void ProgramCache::set(StringView source_text, StringView filename, size_t line_number_offset, NonnullRefPtr<Program> program)
+{
+    // NOTE: Annex B hoisting of functions declared in blocks at the top level depends on the global environment the
+    //       script is evaluated in, and the outcome is stored on the AST. So such a program can't be shared.
+    if (program->has_functions_hoistable_with_annexB_extension())
+        return;
+
+    auto source_bytes = program->source_code().code().bytes().size();
+    if (source_bytes > MAX_CACHED_SOURCE_BYTES)
+        return;
+
+    // Make room by evicting the least recently used programs.
+    while (m_cached_source_bytes + source_bytes > MAX_CACHED_SOURCE_BYTES) {
+        auto evicted_entry = m_entries.take_first();
+        m_cached_source_bytes -= evicted_entry.program->source_code().code().bytes().size();
+    }
+
+    m_entries.append({
+        .source_hash = source_text.hash(),
+        .filename = filename,
+        .line_number_offset = line_number_offset,
+        .program = move(program),
+    });
+    m_cached_source_bytes += source_bytes;
+}
+
+void ProgramCache::clear()
+{
+    m_entries.clear();
+    m_cached_source_bytes = 0;
+}
+
+}
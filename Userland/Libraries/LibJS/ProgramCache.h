@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Noncopyable.h>
+#include <AK/Vector.h>
+#include <LibJS/AST.h>
+
+namespace JS {
+
+// Keeps the ASTs of recently parsed scripts and modules around, so that loading the same source text again doesn't
+// have to parse it again. The bytecode generated for a program and its functions is kept on its AST nodes, so that
+// gets reused too.
+// NOTE: Each VM has its own cache, in memory. Nothing is shared between processes, so every WebContent process still
+//       parses a bundle once for itself.
+class ProgramCache {
+    AK_MAKE_NONCOPYABLE(ProgramCache);
+    AK_MAKE_NONMOVABLE(ProgramCache);
+
+public:
+    ProgramCache() = default;
+
+    RefPtr<Program> get(StringView source_text, StringView filename, size_t line_number_offset, Program::Type);
+    void set(StringView source_text, StringView filename, size_t line_number_offset, NonnullRefPtr<Program>);
+    void clear();
+
+    size_t cached_source_bytes() const { return m_cached_source_bytes; }
+
+private:
+    static constexpr size_t MAX_CACHED_SOURCE_BYTES { 8 * MiB };
+
+    struct Entry {
+        u32 source_hash { 0 };
+        ByteString filename;
+        size_t line_number_offset { 0 };
+        NonnullRefPtr<Program> program;
+    };
+
+    // Least recently used first.
+    Vector<Entry> m_entries;
+    size_t m_cached_source_bytes { 0 };
+};
+
+}
@@ -1406,7 +1406,7 @@ ThrowCompletionOr<String> get_substitution(VM& vm, Utf16View const& matched, Utf
 }
 
 // 2.1.2 AddDisposableResource ( disposable, V, hint [ , method ] ), https://tc39.es/proposal-explicit-resource-management/#sec-adddisposableresource-disposable-v-hint-disposemethod
-ThrowCompletionOr<void> add_disposable_resource(VM& vm, Vector<DisposableResource>& disposable, Value value, Environment::InitializeBindingHint hint, FunctionObject* method)
+ThrowCompletionOr<void> add_disposable_resource(VM& vm, Cell& owner, Vector<DisposableResource>& disposable, Value value, Environment::InitializeBindingHint hint, FunctionObject* method)
 {
     // NOTE: For now only sync is a valid hint
     VERIFY(hint == Environment::InitializeBindingHint::SyncDispose);
@@ -1447,6 +1447,8 @@ ThrowCompletionOr<void> add_disposable_resource(VM& vm, Vector<DisposableResourc
     // 3. Append resource to disposable.[[DisposableResourceStack]].
     VERIFY(resource.has_value());
     disposable.append(resource.release_value());
+    owner.did_store_reference(disposable.last().resource_value);
+    owner.did_store_reference(disposable.last().dispose_method);
 
     // 4. Return NormalCompletion(empty).
     return {};
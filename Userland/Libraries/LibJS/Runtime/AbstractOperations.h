@@ -48,7 +48,8 @@ struct DisposableResource {
     Value resource_value;
     NonnullGCPtr<FunctionObject> dispose_method;
 };
-ThrowCompletionOr<void> add_disposable_resource(VM&, Vector<DisposableResource>& disposable, Value, Environment::InitializeBindingHint, FunctionObject* = nullptr);
+// The owner is the cell holding the disposable resource stack, whose write barrier the appended resource goes through.
+ThrowCompletionOr<void> add_disposable_resource(VM&, Cell& owner, Vector<DisposableResource>& disposable, Value, Environment::InitializeBindingHint, FunctionObject* = nullptr);
 ThrowCompletionOr<DisposableResource> create_disposable_resource(VM&, Value, Environment::InitializeBindingHint, FunctionObject* method = nullptr);
 ThrowCompletionOr<GCPtr<FunctionObject>> get_dispose_method(VM&, Value, Environment::InitializeBindingHint);
 Completion dispose(VM& vm, Value, NonnullGCPtr<FunctionObject> method);
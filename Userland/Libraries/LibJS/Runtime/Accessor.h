@@ -24,10 +24,18 @@ public:
     }
 
     FunctionObject* getter() const { return m_getter; }
-    void set_getter(FunctionObject* getter) { m_getter = getter; }
+    void set_getter(FunctionObject* getter)
+    {
+        m_getter = getter;
+        did_store_reference(m_getter);
+    }
 
     FunctionObject* setter() const { return m_setter; }
-    void set_setter(FunctionObject* setter) { m_setter = setter; }
+    void set_setter(FunctionObject* setter)
+    {
+        m_setter = setter;
+        did_store_reference(m_setter);
+    }
 
     void visit_edges(Cell::Visitor& visitor) override
     {
@@ -179,11 +179,32 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
 }
 
 // 23.1.3.30.1 SortIndexedProperties ( obj, len, SortCompare, holes ), https://tc39.es/ecma262/#sec-sortindexedproperties
+IndexedPropertyStorage const* packed_numeric_storage_for_fast_path(Object const& object, size_t length)
+{
+    if (!is<Array>(object) || object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_packed_numeric_storage() || storage->array_like_size() != length)
+        return nullptr;
+    return storage;
+}
+
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes)
 {
     // 1. Let items be a new empty List.
     auto items = MarkedVector<Value> { vm.heap() };
 
+    // OPTIMIZATION: Packed numeric elements have no holes, and reading them can't run any user code.
+    if (auto const* storage = packed_numeric_storage_for_fast_path(object, length)) {
+        items.ensure_capacity(length);
+        visit_packed_numeric_storage(*storage, [&](auto const& storage) {
+            for (auto element : storage.elements())
+                items.unchecked_append(Value(element));
+        });
+        TRY(array_merge_sort(vm, sort_compare, items));
+        return items;
+    }
+
     // 2. Let k be 0.
     // 3. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
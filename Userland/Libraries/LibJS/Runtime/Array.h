@@ -63,6 +63,15 @@ enum class Holes {
     ReadThroughHoles,
 };
 
+// OPTIMIZATION: Ordinary arrays with packed numeric elements have an own, writable data property for every
+//               index below their length. Returns their storage, so these elements can be read and overwritten
+//               directly, without any observable difference from going through [[Get]] and [[Set]].
+IndexedPropertyStorage const* packed_numeric_storage_for_fast_path(Object const&, size_t length);
+inline IndexedPropertyStorage* packed_numeric_storage_for_fast_path(Object& object, size_t length)
+{
+    return const_cast<IndexedPropertyStorage*>(packed_numeric_storage_for_fast_path(static_cast<Object const&>(object), length));
+}
+
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
@@ -79,7 +79,11 @@ public:
     void set_data_block(DataBlock block) { m_data_block = move(block); }
 
     Value detach_key() const { return m_detach_key; }
-    void set_detach_key(Value detach_key) { m_detach_key = detach_key; }
+    void set_detach_key(Value detach_key)
+    {
+        m_detach_key = detach_key;
+        did_store_reference(m_detach_key);
+    }
 
     void detach_buffer() { m_data_block.byte_buffer = Empty {}; }
 
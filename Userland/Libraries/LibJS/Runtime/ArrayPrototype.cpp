@@ -9,6 +9,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -145,6 +146,23 @@ static ThrowCompletionOr<Object*> array_species_create(VM& vm, Object& original_
     return TRY(construct(vm, constructor.as_function(), Value(length))).ptr();
 }
 
+// OPTIMIZATION: Appending to an ordinary, extensible array can only be observed through its prototype chain.
+static ThrowCompletionOr<bool> can_append_elements_directly(Object const& object)
+{
+    if (!is<Array>(object) || object.may_interfere_with_indexed_property_access())
+        return false;
+    if (!static_cast<Array const&>(object).length_is_writable() || !TRY(object.is_extensible()))
+        return false;
+    auto const* storage = object.indexed_properties().storage();
+    if (storage && storage->kind() == IndexedPropertyStorage::Kind::Generic)
+        return false;
+    for (auto const* prototype = object.prototype(); prototype; prototype = prototype->prototype()) {
+        if (prototype->may_interfere_with_indexed_property_access() || !prototype->indexed_properties().is_empty())
+            return false;
+    }
+    return true;
+}
+
 // 23.1.3.1 Array.prototype.at ( index ), https://tc39.es/ecma262/#sec-array.prototype.at
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::at)
 {
@@ -379,8 +397,21 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::fill)
     else
         to = min(relative_end, length);
 
+    auto value = vm.argument(0);
+    if (from < to && value.is_number() && packed_numeric_storage_for_fast_path(this_object, length)) {
+        // Storing the first element makes sure the elements can hold the value, which may change their kind.
+        this_object->indexed_properties().put(from, value);
+        visit_packed_numeric_storage(*this_object->indexed_properties().storage(), [&](auto& storage) {
+            auto element = storage.to_element(value);
+            auto& elements = storage.elements();
+            for (u64 i = from + 1; i < to; i++)
+                elements[i] = element;
+        });
+        return this_object;
+    }
+
     for (u64 i = from; i < to; i++)
-        TRY(this_object->set(i, vm.argument(0), Object::ShouldThrowExceptions::Yes));
+        TRY(this_object->set(i, value, Object::ShouldThrowExceptions::Yes));
 
     return this_object;
 }
@@ -742,6 +773,20 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+    if (auto* storage = packed_numeric_storage_for_fast_path(this_object, length)) {
+        if (!value_to_find.is_number())
+            return Value(false);
+        auto number_to_find = value_to_find.as_double();
+        return visit_packed_numeric_storage(*storage, [&](auto& storage) {
+            auto const& elements = storage.elements();
+            for (u64 i = from_index; i < length; ++i) {
+                double element = elements[i];
+                if (element == number_to_find || (isnan(element) && isnan(number_to_find)))
+                    return Value(true);
+            }
+            return Value(false);
+        });
+    }
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -795,6 +840,20 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    if (auto* storage = packed_numeric_storage_for_fast_path(object, length)) {
+        if (!search_element.is_number())
+            return Value(-1);
+        auto number_to_find = search_element.as_double();
+        return visit_packed_numeric_storage(*storage, [&](auto& storage) {
+            auto const& elements = storage.elements();
+            for (; k < length; ++k) {
+                if (static_cast<double>(elements[k]) == number_to_find)
+                    return Value(k);
+            }
+            return Value(-1);
+        });
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -1005,6 +1064,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
     auto new_length = length + argument_count;
     if (new_length > MAX_ARRAY_LIKE_INDEX)
         return vm.throw_completion<TypeError>(ErrorType::ArrayMaxSize);
+    if (TRY(can_append_elements_directly(this_object))) {
+        for (size_t i = 0; i < argument_count; ++i) {
+            this_object->indexed_properties().append(vm.argument(i));
+            this_object->did_store_reference(vm.argument(i));
+        }
+        return Value(new_length);
+    }
     for (size_t i = 0; i < argument_count; ++i)
         TRY(this_object->set(length + i, vm.argument(i), Object::ShouldThrowExceptions::Yes));
     auto new_length_value = Value(new_length);
@@ -1395,6 +1461,31 @@ ThrowCompletionOr<void> array_merge_sort(VM& vm, Function<ThrowCompletionOr<doub
     return {};
 }
 
+template<typename T>
+static void sort_packed_numeric_elements_by_string(Vector<T>& elements)
+{
+    struct SortItem {
+        ByteString string;
+        T element;
+        size_t index;
+    };
+
+    Vector<SortItem> items;
+    items.ensure_capacity(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i)
+        items.unchecked_append({ number_to_byte_string(elements[i]), elements[i], i });
+
+    // The sort has to be stable, as different numbers like 0 and -0 share a string representation.
+    quick_sort(items, [](auto const& a, auto const& b) {
+        if (a.string != b.string)
+            return a.string < b.string;
+        return a.index < b.index;
+    });
+
+    for (size_t i = 0; i < items.size(); ++i)
+        elements[i] = items[i].element;
+}
+
 // 23.1.3.30 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -1415,6 +1506,17 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
         return TRY(compare_array_elements(vm, x, y, comparefn.is_undefined() ? nullptr : &comparefn.as_function()));
     };
 
+    // OPTIMIZATION: Without a comparefn, numbers are compared by their string representations, which can be computed
+    //               once up front. None of this can run user code, so the elements can be sorted in place.
+    if (comparefn.is_undefined()) {
+        if (auto* storage = packed_numeric_storage_for_fast_path(object, length)) {
+            visit_packed_numeric_storage(*storage, [](auto& storage) {
+                sort_packed_numeric_elements_by_string(storage.elements());
+            });
+            return object;
+        }
+    }
+
     // 5. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, skip-holes).
     auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles));
 
@@ -1424,6 +1526,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     // 7. Let j be 0.
     size_t j = 0;
 
+    // OPTIMIZATION: comparefn may have changed the array, so only write directly into elements that are still packed.
+    if (item_count == length && packed_numeric_storage_for_fast_path(object, length)) {
+        for (; j < item_count && sorted_list[j].is_number(); ++j)
+            object->indexed_properties().put(j, sorted_list[j]);
+    }
+
     // 8. Repeat, while j < itemCount,
     for (; j < item_count; ++j) {
         // a. Perform ? Set(obj, ! ToString(𝔽(j)), sortedList[j], true).
@@ -43,8 +43,10 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
     auto& realm = *vm.current_realm();
 
     // 1. Let asyncContext be the running execution context.
-    if (!m_suspended_execution_context)
+    if (!m_suspended_execution_context) {
         m_suspended_execution_context = vm.running_execution_context().copy();
+        did_store_references();
+    }
 
     // 2. Let promise be ? PromiseResolve(%Promise%, value).
     auto* promise_object = TRY(promise_resolve(vm, realm.intrinsics().promise_constructor(), value));
@@ -107,6 +109,7 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
 
     // 7. Perform PerformPromiseThen(promise, onFulfilled, onRejected).
     m_current_promise = verify_cast<Promise>(promise_object);
+    did_store_reference(m_current_promise);
     m_current_promise->perform_then(on_fulfilled, on_rejected, {});
 
     // 8. Remove asyncContext from the execution context stack and restore the execution context that is at the top of the
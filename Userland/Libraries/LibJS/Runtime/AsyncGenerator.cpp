@@ -193,6 +193,9 @@ void AsyncGenerator::execute(VM& vm, Completion completion)
 
         auto next_result = bytecode_interpreter.run_executable(*m_generating_function->bytecode_executable(), continuation_address, completion_object);
 
+        // The generator's registers were written to while it was running.
+        did_store_references();
+
         auto result_value = move(next_result.value);
         if (!result_value.is_throw_completion()) {
             m_previous_value = result_value.release_value();
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/DeclarativeEnvironment.h>
 #include <LibJS/Runtime/Error.h>
@@ -15,6 +16,15 @@ namespace JS {
 
 JS_DEFINE_ALLOCATOR(DeclarativeEnvironment);
 
+// NOTE: Serial numbers are unique across all environments, since bytecode (and the global variable caches in it) can be
+//       shared between realms when a program is reused from the VM's program cache.
+static Atomic<u64> s_next_environment_serial_number { 1 };
+
+void DeclarativeEnvironment::bump_environment_serial_number()
+{
+    m_environment_serial_number = s_next_environment_serial_number.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+}
+
 DeclarativeEnvironment* DeclarativeEnvironment::create_for_per_iteration_bindings(Badge<ForStatement>, DeclarativeEnvironment& other, size_t bindings_size)
 {
     auto bindings = other.m_bindings.span().slice(0, bindings_size);
@@ -79,7 +89,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::create_mutable_binding(VM&, Depr
         .initialized = false,
     });
 
-    ++m_environment_serial_number;
+    bump_environment_serial_number();
 
     // 3. Return unused.
     return {};
@@ -102,7 +112,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::create_immutable_binding(VM&, De
         .initialized = false,
     });
 
-    ++m_environment_serial_number;
+    bump_environment_serial_number();
 
     // 3. Return unused.
     return {};
@@ -124,10 +134,11 @@ ThrowCompletionOr<void> DeclarativeEnvironment::initialize_binding_direct(VM& vm
 
     // 2. If hint is not normal, perform ? AddDisposableResource(envRec, V, hint).
     if (hint != Environment::InitializeBindingHint::Normal)
-        TRY(add_disposable_resource(vm, m_disposable_resource_stack, value, hint));
+        TRY(add_disposable_resource(vm, *this, m_disposable_resource_stack, value, hint));
 
     // 3. Set the bound value for N in envRec to V.
     binding.value = value;
+    did_store_reference(value);
 
     // 4. Record that the binding for N in envRec has been initialized.
     binding.initialized = true;
@@ -178,6 +189,7 @@ ThrowCompletionOr<void> DeclarativeEnvironment::set_mutable_binding_direct(VM& v
 
     if (binding.mutable_) {
         binding.value = value;
+        did_store_reference(value);
     } else {
         if (strict)
             return vm.throw_completion<TypeError>(ErrorType::InvalidAssignToConst);
@@ -212,7 +224,7 @@ ThrowCompletionOr<bool> DeclarativeEnvironment::delete_binding(VM&, DeprecatedFl
     // NOTE: We keep the entries in m_bindings to avoid disturbing indices.
     binding_and_index->binding() = {};
 
-    ++m_environment_serial_number;
+    bump_environment_serial_number();
 
     // 4. Return true.
     return true;
@@ -70,6 +70,8 @@ public:
     [[nodiscard]] u64 environment_serial_number() const { return m_environment_serial_number; }
 
 private:
+    void bump_environment_serial_number();
+
     ThrowCompletionOr<Value> get_binding_value_direct(VM&, Binding const&) const;
     ThrowCompletionOr<void> set_mutable_binding_direct(VM&, Binding&, Value, bool strict);
 
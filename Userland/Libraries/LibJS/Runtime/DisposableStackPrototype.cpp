@@ -103,7 +103,7 @@ JS_DEFINE_NATIVE_FUNCTION(DisposableStackPrototype::use)
         // d. Else,
         // i. Perform ? AddDisposableResource(disposableStack, value, sync-dispose, method).
         // FIXME: Fairly sure this can't fail, see https://github.com/tc39/proposal-explicit-resource-management/pull/142
-        MUST(add_disposable_resource(vm, disposable_stack->disposable_resource_stack(), value, Environment::InitializeBindingHint::SyncDispose, method));
+        MUST(add_disposable_resource(vm, *disposable_stack, disposable_stack->disposable_resource_stack(), value, Environment::InitializeBindingHint::SyncDispose, method));
     }
 
     // 5. Return value.
@@ -148,7 +148,7 @@ JS_DEFINE_NATIVE_FUNCTION(DisposableStackPrototype::adopt)
         0, "");
 
     // 8. Perform ? AddDisposableResource(disposableStack, undefined, sync-dispose, F).
-    TRY(add_disposable_resource(vm, disposable_stack->disposable_resource_stack(), js_undefined(), Environment::InitializeBindingHint::SyncDispose, function));
+    TRY(add_disposable_resource(vm, *disposable_stack, disposable_stack->disposable_resource_stack(), js_undefined(), Environment::InitializeBindingHint::SyncDispose, function));
 
     // 9. Return value.
     return value;
@@ -172,7 +172,7 @@ JS_DEFINE_NATIVE_FUNCTION(DisposableStackPrototype::defer)
         return vm.throw_completion<TypeError>(ErrorType::NotAFunction, on_dispose.to_string_without_side_effects());
 
     // 5. Perform ? AddDisposableResource(disposableStack, undefined, sync-dispose, onDispose).
-    TRY(add_disposable_resource(vm, disposable_stack->disposable_resource_stack(), js_undefined(), Environment::InitializeBindingHint::SyncDispose, &on_dispose.as_function()));
+    TRY(add_disposable_resource(vm, *disposable_stack, disposable_stack->disposable_resource_stack(), js_undefined(), Environment::InitializeBindingHint::SyncDispose, &on_dispose.as_function()));
 
     // 6. Return undefined.
     return js_undefined();
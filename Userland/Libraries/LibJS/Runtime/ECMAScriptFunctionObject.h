@@ -72,16 +72,28 @@ public:
     ThisMode this_mode() const { return m_this_mode; }
 
     Object* home_object() const { return m_home_object; }
-    void set_home_object(Object* home_object) { m_home_object = home_object; }
+    void set_home_object(Object* home_object)
+    {
+        m_home_object = home_object;
+        did_store_reference(m_home_object);
+    }
 
     ByteString const& source_text() const { return m_source_text; }
     void set_source_text(ByteString source_text) { m_source_text = move(source_text); }
 
     Vector<ClassFieldDefinition> const& fields() const { return m_fields; }
-    void add_field(ClassFieldDefinition field) { m_fields.append(move(field)); }
+    void add_field(ClassFieldDefinition field)
+    {
+        m_fields.append(move(field));
+        did_store_references();
+    }
 
     Vector<PrivateElement> const& private_methods() const { return m_private_methods; }
-    void add_private_method(PrivateElement method) { m_private_methods.append(move(method)); }
+    void add_private_method(PrivateElement method)
+    {
+        m_private_methods.append(move(method));
+        did_store_reference(m_private_methods.last().value);
+    }
 
     // This is for IsSimpleParameterList (static semantics)
     bool has_simple_parameter_list() const { return m_has_simple_parameter_list; }
@@ -95,7 +107,13 @@ public:
 
     // This is used by LibWeb to disassociate event handler attribute callback functions from the nearest script on the call stack.
     // https://html.spec.whatwg.org/multipage/webappapis.html#getting-the-current-value-of-the-event-handler Step 3.11
-    void set_script_or_module(ScriptOrModule script_or_module) { m_script_or_module = move(script_or_module); }
+    void set_script_or_module(ScriptOrModule script_or_module)
+    {
+        m_script_or_module = move(script_or_module);
+        m_script_or_module.visit(
+            [](Empty) {},
+            [&](auto const& script_or_module) { did_store_reference(script_or_module); });
+    }
 
     Variant<PropertyKey, PrivateName, Empty> const& class_field_initializer_name() const { return m_class_field_initializer_name; }
 
@@ -23,6 +23,8 @@ void FinalizationRegistry::add_finalization_record(Cell& target, Value held_valu
 {
     VERIFY(!held_value.is_empty());
     m_records.append({ &target, held_value, unregister_token });
+    did_store_reference(held_value);
+    did_store_reference(unregister_token);
 }
 
 // Extracted from FinalizationRegistry.prototype.unregister ( unregisterToken )
@@ -26,6 +26,12 @@ void FunctionEnvironment::visit_edges(Visitor& visitor)
     visitor.visit(m_function_object);
 }
 
+void FunctionEnvironment::set_function_object(ECMAScriptFunctionObject& function)
+{
+    m_function_object = &function;
+    did_store_reference(m_function_object);
+}
+
 // 9.1.1.3.5 GetSuperBase ( ), https://tc39.es/ecma262/#sec-getsuperbase
 ThrowCompletionOr<Value> FunctionEnvironment::get_super_base() const
 {
@@ -90,6 +96,7 @@ ThrowCompletionOr<Value> FunctionEnvironment::bind_this_value(VM& vm, Value this
 
     // 3. Set envRec.[[ThisValue]] to V.
     m_this_value = this_value;
+    did_store_reference(m_this_value);
 
     // 4. Set envRec.[[ThisBindingStatus]] to initialized.
     m_this_binding_status = ThisBindingStatus::Initialized;
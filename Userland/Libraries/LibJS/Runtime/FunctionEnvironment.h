@@ -29,13 +29,14 @@ public:
 
     ECMAScriptFunctionObject& function_object() { return *m_function_object; }
     ECMAScriptFunctionObject const& function_object() const { return *m_function_object; }
-    void set_function_object(ECMAScriptFunctionObject& function) { m_function_object = &function; }
+    void set_function_object(ECMAScriptFunctionObject& function);
 
     Value new_target() const { return m_new_target; }
     void set_new_target(Value new_target)
     {
         VERIFY(!new_target.is_empty());
         m_new_target = new_target;
+        did_store_reference(m_new_target);
     }
 
     // Abstract operations
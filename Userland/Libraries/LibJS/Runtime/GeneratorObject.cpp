@@ -114,6 +114,9 @@ ThrowCompletionOr<Value> GeneratorObject::execute(VM& vm, Completion const& comp
 
     vm.pop_execution_context();
 
+    // The generator's registers were written to while it was running.
+    did_store_references();
+
     auto result_value = move(next_result.value);
     if (result_value.is_throw_completion()) {
         // Uncaught exceptions disable the generator.
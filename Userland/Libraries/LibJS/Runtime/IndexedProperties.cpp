@@ -14,12 +14,24 @@ constexpr size_t const SPARSE_ARRAY_HOLE_THRESHOLD = 200;
 constexpr size_t const LENGTH_SETTER_GENERIC_STORAGE_THRESHOLD = 4 * MiB;
 
 SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initial_values)
-    : IndexedPropertyStorage(IsSimpleStorage::Yes)
+    : IndexedPropertyStorage(Kind::Simple)
     , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
 }
 
+template<typename T>
+SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(PackedNumericIndexedPropertyStorage<T> const& storage)
+    : IndexedPropertyStorage(Kind::Simple)
+    , m_array_size(storage.array_like_size())
+{
+    auto const& elements = storage.elements();
+    // Keep the spare capacity around, as we're most likely about to grow.
+    m_packed_elements.ensure_capacity(max(elements.capacity(), elements.size() + 1));
+    for (auto element : elements)
+        m_packed_elements.unchecked_append(Value(element));
+}
+
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
 {
     return inline_has_index(index);
@@ -82,7 +94,7 @@ bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 }
 
 GenericIndexedPropertyStorage::GenericIndexedPropertyStorage(SimpleIndexedPropertyStorage&& storage)
-    : IndexedPropertyStorage(IsSimpleStorage::No)
+    : IndexedPropertyStorage(Kind::Generic)
 {
     m_array_size = storage.array_like_size();
     for (size_t i = 0; i < storage.m_packed_elements.size(); ++i) {
@@ -221,6 +233,35 @@ void IndexedPropertyIterator::skip_empty_indices()
     m_index = m_indexed_properties.array_like_size();
 }
 
+IndexedProperties::IndexedProperties(Vector<Value> values)
+{
+    if (values.is_empty())
+        return;
+
+    bool all_int32 = true;
+    bool all_numbers = true;
+    for (auto value : values) {
+        all_int32 = all_int32 && value.is_int32();
+        all_numbers = all_numbers && value.is_number();
+    }
+
+    if (all_int32) {
+        Vector<i32> elements;
+        elements.ensure_capacity(values.size());
+        for (auto value : values)
+            elements.unchecked_append(value.as_i32());
+        m_storage = make<PackedInt32IndexedPropertyStorage>(move(elements));
+    } else if (all_numbers) {
+        Vector<double> elements;
+        elements.ensure_capacity(values.size());
+        for (auto value : values)
+            elements.unchecked_append(value.as_double());
+        m_storage = make<PackedDoubleIndexedPropertyStorage>(move(elements));
+    } else {
+        m_storage = make<SimpleIndexedPropertyStorage>(move(values));
+    }
+}
+
 Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
 {
     if (!m_storage)
@@ -231,6 +272,14 @@ Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
 void IndexedProperties::put(u32 index, Value value, PropertyAttributes attributes)
 {
     ensure_storage();
+    if (m_storage->is_packed_numeric_storage()) {
+        // Packed storage can only be written to in place or appended to, with values of its element type.
+        if (attributes != default_attributes || index > array_like_size() || !value.is_number())
+            switch_to_simple_storage();
+        else if (m_storage->kind() == IndexedPropertyStorage::Kind::PackedInt32 && !value.is_int32())
+            switch_to_packed_double_storage();
+    }
+
     if (m_storage->is_simple_storage() && (attributes != default_attributes || index > (array_like_size() + SPARSE_ARRAY_HOLE_THRESHOLD))) {
         switch_to_generic_storage();
     }
@@ -242,6 +291,9 @@ void IndexedProperties::remove(u32 index)
 {
     VERIFY(m_storage);
     VERIFY(m_storage->has_index(index));
+    // Removing an element leaves a hole, which packed storage can't represent.
+    if (m_storage->is_packed_numeric_storage())
+        switch_to_simple_storage();
     m_storage->remove(index);
 }
 
@@ -250,6 +302,9 @@ bool IndexedProperties::set_array_like_size(size_t new_size)
     ensure_storage();
     auto current_array_like_size = array_like_size();
 
+    if (m_storage->is_packed_numeric_storage() && new_size > current_array_like_size)
+        switch_to_simple_storage();
+
     // We can't use simple storage for lengths that don't fit in an i32.
     // Also, to avoid gigantic unused storage allocations, let's put an (arbitrary) 4M cap on simple storage here.
     // This prevents something like "a = []; a.length = 0x80000000;" from allocating 2G entries.
@@ -266,6 +321,8 @@ size_t IndexedProperties::real_size() const
 {
     if (!m_storage)
         return 0;
+    if (m_storage->is_packed_numeric_storage())
+        return m_storage->size();
     if (m_storage->is_simple_storage()) {
         auto& packed_elements = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage).elements();
         size_t size = 0;
@@ -282,6 +339,13 @@ Vector<u32> IndexedProperties::indices() const
 {
     if (!m_storage)
         return {};
+    if (m_storage->is_packed_numeric_storage()) {
+        Vector<u32> indices;
+        indices.ensure_capacity(m_storage->size());
+        for (size_t i = 0; i < m_storage->size(); ++i)
+            indices.unchecked_append(i);
+        return indices;
+    }
     if (m_storage->is_simple_storage()) {
         auto const& storage = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage);
         auto const& elements = storage.elements();
@@ -299,12 +363,40 @@ Vector<u32> IndexedProperties::indices() const
     return indices;
 }
 
+void IndexedProperties::switch_to_packed_double_storage()
+{
+    VERIFY(m_storage && m_storage->kind() == IndexedPropertyStorage::Kind::PackedInt32);
+    auto const& int32_elements = static_cast<PackedInt32IndexedPropertyStorage const&>(*m_storage).elements();
+    Vector<double> elements;
+    elements.ensure_capacity(max(int32_elements.capacity(), int32_elements.size() + 1));
+    for (auto element : int32_elements)
+        elements.unchecked_append(element);
+    m_storage = make<PackedDoubleIndexedPropertyStorage>(move(elements));
+}
+
+void IndexedProperties::switch_to_simple_storage()
+{
+    VERIFY(m_storage);
+    switch (m_storage->kind()) {
+    case IndexedPropertyStorage::Kind::PackedInt32:
+        m_storage = make<SimpleIndexedPropertyStorage>(static_cast<PackedInt32IndexedPropertyStorage const&>(*m_storage));
+        break;
+    case IndexedPropertyStorage::Kind::PackedDouble:
+        m_storage = make<SimpleIndexedPropertyStorage>(static_cast<PackedDoubleIndexedPropertyStorage const&>(*m_storage));
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
 void IndexedProperties::switch_to_generic_storage()
 {
     if (!m_storage) {
         m_storage = make<GenericIndexedPropertyStorage>();
         return;
     }
+    if (m_storage->is_packed_numeric_storage())
+        switch_to_simple_storage();
     auto& storage = static_cast<SimpleIndexedPropertyStorage&>(*m_storage);
     m_storage = make<GenericIndexedPropertyStorage>(move(storage));
 }
@@ -312,7 +404,7 @@ void IndexedProperties::switch_to_generic_storage()
 void IndexedProperties::ensure_storage()
 {
     if (!m_storage)
-        m_storage = make<SimpleIndexedPropertyStorage>();
+        m_storage = make<PackedInt32IndexedPropertyStorage>();
 }
 
 }
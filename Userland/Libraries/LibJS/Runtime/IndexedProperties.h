@@ -27,9 +27,13 @@ class IndexedPropertyStorage {
 public:
     virtual ~IndexedPropertyStorage() = default;
 
-    enum class IsSimpleStorage {
-        No,
-        Yes,
+    // Storages are ordered from most to least specialized; IndexedProperties only ever moves
+    // an object's elements towards a more general kind.
+    enum class Kind : u8 {
+        PackedInt32,
+        PackedDouble,
+        Simple,
+        Generic,
     };
 
     virtual bool has_index(u32 index) const = 0;
@@ -44,25 +48,119 @@ public:
     virtual size_t array_like_size() const = 0;
     virtual bool set_array_like_size(size_t new_size) = 0;
 
-    bool is_simple_storage() const { return m_is_simple_storage; }
+    Kind kind() const { return m_kind; }
+    bool is_simple_storage() const { return m_kind == Kind::Simple; }
+    bool is_packed_numeric_storage() const { return m_kind == Kind::PackedInt32 || m_kind == Kind::PackedDouble; }
 
 protected:
-    explicit IndexedPropertyStorage(IsSimpleStorage is_simple_storage)
-        : m_is_simple_storage(is_simple_storage == IsSimpleStorage::Yes)
+    explicit IndexedPropertyStorage(Kind kind)
+        : m_kind(kind)
     {
     }
 
 private:
-    bool m_is_simple_storage { false };
+    Kind m_kind { Kind::Generic };
 };
 
+// Elements without holes or non-default attributes, stored as raw numbers. Values that don't fit
+// the element type are never put here; IndexedProperties switches to a more general storage first.
+template<typename T>
+class PackedNumericIndexedPropertyStorage final : public IndexedPropertyStorage {
+public:
+    static constexpr Kind storage_kind = IsSame<T, i32> ? Kind::PackedInt32 : Kind::PackedDouble;
+
+    PackedNumericIndexedPropertyStorage()
+        : IndexedPropertyStorage(storage_kind)
+    {
+    }
+    explicit PackedNumericIndexedPropertyStorage(Vector<T>&& initial_elements)
+        : IndexedPropertyStorage(storage_kind)
+        , m_elements(move(initial_elements))
+    {
+    }
+
+    static bool can_store(Value value)
+    {
+        if constexpr (IsSame<T, i32>)
+            return value.is_int32();
+        else
+            return value.is_number();
+    }
+
+    static T to_element(Value value)
+    {
+        if constexpr (IsSame<T, i32>)
+            return value.as_i32();
+        else
+            return value.as_double();
+    }
+
+    virtual bool has_index(u32 index) const override { return index < m_elements.size(); }
+    virtual Optional<ValueAndAttributes> get(u32 index) const override { return inline_get(index); }
+    virtual void put(u32 index, Value value, PropertyAttributes attributes = default_attributes) override
+    {
+        VERIFY(attributes == default_attributes);
+        VERIFY(index <= m_elements.size());
+        if (index == m_elements.size())
+            m_elements.append(to_element(value));
+        else
+            inline_set(index, value);
+    }
+    virtual void remove(u32) override { VERIFY_NOT_REACHED(); }
+
+    virtual ValueAndAttributes take_first() override { return { Value(m_elements.take_first()), default_attributes }; }
+    virtual ValueAndAttributes take_last() override { return { Value(m_elements.take_last()), default_attributes }; }
+
+    virtual size_t size() const override { return m_elements.size(); }
+    virtual size_t array_like_size() const override { return m_elements.size(); }
+    virtual bool set_array_like_size(size_t new_size) override
+    {
+        VERIFY(new_size <= m_elements.size());
+        m_elements.shrink(new_size, true);
+        return true;
+    }
+
+    Vector<T> const& elements() const { return m_elements; }
+    Vector<T>& elements() { return m_elements; }
+
+    [[nodiscard]] Optional<ValueAndAttributes> inline_get(u32 index) const
+    {
+        if (index >= m_elements.size())
+            return {};
+        return ValueAndAttributes { Value(m_elements.data()[index]), default_attributes };
+    }
+
+    void inline_set(u32 index, Value value)
+    {
+        VERIFY(can_store(value));
+        m_elements.data()[index] = to_element(value);
+    }
+
+private:
+    Vector<T> m_elements;
+};
+
+using PackedInt32IndexedPropertyStorage = PackedNumericIndexedPropertyStorage<i32>;
+using PackedDoubleIndexedPropertyStorage = PackedNumericIndexedPropertyStorage<double>;
+
+template<typename Storage, typename Callback>
+decltype(auto) visit_packed_numeric_storage(Storage& storage, Callback callback)
+{
+    VERIFY(storage.is_packed_numeric_storage());
+    if (storage.kind() == IndexedPropertyStorage::Kind::PackedInt32)
+        return callback(static_cast<CopyConst<Storage, PackedInt32IndexedPropertyStorage>&>(storage));
+    return callback(static_cast<CopyConst<Storage, PackedDoubleIndexedPropertyStorage>&>(storage));
+}
+
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
     SimpleIndexedPropertyStorage()
-        : IndexedPropertyStorage(IsSimpleStorage::Yes)
+        : IndexedPropertyStorage(Kind::Simple)
     {
     }
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
+    template<typename T>
+    explicit SimpleIndexedPropertyStorage(PackedNumericIndexedPropertyStorage<T> const&);
 
     virtual bool has_index(u32 index) const override;
     virtual Optional<ValueAndAttributes> get(u32 index) const override;
@@ -103,7 +201,7 @@ class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
     explicit GenericIndexedPropertyStorage(SimpleIndexedPropertyStorage&&);
     explicit GenericIndexedPropertyStorage()
-        : IndexedPropertyStorage(IsSimpleStorage::No)
+        : IndexedPropertyStorage(Kind::Generic)
     {
     }
 
@@ -150,11 +248,7 @@ class IndexedProperties {
 public:
     IndexedProperties() = default;
 
-    explicit IndexedProperties(Vector<Value> values)
-    {
-        if (!values.is_empty())
-            m_storage = make<SimpleIndexedPropertyStorage>(move(values));
-    }
+    explicit IndexedProperties(Vector<Value> values);
 
     bool has_index(u32 index) const { return m_storage ? m_storage->has_index(index) : false; }
     Optional<ValueAndAttributes> get(u32 index) const;
@@ -182,16 +276,25 @@ public:
     {
         if (!m_storage)
             return;
-        if (m_storage->is_simple_storage()) {
+        switch (m_storage->kind()) {
+        case IndexedPropertyStorage::Kind::PackedInt32:
+        case IndexedPropertyStorage::Kind::PackedDouble:
+            // Raw numbers never need to be visited.
+            break;
+        case IndexedPropertyStorage::Kind::Simple:
             for (auto& value : static_cast<SimpleIndexedPropertyStorage&>(*m_storage).elements())
                 callback(value);
-        } else {
+            break;
+        case IndexedPropertyStorage::Kind::Generic:
             for (auto& element : static_cast<GenericIndexedPropertyStorage const&>(*m_storage).sparse_elements())
                 callback(element.value.value);
+            break;
         }
     }
 
 private:
+    void switch_to_packed_double_storage();
+    void switch_to_simple_storage();
     void switch_to_generic_storage();
     void ensure_storage();
 
@@ -71,7 +71,11 @@ public:
     void set_numeric(bool numeric) { m_numeric = numeric; }
 
     CollatorCompareFunction* bound_compare() const { return m_bound_compare; }
-    void set_bound_compare(CollatorCompareFunction* bound_compare) { m_bound_compare = bound_compare; }
+    void set_bound_compare(CollatorCompareFunction* bound_compare)
+    {
+        m_bound_compare = bound_compare;
+        did_store_reference(m_bound_compare);
+    }
 
 private:
     explicit Collator(Object& prototype);
@@ -125,7 +125,11 @@ public:
     StringView time_zone_name_string() const { return ::Locale::calendar_pattern_style_to_string(*Patterns::time_zone_name); }
 
     NativeFunction* bound_format() const { return m_bound_format; }
-    void set_bound_format(NativeFunction* bound_format) { m_bound_format = bound_format; }
+    void set_bound_format(NativeFunction* bound_format)
+    {
+        m_bound_format = bound_format;
+        did_store_reference(m_bound_format);
+    }
 
 private:
     DateTimeFormat(Object& prototype);
@@ -384,6 +384,12 @@ StringView NumberFormat::sign_display_string() const
     }
 }
 
+void NumberFormat::set_bound_format(NativeFunction* bound_format)
+{
+    m_bound_format = bound_format;
+    did_store_reference(m_bound_format);
+}
+
 // 15.5.1 CurrencyDigits ( currency ), https://tc39.es/ecma402/#sec-currencydigits
 int currency_digits(StringView currency)
 {
@@ -241,7 +241,7 @@ public:
     void set_sign_display(StringView sign_display);
 
     NativeFunction* bound_format() const { return m_bound_format; }
-    void set_bound_format(NativeFunction* bound_format) { m_bound_format = bound_format; }
+    void set_bound_format(NativeFunction* bound_format);
 
     bool has_compact_format() const { return m_compact_format.has_value(); }
     void set_compact_format(::Locale::NumberFormat compact_format) { m_compact_format = compact_format; }
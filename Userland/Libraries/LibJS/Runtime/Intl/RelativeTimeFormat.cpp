@@ -32,6 +32,18 @@ void RelativeTimeFormat::visit_edges(Cell::Visitor& visitor)
         visitor.visit(m_plural_rules);
 }
 
+void RelativeTimeFormat::set_number_format(NumberFormat* number_format)
+{
+    m_number_format = number_format;
+    did_store_reference(m_number_format);
+}
+
+void RelativeTimeFormat::set_plural_rules(PluralRules* plural_rules)
+{
+    m_plural_rules = plural_rules;
+    did_store_reference(m_plural_rules);
+}
+
 void RelativeTimeFormat::set_numeric(StringView numeric)
 {
     if (numeric == "always"sv) {
@@ -54,10 +54,10 @@ public:
     StringView numeric_string() const;
 
     NumberFormat& number_format() const { return *m_number_format; }
-    void set_number_format(NumberFormat* number_format) { m_number_format = number_format; }
+    void set_number_format(NumberFormat* number_format);
 
     PluralRules& plural_rules() const { return *m_plural_rules; }
-    void set_plural_rules(PluralRules* plural_rules) { m_plural_rules = plural_rules; }
+    void set_plural_rules(PluralRules* plural_rules);
 
 private:
     explicit RelativeTimeFormat(Object& prototype);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibJS/Heap/DeferGC.h>
 #include <LibJS/Runtime/AggregateErrorConstructor.h>
 #include <LibJS/Runtime/AggregateErrorPrototype.h>
 #include <LibJS/Runtime/ArrayBufferConstructor.h>
@@ -288,6 +289,8 @@ JS_ENUMERATE_TYPED_ARRAYS
     void Intrinsics::initialize_##snake_namespace##snake_name()                                                                                          \
     {                                                                                                                                                    \
         auto& vm = this->vm();                                                                                                                           \
+        /* NOTE: This may run long after the intrinsics became old, so only collect once the new cells have been stored and recorded. */                 \
+        DeferGC defer_gc(heap());                                                                                                                        \
                                                                                                                                                          \
         VERIFY(!m_##snake_namespace##snake_name##_prototype);                                                                                            \
         VERIFY(!m_##snake_namespace##snake_name##_constructor);                                                                                          \
@@ -318,6 +321,8 @@ JS_ENUMERATE_TYPED_ARRAYS
             initialize_constructor(vm, vm.names.Symbol, *m_##snake_namespace##snake_name##_constructor, m_##snake_namespace##snake_name##_prototype);    \
         else                                                                                                                                             \
             initialize_constructor(vm, vm.names.ClassName, *m_##snake_namespace##snake_name##_constructor, m_##snake_namespace##snake_name##_prototype); \
+                                                                                                                                                         \
+        did_store_references();                                                                                                                          \
     }                                                                                                                                                    \
                                                                                                                                                          \
     NonnullGCPtr<Namespace::ConstructorName> Intrinsics::snake_namespace##snake_name##_constructor()                                                     \
@@ -354,8 +359,10 @@ JS_ENUMERATE_TEMPORAL_OBJECTS
 #define __JS_ENUMERATE(ClassName, snake_name)                                       \
     NonnullGCPtr<ClassName> Intrinsics::snake_name##_object()                       \
     {                                                                               \
-        if (!m_##snake_name##_object)                                               \
+        if (!m_##snake_name##_object) {                                             \
             m_##snake_name##_object = heap().allocate<ClassName>(m_realm, m_realm); \
+            did_store_reference(m_##snake_name##_object);                           \
+        }                                                                           \
         return *m_##snake_name##_object;                                            \
     }
 JS_ENUMERATE_BUILTIN_NAMESPACE_OBJECTS
@@ -71,7 +71,9 @@ void Map::map_set(Value const& key, Value value)
         auto index = m_next_insertion_id++;
         m_keys.insert(index, key);
         m_entries.set(key, value);
+        did_store_reference(key);
     }
+    did_store_reference(value);
 }
 
 size_t Map::map_size() const
@@ -552,6 +552,7 @@ ThrowCompletionOr<void> Object::private_field_add(PrivateName const& name, Value
 
     // 4. Append PrivateElement { [[Key]]: P, [[Kind]]: field, [[Value]]: value } to O.[[PrivateElements]].
     m_private_elements->empend(name, PrivateElement::Kind::Field, value);
+    did_store_reference(value);
 
     // 5. Return unused.
     return {};
@@ -580,6 +581,7 @@ ThrowCompletionOr<void> Object::private_method_or_accessor_add(PrivateElement el
 
     // 5. Append method to O.[[PrivateElements]].
     m_private_elements->append(move(element));
+    did_store_reference(m_private_elements->last().value);
 
     // 6. Return unused.
     return {};
@@ -635,6 +637,7 @@ ThrowCompletionOr<void> Object::private_set(PrivateName const& name, Value value
     if (entry->kind == PrivateElement::Kind::Field) {
         // a. Set entry.[[Value]] to value.
         entry->value = value;
+        did_store_reference(value);
         return {};
     }
     // 4. Else if entry.[[Kind]] is method, then
@@ -1177,7 +1180,7 @@ Optional<ValueAndAttributes> Object::storage_get(PropertyKey const& property_key
 
         if (m_has_intrinsic_accessors) {
             if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value())
-                const_cast<Object&>(*this).m_storage[metadata->offset] = (*accessor)(shape().realm());
+                const_cast<Object&>(*this).put_direct(metadata->offset, (*accessor)(shape().realm()));
         }
 
         value = m_storage[metadata->offset];
@@ -1205,6 +1208,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
     if (property_key.is_number()) {
         auto index = property_key.as_number();
         m_indexed_properties.put(index, value, attributes);
+        did_store_reference(value);
         return;
     }
 
@@ -1226,6 +1230,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
         else
             set_shape(*m_shape->create_put_transition(property_key_string_or_symbol, attributes));
         m_storage.append(value);
+        did_store_reference(value);
         return;
     }
 
@@ -1236,7 +1241,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
             set_shape(*m_shape->create_configure_transition(property_key_string_or_symbol, attributes));
     }
 
-    m_storage[metadata->offset] = value;
+    put_direct(metadata->offset, value);
 }
 
 void Object::storage_delete(PropertyKey const& property_key)
@@ -1256,14 +1261,14 @@ void Object::storage_delete(PropertyKey const& property_key)
     VERIFY(metadata.has_value());
 
     if (m_shape->is_cacheable_dictionary()) {
-        m_shape = m_shape->create_uncacheable_dictionary_transition();
+        set_shape(m_shape->create_uncacheable_dictionary_transition());
     }
     if (m_shape->is_uncacheable_dictionary()) {
         m_shape->remove_property_without_transition(property_key.to_string_or_symbol(), metadata->offset);
         m_storage.remove(metadata->offset);
         return;
     }
-    m_shape = m_shape->create_delete_transition(property_key.to_string_or_symbol());
+    set_shape(*m_shape->create_delete_transition(property_key.to_string_or_symbol()));
     m_storage.remove(metadata->offset);
 }
 
@@ -1271,7 +1276,7 @@ void Object::set_prototype(Object* new_prototype)
 {
     if (prototype() == new_prototype)
         return;
-    m_shape = shape().create_prototype_transition(new_prototype);
+    set_shape(*shape().create_prototype_transition(new_prototype));
 }
 
 void Object::define_native_accessor(Realm& realm, PropertyKey const& property_key, Function<ThrowCompletionOr<Value>(VM&)> getter, Function<ThrowCompletionOr<Value>(VM&)> setter, PropertyAttributes attribute)
@@ -209,11 +209,40 @@ public:
     virtual void visit_edges(Cell::Visitor&) override;
 
     Value get_direct(size_t index) const { return m_storage[index]; }
-    void put_direct(size_t index, Value value) { m_storage[index] = value; }
+    void put_direct(size_t index, Value value)
+    {
+        m_storage[index] = value;
+        did_store_reference(value);
+    }
+
+    // Adds a property that an inline cache has seen added to objects with our shape before, which gave them `new_shape`.
+    void add_direct_with_cached_transition(Shape& new_shape, Value value)
+    {
+        VERIFY(m_storage.size() == shape().property_count());
+        VERIFY(new_shape.property_count() == m_storage.size() + 1);
+        set_shape(new_shape);
+        m_storage.append(value);
+        did_store_reference(value);
+    }
+
+    // Whether adding a named property to this object by [[Set]] always behaves like it does for ordinary objects.
+    [[nodiscard]] bool can_cache_property_additions() const
+    {
+        return m_is_extensible
+            && !m_may_interfere_with_indexed_property_access
+            && !m_may_interfere_with_named_property_access
+            && !m_has_magical_length_property
+            && !m_is_typed_array;
+    }
+    bool may_interfere_with_named_property_access() const { return m_may_interfere_with_named_property_access; }
 
     IndexedProperties const& indexed_properties() const { return m_indexed_properties; }
     IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        m_indexed_properties = IndexedProperties(move(values));
+        did_store_references();
+    }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
@@ -253,8 +282,15 @@ protected:
 
     bool m_is_typed_array { false };
 
+    // Set by objects that customize [[Set]] or [[DefineOwnProperty]] for named properties without changing their shape.
+    bool m_may_interfere_with_named_property_access { false };
+
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape& shape)
+    {
+        m_shape = &shape;
+        did_store_reference(&shape);
+    }
 
     Object* prototype() { return shape().prototype(); }
 
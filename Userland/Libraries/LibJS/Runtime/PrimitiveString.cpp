@@ -254,6 +254,51 @@ NonnullGCPtr<PrimitiveString> PrimitiveString::create(VM& vm, PrimitiveString& l
     return vm.heap().allocate_without_realm<PrimitiveString>(lhs, rhs);
 }
 
+// Surrogates encoded as UTF-8 (as we allow for lone surrogates) are 3 bytes long: 0xED, then 0xA0-0xAF for high
+// surrogates or 0xB0-0xBF for low surrogates, then a continuation byte.
+static Optional<u16> utf8_encoded_surrogate_at(StringView string, size_t offset)
+{
+    if (offset + 3 > string.length())
+        return {};
+    auto first = static_cast<u8>(string[offset]);
+    auto second = static_cast<u8>(string[offset + 1]);
+    auto third = static_cast<u8>(string[offset + 2]);
+    if (first != 0xed || (second & 0xe0) != 0xa0)
+        return {};
+    return static_cast<u16>(0xd000 | ((second & 0x3f) << 6) | (third & 0x3f));
+}
+
+static size_t utf8_length_of(Utf16View const& string)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < string.length_in_code_units(); ++i) {
+        auto code_unit = string.code_unit_at(i);
+        if (code_unit < 0x80) {
+            length += 1;
+        } else if (code_unit < 0x800) {
+            length += 2;
+        } else if (Utf16View::is_high_surrogate(code_unit) && i + 1 < string.length_in_code_units() && Utf16View::is_low_surrogate(string.code_unit_at(i + 1))) {
+            length += 4;
+            ++i;
+        } else {
+            length += 3;
+        }
+    }
+    return length;
+}
+
+// NOTE: The pieces of a rope are read in whichever encoding they already have. Converting them here doesn't cache the
+//       result on them, as that would leave every piece holding two copies of itself.
+StringView PrimitiveString::existing_utf8_string_view() const
+{
+    VERIFY(!m_is_rope);
+    if (has_utf8_string())
+        return m_utf8_string->bytes_as_string_view();
+    if (has_byte_string())
+        return m_byte_string->view();
+    return {};
+}
+
 void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) const
 {
     if (!m_is_rope)
@@ -279,79 +324,78 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
     }
 
     if (preference == EncodingPreference::UTF16) {
-        // The caller wants a UTF-16 string, so we can simply concatenate all the pieces
-        // into a UTF-16 code unit buffer and create a Utf16String from it.
-
-        Utf16Data code_units;
-        for (auto const* current : pieces)
-            code_units.extend(current->utf16_string().string());
+        // The caller wants a UTF-16 string, so we can simply concatenate all the pieces into a UTF-16 code unit buffer.
+        // If the first piece is itself the result of such a concatenation, this usually just appends to its buffer.
+        auto prefix = pieces.first()->has_utf16_string() ? *pieces.first()->m_utf16_string : Utf16String::create();
+        auto suffix = pieces.span().slice(pieces.first()->has_utf16_string() ? 1 : 0);
+
+        size_t suffix_length = 0;
+        for (auto const* current : suffix) {
+            if (current->has_utf16_string())
+                suffix_length += current->m_utf16_string->length_in_code_units();
+            else
+                suffix_length += AK::utf16_code_unit_length_from_utf8(current->existing_utf8_string_view());
+        }
 
-        m_utf16_string = Utf16String::create(move(code_units));
+        m_utf16_string = Utf16String::create_by_appending(prefix, suffix_length, [&](Utf16Data& code_units) {
+            for (auto const* current : suffix) {
+                if (current->has_utf16_string()) {
+                    auto view = current->m_utf16_string->view();
+                    code_units.unchecked_append(view.data(), view.length_in_code_units());
+                    continue;
+                }
+                for (auto code_point : Utf8View { current->existing_utf8_string_view() })
+                    MUST(AK::code_point_to_utf16(code_units, code_point));
+            }
+        });
         m_is_rope = false;
         m_lhs = nullptr;
         m_rhs = nullptr;
         return;
     }
 
-    // Now that we have all the pieces, we can concatenate them using a StringBuilder.
-    StringBuilder builder;
-
-    // We keep track of the previous piece in order to handle surrogate pairs spread across two pieces.
-    PrimitiveString const* previous = nullptr;
+    // Size the buffer for the whole string up front, so that it doesn't need to grow while we're appending.
+    size_t length = 0;
     for (auto const* current : pieces) {
-        if (!previous) {
-            // This is the very first piece, just append it and continue.
-            builder.append(current->utf8_string());
-            previous = current;
-            continue;
-        }
-
-        // Get the UTF-8 representations for both strings.
-        auto current_string_as_utf8 = current->utf8_string_view();
-        auto previous_string_as_utf8 = previous->utf8_string_view();
-
-        // NOTE: Now we need to look at the end of the previous string and the start
-        //       of the current string, to see if they should be combined into a surrogate.
-
-        // Surrogates encoded as UTF-8 are 3 bytes.
-        if ((previous_string_as_utf8.length() < 3) || (current_string_as_utf8.length() < 3)) {
-            builder.append(current_string_as_utf8);
-            previous = current;
-            continue;
-        }
-
-        // Might the previous string end with a UTF-8 encoded surrogate?
-        if ((static_cast<u8>(previous_string_as_utf8[previous_string_as_utf8.length() - 3]) & 0xf0) != 0xe0) {
-            // If not, just append the current string and continue.
-            builder.append(current_string_as_utf8);
-            previous = current;
-            continue;
-        }
-
-        // Might the current string begin with a UTF-8 encoded surrogate?
-        if ((static_cast<u8>(current_string_as_utf8[0]) & 0xf0) != 0xe0) {
-            // If not, just append the current string and continue.
-            builder.append(current_string_as_utf8);
-            previous = current;
-            continue;
-        }
-
-        auto high_surrogate = *Utf8View(previous_string_as_utf8.substring_view(previous_string_as_utf8.length() - 3)).begin();
-        auto low_surrogate = *Utf8View(current_string_as_utf8).begin();
+        if (current->has_utf8_string() || current->has_byte_string())
+            length += current->existing_utf8_string_view().length();
+        else
+            length += utf8_length_of(current->m_utf16_string->view());
+    }
 
-        if (!Utf16View::is_high_surrogate(high_surrogate) || !Utf16View::is_low_surrogate(low_surrogate)) {
-            builder.append(current_string_as_utf8);
-            previous = current;
-            continue;
+    StringBuilder builder(length);
+    for (auto const* current : pieces) {
+        auto utf8_string = current->existing_utf8_string_view();
+        bool is_utf8 = current->has_utf8_string() || current->has_byte_string();
+
+        // NOTE: Now we need to look at the end of what we have so far and the start of the
+        //       current string, to see if they should be combined into a surrogate pair.
+        auto high_surrogate = builder.length() >= 3 ? utf8_encoded_surrogate_at(builder.string_view(), builder.length() - 3) : Optional<u16> {};
+        if (high_surrogate.has_value() && Utf16View::is_high_surrogate(*high_surrogate)) {
+            Optional<u16> low_surrogate;
+            if (is_utf8)
+                low_surrogate = utf8_encoded_surrogate_at(utf8_string, 0);
+            else if (!current->m_utf16_string->is_empty())
+                low_surrogate = current->m_utf16_string->code_unit_at(0);
+
+            if (low_surrogate.has_value() && Utf16View::is_low_surrogate(*low_surrogate)) {
+                // Remove 3 bytes from the builder and replace them with the UTF-8 encoded code point.
+                builder.trim(3);
+                builder.append_code_point(Utf16View::decode_surrogate_pair(*high_surrogate, *low_surrogate));
+
+                // Append the remaining part of the current string.
+                if (is_utf8)
+                    builder.append(utf8_string.substring_view(3));
+                else
+                    builder.append(current->m_utf16_string->substring_view(1));
+                continue;
+            }
         }
 
-        // Remove 3 bytes from the builder and replace them with the UTF-8 encoded code point.
-        builder.trim(3);
-        builder.append_code_point(Utf16View::decode_surrogate_pair(high_surrogate, low_surrogate));
-
-        // Append the remaining part of the current string.
-        builder.append(current_string_as_utf8.substring_view(3));
-        previous = current;
+        if (is_utf8)
+            builder.append(utf8_string);
+        else
+            builder.append(current->m_utf16_string->view());
     }
 
     // NOTE: We've already produced valid UTF-8 above, so there's no need for additional validation.
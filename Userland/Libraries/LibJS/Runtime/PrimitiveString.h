@@ -66,6 +66,7 @@ private:
         UTF16,
     };
     void resolve_rope_if_needed(EncodingPreference) const;
+    StringView existing_utf8_string_view() const;
 
     mutable bool m_is_rope { false };
 
@@ -211,6 +211,7 @@ void Promise::fulfill(Value value)
 
     // 3. Set promise.[[PromiseResult]] to value.
     m_result = value;
+    did_store_reference(m_result);
 
     // 4. Set promise.[[PromiseFulfillReactions]] to undefined.
     // 5. Set promise.[[PromiseRejectReactions]] to undefined.
@@ -242,6 +243,7 @@ void Promise::reject(Value reason)
 
     // 3. Set promise.[[PromiseResult]] to reason.
     m_result = reason;
+    did_store_reference(m_result);
 
     // 4. Set promise.[[PromiseFulfillReactions]] to undefined.
     // 5. Set promise.[[PromiseRejectReactions]] to undefined.
@@ -333,9 +335,11 @@ Value Promise::perform_then(Value on_fulfilled, Value on_rejected, GCPtr<Promise
 
         // a. Append fulfillReaction as the last element of the List that is promise.[[PromiseFulfillReactions]].
         m_fulfill_reactions.append(fulfill_reaction);
+        did_store_reference(fulfill_reaction);
 
         // b. Append rejectReaction as the last element of the List that is promise.[[PromiseRejectReactions]].
         m_reject_reactions.append(reject_reaction);
+        did_store_reference(reject_reaction);
         break;
     // 10. Else if promise.[[PromiseState]] is fulfilled, then
     case Promise::State::Fulfilled: {
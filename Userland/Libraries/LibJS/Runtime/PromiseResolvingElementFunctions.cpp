@@ -77,6 +77,7 @@ ThrowCompletionOr<Value> PromiseAllResolveElementFunction::resolve_element()
 
     // 8. Set values[index] to x.
     m_values->values()[m_index] = vm.argument(0);
+    m_values->did_store_reference(vm.argument(0));
 
     // 9. Set remainingElementsCount.[[Value]] to remainingElementsCount.[[Value]] - 1.
     // 10. If remainingElementsCount.[[Value]] is 0, then
@@ -118,6 +119,7 @@ ThrowCompletionOr<Value> PromiseAllSettledResolveElementFunction::resolve_elemen
 
     // 12. Set values[index] to obj.
     m_values->values()[m_index] = object;
+    m_values->did_store_reference(object);
 
     // 13. Set remainingElementsCount.[[Value]] to remainingElementsCount.[[Value]] - 1.
     // 14. If remainingElementsCount.[[Value]] is 0, then
@@ -159,6 +161,7 @@ ThrowCompletionOr<Value> PromiseAllSettledRejectElementFunction::resolve_element
 
     // 12. Set values[index] to obj.
     m_values->values()[m_index] = object;
+    m_values->did_store_reference(object);
 
     // 13. Set remainingElementsCount.[[Value]] to remainingElementsCount.[[Value]] - 1.
     // 14. If remainingElementsCount.[[Value]] is 0, then
@@ -191,6 +194,7 @@ ThrowCompletionOr<Value> PromiseAnyRejectElementFunction::resolve_element()
 
     // 8. Set errors[index] to x.
     m_values->values()[m_index] = vm.argument(0);
+    m_values->did_store_reference(vm.argument(0));
 
     // 9. Set remainingElementsCount.[[Value]] to remainingElementsCount.[[Value]] - 1.
     // 10. If remainingElementsCount.[[Value]] is 0, then
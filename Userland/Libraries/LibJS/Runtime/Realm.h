@@ -42,6 +42,7 @@ public:
     {
         VERIFY(!m_intrinsics);
         m_intrinsics = &intrinsics;
+        did_store_reference(m_intrinsics);
     }
 
     HostDefined* host_defined() { return m_host_defined; }
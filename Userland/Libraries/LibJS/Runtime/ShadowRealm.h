@@ -22,7 +22,11 @@ public:
 
     [[nodiscard]] Realm const& shadow_realm() const { return *m_shadow_realm; }
     [[nodiscard]] Realm& shadow_realm() { return *m_shadow_realm; }
-    void set_shadow_realm(NonnullGCPtr<Realm> realm) { m_shadow_realm = realm; }
+    void set_shadow_realm(NonnullGCPtr<Realm> realm)
+    {
+        m_shadow_realm = realm;
+        did_store_reference(m_shadow_realm);
+    }
 
 private:
     ShadowRealm(Object& prototype);
@@ -111,6 +111,8 @@ NonnullGCPtr<Shape> Shape::create_put_transition(StringOrSymbol const& property_
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
         m_forward_transitions->set(key, new_shape.ptr());
+        if (property_key.is_symbol())
+            did_store_reference(property_key.as_symbol());
     }
     return new_shape;
 }
@@ -126,6 +128,8 @@ NonnullGCPtr<Shape> Shape::create_configure_transition(StringOrSymbol const& pro
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
         m_forward_transitions->set(key, new_shape.ptr());
+        if (property_key.is_symbol())
+            did_store_reference(property_key.as_symbol());
     }
     return new_shape;
 }
@@ -279,6 +283,8 @@ NonnullGCPtr<Shape> Shape::create_delete_transition(StringOrSymbol const& proper
     if (!m_delete_transitions)
         m_delete_transitions = make<HashMap<StringOrSymbol, WeakPtr<Shape>>>();
     m_delete_transitions->set(property_key, new_shape.ptr());
+    if (property_key.is_symbol())
+        did_store_reference(property_key.as_symbol());
     return new_shape;
 }
 
@@ -290,6 +296,7 @@ void Shape::add_property_without_transition(StringOrSymbol const& property_key,
         VERIFY(m_property_count < NumericLimits<u32>::max());
         ++m_property_count;
     }
+    invalidate_prototype_if_needed_for_change_without_transition();
 }
 
 FLATTEN void Shape::add_property_without_transition(PropertyKey const& property_key, PropertyAttributes attributes)
@@ -306,6 +313,7 @@ void Shape::set_property_attributes_without_transition(StringOrSymbol const& pro
     VERIFY(it != m_property_table->end());
     it->value.attributes = attributes;
     m_property_table->set(property_key, it->value);
+    invalidate_prototype_if_needed_for_change_without_transition();
 }
 
 void Shape::remove_property_without_transition(StringOrSymbol const& property_key, u32 offset)
@@ -319,6 +327,7 @@ void Shape::remove_property_without_transition(StringOrSymbol const& property_ke
         if (it.value.offset > offset)
             --it.value.offset;
     }
+    invalidate_prototype_if_needed_for_change_without_transition();
 }
 
 NonnullGCPtr<Shape> Shape::create_for_prototype(NonnullGCPtr<Realm> realm, GCPtr<Object> prototype)
@@ -328,6 +337,7 @@ NonnullGCPtr<Shape> Shape::create_for_prototype(NonnullGCPtr<Realm> realm, GCPtr
     new_shape->m_is_prototype_shape = true;
     new_shape->m_prototype = prototype;
     new_shape->m_prototype_chain_validity = realm->heap().allocate_without_realm<PrototypeChainValidity>();
+    new_shape->did_store_reference(new_shape->m_prototype_chain_validity);
     return new_shape;
 }
 
@@ -344,6 +354,7 @@ NonnullGCPtr<Shape> Shape::clone_for_prototype()
     (*new_shape->m_property_table) = *m_property_table;
     new_shape->m_property_count = new_shape->m_property_table->size();
     new_shape->m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+    new_shape->did_store_reference(new_shape->m_prototype_chain_validity);
     return new_shape;
 }
 
@@ -352,6 +363,7 @@ void Shape::set_prototype_without_transition(Object* new_prototype)
     VERIFY(new_prototype);
     new_prototype->convert_to_prototype_if_needed();
     m_prototype = new_prototype;
+    did_store_reference(new_prototype);
 }
 
 void Shape::set_prototype_shape()
@@ -360,6 +372,7 @@ void Shape::set_prototype_shape()
     s_all_prototype_shapes.set(this);
     m_is_prototype_shape = true;
     m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+    did_store_reference(m_prototype_chain_validity);
 }
 
 void Shape::invalidate_prototype_if_needed_for_new_prototype(NonnullGCPtr<Shape> new_prototype_shape)
@@ -372,6 +385,18 @@ void Shape::invalidate_prototype_if_needed_for_new_prototype(NonnullGCPtr<Shape>
     invalidate_all_prototype_chains_leading_to_this();
 }
 
+// A prototype whose shape is a dictionary changes it in place, so there's no new shape to hand a fresh validity to.
+void Shape::invalidate_prototype_if_needed_for_change_without_transition()
+{
+    if (!m_is_prototype_shape)
+        return;
+    m_prototype_chain_validity->set_valid(false);
+    m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+    did_store_reference(m_prototype_chain_validity);
+
+    invalidate_all_prototype_chains_leading_to_this();
+}
+
 void Shape::invalidate_all_prototype_chains_leading_to_this()
 {
     HashTable<Shape*> shapes_to_invalidate;
@@ -391,6 +416,7 @@ void Shape::invalidate_all_prototype_chains_leading_to_this()
     for (auto* shape : shapes_to_invalidate) {
         shape->m_prototype_chain_validity->set_valid(false);
         shape->m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
+        shape->did_store_reference(shape->m_prototype_chain_validity);
     }
 }
 
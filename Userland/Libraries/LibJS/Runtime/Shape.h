@@ -113,6 +113,7 @@ private:
 
     void invalidate_prototype_if_needed_for_new_prototype(NonnullGCPtr<Shape> new_prototype_shape);
     void invalidate_all_prototype_chains_leading_to_this();
+    void invalidate_prototype_if_needed_for_change_without_transition();
 
     virtual void visit_edges(Visitor&) override;
 
@@ -47,7 +47,11 @@ public:
     void set_array_length(ByteLength length) { m_array_length = move(length); }
     void set_byte_length(ByteLength length) { m_byte_length = move(length); }
     void set_byte_offset(u32 offset) { m_byte_offset = offset; }
-    void set_viewed_array_buffer(ArrayBuffer* array_buffer) { m_viewed_array_buffer = array_buffer; }
+    void set_viewed_array_buffer(ArrayBuffer* array_buffer)
+    {
+        m_viewed_array_buffer = array_buffer;
+        did_store_reference(m_viewed_array_buffer);
+    }
 
     [[nodiscard]] Kind kind() const { return m_kind; }
 
@@ -45,21 +45,40 @@ NonnullRefPtr<Utf16StringImpl> Utf16StringImpl::create(Utf16View const& view)
     return create(move(string));
 }
 
-Utf16Data const& Utf16StringImpl::string() const
+NonnullRefPtr<Utf16StringImpl> Utf16StringImpl::create_sharing_buffer(NonnullRefPtr<Utf16StringImpl> buffer, size_t length)
 {
-    return m_string;
+    VERIFY(!buffer->m_buffer);
+    VERIFY(length <= buffer->m_string.size());
+    auto string = adopt_ref(*new Utf16StringImpl);
+    string->m_buffer = move(buffer);
+    string->m_length = length;
+    return string;
 }
 
 Utf16View Utf16StringImpl::view() const
 {
+    if (m_buffer)
+        return Utf16View { m_buffer->m_string.span().trim(m_length) };
     return Utf16View { m_string };
 }
 
+Utf16StringImpl* Utf16StringImpl::buffer_with_room_to_append(size_t length)
+{
+    if (!m_buffer)
+        return nullptr;
+    // NOTE: The buffer must never be reallocated, since shorter strings keep viewing its code units.
+    auto& code_units = m_buffer->m_string;
+    if (code_units.size() != m_length || code_units.capacity() - m_length < length)
+        return nullptr;
+    return m_buffer;
+}
+
 u32 Utf16StringImpl::compute_hash() const
 {
-    if (m_string.is_empty())
+    auto string = view();
+    if (string.is_empty())
         return 0;
-    return string_hash((char const*)m_string.data(), m_string.size() * sizeof(u16));
+    return string_hash((char const*)string.data(), string.length_in_code_units() * sizeof(u16));
 }
 
 }
@@ -89,11 +108,6 @@ Utf16String::Utf16String(NonnullRefPtr<Detail::Utf16StringImpl> string)
 {
 }
 
-Utf16Data const& Utf16String::string() const
-{
-    return m_string->string();
-}
-
 Utf16View Utf16String::view() const
 {
     return m_string->view();
@@ -9,6 +9,7 @@
 #include <AK/ByteString.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/Types.h>
 #include <AK/Utf16View.h>
 #include <AK/Vector.h>
@@ -25,10 +26,16 @@ public:
     [[nodiscard]] static NonnullRefPtr<Utf16StringImpl> create(Utf16Data);
     [[nodiscard]] static NonnullRefPtr<Utf16StringImpl> create(StringView);
     [[nodiscard]] static NonnullRefPtr<Utf16StringImpl> create(Utf16View const&);
+    [[nodiscard]] static NonnullRefPtr<Utf16StringImpl> create_sharing_buffer(NonnullRefPtr<Utf16StringImpl> buffer, size_t length);
 
-    Utf16Data const& string() const;
     Utf16View view() const;
 
+    // If we're the longest string using our buffer, and it has room for `length` more code units, returns the buffer so
+    // that a longer string can be made by appending to it.
+    Utf16StringImpl* buffer_with_room_to_append(size_t length);
+    Utf16Data& code_units() { return m_string; }
+    bool shares_buffer() const { return m_buffer; }
+
     [[nodiscard]] u32 hash() const
     {
         if (!m_has_hash) {
@@ -37,7 +44,7 @@ public:
         }
         return m_hash;
     }
-    [[nodiscard]] bool operator==(Utf16StringImpl const& other) const { return string() == other.string(); }
+    [[nodiscard]] bool operator==(Utf16StringImpl const& other) const { return view() == other.view(); }
 
 private:
     Utf16StringImpl() = default;
@@ -48,6 +55,10 @@ private:
     mutable bool m_has_hash { false };
     mutable u32 m_hash { 0 };
     Utf16Data m_string;
+
+    // Strings made by appending to a string share its buffer while they can, using the first `m_length` code units.
+    RefPtr<Utf16StringImpl> m_buffer;
+    size_t m_length { 0 };
 };
 
 }
@@ -59,7 +70,35 @@ public:
     [[nodiscard]] static Utf16String create(StringView);
     [[nodiscard]] static Utf16String create(Utf16View const&);
 
-    Utf16Data const& string() const;
+    // Creates the concatenation of `prefix` and `suffix_length` code units written by `append_suffix`. Strings made by
+    // appending to the result again reuse its buffer, which keeps building a string piece by piece linear.
+    template<typename Callback>
+    [[nodiscard]] static Utf16String create_by_appending(Utf16String const& prefix, size_t suffix_length, Callback append_suffix)
+    {
+        auto length = prefix.length_in_code_units() + suffix_length;
+        if (length < minimum_length_to_share_buffer) {
+            Utf16Data code_units;
+            code_units.ensure_capacity(length);
+            code_units.unchecked_append(prefix.view().data(), prefix.length_in_code_units());
+            append_suffix(code_units);
+            return create(move(code_units));
+        }
+
+        if (auto* buffer = prefix.m_string->buffer_with_room_to_append(suffix_length)) {
+            append_suffix(buffer->code_units());
+            VERIFY(buffer->code_units().size() == length);
+            return Utf16String { Detail::Utf16StringImpl::create_sharing_buffer(*buffer, length) };
+        }
+
+        // Only leave room to grow if the prefix was made by appending as well, so one-off concatenations waste nothing.
+        Utf16Data code_units;
+        code_units.ensure_capacity(prefix.m_string->shares_buffer() ? length * 2 : length);
+        code_units.unchecked_append(prefix.view().data(), prefix.length_in_code_units());
+        append_suffix(code_units);
+        VERIFY(code_units.size() == length);
+        return Utf16String { Detail::Utf16StringImpl::create_sharing_buffer(Detail::Utf16StringImpl::create(move(code_units)), length) };
+    }
+
     Utf16View view() const;
     Utf16View substring_view(size_t code_unit_offset, size_t code_unit_length) const;
     Utf16View substring_view(size_t code_unit_offset) const;
@@ -80,6 +119,8 @@ public:
     }
 
 private:
+    static constexpr size_t minimum_length_to_share_buffer = 64;
+
     explicit Utf16String(NonnullRefPtr<Detail::Utf16StringImpl>);
 
     NonnullRefPtr<Detail::Utf16StringImpl> m_string;
@@ -58,6 +58,8 @@ public:
 
     Bytecode::Interpreter& bytecode_interpreter();
 
+    ProgramCache& program_cache() { return *m_program_cache; }
+
     void dump_backtrace() const;
 
     void gather_roots(HashMap<Cell*, HeapRoot>&);
@@ -349,6 +351,8 @@ private:
 
     OwnPtr<Bytecode::Interpreter> m_bytecode_interpreter;
 
+    OwnPtr<ProgramCache> m_program_cache;
+
     bool m_dynamic_imports_allowed { false };
 };
 
@@ -7,6 +7,7 @@
 #include <LibJS/AST.h>
 #include <LibJS/Lexer.h>
 #include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Script.h>
 
@@ -17,16 +18,25 @@ JS_DEFINE_ALLOCATOR(Script);
 // 16.1.5 ParseScript ( sourceText, realm, hostDefined ), https://tc39.es/ecma262/#sec-parse-script
 Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView source_text, Realm& realm, StringView filename, HostDefined* host_defined, size_t line_number_offset)
 {
+    auto& program_cache = realm.vm().program_cache();
+
     // 1. Let script be ParseText(sourceText, Script).
-    auto parser = Parser(Lexer(source_text, filename, line_number_offset));
-    auto script = parser.parse_program();
+    // NOTE: If the same source text has been parsed recently, we reuse its AST, along with any bytecode generated for it.
+    RefPtr<Program> script = program_cache.get(source_text, filename, line_number_offset, Program::Type::Script);
+    if (!script) {
+        auto parser = Parser(Lexer(source_text, filename, line_number_offset));
+        auto parsed_script = parser.parse_program();
+
+        // 2. If script is a List of errors, return body.
+        if (parser.has_errors())
+            return parser.errors();
 
-    // 2. If script is a List of errors, return body.
-    if (parser.has_errors())
-        return parser.errors();
+        program_cache.set(source_text, filename, line_number_offset, parsed_script);
+        script = move(parsed_script);
+    }
 
     // 3. Return Script Record { [[Realm]]: realm, [[ECMAScriptCode]]: script, [[HostDefined]]: hostDefined }.
-    return realm.heap().allocate_without_realm<Script>(realm, filename, move(script), host_defined);
+    return realm.heap().allocate_without_realm<Script>(realm, filename, script.release_nonnull(), host_defined);
 }
 
 Script::Script(Realm& realm, StringView filename, NonnullRefPtr<Program> parse_node, HostDefined* host_defined)
@@ -0,0 +1,119 @@
+describe("transitions out of packed numeric storage", () => {
+    test("storing a double into int32 elements", () => {
+        const a = [1, 2, 3];
+        a[1] = 2.5;
+        expect(a).toEqual([1, 2.5, 3]);
+        a.push(-0);
+        expect(Object.is(a[3], -0)).toBeTrue();
+    });
+
+    test("storing a non-number", () => {
+        const a = [1.5, 2, 3];
+        a[0] = "foo";
+        a.push({});
+        expect(a[0]).toBe("foo");
+        expect(a).toHaveLength(4);
+        expect(typeof a[3]).toBe("object");
+    });
+
+    test("creating holes", () => {
+        const a = [1, 2, 3];
+        delete a[1];
+        expect(1 in a).toBeFalse();
+        expect(a).toHaveLength(3);
+
+        const b = [1, 2, 3];
+        b[5] = 6;
+        expect(b).toHaveLength(6);
+        expect(3 in b).toBeFalse();
+        expect(b[5]).toBe(6);
+
+        const c = [1, 2, 3];
+        c.length = 5;
+        expect(4 in c).toBeFalse();
+        c.length = 1;
+        expect(c).toEqual([1]);
+    });
+
+    test("changing attributes", () => {
+        const a = [1, 2, 3];
+        Object.freeze(a);
+        a[0] = 5;
+        expect(a[0]).toBe(1);
+        expect(() => a.push(4)).toThrow(TypeError);
+        expect(() => a.fill(0)).toThrow(TypeError);
+    });
+});
+
+describe("fast paths", () => {
+    test("fill", () => {
+        const a = [1, 2, 3, 4];
+        a.fill(7, 1, 3);
+        expect(a).toEqual([1, 7, 7, 4]);
+        a.fill(0.5);
+        expect(a).toEqual([0.5, 0.5, 0.5, 0.5]);
+    });
+
+    test("indexOf and includes", () => {
+        const a = [1, 2.5, NaN, -0, 3];
+        expect(a.indexOf(2.5)).toBe(1);
+        expect(a.indexOf(NaN)).toBe(-1);
+        expect(a.indexOf(0)).toBe(3);
+        expect(a.indexOf("1")).toBe(-1);
+        expect(a.indexOf(1, 1)).toBe(-1);
+        expect(a.includes(NaN)).toBeTrue();
+        expect(a.includes(0)).toBeTrue();
+        expect(a.includes("3")).toBeFalse();
+        expect(a.includes(1, -4)).toBeFalse();
+    });
+
+    test("push with indexed properties on the prototype", () => {
+        const setter = {
+            set 1(value) {
+                this.setterValue = value;
+            },
+        };
+        const a = [1];
+        Object.setPrototypeOf(a, setter);
+        Array.prototype.push.call(a, 2);
+        expect(a.setterValue).toBe(2);
+        expect(a).toHaveLength(2);
+        expect(Object.hasOwn(a, 1)).toBeFalse();
+    });
+
+    test("sort", () => {
+        const a = [10, 9, 1, -0, 0, 100, 2.5, -1];
+        a.sort();
+        expect(a).toEqual([-1, -0, 0, 1, 10, 100, 2.5, 9]);
+        expect(Object.is(a[1], -0)).toBeTrue();
+        expect(Object.is(a[2], 0)).toBeTrue();
+
+        a.sort((x, y) => x - y);
+        expect(a).toEqual([-1, -0, 0, 1, 2.5, 9, 10, 100]);
+        expect(Object.is(a[1], -0)).toBeTrue();
+    });
+
+    test("sort with a comparator that changes the array", () => {
+        const a = [3, 2, 1];
+        a.sort((x, y) => {
+            a[0] = "foo";
+            return x - y;
+        });
+        expect(a).toEqual([1, 2, 3]);
+    });
+
+    test("arguments that shrink the array", () => {
+        const shrinkingFromIndex = array => ({
+            valueOf() {
+                array.length = 1;
+                return 0;
+            },
+        });
+
+        const a = [1, 2, 3, 4];
+        expect(a.indexOf(undefined, shrinkingFromIndex(a))).toBe(-1);
+
+        const b = [1, 2, 3, 4];
+        expect(b.includes(undefined, shrinkingFromIndex(b))).toBeTrue();
+    });
+});
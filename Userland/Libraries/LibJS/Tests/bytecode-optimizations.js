@@ -0,0 +1,58 @@
+test("constant arithmetic and comparisons", () => {
+    const a = 1 + 2 * 3;
+    const b = a - 10;
+    expect(a).toBe(7);
+    expect(b).toBe(-3);
+    expect(-b).toBe(3);
+    expect(~a).toBe(-8);
+    expect(a / 0).toBe(Infinity);
+    expect(0 / 0).toBeNaN();
+    expect(1 / -0).toBe(-Infinity);
+    expect(null == undefined).toBeTrue();
+    expect(null === undefined).toBeFalse();
+    expect(true + 1).toBe(2);
+});
+
+test("branches on constant conditions", () => {
+    let result = "";
+    if (1 < 2) result += "a";
+    else result += "b";
+    if (null ?? false) result += "c";
+    if (undefined === undefined) result += "d";
+    while (false) result += "e";
+    expect(result).toBe("ad");
+});
+
+test("constants are not propagated across loop iterations", () => {
+    let x = 0;
+    let total = 0;
+    for (let i = 0; i < 5; ++i) {
+        total += x;
+        x = 2;
+    }
+    expect(total).toBe(8);
+});
+
+test("unused values still have their side effects", () => {
+    let calls = 0;
+    function f() {
+        ++calls;
+        return {};
+    }
+    f() + 1;
+    [f(), f()];
+    expect(calls).toBe(3);
+});
+
+test("jumps through empty blocks inside try/finally", () => {
+    const log = [];
+    for (let i = 0; i < 3; ++i) {
+        try {
+            if (i === 1) continue;
+            log.push(i);
+        } finally {
+            log.push("f");
+        }
+    }
+    expect(log).toEqual([0, "f", "f", 2, "f"]);
+});
@@ -0,0 +1,145 @@
+// Each of these stores a reference to a new cell into a cell that has already survived a collection.
+// A minor collection only finds the new cell through the write barrier, so if that's missing, the new
+// cell is swept and its memory is reused by the allocations that follow.
+
+function reuseFreedCells() {
+    const garbage = [];
+    for (let i = 0; i < 10_000; ++i) garbage.push({ marker: -1 });
+    return garbage;
+}
+
+function loadModule(filename) {
+    let module = null;
+    let thrownError = null;
+    import(filename)
+        .then(result => {
+            module = result;
+        })
+        .catch(error => {
+            thrownError = error;
+        });
+    runQueuedPromiseJobs();
+    if (thrownError) throw thrownError;
+    return module;
+}
+
+describe("old-to-young stores survive a minor collection", () => {
+    test("module import.meta", () => {
+        const module = loadModule("./modules/import-meta-getter.mjs");
+        collectYoungGeneration();
+
+        // The module record is old now, and import.meta is only created on first access.
+        (() => {
+            module.importMeta().marker = 42;
+        })();
+        collectYoungGeneration();
+        reuseFreedCells();
+
+        expect(module.importMeta().marker).toBe(42);
+    });
+
+    test("closure environment binding", () => {
+        function makeBox() {
+            let value = null;
+            return {
+                set(newValue) {
+                    value = newValue;
+                },
+                get() {
+                    return value;
+                },
+            };
+        }
+
+        const box = makeBox();
+        collectYoungGeneration();
+
+        (() => {
+            box.set({ marker: 42 });
+        })();
+        collectYoungGeneration();
+        reuseFreedCells();
+
+        expect(box.get().marker).toBe(42);
+    });
+
+    test("shape symbol key", () => {
+        const object = {};
+        collectYoungGeneration();
+
+        (() => {
+            object[Symbol("young")] = 42;
+        })();
+        collectYoungGeneration();
+        reuseFreedCells();
+
+        const symbols = Object.getOwnPropertySymbols(object);
+        expect(symbols).toHaveLength(1);
+        expect(symbols[0].description).toBe("young");
+        expect(object[symbols[0]]).toBe(42);
+    });
+
+    test("shape prototype", () => {
+        const object = {};
+        collectYoungGeneration();
+
+        (() => {
+            Object.setPrototypeOf(object, { marker: 42 });
+        })();
+        collectYoungGeneration();
+        reuseFreedCells();
+
+        expect(Object.getPrototypeOf(object).marker).toBe(42);
+    });
+
+    test("DisposableStack use", () => {
+        const stack = new DisposableStack();
+        const disposed = [];
+        collectYoungGeneration();
+
+        (() => {
+            stack.use({
+                marker: 42,
+                [Symbol.dispose]() {
+                    disposed.push(this.marker);
+                },
+            });
+        })();
+        collectYoungGeneration();
+        reuseFreedCells();
+
+        stack.dispose();
+        expect(disposed).toEqual([42]);
+    });
+
+    test("DisposableStack adopt", () => {
+        const stack = new DisposableStack();
+        const disposed = [];
+        collectYoungGeneration();
+
+        (() => {
+            stack.adopt({ marker: 42 }, value => disposed.push(value.marker));
+        })();
+        collectYoungGeneration();
+        reuseFreedCells();
+
+        stack.dispose();
+        expect(disposed).toEqual([42]);
+    });
+
+    test("DisposableStack defer", () => {
+        const stack = new DisposableStack();
+        const disposed = [];
+        collectYoungGeneration();
+
+        (() => {
+            const marker = { value: 42 };
+            stack.defer(() => disposed.push(marker.value));
+        })();
+        collectYoungGeneration();
+        reuseFreedCells();
+
+        stack.dispose();
+        expect(disposed).toEqual([42]);
+    });
+});
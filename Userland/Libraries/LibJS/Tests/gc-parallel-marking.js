@@ -0,0 +1,54 @@
+// Marking only spreads over several threads once the heap is large enough, so build plenty of long chains.
+const CHAIN_COUNT = 2_000;
+const CHAIN_LENGTH = 50;
+
+function buildChains(weakSet) {
+    const chains = [];
+    for (let i = 0; i < CHAIN_COUNT; ++i) {
+        let head = null;
+        for (let j = CHAIN_LENGTH - 1; j >= 0; --j) {
+            head = { chain: i, index: j, next: head };
+            weakSet.add(head);
+        }
+        chains.push(head);
+    }
+    return chains;
+}
+
+function expectChainsIntact(chains) {
+    for (const head of chains) {
+        let length = 0;
+        for (let node = head; node; node = node.next) {
+            expect(node.chain).toBe(head.chain);
+            expect(node.index).toBe(length++);
+        }
+        expect(length).toBe(CHAIN_LENGTH);
+    }
+}
+
+test("marking with several threads keeps the same cells alive as with one", () => {
+    const weakSet = new WeakSet();
+    const chains = buildChains(weakSet);
+
+    // Everything still in the weak set after this collection is reachable,
+    // so another collection has to keep exactly those cells, however many threads mark them.
+    gcWithMarkingThreads(1);
+    const liveAfterOneThread = getWeakSetSize(weakSet);
+    expect(liveAfterOneThread).toBeGreaterThanOrEqual(CHAIN_COUNT * CHAIN_LENGTH);
+
+    gcWithMarkingThreads(4);
+    expect(getWeakSetSize(weakSet)).toBe(liveAfterOneThread);
+    expectChainsIntact(chains);
+
+    // Then drop every other chain, and the threads have to agree on what's garbage too.
+    const keptChains = chains.filter((_, i) => i % 2 === 0);
+    chains.length = 0;
+
+    gcWithMarkingThreads(4);
+    const liveAfterFourThreads = getWeakSetSize(weakSet);
+    expect(liveAfterFourThreads).toBeLessThan(liveAfterOneThread);
+
+    gcWithMarkingThreads(1);
+    expect(getWeakSetSize(weakSet)).toBe(liveAfterFourThreads);
+    expectChainsIntact(keptChains);
+});
@@ -16,3 +16,180 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic property access sees every shape", () => {
+    function ic(o) {
+        return o.x;
+    }
+
+    const objects = [{ x: 1 }, { a: 0, x: 2 }, { b: 0, x: 3 }, { c: 0, x: 4 }, { d: 0, x: 5 }, Object.create({ x: 6 })];
+    for (let i = 0; i < 3; ++i) {
+        expect(objects.map(ic)).toEqual([1, 2, 3, 4, 5, 6]);
+    }
+});
+
+test("Property added to an intermediate prototype shadows the cached one", () => {
+    const grandparent = { x: 1 };
+    const parent = Object.create(grandparent);
+    const o = Object.create(parent);
+
+    function ic(o) {
+        return o.x;
+    }
+
+    expect(ic(o)).toBe(1);
+    expect(ic(o)).toBe(1);
+    parent.x = 2;
+    expect(ic(o)).toBe(2);
+});
+
+test("Property added to a dictionary prototype shadows the cached one", () => {
+    const grandparent = { x: 1 };
+    const parent = Object.create(grandparent);
+    for (let i = 0; i < 100; ++i) parent["prop" + i] = i;
+    const o = Object.create(parent);
+
+    function ic(o) {
+        return o.x;
+    }
+
+    expect(ic(o)).toBe(1);
+    expect(ic(o)).toBe(1);
+    parent.x = 2;
+    expect(ic(o)).toBe(2);
+});
+
+test("Cached property additions", () => {
+    function add(o, value) {
+        o.x = value;
+        return o;
+    }
+
+    for (let i = 0; i < 3; ++i) {
+        const o = add({ a: i }, i);
+        expect(o.x).toBe(i);
+        expect(Object.keys(o)).toEqual(["a", "x"]);
+        expect(Object.getOwnPropertyDescriptor(o, "x")).toEqual({ value: i, writable: true, enumerable: true, configurable: true });
+    }
+});
+
+test("Cached property addition does not skip a setter added to the prototype", () => {
+    const prototype = {};
+    function add(o) {
+        o.x = 1;
+    }
+
+    add(Object.create(prototype));
+    add(Object.create(prototype));
+
+    let setterValue;
+    Object.defineProperty(prototype, "x", {
+        set(value) {
+            setterValue = value;
+        },
+    });
+    const o = Object.create(prototype);
+    add(o);
+    expect(setterValue).toBe(1);
+    expect(Object.hasOwn(o, "x")).toBeFalse();
+});
+
+test("Cached property addition does not skip a setter that defines the property itself", () => {
+    let calls = 0;
+    const prototype = {
+        set x(value) {
+            ++calls;
+            Object.defineProperty(this, "x", { value, writable: true, enumerable: true, configurable: true });
+        },
+    };
+    function add(o) {
+        o.x = 1;
+    }
+
+    add(Object.create(prototype));
+    add(Object.create(prototype));
+    expect(calls).toBe(2);
+});
+
+test("Cached property addition does not skip a read-only property added to the prototype", () => {
+    const prototype = {};
+    function add(o) {
+        "use strict";
+        o.x = 1;
+    }
+
+    add(Object.create(prototype));
+    add(Object.create(prototype));
+
+    Object.defineProperty(prototype, "x", { value: 0, writable: false });
+    const o = Object.create(prototype);
+    expect(() => add(o)).toThrowWithMessage(TypeError, "Cannot set property 'x' of [object Object]");
+    expect(o.x).toBe(0);
+});
+
+test("Cached property addition to non-extensible objects", () => {
+    function add(o) {
+        o.x = 1;
+        return o;
+    }
+
+    add({});
+    add({});
+    expect(add(Object.preventExtensions({})).x).toBeUndefined();
+    expect(add(Object.freeze({})).x).toBeUndefined();
+    expect(add(Object.seal({})).x).toBeUndefined();
+});
+
+test("Cached property addition to proxies", () => {
+    function add(o) {
+        o.x = 1;
+        return o;
+    }
+
+    add({});
+    add({});
+    let trapped = false;
+    const proxy = new Proxy(
+        {},
+        {
+            set() {
+                trapped = true;
+                return true;
+            },
+        }
+    );
+    add(proxy);
+    expect(trapped).toBeTrue();
+    expect(Object.hasOwn(proxy, "x")).toBeFalse();
+});
+
+test("Cached property access on arrays", () => {
+    function set(o, value) {
+        o.length = value;
+        return o;
+    }
+
+    set({}, 1);
+    set({}, 1);
+    const array = [1, 2, 3];
+    set(array, 1);
+    expect(array).toEqual([1]);
+});
+
+test("Super property assignment does not store into the prototype", () => {
+    class A {}
+    A.prototype.x = 0;
+    class B extends A {
+        set(value) {
+            super.x = value;
+        }
+    }
+
+    const b1 = new B();
+    b1.set(1);
+    const b2 = new B();
+    b2.set(2);
+    expect(b1.x).toBe(1);
+    expect(b2.x).toBe(2);
+    expect(A.prototype.x).toBe(0);
+});
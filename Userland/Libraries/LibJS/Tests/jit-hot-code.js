@@ -0,0 +1,180 @@
+// These run often enough to be picked up by the baseline JIT, and check that the native code
+// behaves exactly like the interpreter on both its fast and slow paths.
+
+test("int32 arithmetic overflows into doubles", () => {
+    let sum = 0;
+    for (let i = 0; i < 1000; ++i) sum += 2147483;
+    expect(sum).toBe(2147483000);
+    for (let i = 0; i < 1000; ++i) sum += 2147483;
+    expect(sum).toBe(4294966000);
+
+    let difference = 0;
+    for (let i = 0; i < 1000; ++i) difference -= 4294967;
+    expect(difference).toBe(-4294967000);
+
+    let counter = 2147483547;
+    for (let i = 0; i < 200; ++i) counter++;
+    expect(counter).toBe(2147483747);
+    for (let i = 0; i < 200; ++i) counter--;
+    expect(counter).toBe(2147483547);
+});
+
+test("arithmetic on non-int32 values", () => {
+    function add(a, b) {
+        return a + b;
+    }
+    let results = [];
+    for (let i = 0; i < 200; ++i) results.push(add(i, 1));
+    expect(results[199]).toBe(200);
+    expect(add(0.5, 1)).toBe(1.5);
+    expect(add("foo", 1)).toBe("foo1");
+    expect(add(1n, 2n)).toBe(3n);
+    expect(add({ valueOf: () => 41 }, 1)).toBe(42);
+});
+
+test("bitwise operations", () => {
+    let and = -1;
+    let or = 0;
+    let xor = 0;
+    for (let i = -100; i < 100; ++i) {
+        and &= ~(i * i);
+        or |= i;
+        xor ^= i * 12345;
+    }
+    expect(and).toBe(-16382);
+    expect(or).toBe(-1);
+    expect(xor).toBe(1234464);
+    expect(((2 ** 32 + 5) & 3) | 0.5).toBe(1);
+});
+
+test("comparisons", () => {
+    function compare(a, b) {
+        return [a < b, a <= b, a > b, a >= b, a == b, a != b, a === b, a !== b];
+    }
+    for (let i = 0; i < 100; ++i) compare(i, 50);
+    expect(compare(-1, 1)).toEqual([true, true, false, false, false, true, false, true]);
+    expect(compare(1, 1)).toEqual([false, true, false, true, true, false, true, false]);
+    expect(compare(1, 1.5)).toEqual([true, true, false, false, false, true, false, true]);
+    expect(compare(1, "1")).toEqual([false, true, false, true, true, false, false, true]);
+    expect(compare(NaN, NaN)).toEqual([false, false, false, false, false, true, false, true]);
+    expect(compare("a", "b")).toEqual([true, true, false, false, false, true, false, true]);
+});
+
+test("conditional jumps on all kinds of values", () => {
+    function truthiness(value) {
+        if (value) return true;
+        return false;
+    }
+    for (let i = 0; i < 100; ++i) truthiness(i);
+    for (const value of [0, -0, NaN, "", null, undefined, false, 0n])
+        expect(truthiness(value)).toBeFalse();
+    for (const value of [1, -1, 0.5, "0", {}, [], true, 1n, Symbol()])
+        expect(truthiness(value)).toBeTrue();
+
+    function nullish(value) {
+        return value ?? "default";
+    }
+    for (let i = 0; i < 100; ++i) nullish(i);
+    expect(nullish(null)).toBe("default");
+    expect(nullish(undefined)).toBe("default");
+    expect(nullish(0)).toBe(0);
+    expect(nullish(false)).toBeFalse();
+});
+
+test("exceptions thrown from hot code", () => {
+    function maybeThrow(i) {
+        if (i % 10 === 9) throw new Error(`error ${i}`);
+        return i;
+    }
+    let caught = [];
+    let sum = 0;
+    for (let i = 0; i < 200; ++i) {
+        try {
+            sum += maybeThrow(i);
+        } catch (e) {
+            caught.push(e.message);
+        }
+    }
+    expect(caught).toHaveLength(20);
+    expect(caught[19]).toBe("error 199");
+    expect(sum).toBe(17820);
+
+    expect(() => {
+        for (let i = 0; i < 1000; ++i) {
+            if (i === 500) null.foo;
+        }
+    }).toThrow(TypeError);
+
+    const throwingValueOf = {
+        valueOf() {
+            throw new Error("valueOf");
+        },
+    };
+    expect(() => {
+        for (let i = 0; i < 1000; ++i) {
+            if (i === 500 && i < throwingValueOf) break;
+        }
+    }).toThrowWithMessage(Error, "valueOf");
+});
+
+test("finally blocks and control flow", () => {
+    let log = [];
+    for (let i = 0; i < 300; ++i) {
+        try {
+            if (i % 3 === 0) continue;
+            if (i === 299) break;
+        } finally {
+            if (i % 100 === 0 || i === 299) log.push(i);
+        }
+    }
+    expect(log).toEqual([0, 100, 200, 299]);
+
+    function returnFromFinally(i) {
+        try {
+            return i;
+        } finally {
+            if (i === 150) return "finally";
+        }
+    }
+    let results = [];
+    for (let i = 0; i < 200; ++i) results.push(returnFromFinally(i));
+    expect(results[149]).toBe(149);
+    expect(results[150]).toBe("finally");
+});
+
+test("arguments", () => {
+    function sloppy(a, b) {
+        arguments[0] = 10;
+        b = 20;
+        return [a, arguments[1]];
+    }
+    let result;
+    for (let i = 0; i < 100; ++i) result = sloppy(1, 2);
+    expect(result).toEqual([10, 20]);
+});
+
+test("generators resumed in native code", () => {
+    function* counter() {
+        for (let i = 0; i < 500; ++i) yield i;
+        return "done";
+    }
+    let sum = 0;
+    const iterator = counter();
+    for (let result = iterator.next(); !result.done; result = iterator.next()) sum += result.value;
+    expect(sum).toBe(124750);
+    expect(counter().return(42)).toEqual({ value: 42, done: true });
+});
+
+test("async functions resumed in native code", () => {
+    let sum = 0;
+    async function accumulate() {
+        for (let i = 0; i < 500; ++i) sum += await i;
+        return sum;
+    }
+    let result;
+    accumulate().then(value => {
+        result = value;
+    });
+    runQueuedPromiseJobs();
+    expect(result).toBe(124750);
+});
@@ -0,0 +1,3 @@
+export function importMeta() {
+    return import.meta;
+}
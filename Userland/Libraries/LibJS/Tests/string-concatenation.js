@@ -28,3 +28,63 @@ test("adding strings with dangling surrogates", () => {
     expect("\ud834a" + "\udf06").toBe("\ud834a\udf06");
     expect("\ud834" + "a\udf06").toBe("\ud834a\udf06");
 });
+
+test("reading a string while building it piece by piece", () => {
+    let s = "";
+    for (let i = 0; i < 1000; ++i) {
+        s += String.fromCharCode(0x61 + (i % 26));
+        expect(s.length).toBe(i + 1);
+        expect(s.charCodeAt(i)).toBe(0x61 + (i % 26));
+    }
+    expect(s.slice(0, 28)).toBe("abcdefghijklmnopqrstuvwxyzab");
+});
+
+test("appending different strings to the same string", () => {
+    let s = "x".repeat(100);
+    s += "y";
+    expect(s.length).toBe(101);
+
+    const a = s + "a";
+    const b = s + "b";
+    expect(a.length).toBe(102);
+    expect(b.length).toBe(102);
+    expect(a.at(-1)).toBe("a");
+    expect(b.at(-1)).toBe("b");
+    expect(s.at(-1)).toBe("y");
+    expect(a === b).toBeFalse();
+    expect(a.slice(0, -1) === b.slice(0, -1)).toBeTrue();
+});
+
+test("many unresolved concatenations", () => {
+    let s = "";
+    for (let i = 0; i < 100_000; ++i) s += "ab";
+    expect(s.length).toBe(200_000);
+    expect(s.endsWith("abab")).toBeTrue();
+});
+
+test("adding strings with and without non-ASCII characters", () => {
+    const pieces = ["abc", "Привет", String.fromCharCode(0x3b3), "😀", "こんにちは"];
+    let s = "";
+    for (const piece of pieces) s += piece;
+    expect(s.length).toBe(3 + 6 + 1 + 2 + 5);
+    expect(`${s}`).toBe("abcПривет" + "γ😀こんにちは");
+});
+
+test("adding strings with surrogates split across several pieces", () => {
+    const high = "\ud83d";
+    const low = "\ude00";
+
+    const utf16 = "a" + high + low;
+    expect(utf16.length).toBe(3);
+    expect(utf16.codePointAt(1)).toBe(0x1f600);
+
+    const key = "a" + high + (low + "b");
+    const object = { ["a😀b"]: 1 };
+    expect(object[key]).toBe(1);
+    expect(key).toBe("a😀b");
+
+    const lone = high + "b" + low;
+    expect(lone.length).toBe(3);
+    expect(lone.charCodeAt(0)).toBe(0xd83d);
+    expect(lone.charCodeAt(2)).toBe(0xde00);
+});
@@ -0,0 +1,918 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/HashTable.h>
+#include <AK/Utf32View.h>
+#include <LibRegex/RegexDFA.h>
+#include <LibUnicode/CharacterTypes.h>
+
+namespace regex {
+
+// U+2028 LINE SEPARATOR
+constexpr static u32 const LineSeparator { 0x2028 };
+// U+2029 PARAGRAPH SEPARATOR
+constexpr static u32 const ParagraphSeparator { 0x2029 };
+
+// Within a closure, a checkpoint is either set at the position the closure is for, or somewhere before it.
+enum CheckpointState : u32 {
+    Unset,
+    SetBefore,
+    SetHere,
+};
+
+// A backward scan holds a mask of the states a checkpoint could be in.
+constexpr static u32 const AnyCheckpointState { (1 << Unset) | (1 << SetBefore) | (1 << SetHere) };
+
+static bool is_word_character(u32 ch)
+{
+    return is_ascii_alphanumeric(ch) || ch == '_';
+}
+
+static bool is_line_terminator(u32 ch)
+{
+    return ch == '\r' || ch == '\n' || ch == LineSeparator || ch == ParagraphSeparator;
+}
+
+static bool considers_newlines(AllOptions options)
+{
+    return options.has_flag_set(AllFlags::Multiline) && options.has_flag_set(AllFlags::Internal_ConsiderNewline);
+}
+
+OwnPtr<LazyDFA> LazyDFA::try_create(ByteCode const& bytecode)
+{
+    auto dfa = adopt_own(*new LazyDFA);
+    dfa->m_bytecode_size = bytecode.size();
+
+    HashMap<size_t, u32> repetition_indices;
+    HashMap<size_t, u32> checkpoint_indices;
+    auto index_for = [](HashMap<size_t, u32>& indices, size_t id) {
+        if (auto index = indices.get(id); index.has_value())
+            return *index;
+        auto index = static_cast<u32>(indices.size());
+        indices.set(id, index);
+        return index;
+    };
+
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto instruction_position = state.instruction_position;
+
+        Instruction instruction;
+        instruction.next = instruction_position + opcode.size();
+
+        auto jump_target = [&]<typename T>() {
+            return instruction.next + static_cast<T const&>(opcode).offset();
+        };
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto const& compare = static_cast<OpCode_Compare const&>(opcode);
+            instruction.type = InstructionType::Compare;
+
+            // Only compares that look at exactly one character can be turned into transitions, with the exception
+            // of a lone string compare, which is handled one character at a time.
+            auto offset = instruction_position + 3;
+            for (size_t i = 0; i < compare.arguments_count(); ++i) {
+                switch ((CharacterCompareType)bytecode.at(offset++)) {
+                case CharacterCompareType::Inverse:
+                case CharacterCompareType::TemporaryInverse:
+                case CharacterCompareType::AnyChar:
+                case CharacterCompareType::And:
+                case CharacterCompareType::Or:
+                case CharacterCompareType::EndAndOr:
+                    break;
+                case CharacterCompareType::Char:
+                case CharacterCompareType::CharClass:
+                case CharacterCompareType::CharRange:
+                case CharacterCompareType::Property:
+                case CharacterCompareType::GeneralCategory:
+                case CharacterCompareType::Script:
+                case CharacterCompareType::ScriptExtension:
+                    ++offset;
+                    break;
+                case CharacterCompareType::LookupTable: {
+                    auto count = bytecode.at(offset++);
+                    offset += count;
+                    break;
+                }
+                case CharacterCompareType::String: {
+                    auto length = bytecode.at(offset++);
+                    if (length != 1) {
+                        if (length == 0 || compare.arguments_count() != 1)
+                            return nullptr;
+                        instruction.type = InstructionType::CompareString;
+                        instruction.string_offset = offset;
+                        instruction.count = length;
+                    }
+                    offset += length;
+                    break;
+                }
+                default:
+                    // Backreferences need to know what a capture group matched.
+                    return nullptr;
+                }
+            }
+            break;
+        }
+        case OpCodeId::Jump:
+            instruction.type = InstructionType::Jump;
+            instruction.target = jump_target.operator()<OpCode_Jump>();
+            break;
+        // The optimizer only turns forks into replacing forks where that doesn't change the result, so they're
+        // followed like the plain forks they stand in for.
+        case OpCodeId::ForkJump:
+            instruction.type = InstructionType::ForkJump;
+            instruction.target = jump_target.operator()<OpCode_ForkJump>();
+            break;
+        case OpCodeId::ForkReplaceJump:
+            instruction.type = InstructionType::ForkJump;
+            instruction.target = jump_target.operator()<OpCode_ForkReplaceJump>();
+            break;
+        case OpCodeId::ForkStay:
+            instruction.type = InstructionType::ForkStay;
+            instruction.target = jump_target.operator()<OpCode_ForkStay>();
+            break;
+        case OpCodeId::ForkReplaceStay:
+            instruction.type = InstructionType::ForkStay;
+            instruction.target = jump_target.operator()<OpCode_ForkReplaceStay>();
+            break;
+        case OpCodeId::Checkpoint:
+            instruction.type = InstructionType::Checkpoint;
+            instruction.register_index = index_for(checkpoint_indices, static_cast<OpCode_Checkpoint const&>(opcode).id());
+            break;
+        case OpCodeId::JumpNonEmpty: {
+            auto const& jump = static_cast<OpCode_JumpNonEmpty const&>(opcode);
+            instruction.type = InstructionType::JumpNonEmpty;
+            instruction.target = jump_target.operator()<OpCode_JumpNonEmpty>();
+            instruction.register_index = index_for(checkpoint_indices, jump.checkpoint());
+            switch (jump.form()) {
+            case OpCodeId::Jump:
+                instruction.form = InstructionType::Jump;
+                break;
+            case OpCodeId::ForkJump:
+            case OpCodeId::ForkReplaceJump:
+                instruction.form = InstructionType::ForkJump;
+                break;
+            case OpCodeId::ForkStay:
+            case OpCodeId::ForkReplaceStay:
+                instruction.form = InstructionType::ForkStay;
+                break;
+            default:
+                return nullptr;
+            }
+            break;
+        }
+        case OpCodeId::Repeat: {
+            auto const& repeat = static_cast<OpCode_Repeat const&>(opcode);
+            instruction.type = InstructionType::Repeat;
+            instruction.target = instruction_position - repeat.offset();
+            instruction.count = repeat.count();
+            instruction.register_index = index_for(repetition_indices, repeat.id());
+            break;
+        }
+        case OpCodeId::ResetRepeat:
+            instruction.type = InstructionType::ResetRepeat;
+            instruction.register_index = index_for(repetition_indices, static_cast<OpCode_ResetRepeat const&>(opcode).id());
+            break;
+        case OpCodeId::CheckBegin:
+            instruction.type = InstructionType::CheckBegin;
+            dfa->m_uses_line_begin = true;
+            break;
+        case OpCodeId::CheckEnd:
+            instruction.type = InstructionType::CheckEnd;
+            dfa->m_uses_line_end = true;
+            break;
+        case OpCodeId::CheckBoundary:
+            if (static_cast<OpCode_CheckBoundary const&>(opcode).type() == BoundaryCheckType::Word)
+                instruction.type = InstructionType::CheckWordBoundary;
+            else
+                instruction.type = InstructionType::CheckNotWordBoundary;
+            dfa->m_uses_word_boundary = true;
+            break;
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            instruction.type = InstructionType::Continue;
+            break;
+        case OpCodeId::Exit:
+            instruction.type = InstructionType::Fail;
+            break;
+        case OpCodeId::FailForks:
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+            // Lookarounds move back and forth in the input.
+            return nullptr;
+        }
+
+        dfa->m_instructions.set(instruction_position, instruction);
+        state.instruction_position = instruction.next;
+    }
+
+    // Everything the threads can jump to has to be an instruction we know about.
+    for (auto const& it : dfa->m_instructions) {
+        auto const& instruction = it.value;
+        if (instruction.next < dfa->m_bytecode_size && !dfa->m_instructions.contains(instruction.next))
+            return nullptr;
+        if (instruction.target < dfa->m_bytecode_size && !dfa->m_instructions.contains(instruction.target))
+            return nullptr;
+
+        auto add_predecessor = [&](size_t position) {
+            auto& predecessors = dfa->m_predecessors.ensure(dfa->instruction_position_after(position));
+            if (predecessors.is_empty() || predecessors.last() != it.key)
+                predecessors.append(it.key);
+        };
+        if (instruction.type != InstructionType::Jump && instruction.type != InstructionType::Fail)
+            add_predecessor(instruction.next);
+        switch (instruction.type) {
+        case InstructionType::Jump:
+        case InstructionType::ForkJump:
+        case InstructionType::ForkStay:
+        case InstructionType::JumpNonEmpty:
+        case InstructionType::Repeat:
+            add_predecessor(instruction.target);
+            break;
+        default:
+            break;
+        }
+    }
+
+    dfa->m_repetition_count = repetition_indices.size();
+    dfa->m_checkpoint_count = checkpoint_indices.size();
+    return dfa;
+}
+
+bool LazyDFA::supports_options(AllOptions options)
+{
+    return !options.has_flag_set(AllFlags::MatchNotBeginOfLine) && !options.has_flag_set(AllFlags::MatchNotEndOfLine);
+}
+
+LazyDFA::Result LazyDFA::match_at(ByteCode const& bytecode, MatchInput const& input, size_t string_position, size_t string_position_in_code_units)
+{
+    return run(bytecode, input, string_position, string_position_in_code_units, Mode::FirstMatch);
+}
+
+LazyDFA::Result LazyDFA::find_leftmost_match_end(ByteCode const& bytecode, MatchInput const& input, size_t string_position, size_t string_position_in_code_units)
+{
+    return run(bytecode, input, string_position, string_position_in_code_units, Mode::LeftmostMatch);
+}
+
+LazyDFA::Result LazyDFA::find_leftmost_match_start(ByteCode const& bytecode, MatchInput const& input, size_t match_end, size_t match_end_in_code_units, size_t earliest_start)
+{
+    reset_if_options_changed(input.regex_options);
+
+    auto const& view = input.view;
+    auto view_length = view.length();
+    auto bytes = view.is_string_view() ? view.string_view() : StringView {};
+    auto newlines = considers_newlines(input.regex_options);
+
+    // The scan starts out with a single thread that has just reached the end of the bytecode, with registers that
+    // could be anything.
+    Vector<u32> key;
+    u32 flags = Backward;
+    if (m_uses_line_end && (match_end >= view_length || (newlines && is_line_terminator(view.substring_view(match_end, 1)[0]))))
+        flags |= AtLineEnd;
+    if (m_uses_word_boundary && match_end < view_length && is_word_character(view[match_end_in_code_units]))
+        flags |= NextIsWord;
+    key.append(flags);
+    key.append(m_bytecode_size);
+    key.append(0);
+    for (u32 repetition = 0; repetition < m_repetition_count; ++repetition) {
+        key.append(0);
+        key.append(NumericLimits<u32>::max());
+    }
+    for (u32 checkpoint = 0; checkpoint < m_checkpoint_count; ++checkpoint)
+        key.append(AnyCheckpointState);
+    auto state_index = state_for(move(key));
+
+    auto string_position = match_end;
+    auto string_position_in_code_units = match_end_in_code_units;
+    Result result;
+    while (string_position > earliest_start) {
+        // Only inputs where every character is a single code unit are scanned backwards.
+        auto previous_position_in_code_units = string_position_in_code_units - 1;
+        u32 ch = view.is_string_view() ? bit_cast<u8>(bytes[previous_position_in_code_units]) : view.code_unit_at(previous_position_in_code_units);
+        Optional<u32> previous;
+        if (ch < m_states[state_index]->transitions.size()) {
+            previous = m_states[state_index]->transitions[ch];
+            if (*previous == unknown_transition)
+                previous = backward_transition(bytecode, input, state_index, string_position - 1, previous_position_in_code_units, true);
+        } else {
+            previous = backward_transition(bytecode, input, state_index, string_position - 1, previous_position_in_code_units, false);
+        }
+        if (!previous.has_value())
+            return { Outcome::GaveUp };
+
+        // The lowest bit says whether a match can start at the position the transition was made from.
+        if (*previous & 1)
+            result = { Outcome::Matched, string_position, string_position_in_code_units };
+
+        state_index = *previous >> 1;
+        --string_position;
+        string_position_in_code_units = previous_position_in_code_units;
+        if (m_states[state_index]->is_dead)
+            return result;
+    }
+
+    // Nothing before the earliest start is read, so whether a match can start there is checked directly.
+    auto const& state_key = m_states[state_index]->key;
+    Context context;
+    context.at_line_begin = string_position == 0 || (newlines && is_line_terminator(view.substring_view(string_position - 1, 1)[0]));
+    context.at_line_end = state_key[0] & AtLineEnd;
+    context.previous_is_word = m_uses_word_boundary && string_position > 0 && is_word_character(view[string_position_in_code_units - 1]);
+    context.next_is_word = state_key[0] & NextIsWord;
+
+    Vector<u32> threads;
+    bool can_start = false;
+    if (!follow_empty_transitions_backward(state_key, context, threads, can_start))
+        return { Outcome::GaveUp };
+    if (can_start)
+        result = { Outcome::Matched, string_position, string_position_in_code_units };
+    return result;
+}
+
+LazyDFA::Result LazyDFA::run(ByteCode const& bytecode, MatchInput const& input, size_t string_position, size_t string_position_in_code_units, Mode mode)
+{
+    reset_if_options_changed(input.regex_options);
+
+    auto const& view = input.view;
+    auto view_length = view.length();
+    auto bytes = view.is_string_view() ? view.string_view() : StringView {};
+
+    Vector<u32> key;
+    u32 flags = 0;
+    if (mode == Mode::LeftmostMatch)
+        flags |= Unanchored;
+    if (m_uses_line_begin && (string_position == 0 || (considers_newlines(input.regex_options) && is_line_terminator(view.substring_view(string_position - 1, 1)[0]))))
+        flags |= AtLineBegin;
+    if (m_uses_word_boundary && string_position > 0 && is_word_character(view[string_position_in_code_units - 1]))
+        flags |= PreviousIsWord;
+    key.append(flags);
+    if (mode == Mode::FirstMatch)
+        key.resize(1 + thread_width());
+    auto state_index = state_for(move(key));
+
+    Result result;
+    for (;;) {
+        if (string_position >= view_length) {
+            auto accepts = accepts_at_end(state_index);
+            if (!accepts.has_value())
+                return { Outcome::GaveUp };
+            if (*accepts)
+                result = { Outcome::Matched, string_position, string_position_in_code_units };
+            return result;
+        }
+
+        u32 ch = view.is_string_view() ? bit_cast<u8>(bytes[string_position_in_code_units]) : view.code_unit_at(string_position_in_code_units);
+        Optional<u32> next;
+        if (ch < m_states[state_index]->transitions.size()) {
+            next = m_states[state_index]->transitions[ch];
+            if (*next == unknown_transition)
+                next = transition(bytecode, input, state_index, string_position, string_position_in_code_units, true);
+        } else {
+            // Characters outside of ASCII may read differently depending on how a compare looks at the input
+            // (e.g. as a code unit or a code point), so their transitions are always worked out from scratch.
+            next = transition(bytecode, input, state_index, string_position, string_position_in_code_units, false);
+        }
+        if (!next.has_value())
+            return { Outcome::GaveUp };
+
+        if (*next & 1)
+            result = { Outcome::Matched, string_position, string_position_in_code_units };
+
+        state_index = *next >> 1;
+        if (m_states[state_index]->is_dead)
+            return result;
+
+        ++string_position;
+        if (ch < 0x80 || !view.unicode())
+            ++string_position_in_code_units;
+        else
+            string_position_in_code_units += view.length_of_code_point(view[string_position_in_code_units]);
+    }
+}
+
+void LazyDFA::reset_if_options_changed(AllOptions options)
+{
+    if (m_options.has_value() && m_options->value() == options.value())
+        return;
+    m_options = options;
+    m_states.clear();
+    m_state_indices.clear();
+    ++m_generation;
+}
+
+u32 LazyDFA::state_for(Vector<u32> key)
+{
+    if (auto index = m_state_indices.get(key); index.has_value())
+        return *index;
+
+    if (m_states.size() >= max_state_count) {
+        m_states.clear();
+        m_state_indices.clear();
+        ++m_generation;
+    }
+
+    auto state = make<State>();
+    state->key = key;
+    state->is_dead = key.size() == 1 && !(key[0] & Unanchored);
+    state->transitions.fill(unknown_transition);
+
+    auto index = static_cast<u32>(m_states.size());
+    m_states.append(move(state));
+    m_state_indices.set(move(key), index);
+    return index;
+}
+
+Optional<u32> LazyDFA::transition(ByteCode const& bytecode, MatchInput const& input, u32 state_index, size_t string_position, size_t string_position_in_code_units, bool cache)
+{
+    auto const& view = input.view;
+    auto newlines = considers_newlines(input.regex_options);
+    auto key = m_states[state_index]->key;
+
+    // These are read the same way the instructions that look at the surrounding characters read them.
+    auto next_is_line_terminator = newlines && is_line_terminator(view.substring_view(string_position, 1)[0]);
+    auto next_is_word = m_uses_word_boundary && is_word_character(view[string_position_in_code_units]);
+
+    Context context;
+    context.at_line_begin = key[0] & AtLineBegin;
+    context.at_line_end = next_is_line_terminator;
+    context.previous_is_word = key[0] & PreviousIsWord;
+    context.next_is_word = next_is_word;
+
+    Vector<u32> consuming_threads;
+    bool accepts = false;
+    if (!follow_empty_transitions(key, context, consuming_threads, accepts))
+        return {};
+
+    // Matches that start after the one that was just found can't be the leftmost one, so stop starting them.
+    u32 flags = accepts ? 0 : key[0] & Unanchored;
+    if (m_uses_line_begin && next_is_line_terminator)
+        flags |= AtLineBegin;
+    if (next_is_word)
+        flags |= PreviousIsWord;
+
+    Vector<u32> next_key;
+    next_key.append(flags);
+
+    auto width = thread_width();
+    HashTable<Vector<u32>, KeyTraits> next_threads;
+    Vector<u32> next_thread;
+    for (size_t i = 0; i < consuming_threads.size(); i += width) {
+        auto const* thread = consuming_threads.data() + i;
+        if (!thread_consumes(bytecode, input, thread, string_position, string_position_in_code_units))
+            continue;
+
+        next_thread.clear();
+        next_thread.append(thread, width);
+
+        auto const& instruction = m_instructions.get(thread[0]).value();
+        if (instruction.type == InstructionType::CompareString && thread[1] + 1 < instruction.count) {
+            ++next_thread[1];
+        } else {
+            next_thread[0] = instruction.next;
+            next_thread[1] = 0;
+        }
+        for (u32 checkpoint = 0; checkpoint < m_checkpoint_count; ++checkpoint) {
+            auto& checkpoint_state = next_thread[checkpoint_register(checkpoint)];
+            if (checkpoint_state == SetHere)
+                checkpoint_state = SetBefore;
+        }
+
+        if (next_threads.set(next_thread) == HashSetResult::InsertedNewEntry)
+            next_key.extend(next_thread);
+    }
+
+    auto generation = m_generation;
+    auto next_state_index = state_for(move(next_key));
+    auto result = (next_state_index << 1) | (accepts ? 1 : 0);
+
+    if (cache && generation == m_generation)
+        m_states[state_index]->transitions[view.code_unit_at(string_position_in_code_units)] = result;
+    return result;
+}
+
+Optional<bool> LazyDFA::accepts_at_end(u32 state_index)
+{
+    auto& state = *m_states[state_index];
+    if (!state.accepts_at_end.has_value()) {
+        Context context;
+        context.at_line_begin = state.key[0] & AtLineBegin;
+        context.at_line_end = true;
+        context.previous_is_word = state.key[0] & PreviousIsWord;
+        context.next_is_word = false;
+
+        Vector<u32> consuming_threads;
+        bool accepts = false;
+        if (!follow_empty_transitions(state.key, context, consuming_threads, accepts))
+            return {};
+        state.accepts_at_end = accepts;
+    }
+    return state.accepts_at_end;
+}
+
+// Follows every instruction that doesn't consume input, in the order the backtracker would, until the threads either
+// die, want to look at the next character, or reach the end of the bytecode. Threads that would only be tried after
+// one that matched can't change the outcome, so they're dropped.
+bool LazyDFA::follow_empty_transitions(Vector<u32> const& key, Context context, Vector<u32>& consuming_threads, bool& accepts) const
+{
+    auto width = thread_width();
+
+    // Threads are taken off the end of the stack, so the ones to try first are pushed last.
+    Vector<u32> stack;
+    if (key[0] & Unanchored) {
+        // A match can start at every position, but only after everything that started earlier.
+        stack.resize(width);
+    }
+    for (size_t i = key.size(); i > 1; i -= width)
+        stack.append(key.data() + i - width, width);
+
+    HashTable<Vector<u32>, KeyTraits> seen;
+    Vector<u32> thread;
+    thread.resize(width);
+
+    auto push = [&](size_t instruction_position) {
+        thread[0] = instruction_position;
+        stack.extend(thread);
+    };
+
+    while (!stack.is_empty()) {
+        for (size_t i = 0; i < width; ++i)
+            thread[i] = stack[stack.size() - width + i];
+        stack.shrink(stack.size() - width);
+
+        if (seen.set(thread) != HashSetResult::InsertedNewEntry)
+            continue;
+        if (seen.size() > max_thread_count)
+            return false;
+
+        if (thread[0] >= m_bytecode_size) {
+            accepts = true;
+            return true;
+        }
+
+        auto const& instruction = m_instructions.get(thread[0]).value();
+        switch (instruction.type) {
+        case InstructionType::Compare:
+        case InstructionType::CompareString:
+            consuming_threads.extend(thread);
+            break;
+        case InstructionType::Jump:
+            push(instruction.target);
+            break;
+        case InstructionType::ForkJump:
+            push(instruction.next);
+            push(instruction.target);
+            break;
+        case InstructionType::ForkStay:
+            push(instruction.target);
+            push(instruction.next);
+            break;
+        case InstructionType::Checkpoint:
+            thread[checkpoint_register(instruction.register_index)] = SetHere;
+            push(instruction.next);
+            break;
+        case InstructionType::JumpNonEmpty:
+            // Only loop again if the last iteration actually consumed something.
+            if (thread[checkpoint_register(instruction.register_index)] != SetBefore) {
+                push(instruction.next);
+            } else if (instruction.form == InstructionType::Jump) {
+                push(instruction.target);
+            } else if (instruction.form == InstructionType::ForkJump) {
+                push(instruction.next);
+                push(instruction.target);
+            } else {
+                push(instruction.target);
+                push(instruction.next);
+            }
+            break;
+        case InstructionType::Repeat: {
+            auto& repetition = thread[repetition_register(instruction.register_index)];
+            if (repetition == instruction.count - 1) {
+                repetition = 0;
+                push(instruction.next);
+            } else {
+                ++repetition;
+                push(instruction.target);
+            }
+            break;
+        }
+        case InstructionType::ResetRepeat:
+            thread[repetition_register(instruction.register_index)] = 0;
+            push(instruction.next);
+            break;
+        case InstructionType::CheckBegin:
+            if (context.at_line_begin)
+                push(instruction.next);
+            break;
+        case InstructionType::CheckEnd:
+            if (context.at_line_end)
+                push(instruction.next);
+            break;
+        case InstructionType::CheckWordBoundary:
+            if (context.previous_is_word != context.next_is_word)
+                push(instruction.next);
+            break;
+        case InstructionType::CheckNotWordBoundary:
+            if (context.previous_is_word == context.next_is_word)
+                push(instruction.next);
+            break;
+        case InstructionType::Continue:
+            push(instruction.next);
+            break;
+        case InstructionType::Fail:
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool LazyDFA::thread_consumes(ByteCode const& bytecode, MatchInput const& input, u32 const* thread, size_t string_position, size_t string_position_in_code_units) const
+{
+    auto const& instruction = m_instructions.get(thread[0]).value();
+    if (instruction.type == InstructionType::CompareString) {
+        // Compare a single character the way OpCode_Compare compares one.
+        u32 expected = bytecode.at(instruction.string_offset + thread[1]);
+        u32 ch = input.view.unicode()
+            ? input.view.substring_view(string_position, 1)[0]
+            : input.view.code_unit_at(string_position_in_code_units);
+
+        if (!(input.regex_options & AllFlags::Insensitive))
+            return ch == expected;
+        if (input.view.unicode())
+            return Unicode::equals_ignoring_case(Utf32View { &ch, 1 }, Utf32View { &expected, 1 });
+        return to_ascii_lowercase(ch) == to_ascii_lowercase(expected);
+    }
+
+    MatchState state;
+    state.instruction_position = thread[0];
+    state.string_position = string_position;
+    state.string_position_in_code_units = string_position_in_code_units;
+    auto& opcode = bytecode.get_opcode(state);
+    return opcode.execute(input, state) == ExecutionResult::Continue && state.string_position == string_position + 1;
+}
+
+
+// Works out the state of a backward scan before it read the character at the given position, which is the one
+// before the position the given state is for.
+Optional<u32> LazyDFA::backward_transition(ByteCode const& bytecode, MatchInput const& input, u32 state_index, size_t string_position, size_t string_position_in_code_units, bool cache)
+{
+    auto const& view = input.view;
+    auto newlines = considers_newlines(input.regex_options);
+    auto key = m_states[state_index]->key;
+
+    // These are read the same way transition() reads them going forward.
+    auto previous_is_line_terminator = newlines && is_line_terminator(view.substring_view(string_position, 1)[0]);
+    auto previous_is_word = m_uses_word_boundary && is_word_character(view[string_position_in_code_units]);
+
+    Context context;
+    context.at_line_begin = previous_is_line_terminator;
+    context.at_line_end = key[0] & AtLineEnd;
+    context.previous_is_word = previous_is_word;
+    context.next_is_word = key[0] & NextIsWord;
+
+    Vector<u32> threads;
+    bool can_start = false;
+    if (!follow_empty_transitions_backward(key, context, threads, can_start))
+        return {};
+
+    u32 flags = Backward;
+    if (m_uses_line_end && previous_is_line_terminator)
+        flags |= AtLineEnd;
+    if (previous_is_word)
+        flags |= NextIsWord;
+
+    Vector<u32> previous_key;
+    previous_key.append(flags);
+
+    auto width = backward_thread_width();
+    HashTable<Vector<u32>, KeyTraits> previous_threads;
+    Vector<u32> previous_thread;
+    auto add_previous_thread = [&](u32 const* thread, size_t instruction_position, u32 string_compare_offset) {
+        previous_thread.clear();
+        previous_thread.append(thread, width);
+        previous_thread[0] = instruction_position;
+        previous_thread[1] = string_compare_offset;
+
+        // Consuming a character turns a checkpoint that was set here into one that was set before, so one that was
+        // set before could have been set either way, and one that's unset stayed unset.
+        for (u32 checkpoint = 0; checkpoint < m_checkpoint_count; ++checkpoint) {
+            auto& mask = previous_thread[backward_checkpoint_register(checkpoint)];
+            u32 previous_mask = 0;
+            if (mask & (1 << Unset))
+                previous_mask |= 1 << Unset;
+            if (mask & (1 << SetBefore))
+                previous_mask |= (1 << SetBefore) | (1 << SetHere);
+            if (previous_mask == 0)
+                return;
+            mask = previous_mask;
+        }
+
+        if (!thread_consumes(bytecode, input, previous_thread.data(), string_position, string_position_in_code_units))
+            return;
+        if (previous_threads.set(previous_thread) == HashSetResult::InsertedNewEntry)
+            previous_key.extend(previous_thread);
+    };
+
+    for (size_t i = 0; i < threads.size(); i += width) {
+        auto const* thread = threads.data() + i;
+        if (thread[1] > 0) {
+            add_previous_thread(thread, thread[0], thread[1] - 1);
+            continue;
+        }
+
+        auto predecessors = m_predecessors.get(thread[0]);
+        if (!predecessors.has_value())
+            continue;
+        for (auto position : *predecessors) {
+            auto const& instruction = m_instructions.get(position).value();
+            if (instruction.type == InstructionType::Compare)
+                add_previous_thread(thread, position, 0);
+            else if (instruction.type == InstructionType::CompareString)
+                add_previous_thread(thread, position, instruction.count - 1);
+        }
+    }
+
+    auto generation = m_generation;
+    auto previous_state_index = state_for(move(previous_key));
+    auto result = (previous_state_index << 1) | (can_start ? 1 : 0);
+
+    if (cache && generation == m_generation)
+        m_states[state_index]->transitions[view.code_unit_at(string_position_in_code_units)] = result;
+    return result;
+}
+
+// Follows every instruction that doesn't consume input backwards, narrowing down what the registers could have been
+// before it, and collects every thread that could have led to the given ones. Unlike going forward, there's no order
+// to keep: all that's asked is whether a match can start at all.
+bool LazyDFA::follow_empty_transitions_backward(Vector<u32> const& key, Context context, Vector<u32>& threads, bool& can_start) const
+{
+    auto width = backward_thread_width();
+
+    Vector<u32> stack;
+    stack.append(key.data() + 1, key.size() - 1);
+
+    HashTable<Vector<u32>, KeyTraits> seen;
+    Vector<u32> thread;
+    thread.resize(width);
+    Vector<u32> previous;
+
+    while (!stack.is_empty()) {
+        for (size_t i = 0; i < width; ++i)
+            thread[i] = stack[stack.size() - width + i];
+        stack.shrink(stack.size() - width);
+
+        if (seen.set(thread) != HashSetResult::InsertedNewEntry)
+            continue;
+        if (seen.size() > max_thread_count)
+            return false;
+
+        threads.extend(thread);
+        if (can_start_match(thread.data()))
+            can_start = true;
+
+        // Only a string compare can lead into the middle of itself, and it does so by consuming a character.
+        if (thread[1] != 0)
+            continue;
+
+        auto predecessors = m_predecessors.get(thread[0]);
+        if (!predecessors.has_value())
+            continue;
+
+        for (auto position : *predecessors) {
+            auto const& instruction = m_instructions.get(position).value();
+            auto reaches = [&](size_t instruction_position) { return instruction_position_after(instruction_position) == thread[0]; };
+            auto start_previous = [&] {
+                previous = thread;
+                previous[0] = position;
+            };
+
+            switch (instruction.type) {
+            case InstructionType::Compare:
+            case InstructionType::CompareString:
+            case InstructionType::Fail:
+                break;
+            case InstructionType::Jump:
+            case InstructionType::ForkJump:
+            case InstructionType::ForkStay:
+            case InstructionType::Continue:
+                start_previous();
+                stack.extend(previous);
+                break;
+            case InstructionType::Checkpoint: {
+                start_previous();
+                auto& mask = previous[backward_checkpoint_register(instruction.register_index)];
+                if (mask & (1 << SetHere)) {
+                    mask = AnyCheckpointState;
+                    stack.extend(previous);
+                }
+                break;
+            }
+            case InstructionType::JumpNonEmpty: {
+                auto checkpoint = backward_checkpoint_register(instruction.register_index);
+                // Only a thread whose last iteration consumed something loops again, a plain jump leaves the loop otherwise.
+                if (reaches(instruction.next)) {
+                    start_previous();
+                    if (instruction.form == InstructionType::Jump)
+                        previous[checkpoint] &= ~(1u << SetBefore);
+                    if (previous[checkpoint] != 0)
+                        stack.extend(previous);
+                }
+                if (reaches(instruction.target)) {
+                    start_previous();
+                    previous[checkpoint] &= 1 << SetBefore;
+                    if (previous[checkpoint] != 0)
+                        stack.extend(previous);
+                }
+                break;
+            }
+            case InstructionType::Repeat: {
+                auto low = backward_repetition_register(instruction.register_index);
+                auto high = low + 1;
+                // Leaving the loop resets the counter, so it was at its last value before.
+                if (reaches(instruction.next) && thread[low] == 0 && instruction.count > 0 && instruction.count - 1 <= NumericLimits<u32>::max()) {
+                    start_previous();
+                    previous[low] = instruction.count - 1;
+                    previous[high] = instruction.count - 1;
+                    stack.extend(previous);
+                }
+                // Looping again counts up, but never to the last value.
+                if (reaches(instruction.target)) {
+                    auto previous_low = max(thread[low], 1u);
+                    auto previous_high = thread[high];
+                    if (instruction.count > 0 && instruction.count - 1 < previous_high)
+                        previous_high = instruction.count - 1;
+                    if (previous_low <= previous_high) {
+                        start_previous();
+                        previous[low] = previous_low - 1;
+                        previous[high] = previous_high == NumericLimits<u32>::max() ? previous_high : previous_high - 1;
+                        stack.extend(previous);
+                    }
+                }
+                break;
+            }
+            case InstructionType::ResetRepeat: {
+                auto low = backward_repetition_register(instruction.register_index);
+                if (thread[low] == 0) {
+                    start_previous();
+                    previous[low] = 0;
+                    previous[low + 1] = NumericLimits<u32>::max();
+                    stack.extend(previous);
+                }
+                break;
+            }
+            case InstructionType::CheckBegin:
+                if (context.at_line_begin) {
+                    start_previous();
+                    stack.extend(previous);
+                }
+                break;
+            case InstructionType::CheckEnd:
+                if (context.at_line_end) {
+                    start_previous();
+                    stack.extend(previous);
+                }
+                break;
+            case InstructionType::CheckWordBoundary:
+                if (context.previous_is_word != context.next_is_word) {
+                    start_previous();
+                    stack.extend(previous);
+                }
+                break;
+            case InstructionType::CheckNotWordBoundary:
+                if (context.previous_is_word == context.next_is_word) {
+                    start_previous();
+                    stack.extend(previous);
+                }
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Whether a thread of a backward scan could be the one a match starts with.
+bool LazyDFA::can_start_match(u32 const* thread) const
+{
+    if (thread[0] != 0 || thread[1] != 0)
+        return false;
+    for (u32 repetition = 0; repetition < m_repetition_count; ++repetition) {
+        if (thread[backward_repetition_register(repetition)] != 0)
+            return false;
+    }
+    for (u32 checkpoint = 0; checkpoint < m_checkpoint_count; ++checkpoint) {
+        if (!(thread[backward_checkpoint_register(checkpoint)] & (1 << Unset)))
+            return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+#include "RegexOptions.h"
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// Runs patterns that never need to backtrack (i.e. ones without backreferences or lookarounds) on a DFA
+// whose states are built from the bytecode as the input needs them, so a match attempt takes time linear
+// in the length of the input no matter how the pattern is written.
+//
+// A DFA state is the list of bytecode threads that are still alive, ordered the same way the backtracker
+// would try them, which lets the DFA report the same match the backtracker would find.
+//
+// Searching takes two passes over the input: one forward to find where the leftmost match ends, and one
+// backward from there to find where it starts. Each of them reads every character at most once.
+//
+// The DFA can't tell where the capture groups are though, so for those the matcher still runs the backtracker,
+// starting at the position the match was found at. That run is bound to succeed, but it isn't bounded the way
+// the DFA is: a pattern that nests quantifiers (e.g. /((a|aa)*)*b/) can still take exponential time in it.
+class LazyDFA {
+    AK_MAKE_NONCOPYABLE(LazyDFA);
+    AK_MAKE_NONMOVABLE(LazyDFA);
+
+public:
+    // Once this many states have been built, the cache is thrown away and rebuilt from scratch.
+    static constexpr size_t max_state_count = 1024;
+    // A state with more threads than this is too expensive to build, and the matcher falls back to the backtracker.
+    static constexpr size_t max_thread_count = 4096;
+
+    // Returns null if the bytecode does anything that can't be expressed with a DFA.
+    static OwnPtr<LazyDFA> try_create(ByteCode const&);
+    static bool supports_options(AllOptions);
+
+    enum class Outcome {
+        Matched,
+        NotMatched,
+        GaveUp,
+    };
+
+    struct Result {
+        Outcome outcome { Outcome::NotMatched };
+        size_t string_position { 0 };
+        size_t string_position_in_code_units { 0 };
+    };
+
+    // Finds the end of the match the backtracker would find when starting at the given position.
+    Result match_at(ByteCode const&, MatchInput const&, size_t string_position, size_t string_position_in_code_units);
+
+    // Finds the end of the leftmost match, i.e. the one the backtracker would find when trying every position from
+    // the given one onwards.
+    Result find_leftmost_match_end(ByteCode const&, MatchInput const&, size_t string_position, size_t string_position_in_code_units);
+
+    // Walks back from the end of the leftmost match to the earliest position (but not before the given one) that a
+    // match ending there can start at, which is where the leftmost match starts.
+    Result find_leftmost_match_start(ByteCode const&, MatchInput const&, size_t match_end, size_t match_end_in_code_units, size_t earliest_start);
+
+    size_t state_count() const { return m_states.size(); }
+
+private:
+    LazyDFA() = default;
+
+    enum class InstructionType : u8 {
+        Compare,
+        CompareString,
+        Jump,
+        ForkJump,
+        ForkStay,
+        Checkpoint,
+        JumpNonEmpty,
+        Repeat,
+        ResetRepeat,
+        CheckBegin,
+        CheckEnd,
+        CheckWordBoundary,
+        CheckNotWordBoundary,
+        Continue,
+        Fail,
+    };
+
+    struct Instruction {
+        InstructionType type { InstructionType::Fail };
+        size_t next { 0 };
+        size_t target { 0 };
+        InstructionType form { InstructionType::Jump };
+        u32 register_index { 0 };
+        u64 count { 0 };
+        size_t string_offset { 0 };
+    };
+
+    // What the instructions that don't consume anything need to know about the characters around a position.
+    struct Context {
+        bool at_line_begin { false };
+        bool at_line_end { false };
+        bool previous_is_word { false };
+        bool next_is_word { false };
+    };
+
+    enum StateFlags : u32 {
+        Unanchored = 1 << 0,
+        AtLineBegin = 1 << 1,
+        PreviousIsWord = 1 << 2,
+        // The state of a backward scan. What it knows about is the character after its position instead.
+        Backward = 1 << 3,
+        AtLineEnd = 1 << 4,
+        NextIsWord = 1 << 5,
+    };
+
+    static constexpr u32 unknown_transition = NumericLimits<u32>::max();
+
+    struct KeyTraits : public DefaultTraits<Vector<u32>> {
+        static unsigned hash(Vector<u32> const& key)
+        {
+            unsigned hash = 0;
+            for (auto value : key)
+                hash = pair_int_hash(hash, value);
+            return hash;
+        }
+    };
+
+    struct State {
+        // The state flags, followed by the threads in priority order. A thread is an instruction position
+        // followed by its registers: the offset into a string compare, the repetition counters and the checkpoints.
+        // A backward scan doesn't know the registers, so its threads hold what they could be instead: an inclusive
+        // range for each repetition counter, and a mask of CheckpointState bits for each checkpoint.
+        Vector<u32> key;
+        bool is_dead { false };
+        Optional<bool> accepts_at_end;
+        // The next state for each ASCII character, shifted left by one, with the low bit set if a match ends before it.
+        AK::Array<u32, 128> transitions;
+    };
+
+    enum class Mode {
+        FirstMatch,
+        LeftmostMatch,
+    };
+
+    Result run(ByteCode const&, MatchInput const&, size_t string_position, size_t string_position_in_code_units, Mode);
+
+    void reset_if_options_changed(AllOptions);
+    u32 state_for(Vector<u32> key);
+    Optional<u32> transition(ByteCode const&, MatchInput const&, u32 state_index, size_t string_position, size_t string_position_in_code_units, bool cache);
+    Optional<bool> accepts_at_end(u32 state_index);
+    bool follow_empty_transitions(Vector<u32> const& key, Context, Vector<u32>& consuming_threads, bool& accepts) const;
+    bool thread_consumes(ByteCode const&, MatchInput const&, u32 const* thread, size_t string_position, size_t string_position_in_code_units) const;
+
+    Optional<u32> backward_transition(ByteCode const&, MatchInput const&, u32 state_index, size_t string_position, size_t string_position_in_code_units, bool cache);
+    bool follow_empty_transitions_backward(Vector<u32> const& key, Context, Vector<u32>& threads, bool& can_start) const;
+    bool can_start_match(u32 const* thread) const;
+
+    size_t thread_width() const { return 2 + m_repetition_count + m_checkpoint_count; }
+    u32 repetition_register(u32 index) const { return 2 + index; }
+    u32 checkpoint_register(u32 index) const { return 2 + m_repetition_count + index; }
+
+    size_t backward_thread_width() const { return 2 + 2 * m_repetition_count + m_checkpoint_count; }
+    u32 backward_repetition_register(u32 index) const { return 2 + 2 * index; }
+    u32 backward_checkpoint_register(u32 index) const { return 2 + 2 * m_repetition_count + index; }
+
+    size_t instruction_position_after(size_t position) const { return min(position, m_bytecode_size); }
+
+    HashMap<size_t, Instruction> m_instructions;
+    // For every instruction position (and the end of the bytecode), the instructions that can continue there.
+    HashMap<size_t, Vector<size_t>> m_predecessors;
+    size_t m_bytecode_size { 0 };
+    u32 m_repetition_count { 0 };
+    u32 m_checkpoint_count { 0 };
+    bool m_uses_line_begin { false };
+    bool m_uses_line_end { false };
+    bool m_uses_word_boundary { false };
+
+    Optional<AllOptions> m_options;
+    Vector<NonnullOwnPtr<State>> m_states;
+    HashMap<Vector<u32>, u32, KeyTraits> m_state_indices;
+    // Bumped whenever the cache is thrown away, so transitions out of states that no longer exist aren't recorded.
+    u64 m_generation { 0 };
+};
+
+}
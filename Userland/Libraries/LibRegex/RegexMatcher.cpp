@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/BumpAllocator.h>
 #include <AK/ByteString.h>
+#include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/StringBuilder.h>
 #include <LibRegex/RegexMatcher.h>
@@ -60,6 +62,7 @@ Regex<Parser>::Regex(Regex&& regex)
     , parser_result(move(regex.parser_result))
     , matcher(move(regex.matcher))
     , start_offset(regex.start_offset)
+    , lazy_dfa(move(regex.lazy_dfa))
 {
     if (matcher)
         matcher->reset_pattern({}, this);
@@ -74,6 +77,7 @@ Regex<Parser>& Regex<Parser>::operator=(Regex&& regex)
     if (matcher)
         matcher->reset_pattern({}, this);
     start_offset = regex.start_offset;
+    lazy_dfa = move(regex.lazy_dfa);
     return *this;
 }
 
@@ -114,6 +118,62 @@ RegexResult Matcher<Parser>::match(RegexStringView view, Optional<typename Parse
     return match(views, regex_options);
 }
 
+// Finds the first occurrence of a string of ASCII characters that starts before the limit.
+static Optional<size_t> find_ascii_string(RegexStringView const& view, StringView string, size_t start, size_t limit)
+{
+    if (start >= limit)
+        return {};
+
+    if (view.is_string_view()) {
+        auto haystack = view.string_view();
+        haystack = haystack.substring_view(0, min(haystack.length(), limit - 1 + string.length()));
+        return haystack.find(string, start);
+    }
+
+    auto const& haystack = view.u16_view();
+    auto length = haystack.length_in_code_units();
+    for (size_t i = start; i < limit && i + string.length() <= length; ++i) {
+        size_t matched = 0;
+        while (matched < string.length() && haystack.code_unit_at(i + matched) == static_cast<u8>(string[matched]))
+            ++matched;
+        if (matched == string.length())
+            return i;
+    }
+    return {};
+}
+
+// Finds the first position before the limit that a match could start at, judging by what the optimizer found out about every match.
+static Optional<size_t> find_possible_match_start(RegexStringView const& view, regex::Parser::Result const& parser_result, size_t start, size_t limit)
+{
+    auto const& optimization_data = parser_result.optimization_data;
+    if (optimization_data.literal_prefix.has_value())
+        return find_ascii_string(view, *optimization_data.literal_prefix, start, limit);
+
+    if (!optimization_data.starting_characters.has_value())
+        return start;
+
+    auto const& starting_characters = *optimization_data.starting_characters;
+    auto can_start_with = [&](u32 ch) {
+        return ch < 0x80 ? starting_characters.ascii[ch] : starting_characters.non_ascii;
+    };
+
+    if (view.is_string_view()) {
+        auto haystack = view.string_view();
+        for (size_t i = start; i < min(limit, haystack.length()); ++i) {
+            if (can_start_with(static_cast<u8>(haystack[i])))
+                return i;
+        }
+        return {};
+    }
+
+    auto const& haystack = view.u16_view();
+    for (size_t i = start; i < min(limit, haystack.length_in_code_units()); ++i) {
+        if (can_start_with(haystack.code_unit_at(i)))
+            return i;
+    }
+    return {};
+}
+
 template<typename Parser>
 RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
 {
@@ -185,6 +245,23 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
 
+    auto& bytecode = m_pattern->parser_result.bytecode;
+    auto* lazy_dfa = m_pattern->lazy_dfa.ptr();
+    if (lazy_dfa && !LazyDFA::supports_options(input.regex_options))
+        lazy_dfa = nullptr;
+    // The DFA only knows where a match ends, so the backtracker still has to fill in the capture groups.
+    auto needs_capture_groups = m_pattern->parser_result.capture_groups_count > 0 && !input.regex_options.has_flag_set(AllFlags::SkipSubExprResults);
+
+    // The prefilters were worked out for the options the pattern was compiled with, and only for inputs where a position
+    // is the same as an index into the code units.
+    auto const& parser_result = m_pattern->parser_result;
+    auto has_prefilters = parser_result.optimization_data.literal_prefix.has_value()
+        || parser_result.optimization_data.required_substring.has_value()
+        || parser_result.optimization_data.starting_characters.has_value();
+    auto has_same_flag = [&](AllFlags flag) { return input.regex_options.has_flag_set(flag) == parser_result.options.has_flag_set(flag); };
+    if (!has_same_flag(AllFlags::Insensitive) || !has_same_flag(AllFlags::Unicode))
+        has_prefilters = false;
+
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -194,12 +271,27 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         input.view = view;
         dbgln_if(REGEX_DEBUG, "[match] Starting match with view ({}): _{}_", view.length(), view);
 
+        // The DFA reads the character at a position from the code units, so every character has to be a single one.
+        if (lazy_dfa && view.unicode()) {
+            auto has_only_single_code_unit_characters = view.is_string_view()
+                ? all_of(view.string_view(), [](char ch) { return is_ascii(ch); })
+                : view.length() == view.length_in_code_units();
+            if (!has_only_single_code_unit_characters)
+                lazy_dfa = nullptr;
+        }
+
         auto view_length = view.length();
         size_t view_index = m_pattern->start_offset;
         state.string_position = view_index;
         state.string_position_in_code_units = view_index;
         bool succeeded = false;
 
+        auto use_prefilters = has_prefilters && (view.is_string_view() || (view.is_u16_view() && !view.unicode()));
+        // Every match contains this string, so if it's not there, no position needs to be tried.
+        auto& required_substring = parser_result.optimization_data.required_substring;
+        auto is_missing_required_substring = use_prefilters && required_substring.has_value()
+            && !find_ascii_string(view, *required_substring, view_index, view.length_in_code_units()).has_value();
+
         if (view_index == view_length && m_pattern->parser_result.match_length_minimum == 0) {
             // Run the code until it tries to consume something.
             // This allows non-consuming code to run on empty strings, for instance
@@ -232,6 +324,18 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         }
 
         for (; view_index <= view_length; ++view_index) {
+            if (is_missing_required_substring)
+                break;
+
+            if (use_prefilters) {
+                // Without continue_search, only the current position is tried.
+                auto limit = continue_search ? view_length : view_index + 1;
+                auto possible_start = find_possible_match_start(view, parser_result, view_index, limit);
+                if (!possible_start.has_value())
+                    break;
+                view_index = *possible_start;
+            }
+
             if (view_index == view_length && input.regex_options.has_flag_set(AllFlags::Multiline))
                 break;
 
@@ -253,7 +357,61 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            auto success = execute(input, state, operations);
+            bool success;
+            if (lazy_dfa && continue_search) {
+                // Rather than trying every position, scan forward for where the leftmost match ends, then back from there
+                // for where it starts, which reads each character a bounded number of times.
+                auto match_end = lazy_dfa->find_leftmost_match_end(bytecode, input, state.string_position, state.string_position_in_code_units);
+                if (match_end.outcome == LazyDFA::Outcome::NotMatched)
+                    break;
+                LazyDFA::Result match_start { LazyDFA::Outcome::GaveUp };
+                if (match_end.outcome == LazyDFA::Outcome::Matched)
+                    match_start = lazy_dfa->find_leftmost_match_start(bytecode, input, match_end.string_position, match_end.string_position_in_code_units, state.string_position);
+
+                if (match_start.outcome == LazyDFA::Outcome::Matched) {
+                    view_index = match_start.string_position;
+                    // Like above, a match at the very end doesn't count when matching line by line.
+                    if (view_index == view_length && input.regex_options.has_flag_set(AllFlags::Multiline))
+                        break;
+                    state.string_position = view_index;
+                    state.string_position_in_code_units = view_index;
+                    if (needs_capture_groups) {
+                        // The backtracker is bound to find the same match from here, but that can still take exponential time.
+                        success = execute(input, state, operations);
+                    } else {
+                        state.string_position = match_end.string_position;
+                        state.string_position_in_code_units = match_end.string_position_in_code_units;
+                        success = true;
+                    }
+                } else {
+                    // Finding the end of a match means it has a start, so the DFA gave up if it didn't find one.
+                    lazy_dfa = nullptr;
+                    success = execute(input, state, operations);
+                }
+            } else if (lazy_dfa) {
+                auto match = lazy_dfa->match_at(bytecode, input, state.string_position, state.string_position_in_code_units);
+                switch (match.outcome) {
+                case LazyDFA::Outcome::Matched:
+                    if (needs_capture_groups) {
+                        success = execute(input, state, operations);
+                    } else {
+                        state.string_position = match.string_position;
+                        state.string_position_in_code_units = match.string_position_in_code_units;
+                        success = true;
+                    }
+                    break;
+                case LazyDFA::Outcome::NotMatched:
+                    success = false;
+                    break;
+                case LazyDFA::Outcome::GaveUp:
+                    lazy_dfa = nullptr;
+                    success = execute(input, state, operations);
+                    break;
+                }
+            } else {
+                success = execute(input, state, operations);
+            }
+
             if (success) {
                 succeeded = true;
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexDFA.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
@@ -80,6 +81,9 @@ private:
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
 };
 
+// NOTE: Matching updates state kept on the Regex (the start offset, and the lazy DFA's states), even through const
+//       member functions. So a Regex, including a static const one, must not be matched from several threads at once.
+//       Threads that need the same pattern should each construct a Regex of their own.
 template<class Parser>
 class Regex final {
 public:
@@ -87,6 +91,9 @@ public:
     regex::Parser::Result parser_result;
     OwnPtr<Matcher<Parser>> matcher { nullptr };
     mutable size_t start_offset { 0 };
+    // Set if the pattern never needs to backtrack. Its states are built while matching, hence mutable.
+    // Finding a match never backtracks, but capture groups still need the backtracker, which can take exponential time.
+    mutable OwnPtr<LazyDFA> lazy_dfa { nullptr };
 
     static regex::Parser::Result parse_pattern(StringView pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
 
@@ -238,6 +245,7 @@ private:
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
+    void attempt_to_find_search_prefilters();
 };
 
 // free standing functions for match, search and has_match
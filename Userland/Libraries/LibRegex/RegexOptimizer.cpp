@@ -29,14 +29,21 @@ void Regex<Parser>::run_optimization_passes()
     parser_result.bytecode.flatten();
 
     auto blocks = split_basic_blocks(parser_result.bytecode);
-    if (attempt_rewrite_entire_match_as_substring_search(blocks))
+    if (attempt_rewrite_entire_match_as_substring_search(blocks)) {
+        attempt_to_find_search_prefilters();
         return;
+    }
 
     // Rewrite fork loops as atomic groups
     // e.g. a*b -> (ATOMIC a*)b
     attempt_rewrite_loops_as_atomic_groups(blocks);
 
     parser_result.bytecode.flatten();
+
+    if (parser_result.error == Error::NoError)
+        lazy_dfa = LazyDFA::try_create(parser_result.bytecode);
+
+    attempt_to_find_search_prefilters();
 }
 
 template<typename Parser>
@@ -651,6 +658,312 @@ bool Regex<Parser>::attempt_rewrite_entire_match_as_substring_search(BasicBlockL
     return true;
 }
 
+template<typename Parser>
+void Regex<Parser>::attempt_to_find_search_prefilters()
+{
+    if (parser_result.error != Error::NoError)
+        return;
+
+    auto& bytecode = parser_result.bytecode;
+    auto& optimization_data = parser_result.optimization_data;
+    auto insensitive = parser_result.options.has_flag_set(AllFlags::Insensitive);
+
+    struct Instruction {
+        OpCodeId id;
+        size_t next { 0 };
+        Vector<size_t, 2> successors;
+        // For compares of a single character or string, the ASCII characters it starts with, and whether that's all it matches.
+        ByteString literal;
+        bool matches_only_literal { false };
+        // Set for compares that may match more or less than a single character, e.g. a string or a backreference.
+        bool matches_other_than_one_character { false };
+    };
+    HashMap<size_t, Instruction> instructions;
+    Vector<size_t> literal_compares;
+    HashTable<size_t> jump_targets;
+
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto position = state.instruction_position;
+        Instruction instruction { opcode.opcode_id(), position + opcode.size(), {}, {}, false };
+
+        auto add_jump = [&](size_t target) {
+            instruction.successors.append(target);
+            jump_targets.set(target);
+        };
+        auto add_fork = [&]<typename T>() {
+            instruction.successors.append(instruction.next);
+            add_jump(instruction.next + static_cast<T const&>(opcode).offset());
+        };
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            instruction.successors.append(instruction.next);
+
+            auto offset = position + 3;
+            for (size_t i = 0; i < compare.arguments_count(); ++i) {
+                switch (static_cast<CharacterCompareType>(bytecode.at(offset++))) {
+                case CharacterCompareType::Char:
+                case CharacterCompareType::CharClass:
+                case CharacterCompareType::CharRange:
+                case CharacterCompareType::Property:
+                case CharacterCompareType::GeneralCategory:
+                case CharacterCompareType::Script:
+                case CharacterCompareType::ScriptExtension:
+                    ++offset;
+                    break;
+                case CharacterCompareType::Reference:
+                    instruction.matches_other_than_one_character = true;
+                    ++offset;
+                    break;
+                case CharacterCompareType::String: {
+                    auto length = bytecode.at(offset++);
+                    if (length != 1)
+                        instruction.matches_other_than_one_character = true;
+                    offset += length;
+                    break;
+                }
+                case CharacterCompareType::LookupTable:
+                    offset += bytecode.at(offset) + 1;
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            if (compare.arguments_count() != 1)
+                break;
+            auto type = static_cast<CharacterCompareType>(bytecode.at(position + 3));
+            if (type != CharacterCompareType::Char && type != CharacterCompareType::String)
+                break;
+            StringBuilder builder;
+            auto characters = compare.flat_compares();
+            for (auto& character : characters) {
+                if (character.value > 0x7f)
+                    break;
+                builder.append(static_cast<char>(character.value));
+            }
+            instruction.literal = builder.to_byte_string();
+            instruction.matches_only_literal = !characters.is_empty() && instruction.literal.length() == characters.size();
+            if (!instruction.literal.is_empty())
+                literal_compares.append(position);
+            break;
+        }
+        case OpCodeId::Jump:
+            add_jump(instruction.next + static_cast<OpCode_Jump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkJump:
+            add_fork.template operator()<OpCode_ForkJump>();
+            break;
+        case OpCodeId::ForkReplaceJump:
+            add_fork.template operator()<OpCode_ForkReplaceJump>();
+            break;
+        case OpCodeId::ForkStay:
+            add_fork.template operator()<OpCode_ForkStay>();
+            break;
+        case OpCodeId::ForkReplaceStay:
+            add_fork.template operator()<OpCode_ForkReplaceStay>();
+            break;
+        case OpCodeId::JumpNonEmpty:
+            add_fork.template operator()<OpCode_JumpNonEmpty>();
+            break;
+        case OpCodeId::Repeat:
+            instruction.successors.append(instruction.next);
+            add_jump(position - static_cast<OpCode_Repeat const&>(opcode).offset());
+            break;
+        case OpCodeId::Exit:
+            break;
+        case OpCodeId::FailForks:
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+            // Lookarounds look at characters outside of the match, and may require characters to *not* be there.
+            return;
+        default:
+            instruction.successors.append(instruction.next);
+            break;
+        }
+
+        state.instruction_position = instruction.next;
+        instructions.set(position, move(instruction));
+    }
+
+    auto instruction_at = [&](size_t position) -> Instruction const* {
+        auto it = instructions.find(position);
+        return it == instructions.end() ? nullptr : &it->value;
+    };
+
+    // Every match starts with the strings matched by the compares that are reached from the start without any choices.
+    if (!insensitive) {
+        StringBuilder prefix;
+        auto const* instruction = instruction_at(0);
+        for (size_t steps = 0; instruction && steps < instructions.size(); ++steps) {
+            if (instruction->id == OpCodeId::Compare) {
+                prefix.append(instruction->literal);
+                if (!instruction->matches_only_literal)
+                    break;
+            }
+            if (instruction->successors.size() != 1)
+                break;
+            instruction = instruction_at(instruction->successors.first());
+        }
+        if (!prefix.is_empty())
+            optimization_data.literal_prefix = prefix.to_byte_string();
+    }
+
+    // If there's no such prefix, the first character of every match is still matched by one of the compares reached
+    // from the start before anything is consumed.
+    if (!optimization_data.literal_prefix.has_value()) {
+        regex::Parser::Result::StartingCharacters starting_characters;
+        HashTable<size_t> visited;
+        Vector<size_t> to_visit { 0 };
+        auto gave_up = false;
+
+        MatchInput input;
+        input.regex_options = parser_result.options;
+
+        while (!to_visit.is_empty() && !gave_up) {
+            auto position = to_visit.take_last();
+            if (visited.set(position) != HashSetResult::InsertedNewEntry)
+                continue;
+            auto const* instruction = instruction_at(position);
+            if (!instruction) {
+                // The end can be reached without consuming anything, so a match can start anywhere.
+                gave_up = true;
+                break;
+            }
+            if (instruction->id != OpCodeId::Compare) {
+                to_visit.extend(instruction->successors.span());
+                continue;
+            }
+
+            if (instruction->matches_other_than_one_character) {
+                // A string can't be checked against a single character, so only its first one is looked at.
+                if (instruction->literal.is_empty()) {
+                    gave_up = true;
+                    break;
+                }
+                auto first = instruction->literal[0];
+                starting_characters.ascii[first] = true;
+                if (insensitive) {
+                    starting_characters.ascii[to_ascii_lowercase(first)] = true;
+                    starting_characters.ascii[to_ascii_uppercase(first)] = true;
+                    starting_characters.non_ascii = true;
+                }
+                continue;
+            }
+
+            MatchState compare_state;
+            compare_state.instruction_position = position;
+            auto& compare = static_cast<OpCode_Compare const&>(bytecode.get_opcode(compare_state));
+            auto characters = compare.flat_compares();
+
+            for (u8 ch = 0; ch < 0x80; ++ch) {
+                char string[] = { static_cast<char>(ch) };
+                input.view = StringView { string, 1 };
+                compare_state.string_position = 0;
+                compare_state.string_position_in_code_units = 0;
+                if (compare.execute(input, compare_state) == ExecutionResult::Continue && compare_state.string_position == 1)
+                    starting_characters.ascii[ch] = true;
+            }
+
+            // Only compares of plain ASCII characters are sure to never match anything outside of ASCII.
+            auto only_ascii = !insensitive && all_of(characters, [](auto const& character) {
+                switch (character.type) {
+                case CharacterCompareType::Char:
+                    return character.value <= 0x7f;
+                case CharacterCompareType::CharRange:
+                    return CharRange { character.value }.to <= 0x7f;
+                default:
+                    return false;
+                }
+            });
+            if (!only_ascii)
+                starting_characters.non_ascii = true;
+        }
+
+        size_t count = 0;
+        char last_character = 0;
+        for (size_t ch = 0; ch < starting_characters.ascii.size(); ++ch) {
+            if (starting_characters.ascii[ch]) {
+                ++count;
+                last_character = static_cast<char>(ch);
+            }
+        }
+
+        if (gave_up || (starting_characters.non_ascii && count == starting_characters.ascii.size())) {
+            // Every position is a possible start.
+        } else if (!starting_characters.non_ascii && count == 1) {
+            // A single character can be searched for like any other string.
+            optimization_data.literal_prefix = ByteString::repeated(last_character, 1);
+        } else {
+            optimization_data.starting_characters = starting_characters;
+        }
+    }
+
+    // Finally, look for the longest string of compares that every way through the bytecode has to go through.
+    // A compare is required if the end can't be reached without it, which takes a walk through the bytecode per
+    // compare, so only a limited number of them are looked at.
+    if (insensitive)
+        return;
+
+    static constexpr size_t max_required_compares_to_check = 32;
+    Vector<bool> reachable;
+    auto is_required = [&](size_t required_position) {
+        reachable.clear_with_capacity();
+        reachable.resize(bytecode.size());
+        Vector<size_t> to_visit { 0 };
+        while (!to_visit.is_empty()) {
+            auto position = to_visit.take_last();
+            if (position >= bytecode.size())
+                return false;
+            if (position == required_position || reachable[position])
+                continue;
+            reachable[position] = true;
+            if (auto const* instruction = instruction_at(position))
+                to_visit.extend(instruction->successors.span());
+        }
+        return true;
+    };
+
+    auto const& prefix = optimization_data.literal_prefix;
+    ByteString longest_required_string;
+    size_t compares_checked = 0;
+    for (auto position : literal_compares) {
+        if (++compares_checked > max_required_compares_to_check)
+            break;
+        if (!is_required(position))
+            continue;
+
+        // The instructions that can only be reached by falling through from a required one are required too, and run
+        // right after it, so their strings follow on directly from its string.
+        StringBuilder builder;
+        auto const* instruction = instruction_at(position);
+        builder.append(instruction->literal);
+        while (instruction->matches_only_literal || instruction->id != OpCodeId::Compare) {
+            if (instruction->successors.size() != 1 || instruction->successors.first() != instruction->next || jump_targets.contains(instruction->next))
+                break;
+            instruction = instruction_at(instruction->next);
+            if (!instruction)
+                break;
+            if (instruction->id == OpCodeId::Compare) {
+                if (instruction->literal.is_empty())
+                    break;
+                builder.append(instruction->literal);
+            }
+        }
+
+        if (builder.length() > longest_required_string.length())
+            longest_required_string = builder.to_byte_string();
+    }
+
+    // A search for the prefix already finds out whether there can be a match at all.
+    if (longest_required_string.length() > (prefix.has_value() ? prefix->length() : 0))
+        optimization_data.required_substring = move(longest_required_string);
+}
+
 template<typename Parser>
 void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const& basic_blocks)
 {
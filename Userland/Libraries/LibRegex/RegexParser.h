@@ -11,6 +11,7 @@
 #include "RegexLexer.h"
 #include "RegexOptions.h"
 
+#include <AK/Array.h>
 #include <AK/Forward.h>
 #include <AK/StringBuilder.h>
 #include <AK/Types.h>
@@ -56,8 +57,17 @@ public:
         Vector<DeprecatedFlyString> capture_groups;
         AllOptions options;
 
+        struct StartingCharacters {
+            AK::Array<bool, 128> ascii {};
+            bool non_ascii { false };
+        };
+
         struct {
             Optional<ByteString> pure_substring_search;
+            // What every match is known to look like, so a search can skip over positions no match can start at.
+            Optional<ByteString> literal_prefix;
+            Optional<ByteString> required_substring;
+            Optional<StartingCharacters> starting_characters;
         } optimization_data {};
     };
 
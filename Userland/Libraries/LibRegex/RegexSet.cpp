@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/HashMap.h>
+#include <AK/Queue.h>
+#include <LibRegex/RegexSet.h>
+
+namespace regex {
+
+AhoCorasick::AhoCorasick(Vector<ByteString> const& literals, CaseSensitivity case_sensitivity)
+    : m_literal_count(literals.size())
+{
+    auto fold = [&](u8 byte) -> u8 {
+        return case_sensitivity == CaseSensitivity::CaseInsensitive ? to_ascii_lowercase(byte) : byte;
+    };
+
+    for (auto const& literal : literals) {
+        for (auto byte : literal.bytes()) {
+            if (m_byte_classes[fold(byte)] != 0)
+                continue;
+            m_byte_classes[fold(byte)] = m_class_count++;
+        }
+    }
+    if (case_sensitivity == CaseSensitivity::CaseInsensitive) {
+        for (u8 byte = 'A'; byte <= 'Z'; ++byte)
+            m_byte_classes[byte] = m_byte_classes[to_ascii_lowercase(byte)];
+    }
+
+    // Build the trie, with missing transitions left as 0, which is only ever the target of a failure transition.
+    m_next_literal.resize(literals.size());
+    add_state();
+    for (size_t i = 0; i < literals.size(); ++i) {
+        u32 state = 0;
+        for (auto byte : literals[i].bytes()) {
+            auto& next = m_transitions[state * m_class_count + m_byte_classes[byte]];
+            if (next == 0) {
+                auto new_state = add_state();
+                // add_state() may have moved the table.
+                m_transitions[state * m_class_count + m_byte_classes[byte]] = new_state;
+                state = new_state;
+            } else {
+                state = next;
+            }
+        }
+        m_next_literal[i] = m_first_literal[state];
+        m_first_literal[state] = i;
+    }
+
+    // Then fill in the failure transitions in breadth-first order, so the failure state of a state is always done before it.
+    Vector<u32> failure_links;
+    failure_links.resize(m_first_literal.size());
+    Queue<u32> queue;
+    for (size_t byte_class = 0; byte_class < m_class_count; ++byte_class) {
+        if (auto next = m_transitions[byte_class]; next != 0)
+            queue.enqueue(next);
+    }
+    while (!queue.is_empty()) {
+        auto state = queue.dequeue();
+        auto failure_state = failure_links[state];
+        m_output_link[state] = m_first_literal[failure_state] != no_literal && failure_state != 0 ? failure_state : m_output_link[failure_state];
+
+        for (size_t byte_class = 0; byte_class < m_class_count; ++byte_class) {
+            auto& next = m_transitions[state * m_class_count + byte_class];
+            auto failure_next = m_transitions[failure_state * m_class_count + byte_class];
+            if (next == 0) {
+                next = failure_next;
+                continue;
+            }
+            failure_links[next] = failure_next;
+            queue.enqueue(next);
+        }
+    }
+}
+
+u32 AhoCorasick::add_state()
+{
+    auto state = static_cast<u32>(m_first_literal.size());
+    m_transitions.resize(m_transitions.size() + m_class_count);
+    m_first_literal.append(no_literal);
+    m_output_link.append(0);
+    return state;
+}
+
+size_t AhoCorasick::find_all(StringView input, Vector<bool>& found) const
+{
+    found.clear_with_capacity();
+    found.resize(m_literal_count);
+    size_t found_count = 0;
+
+    auto report = [&](u32 state) {
+        for (auto literal = m_first_literal[state]; literal != no_literal; literal = m_next_literal[literal]) {
+            if (found[literal])
+                continue;
+            found[literal] = true;
+            ++found_count;
+        }
+    };
+
+    // Empty literals occur everywhere.
+    report(0);
+
+    u32 state = 0;
+    for (auto byte : input.bytes()) {
+        if (found_count == m_literal_count)
+            break;
+        state = m_transitions[state * m_class_count + m_byte_classes[byte]];
+        if (m_first_literal[state] != no_literal)
+            report(state);
+        for (auto output = m_output_link[state]; output != 0; output = m_output_link[output])
+            report(output);
+    }
+
+    return found_count;
+}
+
+template<class Parser>
+RegexSet<Parser>::RegexSet(Vector<ByteString> patterns, OptionsType regex_options)
+    : m_options(regex_options)
+{
+    auto case_insensitive = AllOptions { regex_options }.has_flag_set(AllFlags::Insensitive);
+
+    Vector<ByteString> literals;
+    HashMap<ByteString, u32> literal_indices;
+    auto literal_index = [&](ByteString const& literal) {
+        // Literals that only differ in case are the same literal to a case-insensitive scan.
+        auto key = case_insensitive ? literal.to_lowercase() : literal;
+        return literal_indices.ensure(key, [&] {
+            literals.append(literal);
+            return static_cast<u32>(literals.size() - 1);
+        });
+    };
+
+    m_regexes.ensure_capacity(patterns.size());
+    m_members.ensure_capacity(patterns.size());
+    for (auto& pattern : patterns) {
+        m_regexes.unchecked_append(Regex<Parser>(move(pattern), regex_options));
+        auto const& regex = m_regexes.last();
+
+        Member member;
+        auto const& parser_result = regex.parser_result;
+        auto const& optimization_data = parser_result.optimization_data;
+        if (parser_result.error == Error::NoError && parser_result.options.has_flag_set(AllFlags::Insensitive) == case_insensitive) {
+            if (optimization_data.pure_substring_search.has_value()) {
+                member.literal = literal_index(*optimization_data.pure_substring_search);
+                member.is_pure_literal = true;
+            } else if (optimization_data.required_substring.has_value()) {
+                member.literal = literal_index(*optimization_data.required_substring);
+            } else if (optimization_data.literal_prefix.has_value()) {
+                member.literal = literal_index(*optimization_data.literal_prefix);
+            }
+        }
+        m_members.unchecked_append(member);
+    }
+
+    if (!literals.is_empty())
+        m_literal_searcher = AhoCorasick(literals, case_insensitive ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive);
+}
+
+template<class Parser>
+RegexSet<Parser>::RegexSet(RegexSet&&) = default;
+
+template<class Parser>
+RegexSet<Parser>& RegexSet<Parser>::operator=(RegexSet&&) = default;
+
+template<class Parser>
+RegexSet<Parser>::~RegexSet() = default;
+
+template<class Parser>
+bool RegexSet<Parser>::scan_literals(RegexStringView view, Optional<OptionsType> regex_options, Vector<bool>& found_literals) const
+{
+    // The scan only understands bytes, and has folded case (or not) the way the patterns were compiled.
+    if (!m_literal_searcher.has_value() || !view.is_string_view())
+        return false;
+    auto options = AllOptions { m_options } | AllOptions { regex_options.value_or({}) }.value();
+    if (options.has_flag_set(AllFlags::Insensitive) != AllOptions { m_options }.has_flag_set(AllFlags::Insensitive))
+        return false;
+
+    m_literal_searcher->find_all(view.string_view(), found_literals);
+    return true;
+}
+
+template<class Parser>
+bool RegexSet<Parser>::member_matches(size_t index, RegexStringView view, Optional<OptionsType> regex_options, Vector<bool> const& found_literals, bool did_scan) const
+{
+    auto const& member = m_members[index];
+    if (did_scan && member.literal.has_value()) {
+        if (!found_literals[*member.literal])
+            return false;
+        // Options like MatchNotBeginOfLine can still rule out where the literal was found.
+        if (member.is_pure_literal && !regex_options.has_value())
+            return true;
+    }
+
+    auto options = AllOptions { regex_options.value_or({}) } | AllFlags::SingleMatch | AllFlags::SkipSubExprResults;
+    return m_regexes[index].search(view, OptionsType { options }).success;
+}
+
+template<class Parser>
+Vector<size_t> RegexSet<Parser>::matches(RegexStringView view, Optional<OptionsType> regex_options) const
+{
+    Vector<bool> found_literals;
+    auto did_scan = scan_literals(view, regex_options, found_literals);
+
+    Vector<size_t> indices;
+    for (size_t i = 0; i < m_regexes.size(); ++i) {
+        if (member_matches(i, view, regex_options, found_literals, did_scan))
+            indices.append(i);
+    }
+    return indices;
+}
+
+template<class Parser>
+Optional<size_t> RegexSet<Parser>::first_match(RegexStringView view, Optional<OptionsType> regex_options) const
+{
+    Vector<bool> found_literals;
+    auto did_scan = scan_literals(view, regex_options, found_literals);
+
+    for (size_t i = 0; i < m_regexes.size(); ++i) {
+        if (member_matches(i, view, regex_options, found_literals, did_scan))
+            return i;
+    }
+    return {};
+}
+
+template class RegexSet<PosixBasicParser>;
+template class RegexSet<PosixExtendedParser>;
+template class RegexSet<ECMA262Parser>;
+
+}
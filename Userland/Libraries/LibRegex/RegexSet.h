@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexMatcher.h"
+
+#include <AK/Array.h>
+#include <AK/ByteString.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// Finds which of a set of literal strings occur in an input, in a single pass over it (Aho-Corasick).
+class AhoCorasick {
+    AK_MAKE_NONCOPYABLE(AhoCorasick);
+    AK_MAKE_DEFAULT_MOVABLE(AhoCorasick);
+
+public:
+    // Literals are identified by their index in the given list. Only ASCII letters are folded when searching case-insensitively.
+    AhoCorasick(Vector<ByteString> const& literals, CaseSensitivity);
+
+    size_t literal_count() const { return m_literal_count; }
+
+    // Sets found[i] if the i-th literal occurs somewhere in the input, and returns how many of them do.
+    size_t find_all(StringView input, Vector<bool>& found) const;
+
+private:
+    static constexpr u32 no_literal = NumericLimits<u32>::max();
+
+    u32 add_state();
+
+    size_t m_literal_count { 0 };
+    // Bytes that don't occur in any literal share class 0, which keeps the transition table small.
+    AK::Array<u8, 256> m_byte_classes {};
+    size_t m_class_count { 1 };
+    // The transitions of the automaton, with the failure links already followed: m_class_count entries per state.
+    Vector<u32> m_transitions;
+    // The literals ending at a state are a linked list through m_next_literal.
+    Vector<u32> m_first_literal;
+    Vector<u32> m_next_literal;
+    // The nearest state a literal ends at that can be reached by following failure links, or 0 if there is none.
+    Vector<u32> m_output_link;
+};
+
+// Matches a set of patterns against an input and reports which of them match, without running every pattern on every input.
+//
+// Patterns that are plain strings are all looked for with a single Aho-Corasick scan. The same scan also looks for the
+// literal every match of one of the remaining patterns has to contain, so those only run when their literal was found.
+template<class Parser>
+class RegexSet final {
+    AK_MAKE_NONCOPYABLE(RegexSet);
+
+public:
+    using OptionsType = typename ParserTraits<Parser>::OptionsType;
+
+    explicit RegexSet(Vector<ByteString> patterns, OptionsType regex_options = {});
+    RegexSet(RegexSet&&);
+    RegexSet& operator=(RegexSet&&);
+    ~RegexSet();
+
+    size_t size() const { return m_regexes.size(); }
+    Regex<Parser> const& regex(size_t index) const { return m_regexes[index]; }
+    Regex<Parser> const& operator[](size_t index) const { return regex(index); }
+
+    // Returns the indices of the patterns that match somewhere in the input, in ascending order.
+    Vector<size_t> matches(RegexStringView, Optional<OptionsType> regex_options = {}) const;
+    // Returns the index of the first pattern that matches somewhere in the input.
+    Optional<size_t> first_match(RegexStringView, Optional<OptionsType> regex_options = {}) const;
+    bool has_match(RegexStringView view, Optional<OptionsType> regex_options = {}) const { return first_match(view, regex_options).has_value(); }
+
+private:
+    struct Member {
+        // The literal the scan looks for on behalf of this pattern.
+        Optional<u32> literal;
+        // Whether finding the literal means the pattern matches, rather than that it might.
+        bool is_pure_literal { false };
+    };
+
+    bool scan_literals(RegexStringView, Optional<OptionsType> regex_options, Vector<bool>& found_literals) const;
+    bool member_matches(size_t index, RegexStringView, Optional<OptionsType> regex_options, Vector<bool> const& found_literals, bool did_scan) const;
+
+    OptionsType m_options;
+    Vector<Regex<Parser>> m_regexes;
+    Vector<Member> m_members;
+    Optional<AhoCorasick> m_literal_searcher;
+};
+
+}
+
+using regex::RegexSet;
@@ -116,6 +116,9 @@ static consteval size_t __testjs_last()
 static constexpr auto TOP_LEVEL_TEST_NAME = "__$$TOP_LEVEL$$__";
 extern RefPtr<JS::VM> g_vm;
 extern bool g_collect_on_every_allocation;
+extern bool g_generational_gc;
+extern bool g_incremental_gc;
+extern size_t g_gc_marking_threads;
 extern ByteString g_currently_running_test;
 struct FunctionWithLength {
     JS::ThrowCompletionOr<JS::Value> (*function)(JS::VM&);
@@ -301,6 +304,9 @@ inline JSFileResult TestRunner::run_file_test(ByteString const& test_path)
     g_vm->pop_execution_context();
 
     g_vm->heap().set_should_collect_on_every_allocation(g_collect_on_every_allocation);
+    g_vm->heap().set_generational_collection_enabled(g_generational_gc);
+    g_vm->heap().set_incremental_marking_enabled(g_incremental_gc);
+    g_vm->heap().set_marking_thread_count(max(g_gc_marking_threads, 1uz));
 
     if (g_run_file) {
         auto result = g_run_file(test_path, *realm, global_execution_context);
@@ -337,8 +343,7 @@ inline JSFileResult TestRunner::run_file_test(ByteString const& test_path)
         }
     }
 
-    // FIXME: Since a new realm is created every time, we no longer cache the test-common.js file as scripts are parsed for the current realm only.
-    //        Find a way to cache this.
+    // NOTE: A new realm is created for every test file, but the AST (and bytecode) of test-common.js is reused through the VM's program cache.
     auto result = parse_script(m_common_path, *realm);
     if (result.is_error()) {
         warnln("Unable to parse test-common.js");
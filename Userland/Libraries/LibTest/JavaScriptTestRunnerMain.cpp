@@ -20,6 +20,9 @@ namespace JS {
 
 RefPtr<::JS::VM> g_vm;
 bool g_collect_on_every_allocation = false;
+bool g_generational_gc = false;
+bool g_incremental_gc = false;
+size_t g_gc_marking_threads = 1;
 ByteString g_currently_running_test;
 HashMap<ByteString, FunctionWithLength> s_exposed_global_functions;
 Function<void()> g_main_hook;
@@ -117,7 +120,15 @@ int main(int argc, char** argv)
     args_parser.add_option(print_json, "Show results as JSON", "json", 'j');
     args_parser.add_option(per_file, "Show detailed per-file results as JSON (implies -j)", "per-file");
     args_parser.add_option(g_collect_on_every_allocation, "Collect garbage after every allocation", "collect-often", 'g');
+    args_parser.add_option(g_generational_gc, "Use generational garbage collection", "generational-gc", {});
+    args_parser.add_option(g_incremental_gc, "Mark the heap incrementally, interleaved with the tests", "incremental-gc", {});
+    args_parser.add_option(g_gc_marking_threads, "Number of threads to mark the heap with", "gc-marking-threads", {}, "count");
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::Bytecode::g_dump_bytecode_passes, "Dump the bytecode before and after optimization, with per-pass timings", "dump-bytecode-passes", {});
+    args_parser.add_option(JS::Bytecode::g_disable_bytecode_optimizations, "Don't optimize the generated bytecode", "disable-bytecode-optimizations", {});
+    // The test runner isn't pledged, so the JIT can map its code as executable.
+    JS::Bytecode::g_disable_jit = false;
+    args_parser.add_option(JS::Bytecode::g_disable_jit, "Run everything in the bytecode interpreter", "disable-jit", {});
     args_parser.add_option(test_glob, "Only run tests matching the given glob", "filter", 'f', "glob");
     for (auto& entry : g_extra_args)
         args_parser.add_option(*entry.key, entry.value.get<0>().characters(), entry.value.get<1>().characters(), entry.value.get<2>());
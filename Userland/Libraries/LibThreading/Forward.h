@@ -12,4 +12,10 @@ namespace Threading {
 template<typename ErrorType>
 class WorkerThread;
 
+template<typename Pool>
+struct ThreadPoolLooper;
+
+template<typename TWork, template<typename> class Looper>
+class ThreadPool;
+
 }
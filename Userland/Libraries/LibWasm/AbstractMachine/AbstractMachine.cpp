@@ -44,7 +44,7 @@ Optional<TableAddress> Store::allocate(TableType const& type)
 Optional<MemoryAddress> Store::allocate(MemoryType const& type)
 {
     MemoryAddress address { m_memories.size() };
-    auto instance = MemoryInstance::create(type);
+    auto instance = MemoryInstance::create(type, m_memory_kind);
     if (instance.is_error())
         return {};
 
@@ -52,6 +52,83 @@ Optional<MemoryAddress> Store::allocate(MemoryType const& type)
     return address;
 }
 
+MemoryInstance::MemoryInstance(MemoryInstance&& other)
+    : successful_grow_hook(move(other.successful_grow_hook))
+    , m_type(other.m_type)
+    , m_size(exchange(other.m_size, 0))
+    , m_data(move(other.m_data))
+    , m_reservation(exchange(other.m_reservation, nullptr))
+{
+    // A small enough ByteBuffer keeps its data inline, so it may have moved along with it.
+    m_base = m_reservation ? m_reservation : m_data.data();
+    other.m_base = nullptr;
+}
+
+MemoryInstance& MemoryInstance::operator=(MemoryInstance&& other)
+{
+    if (this == &other)
+        return *this;
+    if (m_reservation)
+        release_guarded_memory(m_reservation);
+    successful_grow_hook = move(other.successful_grow_hook);
+    m_type = other.m_type;
+    m_size = exchange(other.m_size, 0);
+    m_data = move(other.m_data);
+    m_reservation = exchange(other.m_reservation, nullptr);
+    m_base = m_reservation ? m_reservation : m_data.data();
+    other.m_base = nullptr;
+    return *this;
+}
+
+MemoryInstance::~MemoryInstance()
+{
+    if (m_reservation)
+        release_guarded_memory(m_reservation);
+}
+
+bool MemoryInstance::grow(size_t size_to_grow, GrowType grow_type, InhibitGrowCallback inhibit_callback)
+{
+    if (size_to_grow == 0)
+        return true;
+    u64 new_size = m_size + size_to_grow;
+    // Can't grow past 2^16 pages.
+    if (new_size >= Constants::page_size * 65536)
+        return false;
+    if (auto max = m_type.limits().max(); max.has_value()) {
+        if (max.value() * Constants::page_size < new_size)
+            return false;
+    }
+    auto previous_size = m_size;
+    if (m_reservation) {
+        // The newly accessible pages have never been touched, so they're already zeroed.
+        if (!commit_guarded_memory(m_reservation, previous_size, new_size))
+            return false;
+        m_base = m_reservation;
+    } else {
+        if (m_data.try_resize(new_size).is_error())
+            return false;
+        m_base = m_data.data();
+        // The spec requires that we zero out everything on grow
+        __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
+    }
+    m_size = new_size;
+
+    // NOTE: This exists because wasm-js-api wants to execute code after a successful grow,
+    //       See [this issue](https://github.com/WebAssembly/spec/issues/1635) for more details.
+    if (inhibit_callback == InhibitGrowCallback::No && successful_grow_hook)
+        successful_grow_hook();
+
+    if (grow_type == GrowType::Yes) {
+        // Grow the memory's type. We do this when encountering a `memory.grow`.
+        //
+        // See relevant spec link:
+        // https://www.w3.org/TR/wasm-core-2/#growing-memories%E2%91%A0
+        m_type = MemoryType { Limits(m_type.limits().min() + size_to_grow / Constants::page_size, m_type.limits().max()) };
+    }
+
+    return true;
+}
+
 Optional<GlobalAddress> Store::allocate(GlobalType const& type, Value value)
 {
     GlobalAddress address { m_globals.size() };
@@ -365,7 +442,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
                     };
                 }
                 if (!data.init.is_empty())
-                    instance->data().overwrite(offset, data.init.data(), data.init.size());
+                    instance->bytes().overwrite(offset, data.init.data(), data.init.size());
                 return {};
             },
             [&](DataSection::Data::Passive const& passive) -> Optional<InstantiationError> {
@@ -13,6 +13,7 @@
 #include <AK/Result.h>
 #include <AK/StackInfo.h>
 #include <AK/UFixedBigInt.h>
+#include <LibWasm/AbstractMachine/GuardPages.h>
 #include <LibWasm/Types.h>
 
 // NOTE: Special case for Wasm::Result.
@@ -403,21 +404,62 @@ private:
 };
 
 class MemoryInstance {
+    AK_MAKE_NONCOPYABLE(MemoryInstance);
+
 public:
-    static ErrorOr<MemoryInstance> create(MemoryType const& type)
+    enum class Kind {
+        // Kept in a ByteBuffer, which is reallocated when the memory grows, and can be shared as one (e.g. to back an ArrayBuffer).
+        Buffer,
+        // Kept at the start of a reservation with guard pages after it, see GuardPages.h.
+        // Growing is cheap, and accesses don't need to be bounds checked.
+        GuardPages,
+    };
+
+    // Falls back to a Buffer memory where guard pages can't be set up, or where the reservation can't be committed to.
+    static ErrorOr<MemoryInstance> create(MemoryType const& type, Kind kind = Kind::Buffer)
     {
-        MemoryInstance instance { type };
+        if (kind == Kind::GuardPages) {
+            if (auto* reservation = reserve_guarded_memory()) {
+                MemoryInstance instance { type };
+                instance.m_reservation = reservation;
+                if (instance.grow(type.limits().min() * Constants::page_size, GrowType::No))
+                    return { move(instance) };
+            }
+        }
 
+        MemoryInstance instance { type };
         if (!instance.grow(type.limits().min() * Constants::page_size, GrowType::No))
             return Error::from_string_literal("Failed to grow to requested size");
 
         return { move(instance) };
     }
 
+    MemoryInstance(MemoryInstance&&);
+    MemoryInstance& operator=(MemoryInstance&&);
+    ~MemoryInstance();
+
     auto& type() const { return m_type; }
     auto size() const { return m_size; }
-    auto& data() const { return m_data; }
-    auto& data() { return m_data; }
+    Kind kind() const { return m_reservation ? Kind::GuardPages : Kind::Buffer; }
+    // Accesses to a guarded memory only need to be bounds checked if the fault they would cause wouldn't be turned into a trap.
+    bool is_guarded() const { return m_reservation != nullptr; }
+
+    // The accessible part of the memory; for guarded memories, what follows it up to the end of the reservation faults when accessed.
+    ALWAYS_INLINE u8* base() const { return m_base; }
+    Bytes bytes() { return { m_base, m_size }; }
+    ReadonlyBytes bytes() const { return { m_base, m_size }; }
+
+    // Only Buffer memories are backed by a ByteBuffer.
+    ByteBuffer const& data() const
+    {
+        VERIFY(!is_guarded());
+        return m_data;
+    }
+    ByteBuffer& data()
+    {
+        VERIFY(!is_guarded());
+        return m_data;
+    }
 
     enum class InhibitGrowCallback {
         No,
@@ -429,40 +471,7 @@ public:
         Yes,
     };
 
-    bool grow(size_t size_to_grow, GrowType grow_type = GrowType::Yes, InhibitGrowCallback inhibit_callback = InhibitGrowCallback::No)
-    {
-        if (size_to_grow == 0)
-            return true;
-        u64 new_size = m_data.size() + size_to_grow;
-        // Can't grow past 2^16 pages.
-        if (new_size >= Constants::page_size * 65536)
-            return false;
-        if (auto max = m_type.limits().max(); max.has_value()) {
-            if (max.value() * Constants::page_size < new_size)
-                return false;
-        }
-        auto previous_size = m_size;
-        if (m_data.try_resize(new_size).is_error())
-            return false;
-        m_size = new_size;
-        // The spec requires that we zero out everything on grow
-        __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
-
-        // NOTE: This exists because wasm-js-api wants to execute code after a successful grow,
-        //       See [this issue](https://github.com/WebAssembly/spec/issues/1635) for more details.
-        if (inhibit_callback == InhibitGrowCallback::No && successful_grow_hook)
-            successful_grow_hook();
-
-        if (grow_type == GrowType::Yes) {
-            // Grow the memory's type. We do this when encountering a `memory.grow`.
-            //
-            // See relevant spec link:
-            // https://www.w3.org/TR/wasm-core-2/#growing-memories%E2%91%A0
-            m_type = MemoryType { Limits(m_type.limits().min() + size_to_grow / Constants::page_size, m_type.limits().max()) };
-        }
-
-        return true;
-    }
+    bool grow(size_t size_to_grow, GrowType grow_type = GrowType::Yes, InhibitGrowCallback inhibit_callback = InhibitGrowCallback::No);
 
     Function<void()> successful_grow_hook;
 
@@ -474,7 +483,9 @@ private:
 
     MemoryType m_type;
     size_t m_size { 0 };
+    u8* m_base { nullptr };
     ByteBuffer m_data;
+    u8* m_reservation { nullptr };
 };
 
 class GlobalInstance {
@@ -553,6 +564,9 @@ public:
     DataInstance* get(DataAddress);
     ElementInstance* get(ElementAddress);
 
+    // The kind of memory that allocate(MemoryType const&) creates.
+    void set_memory_kind(MemoryInstance::Kind kind) { m_memory_kind = kind; }
+
 private:
     Vector<FunctionInstance> m_functions;
     Vector<TableInstance> m_tables;
@@ -560,25 +574,7 @@ private:
     Vector<GlobalInstance> m_globals;
     Vector<ElementInstance> m_elements;
     Vector<DataInstance> m_datas;
-};
-
-class Label {
-public:
-    explicit Label(size_t arity, InstructionPointer continuation, size_t stack_height)
-        : m_arity(arity)
-        , m_stack_height(stack_height)
-        , m_continuation(continuation)
-    {
-    }
-
-    auto continuation() const { return m_continuation; }
-    auto arity() const { return m_arity; }
-    auto stack_height() const { return m_stack_height; }
-
-private:
-    size_t m_arity { 0 };
-    size_t m_stack_height { 0 };
-    InstructionPointer m_continuation { 0 };
+    MemoryInstance::Kind m_memory_kind { MemoryInstance::Kind::Buffer };
 };
 
 class Frame {
@@ -596,15 +592,12 @@ public:
     auto& locals() { return m_locals; }
     auto& expression() const { return m_expression; }
     auto arity() const { return m_arity; }
-    auto label_index() const { return m_label_index; }
-    auto& label_index() { return m_label_index; }
 
 private:
     ModuleInstance const& m_module;
     Vector<Value> m_locals;
     Expression const& m_expression;
     size_t m_arity { 0 };
-    size_t m_label_index { 0 };
 };
 
 using InstantiationResult = AK::ErrorOr<NonnullOwnPtr<ModuleInstance>, InstantiationError>;
@@ -14,6 +14,7 @@
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/AbstractMachine/GuardPages.h>
 #include <LibWasm/AbstractMachine/Operators.h>
 #include <LibWasm/Opcode.h>
 #include <LibWasm/Printer/Printer.h>
@@ -33,7 +34,24 @@ namespace Wasm {
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
-    auto& instructions = configuration.frame().expression().instructions();
+    if (!guarded_memories_exist()) {
+        interpret_instructions(configuration);
+        return;
+    }
+
+    // Accesses to guarded memories aren't bounds checked, one that's out of bounds faults and the fault handler jumps back here.
+    sigjmp_buf jump_buffer;
+    GuardedMemoryTrapScope trap_scope { &jump_buffer };
+    if (sigsetjmp(jump_buffer, 0) != 0) {
+        m_trap = Trap { "Memory access out of bounds" };
+        return;
+    }
+    interpret_instructions(configuration);
+}
+
+void BytecodeInterpreter::interpret_instructions(Configuration& configuration)
+{
+    auto& instructions = configuration.frame().expression().compiled_instructions();
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
     auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
@@ -47,25 +65,22 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
             }
         }
         auto& instruction = instructions[current_ip_value.value()];
-        auto old_ip = current_ip_value;
+        // Branches overwrite this with their target, everything else carries on with the next instruction.
+        ++current_ip_value;
         interpret_instruction(configuration, current_ip_value, instruction);
         if (did_trap())
             return;
-        if (current_ip_value == old_ip) // If no jump occurred
-            ++current_ip_value;
     }
 }
 
-void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
+ALWAYS_INLINE void BytecodeInterpreter::branch(Configuration& configuration, InstructionPointer& ip, Instruction::BranchArgs const& args)
 {
-    dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
-    for (size_t i = 0; i < index.value(); ++i)
-        configuration.label_stack().take_last();
-    auto label = configuration.label_stack().last();
-    dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label.continuation().value(), label.arity());
-
-    configuration.value_stack().remove(label.stack_height(), configuration.value_stack().size() - label.stack_height() - label.arity());
-    configuration.ip() = label.continuation();
+    dbgln_if(WASM_TRACE_DEBUG, "Branch to IP {}, keeping {} value(s) and dropping {}", args.target.value(), args.arity, args.drop_count);
+    if (args.drop_count != 0) {
+        auto& value_stack = configuration.value_stack();
+        value_stack.remove(value_stack.size() - args.arity - args.drop_count, args.drop_count);
+    }
+    ip = args.target;
 }
 
 template<typename ReadType, typename PushType>
@@ -77,13 +92,13 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
     auto& entry = configuration.value_stack().last();
     auto base = entry.to<i32>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
-    if (instance_address + sizeof(ReadType) > memory->size()) {
+    if (!memory->is_guarded() && instance_address + sizeof(ReadType) > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
         dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + sizeof(ReadType), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
+    auto slice = Bytes { memory->base() + instance_address, sizeof(ReadType) };
     entry = Value(static_cast<PushType>(read_value<ReadType>(slice)));
 }
 
@@ -102,13 +117,13 @@ void BytecodeInterpreter::load_and_push_mxn(Configuration& configuration, Instru
     auto& entry = configuration.value_stack().last();
     auto base = entry.to<i32>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
-    if (instance_address + M * N / 8 > memory->size()) {
+    if (!memory->is_guarded() && instance_address + M * N / 8 > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
         dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + M * N / 8, memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-load({} : {}) -> stack", instance_address, M * N / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M * N / 8);
+    auto slice = Bytes { memory->base() + instance_address, M * N / 8 };
     using V64 = NativeVectorType<M, N, SetSign>;
     using V128 = NativeVectorType<M * 2, N, SetSign>;
 
@@ -130,11 +145,11 @@ void BytecodeInterpreter::load_and_push_lane_n(Configuration& configuration, Ins
     auto vector = configuration.value_stack().take_last().to<u128>();
     auto base = configuration.value_stack().take_last().to<u32>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + memarg_and_lane.memory.offset;
-    if (instance_address + N / 8 > memory->size()) {
+    if (!memory->is_guarded() && instance_address + N / 8 > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
         return;
     }
-    auto slice = memory->data().bytes().slice(instance_address, N / 8);
+    auto slice = Bytes { memory->base() + instance_address, N / 8 };
     auto dst = bit_cast<u8*>(&vector) + memarg_and_lane.lane * N / 8;
     memcpy(dst, slice.data(), N / 8);
     configuration.value_stack().append(Value(vector));
@@ -148,11 +163,11 @@ void BytecodeInterpreter::load_and_push_zero_n(Configuration& configuration, Ins
     auto memory = configuration.store().get(address);
     auto base = configuration.value_stack().take_last().to<u32>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + memarg_and_lane.offset;
-    if (instance_address + N / 8 > memory->size()) {
+    if (!memory->is_guarded() && instance_address + N / 8 > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
         return;
     }
-    auto slice = memory->data().bytes().slice(instance_address, N / 8);
+    auto slice = Bytes { memory->base() + instance_address, N / 8 };
     u128 vector = 0;
     memcpy(&vector, slice.data(), N / 8);
     configuration.value_stack().append(Value(vector));
@@ -167,13 +182,13 @@ void BytecodeInterpreter::load_and_push_m_splat(Configuration& configuration, In
     auto& entry = configuration.value_stack().last();
     auto base = entry.to<i32>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
-    if (instance_address + M / 8 > memory->size()) {
+    if (!memory->is_guarded() && instance_address + M / 8 > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
         dbgln("LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + M / 8, memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "vec-splat({} : {}) -> stack", instance_address, M / 8);
-    auto slice = memory->data().bytes().slice(instance_address, M / 8);
+    auto slice = Bytes { memory->base() + instance_address, M / 8 };
     auto value = read_value<NativeIntegralType<M>>(slice);
     set_top_m_splat<M, NativeIntegralType>(configuration, value);
 }
@@ -228,21 +243,26 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
     TRAP_IF_NOT(m_stack_info.size_free() >= Constants::minimum_stack_space_to_keep_free);
 
     auto instance = configuration.store().get(address);
-    FunctionType const* type { nullptr };
-    instance->visit([&](auto const& function) { type = &function.type(); });
+    if (auto* wasm_function = instance->get_pointer<WasmFunction>()) {
+        // The arguments and results can stay where they are on the stack, the callee's frame doesn't need a copy of them.
+        CallFrameHandle handle { *this, configuration };
+        configuration.call_with_arguments_on_stack(*this, *wasm_function);
+        return;
+    }
+
+    auto& type = instance->get<HostFunction>().type();
     Vector<Value> args;
-    args.ensure_capacity(type->parameters().size());
-    auto span = configuration.value_stack().span().slice_from_end(type->parameters().size());
+    args.ensure_capacity(type.parameters().size());
+    auto span = configuration.value_stack().span().slice_from_end(type.parameters().size());
     for (auto& value : span)
         args.unchecked_append(value);
 
     configuration.value_stack().remove(configuration.value_stack().size() - span.size(), span.size());
 
     Result result { Trap { ""sv } };
-    if (instance->has<WasmFunction>()) {
-        CallFrameHandle handle { *this, configuration };
-        result = configuration.call(*this, address, move(args));
-    } else {
+    {
+        // Faults in host code are never ours to turn into traps.
+        GuardedMemoryTrapScope trap_scope { nullptr };
         result = configuration.call(*this, address, move(args));
     }
 
@@ -358,49 +378,39 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
     auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
     auto memory = configuration.store().get(address);
     u64 instance_address = static_cast<u64>(base) + arg.offset;
-    Checked addition { instance_address };
-    addition += data.size();
-    if (addition.has_overflow() || addition.value() > memory->size()) {
-        m_trap = Trap { "Memory access out of bounds" };
-        dbgln("LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + data.size(), memory->size());
-        return;
+    if (!memory->is_guarded()) {
+        Checked addition { instance_address };
+        addition += data.size();
+        if (addition.has_overflow() || addition.value() > memory->size()) {
+            m_trap = Trap { "Memory access out of bounds" };
+            dbgln("LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + data.size(), memory->size());
+            return;
+        }
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    data.copy_to(Bytes { memory->base() + instance_address, data.size() });
 }
 
+// This reads straight from the memory rather than through a stream, as the read faults when a guarded memory is accessed out of bounds.
 template<typename T>
 T BytecodeInterpreter::read_value(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto value_or_error = stream.read_value<LittleEndian<T>>();
-    if (value_or_error.is_error()) {
-        dbgln("Read from {} failed", data.data());
-        m_trap = Trap { "Read from memory failed" };
-    }
-    return value_or_error.release_value();
+    VERIFY(data.size() == sizeof(T));
+    T value;
+    memcpy(&value, data.data(), sizeof(T));
+    return AK::convert_between_host_and_little_endian(value);
 }
 
 template<>
 float BytecodeInterpreter::read_value<float>(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u32>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap { "Read from memory failed" };
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<float>(static_cast<u32>(raw_value));
+    return bit_cast<float>(read_value<u32>(data));
 }
 
 template<>
 double BytecodeInterpreter::read_value<double>(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u64>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap { "Read from memory failed" };
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<double>(static_cast<u64>(raw_value));
+    return bit_cast<double>(read_value<u64>(data));
 }
 
 ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
@@ -414,7 +424,7 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
     case Instructions::nop.value():
         return;
     case Instructions::local_get.value():
-        configuration.value_stack().append(Value(configuration.frame().locals()[instruction.arguments().get<LocalIndex>().value()]));
+        configuration.value_stack().unchecked_append(Value(configuration.frame().locals()[instruction.arguments().get<LocalIndex>().value()]));
         return;
     case Instructions::local_set.value(): {
         auto value = configuration.value_stack().take_last();
@@ -422,109 +432,63 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         return;
     }
     case Instructions::i32_const.value():
-        configuration.value_stack().append(Value(instruction.arguments().get<i32>()));
+        configuration.value_stack().unchecked_append(Value(instruction.arguments().get<i32>()));
         return;
     case Instructions::i64_const.value():
-        configuration.value_stack().append(Value(instruction.arguments().get<i64>()));
+        configuration.value_stack().unchecked_append(Value(instruction.arguments().get<i64>()));
         return;
     case Instructions::f32_const.value():
-        configuration.value_stack().append(Value(instruction.arguments().get<float>()));
+        configuration.value_stack().unchecked_append(Value(instruction.arguments().get<float>()));
         return;
     case Instructions::f64_const.value():
-        configuration.value_stack().append(Value(instruction.arguments().get<double>()));
+        configuration.value_stack().unchecked_append(Value(instruction.arguments().get<double>()));
         return;
-    case Instructions::block.value(): {
-        size_t arity = 0;
-        size_t param_arity = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            param_arity = type.parameters().size();
-        }
-        }
-
-        configuration.label_stack().append(Label(arity, args.end_ip, configuration.value_stack().size() - param_arity));
+    case Instructions::synthetic_br.value():
+        return branch(configuration, ip, instruction.arguments().get<Instruction::BranchArgs>());
+    case Instructions::synthetic_br_if.value():
+        if (configuration.value_stack().take_last().to<i32>() != 0)
+            branch(configuration, ip, instruction.arguments().get<Instruction::BranchArgs>());
         return;
-    }
-    case Instructions::loop.value(): {
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        size_t arity = 0;
-        if (args.block_type.kind() == BlockType::Index) {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.parameters().size();
-        }
-        configuration.label_stack().append(Label(arity, ip.value() + 1, configuration.value_stack().size() - arity));
+    case Instructions::synthetic_br_unless.value():
+        if (configuration.value_stack().take_last().to<i32>() == 0)
+            branch(configuration, ip, instruction.arguments().get<Instruction::BranchArgs>());
         return;
+    case Instructions::synthetic_br_table.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::BranchTableArgs>();
+        auto i = configuration.value_stack().take_last().to<u32>();
+        if (i >= arguments.targets.size())
+            return branch(configuration, ip, arguments.default_);
+        return branch(configuration, ip, arguments.targets[i]);
     }
-    case Instructions::if_.value(): {
-        size_t arity = 0;
-        size_t param_arity = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            param_arity = type.parameters().size();
-        }
-        }
-
-        auto value = configuration.value_stack().take_last().to<i32>();
-        auto end_label = Label(arity, args.end_ip.value(), configuration.value_stack().size() - param_arity);
-        if (value == 0) {
-            if (args.else_ip.has_value()) {
-                configuration.ip() = args.else_ip.value();
-                configuration.label_stack().append(end_label);
-            } else {
-                configuration.ip() = args.end_ip.value() + 1;
-            }
-        } else {
-            configuration.label_stack().append(end_label);
-        }
+    case Instructions::synthetic_local_copy.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalPairArgs>();
+        auto& locals = configuration.frame().locals();
+        locals[args.second.value()] = locals[args.first.value()];
         return;
     }
-    case Instructions::structured_end.value():
-        configuration.label_stack().take_last();
-        return;
-    case Instructions::structured_else.value(): {
-        auto label = configuration.label_stack().take_last();
-        // Jump to the end label
-        configuration.ip() = label.continuation();
+    case Instructions::synthetic_local_set_i32_const.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalAndConstantArgs>();
+        configuration.frame().locals()[args.local.value()] = Value(args.constant);
         return;
     }
-    case Instructions::return_.value(): {
-        while (configuration.label_stack().size() - 1 != configuration.frame().label_index())
-            configuration.label_stack().take_last();
-        configuration.ip() = configuration.frame().expression().instructions().size();
+    case Instructions::synthetic_i32_add_locals.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalPairArgs>();
+        auto& locals = configuration.frame().locals();
+        auto result = locals[args.first.value()].to<u32>() + locals[args.second.value()].to<u32>();
+        configuration.value_stack().unchecked_append(Value(static_cast<i32>(result)));
         return;
     }
-    case Instructions::br.value():
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
-    case Instructions::br_if.value(): {
-        auto cond = configuration.value_stack().take_last().to<i32>();
-        if (cond == 0)
-            return;
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
+    case Instructions::synthetic_i32_add_local_const.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalAndConstantArgs>();
+        auto result = configuration.frame().locals()[args.local.value()].to<u32>() + static_cast<u32>(args.constant);
+        configuration.value_stack().unchecked_append(Value(static_cast<i32>(result)));
+        return;
     }
-    case Instructions::br_table.value(): {
-        auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
-        auto i = configuration.value_stack().take_last().to<u32>();
-
-        if (i >= arguments.labels.size()) {
-            return branch_to_label(configuration, arguments.default_);
-        }
-        return branch_to_label(configuration, arguments.labels[i]);
+    case Instructions::synthetic_i32_and_local_const.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalAndConstantArgs>();
+        auto result = configuration.frame().locals()[args.local.value()].to<i32>() & args.constant;
+        configuration.value_stack().unchecked_append(Value(result));
+        return;
     }
     case Instructions::call.value(): {
         auto index = instruction.arguments().get<FunctionIndex>();
@@ -652,7 +616,7 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         u8 value = static_cast<u8>(configuration.value_stack().take_last().to<u32>());
         auto destination_offset = configuration.value_stack().take_last().to<u32>();
 
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
+        TRAP_IF_NOT(static_cast<u64>(destination_offset) + count <= instance->size());
 
         if (count == 0)
             return;
@@ -678,8 +642,8 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         source_position.saturating_add(count);
         Checked<size_t> destination_position = destination_offset;
         destination_position.saturating_add(count);
-        TRAP_IF_NOT(source_position <= source_instance->data().size());
-        TRAP_IF_NOT(destination_position <= destination_instance->data().size());
+        TRAP_IF_NOT(source_position <= source_instance->size());
+        TRAP_IF_NOT(destination_position <= destination_instance->size());
 
         if (count == 0)
             return;
@@ -687,12 +651,12 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         Instruction::MemoryArgument memarg { 0, 0, args.dst_index };
         if (destination_offset <= source_offset) {
             for (auto i = 0; i < count; ++i) {
-                auto value = source_instance->data()[source_offset + i];
+                auto value = source_instance->bytes()[source_offset + i];
                 store_to_memory(configuration, memarg, { &value, sizeof(value) }, destination_offset + i);
             }
         } else {
             for (auto i = count - 1; i >= 0; --i) {
-                auto value = source_instance->data()[source_offset + i];
+                auto value = source_instance->bytes()[source_offset + i];
                 store_to_memory(configuration, memarg, { &value, sizeof(value) }, destination_offset + i);
             }
         }
@@ -715,7 +679,7 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         Checked<size_t> destination_position = destination_offset;
         destination_position.saturating_add(count);
         TRAP_IF_NOT(source_position <= data.data().size());
-        TRAP_IF_NOT(destination_position <= memory->data().size());
+        TRAP_IF_NOT(destination_position <= memory->size());
 
         if (count == 0)
             return;
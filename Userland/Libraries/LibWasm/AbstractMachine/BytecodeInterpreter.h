@@ -45,8 +45,10 @@ struct BytecodeInterpreter : public Interpreter {
     };
 
 protected:
+    // Kept out of line so that nothing it keeps in registers has to survive the sigsetjmp() in interpret().
+    NEVER_INLINE void interpret_instructions(Configuration&);
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
-    void branch_to_label(Configuration&, LabelIndex);
+    void branch(Configuration&, InstructionPointer&, Instruction::BranchArgs const&);
     template<typename ReadT, typename PushT>
     void load_and_push(Configuration&, Instruction const&);
     template<typename PopT, typename StoreT>
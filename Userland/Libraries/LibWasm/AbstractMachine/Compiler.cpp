@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWasm/AbstractMachine/Compiler.h>
+#include <LibWasm/Opcode.h>
+
+namespace Wasm {
+
+namespace {
+
+struct BlockArity {
+    u32 parameters { 0 };
+    u32 results { 0 };
+};
+
+class FunctionBodyCompiler {
+public:
+    FunctionBodyCompiler(Expression const& body, ReadonlySpan<u32> stack_heights, COWVector<FunctionType> const& types)
+        : m_body(body)
+        , m_stack_heights(stack_heights)
+        , m_types(types)
+    {
+    }
+
+    Vector<Instruction> compile(size_t result_count);
+
+private:
+    struct PendingBranch {
+        size_t instruction;
+        // For br_table, which of its targets this is; the default target comes after all others.
+        Optional<size_t> table_entry;
+    };
+
+    struct ControlFrame {
+        enum class Kind {
+            Block,
+            Loop,
+            If,
+        };
+
+        Kind kind;
+        // Branching to the frame's label brings the stack back to this height (i.e. the one below the frame's parameters),
+        u32 height { 0 };
+        // and then puts the values the branch passes along back on top: the frame's results, or its parameters for a loop.
+        u32 label_arity { 0 };
+        InstructionPointer loop_start { 0 };
+        // Branches to the end of the frame, which can't be resolved until the end is reached.
+        Vector<PendingBranch> pending_branches;
+        // The branch an `if` takes when its condition is false, until its else (or end) is reached.
+        Optional<size_t> if_branch;
+    };
+
+    BlockArity arity(BlockType const&) const;
+
+    void compile_instruction(size_t index);
+    Instruction::BranchArgs branch_to(LabelIndex, u32 height_at_branch, PendingBranch);
+    void resolve_pending_branches(ControlFrame&);
+    void set_branch_target(PendingBranch, InstructionPointer);
+    void append(Instruction);
+    void place_label();
+
+    ControlFrame& frame_for(LabelIndex label) { return m_control_stack[m_control_stack.size() - 1 - label.value()]; }
+    InstructionPointer next_ip() const { return InstructionPointer { m_output.size() }; }
+
+    Expression const& m_body;
+    ReadonlySpan<u32> m_stack_heights;
+    COWVector<FunctionType> const& m_types;
+
+    Vector<Instruction> m_output;
+    Vector<ControlFrame> m_control_stack;
+    // Instructions may only be fused if they all come after the last place a branch can land at.
+    size_t m_fusable_from { 0 };
+};
+
+BlockArity FunctionBodyCompiler::arity(BlockType const& type) const
+{
+    switch (type.kind()) {
+    case BlockType::Empty:
+        return {};
+    case BlockType::Type:
+        return { 0, 1 };
+    case BlockType::Index: {
+        auto& function_type = m_types[type.type_index().value()];
+        return { static_cast<u32>(function_type.parameters().size()), static_cast<u32>(function_type.results().size()) };
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+Vector<Instruction> FunctionBodyCompiler::compile(size_t result_count)
+{
+    VERIFY(m_stack_heights.size() == m_body.instructions().size());
+    m_output.ensure_capacity(m_body.instructions().size());
+
+    // The function itself is the outermost label, a branch to it (or a return) ends the function with its results on the stack.
+    m_control_stack.append(ControlFrame { .kind = ControlFrame::Kind::Block, .height = 0, .label_arity = static_cast<u32>(result_count) });
+
+    for (size_t i = 0; i < m_body.instructions().size(); ++i)
+        compile_instruction(i);
+
+    VERIFY(m_control_stack.size() == 1);
+    resolve_pending_branches(m_control_stack.last());
+    return move(m_output);
+}
+
+void FunctionBodyCompiler::compile_instruction(size_t index)
+{
+    auto& instruction = m_body.instructions()[index];
+    auto height = m_stack_heights[index];
+    // Code that can't be reached can have made-up stack heights, but whatever it does never happens either.
+    auto height_after_condition = height > 0 ? height - 1 : 0;
+
+    switch (instruction.opcode().value()) {
+    case Instructions::nop.value():
+        return;
+    case Instructions::block.value():
+    case Instructions::loop.value(): {
+        auto block_arity = arity(instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type);
+        auto is_loop = instruction.opcode() == Instructions::loop;
+        ControlFrame frame {
+            .kind = is_loop ? ControlFrame::Kind::Loop : ControlFrame::Kind::Block,
+            .height = height - min(height, block_arity.parameters),
+            .label_arity = is_loop ? block_arity.parameters : block_arity.results,
+        };
+        if (is_loop) {
+            frame.loop_start = next_ip();
+            place_label();
+        }
+        m_control_stack.append(move(frame));
+        return;
+    }
+    case Instructions::if_.value(): {
+        auto block_arity = arity(instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type);
+        // The branch to the else doesn't need to touch the stack, the parameters stay where they are.
+        if (m_output.size() > m_fusable_from && m_output.last().opcode() == Instructions::i32_eqz) {
+            m_output.take_last();
+            append(Instruction { Instructions::synthetic_br_if, Instruction::BranchArgs {} });
+        } else {
+            append(Instruction { Instructions::synthetic_br_unless, Instruction::BranchArgs {} });
+        }
+        m_control_stack.append(ControlFrame {
+            .kind = ControlFrame::Kind::If,
+            .height = height_after_condition - min(height_after_condition, block_arity.parameters),
+            .label_arity = block_arity.results,
+            .if_branch = m_output.size() - 1,
+        });
+        return;
+    }
+    case Instructions::structured_else.value(): {
+        auto& frame = m_control_stack.last();
+        VERIFY(frame.kind == ControlFrame::Kind::If);
+        append(Instruction { Instructions::synthetic_br, branch_to(LabelIndex { 0 }, height, { m_output.size(), {} }) });
+        set_branch_target({ frame.if_branch.release_value(), {} }, next_ip());
+        place_label();
+        return;
+    }
+    case Instructions::structured_end.value(): {
+        auto frame = m_control_stack.take_last();
+        if (frame.if_branch.has_value()) {
+            // An if without an else branches here when the condition is false, so nothing may be fused across this point.
+            set_branch_target({ *frame.if_branch, {} }, next_ip());
+            place_label();
+        }
+        resolve_pending_branches(frame);
+        return;
+    }
+    case Instructions::br.value():
+        append(Instruction { Instructions::synthetic_br, branch_to(instruction.arguments().get<LabelIndex>(), height, { m_output.size(), {} }) });
+        return;
+    case Instructions::br_if.value(): {
+        auto label = instruction.arguments().get<LabelIndex>();
+        auto opcode = Instructions::synthetic_br_if;
+        if (m_output.size() > m_fusable_from && m_output.last().opcode() == Instructions::i32_eqz) {
+            m_output.take_last();
+            opcode = Instructions::synthetic_br_unless;
+        }
+        append(Instruction { opcode, branch_to(label, height_after_condition, { m_output.size(), {} }) });
+        return;
+    }
+    case Instructions::br_table.value(): {
+        auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
+        Instruction::BranchTableArgs table;
+        table.targets.ensure_capacity(args.labels.size());
+        for (size_t i = 0; i < args.labels.size(); ++i)
+            table.targets.unchecked_append(branch_to(args.labels[i], height_after_condition, { m_output.size(), i }));
+        table.default_ = branch_to(args.default_, height_after_condition, { m_output.size(), args.labels.size() });
+        append(Instruction { Instructions::synthetic_br_table, move(table) });
+        return;
+    }
+    case Instructions::return_.value():
+        append(Instruction { Instructions::synthetic_br, branch_to(LabelIndex { m_control_stack.size() - 1 }, height, { m_output.size(), {} }) });
+        return;
+    default:
+        append(instruction);
+        return;
+    }
+}
+
+Instruction::BranchArgs FunctionBodyCompiler::branch_to(LabelIndex label, u32 height_at_branch, PendingBranch pending)
+{
+    auto& frame = frame_for(label);
+    Instruction::BranchArgs args;
+    args.arity = frame.label_arity;
+    if (height_at_branch > frame.height + frame.label_arity)
+        args.drop_count = height_at_branch - frame.height - frame.label_arity;
+
+    if (frame.kind == ControlFrame::Kind::Loop)
+        args.target = frame.loop_start;
+    else
+        frame.pending_branches.append(pending);
+    return args;
+}
+
+void FunctionBodyCompiler::resolve_pending_branches(ControlFrame& frame)
+{
+    for (auto& pending : frame.pending_branches)
+        set_branch_target(pending, next_ip());
+    if (!frame.pending_branches.is_empty())
+        place_label();
+}
+
+void FunctionBodyCompiler::set_branch_target(PendingBranch pending, InstructionPointer target)
+{
+    auto& arguments = m_output[pending.instruction].arguments();
+    if (!pending.table_entry.has_value()) {
+        arguments.get<Instruction::BranchArgs>().target = target;
+        return;
+    }
+    auto& table = arguments.get<Instruction::BranchTableArgs>();
+    auto& entry = *pending.table_entry < table.targets.size() ? table.targets[*pending.table_entry] : table.default_;
+    entry.target = target;
+}
+
+void FunctionBodyCompiler::place_label()
+{
+    m_fusable_from = m_output.size();
+}
+
+void FunctionBodyCompiler::append(Instruction instruction)
+{
+    auto fusable = [&](size_t count) { return m_output.size() >= m_fusable_from + count; };
+    auto opcode_from_end = [&](size_t offset) { return m_output[m_output.size() - 1 - offset].opcode(); };
+    auto arguments_from_end = [&](size_t offset) -> auto& { return m_output[m_output.size() - 1 - offset].arguments(); };
+
+    auto replace_last = [&](size_t count, Instruction fused) {
+        m_output.shrink(m_output.size() - count, true);
+        m_output.append(move(fused));
+    };
+
+    switch (instruction.opcode().value()) {
+    case Instructions::i32_add.value():
+        if (!fusable(2) || opcode_from_end(1) != Instructions::local_get)
+            break;
+        if (opcode_from_end(0) == Instructions::local_get) {
+            Instruction::LocalPairArgs args { arguments_from_end(1).get<LocalIndex>(), arguments_from_end(0).get<LocalIndex>() };
+            return replace_last(2, Instruction { Instructions::synthetic_i32_add_locals, args });
+        }
+        if (opcode_from_end(0) == Instructions::i32_const) {
+            Instruction::LocalAndConstantArgs args { arguments_from_end(1).get<LocalIndex>(), arguments_from_end(0).get<i32>() };
+            return replace_last(2, Instruction { Instructions::synthetic_i32_add_local_const, args });
+        }
+        break;
+    case Instructions::i32_and.value():
+        if (fusable(2) && opcode_from_end(1) == Instructions::local_get && opcode_from_end(0) == Instructions::i32_const) {
+            Instruction::LocalAndConstantArgs args { arguments_from_end(1).get<LocalIndex>(), arguments_from_end(0).get<i32>() };
+            return replace_last(2, Instruction { Instructions::synthetic_i32_and_local_const, args });
+        }
+        break;
+    case Instructions::local_set.value():
+        if (!fusable(1))
+            break;
+        if (opcode_from_end(0) == Instructions::local_get) {
+            Instruction::LocalPairArgs args { arguments_from_end(0).get<LocalIndex>(), instruction.arguments().get<LocalIndex>() };
+            return replace_last(1, Instruction { Instructions::synthetic_local_copy, args });
+        }
+        if (opcode_from_end(0) == Instructions::i32_const) {
+            Instruction::LocalAndConstantArgs args { instruction.arguments().get<LocalIndex>(), arguments_from_end(0).get<i32>() };
+            return replace_last(1, Instruction { Instructions::synthetic_local_set_i32_const, args });
+        }
+        break;
+    default:
+        break;
+    }
+
+    m_output.append(move(instruction));
+}
+
+}
+
+Vector<Instruction> compile_function_body(Expression const& body, ReadonlySpan<u32> stack_heights, size_t result_count, COWVector<FunctionType> const& types)
+{
+    return FunctionBodyCompiler { body, stack_heights, types }.compile(result_count);
+}
+
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/COWVector.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+// Translates a validated function body into the instructions the interpreter runs (see Expression::compiled_instructions()).
+//
+// As the height of the value stack at every instruction is known after validation, the labels of structured instructions
+// can be resolved ahead of time: block, loop and end disappear, and branches become synthetic instructions that know where
+// they go, and how many values to keep and drop on the way. This also makes the interpreter's label stack unnecessary.
+// Some common sequences of instructions (e.g. adding two locals) are fused into a single synthetic instruction.
+//
+// `stack_heights` holds the height of the stack before each instruction of the body.
+Vector<Instruction> compile_function_body(Expression const&, ReadonlySpan<u32> stack_heights, size_t result_count, COWVector<FunctionType> const& types);
+
+}
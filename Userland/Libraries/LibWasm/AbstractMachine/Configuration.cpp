@@ -46,6 +46,31 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
     return host_function.function()(*this, arguments);
 }
 
+void Configuration::call_with_arguments_on_stack(Interpreter& interpreter, WasmFunction const& function)
+{
+    auto& code = function.code().func();
+    auto arguments = m_value_stack.span().slice_from_end(function.type().parameters().size());
+
+    Vector<Value> locals;
+    size_t local_count = arguments.size();
+    for (auto& local : code.locals())
+        local_count += local.n();
+    locals.ensure_capacity(local_count);
+    locals.unchecked_append(arguments.data(), arguments.size());
+    m_value_stack.shrink(m_value_stack.size() - arguments.size(), true);
+    while (locals.size() < local_count)
+        locals.unchecked_append(Value());
+
+    set_frame(Frame {
+        function.module(),
+        move(locals),
+        code.body(),
+        function.type().results().size(),
+    });
+    m_ip = 0;
+    interpreter.interpret(*this);
+}
+
 Result Configuration::execute(Interpreter& interpreter)
 {
     interpreter.interpret(*this);
@@ -57,7 +82,6 @@ Result Configuration::execute(Interpreter& interpreter)
     for (size_t i = 0; i < frame().arity(); ++i)
         results.unchecked_append(value_stack().take_last());
 
-    label_stack().take_last();
     return Result { move(results) };
 }
 
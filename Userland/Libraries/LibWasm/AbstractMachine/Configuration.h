@@ -19,10 +19,10 @@ public:
 
     void set_frame(Frame frame)
     {
-        Label label(frame.arity(), frame.expression().instructions().size(), m_value_stack.size());
-        frame.label_index() = m_label_stack.size();
+        // The validator knows how many values the expression can have on the stack at once, so the interpreter
+        // can push values without checking for room first.
+        m_value_stack.ensure_capacity(m_value_stack.size() + frame.expression().max_stack_height());
         m_frame_stack.append(move(frame));
-        m_label_stack.append(label);
     }
     ALWAYS_INLINE auto& frame() const { return m_frame_stack.last(); }
     ALWAYS_INLINE auto& frame() { return m_frame_stack.last(); }
@@ -32,8 +32,6 @@ public:
     ALWAYS_INLINE auto& depth() { return m_depth; }
     ALWAYS_INLINE auto& value_stack() const { return m_value_stack; }
     ALWAYS_INLINE auto& value_stack() { return m_value_stack; }
-    ALWAYS_INLINE auto& label_stack() const { return m_label_stack; }
-    ALWAYS_INLINE auto& label_stack() { return m_label_stack; }
     ALWAYS_INLINE auto& store() const { return m_store; }
     ALWAYS_INLINE auto& store() { return m_store; }
 
@@ -56,6 +54,9 @@ public:
 
     void unwind(Badge<CallFrameHandle>, CallFrameHandle const&);
     Result call(Interpreter&, FunctionAddress, Vector<Value> arguments);
+    // Like call(), but takes the arguments from the top of the value stack, and leaves the results there.
+    // The caller is responsible for the frame this pushes, through a CallFrameHandle.
+    void call_with_arguments_on_stack(Interpreter&, WasmFunction const&);
     Result execute(Interpreter&);
 
     void enable_instruction_count_limit() { m_should_limit_instruction_count = true; }
@@ -66,7 +67,6 @@ public:
 private:
     Store& m_store;
     Vector<Value> m_value_stack;
-    Vector<Label> m_label_stack;
     Vector<Frame> m_frame_stack;
     size_t m_depth { 0 };
     InstructionPointer m_ip;
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/BitCast.h>
+#include <AK/Platform.h>
+#include <LibWasm/AbstractMachine/GuardPages.h>
+#include <signal.h>
+#include <sys/mman.h>
+
+namespace Wasm {
+
+// The fault handler has to look reservations up without taking locks, so they're kept in a fixed set of slots.
+static constexpr size_t max_reservation_count = 256;
+static Atomic<u8*> s_reservations[max_reservation_count];
+static Atomic<size_t> s_reservation_count { 0 };
+
+static Atomic<bool> s_fault_handler_installed { false };
+static struct sigaction s_previous_segv_action;
+static struct sigaction s_previous_bus_action;
+
+static thread_local sigjmp_buf* s_jump_buffer { nullptr };
+
+static bool is_inside_reservation(FlatPtr address)
+{
+    for (auto& slot : s_reservations) {
+        auto base = bit_cast<FlatPtr>(slot.load(AK::MemoryOrder::memory_order_acquire));
+        if (base != 0 && address >= base && address - base < guarded_memory_reservation_size)
+            return true;
+    }
+    return false;
+}
+
+static void handle_fault(int signal, siginfo_t* info, void* context)
+{
+    if (s_jump_buffer && is_inside_reservation(bit_cast<FlatPtr>(info->si_addr)))
+        siglongjmp(*s_jump_buffer, 1);
+
+    // Not a fault we caused, so let whoever was handling these before deal with it.
+    auto& previous_action = signal == SIGSEGV ? s_previous_segv_action : s_previous_bus_action;
+    if ((previous_action.sa_flags & SA_SIGINFO) && previous_action.sa_sigaction) {
+        previous_action.sa_sigaction(signal, info, context);
+        return;
+    }
+    if (!(previous_action.sa_flags & SA_SIGINFO) && previous_action.sa_handler != SIG_DFL && previous_action.sa_handler != SIG_IGN) {
+        previous_action.sa_handler(signal);
+        return;
+    }
+
+    // Returning re-executes the faulting instruction, which then crashes the way it would have without us.
+    struct sigaction default_action {};
+    default_action.sa_handler = SIG_DFL;
+    sigemptyset(&default_action.sa_mask);
+    sigaction(signal, &default_action, nullptr);
+}
+
+static bool install_fault_handler()
+{
+    if (s_fault_handler_installed.exchange(true))
+        return true;
+
+    struct sigaction action {};
+    action.sa_sigaction = handle_fault;
+    // The handler jumps back into the interpreter without restoring the signal mask, so this signal mustn't be blocked while it runs.
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGSEGV, &action, &s_previous_segv_action) < 0)
+        return false;
+    // Some systems report accesses to PROT_NONE pages as bus errors.
+    if (sigaction(SIGBUS, &action, &s_previous_bus_action) < 0)
+        return false;
+    return true;
+}
+
+u8* reserve_guarded_memory()
+{
+    if constexpr (sizeof(FlatPtr) < sizeof(u64))
+        return nullptr;
+
+#ifdef AK_OS_SERENITY
+    // FIXME: Serenity doesn't report the faulting address in si_addr yet, so we can't tell our faults apart from others.
+    return nullptr;
+#endif
+
+    if (!install_fault_handler())
+        return nullptr;
+
+    auto* base = mmap(nullptr, guarded_memory_reservation_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED)
+        return nullptr;
+
+    for (auto& slot : s_reservations) {
+        u8* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, static_cast<u8*>(base), AK::MemoryOrder::memory_order_acq_rel)) {
+            s_reservation_count.fetch_add(1);
+            return static_cast<u8*>(base);
+        }
+    }
+
+    munmap(base, guarded_memory_reservation_size);
+    return nullptr;
+}
+
+void release_guarded_memory(u8* base)
+{
+    for (auto& slot : s_reservations) {
+        auto* expected = base;
+        if (slot.compare_exchange_strong(expected, nullptr, AK::MemoryOrder::memory_order_acq_rel)) {
+            s_reservation_count.fetch_sub(1);
+            break;
+        }
+    }
+    munmap(base, guarded_memory_reservation_size);
+}
+
+bool commit_guarded_memory(u8* base, size_t committed_size, size_t new_size)
+{
+    VERIFY(committed_size <= new_size);
+    VERIFY(new_size <= guarded_memory_reservation_size);
+    if (committed_size == new_size)
+        return true;
+    // Pages that were never accessible are still untouched, so they read as zero like the spec wants new memory to.
+    return mprotect(base + committed_size, new_size - committed_size, PROT_READ | PROT_WRITE) == 0;
+}
+
+bool guarded_memories_exist()
+{
+    return s_reservation_count.load(AK::MemoryOrder::memory_order_relaxed) != 0;
+}
+
+GuardedMemoryTrapScope::GuardedMemoryTrapScope(sigjmp_buf* jump_buffer)
+    : m_previous_jump_buffer(s_jump_buffer)
+{
+    s_jump_buffer = jump_buffer;
+}
+
+GuardedMemoryTrapScope::~GuardedMemoryTrapScope()
+{
+    s_jump_buffer = m_previous_jump_buffer;
+}
+
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/Types.h>
+#include <setjmp.h>
+
+namespace Wasm {
+
+// Linear memories of kind GuardPages live at the start of a reservation that's large enough to hold the largest memory,
+// followed by enough inaccessible pages that no load or store can reach past its end: an address is a 32-bit base plus a
+// 32-bit offset, and an access is at most 16 bytes wide. Growing such a memory only makes more of the reservation accessible,
+// and the interpreter doesn't bounds check accesses to it; an access that's out of bounds faults instead, and the fault handler
+// turns that into a trap by jumping back to the GuardedMemoryTrapScope of the interpreter that made it.
+static constexpr u64 guarded_memory_reservation_size = 8 * GiB + 64 * KiB;
+
+// Returns nullptr if the address space can't be reserved (e.g. on 32-bit hosts), if too many memories are already reserved,
+// or if faults can't be traced back to a reservation on this system.
+u8* reserve_guarded_memory();
+void release_guarded_memory(u8* base);
+// Makes the first new_size bytes of the reservation accessible; they must have been inaccessible past committed_size.
+bool commit_guarded_memory(u8* base, size_t committed_size, size_t new_size);
+
+// Whether any memory is currently reserved, i.e. whether unchecked accesses can happen at all.
+bool guarded_memories_exist();
+
+// While one of these is the innermost scope on a thread, a fault inside a guarded memory reservation jumps to its buffer.
+// Code that mustn't be jumped out of (e.g. host functions called from wasm) can open a scope without a buffer.
+class GuardedMemoryTrapScope {
+    AK_MAKE_NONCOPYABLE(GuardedMemoryTrapScope);
+    AK_MAKE_NONMOVABLE(GuardedMemoryTrapScope);
+
+public:
+    explicit GuardedMemoryTrapScope(sigjmp_buf* jump_buffer);
+    ~GuardedMemoryTrapScope();
+
+private:
+    sigjmp_buf* m_previous_jump_buffer { nullptr };
+};
+
+}
@@ -6,11 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/BitCast.h>
 #include <AK/BuiltinWrappers.h>
 #include <AK/Result.h>
 #include <AK/SIMD.h>
 #include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <LibWasm/Types.h>
@@ -21,6 +23,45 @@ namespace Wasm::Operators {
 
 using namespace AK::SIMD;
 
+namespace Detail {
+
+template<size_t Offset, SIMDVector V, size_t... Indices>
+ALWAYS_INLINE auto pick_lanes_impl(V vector, IndexSequence<Indices...>)
+{
+    return __builtin_shufflevector(vector, vector, (Offset + Indices)...);
+}
+
+// Returns the `Count` lanes of `vector` starting at lane `Offset` as a vector of their own.
+template<size_t Offset, size_t Count, SIMDVector V>
+ALWAYS_INLINE auto pick_lanes(V vector)
+{
+    return pick_lanes_impl<Offset>(vector, MakeIndexSequence<Count> {});
+}
+
+template<SIMDVector V, size_t... Indices>
+ALWAYS_INLINE auto concatenate_impl(V low, V high, IndexSequence<Indices...>)
+{
+    return __builtin_shufflevector(low, high, Indices...);
+}
+
+// Returns the lanes of `low` followed by the lanes of `high`.
+template<SIMDVector V>
+ALWAYS_INLINE auto concatenate(V low, V high)
+{
+    return concatenate_impl(low, high, MakeIndexSequence<vector_length<V> * 2> {});
+}
+
+// Splits each lane into the two lanes of half the width it is made of, and returns the vectors of the first and second ones,
+// sign- or zero-extended back to the full width. As lanes are little-endian, the first one is in the lower half.
+template<SIMDVector V>
+ALWAYS_INLINE Array<V, 2> split_pairs(V pairs)
+{
+    constexpr auto half_width = sizeof(ElementOf<V>) * 4;
+    return { (pairs << half_width) >> half_width, pairs >> half_width };
+}
+
+}
+
 #define DEFINE_BINARY_OPERATOR(Name, operation) \
     struct Name {                               \
         template<typename Lhs, typename Rhs>    \
@@ -334,16 +375,9 @@ template<size_t VectorSize, typename Op, template<typename> typename SetSign = M
 struct VectorCmpOp {
     auto operator()(u128 c1, u128 c2) const
     {
-        using ElementType = NativeIntegralType<128 / VectorSize>;
-        auto result = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c1);
-        auto other = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c2);
-        Op op;
-        for (size_t i = 0; i < VectorSize; ++i) {
-            SetSign<ElementType> lhs = result[i];
-            SetSign<ElementType> rhs = other[i];
-            result[i] = op(lhs, rhs) ? static_cast<MakeUnsigned<ElementType>>(-1) : 0;
-        }
-        return bit_cast<u128>(result);
+        using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+        // Comparing two vectors already gives all ones for the lanes where the comparison holds, and zero for the others.
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(c1), bit_cast<VectorType>(c2)));
     }
 
     static StringView name()
@@ -367,14 +401,8 @@ template<size_t VectorSize, typename Op>
 struct VectorFloatCmpOp {
     auto operator()(u128 c1, u128 c2) const
     {
-        auto first = bit_cast<NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>>(c1);
-        auto other = bit_cast<NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>>(c2);
-        using ElementType = NativeIntegralType<128 / VectorSize>;
-        Native128ByteVectorOf<ElementType, MakeUnsigned> result;
-        Op op;
-        for (size_t i = 0; i < VectorSize; ++i)
-            result[i] = op(first[i], other[i]) ? static_cast<ElementType>(-1) : 0;
-        return bit_cast<u128>(result);
+        using VectorType = NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(c1), bit_cast<VectorType>(c2)));
     }
 
     static StringView name()
@@ -569,17 +597,9 @@ struct VectorIntegerExtOpPairwise {
     auto operator()(u128 c) const
     {
         using VectorResult = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
-        using VectorInput = NativeVectorType<128 / (VectorSize * 2), VectorSize * 2, SetSign>;
-        auto vector = bit_cast<VectorInput>(c);
-        VectorResult result;
-        Op op;
-
-        // FIXME: Find a way to not loop here
-        for (size_t i = 0; i < VectorSize; ++i) {
-            result[i] = op(vector[i * 2], vector[(i * 2) + 1]);
-        }
-
-        return bit_cast<u128>(result);
+        auto pairs = bit_cast<VectorResult>(c);
+        auto [even, odd] = Detail::split_pairs(pairs);
+        return bit_cast<u128>(Op {}(even, odd));
     }
 
     static StringView name()
@@ -608,20 +628,8 @@ struct VectorIntegerExt {
     {
         using VectorResult = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
         using VectorInput = NativeVectorType<128 / (VectorSize * 2), VectorSize * 2, SetSign>;
-        auto vector = bit_cast<VectorInput>(c);
-        VectorResult result;
-
-        // FIXME: Find a way to not loop here
-        for (size_t i = 0; i < VectorSize; ++i) {
-            if constexpr (Mode == VectorExt::High)
-                result[i] = vector[VectorSize + i];
-            else if constexpr (Mode == VectorExt::Low)
-                result[i] = vector[i];
-            else
-                VERIFY_NOT_REACHED();
-        }
-
-        return bit_cast<u128>(result);
+        constexpr size_t offset = Mode == VectorExt::High ? VectorSize : 0;
+        return bit_cast<u128>(simd_cast<VectorResult>(Detail::pick_lanes<offset, VectorSize>(bit_cast<VectorInput>(c))));
     }
 
     static StringView name()
@@ -645,27 +653,11 @@ struct VectorIntegerExtOp {
     {
         using VectorResult = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
         using VectorInput = NativeVectorType<128 / (VectorSize * 2), VectorSize * 2, SetSign>;
-        auto first = bit_cast<VectorInput>(lhs);
-        auto second = bit_cast<VectorInput>(rhs);
-        VectorResult result;
-        Op op;
-
-        using ResultType = SetSign<NativeIntegralType<128 / VectorSize>>;
-        // FIXME: Find a way to not loop here
-        for (size_t i = 0; i < VectorSize; ++i) {
-            if constexpr (Mode == VectorExt::High) {
-                ResultType a = first[VectorSize + i];
-                ResultType b = second[VectorSize + i];
-                result[i] = op(a, b);
-            } else if constexpr (Mode == VectorExt::Low) {
-                ResultType a = first[i];
-                ResultType b = second[i];
-                result[i] = op(a, b);
-            } else
-                VERIFY_NOT_REACHED();
-        }
-
-        return bit_cast<u128>(result);
+        constexpr size_t offset = Mode == VectorExt::High ? VectorSize : 0;
+        // The lanes are twice as wide as the operands, so the result of the operation always fits.
+        auto first = simd_cast<VectorResult>(Detail::pick_lanes<offset, VectorSize>(bit_cast<VectorInput>(lhs)));
+        auto second = simd_cast<VectorResult>(Detail::pick_lanes<offset, VectorSize>(bit_cast<VectorInput>(rhs)));
+        return bit_cast<u128>(Op {}(first, second));
     }
 
     static StringView name()
@@ -683,22 +675,59 @@ struct VectorIntegerExtOp {
     }
 };
 
+template<typename ResultT, typename Op>
+struct SaturatingOp;
+
+template<typename>
+constexpr bool IsSaturatingAddOrSubtract = false;
+
+template<typename ResultT, typename Op>
+constexpr bool IsSaturatingAddOrSubtract<SaturatingOp<ResultT, Op>> = IsOneOf<Op, Add, Subtract>;
+
 template<size_t VectorSize, typename Op, template<typename> typename SetSign = MakeSigned>
 struct VectorIntegerBinaryOp {
     auto operator()(u128 lhs, u128 rhs) const
     {
         using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+        using ElementType = SetSign<NativeIntegralType<128 / VectorSize>>;
         auto first = bit_cast<VectorType>(lhs);
         auto second = bit_cast<VectorType>(rhs);
-        VectorType result;
-        Op op;
 
-        // FIXME: Find a way to not loop here
-        for (size_t i = 0; i < VectorSize; ++i) {
-            result[i] = op(first[i], second[i]);
+        if constexpr (IsOneOf<Op, Add, Subtract, Multiply, BitAnd, BitOr, BitXor>) {
+            // Lanes wrap around on overflow, which only unsigned lanes are defined to do.
+            using UnsignedVectorType = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
+            return bit_cast<u128>(Op {}(bit_cast<UnsignedVectorType>(lhs), bit_cast<UnsignedVectorType>(rhs)));
+        } else if constexpr (IsSame<Op, Minimum>) {
+            return bit_cast<u128>(first < second ? first : second);
+        } else if constexpr (IsSame<Op, Maximum>) {
+            return bit_cast<u128>(first > second ? first : second);
+        } else if constexpr (IsSame<Op, Average> && IsUnsigned<ElementType>) {
+            // (a + b + 1) / 2, without the intermediate sum overflowing the lane.
+            return bit_cast<u128>((first | second) - ((first ^ second) >> 1));
+        } else if constexpr (IsSaturatingAddOrSubtract<Op>) {
+            using UnsignedVectorType = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
+            constexpr bool is_add = IsSame<typename Op::Operation, Add>;
+            auto wrapped = bit_cast<VectorType>(typename Op::Operation {}(bit_cast<UnsignedVectorType>(lhs), bit_cast<UnsignedVectorType>(rhs)));
+            if constexpr (IsUnsigned<ElementType>) {
+                if constexpr (is_add)
+                    return bit_cast<u128>(wrapped < first ? NumericLimits<ElementType>::max() : wrapped);
+                else
+                    return bit_cast<u128>(first < second ? NumericLimits<ElementType>::min() : wrapped);
+            } else {
+                // The operation overflowed if the sign of the result is wrong, i.e. adding operands of the same sign gave the
+                // other sign, or subtracting a value of the other sign gave the sign of the subtrahend; then it saturates
+                // towards the sign of the first operand.
+                auto overflowed = is_add ? ((first ^ wrapped) & (second ^ wrapped)) < 0 : ((first ^ second) & (first ^ wrapped)) < 0;
+                auto saturated = first < 0 ? NumericLimits<ElementType>::min() : NumericLimits<ElementType>::max();
+                return bit_cast<u128>(overflowed ? saturated : wrapped);
+            }
+        } else {
+            VectorType result;
+            Op op;
+            for (size_t i = 0; i < VectorSize; ++i)
+                result[i] = op(first[i], second[i]);
+            return bit_cast<u128>(result);
         }
-
-        return bit_cast<u128>(result);
     }
 
     static StringView name()
@@ -724,12 +753,18 @@ struct VectorBitmask {
     {
         using VectorType = NativeVectorType<128 / VectorSize, VectorSize, MakeSigned>;
         auto value = bit_cast<VectorType>(lhs);
-        u32 result = 0;
-
-        for (size_t i = 0; i < VectorSize; ++i)
-            result |= static_cast<u32>(value[i] < 0) << i;
 
-        return result;
+        // maskbits() collects the top bit of each lane, which is the sign bit we're after.
+        if constexpr (VectorSize == 16) {
+            return static_cast<u32>(maskbits(bit_cast<i8x16>(value)));
+        } else if constexpr (VectorSize == 4) {
+            return static_cast<u32>(maskbits(bit_cast<i32x4>(value)));
+        } else {
+            u32 result = 0;
+            for (size_t i = 0; i < VectorSize; ++i)
+                result |= static_cast<u32>(value[i] < 0) << i;
+            return result;
+        }
     }
 
     static StringView name() { return "bitmask"sv; }
@@ -739,20 +774,15 @@ template<size_t VectorSize>
 struct VectorDotProduct {
     auto operator()(u128 lhs, u128 rhs) const
     {
-        using VectorInput = NativeVectorType<128 / (VectorSize * 2), VectorSize * 2, MakeSigned>;
         using VectorResult = NativeVectorType<128 / VectorSize, VectorSize, MakeSigned>;
-        auto v1 = bit_cast<VectorInput>(lhs);
-        auto v2 = bit_cast<VectorInput>(rhs);
-        VectorResult result;
-
-        using ResultType = MakeUnsigned<NativeIntegralType<128 / VectorSize>>;
-        for (size_t i = 0; i < VectorSize; ++i) {
-            ResultType low = v1[i * 2] * v2[i * 2];
-            ResultType high = v1[(i * 2) + 1] * v2[(i * 2) + 1];
-            result[i] = low + high;
-        }
+        using UnsignedVectorResult = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
+        auto [lhs_even, lhs_odd] = Detail::split_pairs(bit_cast<VectorResult>(lhs));
+        auto [rhs_even, rhs_odd] = Detail::split_pairs(bit_cast<VectorResult>(rhs));
 
-        return bit_cast<u128>(result);
+        // The products fit, but their sum may not (and then wraps around).
+        auto low = bit_cast<UnsignedVectorResult>(lhs_even * rhs_even);
+        auto high = bit_cast<UnsignedVectorResult>(lhs_odd * rhs_odd);
+        return bit_cast<u128>(low + high);
     }
 
     static StringView name() { return "dot"sv; }
@@ -763,29 +793,14 @@ struct VectorNarrow {
     auto operator()(u128 lhs, u128 rhs) const
     {
         using VectorInput = NativeVectorType<128 / (VectorSize / 2), VectorSize / 2, MakeSigned>;
-        using VectorResult = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
-        auto v1 = bit_cast<VectorInput>(lhs);
-        auto v2 = bit_cast<VectorInput>(rhs);
-        VectorResult result;
+        using VectorHalfResult = NativeVectorType<128 / VectorSize, VectorSize / 2, MakeUnsigned>;
+        using InputElement = MakeSigned<NativeIntegralType<128 / (VectorSize / 2)>>;
+        constexpr auto min = static_cast<InputElement>(NumericLimits<Element>::min());
+        constexpr auto max = static_cast<InputElement>(NumericLimits<Element>::max());
 
-        for (size_t i = 0; i < (VectorSize / 2); ++i) {
-            if (v1[i] <= NumericLimits<Element>::min())
-                result[i] = NumericLimits<Element>::min();
-            else if (v1[i] >= NumericLimits<Element>::max())
-                result[i] = NumericLimits<Element>::max();
-            else
-                result[i] = v1[i];
-        }
-        for (size_t i = 0; i < (VectorSize / 2); ++i) {
-            if (v2[i] <= NumericLimits<Element>::min())
-                result[i + VectorSize / 2] = NumericLimits<Element>::min();
-            else if (v2[i] >= NumericLimits<Element>::max())
-                result[i + VectorSize / 2] = NumericLimits<Element>::max();
-            else
-                result[i + VectorSize / 2] = v2[i];
-        }
-
-        return bit_cast<u128>(result);
+        auto low = simd_cast<VectorHalfResult>(AK::SIMD::clamp(bit_cast<VectorInput>(lhs), min, max));
+        auto high = simd_cast<VectorHalfResult>(AK::SIMD::clamp(bit_cast<VectorInput>(rhs), min, max));
+        return bit_cast<u128>(Detail::concatenate(low, high));
     }
 
     static StringView name() { return "narrow"sv; }
@@ -796,16 +811,24 @@ struct VectorIntegerUnaryOp {
     auto operator()(u128 lhs) const
     {
         using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
-        auto value = bit_cast<VectorType>(lhs);
-        VectorType result;
-        Op op;
-
-        // FIXME: Find a way to not loop here
-        for (size_t i = 0; i < VectorSize; ++i) {
-            result[i] = op(value[i]);
+        using SignedVectorType = NativeVectorType<128 / VectorSize, VectorSize, MakeSigned>;
+        using UnsignedVectorType = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
+
+        if constexpr (IsSame<Op, Negate>) {
+            // Negating the smallest signed value gives itself back, which only unsigned lanes are defined to do.
+            return bit_cast<u128>(-bit_cast<UnsignedVectorType>(lhs));
+        } else if constexpr (IsSame<Op, Absolute>) {
+            auto value = bit_cast<SignedVectorType>(lhs);
+            auto negated = bit_cast<SignedVectorType>(-bit_cast<UnsignedVectorType>(lhs));
+            return bit_cast<u128>(value < 0 ? negated : value);
+        } else {
+            auto value = bit_cast<VectorType>(lhs);
+            VectorType result;
+            Op op;
+            for (size_t i = 0; i < VectorSize; ++i)
+                result[i] = op(value[i]);
+            return bit_cast<u128>(result);
         }
-
-        return bit_cast<u128>(result);
     }
 
     static StringView name()
@@ -832,12 +855,19 @@ struct VectorFloatBinaryOp {
         using VectorType = NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>;
         auto first = bit_cast<VectorType>(lhs);
         auto second = bit_cast<VectorType>(rhs);
-        VectorType result;
-        Op op;
-        for (size_t i = 0; i < VectorSize; ++i) {
-            result[i] = op(first[i], second[i]);
+
+        if constexpr (IsOneOf<Op, Add, Subtract, Multiply, PseudoMinimum, PseudoMaximum>) {
+            return bit_cast<u128>(Op {}(first, second));
+        } else if constexpr (IsSame<Op, Divide>) {
+            return bit_cast<u128>(first / second);
+        } else {
+            // The minimum and maximum of NaNs and zeros don't map to a comparison.
+            VectorType result;
+            Op op;
+            for (size_t i = 0; i < VectorSize; ++i)
+                result[i] = op(first[i], second[i]);
+            return bit_cast<u128>(result);
         }
-        return bit_cast<u128>(result);
     }
 
     static StringView name()
@@ -858,13 +888,23 @@ struct VectorFloatUnaryOp {
     auto operator()(u128 lhs) const
     {
         using VectorType = NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>;
-        auto value = bit_cast<VectorType>(lhs);
-        VectorType result;
-        Op op;
-        for (size_t i = 0; i < VectorSize; ++i) {
-            result[i] = op(value[i]);
+        using BitsVectorType = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
+        using BitsType = NativeIntegralType<128 / VectorSize>;
+        constexpr auto sign_bit = static_cast<BitsType>(1) << (128 / VectorSize - 1);
+
+        // Only the sign bit changes, NaNs included.
+        if constexpr (IsSame<Op, Absolute>) {
+            return bit_cast<u128>(bit_cast<BitsVectorType>(lhs) & static_cast<BitsType>(~sign_bit));
+        } else if constexpr (IsSame<Op, Negate>) {
+            return bit_cast<u128>(bit_cast<BitsVectorType>(lhs) ^ sign_bit);
+        } else {
+            auto value = bit_cast<VectorType>(lhs);
+            VectorType result;
+            Op op;
+            for (size_t i = 0; i < VectorSize; ++i)
+                result[i] = op(value[i]);
+            return bit_cast<u128>(result);
         }
-        return bit_cast<u128>(result);
     }
 
     static StringView name()
@@ -1131,6 +1171,8 @@ struct SaturatingTruncate {
 
 template<typename ResultT, typename Op>
 struct SaturatingOp {
+    using Operation = Op;
+
     template<typename Lhs, typename Rhs>
     ResultT operator()(Lhs lhs, Rhs rhs) const
     {
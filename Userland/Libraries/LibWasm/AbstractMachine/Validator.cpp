@@ -9,6 +9,7 @@
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
+#include <LibWasm/AbstractMachine/Compiler.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
@@ -262,6 +263,8 @@ ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
         auto results = TRY(function_validator.validate(function.body(), function_type.results()));
         if (results.result_types.size() != function_type.results().size())
             return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+
+        function.body().set_compiled_instructions(compile_function_body(function.body(), results.stack_heights, function_type.results().size(), m_context.types));
     }
 
     return {};
@@ -3706,12 +3709,17 @@ ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Ex
         m_frames.empend(FunctionType { {}, result_types }, FrameKind::Function, (size_t)0);
     auto stack = Stack(m_frames);
     bool is_constant_expression = true;
+    Vector<u32> stack_heights;
+    stack_heights.ensure_capacity(expression.instructions().size());
+    size_t max_stack_height = 0;
 
     for (auto& instruction : expression.instructions()) {
+        stack_heights.unchecked_append(stack.size());
         bool is_constant = false;
         TRY(validate(instruction, stack, is_constant));
 
         is_constant_expression &= is_constant;
+        max_stack_height = max(max_stack_height, stack.size());
     }
 
     auto expected_result_types = result_types;
@@ -3723,7 +3731,8 @@ ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Ex
     m_frames.take_last();
     VERIFY(m_frames.is_empty());
 
-    return ExpressionTypeResult { stack.release_vector(), is_constant_expression };
+    expression.set_max_stack_height(max(max_stack_height, result_types.size()));
+    return ExpressionTypeResult { stack.release_vector(), is_constant_expression, move(stack_heights), max_stack_height };
 }
 
 ByteString Validator::Errors::find_instruction_name(SourceLocation const& location)
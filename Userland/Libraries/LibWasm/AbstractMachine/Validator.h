@@ -263,6 +263,9 @@ public:
     struct ExpressionTypeResult {
         Vector<StackEntry> result_types;
         bool is_constant { false };
+        // The height of the stack before each instruction, and the largest it ever gets.
+        Vector<u32> stack_heights;
+        size_t max_stack_height { 0 };
     };
     ErrorOr<ExpressionTypeResult, ValidationError> validate(Expression const&, Vector<ValueType> const&);
     ErrorOr<void, ValidationError> validate(Instruction const& instruction, Stack& stack, bool& is_constant);
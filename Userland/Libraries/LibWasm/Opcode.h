@@ -460,8 +460,21 @@ namespace Instructions {
     ENUMERATE_SINGLE_BYTE_WASM_OPCODES(M) \
     ENUMERATE_MULTI_BYTE_WASM_OPCODES(M)
 
+// These only appear in compiled expressions (see Expression::compiled_instructions()), and never in wasm.
+#define ENUMERATE_SYNTHETIC_INSTRUCTION_OPCODES(M)          \
+    M(synthetic_br, 0xff00000000000000ull)                  \
+    M(synthetic_br_if, 0xff00000000000001ull)               \
+    M(synthetic_br_unless, 0xff00000000000002ull)           \
+    M(synthetic_br_table, 0xff00000000000003ull)            \
+    M(synthetic_local_copy, 0xff00000000000004ull)          \
+    M(synthetic_local_set_i32_const, 0xff00000000000005ull) \
+    M(synthetic_i32_add_locals, 0xff00000000000006ull)      \
+    M(synthetic_i32_add_local_const, 0xff00000000000007ull) \
+    M(synthetic_i32_and_local_const, 0xff00000000000008ull)
+
 #define M(name, value) static constexpr OpCode name = value;
 ENUMERATE_WASM_OPCODES(M)
+ENUMERATE_SYNTHETIC_INSTRUCTION_OPCODES(M)
 #undef M
 
 }
@@ -447,6 +447,15 @@ void Printer::print(Wasm::Instruction const& instruction)
             [&](LabelIndex const& index) { print("(label index {})", index.value()); },
             [&](LocalIndex const& index) { print("(local index {})", index.value()); },
             [&](TableIndex const& index) { print("(table index {})", index.value()); },
+            [&](Instruction::BranchArgs const& args) { print("(branch (target {}) (arity {}) (drop {}))", args.target.value(), args.arity, args.drop_count); },
+            [&](Instruction::BranchTableArgs const& args) {
+                print("(branch_table");
+                for (auto& target : args.targets)
+                    print(" (target {})", target.target.value());
+                print(" (target {}) (arity {}))", args.default_.target.value(), args.default_.arity);
+            },
+            [&](Instruction::LocalAndConstantArgs const& args) { print("(local index {}) (constant {})", args.local.value(), args.constant); },
+            [&](Instruction::LocalPairArgs const& args) { print("(local index {}) (local index {})", args.first.value(), args.second.value()); },
             [&](Instruction::IndirectCallArgs const& args) { print("(indirect (type index {}) (table index {}))", args.type.value(), args.table.value()); },
             [&](Instruction::MemoryArgument const& args) { print("(memory index {} (align {}) (offset {}))", args.memory_index.value(), args.align, args.offset); },
             [&](Instruction::MemoryAndLaneArgument const& args) { print("(memory index {} (align {}) (offset {})) (lane {})", args.memory.memory_index.value(), args.memory.align, args.memory.offset, args.lane); },
@@ -1140,5 +1149,14 @@ HashMap<Wasm::OpCode, ByteString> Wasm::Names::instruction_names {
     { Instructions::f64x2_convert_low_i32x4_u, "f64x2.convert_low_i32x4_u" },
     { Instructions::structured_else, "synthetic:else" },
     { Instructions::structured_end, "synthetic:end" },
+    { Instructions::synthetic_br, "synthetic:br" },
+    { Instructions::synthetic_br_if, "synthetic:br.if" },
+    { Instructions::synthetic_br_unless, "synthetic:br.unless" },
+    { Instructions::synthetic_br_table, "synthetic:br.table" },
+    { Instructions::synthetic_local_copy, "synthetic:local.copy" },
+    { Instructions::synthetic_local_set_i32_const, "synthetic:local.set.i32.const" },
+    { Instructions::synthetic_i32_add_locals, "synthetic:i32.add.locals" },
+    { Instructions::synthetic_i32_add_local_const, "synthetic:i32.add.local.const" },
+    { Instructions::synthetic_i32_and_local_const, "synthetic:i32.and.local.const" },
 };
 HashMap<ByteString, Wasm::OpCode> Wasm::Names::instructions_by_name;
@@ -0,0 +1,105 @@
+// The module exports:
+//   early_return(), which adds 100 to the result of a function that returns with another value below its result
+//   select(index), which br_tables out of three nested blocks (each adding to the value) with 10
+//   sum_to(n), which sums up 1 to n in a loop
+//   fib(n), which recurses, and returns early from inside an if
+//   odd_or_zero(value), which returns the value if it's odd, and 0 otherwise
+//   zero_or_nonzero(value), which returns 1 for zero and 2 otherwise, through a br_if on the value's i32.eqz
+//   double_thrice(), which doubles 1 in a loop that takes the value as a parameter
+// prettier-ignore
+const binary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0a, 0x02, 0x60, 0x00, 0x01, 0x7f, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x09, 0x08, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x07,
+    0x58, 0x07, 0x0c, 0x65, 0x61, 0x72, 0x6c, 0x79, 0x5f, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x00,
+    0x01, 0x06, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x00, 0x02, 0x06, 0x73, 0x75, 0x6d, 0x5f, 0x74,
+    0x6f, 0x00, 0x03, 0x03, 0x66, 0x69, 0x62, 0x00, 0x04, 0x0b, 0x6f, 0x64, 0x64, 0x5f, 0x6f, 0x72,
+    0x5f, 0x7a, 0x65, 0x72, 0x6f, 0x00, 0x05, 0x0f, 0x7a, 0x65, 0x72, 0x6f, 0x5f, 0x6f, 0x72, 0x5f,
+    0x6e, 0x6f, 0x6e, 0x7a, 0x65, 0x72, 0x6f, 0x00, 0x06, 0x0d, 0x64, 0x6f, 0x75, 0x62, 0x6c, 0x65,
+    0x5f, 0x74, 0x68, 0x72, 0x69, 0x63, 0x65, 0x00, 0x07, 0x0a, 0xaa, 0x01, 0x08, 0x07, 0x00, 0x41,
+    0x05, 0x41, 0x07, 0x0f, 0x0b, 0x08, 0x00, 0x41, 0xe4, 0x00, 0x10, 0x00, 0x6a, 0x0b, 0x1d, 0x00,
+    0x02, 0x7f, 0x02, 0x7f, 0x02, 0x7f, 0x41, 0xe3, 0x00, 0x41, 0x0a, 0x20, 0x00, 0x0e, 0x02, 0x00,
+    0x01, 0x02, 0x0b, 0x41, 0x01, 0x6a, 0x0b, 0x41, 0x02, 0x6a, 0x0b, 0x0b, 0x21, 0x01, 0x02, 0x7f,
+    0x41, 0x00, 0x21, 0x01, 0x03, 0x40, 0x20, 0x01, 0x20, 0x00, 0x6a, 0x21, 0x01, 0x20, 0x00, 0x41,
+    0x7f, 0x6a, 0x22, 0x00, 0x0d, 0x00, 0x0b, 0x20, 0x01, 0x21, 0x02, 0x20, 0x02, 0x0b, 0x1c, 0x00,
+    0x20, 0x00, 0x41, 0x02, 0x48, 0x04, 0x40, 0x20, 0x00, 0x0f, 0x0b, 0x20, 0x00, 0x41, 0x7f, 0x6a,
+    0x10, 0x04, 0x20, 0x00, 0x41, 0x7e, 0x6a, 0x10, 0x04, 0x6a, 0x0b, 0x10, 0x00, 0x20, 0x00, 0x41,
+    0x01, 0x71, 0x45, 0x04, 0x7f, 0x41, 0x00, 0x05, 0x20, 0x00, 0x0b, 0x0b, 0x0f, 0x00, 0x02, 0x7f,
+    0x41, 0x01, 0x20, 0x00, 0x45, 0x0d, 0x00, 0x1a, 0x41, 0x02, 0x0b, 0x0b, 0x19, 0x01, 0x01, 0x7f,
+    0x41, 0x03, 0x21, 0x00, 0x41, 0x01, 0x03, 0x01, 0x41, 0x02, 0x6c, 0x20, 0x00, 0x41, 0x01, 0x6b,
+    0x22, 0x00, 0x0d, 0x00, 0x0b, 0x0b,
+]);
+
+const instantiate = () => {
+    const module = parseWebAssemblyModule(binary);
+    const exports = {};
+    for (const name of ["early_return", "select", "sum_to", "fib", "odd_or_zero", "zero_or_nonzero", "double_thrice"]) {
+        const address = module.getExport(name);
+        exports[name] = (...args) => module.invoke(address, ...args);
+    }
+    return exports;
+};
+
+test("return only keeps the function's results", () => {
+    const module = instantiate();
+    expect(module.early_return()).toBe(107);
+});
+
+test("br_table picks the right label, and drops what's below the value", () => {
+    const module = instantiate();
+    expect(module.select(0)).toBe(13);
+    expect(module.select(1)).toBe(12);
+    expect(module.select(2)).toBe(10);
+    expect(module.select(3)).toBe(10);
+    expect(module.select(-1)).toBe(10);
+});
+
+test("loops", () => {
+    const module = instantiate();
+    expect(module.sum_to(1)).toBe(1);
+    expect(module.sum_to(100)).toBe(5050);
+    expect(module.double_thrice()).toBe(8);
+});
+
+test("recursion with early returns", () => {
+    const module = instantiate();
+    expect(module.fib(0)).toBe(0);
+    expect(module.fib(1)).toBe(1);
+    expect(module.fib(20)).toBe(6765);
+});
+
+test("conditions", () => {
+    const module = instantiate();
+    expect(module.odd_or_zero(4)).toBe(0);
+    expect(module.odd_or_zero(5)).toBe(5);
+    expect(module.odd_or_zero(-3)).toBe(-3);
+    expect(module.zero_or_nonzero(0)).toBe(1);
+    expect(module.zero_or_nonzero(3)).toBe(2);
+    expect(module.zero_or_nonzero(-1)).toBe(2);
+});
+
+// The module exports eqz_if_then_br_if(value, condition), which is
+//   block (result i32)
+//     i32.const 7 local.get 0 local.get 1
+//     if (param i32) (result i32) i32.eqz end
+//     br_if 0 drop i32.const 9
+//   end
+// The i32.eqz at the end of the if body must not be fused with the br_if after it,
+// since the br_if is also reached without running the body.
+// prettier-ignore
+const ifWithoutElseBinary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x02, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x60, 0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x01, 0x07, 0x15, 0x01, 0x11, 0x65, 0x71,
+    0x7a, 0x5f, 0x69, 0x66, 0x5f, 0x74, 0x68, 0x65, 0x6e, 0x5f, 0x62, 0x72, 0x5f, 0x69, 0x66, 0x00,
+    0x00, 0x0a, 0x16, 0x01, 0x14, 0x00, 0x02, 0x7f, 0x41, 0x07, 0x20, 0x00, 0x20, 0x01, 0x04, 0x00,
+    0x45, 0x0b, 0x0d, 0x00, 0x1a, 0x41, 0x09, 0x0b, 0x0b,
+]);
+
+test("an if without an else ends in a branch target", () => {
+    const module = parseWebAssemblyModule(ifWithoutElseBinary);
+    const eqzIfThenBrIf = (value, condition) =>
+        module.invoke(module.getExport("eqz_if_then_br_if"), value, condition);
+    expect(eqzIfThenBrIf(0, 1)).toBe(7);
+    expect(eqzIfThenBrIf(0, 0)).toBe(9);
+    expect(eqzIfThenBrIf(5, 0)).toBe(7);
+    expect(eqzIfThenBrIf(5, 1)).toBe(9);
+});
@@ -0,0 +1,94 @@
+// The module has a memory of 1 to 4 pages, and exports:
+//   load(address) and store(address, value), which access an i32
+//   load8(address), which loads a u8
+//   load_far(address) and store_far(address), which access an i64 at offset 0xffffffff
+//   load_v128(address), which loads a v128 and returns its last i32 lane
+//   size() and grow(pages)
+// prettier-ignore
+const binary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x18, 0x05, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x60, 0x02, 0x7f, 0x7f, 0x00, 0x60, 0x01, 0x7f, 0x01, 0x7e, 0x60, 0x01, 0x7f, 0x00, 0x60, 0x00,
+    0x01, 0x7f, 0x03, 0x09, 0x08, 0x00, 0x01, 0x00, 0x02, 0x03, 0x00, 0x04, 0x00, 0x05, 0x04, 0x01,
+    0x01, 0x01, 0x04, 0x07, 0x49, 0x08, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x00, 0x05, 0x73, 0x74,
+    0x6f, 0x72, 0x65, 0x00, 0x01, 0x05, 0x6c, 0x6f, 0x61, 0x64, 0x38, 0x00, 0x02, 0x08, 0x6c, 0x6f,
+    0x61, 0x64, 0x5f, 0x66, 0x61, 0x72, 0x00, 0x03, 0x09, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x5f, 0x66,
+    0x61, 0x72, 0x00, 0x04, 0x09, 0x6c, 0x6f, 0x61, 0x64, 0x5f, 0x76, 0x31, 0x32, 0x38, 0x00, 0x05,
+    0x04, 0x73, 0x69, 0x7a, 0x65, 0x00, 0x06, 0x04, 0x67, 0x72, 0x6f, 0x77, 0x00, 0x07, 0x0a, 0x4d,
+    0x08, 0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0b, 0x09, 0x00, 0x20, 0x00, 0x20, 0x01, 0x36,
+    0x02, 0x00, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x2d, 0x00, 0x00, 0x0b, 0x0b, 0x00, 0x20, 0x00, 0x29,
+    0x03, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x0b, 0x0d, 0x00, 0x20, 0x00, 0x42, 0x01, 0x37, 0x03, 0xff,
+    0xff, 0xff, 0xff, 0x0f, 0x0b, 0x0b, 0x00, 0x20, 0x00, 0xfd, 0x00, 0x04, 0x00, 0xfd, 0x1b, 0x03,
+    0x0b, 0x04, 0x00, 0x3f, 0x00, 0x0b, 0x06, 0x00, 0x20, 0x00, 0x40, 0x00, 0x0b,
+]);
+
+const instantiate = () => {
+    const module = parseWebAssemblyModule(binary);
+    const exports = {};
+    for (const name of ["load", "store", "load8", "load_far", "store_far", "load_v128", "size", "grow"]) {
+        const address = module.getExport(name);
+        exports[name] = (...args) => module.invoke(address, ...args);
+    }
+    return exports;
+};
+
+const outOfBounds = "Execution trapped: Memory access out of bounds";
+
+test("memory starts out zeroed and keeps what's stored", () => {
+    const memory = instantiate();
+    expect(memory.load(0)).toBe(0);
+    expect(memory.load(65532)).toBe(0);
+    memory.store(65532, 0x12345678);
+    expect(memory.load(65532)).toBe(0x12345678);
+    expect(memory.load8(65535)).toBe(0x12);
+    expect(memory.load_v128(65520)).toBe(0x12345678);
+});
+
+test("accesses past the end trap", () => {
+    const memory = instantiate();
+    expect(() => memory.load(65533)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => memory.store(65536, 1)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => memory.load8(65536)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => memory.load_v128(65521)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => memory.load_far(0)).toThrowWithMessage(TypeError, outOfBounds);
+    expect(() => memory.store_far(-1)).toThrowWithMessage(TypeError, outOfBounds);
+
+    // A trap doesn't leave the memory (or the interpreter) in a broken state.
+    memory.store(0, 42);
+    expect(memory.load(0)).toBe(42);
+});
+
+test("growing keeps the contents and makes the new pages accessible", () => {
+    const memory = instantiate();
+    memory.store(65532, 0x12345678);
+    expect(memory.size()).toBe(1);
+    expect(memory.grow(1)).toBe(1);
+    expect(memory.size()).toBe(2);
+    expect(memory.load(65532)).toBe(0x12345678);
+    expect(memory.load(65536)).toBe(0);
+    memory.store(131068, 7);
+    expect(memory.load(131068)).toBe(7);
+    expect(() => memory.load(131069)).toThrowWithMessage(TypeError, outOfBounds);
+
+    expect(memory.grow(3)).toBe(-1);
+    expect(memory.size()).toBe(2);
+    expect(memory.grow(2)).toBe(2);
+    expect(memory.size()).toBe(4);
+    expect(memory.load(131068)).toBe(7);
+    expect(memory.load(262140)).toBe(0);
+    expect(() => memory.load(262141)).toThrowWithMessage(TypeError, outOfBounds);
+});
+
+test("memories still work once no more address space can be reserved for guard pages", () => {
+    // Every instantiated memory stays alive, so these run out of reservations and fall back to bounds checked memories.
+    const memories = [];
+    for (let i = 0; i < 300; ++i) {
+        const memory = instantiate();
+        memory.store(65532, i);
+        memories.push(memory);
+    }
+    for (let i = 0; i < memories.length; ++i) {
+        expect(memories[i].load(65532)).toBe(i);
+        expect(() => memories[i].load(65533)).toThrowWithMessage(TypeError, outOfBounds);
+        expect(() => memories[i].load_far(0)).toThrowWithMessage(TypeError, outOfBounds);
+    }
+});
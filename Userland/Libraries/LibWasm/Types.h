@@ -442,6 +442,29 @@ public:
         MemoryIndex memory_index;
     };
 
+    // The arguments of synthetic instructions, see Expression::compiled_instructions().
+    struct BranchArgs {
+        InstructionPointer target;
+        // The values the branch passes to its target stay on top of the stack, the ones between them and the target's stack height are dropped.
+        u32 arity { 0 };
+        u32 drop_count { 0 };
+    };
+
+    struct BranchTableArgs {
+        Vector<BranchArgs> targets;
+        BranchArgs default_;
+    };
+
+    struct LocalAndConstantArgs {
+        LocalIndex local;
+        i32 constant;
+    };
+
+    struct LocalPairArgs {
+        LocalIndex first;
+        LocalIndex second;
+    };
+
     struct ShuffleArgument {
         explicit ShuffleArgument(u8 (&lanes)[16])
             : lanes {
@@ -471,6 +494,8 @@ private:
     OpCode m_opcode { 0 };
     Variant<
         BlockType,
+        BranchArgs,
+        BranchTableArgs,
         DataIndex,
         ElementIndex,
         FunctionIndex,
@@ -478,7 +503,9 @@ private:
         IndirectCallArgs,
         LabelIndex,
         LaneIndex,
+        LocalAndConstantArgs,
         LocalIndex,
+        LocalPairArgs,
         MemoryArgument,
         MemoryAndLaneArgument,
         MemoryCopyArgs,
@@ -706,10 +733,22 @@ public:
 
     auto& instructions() const { return m_instructions; }
 
+    // The instructions the interpreter runs. Validating a function body compiles it into these: structured control flow is
+    // replaced by branches to resolved targets, and some common sequences of instructions are fused into one.
+    // Expressions that weren't compiled (i.e. constant expressions, which have no control flow) are run as they are.
+    auto& compiled_instructions() const { return m_compiled_instructions.has_value() ? *m_compiled_instructions : m_instructions; }
+    void set_compiled_instructions(Vector<Instruction> instructions) const { m_compiled_instructions = move(instructions); }
+
+    // The most values running the expression ever has on the stack at once.
+    size_t max_stack_height() const { return m_max_stack_height.value_or(m_instructions.size()); }
+    void set_max_stack_height(size_t height) const { m_max_stack_height = height; }
+
     static ParseResult<Expression> parse(Stream& stream, Optional<size_t> size_hint = {});
 
 private:
     Vector<Instruction> m_instructions;
+    mutable Optional<Vector<Instruction>> m_compiled_instructions;
+    mutable Optional<size_t> m_max_stack_height;
 };
 
 class GlobalSection {
@@ -16,11 +16,14 @@ namespace Web::Bindings {
 PlatformObject::PlatformObject(JS::Realm& realm, MayInterfereWithIndexedPropertyAccess may_interfere_with_indexed_property_access)
     : JS::Object(realm, nullptr, may_interfere_with_indexed_property_access)
 {
+    // NOTE: Legacy platform objects may have named property setters, which the inline caches for [[Set]] must not skip.
+    m_may_interfere_with_named_property_access = true;
 }
 
 PlatformObject::PlatformObject(JS::Object& prototype, MayInterfereWithIndexedPropertyAccess may_interfere_with_indexed_property_access)
     : JS::Object(ConstructWithPrototypeTag::Tag, prototype, may_interfere_with_indexed_property_access)
 {
+    m_may_interfere_with_named_property_access = true;
 }
 
 PlatformObject::~PlatformObject() = default;
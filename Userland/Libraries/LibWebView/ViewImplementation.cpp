@@ -628,6 +628,25 @@ ErrorOr<LexicalPath> ViewImplementation::dump_gc_graph()
     return path;
 }
 
+void ViewImplementation::start_js_profiling(Duration sample_interval)
+{
+    client().async_start_js_profiling(page_id(), sample_interval.to_microseconds());
+}
+
+ErrorOr<LexicalPath> ViewImplementation::dump_js_profile()
+{
+    auto promise = request_internal_page_info(PageInfoType::JSProfile);
+    auto collapsed_stacks = TRY(promise->await());
+
+    LexicalPath path { Core::StandardPaths::tempfile_directory() };
+    path = path.append(TRY(Core::DateTime::now().to_string("js-profile-%Y-%m-%d-%H-%M-%S.folded"sv)));
+
+    auto dump_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+    TRY(dump_file->write_until_depleted(collapsed_stacks.bytes()));
+
+    return path;
+}
+
 void ViewImplementation::set_user_style_sheet(String source)
 {
     client().async_set_user_style(page_id(), move(source));
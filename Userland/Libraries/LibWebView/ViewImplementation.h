@@ -140,6 +140,9 @@ public:
 
     ErrorOr<LexicalPath> dump_gc_graph();
 
+    void start_js_profiling(Duration sample_interval);
+    ErrorOr<LexicalPath> dump_js_profile();
+
     void set_user_style_sheet(String source);
     // Load Native.css as the User style sheet, which attempts to make WebView content look as close to
     // native GUI widgets as possible.
@@ -271,7 +271,7 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString const& metho
 
     auto headers = request_headers;
     if (!headers.contains("Accept-Encoding"))
-        headers.set("Accept-Encoding", "gzip, deflate, br");
+        headers.set("Accept-Encoding", "gzip, deflate, br, zstd");
 
     enqueue(StartRequest {
         .request_id = request_id,
@@ -10,11 +10,14 @@
  */
 
 #include <AK/JsonObject.h>
+#include <AK/MemoryStream.h>
 #include <AK/QuickSort.h>
 #include <LibCore/EventLoop.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/SystemTheme.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Profiler.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibWeb/ARIA/RoleType.h>
@@ -931,6 +934,24 @@ static void append_gc_graph(StringBuilder& builder)
     gc_graph.serialize(builder);
 }
 
+static void append_js_profile(StringBuilder& builder, WebView::PageInfoType type)
+{
+    auto* profiler = Web::Bindings::main_thread_vm().bytecode_interpreter().profiler();
+    if (!profiler) {
+        builder.append("(not profiling)"sv);
+        return;
+    }
+
+    AllocatingMemoryStream stream;
+    if (type == WebView::PageInfoType::JSProfile)
+        MUST(profiler->write_collapsed_stacks(stream));
+    else
+        MUST(profiler->write_instruction_statistics(stream));
+
+    auto buffer = MUST(stream.read_until_eof());
+    builder.append(StringView { buffer });
+}
+
 void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::PageInfoType type)
 {
     auto page = this->page(page_id);
@@ -963,9 +984,28 @@ void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::Page
         append_gc_graph(builder);
     }
 
+    if (has_flag(type, WebView::PageInfoType::JSProfile)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        append_js_profile(builder, WebView::PageInfoType::JSProfile);
+    }
+
+    if (has_flag(type, WebView::PageInfoType::JSInstructionStatistics)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        append_js_profile(builder, WebView::PageInfoType::JSInstructionStatistics);
+    }
+
     async_did_get_internal_page_info(page_id, type, MUST(builder.to_string()));
 }
 
+void ConnectionFromClient::start_js_profiling(u64, u64 sample_interval_in_microseconds)
+{
+    // All pages share the main thread's VM, so there is only one interpreter to profile.
+    auto sample_interval = Duration::from_microseconds(max<u64>(sample_interval_in_microseconds, 1));
+    Web::Bindings::main_thread_vm().bytecode_interpreter().start_profiling(sample_interval);
+}
+
 Messages::WebContentServer::GetSelectedTextResponse ConnectionFromClient::get_selected_text(u64 page_id)
 {
     if (auto page = this->page(page_id); page.has_value())
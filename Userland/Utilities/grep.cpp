@@ -234,23 +234,34 @@ ErrorOr<int> serenity_main(Main::Arguments args)
         options |= PosixFlags::Insensitive;
 
     auto grep_logic = [&](auto&& regular_expressions) {
-        for (auto& re : regular_expressions) {
+        for (size_t i = 0; i < regular_expressions.size(); ++i) {
+            auto& re = regular_expressions[i];
             if (re.parser_result.error != regex::Error::NoError) {
                 warnln("regex parse error: {}", regex::get_error_string(re.parser_result.error));
                 return ExitStatus::ErrorOccurred;
             }
         }
 
+        // The line is reported for the first pattern that matches it (or doesn't, with -v).
+        auto first_reported_pattern = [&](StringView str) -> Optional<size_t> {
+            if (!invert_match)
+                return regular_expressions.first_match(str);
+
+            auto matching_patterns = regular_expressions.matches(str);
+            for (size_t i = 0; i < regular_expressions.size(); ++i) {
+                if (i >= matching_patterns.size() || matching_patterns[i] != i)
+                    return i;
+            }
+            return {};
+        };
+
         auto matches = [&](StringView str, StringView filename, size_t line_number, bool print_filename, bool is_binary) {
             size_t last_printed_char_pos { 0 };
             if (is_binary && binary_mode == BinaryFileMode::Skip)
                 return false;
 
-            for (auto& re : regular_expressions) {
-                auto result = re.match(str, PosixFlags::Global);
-                if (!(result.success ^ invert_match))
-                    continue;
-
+            // All patterns are looked for at once, and only the one that gets reported is run again to find where it matched.
+            if (auto index = first_reported_pattern(str); index.has_value()) {
                 if (quiet_mode)
                     return true;
 
@@ -270,6 +281,10 @@ ErrorOr<int> serenity_main(Main::Arguments args)
                     if (line_numbers)
                         print_type |= PrintType::LineNumbers;
 
+                    RegexResult result;
+                    if (!invert_match)
+                        result = regular_expressions[*index].match(str, PosixFlags::Global);
+
                     if ((result.matches.size() || invert_match) && has_any_flag(print_type, PrintType::Path | PrintType::LineNumbers)) {
                         StringBuilder filename_builder;
                         append_formatted_path(filename_builder, filename, line_number, print_type, !disable_hyperlinks, colored_output);
@@ -373,18 +388,14 @@ ErrorOr<int> serenity_main(Main::Arguments args)
     };
 
     if (use_ere) {
-        Vector<Regex<PosixExtended>> regular_expressions;
-        for (auto pattern : patterns) {
-            auto escaped_pattern = (fixed_strings) ? escape_characters(pattern, ere_special_characters) : pattern;
-            regular_expressions.append(Regex<PosixExtended>(escaped_pattern, options));
-        }
-        return to_underlying(grep_logic(regular_expressions));
+        Vector<ByteString> escaped_patterns;
+        for (auto pattern : patterns)
+            escaped_patterns.append((fixed_strings) ? escape_characters(pattern, ere_special_characters) : pattern);
+        return to_underlying(grep_logic(RegexSet<PosixExtended>(move(escaped_patterns), options)));
     }
 
-    Vector<Regex<PosixBasic>> regular_expressions;
-    for (auto pattern : patterns) {
-        auto escaped_pattern = (fixed_strings) ? escape_characters(pattern, basic_special_characters) : pattern;
-        regular_expressions.append(Regex<PosixBasic>(escaped_pattern, options));
-    }
-    return to_underlying(grep_logic(regular_expressions));
+    Vector<ByteString> escaped_patterns;
+    for (auto pattern : patterns)
+        escaped_patterns.append((fixed_strings) ? escape_characters(pattern, basic_special_characters) : pattern);
+    return to_underlying(grep_logic(RegexSet<PosixBasic>(move(escaped_patterns), options)));
 }
@@ -20,11 +20,29 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool keep_input_files { false };
     bool write_to_stdout { false };
     bool decompress { false };
+    size_t thread_count { 1 };
+    auto compression_level = Compress::DeflateCompressor::CompressionLevel::GOOD;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(keep_input_files, "Keep (don't delete) input files", "keep", 'k');
     args_parser.add_option(write_to_stdout, "Write to stdout, keep original files unchanged", "stdout", 'c');
     args_parser.add_option(decompress, "Decompress", "decompress", 'd');
+    args_parser.add_option(thread_count, "Compress on this many threads into a single member (0 for one per core)", "threads", 'T', "count");
+    for (char level = '1'; level <= '9'; ++level) {
+        auto is_fastest = level == '1';
+        auto is_best = level == '9';
+        args_parser.add_option(Core::ArgsParser::Option {
+            .argument_mode = Core::ArgsParser::OptionArgumentMode::None,
+            .help_string = is_fastest ? "Compress faster (-2 to -8 select the levels in between)" : (is_best ? "Compress better" : "Set the compression level"),
+            .long_name = is_fastest ? "fast" : (is_best ? "best" : nullptr),
+            .short_name = level,
+            .accept_value = [&compression_level, level](auto) -> bool {
+                compression_level = static_cast<Compress::DeflateCompressor::CompressionLevel>(level - '0');
+                return true;
+            },
+            .hide_mode = is_fastest || is_best ? Core::ArgsParser::OptionHideMode::None : Core::ArgsParser::OptionHideMode::CommandLineAndMarkdown,
+        });
+    }
     args_parser.add_positional_argument(filenames, "Files", "FILES", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -71,10 +89,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         // Buffer reads, which yields a significant performance improvement.
         NonnullOwnPtr<Stream> input_stream = TRY(Core::InputBufferedFile::create(move(input_file), 1 * MiB));
 
+        Compress::ParallelGzipCompressor* parallel_compressor = nullptr;
         if (decompress) {
             input_stream = TRY(try_make<Compress::GzipDecompressor>(move(input_stream)));
+        } else if (thread_count == 1) {
+            output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull(), compression_level));
         } else {
-            output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull()));
+            auto compressor = TRY(Compress::ParallelGzipCompressor::construct(output_stream.release_nonnull(), thread_count, compression_level));
+            parallel_compressor = compressor.ptr();
+            output_stream = move(compressor);
         }
 
         auto buffer = TRY(ByteBuffer::create_uninitialized(1 * MiB));
@@ -84,6 +107,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             TRY(output_stream->write_until_depleted(span));
         }
 
+        if (parallel_compressor)
+            TRY(parallel_compressor->finish());
+
         if (!keep_input_files)
             TRY(Core::System::unlink(input_filename));
     }
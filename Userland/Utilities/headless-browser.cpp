@@ -189,7 +189,24 @@ private:
     RefPtr<Protocol::RequestClient> m_request_client;
 };
 
-static ErrorOr<NonnullRefPtr<Core::Timer>> load_page_for_screenshot_and_exit(Core::EventLoop& event_loop, HeadlessWebContentView& view, URL::URL url, int screenshot_timeout)
+static void dump_js_profile(HeadlessWebContentView& view)
+{
+    auto path = view.dump_js_profile();
+    if (path.is_error()) {
+        warnln("Failed to dump JS profile: {}", path.error());
+        return;
+    }
+    outln("JS profile dumped to {}", path.value());
+
+    auto instruction_statistics = view.request_internal_page_info(WebView::PageInfoType::JSInstructionStatistics)->await();
+    if (instruction_statistics.is_error()) {
+        warnln("Failed to get JS instruction statistics: {}", instruction_statistics.error());
+        return;
+    }
+    out("{}", instruction_statistics.value());
+}
+
+static ErrorOr<NonnullRefPtr<Core::Timer>> load_page_for_screenshot_and_exit(Core::EventLoop& event_loop, HeadlessWebContentView& view, URL::URL url, int screenshot_timeout, bool profile_js)
 {
     // FIXME: Allow passing the output path as an argument.
     static constexpr auto output_file_path = "output.png"sv;
@@ -212,6 +229,9 @@ static ErrorOr<NonnullRefPtr<Core::Timer>> load_page_for_screenshot_and_exit(Cor
                 warnln("No screenshot available");
             }
 
+            if (profile_js)
+                dump_js_profile(view);
+
             event_loop.quit(0);
         });
 
@@ -540,7 +560,7 @@ static ErrorOr<void> collect_ref_tests(Vector<Test>& tests, StringView path)
     return {};
 }
 
-static ErrorOr<int> run_tests(HeadlessWebContentView& view, StringView test_root_path, StringView test_glob, bool dump_failed_ref_tests, bool dump_gc_graph)
+static ErrorOr<int> run_tests(HeadlessWebContentView& view, StringView test_root_path, StringView test_glob, bool dump_failed_ref_tests, bool dump_gc_graph, bool profile_js)
 {
     view.clear_content_filters();
 
@@ -623,6 +643,9 @@ static ErrorOr<int> run_tests(HeadlessWebContentView& view, StringView test_root
         }
     }
 
+    if (profile_js)
+        dump_js_profile(view);
+
     if (timeout_count == 0 && fail_count == 0)
         return 0;
     return 1;
@@ -640,6 +663,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool dump_layout_tree = false;
     bool dump_text = false;
     bool dump_gc_graph = false;
+    bool profile_js = false;
+    size_t profile_js_interval_in_microseconds = 1000;
     bool is_layout_test_mode = false;
     StringView test_root_path;
     ByteString test_glob;
@@ -659,6 +684,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(test_glob, "Only run tests matching the given glob", "filter", 'f', "glob");
     args_parser.add_option(dump_failed_ref_tests, "Dump screenshots of failing ref tests", "dump-failed-ref-tests", 'D');
     args_parser.add_option(dump_gc_graph, "Dump GC graph", "dump-gc-graph", 'G');
+    args_parser.add_option(profile_js, "Profile JavaScript, then dump the sampled call stacks in the collapsed stack format", "profile-js", {});
+    args_parser.add_option(profile_js_interval_in_microseconds, "How often to sample the JavaScript call stack (default: 1000)", "profile-js-interval", {}, "microseconds");
     args_parser.add_option(resources_folder, "Path of the base resources folder (defaults to /res)", "resources", 'r', "resources-root-path");
     args_parser.add_option(web_driver_ipc_path, "Path to the WebDriver IPC socket", "webdriver-ipc-path", 0, "path");
     args_parser.add_option(is_layout_test_mode, "Enable layout test mode", "layout-test-mode");
@@ -687,9 +714,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     command_line_builder.join(' ', arguments.strings);
     auto view = TRY(HeadlessWebContentView::create(move(theme), window_size, MUST(command_line_builder.to_string()), web_driver_ipc_path, is_layout_test_mode ? Ladybird::IsLayoutTestMode::Yes : Ladybird::IsLayoutTestMode::No, certificates, resources_folder));
 
+    if (profile_js)
+        view->start_js_profiling(Duration::from_microseconds(profile_js_interval_in_microseconds));
+
     if (!test_root_path.is_empty()) {
         test_glob = ByteString::formatted("*{}*", test_glob);
-        return run_tests(*view, test_root_path, test_glob, dump_failed_ref_tests, dump_gc_graph);
+        return run_tests(*view, test_root_path, test_glob, dump_failed_ref_tests, dump_gc_graph, profile_js);
     }
 
     auto url = WebView::sanitize_url(raw_url);
@@ -700,16 +730,20 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (dump_layout_tree) {
         TRY(run_dump_test(*view, raw_url, ""sv, TestMode::Layout));
+        if (profile_js)
+            dump_js_profile(*view);
         return 0;
     }
 
     if (dump_text) {
         TRY(run_dump_test(*view, raw_url, ""sv, TestMode::Text));
+        if (profile_js)
+            dump_js_profile(*view);
         return 0;
     }
 
     if (web_driver_ipc_path.is_empty()) {
-        auto timer = TRY(load_page_for_screenshot_and_exit(event_loop, *view, url.value(), screenshot_timeout));
+        auto timer = TRY(load_page_for_screenshot_and_exit(event_loop, *view, url.value(), screenshot_timeout, profile_js));
         return event_loop.exec();
     }
 
@@ -16,6 +16,7 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Profiler.h>
 #include <LibJS/Console.h>
 #include <LibJS/Contrib/Test262/GlobalObject.h>
 #include <LibJS/Parser.h>
@@ -53,6 +54,7 @@ public:
 private:
     JS_DECLARE_NATIVE_FUNCTION(exit_interpreter);
     JS_DECLARE_NATIVE_FUNCTION(repl_help);
+    JS_DECLARE_NATIVE_FUNCTION(inline_cache_stats);
     JS_DECLARE_NATIVE_FUNCTION(save_to_file);
     JS_DECLARE_NATIVE_FUNCTION(load_ini);
     JS_DECLARE_NATIVE_FUNCTION(load_json);
@@ -328,6 +330,7 @@ void ReplObject::initialize(JS::Realm& realm)
     u8 attr = JS::Attribute::Configurable | JS::Attribute::Writable | JS::Attribute::Enumerable;
     define_native_function(realm, "exit", exit_interpreter, 0, attr);
     define_native_function(realm, "help", repl_help, 0, attr);
+    define_native_function(realm, "inlineCacheStats", inline_cache_stats, 0, attr);
     define_native_function(realm, "save", save_to_file, 1, attr);
     define_native_function(realm, "loadINI", load_ini, 1, attr);
     define_native_function(realm, "loadJSON", load_json, 1, attr);
@@ -379,6 +382,7 @@ JS_DEFINE_NATIVE_FUNCTION(ReplObject::repl_help)
     warnln("REPL commands:");
     warnln("    exit(code): exit the REPL with specified code. Defaults to 0.");
     warnln("    help(): display this menu");
+    warnln("    inlineCacheStats(): display how often property accesses hit their inline caches.");
     warnln("    loadINI(file): load the given file as INI.");
     warnln("    loadJSON(file): load the given file as JSON.");
     warnln("    print(value): pretty-print the given JS value.");
@@ -386,6 +390,21 @@ JS_DEFINE_NATIVE_FUNCTION(ReplObject::repl_help)
     return JS::js_undefined();
 }
 
+JS_DEFINE_NATIVE_FUNCTION(ReplObject::inline_cache_stats)
+{
+    auto const& statistics = JS::Bytecode::g_inline_cache_statistics;
+    auto print_line = [](StringView name, u64 hits, u64 misses) {
+        auto total = hits + misses;
+        outln("{:>12}: {:>10} hits, {:>10} misses ({}% hit rate)", name, hits, misses, total ? hits * 100 / total : 0);
+    };
+    print_line("get"sv, statistics.get_own_property_hits + statistics.get_prototype_chain_hits, statistics.get_misses);
+    outln("{:>12}  {:>10} own property, {:>10} prototype chain", ""sv, statistics.get_own_property_hits, statistics.get_prototype_chain_hits);
+    print_line("put"sv, statistics.put_existing_property_hits + statistics.put_new_property_hits, statistics.put_misses);
+    outln("{:>12}  {:>10} existing property, {:>10} new property", ""sv, statistics.put_existing_property_hits, statistics.put_new_property_hits);
+    print_line("get global"sv, statistics.get_global_hits, statistics.get_global_misses);
+    return JS::js_undefined();
+}
+
 JS_DEFINE_NATIVE_FUNCTION(ReplObject::load_ini)
 {
     return load_ini_impl(vm);
@@ -533,14 +552,36 @@ private:
     int m_group_stack_depth { 0 };
 };
 
+static ErrorOr<void> write_profile(StringView path)
+{
+    auto profiler = g_vm->bytecode_interpreter().stop_profiling();
+    if (!profiler)
+        return {};
+
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write));
+    TRY(profiler->write_collapsed_stacks(*file));
+    warnln("Wrote {} samples of the call stack to {}", profiler->sample_count(), path);
+
+    auto standard_error = TRY(Core::File::standard_error());
+    TRY(profiler->write_instruction_statistics(*standard_error));
+    return {};
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction map_fixed"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction map_fixed prot_exec thread"));
+    // With prot_exec pledged, the JIT can map the code it generates as executable.
+    JS::Bytecode::g_disable_jit = false;
 
     bool gc_on_every_allocation = false;
+    bool generational_gc = false;
+    bool incremental_gc = false;
+    size_t gc_marking_threads = 1;
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
+    StringView profile_path;
+    size_t profile_interval_in_microseconds = JS::Bytecode::Profiler::default_sample_interval.to_microseconds();
     StringView evaluate_script;
     Vector<StringView> script_paths;
 
@@ -548,11 +589,19 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::Bytecode::g_dump_bytecode_passes, "Dump the bytecode before and after optimization, with per-pass timings", "dump-bytecode-passes", {});
+    args_parser.add_option(JS::Bytecode::g_disable_bytecode_optimizations, "Don't optimize the generated bytecode", "disable-bytecode-optimizations", {});
+    args_parser.add_option(JS::Bytecode::g_disable_jit, "Run everything in the bytecode interpreter", "disable-jit", {});
+    args_parser.add_option(profile_path, "Sample the call stack and write it to a file in the collapsed stack format, and print per-instruction statistics", "profile", {}, "path");
+    args_parser.add_option(profile_interval_in_microseconds, "How often to sample the call stack while profiling", "profile-interval", {}, "microseconds");
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(generational_gc, "Use generational garbage collection", "generational-gc", {});
+    args_parser.add_option(incremental_gc, "Mark the heap incrementally, interleaved with the program", "incremental-gc", {});
+    args_parser.add_option(gc_marking_threads, "Number of threads to mark the heap with", "gc-marking-threads", {}, "count");
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
@@ -569,6 +618,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     g_vm = g_vm_storage->ptr();
     g_vm->set_dynamic_imports_allowed(true);
 
+    if (!profile_path.is_empty())
+        g_vm->bytecode_interpreter().start_profiling(Duration::from_microseconds(max(profile_interval_in_microseconds, 1uz)));
+
     if (!disable_debug_printing) {
         // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
         // which is, as far as I can tell, correct - a promise is created, rejected without handler, and a
@@ -600,6 +652,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         ReplConsoleClient console_client(console_object.console());
         console_object.console().set_client(console_client);
         g_vm->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        g_vm->heap().set_generational_collection_enabled(generational_gc);
+        g_vm->heap().set_incremental_marking_enabled(incremental_gc);
+        g_vm->heap().set_marking_thread_count(max(gc_marking_threads, 1uz));
 
         auto& global_environment = realm.global_environment();
 
@@ -817,6 +872,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         s_editor->on_tab_complete = move(complete);
         TRY(repl(realm));
         s_editor->save_history(s_history_path.to_byte_string());
+        TRY(write_profile(profile_path));
     } else {
         OwnPtr<JS::ExecutionContext> root_execution_context;
         if (use_test262_global)
@@ -829,6 +885,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         ReplConsoleClient console_client(console_object.console());
         console_object.console().set_client(console_client);
         g_vm->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        g_vm->heap().set_generational_collection_enabled(generational_gc);
+        g_vm->heap().set_incremental_marking_enabled(incremental_gc);
+        g_vm->heap().set_marking_thread_count(max(gc_marking_threads, 1uz));
 
         StringBuilder builder;
         StringView source_name;
@@ -861,7 +920,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
         // We resolve modules as if it is the first file
 
-        if (!TRY(parse_and_run(realm, builder.string_view(), source_name)))
+        auto success = TRY(parse_and_run(realm, builder.string_view(), source_name));
+        TRY(write_profile(profile_path));
+        if (!success)
             return 1;
     }
 
@@ -14,6 +14,7 @@
 #include <LibCompress/Gzip.h>
 #include <LibCompress/Lzma.h>
 #include <LibCompress/Xz.h>
+#include <LibCompress/Zstd.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/Directory.h>
@@ -27,6 +28,25 @@
 
 constexpr size_t buffer_size = 4096;
 
+static ErrorOr<NonnullOwnPtr<Stream>> open_indexed_gzip_archive(StringView archive_path, StringView index_path)
+{
+    auto archive = TRY(Core::InputBufferedFile::create(TRY(Core::File::open(archive_path, Core::File::OpenMode::Read))));
+
+    // Building the index needs a full pass over the archive, so it is stored to let later runs skip straight to the data they need.
+    Optional<Compress::GzipIndex> index;
+    if (FileSystem::exists(index_path)) {
+        auto index_file = TRY(Core::InputBufferedFile::create(TRY(Core::File::open(index_path, Core::File::OpenMode::Read))));
+        index = TRY(Compress::GzipIndex::read_from_stream(*index_file));
+    } else {
+        index = TRY(Compress::GzipIndex::build(*archive));
+        auto index_file = TRY(Core::OutputBufferedFile::create(TRY(Core::File::open(index_path, Core::File::OpenMode::Write))));
+        TRY(index->write_to_stream(*index_file));
+        TRY(index_file->flush_buffer());
+    }
+
+    return TRY(Compress::SeekableGzipDecompressor::create(move(archive), index.release_value()));
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     bool create = false;
@@ -36,10 +56,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool gzip = false;
     bool lzma = false;
     bool xz = false;
+    bool zstd = false;
     bool no_auto_compress = false;
     StringView archive_file;
     bool dereference = false;
     StringView directory;
+    StringView gzip_index_file;
     Vector<ByteString> paths;
 
     Core::ArgsParser args_parser;
@@ -50,10 +72,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(gzip, "Compress or decompress file using gzip", "gzip", 'z');
     args_parser.add_option(lzma, "Compress or decompress file using lzma", "lzma");
     args_parser.add_option(xz, "Compress or decompress file using xz", "xz", 'J');
+    args_parser.add_option(zstd, "Compress or decompress file using zstd", "zstd");
     args_parser.add_option(no_auto_compress, "Do not use the archive suffix to select the compression algorithm", "no-auto-compress");
     args_parser.add_option(directory, "Directory to extract to/create from", "directory", 'C', "DIRECTORY");
     args_parser.add_option(archive_file, "Archive file", "file", 'f', "FILE");
     args_parser.add_option(dereference, "Follow symlinks", "dereference", 'h');
+    args_parser.add_option(gzip_index_file, "Seek index for a gzip archive, created if it does not exist yet", "index", 0, "FILE");
     args_parser.add_positional_argument(paths, "Paths", "PATHS", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -69,23 +93,36 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             lzma = true;
         if (archive_file.ends_with(".xz"sv))
             xz = true;
+        if (archive_file.ends_with(".zst"sv) || archive_file.ends_with(".tzst"sv))
+            zstd = true;
+    }
+
+    if (!gzip_index_file.is_empty() && (!gzip || archive_file.is_empty() || archive_file == "-"sv)) {
+        warnln("--index can only be used with a gzip compressed archive file");
+        return 1;
     }
 
     if (list || extract) {
         NonnullOwnPtr<Stream> input_stream = TRY(Core::InputBufferedFile::create(TRY(Core::File::open_file_or_standard_stream(archive_file, Core::File::OpenMode::Read))));
 
+        // With an index, skipping over the contents of unwanted entries seeks instead of decompressing them.
+        if (!gzip_index_file.is_empty())
+            input_stream = TRY(open_indexed_gzip_archive(archive_file, gzip_index_file));
+        else if (gzip)
+            input_stream = make<Compress::GzipDecompressor>(move(input_stream));
+
         if (!directory.is_empty())
             TRY(Core::System::chdir(directory));
 
-        if (gzip)
-            input_stream = make<Compress::GzipDecompressor>(move(input_stream));
-
         if (lzma)
             input_stream = TRY(Compress::LzmaDecompressor::create_from_container(move(input_stream)));
 
         if (xz)
             input_stream = TRY(Compress::XzDecompressor::create(move(input_stream)));
 
+        if (zstd)
+            input_stream = TRY(Compress::ZstdDecompressor::construct(move(input_stream)));
+
         auto tar_stream = TRY(Archive::TarInputStream::construct(move(input_stream)));
 
         HashMap<ByteString, ByteString> global_overrides;
@@ -105,6 +142,20 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             return {};
         };
 
+        auto is_selected = [&](StringView filename) {
+            if (paths.is_empty())
+                return true;
+
+            for (auto const& path : paths) {
+                auto selected_path = path.view().trim("/"sv, TrimMode::Right);
+                if (filename == selected_path)
+                    return true;
+                if (filename.starts_with(selected_path) && filename.substring_view(selected_path.length()).starts_with('/'))
+                    return true;
+            }
+            return false;
+        };
+
         while (!tar_stream->finished()) {
             Archive::TarFileHeader const& header = tar_stream->header();
 
@@ -163,6 +214,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 path = path.prepend(header.prefix());
             ByteString filename = get_override("path"sv).value_or(path.string());
 
+            if (!is_selected(filename)) {
+                local_overrides.clear();
+                TRY(tar_stream->advance());
+                continue;
+            }
+
             if (list || verbose)
                 outln("{}", filename);
 
@@ -240,6 +297,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (xz)
             return Error::from_string_literal("Creating XZ compressed archives is not supported");
 
+        if (zstd)
+            output_stream = TRY(Compress::ZstdCompressor::construct(move(output_stream)));
+
         Archive::TarOutputStream tar_stream(move(output_stream));
 
         auto add_file = [&](ByteString path) -> ErrorOr<void> {
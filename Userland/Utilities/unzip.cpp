@@ -11,6 +11,7 @@
 #include <AK/StringUtils.h>
 #include <LibArchive/Zip.h>
 #include <LibCompress/Deflate.h>
+#include <LibCompress/Zstd.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/Directory.h>
@@ -83,6 +84,23 @@ static bool unpack_zip_member(Archive::ZipMember zip_member, bool quiet)
         checksum.update(decompressed_data.value());
         break;
     }
+    case Archive::ZipCompressionMethod::Zstandard: {
+        auto decompressed_data = Compress::ZstdDecompressor::decompress_all(zip_member.compressed_data);
+        if (decompressed_data.is_error()) {
+            warnln("Failed decompressing file {}: {}", zip_member.name, decompressed_data.error());
+            return false;
+        }
+        if (decompressed_data.value().size() != zip_member.uncompressed_size) {
+            warnln("Failed decompressing file {}", zip_member.name);
+            return false;
+        }
+        if (auto maybe_error = new_file->write_until_depleted(decompressed_data.value()); maybe_error.is_error()) {
+            warnln("Can't write file contents in {}: {}", zip_member.name, maybe_error.release_error());
+            return false;
+        }
+        checksum.update(decompressed_data.value());
+        break;
+    }
     default:
         VERIFY_NOT_REACHED();
     }
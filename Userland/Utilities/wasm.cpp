@@ -352,7 +352,7 @@ static bool pre_interpret_hook(Wasm::Configuration& config, Wasm::InstructionPoi
                     warnln("invalid memory index {} (not found)", args[2]);
                     continue;
                 }
-                warnln("{:>32hex-dump}", mem->data().bytes());
+                warnln("{:>32hex-dump}", mem->bytes());
                 continue;
             }
             if (what.is_one_of("i", "instr", "instruction")) {
@@ -616,6 +616,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (attempt_instantiate) {
         Wasm::AbstractMachine machine;
+        machine.store().set_memory_kind(Wasm::MemoryInstance::Kind::GuardPages);
         Optional<Wasm::Wasi::Implementation> wasi_impl;
 
         if (wasi) {
@@ -7,23 +7,44 @@
 #include <LibCompress/Xz.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("rpath stdio"));
+    TRY(Core::System::pledge("rpath stdio thread"));
 
     StringView filename;
+    size_t thread_count { 1 };
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("Decompress and print an XZ archive");
+    args_parser.add_option(thread_count, "Decompress the blocks of the archive on this many threads (0 for one per core)", "threads", 'T', "count");
     args_parser.add_positional_argument(filename, "File to decompress", "file");
     args_parser.parse(arguments);
 
-    auto file = TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read));
-    auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
-    auto stream = TRY(Compress::XzDecompressor::create(move(buffered_file)));
+    // Decoding blocks in parallel needs the Index at the end of the archive, so the whole input has to be available up front.
+    Variant<Empty, ByteBuffer, NonnullOwnPtr<Core::MappedFile>> buffer_or_file;
+    OwnPtr<Stream> stream;
+
+    if (thread_count == 1) {
+        auto file = TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read));
+        auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
+        stream = TRY(Compress::XzDecompressor::create(move(buffered_file)));
+    } else {
+        ReadonlyBytes input_bytes;
+        if (filename == "-"sv) {
+            auto file = TRY(Core::File::standard_input());
+            buffer_or_file = TRY(file->read_until_eof());
+            input_bytes = buffer_or_file.get<ByteBuffer>();
+        } else if (TRY(Core::System::stat(filename)).st_size > 0) {
+            buffer_or_file = TRY(Core::MappedFile::map(filename));
+            input_bytes = buffer_or_file.get<NonnullOwnPtr<Core::MappedFile>>()->bytes();
+        }
+
+        stream = TRY(Compress::ParallelXzDecompressor::create(input_bytes, thread_count));
+    }
 
     // Arbitrarily chosen buffer size.
     Array<u8, 4096> buffer;